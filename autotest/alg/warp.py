@@ -35,6 +35,7 @@
 import os
 import sys
 import shutil
+import struct
 
 sys.path.append( '../pymod' )
 
@@ -1695,6 +1696,137 @@ def warp_52():
 
     return 'success'
 
+###############################################################################
+# Test chunk-level multi-threading (NUM_CHUNK_THREADS)
+
+def warp_53():
+
+    src_ds = gdal.Open('../gcore/data/byte.tif')
+
+    # Sequential processing with the memory share of each of the 4 threads,
+    # so that both runs end up with the same chunk list.
+    ref_ds = gdal.Warp('', src_ds, format = 'MEM',
+              width = 1000, height = 1000,
+              warpMemoryLimit = 100000,
+              resampleAlg = gdal.GRA_Cubic)
+    ref_cs = ref_ds.GetRasterBand(1).Checksum()
+
+    for num_threads in [ '4', 'ALL_CPUS' ]:
+        out_ds = gdal.Warp('', src_ds, format = 'MEM',
+                  width = 1000, height = 1000,
+                  warpMemoryLimit = 400000,
+                  warpOptions = [ 'NUM_CHUNK_THREADS=' + num_threads ],
+                  resampleAlg = gdal.GRA_Cubic)
+        if num_threads == '4':
+            cs = out_ds.GetRasterBand(1).Checksum()
+            if cs != ref_cs:
+                gdaltest.post_reason('fail')
+                print(cs)
+                print(ref_cs)
+                return 'fail'
+        elif out_ds is None:
+            gdaltest.post_reason('fail')
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test APPROX_TRANSFORMER_GRID_STEP warping option
+
+def warp_54():
+
+    src_ds = gdal.Open('../gcore/data/byte.tif')
+
+    ref_ds = gdal.Warp('', src_ds, format = 'MEM', dstSRS = 'EPSG:4326',
+                       width = 500, height = 500,
+                       warpMemoryLimit = 100000,
+                       resampleAlg = gdal.GRA_Bilinear)
+
+    for warp_options in [ [ 'APPROX_TRANSFORMER_GRID_STEP=16' ],
+                          [ 'APPROX_TRANSFORMER_GRID_STEP=16',
+                            'NUM_THREADS=4' ] ]:
+        ds = gdal.Warp('', src_ds, format = 'MEM', dstSRS = 'EPSG:4326',
+                       width = 500, height = 500,
+                       warpMemoryLimit = 100000,
+                       warpOptions = warp_options,
+                       resampleAlg = gdal.GRA_Bilinear)
+        # Both are approximations within 0.125 pixel of the exact
+        # transformation, so pixels at the edge of the footprint can
+        # flip between valid and nodata.
+        ref_data = struct.unpack('B' * 500 * 500, ref_ds.ReadRaster())
+        data = struct.unpack('B' * 500 * 500, ds.ReadRaster())
+        count = 0
+        for i in range(500 * 500):
+            if abs(ref_data[i] - data[i]) > 1:
+                count = count + 1
+        if count > 500 * 500 / 100:
+            gdaltest.post_reason('fail')
+            print(warp_options)
+            print(count)
+            return 'fail'
+
+    # Ignored without approximate transformer
+    ref_ds = gdal.Warp('', src_ds, format = 'MEM', dstSRS = 'EPSG:4326',
+                       width = 500, height = 500, errorThreshold = 0)
+    ds = gdal.Warp('', src_ds, format = 'MEM', dstSRS = 'EPSG:4326',
+                   width = 500, height = 500, errorThreshold = 0,
+                   warpOptions = [ 'APPROX_TRANSFORMER_GRID_STEP=16' ])
+    if ds.GetRasterBand(1).Checksum() != ref_ds.GetRasterBand(1).Checksum():
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test that APPROX_TRANSFORMER_GRID_STEP does not change the source windows
+# computed for each chunk
+
+class warp_55_chunk_collector:
+    def __init__(self):
+        self.chunks = []
+
+    def handler(self, eErrClass, err_no, msg):
+        if msg.find('Chunk dst=') >= 0:
+            self.chunks.append(msg)
+
+def warp_55():
+
+    src_ds = gdal.Open('../gcore/data/byte.tif')
+    ds = gdal.GetDriverByName('MEM').CreateCopy('', src_ds)
+    gcps = []
+    for (pixel, line, x, y) in [ (0, 0, 0, 0), (20, 0, 20, 2), (0, 20, -3, 20),
+                                 (20, 20, 25, 25), (10, 10, 11, 9) ]:
+        gcps.append(gdal.GCP(x, y, 0, pixel, line))
+    ds.SetGCPs(gcps, '')
+
+    chunk_lists = []
+    old_val = gdal.GetConfigOption('CPL_DEBUG')
+    gdal.SetConfigOption('CPL_DEBUG', 'ON')
+    for warp_options in [ [], [ 'APPROX_TRANSFORMER_GRID_STEP=16' ] ]:
+        collector = warp_55_chunk_collector()
+        gdal.PushErrorHandler(collector.handler)
+        out_ds = gdal.Warp('', ds, format = 'MEM', tps = True,
+                           width = 1000, height = 1000,
+                           warpMemoryLimit = 100000,
+                           warpOptions = warp_options,
+                           resampleAlg = gdal.GRA_Bilinear)
+        gdal.PopErrorHandler()
+        if out_ds is None:
+            gdal.SetConfigOption('CPL_DEBUG', old_val)
+            gdaltest.post_reason('fail')
+            return 'fail'
+        out_ds = None
+        chunk_lists.append(sorted(collector.chunks))
+    gdal.SetConfigOption('CPL_DEBUG', old_val)
+
+    if len(chunk_lists[0]) < 2 or chunk_lists[0] != chunk_lists[1]:
+        gdaltest.post_reason('fail')
+        print(chunk_lists[0])
+        print(chunk_lists[1])
+        return 'fail'
+
+    return 'success'
+
 gdaltest_list = [
     warp_1,
     warp_1_short,
@@ -1764,7 +1896,10 @@ gdaltest_list = [
     warp_49,
     warp_50,
     warp_51,
-    warp_52
+    warp_52,
+    warp_53,
+    warp_54,
+    warp_55
     ]
 
 
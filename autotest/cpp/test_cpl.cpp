@@ -830,4 +830,109 @@ namespace tut
         ensure( VSIGetDiskFreeSpace(".") == -1 || VSIGetDiskFreeSpace(".") >= 0 );
     }
 
+    // Test VSIFPReadL()
+    template<>
+    template<>
+    void object::test<14>()
+    {
+        const char* pszFilename = "tmp/test_cpl_pread.bin";
+        VSILFILE* fp = VSIFOpenL(pszFilename, "wb");
+        ensure( fp != NULL );
+        ensure( VSIFWriteL("0123456789", 1, 10, fp) == 10 );
+        VSIFCloseL(fp);
+
+        fp = VSIFOpenL(pszFilename, "rb");
+        ensure( fp != NULL );
+#ifdef WIN32
+        // Only implemented for POSIX regular files
+        ensure( !VSIFHasPReadL(fp) );
+#else
+        ensure( VSIFHasPReadL(fp) );
+
+        char szBuffer[11] = { 0 };
+        ensure_equals( VSIFPReadL(szBuffer, 4, 3, fp), 4U );
+        ensure_equals( std::string(szBuffer), std::string("3456") );
+        // The file position must not be affected
+        ensure_equals( VSIFTellL(fp), 0U );
+        ensure_equals( VSIFPReadL(szBuffer, 10, 8, fp), 2U );
+        ensure_equals( VSIFPReadL(szBuffer, 10, 20, fp), 0U );
+
+        VSILFILE* fpSub = VSIFOpenL(
+            CPLSPrintf("/vsisubfile/2_5,%s", pszFilename), "rb");
+        ensure( fpSub != NULL );
+        ensure( VSIFHasPReadL(fpSub) );
+        memset(szBuffer, 0, sizeof(szBuffer));
+        ensure_equals( VSIFPReadL(szBuffer, 10, 1, fpSub), 4U );
+        ensure_equals( std::string(szBuffer), std::string("3456") );
+        VSIFCloseL(fpSub);
+#endif
+        VSIFCloseL(fp);
+
+        // Writable handles do not support positional reads, since data
+        // still in their write buffer would not be seen
+        fp = VSIFOpenL(pszFilename, "r+b");
+        ensure( fp != NULL );
+        ensure( !VSIFHasPReadL(fp) );
+        VSIFCloseL(fp);
+
+        fp = VSIFOpenL(pszFilename, "wb+");
+        ensure( fp != NULL );
+        ensure( !VSIFHasPReadL(fp) );
+        VSIFCloseL(fp);
+
+        VSIUnlink(pszFilename);
+    }
+
+    // Test VSI_USE_MMAP and VSIFGetDirectPointerL()
+    template<>
+    template<>
+    void object::test<15>()
+    {
+        const char* pszFilename = "tmp/test_cpl_mmap.bin";
+        VSILFILE* fp = VSIFOpenL(pszFilename, "wb");
+        ensure( fp != NULL );
+        ensure( VSIFWriteL("0123456789", 1, 10, fp) == 10 );
+        VSIFCloseL(fp);
+
+        // Not enabled by default
+        fp = VSIFOpenL(pszFilename, "rb");
+        ensure( fp != NULL );
+        ensure( VSIFGetDirectPointerL(fp, 0, 1) == NULL );
+        VSIFCloseL(fp);
+
+#ifdef HAVE_MMAP
+        CPLSetConfigOption("VSI_USE_MMAP", "YES");
+        fp = VSIFOpenL(pszFilename, "rb");
+        CPLSetConfigOption("VSI_USE_MMAP", NULL);
+        ensure( fp != NULL );
+        ensure( VSIFGetDirectPointerL(fp, 0, 0) != NULL );
+
+        const char* pszData = (const char*)VSIFGetDirectPointerL(fp, 3, 7);
+        ensure( pszData != NULL );
+        ensure( memcmp(pszData, "3456789", 7) == 0 );
+        ensure( VSIFGetDirectPointerL(fp, 3, 8) == NULL );
+        ensure( VSIFHasPReadL(fp) );
+
+        char szBuffer[11] = { 0 };
+        ensure( VSIFSeekL(fp, 8, SEEK_SET) == 0 );
+        ensure_equals( VSIFReadL(szBuffer, 1, 5, fp), 2U );
+        ensure( VSIFEofL(fp) );
+        ensure_equals( VSIFTellL(fp), 10U );
+        ensure( VSIFSeekL(fp, 0, SEEK_SET) == 0 );
+        ensure_equals( VSIFReadL(szBuffer, 2, 2, fp), 2U );
+        ensure_equals( std::string(szBuffer), std::string("0123") );
+
+        void* apData[2] = { szBuffer, szBuffer + 5 };
+        const vsi_l_offset anOffsets[2] = { 1, 6 };
+        const size_t anSizes[2] = { 2, 3 };
+        ensure( VSIFReadMultiRangeL(2, apData, anOffsets, anSizes, fp) == 0 );
+        ensure( memcmp(szBuffer, "12", 2) == 0 );
+        ensure( memcmp(szBuffer + 5, "678", 3) == 0 );
+
+        ensure( VSIFWriteL("x", 1, 1, fp) == 0 );
+        VSIFCloseL(fp);
+#endif
+        VSIUnlink(pszFilename);
+    }
+
 } // namespace tut
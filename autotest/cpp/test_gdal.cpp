@@ -33,7 +33,9 @@
 #include <tut.h>
 #include <gdal.h>
 #include <gdal_priv.h>
+#include <gdal_alg.h>
 #include <gdal_utils.h>
+#include <gdal_proxy.h>
 #include <string>
 #include <limits>
 
@@ -274,4 +276,358 @@ namespace tut
         GetGDALDriverManager()->DeregisterDriver( poDriver );
         delete poDriver;
     }
+
+    // Test per-dataset block cache budget and priority
+    template<> template<> void object::test<10>()
+    {
+        const GIntBig nOldCacheMax = GDALGetCacheMax64();
+        GDALSetCacheMax64(10 * 1000 * 1000);
+
+        // 256 blocks of 256 bytes
+        GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+        ensure(hDriver != NULL);
+        const char* apszOptions[] = { "TILED=YES", "BLOCKXSIZE=16",
+                                      "BLOCKYSIZE=16", NULL };
+        GDALDatasetH hDS = GDALCreate(hDriver, "/vsimem/test_gdal_10.tif",
+                                      256, 256, 1, GDT_Byte,
+                                      (char**)apszOptions);
+        GDALClose(hDS);
+
+        GDALDatasetH hBudgetDS = GDALOpen("/vsimem/test_gdal_10.tif", GA_ReadOnly);
+        GDALDatasetSetBlockCacheMax(hBudgetDS, 16 * 256);
+        ensure_equals(GDALDatasetGetBlockCacheMax(hBudgetDS), 16 * 256);
+        GDALChecksumImage(GDALGetRasterBand(hBudgetDS, 1), 0, 0, 256, 256);
+        ensure(GDALDatasetGetBlockCacheUsed(hBudgetDS) > 0);
+        ensure(GDALDatasetGetBlockCacheUsed(hBudgetDS) <= 16 * 256);
+        GDALClose(hBudgetDS);
+
+        GDALDatasetH hHotDS = GDALOpen("/vsimem/test_gdal_10.tif", GA_ReadOnly);
+        GDALDatasetSetBlockCachePriority(hHotDS, GBCP_Hot);
+        ensure_equals(GDALDatasetGetBlockCachePriority(hHotDS), GBCP_Hot);
+        GDALChecksumImage(GDALGetRasterBand(hHotDS, 1), 0, 0, 256, 256);
+        ensure_equals(GDALDatasetGetBlockCacheUsed(hHotDS), 256 * 256);
+
+        // The cache can only hold the hot blocks and 32 other ones, so the
+        // streaming dataset must evict its own blocks
+        GDALSetCacheMax64(GDALGetCacheUsed64() + 32 * 256);
+        GDALDatasetH hStreamingDS = GDALOpen("/vsimem/test_gdal_10.tif", GA_ReadOnly);
+        GDALDatasetSetBlockCachePriority(hStreamingDS, GBCP_Streaming);
+        GDALChecksumImage(GDALGetRasterBand(hStreamingDS, 1), 0, 0, 256, 256);
+        ensure_equals(GDALDatasetGetBlockCacheUsed(hHotDS), 256 * 256);
+        ensure(GDALDatasetGetBlockCacheUsed(hStreamingDS) <= 32 * 256);
+        GDALClose(hStreamingDS);
+        GDALClose(hHotDS);
+
+        GDALSetCacheMax64(nOldCacheMax);
+        VSIUnlink("/vsimem/test_gdal_10.tif");
+    }
+
+    // Test block cache statistics
+    template<> template<> void object::test<11>()
+    {
+        const GIntBig nOldCacheMax = GDALGetCacheMax64();
+        GDALSetCacheMax64(10 * 1000 * 1000);
+
+        // 256 blocks of 256 bytes
+        GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+        ensure(hDriver != NULL);
+        const char* apszOptions[] = { "TILED=YES", "BLOCKXSIZE=16",
+                                      "BLOCKYSIZE=16", NULL };
+        GDALDatasetH hDS = GDALCreate(hDriver, "/vsimem/test_gdal_11.tif",
+                                      256, 256, 1, GDT_Byte,
+                                      (char**)apszOptions);
+        GDALClose(hDS);
+
+        GDALBlockCacheStatistics sStats;
+        GDALResetBlockCacheStatistics();
+        GDALGetBlockCacheStatistics(&sStats);
+        ensure_equals(sStats.nHits, 0);
+        ensure_equals(sStats.nMisses, 0);
+        ensure_equals(sStats.nCacheHighWaterMark, sStats.nCacheUsed);
+
+        hDS = GDALOpen("/vsimem/test_gdal_11.tif", GA_ReadOnly);
+        GDALChecksumImage(GDALGetRasterBand(hDS, 1), 0, 0, 256, 256);
+        GDALDatasetGetBlockCacheStatistics(hDS, &sStats);
+        ensure_equals(sStats.nMisses, 256);
+        ensure_equals(sStats.nBytesRead, 256 * 256);
+        ensure_equals(sStats.nEvictions, 0);
+        ensure_equals(sStats.nCacheUsed, 256 * 256);
+        ensure_equals(sStats.nCacheHighWaterMark, 256 * 256);
+        const GIntBig nHits = sStats.nHits;
+
+        // Single band dataset: the band counters match the dataset ones
+        GDALBlockCacheStatistics sBandStats;
+        GDALGetRasterBandBlockCacheStatistics(GDALGetRasterBand(hDS, 1),
+                                              &sBandStats);
+        ensure_equals(sBandStats.nHits, nHits);
+        ensure_equals(sBandStats.nMisses, 256);
+        ensure_equals(sBandStats.nBytesRead, 256 * 256);
+        ensure_equals(sBandStats.nCacheUsed, 256 * 256);
+
+        // Everything is served from the cache
+        GDALChecksumImage(GDALGetRasterBand(hDS, 1), 0, 0, 256, 256);
+        GDALDatasetGetBlockCacheStatistics(hDS, &sStats);
+        ensure_equals(sStats.nMisses, 256);
+        ensure(sStats.nHits >= nHits + 256);
+
+        GDALGetBlockCacheStatistics(&sStats);
+        ensure_equals(sStats.nMisses, 256);
+        ensure(sStats.nHits >= nHits + 256);
+        ensure(sStats.nCacheHighWaterMark >= 256 * 256);
+        ensure(sStats.nLockAcquisitions > 0);
+        GDALClose(hDS);
+
+        // Evictions, and dirty flushes, with a budget of 16 blocks
+        hDS = GDALOpen("/vsimem/test_gdal_11.tif", GA_Update);
+        GDALDatasetSetBlockCacheMax(hDS, 16 * 256);
+        GDALFillRaster(GDALGetRasterBand(hDS, 1), 1, 0);
+        GDALDatasetGetBlockCacheStatistics(hDS, &sStats);
+        ensure(sStats.nEvictions >= 256 - 16);
+        ensure(sStats.nDirtyFlushes >= 256 - 16);
+        ensure(sStats.nCacheHighWaterMark < 256 * 256);
+        GDALGetRasterBandBlockCacheStatistics(GDALGetRasterBand(hDS, 1),
+                                              &sBandStats);
+        ensure_equals(sBandStats.nEvictions, sStats.nEvictions);
+        ensure_equals(sBandStats.nDirtyFlushes, sStats.nDirtyFlushes);
+        GDALClose(hDS);
+
+        GDALSetCacheMax64(nOldCacheMax);
+        VSIUnlink("/vsimem/test_gdal_11.tif");
+    }
+
+    static void CPL_STDCALL test_gdal_12_callback( GDALDatasetH, int iWindow,
+                                                   CPLErr eErr,
+                                                   void* pCallbackData )
+    {
+        if( eErr == CE_None )
+            ((int*)pCallbackData)[iWindow] ++;
+    }
+
+    // Test asynchronous reading and prefetching
+    template<> template<> void object::test<12>()
+    {
+        const GIntBig nOldCacheMax = GDALGetCacheMax64();
+        GDALSetCacheMax64(10 * 1000 * 1000);
+
+        GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+        ensure(hDriver != NULL);
+        const char* apszOptions[] = { "TILED=YES", "BLOCKXSIZE=16",
+                                      "BLOCKYSIZE=16", NULL };
+        GDALDatasetH hDS = GDALCreate(hDriver, "/vsimem/test_gdal_12.tif",
+                                      256, 256, 1, GDT_Byte,
+                                      (char**)apszOptions);
+        GByte abyData[256 * 256];
+        for( int i = 0; i < 256 * 256; i++ )
+            abyData[i] = (GByte)(i / 256);
+        ensure_equals(GDALDatasetRasterIO(hDS, GF_Write, 0, 0, 256, 256,
+                                          abyData, 256, 256, GDT_Byte,
+                                          1, NULL, 0, 0, 0), CE_None);
+        GDALClose(hDS);
+
+        // Prefetch two windows, and check that reading them is then
+        // served from the block cache
+        hDS = GDALOpen("/vsimem/test_gdal_12.tif", GA_ReadOnly);
+        const int anWindows[] = { 0, 0, 64, 64,  100, 100, 40, 40 };
+        int anCalls[2] = { 0, 0 };
+        GDALPrefetchRequestH hRequest =
+            GDALDatasetBeginPrefetch(hDS, 2, anWindows, 0, NULL,
+                                     test_gdal_12_callback, anCalls, NULL);
+        ensure(hRequest != NULL);
+        ensure(GDALPrefetchRequestWait(hRequest, -1));
+        GDALDatasetEndPrefetch(hDS, hRequest);
+        ensure_equals(anCalls[0], 1);
+        ensure_equals(anCalls[1], 1);
+
+        GDALBlockCacheStatistics sStats;
+        GDALDatasetGetBlockCacheStatistics(hDS, &sStats);
+        ensure_equals(sStats.nMisses, 16 + 9);
+        GByte abyWindow[40 * 40];
+        ensure_equals(GDALDatasetRasterIO(hDS, GF_Read, 100, 100, 40, 40,
+                                          abyWindow, 40, 40, GDT_Byte,
+                                          1, NULL, 0, 0, 0), CE_None);
+        ensure_equals(abyWindow[0], 100);
+        GDALDatasetGetBlockCacheStatistics(hDS, &sStats);
+        ensure_equals(sStats.nMisses, 16 + 9);
+
+        // Repeated windows, within a request and across pending requests:
+        // they are reported for each occurrence
+        const int anRepeatedWindows[] = { 192, 192, 32, 32,  192, 192, 32, 32 };
+        int anRepeatedCalls[2] = { 0, 0 };
+        int anOtherCalls[2] = { 0, 0 };
+        hRequest = GDALDatasetBeginPrefetch(hDS, 2, anRepeatedWindows, 0, NULL,
+                                            test_gdal_12_callback,
+                                            anRepeatedCalls, NULL);
+        ensure(hRequest != NULL);
+        GDALPrefetchRequestH hOtherRequest =
+            GDALDatasetBeginPrefetch(hDS, 1, anRepeatedWindows, 0, NULL,
+                                     test_gdal_12_callback, anOtherCalls, NULL);
+        ensure(hOtherRequest != NULL);
+        ensure(GDALPrefetchRequestWait(hRequest, -1));
+        ensure(GDALPrefetchRequestWait(hOtherRequest, -1));
+        GDALDatasetEndPrefetch(hDS, hOtherRequest);
+        GDALDatasetEndPrefetch(hDS, hRequest);
+        ensure_equals(anRepeatedCalls[0], 1);
+        ensure_equals(anRepeatedCalls[1], 1);
+        ensure_equals(anOtherCalls[0], 1);
+        GDALDatasetGetBlockCacheStatistics(hDS, &sStats);
+        ensure_equals(sStats.nMisses, 16 + 9 + 4);
+
+        // Out of raster window
+        const int anBadWindow[] = { 250, 0, 10, 10 };
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        hRequest = GDALDatasetBeginPrefetch(hDS, 1, anBadWindow, 0, NULL,
+                                            NULL, NULL, NULL);
+        CPLPopErrorHandler();
+        ensure(hRequest == NULL);
+
+        // Asynchronous reader: the regions reported must cover the buffer,
+        // in order
+        memset(abyData, 0, sizeof(abyData));
+        GDALAsyncReaderH hReader =
+            GDALBeginAsyncReader(hDS, 0, 0, 256, 256, abyData, 128, 128,
+                                 GDT_Byte, 1, NULL, 0, 0, 0, NULL);
+        ensure(hReader != NULL);
+        int nNextLine = 0;
+        GDALAsyncStatusType eStatus;
+        do
+        {
+            int nBufXOff, nBufYOff, nBufXSize, nBufYSize;
+            eStatus = GDALARGetNextUpdatedRegion(hReader, -1.0,
+                                                 &nBufXOff, &nBufYOff,
+                                                 &nBufXSize, &nBufYSize);
+            ensure(eStatus != GARIO_ERROR);
+            if( nBufYSize > 0 )
+            {
+                ensure_equals(nBufYOff, nNextLine);
+                ensure_equals(nBufXSize, 128);
+                nNextLine += nBufYSize;
+            }
+        }
+        while( eStatus != GARIO_COMPLETE );
+        ensure_equals(nNextLine, 128);
+        GDALEndAsyncReader(hDS, hReader);
+        GByte abyRef[128 * 128];
+        ensure_equals(GDALDatasetRasterIO(hDS, GF_Read, 0, 0, 256, 256,
+                                          abyRef, 128, 128, GDT_Byte,
+                                          1, NULL, 0, 0, 0), CE_None);
+        ensure(memcmp(abyData, abyRef, sizeof(abyRef)) == 0);
+
+        GDALClose(hDS);
+        GDALSetCacheMax64(nOldCacheMax);
+        VSIUnlink("/vsimem/test_gdal_12.tif");
+    }
+
+    // Number of files, threads and passes of test<13>
+    static const int TEST_GDAL_13_FILES = 10;
+    static const int TEST_GDAL_13_THREADS = 3;
+    static const int TEST_GDAL_13_PASSES = 3;
+
+    static void test_gdal_13_thread( void* pData )
+    {
+        int* pnErrors = (int*)pData;
+
+        // Proxies are created by the thread that reads them, so that each
+        // thread gets its own pool entries
+        GDALProxyPoolDataset* apoProxies[TEST_GDAL_13_FILES];
+        for( int i = 0; i < TEST_GDAL_13_FILES; i++ )
+        {
+            apoProxies[i] = new GDALProxyPoolDataset(
+                CPLSPrintf("/vsimem/test_gdal_13_%d.tif", i),
+                16, 16, GA_ReadOnly, TRUE);
+            apoProxies[i]->AddSrcBandDescription(GDT_Byte, 16, 16);
+        }
+
+        for( int iPass = 0; iPass < TEST_GDAL_13_PASSES; iPass++ )
+        {
+            for( int i = 0; i < TEST_GDAL_13_FILES; i++ )
+            {
+                // The second read of each proxy is served by the pool
+                for( int iRead = 0; iRead < 2; iRead++ )
+                {
+                    GByte abyData[16 * 16];
+                    if( apoProxies[i]->GetRasterBand(1)->RasterIO(
+                            GF_Read, 0, 0, 16, 16, abyData, 16, 16,
+                            GDT_Byte, 0, 0, NULL) != CE_None ||
+                        abyData[0] != i || abyData[16 * 16 - 1] != i )
+                    {
+                        (*pnErrors) ++;
+                    }
+                }
+            }
+        }
+
+        for( int i = 0; i < TEST_GDAL_13_FILES; i++ )
+            delete apoProxies[i];
+    }
+
+    // Test the dataset pool with more proxies than its size, from several
+    // threads
+    template<> template<> void object::test<13>()
+    {
+        GDALDriverH hDriver = GDALGetDriverByName("GTiff");
+        ensure(hDriver != NULL);
+        for( int i = 0; i < TEST_GDAL_13_FILES; i++ )
+        {
+            GDALDatasetH hDS = GDALCreate(hDriver,
+                                CPLSPrintf("/vsimem/test_gdal_13_%d.tif", i),
+                                16, 16, 1, GDT_Byte, NULL);
+            ensure(hDS != NULL);
+            ensure_equals(GDALFillRaster(GDALGetRasterBand(hDS, 1), i, 0),
+                          CE_None);
+            GDALClose(hDS);
+        }
+
+        GIntBig nHits0, nOpens0, nCloses0, nEvictions0;
+        GDALProxyPoolGetStatistics(&nHits0, &nOpens0, &nCloses0,
+                                   &nEvictions0);
+
+        const int nPoolSize = 5;
+        CPLSetConfigOption("GDAL_MAX_DATASET_POOL_SIZE",
+                           CPLSPrintf("%d", nPoolSize));
+        int anErrors[TEST_GDAL_13_THREADS];
+        CPLJoinableThread* apsThreads[TEST_GDAL_13_THREADS];
+        for( int i = 0; i < TEST_GDAL_13_THREADS; i++ )
+        {
+            anErrors[i] = 0;
+            apsThreads[i] = CPLCreateJoinableThread(test_gdal_13_thread,
+                                                    &anErrors[i]);
+            ensure(apsThreads[i] != NULL);
+        }
+        for( int i = 0; i < TEST_GDAL_13_THREADS; i++ )
+        {
+            CPLJoinThread(apsThreads[i]);
+            ensure_equals(anErrors[i], 0);
+        }
+        CPLSetConfigOption("GDAL_MAX_DATASET_POOL_SIZE", NULL);
+
+        GIntBig nHits, nOpens, nCloses, nEvictions;
+        GDALProxyPoolGetStatistics(&nHits, &nOpens, &nCloses, &nEvictions);
+        nHits -= nHits0;
+        nOpens -= nOpens0;
+        nCloses -= nCloses0;
+        nEvictions -= nEvictions0;
+
+        // Each read references the dataset once
+        const int nReads = TEST_GDAL_13_THREADS * TEST_GDAL_13_PASSES *
+                           TEST_GDAL_13_FILES * 2;
+        ensure_equals(nHits + nOpens, (GIntBig)nReads);
+        // At least the second read of each proxy is a hit
+        ensure("hits", nHits >= nReads / 2);
+        // Each proxy is opened at least once. The working set of the
+        // threads is larger than the pool, so that most first reads of a
+        // pass reopen the dataset
+        ensure("min opens", nOpens >= TEST_GDAL_13_THREADS * TEST_GDAL_13_FILES);
+        ensure("max opens", nOpens <= nReads / 2);
+        // Everything has been closed. The datasets that were not evicted
+        // were closed with their proxy, or with the pool, each thread
+        // leaving at most a full pool behind it
+        ensure_equals(nCloses, nOpens);
+        ensure("min evictions",
+               nEvictions >= nOpens - TEST_GDAL_13_THREADS * nPoolSize);
+        ensure("max evictions", nEvictions <= nOpens);
+
+        for( int i = 0; i < TEST_GDAL_13_FILES; i++ )
+            VSIUnlink(CPLSPrintf("/vsimem/test_gdal_13_%d.tif", i));
+    }
+
 } // namespace tut
@@ -31,8 +31,11 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 #include <tut.h>
+#include <tut_gdal.h>
+#include <gdal_common.h>
 #include <ogrsf_frmts.h>
 #include <string>
+#include <vector>
 
 namespace tut
 {
@@ -354,6 +357,505 @@ namespace tut
         testCopyEquals<OGRMultiLineString>();
         
     }
+
+    // Test building geometries in an arena and the WKB view
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        const char* apszWKT[] = {
+            "POINT (1 2)",
+            "LINESTRING (0 0,10 0,10 5)",
+            "POLYGON ((0 0,10 0,10 10,0 10,0 0),(2 2,2 4,4 4,4 2,2 2))",
+            "MULTIPOLYGON (((0 0,0 1,1 1,0 0)),((20 20,20 30,30 30,30 20,20 20),(22 22,22 24,24 24,24 22,22 22)))",
+            "GEOMETRYCOLLECTION (POINT (1 2 3),MULTILINESTRING ((0 0 1,1 1 2)))",
+            "MULTIPOINT EMPTY"
+        };
+        const double adfArea[] = { 0, 0, 96, 96.5, 0, 0 };
+        const double adfLength[] = { 0, 15, 0, 0, sqrt(2.0), 0 };
+
+        OGRGeometryArena oArena(1024);
+        for( size_t i = 0; i < sizeof(apszWKT) / sizeof(apszWKT[0]); i++ )
+        {
+            for( int iOrder = 0; iOrder < 2; iOrder++ )
+            {
+                OGRGeometry* poRef = NULL;
+                char* pszWKT = (char*) apszWKT[i];
+                OGRGeometryFactory::createFromWkt(&pszWKT, NULL, &poRef);
+                ensure(NULL != poRef);
+
+                const int nSize = poRef->WkbSize();
+                GByte* pabyWKB = (GByte*) CPLMalloc(nSize);
+                poRef->exportToWkb(iOrder == 0 ? wkbNDR : wkbXDR, pabyWKB);
+
+                OGRGeometry* poGeom = NULL;
+                ensure_equals("createFromWkb() in arena failed",
+                    OGRGeometryFactory::createFromWkb(pabyWKB, NULL, &poGeom,
+                                                      nSize, wkbVariantOldOgc,
+                                                      &oArena), OGRERR_NONE);
+                ensure(apszWKT[i], CPL_TO_BOOL(poRef->Equals(poGeom)));
+                ensure_equals(poGeom->WkbSize(), nSize);
+
+                ensure(poGeom->IsReadOnly());
+                ensure(!poRef->IsReadOnly());
+
+                OGRGeometry* poClone = poGeom->clone();
+                ensure(!poClone->IsReadOnly());
+                ensure(CPL_TO_BOOL(poRef->Equals(poClone)));
+                delete poClone;
+
+                OGRWKBView oView(pabyWKB, nSize);
+                ensure(apszWKT[i], oView.IsValid());
+                ensure_equals(oView.WkbSize(), nSize);
+                ensure_equals(oView.getGeometryType(), poRef->getGeometryType());
+                ensure_equals(CPL_TO_BOOL(oView.IsEmpty()),
+                              CPL_TO_BOOL(poRef->IsEmpty()));
+
+                OGREnvelope3D sEnvRef, sEnv;
+                poRef->getEnvelope(&sEnvRef);
+                oView.getEnvelope(&sEnv);
+                ensure_equals(sEnv.MinX, sEnvRef.MinX);
+                ensure_equals(sEnv.MaxX, sEnvRef.MaxX);
+                ensure_equals(sEnv.MinY, sEnvRef.MinY);
+                ensure_equals(sEnv.MaxY, sEnvRef.MaxY);
+                ensure_equals(sEnv.MinZ, sEnvRef.MinZ);
+                ensure_equals(sEnv.MaxZ, sEnvRef.MaxZ);
+                ensure_distance(oView.get_Area(), adfArea[i], 1e-10);
+                ensure_distance(oView.get_Length(), adfLength[i], 1e-10);
+
+                // Truncated data must be rejected
+                ensure(!OGRWKBView(pabyWKB, nSize - 1).IsValid());
+                poGeom = NULL;
+                ensure(OGRGeometryFactory::createFromWkb(pabyWKB, NULL, &poGeom,
+                                                         nSize - 1, wkbVariantOldOgc,
+                                                         &oArena) != OGRERR_NONE);
+
+                CPLFree(pabyWKB);
+                delete poRef;
+            }
+        }
+        ensure(oArena.GetUsedSize() > 0);
+
+#ifndef DEBUG
+        // Methods that would reallocate arena memory must fail
+        {
+            char* pszWKT = (char*) apszWKT[3];
+            OGRGeometry* poRef = NULL;
+            OGRGeometryFactory::createFromWkt(&pszWKT, NULL, &poRef);
+            const int nSize = poRef->WkbSize();
+            GByte* pabyWKB = (GByte*) CPLMalloc(nSize);
+            poRef->exportToWkb(wkbNDR, pabyWKB);
+            OGRGeometry* poGeom = NULL;
+            OGRGeometryFactory::createFromWkb(pabyWKB, NULL, &poGeom, nSize,
+                                              wkbVariantOldOgc, &oArena);
+            ensure(NULL != poGeom);
+            OGRMultiPolygon* poMP = (OGRMultiPolygon*) poGeom;
+            OGRPolygon* poPoly = (OGRPolygon*) poMP->getGeometryRef(1);
+            OGRLinearRing* poRing = poPoly->getExteriorRing();
+
+            CPLPushErrorHandler(CPLQuietErrorHandler);
+            poRing->addPoint(100, 100);
+            poRing->setCoordinateDimension(3);
+            poPoly->addRing(poRing);
+            ensure(NULL == poPoly->stealInteriorRing(0));
+            ensure(poMP->removeGeometry(0) != OGRERR_NONE);
+            poMP->empty();
+            CPLPopErrorHandler();
+
+            ensure(CPL_TO_BOOL(poRef->Equals(poGeom)));
+            CPLFree(pabyWKB);
+            delete poRef;
+        }
+#endif
+
+        oArena.Reset();
+        ensure_equals(oArena.GetUsedSize(), (size_t)0);
+
+        // Predicates on a polygon with a hole
+        OGRGeometry* poPoly = NULL;
+        char* pszWKT = (char*) apszWKT[2];
+        OGRGeometryFactory::createFromWkt(&pszWKT, NULL, &poPoly);
+        GByte* pabyWKB = (GByte*) CPLMalloc(poPoly->WkbSize());
+        poPoly->exportToWkb(wkbNDR, pabyWKB);
+        OGRWKBView oView(pabyWKB, poPoly->WkbSize());
+        ensure(CPL_TO_BOOL(oView.Contains(1, 1)));
+        ensure(!oView.Contains(3, 3));
+        ensure(!oView.Contains(11, 1));
+
+        OGREnvelope sEnv;
+        sEnv.MinX = 2.5; sEnv.MaxX = 3.5; sEnv.MinY = 2.5; sEnv.MaxY = 3.5;
+        ensure(!oView.Intersects(sEnv));
+        sEnv.MinX = 5; sEnv.MaxX = 6; sEnv.MinY = 5; sEnv.MaxY = 6;
+        ensure(CPL_TO_BOOL(oView.Intersects(sEnv)));
+        sEnv.MinX = -1; sEnv.MaxX = 20; sEnv.MinY = 5; sEnv.MaxY = 6;
+        ensure(CPL_TO_BOOL(oView.Intersects(sEnv)));
+        sEnv.MinX = 11; sEnv.MaxX = 20; sEnv.MinY = 5; sEnv.MaxY = 6;
+        ensure(!oView.Intersects(sEnv));
+
+        OGRGeometry* poMaterialized = oView.Materialize();
+        ensure(CPL_TO_BOOL(poPoly->Equals(poMaterialized)));
+        delete poMaterialized;
+        CPLFree(pabyWKB);
+        delete poPoly;
+
+        // Curve geometries are not handled by the arena
+        OGRGeometry* poCurve = NULL;
+        pszWKT = (char*) "CIRCULARSTRING (0 0,1 1,2 0)";
+        OGRGeometryFactory::createFromWkt(&pszWKT, NULL, &poCurve);
+        pabyWKB = (GByte*) CPLMalloc(poCurve->WkbSize());
+        poCurve->exportToWkb(wkbNDR, pabyWKB, wkbVariantIso);
+        OGRGeometry* poGeom = NULL;
+        ensure_equals(OGRGeometryFactory::createFromWkb(pabyWKB, NULL, &poGeom,
+                          poCurve->WkbSize(), wkbVariantIso, &oArena),
+                      OGRERR_UNSUPPORTED_GEOMETRY_TYPE);
+        ensure(!OGRWKBView(pabyWKB, poCurve->WkbSize(), wkbVariantIso).IsValid());
+        CPLFree(pabyWKB);
+        delete poCurve;
+    }
+
+
+    // Check that reading a layer by batches gives the same result as
+    // GetNextFeature()
+    static void checkBatchesMatchFeatures(OGRLayer* poLayer)
+    {
+        OGRFeatureDefn* poDefn = poLayer->GetLayerDefn();
+        std::vector<OGRFeature*> apoFeatures;
+        OGRFeature* poFeature;
+        poLayer->ResetReading();
+        while( (poFeature = poLayer->GetNextFeature()) != NULL )
+            apoFeatures.push_back(poFeature);
+        // The end of the layer is sticky
+        ensure(poLayer->GetName(), poLayer->GetNextFeature() == NULL);
+
+        poLayer->ResetReading();
+        // Batch capacity not a divisor of the feature count on purpose
+        OGRFeatureBatch oBatch(poDefn, 3);
+        size_t nRead = 0;
+        int nCount;
+        while( (nCount = poLayer->GetNextFeatureBatch(&oBatch)) > 0 )
+        {
+            for( int i = 0; i < nCount; i++, nRead++ )
+            {
+                ensure(poLayer->GetName(), nRead < apoFeatures.size());
+                OGRFeature* poRef = apoFeatures[nRead];
+                ensure_equals(poLayer->GetName(), oBatch.GetFID(i),
+                              poRef->GetFID());
+                for( int iField = 0; iField < poDefn->GetFieldCount(); iField++ )
+                {
+                    const char* pszName =
+                        poDefn->GetFieldDefn(iField)->GetNameRef();
+                    ensure_equals(pszName,
+                                  CPL_TO_BOOL(oBatch.IsFieldSet(i, iField)),
+                                  CPL_TO_BOOL(poRef->IsFieldSet(iField)));
+                    if( !poRef->IsFieldSet(iField) )
+                        continue;
+                    switch( poDefn->GetFieldDefn(iField)->GetType() )
+                    {
+                        case OFTInteger:
+                            ensure_equals(pszName,
+                                oBatch.GetFieldAsIntegerArray(iField)[i],
+                                poRef->GetFieldAsInteger(iField));
+                            break;
+                        case OFTInteger64:
+                            ensure_equals(pszName,
+                                oBatch.GetFieldAsInteger64Array(iField)[i],
+                                poRef->GetFieldAsInteger64(iField));
+                            break;
+                        case OFTReal:
+                            ensure_equals(pszName,
+                                oBatch.GetFieldAsDoubleArray(iField)[i],
+                                poRef->GetFieldAsDouble(iField));
+                            break;
+                        case OFTString:
+                            ensure_equals(pszName,
+                                std::string(oBatch.GetFieldAsString(i, iField)),
+                                std::string(poRef->GetFieldAsString(iField)));
+                            break;
+                        case OFTBinary:
+                        {
+                            int nBytes = 0, nRefBytes = 0;
+                            const GByte* pabyData =
+                                oBatch.GetFieldAsBinary(i, iField, &nBytes);
+                            const GByte* pabyRef =
+                                poRef->GetFieldAsBinary(iField, &nRefBytes);
+                            ensure_equals(pszName, nBytes, nRefBytes);
+                            ensure(pszName,
+                                   memcmp(pabyData, pabyRef, nBytes) == 0);
+                            break;
+                        }
+                        case OFTDate:
+                        case OFTTime:
+                        case OFTDateTime:
+                        {
+                            const OGRField* psField =
+                                oBatch.GetFieldAsDateTimeArray(iField) + i;
+                            const OGRField* psRef = poRef->GetRawFieldRef(iField);
+                            ensure_equals(pszName, psField->Date.Year,
+                                          psRef->Date.Year);
+                            ensure_equals(pszName, psField->Date.Month,
+                                          psRef->Date.Month);
+                            ensure_equals(pszName, psField->Date.Day,
+                                          psRef->Date.Day);
+                            ensure_equals(pszName, psField->Date.Hour,
+                                          psRef->Date.Hour);
+                            ensure_equals(pszName, psField->Date.Minute,
+                                          psRef->Date.Minute);
+                            ensure_equals(pszName, psField->Date.Second,
+                                          psRef->Date.Second);
+                            ensure_equals(pszName, psField->Date.TZFlag,
+                                          psRef->Date.TZFlag);
+                            break;
+                        }
+                        default:
+                            break;
+                    }
+                }
+
+                for( int iGeomField = 0;
+                     iGeomField < poDefn->GetGeomFieldCount(); iGeomField++ )
+                {
+                    OGRGeometry* poRefGeom = poRef->GetGeomFieldRef(iGeomField);
+                    size_t nBytes = 0;
+                    const GByte* pabyWKB =
+                        oBatch.GetGeomFieldAsWkb(i, iGeomField, &nBytes);
+                    ensure_equals(poLayer->GetName(), pabyWKB != NULL,
+                                  poRefGeom != NULL);
+                    if( poRefGeom == NULL )
+                        continue;
+
+                    // ISO WKB in the native byte order
+#ifdef CPL_LSB
+                    ensure_equals(poLayer->GetName(), (int)pabyWKB[0],
+                                  (int)wkbNDR);
+#else
+                    ensure_equals(poLayer->GetName(), (int)pabyWKB[0],
+                                  (int)wkbXDR);
+#endif
+                    GUInt32 nGeomType;
+                    memcpy(&nGeomType, pabyWKB + 1, 4);
+                    ensure(poLayer->GetName(), (nGeomType & 0xE0000000U) == 0);
+
+                    OGRGeometry* poGeom = NULL;
+                    ensure_equals(poLayer->GetName(),
+                        OGRGeometryFactory::createFromWkb(
+                            (unsigned char*)pabyWKB, NULL, &poGeom,
+                            (int)nBytes, wkbVariantIso), OGRERR_NONE);
+                    ensure(poLayer->GetName(),
+                           CPL_TO_BOOL(poGeom->Equals(poRefGeom)));
+                    delete poGeom;
+                }
+            }
+        }
+        ensure_equals(poLayer->GetName(), nRead, apoFeatures.size());
+        ensure_equals(poLayer->GetName(),
+                      poLayer->GetNextFeatureBatch(&oBatch), 0);
+
+        for( size_t i = 0; i < apoFeatures.size(); i++ )
+            delete apoFeatures[i];
+    }
+
+    // Test reading GeoPackage and OpenFileGDB layers by batches
+    template<>
+    template<>
+    void object::test<7>()
+    {
+        GDALDriver* poGPKGDriver =
+            GetGDALDriverManager()->GetDriverByName("GPKG");
+        if( poGPKGDriver != NULL )
+        {
+            const char* pszFilename = "/vsimem/test_ogr_7.gpkg";
+            GDALDataset* poDS = poGPKGDriver->Create(pszFilename, 0, 0, 0,
+                                                     GDT_Unknown, NULL);
+            ensure(poDS != NULL);
+            OGRLayer* poLayer = poDS->CreateLayer("test", NULL, wkbUnknown,
+                                                  NULL);
+            ensure(poLayer != NULL);
+            const OGRFieldType aeTypes[] = { OFTInteger, OFTInteger64,
+                                             OFTReal, OFTString, OFTBinary,
+                                             OFTDate, OFTDateTime };
+            const int nFields = (int)(sizeof(aeTypes) / sizeof(aeTypes[0]));
+            for( int i = 0; i < nFields; i++ )
+            {
+                OGRFieldDefn oField(CPLSPrintf("field%d", i), aeTypes[i]);
+                ensure_equals(poLayer->CreateField(&oField), OGRERR_NONE);
+            }
+            const char* apszWKT[] = {
+                "POINT (1 2)", NULL, "POINT (1 2 3)",
+                "POLYGON ((0 0,0 1,1 1,0 0))",
+                "MULTILINESTRING ((0 0 1,1 1 2))", "POINT (3 4)",
+                "GEOMETRYCOLLECTION (POINT (1 2),LINESTRING (0 0,1 1))"
+            };
+            const int nFeatures = (int)(sizeof(apszWKT) / sizeof(apszWKT[0]));
+            for( int i = 0; i < nFeatures; i++ )
+            {
+                OGRFeature oFeature(poLayer->GetLayerDefn());
+                // Leave some fields unset
+                if( i % 3 != 1 )
+                {
+                    oFeature.SetField(0, i);
+                    oFeature.SetField(1, (GIntBig)i << 33);
+                    oFeature.SetField(2, i + 0.5);
+                    oFeature.SetField(3, CPLSPrintf("value %d", i));
+                    GByte abyData[] = { 0, (GByte)i, 255 };
+                    oFeature.SetField(4, 3, abyData);
+                    oFeature.SetField(5, 2016, 1 + i, 2);
+                    oFeature.SetField(6, 2016, 3, 4, 5, 6, 7.5f, 100);
+                }
+                if( apszWKT[i] != NULL )
+                {
+                    OGRGeometry* poGeom = NULL;
+                    char* pszWKT = (char*) apszWKT[i];
+                    OGRGeometryFactory::createFromWkt(&pszWKT, NULL, &poGeom);
+                    oFeature.SetGeometryDirectly(poGeom);
+                }
+                ensure_equals(poLayer->CreateFeature(&oFeature), OGRERR_NONE);
+            }
+
+            // A blob written by another producer: big endian WKB of a
+            // POINT (1 2 3) with the wkb25DBit flag
+            poDS->ExecuteSQL("UPDATE test SET geom = "
+                             "X'47500001000000000080000001"
+                             "3FF0000000000000"
+                             "4000000000000000"
+                             "4008000000000000' WHERE fid = 6", NULL, NULL);
+
+            checkBatchesMatchFeatures(poLayer);
+            delete poDS;
+
+            poDS = (GDALDataset*) GDALOpenEx(pszFilename, GDAL_OF_VECTOR,
+                                             NULL, NULL, NULL);
+            ensure(poDS != NULL);
+            poLayer = poDS->GetLayer(0);
+            checkBatchesMatchFeatures(poLayer);
+            OGRFeature* poFeature = poLayer->GetFeature(6);
+            ensure(poFeature != NULL);
+            ensure(poFeature->GetGeometryRef() != NULL);
+            ensure_equals(poFeature->GetGeometryRef()->getCoordinateDimension(),
+                          3);
+            delete poFeature;
+            delete poDS;
+            VSIUnlink(pszFilename);
+        }
+
+        if( GetGDALDriverManager()->GetDriverByName("OpenFileGDB") != NULL )
+        {
+            std::string osFilename("/vsizip/");
+            osFilename += common::data_basedir;
+            osFilename += SEP;
+            osFilename += "..";
+            osFilename += SEP;
+            osFilename += "..";
+            osFilename += SEP;
+            osFilename += "ogr";
+            osFilename += SEP;
+            osFilename += "data";
+            osFilename += SEP;
+            osFilename += "testopenfilegdb.gdb.zip/testopenfilegdb.gdb";
+            GDALDataset* poDS = (GDALDataset*) GDALOpenEx(osFilename.c_str(),
+                                    GDAL_OF_VECTOR, NULL, NULL, NULL);
+            ensure(osFilename.c_str(), poDS != NULL);
+            ensure(poDS->GetLayerCount() > 0);
+            for( int i = 0; i < poDS->GetLayerCount(); i++ )
+                checkBatchesMatchFeatures(poDS->GetLayer(i));
+            delete poDS;
+        }
+    }
+
+    // Read all the features of a CSV layer, handing them back to the layer
+    // or not
+    static std::vector<OGRFeature*> readCSVFeatures(const char* pszFilename,
+                                                    const char* pszFilter,
+                                                    bool bRecycle)
+    {
+        const char* apszOptions[] = { "X_POSSIBLE_NAMES=x",
+                                      "Y_POSSIBLE_NAMES=y",
+                                      "Z_POSSIBLE_NAMES=z", NULL };
+        GDALDataset* poDS = (GDALDataset*) GDALOpenEx(pszFilename,
+                                GDAL_OF_VECTOR, NULL, apszOptions, NULL);
+        ensure(pszFilename, poDS != NULL);
+        OGRLayer* poLayer = poDS->GetLayer(0);
+        ensure(poLayer != NULL);
+        ensure_equals(poLayer->SetAttributeFilter(pszFilter), OGRERR_NONE);
+
+        // Keep clones, as the features handed back are overwritten
+        std::vector<OGRFeature*> apoFeatures;
+        OGRFeature* poFeature;
+        while( (poFeature = poLayer->GetNextFeature()) != NULL )
+        {
+            apoFeatures.push_back(poFeature->Clone());
+            if( bRecycle )
+                poLayer->RecycleFeature(poFeature);
+            else
+                delete poFeature;
+        }
+        delete poDS;
+        return apoFeatures;
+    }
+
+    // Test that recycled CSV features are identical to fresh ones
+    template<>
+    template<>
+    void object::test<8>()
+    {
+        const char* pszFilename = "/vsimem/test_ogr_8.csv";
+        const char szCSV[] =
+            "id,name,x,y,z,value\n"
+            "1,a rather long string value,1,2,3,1.5\n"
+            "2,short,4,5,,2.5\n"
+            "3,,6,7,8,\n"
+            "4,\"quoted, with a comma\",,,,4.5\n"
+            "5,another rather long string value,9,10,11,5.5\n"
+            "6,x,12,13\n"
+            "7,last,14,15,16,7.5\n";
+        VSILFILE* fp = VSIFOpenL(pszFilename, "wb");
+        ensure(fp != NULL);
+        VSIFWriteL(szCSV, 1, strlen(szCSV), fp);
+        VSIFCloseL(fp);
+
+        // Without and with an attribute filter, whose rejected features are
+        // recycled by the driver
+        const char* apszFilters[] = { NULL, "id <> 2 AND id <> 5" };
+        for( int iFilter = 0; iFilter < 2; iFilter++ )
+        {
+            std::vector<OGRFeature*> apoRef =
+                readCSVFeatures(pszFilename, apszFilters[iFilter], false);
+            std::vector<OGRFeature*> apoRecycled =
+                readCSVFeatures(pszFilename, apszFilters[iFilter], true);
+            ensure_equals("Wrong feature count", apoRecycled.size(), apoRef.size());
+            ensure_equals("Wrong reference count", apoRef.size(),
+                          (size_t)(iFilter == 0 ? 7 : 5));
+            for( size_t i = 0; i < apoRef.size(); i++ )
+            {
+                ensure_equals("Wrong FID", apoRecycled[i]->GetFID(),
+                              apoRef[i]->GetFID());
+                for( int iField = 0; iField < apoRef[i]->GetFieldCount();
+                     iField++ )
+                {
+                    ensure_equals("Wrong field set state",
+                                  CPL_TO_BOOL(apoRecycled[i]->IsFieldSet(iField)),
+                                  CPL_TO_BOOL(apoRef[i]->IsFieldSet(iField)));
+                    ensure_equals("Wrong field value",
+                        std::string(apoRecycled[i]->GetFieldAsString(iField)),
+                        std::string(apoRef[i]->GetFieldAsString(iField)));
+                }
+                OGRGeometry* poRefGeom = apoRef[i]->GetGeometryRef();
+                OGRGeometry* poGeom = apoRecycled[i]->GetGeometryRef();
+                ensure_equals("Wrong geometry presence", poGeom != NULL,
+                              poRefGeom != NULL);
+                if( poRefGeom != NULL )
+                {
+                    ensure_equals("Wrong geometry type",
+                                  poGeom->getGeometryType(),
+                                  poRefGeom->getGeometryType());
+                    ensure("Wrong geometry", CPL_TO_BOOL(poGeom->Equals(poRefGeom)));
+                }
+                delete apoRef[i];
+                delete apoRecycled[i];
+            }
+        }
+
+        VSIUnlink(pszFilename);
+    }
     
 
 } // namespace tut
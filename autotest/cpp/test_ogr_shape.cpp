@@ -414,4 +414,132 @@ namespace tut
         OGR_DS_Destroy(ds);
     }
 
+    static GIntBig get_batch_integer(OGRFeatureBatchH batch, int i, int field)
+    {
+        const int* values = OGR_FB_GetFieldAsIntegerArray(batch, field);
+        if( values != NULL )
+            return values[i];
+        const GIntBig* values64 = OGR_FB_GetFieldAsInteger64Array(batch, field);
+        ensure("Can't get integer values", NULL != values64);
+        return values64[i];
+    }
+
+    // Test reading features by batches
+    template<>
+    template<>
+    void object::test<11>()
+    {
+        std::string source(data_);
+        source += SEP;
+        source += "poly.shp";
+        OGRDataSourceH ds = OGR_Dr_Open(drv_, source.c_str(), false);
+        ensure("Can't open layer", NULL != ds);
+
+        OGRLayerH lyr = OGR_DS_GetLayer(ds, 0);
+        ensure("Can't get layer", NULL != lyr);
+        OGRFeatureDefnH defn = OGR_L_GetLayerDefn(lyr);
+        const int iArea = OGR_FD_GetFieldIndex(defn, "AREA");
+        const int iEasId = OGR_FD_GetFieldIndex(defn, "EAS_ID");
+        const int iPrfedea = OGR_FD_GetFieldIndex(defn, "PRFEDEA");
+
+        // Batch capacity not a divisor of the feature count on purpose
+        OGRFeatureBatchH batch = OGR_FB_Create(defn, 3);
+        int count = 0;
+        int n;
+        while( (n = OGR_L_GetNextFeatureBatch(lyr, batch)) > 0 )
+        {
+            const double* areas = OGR_FB_GetFieldAsDoubleArray(batch, iArea);
+            ensure("Can't get AREA values", NULL != areas);
+            for( int i = 0; i < n; i++ )
+            {
+                OGRFeatureH feat = OGR_L_GetFeature(lyr, OGR_FB_GetFID(batch, i));
+                ensure("Can't fetch feature", NULL != feat);
+                ensure_equals("Wrong FID", OGR_F_GetFID(feat), OGR_FB_GetFID(batch, i));
+                ensure_equals("Wrong AREA", OGR_F_GetFieldAsDouble(feat, iArea), areas[i]);
+                ensure_equals("Wrong EAS_ID",
+                              OGR_F_GetFieldAsInteger64(feat, iEasId),
+                              get_batch_integer(batch, i, iEasId));
+                ensure_equals("Wrong PRFEDEA",
+                              std::string(OGR_F_GetFieldAsString(feat, iPrfedea)),
+                              std::string(OGR_FB_GetFieldAsString(batch, i, iPrfedea)));
+
+                size_t wkbSize = 0;
+                const GByte* wkb = OGR_FB_GetGeomFieldAsWkb(batch, i, 0, &wkbSize);
+                ensure("Can't get WKB", NULL != wkb);
+                OGRGeometryH geom = NULL;
+                OGR_G_CreateFromWkb((unsigned char*)wkb, NULL, &geom, (int)wkbSize);
+                ensure("Can't parse WKB", NULL != geom);
+                ensure_equal_geometries(OGR_F_GetGeometryRef(feat), geom, 0.000000001);
+                OGR_G_DestroyGeometry(geom);
+                OGR_F_Destroy(feat);
+                count++;
+            }
+        }
+        ensure_equals("Wrong feature count", count, 10);
+
+        // With a spatial filter, the generic implementation is used
+        const char* wkt = "LINESTRING(479505 4763195,480526 4762819)";
+        OGRGeometryH filterGeom = NULL;
+        OGR_G_CreateFromWkt((char**) &wkt, NULL, &filterGeom);
+        OGR_L_SetSpatialFilter(lyr, filterGeom);
+        std::vector<GIntBig> expected;
+        OGRFeatureH feat;
+        while( (feat = OGR_L_GetNextFeature(lyr)) != NULL )
+        {
+            expected.push_back(OGR_F_GetFieldAsInteger64(feat, iEasId));
+            OGR_F_Destroy(feat);
+        }
+        ensure("Spatial filter selects no feature", !expected.empty());
+        OGR_L_ResetReading(lyr);
+        ensure_equals("Wrong filtered count", OGR_L_GetNextFeatureBatch(lyr, batch),
+                      (int)expected.size());
+        for( size_t i = 0; i < expected.size(); i++ )
+            ensure_equals("Wrong EAS_ID", get_batch_integer(batch, (int)i, iEasId),
+                          expected[i]);
+        ensure_equals("Expected end of layer", OGR_L_GetNextFeatureBatch(lyr, batch), 0);
+
+        OGR_G_DestroyGeometry(filterGeom);
+        OGR_FB_Destroy(batch);
+        OGR_DS_Destroy(ds);
+    }
+
+    // Test recycling features while reading
+    template<>
+    template<>
+    void object::test<12>()
+    {
+        std::string source(data_);
+        source += SEP;
+        source += "poly.shp";
+        OGRDataSourceH ds = OGR_Dr_Open(drv_, source.c_str(), false);
+        ensure("Can't open layer", NULL != ds);
+
+        OGRLayerH lyr = OGR_DS_GetLayer(ds, 0);
+        ensure("Can't get layer", NULL != lyr);
+
+        OGRFeatureH feat;
+        OGRFeatureH prev = NULL;
+        bool reused = false;
+        int count = 0;
+        while( (feat = OGR_L_GetNextFeature(lyr)) != NULL )
+        {
+            if( feat == prev )
+                reused = true;
+
+            OGRFeatureH ref = OGR_L_GetFeature(lyr, OGR_F_GetFID(feat));
+            ensure("Can't fetch feature", NULL != ref);
+            ensure("Recycled feature differs from fetched one",
+                   OGR_F_Equal(feat, ref) != FALSE);
+            OGR_F_Destroy(ref);
+
+            prev = feat;
+            OGR_L_RecycleFeature(lyr, feat);
+            count++;
+        }
+        ensure_equals("Wrong feature count", count, 10);
+        ensure("Feature was not reused", reused);
+
+        OGR_DS_Destroy(ds);
+    }
+
 } // namespace tut
@@ -576,6 +576,16 @@ int main(int argc, char* argv[])
 
     assert( GDALGetCacheUsed64() == 0 );
 
+    GIntBig nLockAcquisitions = 0;
+    GIntBig nLockContentions = 0;
+    double dfLockWaitTime = 0.0;
+    GDALRasterBlock::GetLockStatistics(&nLockAcquisitions,
+                                       &nLockContentions,
+                                       &dfLockWaitTime);
+    CPLDebug("TEST", "Block cache locks: " CPL_FRMT_GIB " acquisitions, "
+             CPL_FRMT_GIB " contended, %.3f s waited",
+             nLockAcquisitions, nLockContentions, dfLockWaitTime);
+
     GDALDestroyDriverManager();
     CSLDestroy( argv );
 
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Test performance of the overview and RasterIO resampling
+ *           kernels, with and without their SSE2/AVX code paths.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include "gdal.h"
+#include "cpl_conv.h"
+#include "cpl_string.h"
+
+static const int SRC_SIZE = 2048;
+static const int DST_SIZE = SRC_SIZE / 2;
+
+/************************************************************************/
+/*                              Resample()                              */
+/************************************************************************/
+
+static void Resample(GDALDatasetH hSrcDS, GDALDatasetH hDstDS,
+                     const char* pszResampling, int bRasterIO, int nLoops)
+{
+    GDALRasterBandH hSrcBand = GDALGetRasterBand(hSrcDS, 1);
+    GDALRasterBandH hDstBand = GDALGetRasterBand(hDstDS, 1);
+    void* pBuffer = NULL;
+    if( bRasterIO )
+        pBuffer = CPLMalloc(sizeof(float) * DST_SIZE * DST_SIZE);
+
+    for(int i=0;i<nLoops;i++)
+    {
+        if( bRasterIO )
+        {
+            GDALRasterIOExtraArg sExtraArg;
+            INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+            if( EQUAL(pszResampling, "CUBIC") )
+                sExtraArg.eResampleAlg = GRIORA_Cubic;
+            else if( EQUAL(pszResampling, "LANCZOS") )
+                sExtraArg.eResampleAlg = GRIORA_Lanczos;
+            else
+                sExtraArg.eResampleAlg = GRIORA_Average;
+            CPL_IGNORE_RET_VAL(GDALRasterIOEx(hSrcBand, GF_Read,
+                                   0, 0, SRC_SIZE, SRC_SIZE,
+                                   pBuffer, DST_SIZE, DST_SIZE, GDT_Float32,
+                                   0, 0, &sExtraArg));
+            CPL_IGNORE_RET_VAL(GDALRasterIO(hDstBand, GF_Write,
+                                   0, 0, DST_SIZE, DST_SIZE,
+                                   pBuffer, DST_SIZE, DST_SIZE, GDT_Float32,
+                                   0, 0));
+        }
+        else
+        {
+            CPL_IGNORE_RET_VAL(GDALRegenerateOverviews(hSrcBand, 1, &hDstBand,
+                                   pszResampling, NULL, NULL));
+        }
+    }
+
+    CPLFree(pBuffer);
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main(int argc, char* argv[])
+{
+    int nLoops = 5;
+    int nRet = 0;
+
+    argc = GDALGeneralCmdLineProcessor(argc, &argv, 0);
+    for(int i=1;i<argc;i++)
+    {
+        if( EQUAL(argv[i], "-loops") && i+1<argc )
+            nLoops = atoi(argv[++i]);
+        else
+        {
+            printf("Usage: testperfoverview [-loops N]\n");
+            CSLDestroy(argv);
+            return 1;
+        }
+    }
+    CSLDestroy(argv);
+
+    GDALAllRegister();
+    GDALDriverH hMEMDrv = GDALGetDriverByName("MEM");
+
+    const GDALDataType aeTypes[] = { GDT_Byte, GDT_UInt16, GDT_Float32 };
+    const char* const apszResamplings[] = { "CUBIC", "LANCZOS", "AVERAGE" };
+
+    for(size_t iType=0;iType<sizeof(aeTypes)/sizeof(aeTypes[0]);iType++)
+    {
+        const GDALDataType eDT = aeTypes[iType];
+
+        GDALDatasetH hSrcDS = GDALCreate(hMEMDrv, "", SRC_SIZE, SRC_SIZE,
+                                         1, eDT, NULL);
+        GUInt16* panLine = (GUInt16*)CPLMalloc(sizeof(GUInt16) * SRC_SIZE);
+        for(int iY=0;iY<SRC_SIZE;iY++)
+        {
+            for(int iX=0;iX<SRC_SIZE;iX++)
+                panLine[iX] = (GUInt16)(((iX * 7 + iY * 13) ^ (iX * iY)) %
+                                        (eDT == GDT_Byte ? 256 : 65536));
+            CPL_IGNORE_RET_VAL(GDALRasterIO(
+                GDALGetRasterBand(hSrcDS, 1), GF_Write,
+                0, iY, SRC_SIZE, 1, panLine, SRC_SIZE, 1,
+                GDT_UInt16, 0, 0));
+        }
+        CPLFree(panLine);
+
+        for(size_t iResampling=0;
+            iResampling<sizeof(apszResamplings)/sizeof(apszResamplings[0]);
+            iResampling++)
+        {
+          const char* pszResampling = apszResamplings[iResampling];
+          for(int bRasterIO=0;bRasterIO<2;bRasterIO++)
+          {
+            double* apadfResult[2];
+
+            for(int iSIMD=0;iSIMD<2;iSIMD++)
+            {
+                /* GDAL_USE_SSE=NO only disables the SSE2 average kernels: */
+                /* the SSE2 convolution kernels are always used on x86_64. */
+                const char* pszSIMD = (iSIMD == 0) ? "NO" : "YES";
+                CPLSetConfigOption("GDAL_USE_SSE", pszSIMD);
+                CPLSetConfigOption("GDAL_USE_AVX", pszSIMD);
+
+                GDALDatasetH hDstDS = GDALCreate(hMEMDrv, "", DST_SIZE,
+                                                 DST_SIZE, 1, eDT, NULL);
+
+                clock_t start = clock();
+                Resample(hSrcDS, hDstDS, pszResampling, bRasterIO, nLoops);
+                clock_t end = clock();
+
+                printf("%s %s %s (SIMD=%s) : %.2f s\n",
+                       GDALGetDataTypeName(eDT), pszResampling,
+                       bRasterIO ? "RasterIO" : "overview", pszSIMD,
+                       (end - start) * 1.0 / CLOCKS_PER_SEC);
+
+                apadfResult[iSIMD] = (double*)
+                    CPLMalloc(sizeof(double) * DST_SIZE * DST_SIZE);
+                CPL_IGNORE_RET_VAL(GDALRasterIO(GDALGetRasterBand(hDstDS, 1),
+                             GF_Read, 0, 0, DST_SIZE, DST_SIZE,
+                             apadfResult[iSIMD], DST_SIZE, DST_SIZE,
+                             GDT_Float64, 0, 0));
+                GDALClose(hDstDS);
+            }
+
+            /* The SIMD code paths compute the same formulas, but in a */
+            /* different order, so allow for rounding differences. */
+            double dfMaxDiff = 0.0;
+            for(int i=0;i<DST_SIZE * DST_SIZE;i++)
+            {
+                double dfDiff = fabs(apadfResult[0][i] - apadfResult[1][i]);
+                if( eDT == GDT_Float32 )
+                    dfDiff /= MAX(1.0, fabs(apadfResult[0][i]));
+                if( dfDiff > dfMaxDiff )
+                    dfMaxDiff = dfDiff;
+            }
+            if( dfMaxDiff > ((eDT == GDT_Float32) ? 1e-5 : 1.0) )
+            {
+                printf("%s %s %s : results differ by %g with and without "
+                       "SIMD\n",
+                       GDALGetDataTypeName(eDT), pszResampling,
+                       bRasterIO ? "RasterIO" : "overview", dfMaxDiff);
+                nRet = 1;
+            }
+            CPLFree(apadfResult[0]);
+            CPLFree(apadfResult[1]);
+          }
+        }
+
+        GDALClose(hSrcDS);
+    }
+
+    CPLSetConfigOption("GDAL_USE_SSE", NULL);
+    CPLSetConfigOption("GDAL_USE_AVX", NULL);
+
+    GDALDestroyDriverManager();
+
+    return nRet;
+}
@@ -1992,6 +1992,36 @@ def tiff_ovr_50():
 
     return 'success'
 
+###############################################################################
+# Test multi-threaded overview computation (GDAL_NUM_THREADS)
+
+def tiff_ovr_51():
+
+    src_ds = gdal.Open('data/utmsmall.tif')
+    for resampling in [ 'NEAR', 'AVERAGE', 'GAUSS', 'CUBIC', 'MODE' ]:
+        for options in [ [], ['INTERLEAVE=PIXEL'] ]:
+            cs = []
+            for num_threads in [ None, '4' ]:
+                ds = gdaltest.tiff_drv.Create('/vsimem/tiff_ovr_51.tif', 100, 100, 3, options = options)
+                for i in range(3):
+                    ds.GetRasterBand(i+1).WriteRaster(0, 0, 100, 100, src_ds.GetRasterBand(1).ReadRaster(0, 0, 100, 100))
+                gdal.SetConfigOption('GDAL_NUM_THREADS', num_threads)
+                gdal.SetConfigOption('GDAL_TIFF_OVR_BLOCKSIZE', '64')
+                ds.BuildOverviews( resampling, overviewlist = [2,4,8] )
+                gdal.SetConfigOption('GDAL_TIFF_OVR_BLOCKSIZE', None)
+                gdal.SetConfigOption('GDAL_NUM_THREADS', None)
+                cs.append( [ ds.GetRasterBand(i+1).GetOverview(j).Checksum() for i in range(3) for j in range(3) ] )
+                ds = None
+                gdaltest.tiff_drv.Delete('/vsimem/tiff_ovr_51.tif')
+            if cs[0] != cs[1]:
+                gdaltest.post_reason('fail')
+                print(resampling)
+                print(options)
+                print(cs)
+                return 'fail'
+
+    return 'success'
+
 ###############################################################################
 # Cleanup
 
@@ -2087,6 +2117,7 @@ gdaltest_list_internal = [
     tiff_ovr_48,
     tiff_ovr_49,
     tiff_ovr_50,
+    tiff_ovr_51,
     tiff_ovr_cleanup ]
 
 def tiff_ovr_invert_endianness():
@@ -2248,6 +2248,43 @@ def tiff_read_empty_nodata_tag():
 
     return 'success'
 
+###############################################################################
+# Test multi-threaded decompression of tiles/strips (NUM_THREADS open option)
+
+def tiff_read_multi_threaded():
+
+    src_ds = gdal.Open('data/byte.tif')
+    for options in [ ['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16', 'COMPRESS=DEFLATE', 'PREDICTOR=2'],
+                     ['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16', 'COMPRESS=LZW', 'INTERLEAVE=PIXEL'],
+                     ['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16', 'COMPRESS=PACKBITS', 'INTERLEAVE=BAND'],
+                     ['BLOCKYSIZE=3', 'COMPRESS=DEFLATE'] ]:
+        tmp_ds = gdal.GetDriverByName('MEM').Create('', 20, 20, 3)
+        for i in range(3):
+            tmp_ds.GetRasterBand(i+1).WriteRaster(0, 0, 20, 20, src_ds.GetRasterBand(1).ReadRaster(0, 0, 20, 20))
+        gdal.GetDriverByName('GTiff').CreateCopy('/vsimem/tiff_read_multi_threaded.tif', tmp_ds, options = options)
+        tmp_ds = None
+
+        ds = gdal.Open('/vsimem/tiff_read_multi_threaded.tif')
+        expected_data = ds.ReadRaster(1, 2, 18, 17)
+        expected_cs = [ ds.GetRasterBand(i+1).Checksum() for i in range(3) ]
+        ds = None
+
+        ds = gdal.OpenEx('/vsimem/tiff_read_multi_threaded.tif', open_options = ['NUM_THREADS=4'])
+        data = ds.ReadRaster(1, 2, 18, 17)
+        cs = [ ds.GetRasterBand(i+1).Checksum() for i in range(3) ]
+        ds = None
+
+        if data != expected_data or cs != expected_cs:
+            gdaltest.post_reason('fail')
+            print(options)
+            print(cs)
+            print(expected_cs)
+            return 'fail'
+
+    gdal.Unlink('/vsimem/tiff_read_multi_threaded.tif')
+
+    return 'success'
+
 ###############################################################################################
 
 for item in init_list:
@@ -2302,6 +2339,7 @@ gdaltest_list.append( (tiff_read_tiff_metadata) )
 gdaltest_list.append( (tiff_read_irregular_tile_size_jpeg_in_tiff) )
 gdaltest_list.append( (tiff_direct_and_virtual_mem_io) )
 gdaltest_list.append( (tiff_read_empty_nodata_tag) )
+gdaltest_list.append( (tiff_read_multi_threaded) )
 
 gdaltest_list.append( (tiff_read_online_1) )
 gdaltest_list.append( (tiff_read_online_2) )
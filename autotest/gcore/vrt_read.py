@@ -1091,6 +1091,208 @@ def vrt_read_24():
 
     return 'success'
 
+###############################################################################
+# Test a mosaic with many sources, for which a spatial index of the sources
+# is used to select the sources intersecting a request.
+
+def vrt_read_25():
+
+    ds = gdal.Open('data/byte.tif')
+    data = ds.ReadRaster(0,0,20,20,400,400)
+    ds = None
+    ds = gdal.GetDriverByName('GTiff').Create('/vsimem/vrt_read_25.tif',400,400)
+    ds.WriteRaster(0,0,400,400,data)
+    ds = None
+
+    # A background source without DstRect, covered by 20x20 tiles
+    sources = """    <SimpleSource>
+      <SourceFilename>data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+"""
+    for j in range(20):
+        for i in range(20):
+            sources += """    <SimpleSource>
+      <SourceFilename>/vsimem/vrt_read_25.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="%d" yOff="%d" xSize="20" ySize="20" />
+      <DstRect xOff="%d" yOff="%d" xSize="20" ySize="20" />
+    </SimpleSource>
+""" % (i * 20, j * 20, i * 20, j * 20)
+    gdal.FileFromMemBuffer('/vsimem/vrt_read_25.vrt', """<VRTDataset rasterXSize="400" rasterYSize="400">
+  <VRTRasterBand dataType="Byte" band="1">
+%s  </VRTRasterBand>
+</VRTDataset>""" % sources)
+
+    ref_ds = gdal.Open('/vsimem/vrt_read_25.tif')
+    ds = gdal.Open('/vsimem/vrt_read_25.vrt')
+    for (xoff, yoff, xsize, ysize) in [ (0, 0, 400, 400), (0, 0, 1, 1),
+                                        (399, 399, 1, 1), (19, 19, 2, 2),
+                                        (20, 20, 20, 20), (37, 151, 203, 7) ]:
+        ref_data = ref_ds.ReadRaster(xoff, yoff, xsize, ysize)
+        if ds.GetRasterBand(1).ReadRaster(xoff, yoff, xsize, ysize) != ref_data:
+            gdaltest.post_reason('failure')
+            print(xoff, yoff, xsize, ysize)
+            return 'fail'
+        if ds.ReadRaster(xoff, yoff, xsize, ysize) != ref_data:
+            gdaltest.post_reason('failure')
+            print(xoff, yoff, xsize, ysize)
+            return 'fail'
+    ds = None
+    ref_ds = None
+
+    gdal.Unlink('/vsimem/vrt_read_25.vrt')
+    gdal.GetDriverByName('GTiff').Delete('/vsimem/vrt_read_25.tif')
+
+    return 'success'
+
+###############################################################################
+# Test the binary cache of sources (VRT_SOURCE_CACHE=YES)
+
+def vrt_read_26():
+
+    vrt_xml = """<VRTDataset rasterXSize="40" rasterYSize="20">
+  <VRTRasterBand dataType="Float32" band="1">
+    <ComplexSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SourceProperties RasterXSize="20" RasterYSize="20" DataType="Byte" BlockXSize="20" BlockYSize="20" />
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <NODATA>107</NODATA>
+      <LUT>0:0,255:1000</LUT>
+    </ComplexSource>
+    <ComplexSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SourceProperties RasterXSize="20" RasterYSize="20" DataType="Byte" BlockXSize="20" BlockYSize="20" />
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="20" yOff="0" xSize="20" ySize="20" />
+      <ScaleOffset>1.5</ScaleOffset>
+      <ScaleRatio>2.5</ScaleRatio>
+    </ComplexSource>
+  </VRTRasterBand>
+  <VRTRasterBand dataType="Byte" band="2">
+    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SourceProperties RasterXSize="20" RasterYSize="20" DataType="Byte" BlockXSize="20" BlockYSize="20" />
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="10" yOff="0" xSize="20" ySize="20" />
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+    open('tmp/vrt_read_26.vrt', 'wt').write(vrt_xml)
+
+    ds = gdal.Open('tmp/vrt_read_26.vrt')
+    ref_data = ds.ReadRaster(0, 0, 40, 20)
+    ds = None
+
+    gdal.SetConfigOption('VRT_SOURCE_CACHE', 'YES')
+    # First opening writes the cache, second one uses it
+    for i in range(2):
+        ds = gdal.Open('tmp/vrt_read_26.vrt')
+        data = ds.ReadRaster(0, 0, 40, 20)
+        ds = None
+        if data != ref_data:
+            gdal.SetConfigOption('VRT_SOURCE_CACHE', None)
+            gdaltest.post_reason('failure')
+            print(i)
+            return 'fail'
+        if gdal.VSIStatL('tmp/vrt_read_26.vrt.srccache') is None:
+            gdal.SetConfigOption('VRT_SOURCE_CACHE', None)
+            gdaltest.post_reason('failure')
+            return 'fail'
+
+    # A truncated cache must be ignored
+    cache_data = open('tmp/vrt_read_26.vrt.srccache', 'rb').read()
+    open('tmp/vrt_read_26.vrt.srccache', 'wb').write(cache_data[0:-4])
+    ds = gdal.Open('tmp/vrt_read_26.vrt')
+    data = ds.ReadRaster(0, 0, 40, 20)
+    ds = None
+    if data != ref_data:
+        gdal.SetConfigOption('VRT_SOURCE_CACHE', None)
+        gdaltest.post_reason('failure')
+        return 'fail'
+
+    # The cache must be ignored once the VRT is modified
+    # (its size changes, even if its modification time does not)
+    open('tmp/vrt_read_26.vrt', 'wt').write(
+        vrt_xml.replace('<ScaleOffset>1.5</ScaleOffset>', ''))
+    ds = gdal.Open('tmp/vrt_read_26.vrt')
+    data = ds.ReadRaster(0, 0, 40, 20)
+    ds = None
+    gdal.SetConfigOption('VRT_SOURCE_CACHE', None)
+    if data == ref_data:
+        gdaltest.post_reason('failure')
+        return 'fail'
+
+    os.unlink('tmp/vrt_read_26.vrt')
+    os.unlink('tmp/vrt_read_26.vrt.srccache')
+
+    return 'success'
+
+###############################################################################
+# Test concurrent reading of sources (VRT_NUM_THREADS), with overlapping
+# sources and sources with nodata, that must be composited in order
+
+def vrt_read_27():
+
+    sources = ''
+    for j in range(5):
+        for i in range(5):
+            if (i + j) % 2 == 0:
+                sources += """    <SimpleSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SourceProperties RasterXSize="20" RasterYSize="20" DataType="Byte" BlockXSize="20" BlockYSize="20" />
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="%d" yOff="%d" xSize="23" ySize="21" />
+    </SimpleSource>
+""" % (i * 17, j * 15)
+            else:
+                sources += """    <ComplexSource>
+      <SourceFilename relativeToVRT="0">data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="20" ySize="20" />
+      <DstRect xOff="%d" yOff="%d" xSize="20" ySize="20" />
+      <NODATA>107</NODATA>
+      <ScaleRatio>0.5</ScaleRatio>
+    </ComplexSource>
+""" % (i * 17, j * 15)
+    vrt_xml = """<VRTDataset rasterXSize="100" rasterYSize="80">
+  <VRTRasterBand dataType="Byte" band="1">
+%s  </VRTRasterBand>
+</VRTDataset>""" % sources
+
+    windows = [ (0, 0, 100, 80, 100, 80), (0, 0, 100, 80, 33, 27),
+                (5, 3, 60, 50, 120, 100), (16, 14, 3, 3, 3, 3) ]
+    ds = gdal.Open(vrt_xml)
+    ref_data = [ ds.ReadRaster(xoff, yoff, xsize, ysize, bufxsize, bufysize)
+                 for (xoff, yoff, xsize, ysize, bufxsize, bufysize) in windows ]
+    ds = None
+
+    gdal.SetConfigOption('VRT_NUM_THREADS', '4')
+    ds = gdal.Open(vrt_xml)
+    data = [ ds.ReadRaster(xoff, yoff, xsize, ysize, bufxsize, bufysize)
+             for (xoff, yoff, xsize, ysize, bufxsize, bufysize) in windows ]
+    ds = None
+    # Jobs run in this thread must not leave their setting behind
+    num_threads = gdal.GetConfigOption('VRT_NUM_THREADS')
+    gdal.SetConfigOption('VRT_NUM_THREADS', None)
+    if num_threads != '4':
+        gdaltest.post_reason('failure')
+        print(num_threads)
+        return 'fail'
+
+    for i in range(len(windows)):
+        if data[i] != ref_data[i]:
+            gdaltest.post_reason('failure')
+            print(windows[i])
+            return 'fail'
+
+    return 'success'
+
 for item in init_list:
     ut = gdaltest.GDALTest( 'VRT', item[0], item[1], item[2] )
     if ut is None:
@@ -1122,6 +1324,9 @@ gdaltest_list.append( vrt_read_21 )
 gdaltest_list.append( vrt_read_22 )
 gdaltest_list.append( vrt_read_23 )
 gdaltest_list.append( vrt_read_24 )
+gdaltest_list.append( vrt_read_25 )
+gdaltest_list.append( vrt_read_26 )
+gdaltest_list.append( vrt_read_27 )
 
 if __name__ == '__main__':
 
@@ -28,6 +28,8 @@
 # DEALINGS IN THE SOFTWARE.
 ###############################################################################
 
+import os
+import shutil
 import sys
 from osgeo import gdal
 from osgeo import ogr
@@ -36,6 +38,8 @@ from sys import version_info
 sys.path.append( '../pymod' )
 
 import gdaltest
+import webserver
+import test_cli_utilities
 
 ###############################################################################
 #
@@ -285,6 +289,265 @@ def vsicurl_11():
 
     return 'success'
 
+###############################################################################
+def vsicurl_start_webserver():
+
+    gdaltest.webserver_process = None
+    gdaltest.webserver_port = 0
+
+    try:
+        drv = gdal.GetDriverByName( 'HTTP' )
+    except:
+        drv = None
+
+    if drv is None:
+        return 'skip'
+
+    (gdaltest.webserver_process, gdaltest.webserver_port) = webserver.launch()
+    if gdaltest.webserver_port == 0:
+        return 'skip'
+
+    return 'success'
+
+###############################################################################
+# Test the ReadMultiRange() strategies (GTiff direct IO reads one range per
+# scanline) against the local server
+
+def vsicurl_12():
+
+    if gdaltest.webserver_port == 0:
+        return 'skip'
+
+    ref_ds = gdal.Open('data/byte.tif')
+    ref_data = ref_ds.GetRasterBand(1).ReadRaster(2, 3, 10, 12)
+    ref_ds = None
+
+    gdal.SetConfigOption('GDAL_DISABLE_READDIR_ON_OPEN', 'YES')
+    gdal.SetConfigOption('GTIFF_DIRECT_IO', 'YES')
+    for (strategy, gap) in [ ('PARALLEL', '0'), ('PARALLEL', '4096'),
+                             ('SERIAL', '0'), ('SINGLE_GET', '0') ]:
+        gdal.SetConfigOption('CPL_VSIL_CURL_MULTIRANGE', strategy)
+        gdal.SetConfigOption('CPL_VSIL_CURL_MULTIRANGE_MAX_GAP', gap)
+        gdal.SetConfigOption('CPL_VSIL_CURL_MAX_CONCURRENT_RANGES', '3')
+        ds = gdal.Open('/vsicurl/http://127.0.0.1:%d/vsicurl_data/byte.tif' % gdaltest.webserver_port)
+        if ds is None:
+            gdaltest.post_reason('fail')
+            data = None
+        else:
+            data = ds.GetRasterBand(1).ReadRaster(2, 3, 10, 12)
+        ds = None
+        if data != ref_data:
+            gdaltest.post_reason('fail')
+            print(strategy, gap)
+            break
+    gdal.SetConfigOption('GDAL_DISABLE_READDIR_ON_OPEN', None)
+    gdal.SetConfigOption('GTIFF_DIRECT_IO', None)
+    gdal.SetConfigOption('CPL_VSIL_CURL_MULTIRANGE', None)
+    gdal.SetConfigOption('CPL_VSIL_CURL_MULTIRANGE_MAX_GAP', None)
+    gdal.SetConfigOption('CPL_VSIL_CURL_MAX_CONCURRENT_RANGES', None)
+
+    if data != ref_data:
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test the persistent disk cache: a second process must get the chunks
+# downloaded by a first one from the cache directory, corrupted chunks must
+# be removed, a change of the remote file must invalidate its chunks, and the
+# least recently used chunks must be removed when the cache is too large
+
+def vsicurl_13_cache_files(cache_dir):
+
+    files = []
+    for (dirpath, dirnames, filenames) in os.walk(cache_dir):
+        for filename in filenames:
+            files.append(os.path.join(dirpath, filename))
+    return files
+
+def vsicurl_13():
+
+    if gdaltest.webserver_port == 0:
+        return 'skip'
+    if test_cli_utilities.get_gdalinfo_path() is None:
+        return 'skip'
+
+    cache_dir = 'tmp/vsicurl_cache'
+    shutil.rmtree(cache_dir, ignore_errors = True)
+
+    url = '/vsicurl/http://127.0.0.1:%d/vsicurl_data/byte.tif' % gdaltest.webserver_port
+    cmd = test_cli_utilities.get_gdalinfo_path() + ' -checksum ' + url + \
+          ' --config GDAL_DISABLE_READDIR_ON_OPEN YES' + \
+          ' --config CPL_VSIL_CURL_CACHE_DIR ' + cache_dir + ' --debug on'
+
+    ret = gdaltest.runexternal(cmd, check_memleak = False)
+    if ret.find('Checksum=4672') < 0:
+        gdaltest.post_reason('fail')
+        print(ret)
+        return 'fail'
+
+    files = vsicurl_13_cache_files(cache_dir)
+    if len(files) == 0:
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    (ret, err) = gdaltest.runexternal_out_and_err(cmd, check_memleak = False)
+    if ret.find('Checksum=4672') < 0 or err.find('from disk') < 0:
+        gdaltest.post_reason('fail')
+        print(ret)
+        print(err)
+        return 'fail'
+
+    # Corrupt the data of the cached chunks
+    for filename in files:
+        f = open(filename, 'rb+')
+        f.seek(-1, 2)
+        c = bytearray(f.read(1))
+        c[0] = c[0] ^ 0xff
+        f.seek(-1, 2)
+        f.write(c)
+        f.close()
+
+    (ret, err) = gdaltest.runexternal_out_and_err(cmd, check_memleak = False)
+    if ret.find('Checksum=4672') < 0 or \
+       err.find('Removing invalid disk cache file') < 0 or \
+       err.find('from disk') >= 0:
+        gdaltest.post_reason('fail')
+        print(ret)
+        print(err)
+        return 'fail'
+
+    # The webserver derives the ETag from the modification time of the file:
+    # the chunks cached for the previous one must not be used
+    files = vsicurl_13_cache_files(cache_dir)
+    data_filename = 'data/byte.tif'
+    st = os.stat(data_filename)
+    os.utime(data_filename, (st.st_atime, st.st_mtime + 10))
+    try:
+        (ret, err) = gdaltest.runexternal_out_and_err(cmd, check_memleak = False)
+    finally:
+        os.utime(data_filename, (st.st_atime, st.st_mtime))
+    if ret.find('Checksum=4672') < 0 or err.find('from disk') >= 0:
+        gdaltest.post_reason('fail')
+        print(ret)
+        print(err)
+        return 'fail'
+    if len(vsicurl_13_cache_files(cache_dir)) <= len(files):
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    # stefan_full_rgba.tif spans 6 chunks: with a cache of 50000 bytes, the
+    # oldest ones must be removed while it is read
+    url = '/vsicurl/http://127.0.0.1:%d/vsicurl_data/stefan_full_rgba.tif' % gdaltest.webserver_port
+    cmd = test_cli_utilities.get_gdalinfo_path() + ' -checksum ' + url + \
+          ' --config GDAL_DISABLE_READDIR_ON_OPEN YES' + \
+          ' --config CPL_VSIL_CURL_CACHE_DIR ' + cache_dir + \
+          ' --config CPL_VSIL_CURL_DISK_CACHE_SIZE 50000 --debug on'
+    (ret, err) = gdaltest.runexternal_out_and_err(cmd, check_memleak = False)
+    total_size = 0
+    for filename in vsicurl_13_cache_files(cache_dir):
+        total_size += os.stat(filename).st_size
+    shutil.rmtree(cache_dir, ignore_errors = True)
+    if ret.find('Checksum=12603') < 0 or err.find('Removed') < 0 or \
+       total_size > 50000:
+        gdaltest.post_reason('fail')
+        print(total_size)
+        print(ret)
+        print(err)
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test the LRU eviction of the in-memory chunk cache: with a cache of two
+# chunks, downloads are limited to two chunks and reading the file a second
+# time downloads it again, whereas with the default cache it is only served
+# from the cache
+
+def vsicurl_14():
+
+    if gdaltest.webserver_port == 0:
+        return 'skip'
+    if test_cli_utilities.get_gdalinfo_path() is None:
+        return 'skip'
+
+    # stefan_full_rgba.tif spans 6 chunks of 16384 bytes. With GDAL_CACHEMAX
+    # set to 0, -stats and -checksum both read the whole file
+    url = '/vsicurl/http://127.0.0.1:%d/vsicurl_data/stefan_full_rgba.tif' % gdaltest.webserver_port
+    cmd = test_cli_utilities.get_gdalinfo_path() + ' -stats -checksum ' + url + \
+          ' --config GDAL_DISABLE_READDIR_ON_OPEN YES' + \
+          ' --config GDAL_CACHEMAX 0'
+
+    # The cache statistics are emitted when the file manager is cleaned up,
+    # after the configuration options set with --debug have been freed
+    old_debug = os.environ.get('CPL_DEBUG')
+    os.environ['CPL_DEBUG'] = 'ON'
+    outputs = []
+    for cache_size in [ None, '40000' ]:
+        if cache_size is None:
+            outputs.append(gdaltest.runexternal_out_and_err(cmd, check_memleak = False))
+        else:
+            outputs.append(gdaltest.runexternal_out_and_err(
+                cmd + ' --config CPL_VSIL_CURL_CACHE_SIZE ' + cache_size,
+                check_memleak = False))
+    if old_debug is None:
+        del os.environ['CPL_DEBUG']
+    else:
+        os.environ['CPL_DEBUG'] = old_debug
+
+    misses = []
+    for i in range(2):
+        (ret, err) = outputs[i]
+        if ret.find('Checksum=12603') < 0:
+            gdaltest.post_reason('fail')
+            print(ret)
+            print(err)
+            return 'fail'
+
+        pos = err.find('Chunk cache: ')
+        if pos < 0:
+            gdaltest.post_reason('fail')
+            print(err)
+            return 'fail'
+        fields = err[pos:].split(' ')
+        hits = int(fields[2])
+        misses.append(int(fields[4]))
+        if hits == 0:
+            gdaltest.post_reason('fail')
+            print(err)
+            return 'fail'
+
+        if i == 1:
+            # GetMaxBlocksPerDownload(): 40000 bytes only fit 2 chunks
+            for line in err.split('\n'):
+                pos = line.find('Downloading ')
+                if pos < 0:
+                    continue
+                (start, end) = line[pos + len('Downloading '):].split(' ')[0].split('-')
+                if int(end) - int(start) + 1 > 2 * 16384:
+                    gdaltest.post_reason('fail')
+                    print(line)
+                    return 'fail'
+
+    # Each chunk is missed once with the default cache, and again during
+    # the second read when the cache is too small to hold the file
+    if misses[1] <= misses[0]:
+        gdaltest.post_reason('fail')
+        print(misses)
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+def vsicurl_stop_webserver():
+
+    if gdaltest.webserver_port == 0:
+        return 'skip'
+
+    webserver.server_stop(gdaltest.webserver_process, gdaltest.webserver_port)
+
+    return 'success'
+
 gdaltest_list = [ vsicurl_1,
                   #vsicurl_2,
                   #vsicurl_3,
@@ -295,7 +558,12 @@ gdaltest_list = [ vsicurl_1,
                   #vsicurl_8,
                   vsicurl_9,
                   vsicurl_10,
-                  vsicurl_11 ]
+                  vsicurl_11,
+                  vsicurl_start_webserver,
+                  vsicurl_12,
+                  vsicurl_13,
+                  vsicurl_14,
+                  vsicurl_stop_webserver ]
 
 if __name__ == '__main__':
 
@@ -189,6 +189,104 @@ def vrtderived_4():
 
     return 'success'
 
+###############################################################################
+# Check built-in pixel function expressions
+
+def vrtderived_5():
+
+    xml = """<VRTDataset rasterXSize="20" rasterYSize="20">
+  <VRTRasterBand dataType="Float32" band="1" subClass="VRTDerivedRasterBand">
+    <NoDataValue>-1</NoDataValue>
+    <PixelFunctionExpression>%s</PixelFunctionExpression>
+    <SimpleSource>
+      <SourceFilename>data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+    </SimpleSource>
+    <SimpleSource>
+      <SourceFilename>data/byte.tif</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="10" ySize="20"/>
+      <DstRect xOff="0" yOff="0" xSize="10" ySize="20"/>
+    </SimpleSource>
+  </VRTRasterBand>
+</VRTDataset>"""
+
+    ref_ds = gdal.Open('data/byte.tif')
+    ref = ref_ds.GetRasterBand(1).ReadAsArray()
+    ref_ds = None
+
+    tests = [ ('B1 * 2 + 1', lambda a, b: a * 2 + 1),
+              ('(B1 - 100) / (B1 + 100)',
+               lambda a, b: float(a - 100) / (a + 100)),
+              ('B1 &gt; 120 &amp;&amp; B1 &lt; 200 ? 1 : 0',
+               lambda a, b: 1 if a > 120 and a < 200 else 0),
+              ('isnodata(B2) ? NODATA : max(B1, 140) - 2^2',
+               lambda a, b: -1 if b == -1 else max(a, 140) - 4),
+              ('sqrt(abs(-B1))', lambda a, b: a ** 0.5) ]
+
+    for (expr, func) in tests:
+        ds = gdal.Open(xml % expr)
+        if ds is None:
+            gdaltest.post_reason('fail')
+            print(expr)
+            return 'fail'
+        data = ds.GetRasterBand(1).ReadAsArray()
+        ds = None
+        for y in range(20):
+            for x in range(20):
+                b2 = ref[y][x] if x < 10 else -1
+                expected = func(float(ref[y][x]), b2)
+                if abs(data[y][x] - expected) > 1e-5:
+                    gdaltest.post_reason('fail')
+                    print(expr, x, y, data[y][x], expected)
+                    return 'fail'
+
+    # Pixels with a nodata source are nodata with PropagateNoData
+    ds = gdal.Open((xml % 'B1 + B2').replace(
+        '<NoDataValue>', '<PropagateNoData>YES</PropagateNoData><NoDataValue>'))
+    data = ds.GetRasterBand(1).ReadAsArray()
+    if data[0][0] != 2 * ref[0][0] or data[0][10] != -1:
+        gdaltest.post_reason('fail')
+        print(data[0][0], data[0][10])
+        return 'fail'
+
+    # Serialization
+    ds = gdal.GetDriverByName('VRT').CreateCopy('tmp/derived.vrt', ds)
+    ds = None
+    xmlstring = open('tmp/derived.vrt').read()
+    gdal.Unlink('tmp/derived.vrt')
+    if xmlstring.find('<PixelFunctionExpression>B1 + B2</PixelFunctionExpression>') < 0 or \
+       xmlstring.find('<PropagateNoData>YES</PropagateNoData>') < 0:
+        gdaltest.post_reason('fail')
+        print(xmlstring)
+        return 'fail'
+
+    # Invalid expressions
+    for expr in [ 'B1 +', 'foo(B1)', 'B0', 'B3', 'min(B1)', '(B1', 'B1 ? 1' ]:
+        gdal.PushErrorHandler('CPLQuietErrorHandler')
+        ds = gdal.Open(xml % expr)
+        gdal.PopErrorHandler()
+        if ds is not None:
+            gdaltest.post_reason('fail')
+            print(expr)
+            return 'fail'
+
+    # Deeply nested expressions must be rejected without exhausting the stack
+    for expr in [ 'B1?1:' * 1000000 + '0', '(' * 1000000 + 'B1',
+                  '-' * 1000000 + 'B1', 'abs(' * 1000000 + 'B1' ]:
+        gdal.ErrorReset()
+        gdal.PushErrorHandler('CPLQuietErrorHandler')
+        ds = gdal.Open(xml % expr)
+        gdal.PopErrorHandler()
+        if ds is not None or \
+           gdal.GetLastErrorMsg().find('too deeply nested') < 0:
+            gdaltest.post_reason('fail')
+            print(expr[0:20])
+            print(gdal.GetLastErrorMsg())
+            return 'fail'
+
+    return 'success'
+
 ###############################################################################
 # Cleanup.
 
@@ -204,6 +302,7 @@ gdaltest_list = [
     vrtderived_2,
     vrtderived_3,
     vrtderived_4,
+    vrtderived_5,
     vrtderived_cleanup,
 ]
 
@@ -516,6 +516,44 @@ def ogr_join_22():
 
     return 'success'
 
+###############################################################################
+# Check that the hash join, with and without spilling to disk, returns the
+# same result as the attribute filter based join.
+
+def ogr_join_23():
+
+    sql = 'SELECT p.*, il.name, il2.name FROM poly p ' \
+        + 'LEFT JOIN idlink il ON p.eas_id = il.eas_id ' \
+        + 'LEFT JOIN idlink2 il2 ON p.eas_id = il2.eas_id'
+
+    results = []
+    for (hash_join, max_memory) in [ ('NO', None), ('YES', None), ('YES', '0') ]:
+        gdal.SetConfigOption('OGR_SQL_HASH_JOIN', hash_join)
+        gdal.SetConfigOption('OGR_SQL_HASH_JOIN_MAX_MEMORY', max_memory)
+        sql_lyr = gdaltest.ds.ExecuteSQL(sql)
+        gdal.SetConfigOption('OGR_SQL_HASH_JOIN', None)
+        gdal.SetConfigOption('OGR_SQL_HASH_JOIN_MAX_MEMORY', None)
+
+        res = []
+        for feat in sql_lyr:
+            res.append( [ feat.GetFID(), feat.GetField('il.name'),
+                          feat.GetField('il2.name'),
+                          feat.GetGeometryRef().ExportToWkt() ] )
+        gdaltest.ds.ReleaseResultSet( sql_lyr )
+        results.append(res)
+
+    if len(results[0]) != 10:
+        gdaltest.post_reason('fail')
+        print(results[0])
+        return 'fail'
+
+    if results[1] != results[0] or results[2] != results[0]:
+        gdaltest.post_reason('fail')
+        print(results)
+        return 'fail'
+
+    return 'success'
+
 ###############################################################################
 
 def ogr_join_cleanup():
@@ -547,6 +585,7 @@ gdaltest_list = [
     ogr_join_20,
     ogr_join_21,
     ogr_join_22,
+    ogr_join_23,
     ogr_join_cleanup ]
 
 if __name__ == '__main__':
@@ -1512,6 +1512,85 @@ def ogr_sql_47():
 
     return 'success'
 
+###############################################################################
+# Test ORDER BY with sorted runs spilled to temporary files
+
+def ogr_sql_48():
+
+    sql = 'SELECT eas_id, prfedea FROM poly ORDER BY prfedea DESC, eas_id'
+
+    sql_lyr = gdaltest.ds.ExecuteSQL( sql )
+    expect = [ f.GetField('eas_id') for f in sql_lyr ]
+    gdaltest.ds.ReleaseResultSet( sql_lyr )
+
+    for max_memory in [ '0', '1' ]:
+        gdal.SetConfigOption('OGR_SQL_ORDER_BY_MAX_MEMORY', max_memory)
+        sql_lyr = gdaltest.ds.ExecuteSQL( sql )
+        gdal.SetConfigOption('OGR_SQL_ORDER_BY_MAX_MEMORY', None)
+
+        tr = ogrtest.check_features_against_list( sql_lyr, 'eas_id', expect )
+        if tr and sql_lyr.GetFeatureCount() != len(expect):
+            gdaltest.post_reason('fail')
+            tr = 0
+        # Going backward restarts the merge of the runs
+        if tr and sql_lyr.GetFeature(2).GetField('eas_id') != expect[2]:
+            gdaltest.post_reason('fail')
+            tr = 0
+        gdaltest.ds.ReleaseResultSet( sql_lyr )
+
+        if not tr:
+            print(max_memory)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Test LIMIT and OFFSET
+
+def ogr_sql_49():
+
+    sql_lyr = gdaltest.ds.ExecuteSQL( 'SELECT eas_id FROM poly ORDER BY eas_id' )
+    all_ids = [ f.GetField('eas_id') for f in sql_lyr ]
+    gdaltest.ds.ReleaseResultSet( sql_lyr )
+
+    for (clause, expect) in [ ('LIMIT 3', all_ids[0:3]),
+                              ('LIMIT 3 OFFSET 2', all_ids[2:5]),
+                              ('OFFSET 8', all_ids[8:]),
+                              ('LIMIT 0', []),
+                              ('LIMIT 100 OFFSET 100', []) ]:
+        for max_memory in [ None, '0' ]:
+            gdal.SetConfigOption('OGR_SQL_ORDER_BY_MAX_MEMORY', max_memory)
+            sql_lyr = gdaltest.ds.ExecuteSQL(
+                'SELECT eas_id FROM poly ORDER BY eas_id ' + clause )
+            gdal.SetConfigOption('OGR_SQL_ORDER_BY_MAX_MEMORY', None)
+
+            tr = ogrtest.check_features_against_list( sql_lyr, 'eas_id', expect )
+            if tr and sql_lyr.GetFeatureCount() != len(expect):
+                gdaltest.post_reason('fail')
+                tr = 0
+            gdaltest.ds.ReleaseResultSet( sql_lyr )
+            if not tr:
+                print(clause, max_memory)
+                return 'fail'
+
+    # Without ORDER BY, and with a filter evaluated on the result layer
+    sql_lyr = gdaltest.ds.ExecuteSQL( 'SELECT eas_id FROM poly LIMIT 2 OFFSET 1' )
+    if sql_lyr.GetFeatureCount() != 2:
+        gdaltest.post_reason('fail')
+        return 'fail'
+    sql_lyr.SetAttributeFilter( 'eas_id > 0' )
+    if sql_lyr.GetFeatureCount() != 2:
+        gdaltest.post_reason('fail')
+        return 'fail'
+    gdaltest.ds.ReleaseResultSet( sql_lyr )
+
+    sql_lyr = gdaltest.ds.ExecuteSQL( 'SELECT DISTINCT eas_id FROM poly ORDER BY eas_id LIMIT 2 OFFSET 1' )
+    tr = ogrtest.check_features_against_list( sql_lyr, 'eas_id', all_ids[1:3] )
+    gdaltest.ds.ReleaseResultSet( sql_lyr )
+    if not tr:
+        return 'fail'
+
+    return 'success'
 
 def ogr_sql_cleanup():
     gdaltest.lyr = None
@@ -1569,6 +1648,8 @@ gdaltest_list = [
     ogr_sql_45,
     ogr_sql_46,
     ogr_sql_47,
+    ogr_sql_48,
+    ogr_sql_49,
     ogr_sql_cleanup ]
 
 if __name__ == '__main__':
@@ -35,6 +35,7 @@ except:
     from http.server import BaseHTTPRequestHandler, HTTPServer
 from threading import Thread
 
+import os
 import time
 import sys
 import gdaltest
@@ -42,17 +43,76 @@ from sys import version_info
 
 do_log = False
 
+# Files of autotest/gcore/data served, with Range support, under /vsicurl_data/
+def get_vsicurl_data_filename(path):
+    if not path.startswith('/vsicurl_data/'):
+        return None
+    filename = path[len('/vsicurl_data/'):]
+    if filename.find('/') >= 0 or filename.find('..') >= 0:
+        return None
+    filename = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'gcore', 'data', filename)
+    if not os.path.isfile(filename):
+        return None
+    return filename
+
 class GDAL_Handler(BaseHTTPRequestHandler):
 
     def log_request(self, code='-', size='-'):
         return
 
+    def send_vsicurl_data(self, filename):
+        f = open(filename, 'rb')
+        data = f.read()
+        f.close()
+
+        self.protocol_version = 'HTTP/1.1'
+        if 'Range' not in self.headers:
+            self.send_response(200)
+            self.send_header('Content-Length', len(data))
+            self.end_headers()
+            self.wfile.write(data)
+            return
+
+        ranges = []
+        for r in self.headers['Range'][len('bytes='):].split(','):
+            (start, end) = r.split('-')
+            ranges.append((int(start), min(int(end), len(data) - 1)))
+
+        if len(ranges) == 1:
+            (start, end) = ranges[0]
+            self.send_response(206)
+            self.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, len(data)))
+            self.send_header('Content-Length', end - start + 1)
+            self.end_headers()
+            self.wfile.write(data[start:end+1])
+            return
+
+        content = ''.encode('ascii')
+        for (start, end) in ranges:
+            content += ('--boundary\r\nContent-Range: bytes %d-%d/%d\r\n\r\n' % (start, end, len(data))).encode('ascii')
+            content += data[start:end+1] + '\r\n'.encode('ascii')
+        content += '--boundary--\r\n'.encode('ascii')
+        self.send_response(206)
+        self.send_header('Content-Type', 'multipart/byteranges; boundary=boundary')
+        self.send_header('Content-Length', len(content))
+        self.end_headers()
+        self.wfile.write(content)
+
     def do_HEAD(self):
         if do_log:
             f = open('/tmp/log.txt', 'a')
             f.write('HEAD %s\n' % self.path)
             f.close()
 
+        filename = get_vsicurl_data_filename(self.path)
+        if filename is not None:
+            self.protocol_version = 'HTTP/1.1'
+            self.send_response(200)
+            self.send_header('Content-Length', os.path.getsize(filename))
+            self.send_header('ETag', '"%d-%d"' % (os.path.getsize(filename), int(os.path.getmtime(filename))))
+            self.end_headers()
+            return
+
         if self.path == '/s3_fake_bucket/resource2.bin':
             self.send_response(200)
             self.send_header('Content-type', 'text/plain')
@@ -294,6 +354,11 @@ class GDAL_Handler(BaseHTTPRequestHandler):
                 self.server.stop_requested = True
                 return
 
+            filename = get_vsicurl_data_filename(self.path)
+            if filename is not None:
+                self.send_vsicurl_data(filename)
+                return
+
             if self.path == '/s3_delete_bucket/delete_file' and getattr(self.server, 'has_requested_s3_delete_bucket_delete_file', None) is None:
                 self.server.has_requested_s3_delete_bucket_delete_file = True
                 self.protocol_version = 'HTTP/1.1'
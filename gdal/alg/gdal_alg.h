@@ -225,6 +225,9 @@ GDALCreateApproxTransformer( GDALTransformerFunc pfnRawTransformer,
 void CPL_DLL GDALApproxTransformerOwnsSubtransformer( void *pCBData, 
                                                       int bOwnFlag );
 void CPL_DLL GDALDestroyApproxTransformer( void *pApproxArg );
+int  CPL_DLL GDALApproxTransformerBuildGrid( void *pApproxArg,
+                                             int nXSize, int nYSize,
+                                             int nStep );
 int  CPL_DLL GDALApproxTransform(
     void *pTransformArg, int bDstToSrc, int nPointCount,
     double *x, double *y, double *z, int *panSuccess );
@@ -37,6 +37,7 @@
 #include "gdal_alg_priv.h"
 #include "cpl_list.h"
 #include "cpl_multiproc.h"
+#include "cpl_atomic_ops.h"
 
 CPL_CVSID("$Id$");
 CPL_C_START
@@ -2486,6 +2487,29 @@ GDALDeserializeReprojectionTransformer( CPLXMLNode *psTree )
 /* ==================================================================== */
 /************************************************************************/
 
+/* Destination to source transformations precomputed at the nodes of a */
+/* regular grid over the destination pixel/line space. It is read-only  */
+/* once built, and shared by the clones of the approximate transformer. */
+typedef struct
+{
+    volatile int      nRefCount;
+
+    int               nXSize;
+    int               nYSize;
+    int               nStep;
+    int               nCellsX;
+    int               nCellsY;
+
+    /* (nCellsX+1) * (nCellsY+1) nodes */
+    double           *padfX;
+    double           *padfY;
+    double           *padfZ;
+
+    /* nCellsX * nCellsY cells, TRUE if bilinear interpolation of the */
+    /* nodes is within the error threshold. */
+    GByte            *pabyCellOK;
+} ApproxTransformGrid;
+
 typedef struct 
 {
     GDALTransformerInfo sTI;
@@ -2495,8 +2519,27 @@ typedef struct
     double	      dfMaxError;
 
     int               bOwnSubtransformer;
+
+    ApproxTransformGrid *psGrid;
 } ApproxTransformInfo;
 
+/************************************************************************/
+/*                    GDALReleaseApproxTransformGrid()                  */
+/************************************************************************/
+
+static void GDALReleaseApproxTransformGrid( ApproxTransformGrid *psGrid )
+
+{
+    if( psGrid == NULL || CPLAtomicDec(&(psGrid->nRefCount)) != 0 )
+        return;
+
+    CPLFree( psGrid->padfX );
+    CPLFree( psGrid->padfY );
+    CPLFree( psGrid->padfZ );
+    CPLFree( psGrid->pabyCellOK );
+    CPLFree( psGrid );
+}
+
 /************************************************************************/
 /*                  GDALCreateSimilarApproxTransformer()                */
 /************************************************************************/
@@ -2526,6 +2569,16 @@ void* GDALCreateSimilarApproxTransformer( void *hTransformArg, double dfSrcRatio
     }
     psClonedInfo->bOwnSubtransformer = TRUE;
 
+    /* The grid is expressed in destination pixel/line coordinates, and */
+    /* the source ones of the clone are scaled by the ratios. */
+    if( psClonedInfo->psGrid != NULL )
+    {
+        if( dfSrcRatioX == 1.0 && dfSrcRatioY == 1.0 )
+            CPLAtomicInc(&(psClonedInfo->psGrid->nRefCount));
+        else
+            psClonedInfo->psGrid = NULL;
+    }
+
     return psClonedInfo;
 }
 
@@ -2618,6 +2671,7 @@ void *GDALCreateApproxTransformer( GDALTransformerFunc pfnBaseTransformer,
     psATInfo->pBaseCBData = pBaseTransformArg;
     psATInfo->dfMaxError = dfMaxError;
     psATInfo->bOwnSubtransformer = FALSE;
+    psATInfo->psGrid = NULL;
 
     memcpy( psATInfo->sTI.abySignature, GDAL_GTI2_SIGNATURE, strlen(GDAL_GTI2_SIGNATURE) );
     psATInfo->sTI.pszClassName = "GDALApproxTransformer";
@@ -2665,9 +2719,287 @@ void GDALDestroyApproxTransformer( void * pCBData )
     if( psATInfo->bOwnSubtransformer ) 
         GDALDestroyTransformer( psATInfo->pBaseCBData );
 
+    GDALReleaseApproxTransformGrid( psATInfo->psGrid );
+
     CPLFree( pCBData );
 }
 
+/************************************************************************/
+/*                   GDALApproxTransformerBuildGrid()                   */
+/************************************************************************/
+
+/**
+ * Precompute the approximate transformer on a grid.
+ *
+ * The destination to source transformation is computed with the base
+ * transformer at the nodes of a grid of nStep x nStep pixel cells covering
+ * the [0,nXSize]x[0,nYSize] destination pixel/line space, as well as at the
+ * middle of the cells and of their edges. Cells where the bilinear
+ * interpolation of their corners is within the maximum error of the
+ * approximate transformer at those check points are then transformed by
+ * interpolation, whatever the pattern of the points passed to
+ * GDALApproxTransform(). Calls with points outside of the grid, or in other
+ * cells, use the usual scanline approximation.
+ *
+ * The grid is shared with the transformers created from this one with
+ * GDALCloneTransformer(), and can thus be used by several chunks or threads
+ * of a warping operation. It is not serialized.
+ *
+ * Calling this function again with the same parameters is a no-op, so that
+ * several warping operations of the same destination dataset can request it.
+ *
+ * @param pCBData callback data returned by GDALCreateApproxTransformer().
+ * @param nXSize width of the destination dataset.
+ * @param nYSize height of the destination dataset.
+ * @param nStep size in pixels of the grid cells.
+ *
+ * @return TRUE if the grid is available.
+ * @since GDAL 2.1
+ */
+
+int GDALApproxTransformerBuildGrid( void *pCBData, int nXSize, int nYSize,
+                                    int nStep )
+
+{
+    VALIDATE_POINTER1( pCBData, "GDALApproxTransformerBuildGrid", FALSE );
+
+    ApproxTransformInfo *psATInfo = (ApproxTransformInfo *) pCBData;
+
+    if( psATInfo->psGrid != NULL &&
+        psATInfo->psGrid->nXSize == nXSize &&
+        psATInfo->psGrid->nYSize == nYSize &&
+        psATInfo->psGrid->nStep == nStep )
+        return TRUE;
+
+    GDALReleaseApproxTransformGrid( psATInfo->psGrid );
+    psATInfo->psGrid = NULL;
+
+    if( psATInfo->dfMaxError == 0.0 || nXSize <= 0 || nYSize <= 0 ||
+        nStep < 2 )
+        return FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Transform the points of the grid of half cells, i.e. the        */
+/*      nodes, and the middle of the edges and of the cells.            */
+/* -------------------------------------------------------------------- */
+    const int nCellsX = (nXSize - 1) / nStep + 1;
+    const int nCellsY = (nYSize - 1) / nStep + 1;
+    const int nHalfW = 2 * nCellsX + 1;
+    const int nHalfH = 2 * nCellsY + 1;
+
+    double *padfHalfX = (double *)
+        VSI_MALLOC3_VERBOSE( sizeof(double) * 3, nHalfW, nHalfH );
+    int *pabHalfSuccess = (int *)
+        VSI_MALLOC3_VERBOSE( sizeof(int), nHalfW, nHalfH );
+    if( padfHalfX == NULL || pabHalfSuccess == NULL )
+    {
+        CPLFree( padfHalfX );
+        CPLFree( pabHalfSuccess );
+        return FALSE;
+    }
+    const int nHalfPoints = nHalfW * nHalfH;
+    double *padfHalfY = padfHalfX + nHalfPoints;
+    double *padfHalfZ = padfHalfX + 2 * nHalfPoints;
+
+    for( int iY = 0; iY < nHalfH; iY++ )
+    {
+        for( int iX = 0; iX < nHalfW; iX++ )
+        {
+            padfHalfX[iY * nHalfW + iX] = iX * nStep * 0.5;
+            padfHalfY[iY * nHalfW + iX] = iY * nStep * 0.5;
+            padfHalfZ[iY * nHalfW + iX] = 0.0;
+        }
+    }
+
+    if( !psATInfo->pfnBaseTransformer( psATInfo->pBaseCBData, TRUE,
+                                       nHalfPoints,
+                                       padfHalfX, padfHalfY, padfHalfZ,
+                                       pabHalfSuccess ) )
+    {
+        CPLFree( padfHalfX );
+        CPLFree( pabHalfSuccess );
+        return FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Keep the nodes, and check the interpolation of each cell.       */
+/* -------------------------------------------------------------------- */
+    ApproxTransformGrid *psGrid = (ApproxTransformGrid *)
+        CPLCalloc( 1, sizeof(ApproxTransformGrid) );
+    psGrid->nRefCount = 1;
+    psGrid->nXSize = nXSize;
+    psGrid->nYSize = nYSize;
+    psGrid->nStep = nStep;
+    psGrid->nCellsX = nCellsX;
+    psGrid->nCellsY = nCellsY;
+
+    const int nNodes = (nCellsX + 1) * (nCellsY + 1);
+    psGrid->padfX = (double *) VSI_MALLOC2_VERBOSE( sizeof(double), nNodes );
+    psGrid->padfY = (double *) VSI_MALLOC2_VERBOSE( sizeof(double), nNodes );
+    psGrid->padfZ = (double *) VSI_MALLOC2_VERBOSE( sizeof(double), nNodes );
+    psGrid->pabyCellOK = (GByte *) VSI_MALLOC2_VERBOSE( nCellsX, nCellsY );
+    if( psGrid->padfX == NULL || psGrid->padfY == NULL ||
+        psGrid->padfZ == NULL || psGrid->pabyCellOK == NULL )
+    {
+        GDALReleaseApproxTransformGrid( psGrid );
+        CPLFree( padfHalfX );
+        CPLFree( pabHalfSuccess );
+        return FALSE;
+    }
+
+    for( int iY = 0; iY <= nCellsY; iY++ )
+    {
+        for( int iX = 0; iX <= nCellsX; iX++ )
+        {
+            const int iHalf = 2 * iY * nHalfW + 2 * iX;
+            const int iNode = iY * (nCellsX + 1) + iX;
+            psGrid->padfX[iNode] = padfHalfX[iHalf];
+            psGrid->padfY[iNode] = padfHalfY[iHalf];
+            psGrid->padfZ[iNode] = padfHalfZ[iHalf];
+        }
+    }
+
+    /* Offsets, in the half cell grid, of the corners of a cell, and of */
+    /* its check points with the weights of the corners at them. */
+    const int anCorner[4] = { 0, 2, 2 * nHalfW, 2 * nHalfW + 2 };
+    const int anCheck[5] = { 1, nHalfW, nHalfW + 1, nHalfW + 2,
+                             2 * nHalfW + 1 };
+    const double adfCheckWeight[5][4] = { { 0.5, 0.5, 0, 0 },
+                                          { 0.5, 0, 0.5, 0 },
+                                          { 0.25, 0.25, 0.25, 0.25 },
+                                          { 0, 0.5, 0, 0.5 },
+                                          { 0, 0, 0.5, 0.5 } };
+    int nCellsOK = 0;
+
+    for( int iY = 0; iY < nCellsY; iY++ )
+    {
+        for( int iX = 0; iX < nCellsX; iX++ )
+        {
+            const int iHalf = 2 * iY * nHalfW + 2 * iX;
+            int bOK = TRUE;
+
+            for( int i = 0; bOK && i < 4; i++ )
+                bOK = pabHalfSuccess[iHalf + anCorner[i]];
+
+            for( int i = 0; bOK && i < 5; i++ )
+            {
+                const int iCheck = iHalf + anCheck[i];
+                if( !pabHalfSuccess[iCheck] )
+                {
+                    bOK = FALSE;
+                    break;
+                }
+
+                double dfInterpX = 0.0, dfInterpY = 0.0;
+                for( int j = 0; j < 4; j++ )
+                {
+                    dfInterpX += adfCheckWeight[i][j] *
+                                 padfHalfX[iHalf + anCorner[j]];
+                    dfInterpY += adfCheckWeight[i][j] *
+                                 padfHalfY[iHalf + anCorner[j]];
+                }
+
+                const double dfError = fabs(dfInterpX - padfHalfX[iCheck])
+                                     + fabs(dfInterpY - padfHalfY[iCheck]);
+                if( dfError > psATInfo->dfMaxError )
+                    bOK = FALSE;
+            }
+
+            psGrid->pabyCellOK[iY * nCellsX + iX] = (GByte) bOK;
+            if( bOK )
+                nCellsOK ++;
+        }
+    }
+
+    CPLFree( padfHalfX );
+    CPLFree( pabHalfSuccess );
+
+    CPLDebug( "GDAL", "ApproxTransformer - %dx%d grid of %d pixels: "
+              "%d cells out of %d approximated.",
+              nCellsX, nCellsY, nStep, nCellsOK, nCellsX * nCellsY );
+
+    psATInfo->psGrid = psGrid;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                     GDALApproxTransformWithGrid()                    */
+/*                                                                      */
+/*      Returns FALSE, without altering the points, if some of them     */
+/*      are not in valid cells of the grid.                             */
+/************************************************************************/
+
+static int GDALApproxTransformWithGrid( const ApproxTransformGrid *psGrid,
+                                        int nPoints,
+                                        double *x, double *y, double *z,
+                                        int *panSuccess )
+
+{
+    const double dfInvStep = 1.0 / psGrid->nStep;
+    const int nNodesPerLine = psGrid->nCellsX + 1;
+
+    for( int i = 0; i < nPoints; i++ )
+    {
+        const double dfCellX = x[i] * dfInvStep;
+        const double dfCellY = y[i] * dfInvStep;
+        if( !(z[i] == 0.0 &&
+              dfCellX >= 0.0 && dfCellX <= psGrid->nCellsX &&
+              dfCellY >= 0.0 && dfCellY <= psGrid->nCellsY) )
+            return FALSE;
+
+        const int iCellX = MIN( (int) dfCellX, psGrid->nCellsX - 1 );
+        const int iCellY = MIN( (int) dfCellY, psGrid->nCellsY - 1 );
+        if( !psGrid->pabyCellOK[iCellY * psGrid->nCellsX + iCellX] )
+            return FALSE;
+    }
+
+    /* Values at the left edge of the current cell at the current line, */
+    /* and their variation up to the right edge, so that consecutive    */
+    /* points of a scanline only need a linear interpolation.           */
+    int iCurCell = -1;
+    double dfCurY = 0.0;
+    double adfLeft[3] = { 0.0, 0.0, 0.0 };
+    double adfDelta[3] = { 0.0, 0.0, 0.0 };
+
+    for( int i = 0; i < nPoints; i++ )
+    {
+        const double dfCellX = x[i] * dfInvStep;
+        const double dfCellY = y[i] * dfInvStep;
+        const int iCellX = MIN( (int) dfCellX, psGrid->nCellsX - 1 );
+        const int iCellY = MIN( (int) dfCellY, psGrid->nCellsY - 1 );
+        const int iCell = iCellY * psGrid->nCellsX + iCellX;
+
+        if( iCell != iCurCell || y[i] != dfCurY )
+        {
+            const double dfRatioY = dfCellY - iCellY;
+            const int iNode = iCellY * nNodesPerLine + iCellX;
+            const double *apadfNodes[3] = { psGrid->padfX, psGrid->padfY,
+                                            psGrid->padfZ };
+            for( int j = 0; j < 3; j++ )
+            {
+                const double *padfNodes = apadfNodes[j];
+                adfLeft[j] = padfNodes[iNode] + dfRatioY *
+                    (padfNodes[iNode + nNodesPerLine] - padfNodes[iNode]);
+                const double dfRight = padfNodes[iNode + 1] + dfRatioY *
+                    (padfNodes[iNode + nNodesPerLine + 1] -
+                     padfNodes[iNode + 1]);
+                adfDelta[j] = dfRight - adfLeft[j];
+            }
+            iCurCell = iCell;
+            dfCurY = y[i];
+        }
+
+        const double dfRatioX = dfCellX - iCellX;
+        x[i] = adfLeft[0] + dfRatioX * adfDelta[0];
+        y[i] = adfLeft[1] + dfRatioX * adfDelta[1];
+        z[i] = adfLeft[2] + dfRatioX * adfDelta[2];
+        panSuccess[i] = TRUE;
+    }
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                      GDALApproxTransformInternal()                   */
 /************************************************************************/
@@ -2950,6 +3282,14 @@ int GDALApproxTransform( void *pCBData, int bDstToSrc, int nPoints,
 
     int nMiddle = (nPoints-1)/2;
 
+/* -------------------------------------------------------------------- */
+/*      Use the precomputed grid if there is one.                       */
+/* -------------------------------------------------------------------- */
+    if( bDstToSrc && psATInfo->psGrid != NULL &&
+        GDALApproxTransformWithGrid( psATInfo->psGrid, nPoints,
+                                     x, y, z, panSuccess ) )
+        return TRUE;
+
 /* -------------------------------------------------------------------- */
 /*      Bail if our preconditions are not met, or if error is not       */
 /*      acceptable.                                                     */
@@ -913,6 +913,25 @@ GDALWarpDstAlphaMasker( void *pMaskFuncArg, int nBandCount,
  * set the number of threads to use to parallelize the computation part of the
  * warping. If not set, computation will be done in a single thread.
  *
+ * - NUM_CHUNK_THREADS: (GDAL >= 2.1) Can be set to a numeric value or
+ * ALL_CPUS to set the number of chunks that GDALWarpOperation::ChunkAndWarpImage()
+ * processes concurrently. The WARP_MEMORY_LIMIT is shared between those
+ * chunks. Reading and writing of the datasets is serialized, but the warping
+ * of a chunk can overlap the IO of the others. When enabled, NUM_THREADS is
+ * not used for the chunks processed that way. If not set, the
+ * GDAL_WARP_NUM_CHUNK_THREADS configuration option is used, and defaults to 1.
+ *
+ * - APPROX_TRANSFORMER_GRID_STEP: (GDAL >= 2.1) When the transformer is
+ * GDALApproxTransform(), setting this to a number of pixels, e.g. 32, makes
+ * GDALWarpOperation::Initialize() precompute the transformation on a grid
+ * with that step over the whole destination dataset (see
+ * GDALApproxTransformerBuildGrid()), on a copy of the transformer owned by
+ * the warp operation. The grid is then shared by all the
+ * chunks and threads of the operation, instead of each of them
+ * transforming its own scanlines. Cells where the grid interpolation
+ * exceeds the error threshold of the approximate transformer are still
+ * transformed exactly.
+ *
  * - STREAMABLE_OUTPUT: (GDAL >= 2.0) This defaults to FALSE, but may
  * be set to TRUE typically when writing to a streamed file. The
  * gdalwarp utility automatically sets this option when writing to
@@ -351,6 +351,7 @@ void GWKThreadsEnd(void* psThreadDataIn);
 /************************************************************************/
 
 typedef struct _GDALWarpChunk GDALWarpChunk;
+typedef struct _GDALWarpChunkJobContext GDALWarpChunkJobContext;
 
 class CPL_DLL GDALWarpOperation {
 private:
@@ -375,16 +376,43 @@ private:
     int             nChunkListCount;
     int             nChunkListMax;
     GDALWarpChunk  *pasChunkList;
+    double          dfChunkMemoryLimit;
 
     int             bReportTimings;
     unsigned long   nLastTimeReported;
 
     void           *psThreadData;
+
+    // Copy of the transformer of the options, with a precomputed grid
+    void           *pApproxGridTransformerArg;
+    void           *GetTransformerArg();
     
     void            WipeChunkList();
     CPLErr          CollectChunkList( int nDstXOff, int nDstYOff, 
                                       int nDstXSize, int nDstYSize );
     void            ReportTiming( const char * );
+
+    int             GetChunkThreadCount();
+    CPLErr          ChunkAndWarpThreaded( int nThreads, double dfTotalPixels,
+                                          int *pbFallback );
+    CPLErr          WarpRegionInternal( int nDstXOff, int nDstYOff, 
+                                        int nDstXSize, int nDstYSize,
+                                        int nSrcXOff, int nSrcYOff,
+                                        int nSrcXSize, int nSrcYSize,
+                                        int nSrcXExtraSize, int nSrcYExtraSize,
+                                        double dfProgressBase, double dfProgressScale,
+                                        GDALWarpChunkJobContext *psContext );
+    CPLErr          WarpRegionToBufferInternal( int nDstXOff, int nDstYOff, 
+                                        int nDstXSize, int nDstYSize, 
+                                        void *pDataBuf, 
+                                        GDALDataType eBufDataType,
+                                        int nSrcXOff, int nSrcYOff,
+                                        int nSrcXSize, int nSrcYSize,
+                                        int nSrcXExtraSize, int nSrcYExtraSize,
+                                        double dfProgressBase, double dfProgressScale,
+                                        GDALWarpChunkJobContext *psContext );
+
+    static void     ChunkJobThreadMain( void *pData );
     
 public:
                     GDALWarpOperation();
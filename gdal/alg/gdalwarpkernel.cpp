@@ -38,6 +38,7 @@
 #include "gdal_alg_priv.h"
 #include "cpl_string.h"
 #include "gdalwarpkernel_opencl.h"
+#include "gdalwarpkernel_simd.h"
 #include "cpl_atomic_ops.h"
 #include "cpl_worker_thread_pool.h"
 #include <limits>
@@ -3538,6 +3539,38 @@ int GWKResampleNoMasksT<double>( GDALWarpKernel *poWK, int iBand,
 
 #endif /* INSTANCIATE_FLOAT64_SSE2_IMPL */
 
+/************************************************************************/
+/*                        GWKGet4SampleRunFunc()                        */
+/************************************************************************/
+
+/* Returns the vectorized implementation of the bilinear/cubic 4 sample */
+/* formula to use for eDT, or NULL if none applies. AVX is preferred if */
+/* available at runtime, and SSE2 is used otherwise. Both can be disabled */
+/* with the GDAL_USE_AVX / GDAL_USE_SSE configuration options. */
+
+static GWK4SampleRunFunc GWKGet4SampleRunFunc( GDALDataType eDT,
+                                               GDALResampleAlg eResample )
+{
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+    if( CSLTestBoolean(CPLGetConfigOption("GDAL_USE_AVX", "YES")) &&
+        CPLHaveRuntimeAVX() )
+    {
+        return GWKGet4SampleRunFuncAVX(eDT, eResample);
+    }
+#endif
+    if( CSLTestBoolean(CPLGetConfigOption("GDAL_USE_SSE", "YES")) )
+        return GWKGet4SampleRunFuncT<XMMReg4Double>(eDT, eResample);
+    return NULL;
+}
+
+#else /* defined(__x86_64) || defined(_M_X64) */
+
+static GWK4SampleRunFunc GWKGet4SampleRunFunc( CPL_UNUSED GDALDataType eDT,
+                                               CPL_UNUSED GDALResampleAlg eResample )
+{
+    return NULL;
+}
+
 #endif /* defined(__x86_64) || defined(_M_X64) */
 
 /************************************************************************/
@@ -4182,6 +4215,35 @@ static void GWKGeneralCaseThread( void* pData)
         GWKResampleDeleteWrkStruct(psWrkStruct);
 }
 
+/************************************************************************/
+/*                       GWKIs4SampleInterior()                         */
+/************************************************************************/
+
+/* Returns whether the 4 sample formula of eResample can be applied at */
+/* (dfSrcX, dfSrcY) without falling back to its border handling. The   */
+/* tests must match the ones of GWKBilinearResampleNoMasks4SampleT() and */
+/* GWKCubicResampleNoMasks4SampleT(). */
+
+template<GDALResampleAlg eResample>
+static CPL_INLINE bool GWKIs4SampleInterior( double dfSrcX, double dfSrcY,
+                                             int nSrcXSize, int nSrcYSize )
+{
+    if( eResample == GRA_Bilinear )
+    {
+        const int iSrcX = (int) floor(dfSrcX - 0.5);
+        const int iSrcY = (int) floor(dfSrcY - 0.5);
+        return iSrcX >= 0 && iSrcX + 1 < nSrcXSize &&
+               iSrcY >= 0 && iSrcY + 1 < nSrcYSize;
+    }
+    else
+    {
+        const int iSrcX = (int) (dfSrcX - 0.5);
+        const int iSrcY = (int) (dfSrcY - 0.5);
+        return iSrcX - 1 >= 0 && iSrcX + 2 < nSrcXSize &&
+               iSrcY - 1 >= 0 && iSrcY + 2 < nSrcYSize;
+    }
+}
+
 /************************************************************************/
 /*                GWKResampleNoMasksOrDstDensityOnlyThreadInternal()           */
 /************************************************************************/
@@ -4218,6 +4280,17 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal( void* pData )
     double dfErrorThreshold = CPLAtof(
         CSLFetchNameValueDef(poWK->papszWarpOptions, "ERROR_THRESHOLD", "0"));
 
+/* -------------------------------------------------------------------- */
+/*      Runs of pixels whose 4 samples are all inside the source        */
+/*      window are processed by SIMD code, without border tests. The    */
+/*      scalar bilinear code is as fast for a single band, as the SIMD  */
+/*      code mostly saves the computation of weights for other bands.   */
+/* -------------------------------------------------------------------- */
+    GWK4SampleRunFunc pfn4SampleRun = NULL;
+    if( bUse4SamplesFormula &&
+        (eResample == GRA_Cubic || poWK->nBands > 1) )
+        pfn4SampleRun = GWKGet4SampleRunFunc(poWK->eWorkingDataType, eResample);
+
 /* ==================================================================== */
 /*      Loop over output lines.                                         */
 /* ==================================================================== */
@@ -4258,6 +4331,39 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal( void* pData )
         for( iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
             int iSrcOffset;
+
+            if( pfn4SampleRun != NULL )
+            {
+                int iDstXEnd = iDstX;
+                while( iDstXEnd < nDstXSize &&
+                       GWKCheckAndComputeSrcOffsets(pabSuccess, iDstXEnd,
+                                                    padfX, padfY, poWK,
+                                                    nSrcXSize, nSrcYSize,
+                                                    iSrcOffset) &&
+                       GWKIs4SampleInterior<eResample>(
+                            padfX[iDstXEnd]-poWK->nSrcXOff,
+                            padfY[iDstXEnd]-poWK->nSrcYOff,
+                            nSrcXSize, nSrcYSize) )
+                {
+                    iDstXEnd ++;
+                }
+
+                const int nRun = iDstXEnd - iDstX;
+                if( nRun > 0 )
+                {
+                    const int iDstOffset = iDstX + iDstY * nDstXSize;
+                    pfn4SampleRun( poWK, padfX + iDstX, padfY + iDstX,
+                                   nRun, iDstOffset );
+                    if( poWK->pafDstDensity )
+                    {
+                        for( int i = 0; i < nRun; i++ )
+                            poWK->pafDstDensity[iDstOffset + i] = 1.0f;
+                    }
+                    iDstX += nRun - 1;
+                    continue;
+                }
+            }
+
             if( !GWKCheckAndComputeSrcOffsets(pabSuccess, iDstX, padfX, padfY,
                                         poWK, nSrcXSize, nSrcYSize, iSrcOffset) )
                 continue;
@@ -0,0 +1,277 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  Vectorized bilinear and cubic resampling of runs of destination
+ *           pixels, shared by the SSE2 and AVX implementations.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef GDALWARPKERNEL_SIMD_H_INCLUDED
+#define GDALWARPKERNEL_SIMD_H_INCLUDED
+
+#include "gdalwarper.h"
+#include <cmath>
+#include <limits>
+
+/* Resample nCount consecutive destination pixels, starting at offset   */
+/* iDstOffset of the destination buffers, for all bands. padfX/padfY are */
+/* the source coordinates of those pixels. All of them must be far      */
+/* enough from the source window borders for the 4 sample formula to    */
+/* apply without fallback. */
+typedef void (*GWK4SampleRunFunc)( const GDALWarpKernel *poWK,
+                                   const double *padfX,
+                                   const double *padfY,
+                                   int nCount, int iDstOffset );
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+int CPLHaveRuntimeAVX();
+GWK4SampleRunFunc GWKGet4SampleRunFuncAVX( GDALDataType eDT,
+                                           GDALResampleAlg eResample );
+#endif
+
+/* The templates below are instantiated with a 4 x double vector class     */
+/* (XMMReg4Double in gdalwarpkernel.cpp, an AVX one in gdalwarpkernelavx.cpp)*/
+/* providing Load1ValHighAndLow(const double*), Load4Val(const double*),    */
+/* Load4Val(const T*), Load2ValLowAndHigh(const T*, const T*),              */
+/* operators +, -, * and Store4Val(double*).                                */
+/*                                                                         */
+/* The weights of a destination pixel are computed once and shared by all  */
+/* bands, and each band then only needs contiguous loads of source rows.   */
+/* As the order of the operations differs from the one of the scalar       */
+/* GWKBilinearResampleNoMasks4SampleT() and                                */
+/* GWKCubicResampleNoMasks4SampleT(), results may differ from them in the  */
+/* last bit (by one for integer data types when rounding a value very      */
+/* close to a .5 boundary).                                                 */
+
+/************************************************************************/
+/*                         GWK4SampleClampT()                           */
+/************************************************************************/
+
+/* In an anonymous namespace so that the AVX and SSE2 compilation units */
+/* do not share the (non static) member functions of these structures.  */
+namespace {
+
+template<class T, bool is_signed> struct sGWK4SampleRoundT
+{
+    static T eval(double);
+};
+
+template<class T> struct sGWK4SampleRoundT<T, true> /* signed */
+{
+    static T eval(double dfValue) { return (T)floor(dfValue + 0.5); }
+};
+
+template<class T> struct sGWK4SampleRoundT<T, false> /* unsigned */
+{
+    static T eval(double dfValue) { return (T)(dfValue + 0.5); }
+};
+
+} /* end of anonymous namespace */
+
+template<class T> static inline T GWK4SampleClampT(double dfValue)
+{
+    if (dfValue < std::numeric_limits<T>::min())
+        return std::numeric_limits<T>::min();
+    else if (dfValue > std::numeric_limits<T>::max())
+        return std::numeric_limits<T>::max();
+    else
+        return sGWK4SampleRoundT<T,
+                    std::numeric_limits<T>::is_signed>::eval(dfValue);
+}
+
+template<> inline float GWK4SampleClampT<float>(double dfValue)
+{
+    return (float)dfValue;
+}
+
+/************************************************************************/
+/*                          GWK4SampleHorizSum()                        */
+/************************************************************************/
+
+template<class V> static inline double GWK4SampleHorizSum( const V& v )
+{
+    double adfVal[4];
+    v.Store4Val(adfVal);
+    return (adfVal[0] + adfVal[1]) + (adfVal[2] + adfVal[3]);
+}
+
+/************************************************************************/
+/*                     GWKBilinearNoMasks4SampleRun()                   */
+/************************************************************************/
+
+template<class T, class V>
+static void GWKBilinearNoMasks4SampleRun( const GDALWarpKernel *poWK,
+                                          const double *padfX,
+                                          const double *padfY,
+                                          int nCount, int iDstOffset )
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const double dfSrcXOff = poWK->nSrcXOff;
+    const double dfSrcYOff = poWK->nSrcYOff;
+
+    /* The weights of the upper left, upper right, lower left and lower */
+    /* right pixels are (a + b * dfRatioX) * (c + d * dfRatioY). */
+    static const double adfCoefA[4] = { 0.0, 1.0, 0.0, 1.0 };
+    static const double adfCoefB[4] = { 1.0, -1.0, 1.0, -1.0 };
+    static const double adfCoefC[4] = { 0.0, 0.0, 1.0, 1.0 };
+    static const double adfCoefD[4] = { 1.0, 1.0, -1.0, -1.0 };
+    const V v_coef_a = V::Load4Val(adfCoefA);
+    const V v_coef_b = V::Load4Val(adfCoefB);
+    const V v_coef_c = V::Load4Val(adfCoefC);
+    const V v_coef_d = V::Load4Val(adfCoefD);
+
+    for( int i = 0; i < nCount; i++ )
+    {
+        const double dfSrcX = padfX[i] - dfSrcXOff;
+        const double dfSrcY = padfY[i] - dfSrcYOff;
+        const int iSrcX = (int) floor(dfSrcX - 0.5);
+        const int iSrcY = (int) floor(dfSrcY - 0.5);
+        const int iSrcOffset = iSrcX + iSrcY * nSrcXSize;
+        const double adfRatio[2] = { 1.5 - (dfSrcX - iSrcX),
+                                     1.5 - (dfSrcY - iSrcY) };
+
+        const V v_weight =
+            (v_coef_a + v_coef_b * V::Load1ValHighAndLow(&adfRatio[0])) *
+            (v_coef_c + v_coef_d * V::Load1ValHighAndLow(&adfRatio[1]));
+
+        for( int iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc =
+                ((const T*) poWK->papabySrcImage[iBand]) + iSrcOffset;
+            const V v_pixels = V::Load2ValLowAndHigh(pSrc, pSrc + nSrcXSize);
+
+            ((T*) poWK->papabyDstImage[iBand])[iDstOffset + i] =
+                GWK4SampleClampT<T>(GWK4SampleHorizSum(v_pixels * v_weight));
+        }
+    }
+}
+
+/************************************************************************/
+/*                      GWKCubicNoMasks4SampleRun()                     */
+/************************************************************************/
+
+/* The CubicConvolution() macro of gdalwarpkernel.cpp is linear in f0..f3, */
+/* with the following weights, as polynomials in distance1:               */
+/*   w0 = -0.5 * d + d^2 - 0.5 * d^3                                      */
+/*   w1 = 1 - 2.5 * d^2 + 1.5 * d^3                                       */
+/*   w2 = 0.5 * d + 2 * d^2 - 1.5 * d^3                                   */
+/*   w3 = -0.5 * d^2 + 0.5 * d^3                                          */
+
+template<class T, class V>
+static void GWKCubicNoMasks4SampleRun( const GDALWarpKernel *poWK,
+                                       const double *padfX,
+                                       const double *padfY,
+                                       int nCount, int iDstOffset )
+{
+    const int nSrcXSize = poWK->nSrcXSize;
+    const double dfSrcXOff = poWK->nSrcXOff;
+    const double dfSrcYOff = poWK->nSrcYOff;
+    static const double adfCoef0[4] = { 0.0, 1.0, 0.0, 0.0 };
+    static const double adfCoef1[4] = { -0.5, 0.0, 0.5, 0.0 };
+    static const double adfCoef2[4] = { 1.0, -2.5, 2.0, -0.5 };
+    static const double adfCoef3[4] = { -0.5, 1.5, -1.5, 0.5 };
+    const V v_coef0 = V::Load4Val(adfCoef0);
+    const V v_coef1 = V::Load4Val(adfCoef1);
+    const V v_coef2 = V::Load4Val(adfCoef2);
+    const V v_coef3 = V::Load4Val(adfCoef3);
+
+    for( int i = 0; i < nCount; i++ )
+    {
+        const double dfSrcX = padfX[i] - dfSrcXOff;
+        const double dfSrcY = padfY[i] - dfSrcYOff;
+        const int iSrcX = (int) (dfSrcX - 0.5);
+        const int iSrcY = (int) (dfSrcY - 0.5);
+        const int iSrcOffset = iSrcX - 1 + (iSrcY - 1) * nSrcXSize;
+        const double dfDeltaX = dfSrcX - 0.5 - iSrcX;
+        const double dfDeltaY = dfSrcY - 0.5 - iSrcY;
+        const double adfDelta[4] = {
+            dfDeltaX, dfDeltaX * dfDeltaX, dfDeltaY, dfDeltaY * dfDeltaY };
+
+        const V v_delta_x = V::Load1ValHighAndLow(&adfDelta[0]);
+        const V v_delta_x2 = V::Load1ValHighAndLow(&adfDelta[1]);
+        const V v_weight_x = v_coef0 + v_coef1 * v_delta_x +
+                             v_coef2 * v_delta_x2 +
+                             v_coef3 * (v_delta_x2 * v_delta_x);
+
+        const V v_delta_y = V::Load1ValHighAndLow(&adfDelta[2]);
+        const V v_delta_y2 = V::Load1ValHighAndLow(&adfDelta[3]);
+        double adfWeightY[4];
+        (v_coef0 + v_coef1 * v_delta_y + v_coef2 * v_delta_y2 +
+         v_coef3 * (v_delta_y2 * v_delta_y)).Store4Val(adfWeightY);
+        const V v_weight_y0 = V::Load1ValHighAndLow(&adfWeightY[0]);
+        const V v_weight_y1 = V::Load1ValHighAndLow(&adfWeightY[1]);
+        const V v_weight_y2 = V::Load1ValHighAndLow(&adfWeightY[2]);
+        const V v_weight_y3 = V::Load1ValHighAndLow(&adfWeightY[3]);
+
+        for( int iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc =
+                ((const T*) poWK->papabySrcImage[iBand]) + iSrcOffset;
+            const V v_acc =
+                V::Load4Val(pSrc) * v_weight_y0 +
+                V::Load4Val(pSrc + nSrcXSize) * v_weight_y1 +
+                V::Load4Val(pSrc + 2 * nSrcXSize) * v_weight_y2 +
+                V::Load4Val(pSrc + 3 * nSrcXSize) * v_weight_y3;
+
+            ((T*) poWK->papabyDstImage[iBand])[iDstOffset + i] =
+                GWK4SampleClampT<T>(GWK4SampleHorizSum(v_acc * v_weight_x));
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GWKGet4SampleRunFuncT()                        */
+/************************************************************************/
+
+template<class V>
+static GWK4SampleRunFunc GWKGet4SampleRunFuncT( GDALDataType eDT,
+                                                GDALResampleAlg eResample )
+{
+    if( eResample == GRA_Bilinear )
+    {
+        switch( eDT )
+        {
+            case GDT_Byte: return GWKBilinearNoMasks4SampleRun<GByte, V>;
+            case GDT_Int16: return GWKBilinearNoMasks4SampleRun<GInt16, V>;
+            case GDT_UInt16: return GWKBilinearNoMasks4SampleRun<GUInt16, V>;
+            case GDT_Float32: return GWKBilinearNoMasks4SampleRun<float, V>;
+            default: break;
+        }
+    }
+    else if( eResample == GRA_Cubic )
+    {
+        switch( eDT )
+        {
+            case GDT_Byte: return GWKCubicNoMasks4SampleRun<GByte, V>;
+            case GDT_Int16: return GWKCubicNoMasks4SampleRun<GInt16, V>;
+            case GDT_UInt16: return GWKCubicNoMasks4SampleRun<GUInt16, V>;
+            case GDT_Float32: return GWKCubicNoMasks4SampleRun<float, V>;
+            default: break;
+        }
+    }
+    return NULL;
+}
+
+#endif /* GDALWARPKERNEL_SIMD_H_INCLUDED */
@@ -0,0 +1,181 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  High Performance Image Reprojector
+ * Purpose:  AVX implementation of the vectorized bilinear and cubic
+ *           resampling of runs of destination pixels.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "gdalwarpkernel_simd.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+#include <immintrin.h>
+#include <string.h>
+
+CPL_CVSID("$Id$");
+
+/* This file is compiled with -mavx, so it must not include gdalsse_priv.h */
+/* whose inline methods would otherwise be emitted with AVX instructions   */
+/* and possibly picked by the linker for the non-AVX code paths.           */
+
+namespace {
+
+/************************************************************************/
+/*                          XMMReg4DoubleAVX                            */
+/************************************************************************/
+
+class XMMReg4DoubleAVX
+{
+  public:
+    __m256d ymm;
+
+    static inline XMMReg4DoubleAVX Load1ValHighAndLow(const double* ptr)
+    {
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_broadcast_sd(ptr);
+        return reg;
+    }
+
+    static inline XMMReg4DoubleAVX Load4Val(const double* ptr)
+    {
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_loadu_pd(ptr);
+        return reg;
+    }
+
+    static inline XMMReg4DoubleAVX Load4Val(const float* ptr)
+    {
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_cvtps_pd(_mm_loadu_ps(ptr));
+        return reg;
+    }
+
+    static inline XMMReg4DoubleAVX Load4Val(const unsigned char* ptr)
+    {
+        int i;
+        memcpy(&i, ptr, 4);
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(i)));
+        return reg;
+    }
+
+    static inline XMMReg4DoubleAVX Load4Val(const short* ptr)
+    {
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_cvtepi32_pd(
+            _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)ptr)));
+        return reg;
+    }
+
+    static inline XMMReg4DoubleAVX Load4Val(const unsigned short* ptr)
+    {
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_cvtepi32_pd(
+            _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)ptr)));
+        return reg;
+    }
+
+    template<class T>
+    static inline XMMReg4DoubleAVX Load2ValLowAndHigh(const T* ptrLow,
+                                                      const T* ptrHigh)
+    {
+        XMMReg4DoubleAVX reg;
+        reg.ymm = _mm256_insertf128_pd(
+            _mm256_castpd128_pd256(Load2Val(ptrLow)), Load2Val(ptrHigh), 1);
+        return reg;
+    }
+
+    inline XMMReg4DoubleAVX operator+ (const XMMReg4DoubleAVX& other) const
+    {
+        XMMReg4DoubleAVX ret;
+        ret.ymm = _mm256_add_pd(ymm, other.ymm);
+        return ret;
+    }
+
+    inline XMMReg4DoubleAVX operator- (const XMMReg4DoubleAVX& other) const
+    {
+        XMMReg4DoubleAVX ret;
+        ret.ymm = _mm256_sub_pd(ymm, other.ymm);
+        return ret;
+    }
+
+    inline XMMReg4DoubleAVX operator* (const XMMReg4DoubleAVX& other) const
+    {
+        XMMReg4DoubleAVX ret;
+        ret.ymm = _mm256_mul_pd(ymm, other.ymm);
+        return ret;
+    }
+
+    inline void Store4Val(double* ptr) const
+    {
+        _mm256_storeu_pd(ptr, ymm);
+    }
+
+  private:
+    static inline __m128d Load2Val(const double* ptr)
+    {
+        return _mm_loadu_pd(ptr);
+    }
+
+    static inline __m128d Load2Val(const float* ptr)
+    {
+        return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd((const double*)ptr)));
+    }
+
+    static inline __m128d Load2Val(const unsigned char* ptr)
+    {
+        unsigned short s;
+        memcpy(&s, ptr, 2);
+        return _mm_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(s)));
+    }
+
+    static inline __m128d Load2Val(const short* ptr)
+    {
+        int i;
+        memcpy(&i, ptr, 4);
+        return _mm_cvtepi32_pd(_mm_cvtepi16_epi32(_mm_cvtsi32_si128(i)));
+    }
+
+    static inline __m128d Load2Val(const unsigned short* ptr)
+    {
+        int i;
+        memcpy(&i, ptr, 4);
+        return _mm_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_cvtsi32_si128(i)));
+    }
+};
+
+} /* end of anonymous namespace */
+
+/************************************************************************/
+/*                      GWKGet4SampleRunFuncAVX()                       */
+/************************************************************************/
+
+GWK4SampleRunFunc GWKGet4SampleRunFuncAVX( GDALDataType eDT,
+                                           GDALResampleAlg eResample )
+{
+    return GWKGet4SampleRunFuncT<XMMReg4DoubleAVX>(eDT, eResample);
+}
+
+#endif /* HAVE_AVX_AT_COMPILE_TIME */
@@ -31,7 +31,11 @@
 #include "gdalwarper.h"
 #include "cpl_string.h"
 #include "cpl_multiproc.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_api.h"
+#include "gdal_alg_priv.h"
+
+#include <new>
 
 CPL_CVSID("$Id$");
 
@@ -39,8 +43,37 @@ struct _GDALWarpChunk {
     int dx, dy, dsx, dsy; 
     int sx, sy, ssx, ssy; 
     int sExtraSx, sExtraSy;
+    double dfMemoryUse;
 }; 
 
+typedef struct _GDALWarpChunkScheduler GDALWarpChunkScheduler;
+
+/* Per worker state used by ChunkAndWarpThreaded() */
+struct _GDALWarpChunkJobContext {
+    GDALWarpChunkScheduler *psScheduler;
+    void                   *pTransformerArg;
+    int                     bInUse;
+    int                     bIOMutexHeld;
+    GDALWarpChunk          *pasChunkInfo;
+    double                  dfProgressShare;
+    double                  dfLastComplete;
+};
+
+/* State shared by all the workers of ChunkAndWarpThreaded() */
+struct _GDALWarpChunkScheduler {
+    GDALWarpOperation      *poOperation;
+    CPLMutex               *hIOMutex;
+    CPLMutex               *hMutex;
+    CPLCond                *hCond;
+    int                     nJobsInFlight;
+    double                  dfMemoryInFlight;
+    int                     bInterrupted;
+    CPLErr                  eErr;
+    double                  dfProgress;
+    GDALProgressFunc        pfnProgress;
+    void                   *pProgressArg;
+};
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          GDALWarpOperation                           */
@@ -129,10 +162,12 @@ GDALWarpOperation::GDALWarpOperation()
     nChunkListCount = 0;
     nChunkListMax = 0;
     pasChunkList = NULL;
+    dfChunkMemoryLimit = 0.0;
 
     bReportTimings = FALSE;
     nLastTimeReported = 0;
     psThreadData = NULL;
+    pApproxGridTransformerArg = NULL;
 }
 
 /************************************************************************/
@@ -177,6 +212,25 @@ void GDALWarpOperation::WipeOptions()
         GDALDestroyWarpOptions( psOptions );
         psOptions = NULL;
     }
+    if( pApproxGridTransformerArg != NULL )
+    {
+        GDALDestroyTransformer( pApproxGridTransformerArg );
+        pApproxGridTransformerArg = NULL;
+    }
+}
+
+/************************************************************************/
+/*                          GetTransformerArg()                         */
+/************************************************************************/
+
+/* Returns the transformer used to warp the chunks: the private copy of */
+/* the approximate transformer with a grid if one has been built, or    */
+/* the one of the options.                                              */
+void *GDALWarpOperation::GetTransformerArg()
+
+{
+    return pApproxGridTransformerArg != NULL ? pApproxGridTransformerArg :
+                                               psOptions->pTransformerArg;
 }
 
 /************************************************************************/
@@ -575,13 +629,47 @@ CPLErr GDALWarpOperation::Initialize( const GDALWarpOptions *psNewOptions )
     if( !ValidateOptions() )
         eErr = CE_Failure;
 
+/* -------------------------------------------------------------------- */
+/*      Precompute the approximate transformer on a grid if requested,  */
+/*      before it gets cloned for the threads. This is done on a copy   */
+/*      owned by the operation, so that the transformer of the caller   */
+/*      is left untouched.                                              */
+/* -------------------------------------------------------------------- */
+    const char *pszGridStep =
+        CSLFetchNameValue( psOptions->papszWarpOptions,
+                           "APPROX_TRANSFORMER_GRID_STEP" );
+    if( eErr == CE_None && pszGridStep != NULL &&
+        psOptions->pfnTransformer == GDALApproxTransform &&
+        psOptions->hDstDS != NULL )
+    {
+        void *pGridTransformerArg =
+            GDALCreateSimilarTransformer( psOptions->pTransformerArg,
+                                          1.0, 1.0 );
+        if( pGridTransformerArg != NULL &&
+            GDALApproxTransformerBuildGrid(
+                pGridTransformerArg,
+                GDALGetRasterXSize( psOptions->hDstDS ),
+                GDALGetRasterYSize( psOptions->hDstDS ),
+                atoi(pszGridStep) ) )
+        {
+            pApproxGridTransformerArg = pGridTransformerArg;
+        }
+        else
+        {
+            if( pGridTransformerArg != NULL )
+                GDALDestroyTransformer( pGridTransformerArg );
+            CPLDebug( "WARP", "APPROX_TRANSFORMER_GRID_STEP=%s ignored.",
+                      pszGridStep );
+        }
+    }
+
     if( eErr != CE_None )
         WipeOptions();
     else
     {
         psThreadData = GWKThreadsCreate(psOptions->papszWarpOptions,
                                         psOptions->pfnTransformer,
-                                        psOptions->pTransformerArg);
+                                        GetTransformerArg());
         if( psThreadData == NULL )
             eErr = CE_Failure;
     }
@@ -661,6 +749,12 @@ static int OrderWarpChunk(const void* _a, const void *_b)
  * Once an appropriate region is selected GDALWarpOperation::WarpRegion()
  * is invoked to do the actual work. 
  *
+ * If the NUM_CHUNK_THREADS warp option (or the GDAL_WARP_NUM_CHUNK_THREADS
+ * configuration option) is set to a value greater than 1, several chunks
+ * are processed concurrently. In that mode, the memory limit is shared
+ * between the chunks in flight, and reading/writing of the datasets is
+ * serialized while the in-memory warping of the chunks runs in parallel.
+ *
  * @param nDstXOff X offset to window of destination data to be produced.
  * @param nDstYOff Y offset to window of destination data to be produced.
  * @param nDstXSize Width of output window on destination file to be produced.
@@ -673,11 +767,18 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(
     int nDstXOff, int nDstYOff,  int nDstXSize, int nDstYSize )
 
 {
+    int nChunkThreads = GetChunkThreadCount();
+
 /* -------------------------------------------------------------------- */
-/*      Collect the list of chunks to operate on.                       */
+/*      Collect the list of chunks to operate on.  When several         */
+/*      chunks are going to be processed concurrently, each of them     */
+/*      only gets its share of the memory limit.                        */
 /* -------------------------------------------------------------------- */
     WipeChunkList();
+    if( nChunkThreads > 1 )
+        dfChunkMemoryLimit = psOptions->dfWarpMemoryLimit / nChunkThreads;
     CollectChunkList( nDstXOff, nDstYOff, nDstXSize, nDstYSize );
+    dfChunkMemoryLimit = 0.0;
     
     /* Sort chucks from top to bottom, and for equal y, from left to right */
     if( pasChunkList )
@@ -697,6 +798,27 @@ CPLErr GDALWarpOperation::ChunkAndWarpImage(
         dfTotalPixels += dfChunkPixels;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Dispatch the chunks to a pool of worker threads if requested.   */
+/* -------------------------------------------------------------------- */
+    if( nChunkThreads > 1 && nChunkListCount > 1 )
+    {
+        int bFallback = FALSE;
+        CPLErr eErr = ChunkAndWarpThreaded( nChunkThreads, dfTotalPixels,
+                                            &bFallback );
+        if( !bFallback )
+        {
+            if( eErr != CE_None )
+                return eErr;
+
+            WipeChunkList();
+
+            psOptions->pfnProgress( 1.00001, "", psOptions->pProgressArg );
+
+            return CE_None;
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Process them one at a time, updating the progress               */
 /*      information for each region.                                    */
@@ -749,6 +871,296 @@ CPLErr GDALChunkAndWarpImage( GDALWarpOperationH hOperation,
         ChunkAndWarpImage( nDstXOff, nDstYOff, nDstXSize, nDstYSize );
 }
 
+/************************************************************************/
+/*                        GetChunkThreadCount()                         */
+/************************************************************************/
+
+int GDALWarpOperation::GetChunkThreadCount()
+
+{
+    const char* pszChunkThreads =
+        CSLFetchNameValue( psOptions->papszWarpOptions, "NUM_CHUNK_THREADS" );
+    if( pszChunkThreads == NULL )
+        pszChunkThreads = CPLGetConfigOption( "GDAL_WARP_NUM_CHUNK_THREADS", "1" );
+
+    int nThreads;
+    if( EQUAL(pszChunkThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszChunkThreads);
+    if( nThreads > 128 )
+        nThreads = 128;
+
+    /* Chunk processors are user callbacks that have never been required */
+    /* to be thread-safe. */
+    if( nThreads > 1 &&
+        (psOptions->pfnPreWarpChunkProcessor != NULL ||
+         psOptions->pfnPostWarpChunkProcessor != NULL) )
+    {
+        CPLDebug( "WARP", "Chunk processors in use: "
+                  "disabling chunk-level multi-threading" );
+        nThreads = 1;
+    }
+
+    return MAX(1, nThreads);
+}
+
+/************************************************************************/
+/*                       GDALWarpChunkProgress()                        */
+/*                                                                      */
+/*      Progress function installed on the warp kernel of each chunk    */
+/*      processed by ChunkAndWarpThreaded().  It converts the progress  */
+/*      of the chunk into the progress of the whole operation.          */
+/************************************************************************/
+
+static void GDALWarpChunkUpdateProgress( GDALWarpChunkJobContext *psContext,
+                                         double dfComplete,
+                                         const char *pszMessage )
+
+{
+    GDALWarpChunkScheduler *psScheduler = psContext->psScheduler;
+
+    psScheduler->dfProgress +=
+        (dfComplete - psContext->dfLastComplete) * psContext->dfProgressShare;
+    psContext->dfLastComplete = dfComplete;
+
+    if( !psScheduler->bInterrupted &&
+        !psScheduler->pfnProgress( MIN(1.0, psScheduler->dfProgress),
+                                   pszMessage, psScheduler->pProgressArg ) )
+    {
+        psScheduler->bInterrupted = TRUE;
+    }
+}
+
+static int CPL_STDCALL GDALWarpChunkProgress( double dfComplete,
+                                              const char *pszMessage,
+                                              void *pProgressArg )
+
+{
+    GDALWarpChunkJobContext *psContext =
+        (GDALWarpChunkJobContext *) pProgressArg;
+    GDALWarpChunkScheduler *psScheduler = psContext->psScheduler;
+
+    CPLAcquireMutex( psScheduler->hMutex, 1000.0 );
+    GDALWarpChunkUpdateProgress( psContext, dfComplete, pszMessage );
+    int bContinue = !psScheduler->bInterrupted;
+    CPLReleaseMutex( psScheduler->hMutex );
+
+    return bContinue;
+}
+
+/************************************************************************/
+/*                         ChunkJobThreadMain()                         */
+/************************************************************************/
+
+void GDALWarpOperation::ChunkJobThreadMain( void *pData )
+
+{
+    GDALWarpChunkJobContext *psContext = (GDALWarpChunkJobContext *) pData;
+    GDALWarpChunkScheduler *psScheduler = psContext->psScheduler;
+    GDALWarpChunk *pasChunkInfo = psContext->pasChunkInfo;
+    CPLErr eErr;
+
+/* -------------------------------------------------------------------- */
+/*      The IO mutex is held while reading and writing the datasets.    */
+/*      WarpRegionToBufferInternal() releases it during the in-memory   */
+/*      warp so that other chunks can do their IO meanwhile.            */
+/* -------------------------------------------------------------------- */
+    if( !CPLAcquireMutex( psScheduler->hIOMutex, 600.0 ) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Failed to acquire IOMutex in WarpRegion()." );
+        eErr = CE_Failure;
+    }
+    else
+    {
+        psContext->bIOMutexHeld = TRUE;
+        eErr = psScheduler->poOperation->WarpRegionInternal(
+                                    pasChunkInfo->dx, pasChunkInfo->dy, 
+                                    pasChunkInfo->dsx, pasChunkInfo->dsy,
+                                    pasChunkInfo->sx, pasChunkInfo->sy, 
+                                    pasChunkInfo->ssx, pasChunkInfo->ssy,
+                                    pasChunkInfo->sExtraSx, pasChunkInfo->sExtraSy,
+                                    0.0, 1.0, psContext );
+
+        // Not held if it could not be reacquired after the in-memory warp
+        if( psContext->bIOMutexHeld )
+            CPLReleaseMutex( psScheduler->hIOMutex );
+        psContext->bIOMutexHeld = FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Give back our memory share and wake up the scheduler.           */
+/* -------------------------------------------------------------------- */
+    CPLAcquireMutex( psScheduler->hMutex, 1000.0 );
+
+    if( eErr == CE_None && psContext->dfLastComplete < 1.0 )
+        GDALWarpChunkUpdateProgress( psContext, 1.0, "" );
+    if( eErr != CE_None && psScheduler->eErr == CE_None )
+        psScheduler->eErr = eErr;
+
+    psScheduler->nJobsInFlight --;
+    psScheduler->dfMemoryInFlight -= pasChunkInfo->dfMemoryUse;
+    psContext->bInUse = FALSE;
+
+    CPLCondSignal( psScheduler->hCond );
+    CPLReleaseMutex( psScheduler->hMutex );
+}
+
+/************************************************************************/
+/*                        ChunkAndWarpThreaded()                        */
+/*                                                                      */
+/*      Process the collected chunk list with nThreads worker threads.  */
+/*      A chunk is started only once a worker is available and the      */
+/*      memory needed by the chunks in flight, including that one,      */
+/*      fits in dfWarpMemoryLimit.  *pbFallback is set if the           */
+/*      operation cannot be multi-threaded, in which case nothing has   */
+/*      been done.                                                      */
+/************************************************************************/
+
+CPLErr GDALWarpOperation::ChunkAndWarpThreaded( int nThreads,
+                                                double dfTotalPixels,
+                                                int *pbFallback )
+
+{
+    int i, iChunk;
+
+    *pbFallback = FALSE;
+    if( nThreads > nChunkListCount )
+        nThreads = nChunkListCount;
+
+/* -------------------------------------------------------------------- */
+/*      Duplicate the transformer for each worker, since transformers   */
+/*      are generally not thread-safe.                                  */
+/* -------------------------------------------------------------------- */
+    std::vector<GDALWarpChunkJobContext> asContexts( nThreads );
+    for( i = 0; i < nThreads; i++ )
+    {
+        memset( &asContexts[i], 0, sizeof(GDALWarpChunkJobContext) );
+        asContexts[i].pTransformerArg =
+            GDALCloneTransformer( GetTransformerArg() );
+        if( asContexts[i].pTransformerArg == NULL )
+        {
+            CPLDebug( "WARP", "Cannot duplicate transformer function. "
+                      "Falling back to mono-thread chunk processing" );
+            for( int j = 0; j < i; j++ )
+                GDALDestroyTransformer( asContexts[j].pTransformerArg );
+            *pbFallback = TRUE;
+            return CE_None;
+        }
+    }
+
+    CPLWorkerThreadPool *poThreadPool = new (std::nothrow) CPLWorkerThreadPool();
+    if( poThreadPool == NULL || !poThreadPool->Setup( nThreads, NULL, NULL ) )
+    {
+        CPLDebug( "WARP", "Cannot create worker threads. "
+                  "Falling back to mono-thread chunk processing" );
+        delete poThreadPool;
+        for( i = 0; i < nThreads; i++ )
+            GDALDestroyTransformer( asContexts[i].pTransformerArg );
+        *pbFallback = TRUE;
+        return CE_None;
+    }
+
+    GDALWarpChunkScheduler sScheduler;
+    memset( &sScheduler, 0, sizeof(sScheduler) );
+    sScheduler.poOperation = this;
+    sScheduler.eErr = CE_None;
+    sScheduler.pfnProgress = psOptions->pfnProgress;
+    sScheduler.pProgressArg = psOptions->pProgressArg;
+    sScheduler.hIOMutex = CPLCreateMutex();
+    CPLReleaseMutex( sScheduler.hIOMutex );
+    sScheduler.hCond = CPLCreateCond();
+    /* Kept acquired by this thread, except while waiting on hCond. */
+    sScheduler.hMutex = CPLCreateMutex();
+
+    for( i = 0; i < nThreads; i++ )
+        asContexts[i].psScheduler = &sScheduler;
+
+    CPLDebug( "WARP", "Processing %d chunks with %d threads",
+              nChunkListCount, nThreads );
+
+/* -------------------------------------------------------------------- */
+/*      Submit the chunks, in order, as resources become available.     */
+/* -------------------------------------------------------------------- */
+    CPLErr eErr = CE_None;
+
+    for( iChunk = 0; iChunk < nChunkListCount; iChunk++ )
+    {
+        GDALWarpChunk *pasThisChunk = pasChunkList + iChunk;
+
+        while( sScheduler.nJobsInFlight > 0 &&
+               !sScheduler.bInterrupted && sScheduler.eErr == CE_None &&
+               (sScheduler.nJobsInFlight == nThreads ||
+                sScheduler.dfMemoryInFlight + pasThisChunk->dfMemoryUse >
+                                            psOptions->dfWarpMemoryLimit) )
+        {
+            CPLCondWait( sScheduler.hCond, sScheduler.hMutex );
+        }
+        if( sScheduler.bInterrupted || sScheduler.eErr != CE_None )
+            break;
+
+        GDALWarpChunkJobContext *psContext = NULL;
+        for( i = 0; i < nThreads; i++ )
+        {
+            if( !asContexts[i].bInUse )
+            {
+                psContext = &asContexts[i];
+                break;
+            }
+        }
+        CPLAssert( psContext != NULL );
+
+        psContext->bInUse = TRUE;
+        psContext->pasChunkInfo = pasThisChunk;
+        psContext->dfProgressShare =
+            pasThisChunk->dsx * (double) pasThisChunk->dsy / dfTotalPixels;
+        psContext->dfLastComplete = 0.0;
+
+        sScheduler.nJobsInFlight ++;
+        sScheduler.dfMemoryInFlight += pasThisChunk->dfMemoryUse;
+
+        CPLDebug( "WARP", "Start chunk %d (%d chunks, %.0f bytes in flight).",
+                  iChunk, sScheduler.nJobsInFlight,
+                  sScheduler.dfMemoryInFlight );
+
+        if( !poThreadPool->SubmitJob( ChunkJobThreadMain, psContext ) )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined, 
+                      "Cannot submit job in ChunkAndWarpThreaded()" );
+            psContext->bInUse = FALSE;
+            sScheduler.nJobsInFlight --;
+            sScheduler.dfMemoryInFlight -= pasThisChunk->dfMemoryUse;
+            eErr = CE_Failure;
+            break;
+        }
+    }
+
+    CPLReleaseMutex( sScheduler.hMutex );
+
+/* -------------------------------------------------------------------- */
+/*      Wait for the chunks in flight to complete and cleanup.          */
+/* -------------------------------------------------------------------- */
+    poThreadPool->WaitCompletion();
+    delete poThreadPool;
+
+    if( eErr == CE_None )
+        eErr = sScheduler.eErr;
+    if( eErr == CE_None && sScheduler.bInterrupted )
+    {
+        CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+        eErr = CE_Failure;
+    }
+
+    for( i = 0; i < nThreads; i++ )
+        GDALDestroyTransformer( asContexts[i].pTransformerArg );
+    CPLDestroyCond( sScheduler.hCond );
+    CPLDestroyMutex( sScheduler.hMutex );
+    CPLDestroyMutex( sScheduler.hIOMutex );
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                          ChunkThreadMain()                           */
 /************************************************************************/
@@ -1088,6 +1500,8 @@ CPLErr GDALWarpOperation::CollectChunkList(
 /*      dimension and recurse.                                          */
 /* -------------------------------------------------------------------- */
     double dfTotalMemoryUse;
+    double dfMemoryLimit = (dfChunkMemoryLimit > 0.0) ? dfChunkMemoryLimit :
+                                                psOptions->dfWarpMemoryLimit;
 
     dfTotalMemoryUse =
         (((double) nSrcPixelCostInBits) * nSrcXSize * nSrcYSize
@@ -1110,7 +1524,7 @@ CPLErr GDALWarpOperation::CollectChunkList(
     /*CPLDebug("WARP", "dst=(%d,%d,%d,%d) src=(%d,%d,%d,%d) srcfillratio=%.18g",
              nDstXOff, nDstYOff, nDstXSize, nDstYSize,
              nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize, dfSrcFillRatio);*/
-    if( (dfTotalMemoryUse > psOptions->dfWarpMemoryLimit && (nDstXSize > 2 || nDstYSize > 2)) ||
+    if( (dfTotalMemoryUse > dfMemoryLimit && (nDstXSize > 2 || nDstYSize > 2)) ||
         (dfSrcFillRatio > 0 && dfSrcFillRatio < 0.5 && (nDstXSize > 100 || nDstYSize > 100) &&
          CSLFetchBoolean( psOptions->papszWarpOptions, "SRC_FILL_RATIO_HEURISTICS", TRUE )) )
     {
@@ -1193,6 +1607,10 @@ CPLErr GDALWarpOperation::CollectChunkList(
     pasChunkList[nChunkListCount].ssy = nSrcYSize;
     pasChunkList[nChunkListCount].sExtraSx = nSrcXExtraSize;
     pasChunkList[nChunkListCount].sExtraSy = nSrcYExtraSize;
+    pasChunkList[nChunkListCount].dfMemoryUse = dfTotalMemoryUse;
+    CPLDebug( "WARP", "Chunk dst=(%d,%d,%d,%d) src=(%d,%d,%d,%d)",
+              nDstXOff, nDstYOff, nDstXSize, nDstYSize,
+              nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize );
 
     nChunkListCount++;
 
@@ -1262,6 +1680,31 @@ CPLErr GDALWarpOperation::WarpRegion( int nDstXOff, int nDstYOff,
                                       int nSrcXExtraSize, int nSrcYExtraSize,
                                       double dfProgressBase,
                                       double dfProgressScale)
+{
+    return WarpRegionInternal(nDstXOff, nDstYOff, 
+                              nDstXSize, nDstYSize,
+                              nSrcXOff, nSrcYOff,
+                              nSrcXSize, nSrcYSize,
+                              nSrcXExtraSize, nSrcYExtraSize,
+                              dfProgressBase, dfProgressScale, NULL);
+}
+
+/************************************************************************/
+/*                         WarpRegionInternal()                         */
+/*                                                                      */
+/*      psContext is non NULL when called from a worker thread of       */
+/*      ChunkAndWarpThreaded().                                         */
+/************************************************************************/
+
+CPLErr GDALWarpOperation::WarpRegionInternal( int nDstXOff, int nDstYOff, 
+                                              int nDstXSize, int nDstYSize,
+                                              int nSrcXOff, int nSrcYOff,
+                                              int nSrcXSize, int nSrcYSize,
+                                              int nSrcXExtraSize,
+                                              int nSrcYExtraSize,
+                                              double dfProgressBase,
+                                              double dfProgressScale,
+                                              GDALWarpChunkJobContext *psContext )
 
 {
     CPLErr eErr;
@@ -1381,11 +1824,12 @@ CPLErr GDALWarpOperation::WarpRegion( int nDstXOff, int nDstYOff,
 /* -------------------------------------------------------------------- */
 /*      Perform the warp.                                               */
 /* -------------------------------------------------------------------- */
-    eErr = WarpRegionToBuffer( nDstXOff, nDstYOff, nDstXSize, nDstYSize, 
-                               pDstBuffer, psOptions->eWorkingDataType, 
-                               nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
-                               nSrcXExtraSize, nSrcYExtraSize,
-                               dfProgressBase, dfProgressScale);
+    eErr = WarpRegionToBufferInternal( nDstXOff, nDstYOff, nDstXSize, nDstYSize, 
+                                       pDstBuffer, psOptions->eWorkingDataType, 
+                                       nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                                       nSrcXExtraSize, nSrcYExtraSize,
+                                       dfProgressBase, dfProgressScale,
+                                       psContext );
 
 /* -------------------------------------------------------------------- */
 /*      Write the output data back to disk if all went well.            */
@@ -1503,6 +1947,25 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     int nSrcXOff, int nSrcYOff, int nSrcXSize, int nSrcYSize,
     int nSrcXExtraSize, int nSrcYExtraSize,
     double dfProgressBase, double dfProgressScale)
+{
+    return WarpRegionToBufferInternal(nDstXOff, nDstYOff, nDstXSize, nDstYSize, 
+                                      pDataBuf, eBufDataType,
+                                      nSrcXOff, nSrcYOff, nSrcXSize, nSrcYSize,
+                                      nSrcXExtraSize, nSrcYExtraSize,
+                                      dfProgressBase, dfProgressScale, NULL);
+}
+
+/************************************************************************/
+/*                     WarpRegionToBufferInternal()                     */
+/************************************************************************/
+
+CPLErr GDALWarpOperation::WarpRegionToBufferInternal( 
+    int nDstXOff, int nDstYOff, int nDstXSize, int nDstYSize, 
+    void *pDataBuf, GDALDataType eBufDataType,
+    int nSrcXOff, int nSrcYOff, int nSrcXSize, int nSrcYSize,
+    int nSrcXExtraSize, int nSrcYExtraSize,
+    double dfProgressBase, double dfProgressScale,
+    GDALWarpChunkJobContext *psContext )
 
 {
     CPLErr eErr = CE_None;
@@ -1536,7 +1999,7 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
     oWK.eWorkingDataType = psOptions->eWorkingDataType;
 
     oWK.pfnTransformer = psOptions->pfnTransformer;
-    oWK.pTransformerArg = psOptions->pTransformerArg;
+    oWK.pTransformerArg = GetTransformerArg();
     
     oWK.pfnProgress = psOptions->pfnProgress;
     oWK.pProgress = psOptions->pProgressArg;
@@ -1545,6 +2008,16 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
     oWK.papszWarpOptions = psOptions->papszWarpOptions;
     oWK.psThreadData = psThreadData;
+
+    /* Concurrent chunks each get their own transformer, and use the */
+    /* mono-threaded kernel since the kernel thread pool is shared. */
+    if( psContext != NULL )
+    {
+        oWK.pTransformerArg = psContext->pTransformerArg;
+        oWK.pfnProgress = GDALWarpChunkProgress;
+        oWK.pProgress = psContext;
+        oWK.psThreadData = NULL;
+    }
     
     oWK.padfDstNoDataReal = psOptions->padfDstNoDataReal;
 
@@ -1873,15 +2346,23 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 /* -------------------------------------------------------------------- */
 /*      Release IO Mutex, and acquire warper mutex.                     */
 /* -------------------------------------------------------------------- */
-    if( hIOMutex != NULL )
+    int bWarpMutexHeld = FALSE;
+    if( psContext != NULL )
+    {
+        psContext->bIOMutexHeld = FALSE;
+        CPLReleaseMutex( psContext->psScheduler->hIOMutex );
+    }
+    else if( hIOMutex != NULL )
     {
         CPLReleaseMutex( hIOMutex );
         if( !CPLAcquireMutex( hWarpMutex, 600.0 ) )
         {
             CPLError( CE_Failure, CPLE_AppDefined, 
                       "Failed to acquire WarpMutex in WarpRegion()." );
-            return CE_Failure;
+            eErr = CE_Failure;
         }
+        else
+            bWarpMutexHeld = TRUE;
     }
 
 /* -------------------------------------------------------------------- */
@@ -1909,15 +2390,29 @@ CPLErr GDALWarpOperation::WarpRegionToBuffer(
 
 /* -------------------------------------------------------------------- */
 /*      Release Warp Mutex, and acquire io mutex.                       */
+/*      On failure, the caller is told through bIOMutexHeld not to     */
+/*      release the IO mutex, and the buffers are still freed below.    */
 /* -------------------------------------------------------------------- */
-    if( hIOMutex != NULL )
+    if( psContext != NULL )
+    {
+        if( !CPLAcquireMutex( psContext->psScheduler->hIOMutex, 600.0 ) )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined, 
+                      "Failed to acquire IOMutex in WarpRegion()." );
+            eErr = CE_Failure;
+        }
+        else
+            psContext->bIOMutexHeld = TRUE;
+    }
+    else if( hIOMutex != NULL )
     {
-        CPLReleaseMutex( hWarpMutex );
+        if( bWarpMutexHeld )
+            CPLReleaseMutex( hWarpMutex );
         if( !CPLAcquireMutex( hIOMutex, 600.0 ) )
         {
             CPLError( CE_Failure, CPLE_AppDefined, 
                       "Failed to acquire IOMutex in WarpRegion()." );
-            return CE_Failure;
+            eErr = CE_Failure;
         }
     }
         
@@ -2210,7 +2705,7 @@ CPLErr GDALWarpOperation::ComputeSourceWindow(int nDstXOff, int nDstYOff,
 /* -------------------------------------------------------------------- */
 /*      Transform them to the input pixel coordinate space              */
 /* -------------------------------------------------------------------- */
-    if( !psOptions->pfnTransformer( psOptions->pTransformerArg, 
+    if( !psOptions->pfnTransformer( GetTransformerArg(),
                                     TRUE, nSamplePoints, 
                                     padfX, padfY, padfZ, pabSuccess ) )
     {
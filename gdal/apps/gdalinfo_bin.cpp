@@ -45,7 +45,7 @@ static void Usage(const char* pszErrorMsg = NULL)
 {
     printf( "Usage: gdalinfo [--help-general] [-json] [-mm] [-stats] [-hist] [-nogcp] [-nomd]\n"
             "                [-norat] [-noct] [-nofl] [-checksum] [-proj4]\n"
-            "                [-listmdd] [-mdd domain|`all`]*\n"
+            "                [-listmdd] [-mdd domain|`all`]* [-cachestats]\n"
             "                [-sd subdataset] [-oo NAME=VALUE]* datasetname\n" );
 
     if( pszErrorMsg != NULL )
@@ -101,6 +101,11 @@ struct GDALInfoOptions
     /*! display the file list or the first file of the file list */
     int bShowFileList;
 
+    /*! report statistics on the block cache, for the dataset and globally,
+        after the other operations (e.g. statistics or checksum computation)
+        have been done */
+    int bShowCacheStats;
+
     /*! report metadata for the specified domains. "all" can be used to report metadata
         in all domains.
         */
@@ -127,6 +132,12 @@ GDALInfoReportMetadata( GDALMajorObjectH hObject,
                         json_object *poMetadata,
                         CPLString& osStr );
 
+static void
+GDALInfoReportBlockCacheStatistics( GDALDatasetH hDataset,
+                                    int bJson,
+                                    json_object *poJsonObject,
+                                    CPLString& osStr );
+
 /************************************************************************/
 /*                             GDALInfo()                               */
 /************************************************************************/
@@ -1155,6 +1166,9 @@ char *GDALInfo( GDALDatasetH hDataset, const GDALInfoOptions *psOptions )
             json_object_array_add(poBands, poBand);
     }
 
+    if( psOptions->bShowCacheStats )
+        GDALInfoReportBlockCacheStatistics( hDataset, bJson, poJsonObject, osStr );
+
     if(bJson)
     {
         json_object_object_add(poJsonObject, "bands", poBands);
@@ -1280,6 +1294,123 @@ GDALInfoReportCorner( GDALDatasetH hDataset,
 }
 
 
+/************************************************************************/
+/*                  GDALInfoFormatBlockCacheStatistics()                */
+/************************************************************************/
+
+/* Returns a new JSON object in JSON mode, otherwise appends to osStr */
+static json_object *
+GDALInfoFormatBlockCacheStatistics( const GDALBlockCacheStatistics* psStats,
+                                    const char* pszLabel,
+                                    int bWithLockStats,
+                                    int bJson,
+                                    CPLString& osStr )
+{
+    const GIntBig nRequests = psStats->nHits + psStats->nMisses;
+    const double dfHitRatio = (nRequests > 0) ?
+        100.0 * psStats->nHits / nRequests : 0.0;
+
+    if(bJson)
+    {
+        json_object *poStats = json_object_new_object();
+        json_object_object_add(poStats, "hits",
+                               json_object_new_int64(psStats->nHits));
+        json_object_object_add(poStats, "misses",
+                               json_object_new_int64(psStats->nMisses));
+        json_object_object_add(poStats, "hitRatio",
+                               json_object_new_double_with_precision(dfHitRatio, 2));
+        json_object_object_add(poStats, "bytesRead",
+                               json_object_new_int64(psStats->nBytesRead));
+        json_object_object_add(poStats, "evictions",
+                               json_object_new_int64(psStats->nEvictions));
+        json_object_object_add(poStats, "dirtyFlushes",
+                               json_object_new_int64(psStats->nDirtyFlushes));
+        json_object_object_add(poStats, "used",
+                               json_object_new_int64(psStats->nCacheUsed));
+        json_object_object_add(poStats, "highWaterMark",
+                               json_object_new_int64(psStats->nCacheHighWaterMark));
+        if( bWithLockStats )
+        {
+            json_object_object_add(poStats, "lockAcquisitions",
+                                   json_object_new_int64(psStats->nLockAcquisitions));
+            json_object_object_add(poStats, "lockContentions",
+                                   json_object_new_int64(psStats->nLockContentions));
+            json_object_object_add(poStats, "lockWaitTime",
+                                   json_object_new_double_with_precision(psStats->dfLockWaitTime, 6));
+        }
+        return poStats;
+    }
+
+    osStr += CPLOPrintf( "  %s: hits=" CPL_FRMT_GIB ", misses=" CPL_FRMT_GIB
+                         ", hit ratio=%.2f%%, bytes read=" CPL_FRMT_GIB "\n",
+                         pszLabel,
+                         psStats->nHits, psStats->nMisses, dfHitRatio,
+                         psStats->nBytesRead );
+    osStr += CPLOPrintf( "    evictions=" CPL_FRMT_GIB ", dirty flushes=" CPL_FRMT_GIB
+                         ", used=" CPL_FRMT_GIB " bytes, high water mark=" CPL_FRMT_GIB " bytes\n",
+                         psStats->nEvictions, psStats->nDirtyFlushes,
+                         psStats->nCacheUsed, psStats->nCacheHighWaterMark );
+    if( bWithLockStats )
+    {
+        osStr += CPLOPrintf( "    lock acquisitions=" CPL_FRMT_GIB ", lock contentions=" CPL_FRMT_GIB
+                             ", lock wait time=%.6f s\n",
+                             psStats->nLockAcquisitions, psStats->nLockContentions,
+                             psStats->dfLockWaitTime );
+    }
+    return NULL;
+}
+
+/************************************************************************/
+/*                 GDALInfoReportBlockCacheStatistics()                 */
+/************************************************************************/
+
+static void GDALInfoReportBlockCacheStatistics( GDALDatasetH hDataset,
+                                                int bJson,
+                                                json_object *poJsonObject,
+                                                CPLString& osStr )
+{
+    GDALBlockCacheStatistics sStats;
+
+    json_object *poCacheStats = NULL;
+    json_object *poBandsStats = NULL;
+    if(bJson)
+    {
+        poCacheStats = json_object_new_object();
+        poBandsStats = json_object_new_array();
+    }
+    else
+        osStr += "Block Cache Statistics:\n";
+
+    GDALDatasetGetBlockCacheStatistics( hDataset, &sStats );
+    json_object *poStats =
+        GDALInfoFormatBlockCacheStatistics( &sStats, "Dataset", FALSE,
+                                            bJson, osStr );
+    if(bJson)
+        json_object_object_add(poCacheStats, "dataset", poStats);
+
+    for( int iBand = 0; iBand < GDALGetRasterCount( hDataset ); iBand++ )
+    {
+        GDALGetRasterBandBlockCacheStatistics(
+                        GDALGetRasterBand( hDataset, iBand+1 ), &sStats );
+        poStats = GDALInfoFormatBlockCacheStatistics(
+                        &sStats, CPLSPrintf("Band %d", iBand+1), FALSE,
+                        bJson, osStr );
+        if(bJson)
+            json_object_array_add(poBandsStats, poStats);
+    }
+    if(bJson)
+        json_object_object_add(poCacheStats, "bands", poBandsStats);
+
+    GDALGetBlockCacheStatistics( &sStats );
+    poStats = GDALInfoFormatBlockCacheStatistics( &sStats, "Global", TRUE,
+                                                  bJson, osStr );
+    if(bJson)
+    {
+        json_object_object_add(poCacheStats, "global", poStats);
+        json_object_object_add(poJsonObject, "blockCacheStatistics", poCacheStats);
+    }
+}
+
 /************************************************************************/
 /*                       GDALInfoPrintMetadata()                        */
 /************************************************************************/
@@ -1517,6 +1648,7 @@ GDALInfoOptions *GDALInfoOptionsNew(char** papszArgv,
     psOptions->bShowColorTable = TRUE;
     psOptions->bListMDD = FALSE;
     psOptions->bShowFileList = TRUE;
+    psOptions->bShowCacheStats = FALSE;
 
 /* -------------------------------------------------------------------- */
 /*      Parse arguments.                                                */
@@ -1571,6 +1703,8 @@ GDALInfoOptions *GDALInfoOptionsNew(char** papszArgv,
         }
         else if( EQUAL(papszArgv[i], "-nofl") )
             psOptions->bShowFileList = FALSE;
+        else if( EQUAL(papszArgv[i], "-cachestats") )
+            psOptions->bShowCacheStats = TRUE;
         else if( EQUAL(papszArgv[i], "-sd") && papszArgv[i+1] != NULL )
         {
             i++;
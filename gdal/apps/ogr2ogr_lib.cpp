@@ -3692,7 +3692,8 @@ end_loop:
             OGRFeature::DestroyFeature( poDstFeature );
         }
 
-        OGRFeature::DestroyFeature( poFeature );
+        /* Let the source layer reuse the feature for the next one */
+        poSrcLayer->RecycleFeature( poFeature );
 
         /* Report progress */
         nCount ++;
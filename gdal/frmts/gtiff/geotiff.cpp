@@ -57,6 +57,7 @@
 #include "gt_jpeg_copy.h"
 #include "cpl_vsi_virtual.h"
 #include <set>
+#include <map>
 #include "gdal_mdreader.h"
 #include "cpl_worker_thread_pool.h"
 
@@ -186,6 +187,26 @@ typedef struct
     int           bReady;
 } GTiffCompressionJob;
 
+typedef struct
+{
+    GTiffDataset *poDS;
+    int           bTIFFIsBigEndian;
+    char         *pszTmpFilename;
+    int           nHeight;
+    uint16        nPredictor;
+    int           nStripOrTile;
+
+    GByte        *pabyCompressedBuffer;
+    int           nCompressedBufferSize;
+    VSILFILE     *fpPRead; /* if not NULL, read the raw data in the thread */
+    vsi_l_offset  nCompressedOffset;
+
+    GByte        *pabyBuffer; /* decoded data */
+    int           nBufferSize;
+    int           nReqSize;
+    int           bSuccess;
+} GTiffDecompressionJob;
+
 class GTiffDataset : public GDALPamDataset
 {
     friend class GTiffRasterBand;
@@ -388,6 +409,27 @@ class GTiffDataset : public GDALPamDataset
     int            SubmitCompressionJob(int nStripOrTile, GByte* pabyData,
                                         int cc, int nHeight);
 
+    int            nDecompressThreads;
+    CPLWorkerThreadPool *poDecompressThreadPool;
+    std::vector<GTiffDecompressionJob> asDecompressionJobs;
+    std::map<int, int> oMapBlockIdToDecompressionJob;
+    int            nMultiThreadedReadDepth;
+    int            nMTReadBlockXOff1;
+    int            nMTReadBlockYOff1;
+    int            nMTReadBlockXOff2;
+    int            nMTReadBlockYOff2;
+    void           InitDecompressionThreads(char** papszOptions);
+    CPLWorkerThreadPool* GetDecompressThreadPool();
+    static void    ThreadDecompressionFunc(void* pData);
+    int            CanUseMultiThreadedRead();
+    void           StartMultiThreadedRead(int nXOff, int nYOff,
+                                          int nXSize, int nYSize);
+    void           EndMultiThreadedRead();
+    void           FreeDecompressionJobs();
+    void           DecompressBlocksInThreads(int nBlockId);
+    int            FetchPreDecodedBlock(int nBlockId, GByte* pabyDst,
+                                        int nReqSize);
+
     int            GuessJPEGQuality(int& bOutHasQuantizationTable,
                                     int& bOutHasHuffmanTable);
 
@@ -1175,6 +1217,14 @@ public:
                             bool bIsByteSwapped, bool bIsComplex,
                             int nBlockId)
     {
+        if( !bIsByteSwapped )
+        {
+            // Memory mapped file: no copy needed.
+            const GByte* pabyData = (const GByte*)
+                VSIFGetDirectPointerL(fp, nOffset, nPixels * nDTSize);
+            if( pabyData != NULL )
+                return pabyData;
+        }
         if( !FetchBytes(pTempBuffer, nOffset, nPixels, nDTSize, bIsByteSwapped,
                         bIsComplex, nBlockId) )
         {
@@ -1189,36 +1239,49 @@ public:
                      bool bIsByteSwapped, bool bIsComplex,
                      int nBlockId)
     {
-        vsi_l_offset nSeekForward = 0;
-        if( nOffset <= VSIFTellL(fp) ||
-            (nSeekForward = nOffset - VSIFTellL(fp)) > nTempBufferSize )
+        if( VSIFHasPReadL(fp) )
         {
-            if( VSIFSeekL(fp, nOffset, SEEK_SET) != 0 )
+            if( VSIFPReadL(pabyDstBuffer, nPixels * nDTSize, nOffset, fp) !=
+                                        static_cast<size_t>(nPixels * nDTSize) )
             {
                 CPLError(CE_Failure, CPLE_FileIO,
-                         "Cannot seek to block %d", nBlockId);
+                        "Missing data for block %d", nBlockId);
                 return false;
             }
         }
         else
         {
-            while( nSeekForward > 0 )
+            vsi_l_offset nSeekForward = 0;
+            if( nOffset <= VSIFTellL(fp) ||
+                (nSeekForward = nOffset - VSIFTellL(fp)) > nTempBufferSize )
             {
-                size_t nToRead = (size_t) MIN( nTempBufferSize, nSeekForward );
-                if( VSIFReadL(pTempBuffer, nToRead, 1, fp) != 1 )
+                if( VSIFSeekL(fp, nOffset, SEEK_SET) != 0 )
                 {
                     CPLError(CE_Failure, CPLE_FileIO,
                              "Cannot seek to block %d", nBlockId);
                     return false;
                 }
-                nSeekForward -= nToRead;
             }
-        }
-        if( VSIFReadL(pabyDstBuffer, nPixels * nDTSize, 1, fp) != 1 )
-        {
-            CPLError(CE_Failure, CPLE_FileIO,
-                    "Missing data for block %d", nBlockId);
-            return false;
+            else
+            {
+                while( nSeekForward > 0 )
+                {
+                    size_t nToRead = (size_t) MIN( nTempBufferSize, nSeekForward );
+                    if( VSIFReadL(pTempBuffer, nToRead, 1, fp) != 1 )
+                    {
+                        CPLError(CE_Failure, CPLE_FileIO,
+                                 "Cannot seek to block %d", nBlockId);
+                        return false;
+                    }
+                    nSeekForward -= nToRead;
+                }
+            }
+            if( VSIFReadL(pabyDstBuffer, nPixels * nDTSize, 1, fp) != 1 )
+            {
+                CPLError(CE_Failure, CPLE_FileIO,
+                        "Missing data for block %d", nBlockId);
+                return false;
+            }
         }
 
         if( bIsByteSwapped )
@@ -1797,12 +1860,20 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
             return (CPLErr)nErr;
     }
 
+    const bool bMultiThreadedRead = eRWFlag == GF_Read &&
+                                    CanUseMultiThreadedRead();
+    if( bMultiThreadedRead )
+        StartMultiThreadedRead(nXOff, nYOff, nXSize, nYSize);
+
     nJPEGOverviewVisibilityFlag ++;
     eErr =  GDALPamDataset::IRasterIO(
                 eRWFlag, nXOff, nYOff, nXSize, nYSize,
                 pData, nBufXSize, nBufYSize, eBufType,
                 nBandCount, panBandMap, nPixelSpace, nLineSpace, nBandSpace, psExtraArg);
     nJPEGOverviewVisibilityFlag --;
+
+    if( bMultiThreadedRead )
+        EndMultiThreadedRead();
     return eErr;
 }
 
@@ -3489,12 +3560,20 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
         }
     }
 
+    const bool bMultiThreadedRead = eRWFlag == GF_Read &&
+                                    poGDS->CanUseMultiThreadedRead();
+    if( bMultiThreadedRead )
+        poGDS->StartMultiThreadedRead(nXOff, nYOff, nXSize, nYSize);
+
     poGDS->nJPEGOverviewVisibilityFlag ++;
     eErr = GDALPamRasterBand::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
                                         pData, nBufXSize, nBufYSize, eBufType,
                                         nPixelSpace, nLineSpace, psExtraArg);
     poGDS->nJPEGOverviewVisibilityFlag --;
 
+    if( bMultiThreadedRead )
+        poGDS->EndMultiThreadedRead();
+
     poGDS->bLoadingOtherBands = FALSE;
 
     return eErr;
@@ -3581,6 +3660,12 @@ CPLErr GTiffRasterBand::IReadBlock( int nBlockXOff, int nBlockYOff,
         if( nBlockReqSize < nBlockBufSize )
             memset( pImage, 0, nBlockBufSize );
 
+        if( poGDS->FetchPreDecodedBlock( nBlockId, (GByte*) pImage,
+                                         nBlockReqSize ) )
+        {
+            return CE_None;
+        }
+
         if( TIFFIsTiled( poGDS->hTIFF ) )
         {
             if( TIFFReadEncodedTile( poGDS->hTIFF, nBlockId, pImage,
@@ -5978,6 +6063,14 @@ GTiffDataset::GTiffDataset() :
     poCompressThreadPool = NULL;
     hCompressThreadPoolMutex = NULL;
 
+    nDecompressThreads = 0;
+    poDecompressThreadPool = NULL;
+    nMultiThreadedReadDepth = 0;
+    nMTReadBlockXOff1 = 0;
+    nMTReadBlockYOff1 = 0;
+    nMTReadBlockXOff2 = -1;
+    nMTReadBlockYOff2 = -1;
+
     m_pTempBufferForCommonDirectIO = NULL;
     m_nTempBufferForCommonDirectIOSize = 0;
 }
@@ -6162,6 +6255,13 @@ int GTiffDataset::Finalize()
     CPLFree(pabyTempWriteBuffer);
     pabyTempWriteBuffer = NULL;
 
+    FreeDecompressionJobs();
+    if( poDecompressThreadPool )
+    {
+        delete poDecompressThreadPool;
+        poDecompressThreadPool = NULL;
+    }
+
     if( ppoActiveDSRef != NULL && *ppoActiveDSRef == this )
         *ppoActiveDSRef = NULL;
     ppoActiveDSRef = NULL;
@@ -6554,71 +6654,86 @@ bool GTiffDataset::WriteEncodedStrip(uint32 strip, GByte* pabyData,
 }
 
 /************************************************************************/
-/*                        InitCompressionThreads()                      */
+/*                         GTiffGetNumThreads()                         */
+/*                                                                      */
+/*      Return the value of the NUM_THREADS option (or of the           */
+/*      GDAL_NUM_THREADS configuration option), or 0 if not set.        */
 /************************************************************************/
 
-void GTiffDataset::InitCompressionThreads(char** papszOptions)
+static int GTiffGetNumThreads(char** papszOptions)
 {
     const char* pszValue = CSLFetchNameValue( papszOptions, "NUM_THREADS" );
     if (pszValue == NULL)
         pszValue = CPLGetConfigOption("GDAL_NUM_THREADS", NULL);
-    if( pszValue )
+    if( pszValue == NULL )
+        return 0;
+
+    int nThreads;
+    if (EQUAL(pszValue, "ALL_CPUS"))
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszValue);
+    if( nThreads < 0 || (nThreads <= 1 && !EQUAL(pszValue, "0") &&
+                         !EQUAL(pszValue, "1") && !EQUAL(pszValue, "ALL_CPUS")) )
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for NUM_THREADS: %s", pszValue);
+        return 0;
+    }
+    return nThreads;
+}
+
+/************************************************************************/
+/*                        InitCompressionThreads()                      */
+/************************************************************************/
+
+void GTiffDataset::InitCompressionThreads(char** papszOptions)
+{
+    const int nThreads = GTiffGetNumThreads(papszOptions);
+    if( nThreads > 1 )
     {
-        int nThreads;
-        if (EQUAL(pszValue, "ALL_CPUS"))
-            nThreads = CPLGetNumCPUs();
+        if( nCompression == COMPRESSION_NONE ||
+            nCompression == COMPRESSION_JPEG )
+        {
+            CPLDebug("GTiff", "NUM_THREADS ignored with uncompressed or JPEG");
+        }
         else
-            nThreads = atoi(pszValue);
-        if( nThreads > 1 )
         {
-            if( nCompression == COMPRESSION_NONE ||
-                nCompression == COMPRESSION_JPEG )
+            CPLDebug("GTiff", "Using %d threads for compression", nThreads);
+            poCompressThreadPool = new CPLWorkerThreadPool();
+            if( !poCompressThreadPool->Setup(nThreads, NULL, NULL) )
             {
-                CPLDebug("GTiff", "NUM_THREADS ignored with uncompressed or JPEG");
+                delete poCompressThreadPool;
+                poCompressThreadPool = NULL;
             }
             else
             {
-                CPLDebug("GTiff", "Using %d threads for compression", nThreads);
-                poCompressThreadPool = new CPLWorkerThreadPool();
-                if( !poCompressThreadPool->Setup(nThreads, NULL, NULL) )
-                {
-                    delete poCompressThreadPool;
-                    poCompressThreadPool = NULL;
-                }
-                else
+                // Add a margin of an extra job w.r.t thread number
+                // so as to optimize compression time (enables the main
+                // thread to do boring I/O while all CPUs are working)
+                asCompressionJobs.resize(nThreads + 1);
+                memset(&asCompressionJobs[0], 0,
+                       asCompressionJobs.size() * sizeof(GTiffCompressionJob));
+                for(int i=0;i<(int)asCompressionJobs.size();i++)
                 {
-                    // Add a margin of an extra job w.r.t thread number
-                    // so as to optimize compression time (enables the main
-                    // thread to do boring I/O while all CPUs are working)
-                    asCompressionJobs.resize(nThreads + 1);
-                    memset(&asCompressionJobs[0], 0,
-                           asCompressionJobs.size() * sizeof(GTiffCompressionJob));
-                    for(int i=0;i<(int)asCompressionJobs.size();i++)
-                    {
-                        asCompressionJobs[i].pszTmpFilename = 
-                            CPLStrdup(CPLSPrintf("/vsimem/gtiff/thread/job/%p",
-                                                 &asCompressionJobs[i]));
-                        asCompressionJobs[i].nStripOrTile = -1;
-                    }
-                    hCompressThreadPoolMutex = CPLCreateMutex();
-                    CPLReleaseMutex(hCompressThreadPoolMutex);
-
-                    // This is kind of a hack, but basically using
-                    // TIFFWriteRawStrip/Tile and then TIFFReadEncodedStrip/Tile
-                    // does not work on a newly created file, because TIFF_MYBUFFER
-                    // is not set in tif_flags
-                    // (if using TIFFWriteEncodedStrip/Tile first, TIFFWriteBufferSetup()
-                    // is automatically called)
-                    // This should likely rather fixed in libtiff itself...
-                    TIFFWriteBufferSetup(hTIFF, NULL, (size_t)-1);
+                    asCompressionJobs[i].pszTmpFilename = 
+                        CPLStrdup(CPLSPrintf("/vsimem/gtiff/thread/job/%p",
+                                             &asCompressionJobs[i]));
+                    asCompressionJobs[i].nStripOrTile = -1;
                 }
+                hCompressThreadPoolMutex = CPLCreateMutex();
+                CPLReleaseMutex(hCompressThreadPoolMutex);
+
+                // This is kind of a hack, but basically using
+                // TIFFWriteRawStrip/Tile and then TIFFReadEncodedStrip/Tile
+                // does not work on a newly created file, because TIFF_MYBUFFER
+                // is not set in tif_flags
+                // (if using TIFFWriteEncodedStrip/Tile first, TIFFWriteBufferSetup()
+                // is automatically called)
+                // This should likely rather fixed in libtiff itself...
+                TIFFWriteBufferSetup(hTIFF, NULL, (size_t)-1);
             }
         }
-        else if (nThreads < 0 || (!EQUAL(pszValue, "0") && !EQUAL(pszValue, "1") && !EQUAL(pszValue, "ALL_CPUS")) )
-        {
-            CPLError(CE_Warning, CPLE_AppDefined,
-                     "Invalid value for NUM_THREADS: %s", pszValue);
-        }
     }
 }
 
@@ -6851,6 +6966,428 @@ int GTiffDataset::SubmitCompressionJob(int nStripOrTile, GByte* pabyData,
     return TRUE;
 }
 
+/************************************************************************/
+/*                       InitDecompressionThreads()                     */
+/************************************************************************/
+
+void GTiffDataset::InitDecompressionThreads(char** papszOptions)
+{
+    const int nThreads = GTiffGetNumThreads(papszOptions);
+    if( nThreads > 1 )
+    {
+        // The worker pool is lazily instanciated by GetDecompressThreadPool()
+        nDecompressThreads = nThreads;
+    }
+}
+
+/************************************************************************/
+/*                       GetDecompressThreadPool()                      */
+/************************************************************************/
+
+CPLWorkerThreadPool* GTiffDataset::GetDecompressThreadPool()
+{
+    // Overviews and masks share the worker pool of the main dataset
+    if( poBaseDS != NULL )
+        return poBaseDS->GetDecompressThreadPool();
+
+    if( poDecompressThreadPool == NULL && nDecompressThreads > 1 )
+    {
+        CPLDebug("GTiff", "Using %d threads for decompression",
+                 nDecompressThreads);
+        poDecompressThreadPool = new CPLWorkerThreadPool();
+        if( !poDecompressThreadPool->Setup(nDecompressThreads, NULL, NULL) )
+        {
+            delete poDecompressThreadPool;
+            poDecompressThreadPool = NULL;
+        }
+        // Do not retry on failure
+        nDecompressThreads = 0;
+    }
+    return poDecompressThreadPool;
+}
+
+/************************************************************************/
+/*                       CanUseMultiThreadedRead()                      */
+/************************************************************************/
+
+int GTiffDataset::CanUseMultiThreadedRead()
+{
+    if( eAccess == GA_Update || bStreamingIn ||
+        bTreatAsRGBA || bTreatAsSplit || bTreatAsSplitBitmap ||
+        (nBitsPerSample % 8) != 0 ||
+        nPhotometric == PHOTOMETRIC_YCBCR )
+        return FALSE;
+
+    if( !(nCompression == COMPRESSION_ADOBE_DEFLATE ||
+          nCompression == COMPRESSION_LZW ||
+          nCompression == COMPRESSION_PACKBITS ||
+          nCompression == COMPRESSION_LZMA) )
+        return FALSE;
+
+    return GetDecompressThreadPool() != NULL;
+}
+
+/************************************************************************/
+/*                        StartMultiThreadedRead()                      */
+/*                                                                      */
+/*      Declare the window of a RasterIO() read request, so that        */
+/*      blocks intersecting it can be decoded by worker threads when    */
+/*      they are first requested by IReadBlock() / LoadBlockBuf().      */
+/************************************************************************/
+
+void GTiffDataset::StartMultiThreadedRead(int nXOff, int nYOff,
+                                          int nXSize, int nYSize)
+{
+    nMultiThreadedReadDepth ++;
+    if( nMultiThreadedReadDepth > 1 )
+        return;
+
+    nMTReadBlockXOff1 = nXOff / nBlockXSize;
+    nMTReadBlockYOff1 = nYOff / nBlockYSize;
+    nMTReadBlockXOff2 = (nXOff + nXSize - 1) / nBlockXSize;
+    nMTReadBlockYOff2 = (nYOff + nYSize - 1) / nBlockYSize;
+}
+
+/************************************************************************/
+/*                         EndMultiThreadedRead()                       */
+/************************************************************************/
+
+void GTiffDataset::EndMultiThreadedRead()
+{
+    CPLAssert( nMultiThreadedReadDepth > 0 );
+    nMultiThreadedReadDepth --;
+    if( nMultiThreadedReadDepth == 0 )
+    {
+        FreeDecompressionJobs();
+        nMTReadBlockXOff2 = -1;
+        nMTReadBlockYOff2 = -1;
+    }
+}
+
+/************************************************************************/
+/*                        FreeDecompressionJobs()                       */
+/************************************************************************/
+
+void GTiffDataset::FreeDecompressionJobs()
+{
+    for(int i=0;i<(int)asDecompressionJobs.size();i++)
+    {
+        CPLFree(asDecompressionJobs[i].pabyCompressedBuffer);
+        CPLFree(asDecompressionJobs[i].pabyBuffer);
+        CPLFree(asDecompressionJobs[i].pszTmpFilename);
+    }
+    asDecompressionJobs.resize(0);
+    oMapBlockIdToDecompressionJob.clear();
+}
+
+/************************************************************************/
+/*                       ThreadDecompressionFunc()                      */
+/************************************************************************/
+
+void GTiffDataset::ThreadDecompressionFunc(void* pData)
+{
+    GTiffDecompressionJob* psJob = (GTiffDecompressionJob*)pData;
+    GTiffDataset* poDS = psJob->poDS;
+
+    // Errors are silently ignored here: the block will be read again
+    // in the main thread, which will report them.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+
+    if( psJob->fpPRead != NULL &&
+        VSIFPReadL(psJob->pabyCompressedBuffer, psJob->nCompressedBufferSize,
+                   psJob->nCompressedOffset, psJob->fpPRead) !=
+                            static_cast<size_t>(psJob->nCompressedBufferSize) )
+    {
+        CPLPopErrorHandler();
+        return;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Wrap the raw strip/tile into a single-strip in-memory TIFF      */
+/*      with the same characteristics as the source.                    */
+/* -------------------------------------------------------------------- */
+    VSILFILE* fpTmp = VSIFOpenL(psJob->pszTmpFilename, "wb+");
+    TIFF* hTIFFTmp = VSI_TIFFOpen(psJob->pszTmpFilename,
+        (psJob->bTIFFIsBigEndian) ? "wb+" : "wl+", fpTmp);
+    if( hTIFFTmp == NULL )
+    {
+        if( fpTmp )
+            VSIFCloseL(fpTmp);
+        VSIUnlink(psJob->pszTmpFilename);
+        CPLPopErrorHandler();
+        return;
+    }
+    TIFFSetField(hTIFFTmp, TIFFTAG_IMAGEWIDTH, poDS->nBlockXSize);
+    TIFFSetField(hTIFFTmp, TIFFTAG_IMAGELENGTH, psJob->nHeight);
+    TIFFSetField(hTIFFTmp, TIFFTAG_BITSPERSAMPLE, poDS->nBitsPerSample);
+    TIFFSetField(hTIFFTmp, TIFFTAG_COMPRESSION, poDS->nCompression);
+    if( psJob->nPredictor != PREDICTOR_NONE )
+        TIFFSetField(hTIFFTmp, TIFFTAG_PREDICTOR, psJob->nPredictor);
+    // The color table is not needed to decode the data
+    TIFFSetField(hTIFFTmp, TIFFTAG_PHOTOMETRIC,
+                 (poDS->nPhotometric == PHOTOMETRIC_PALETTE) ?
+                        PHOTOMETRIC_MINISBLACK : poDS->nPhotometric);
+    TIFFSetField(hTIFFTmp, TIFFTAG_SAMPLEFORMAT, poDS->nSampleFormat);
+    TIFFSetField(hTIFFTmp, TIFFTAG_SAMPLESPERPIXEL, poDS->nSamplesPerPixel);
+    TIFFSetField(hTIFFTmp, TIFFTAG_ROWSPERSTRIP, psJob->nHeight);
+    TIFFSetField(hTIFFTmp, TIFFTAG_PLANARCONFIG, poDS->nPlanarConfig);
+
+    bool bOK = TIFFWriteRawStrip(hTIFFTmp, 0, psJob->pabyCompressedBuffer,
+                            psJob->nCompressedBufferSize) ==
+                                        psJob->nCompressedBufferSize;
+    XTIFFClose(hTIFFTmp);
+    VSIFCloseL(fpTmp);
+
+/* -------------------------------------------------------------------- */
+/*      Reopen it and let libtiff decode the strip.                     */
+/* -------------------------------------------------------------------- */
+    if( bOK )
+    {
+        fpTmp = VSIFOpenL(psJob->pszTmpFilename, "rb");
+        hTIFFTmp = (fpTmp != NULL) ?
+            VSI_TIFFOpen(psJob->pszTmpFilename, "r", fpTmp) : NULL;
+        bOK = hTIFFTmp != NULL;
+        if( bOK )
+        {
+            bOK = TIFFReadEncodedStrip(hTIFFTmp, 0, psJob->pabyBuffer,
+                                       psJob->nReqSize) != -1;
+            XTIFFClose(hTIFFTmp);
+        }
+        if( fpTmp )
+            VSIFCloseL(fpTmp);
+    }
+    VSIUnlink(psJob->pszTmpFilename);
+
+    CPLPopErrorHandler();
+
+    psJob->bSuccess = bOK;
+}
+
+/************************************************************************/
+/*                     DecompressBlocksInThreads()                      */
+/*                                                                      */
+/*      Read the raw data of nBlockId and of the following blocks of    */
+/*      the same band inside the current RasterIO() window, and decode  */
+/*      them with the worker threads.                                   */
+/************************************************************************/
+
+void GTiffDataset::DecompressBlocksInThreads(int nBlockId)
+{
+    FreeDecompressionJobs();
+
+    CPLWorkerThreadPool* poPool = GetDecompressThreadPool();
+    if( poPool == NULL || !SetDirectory() )
+        return;
+
+    const bool bIsTiled = TIFFIsTiled(hTIFF) != 0;
+    const int nBlockBufSize = static_cast<int>(bIsTiled ? TIFFTileSize(hTIFF) :
+                                                          TIFFStripSize(hTIFF));
+    if( nBlockBufSize <= 0 )
+        return;
+
+    toff_t *panByteCounts = NULL;
+    if( !TIFFGetField( hTIFF,
+                       bIsTiled ? TIFFTAG_TILEBYTECOUNTS : TIFFTAG_STRIPBYTECOUNTS,
+                       &panByteCounts ) || panByteCounts == NULL )
+        return;
+
+    // When the file supports positional reads, the worker threads read
+    // the raw data themselves, concurrently.
+    toff_t *panOffsets = NULL;
+    VSILFILE* fpPRead = VSI_TIFFGetVSILFile(TIFFClientdata( hTIFF ));
+    if( !VSIFHasPReadL(fpPRead) ||
+        !TIFFGetField( hTIFF,
+                       bIsTiled ? TIFFTAG_TILEOFFSETS : TIFFTAG_STRIPOFFSETS,
+                       &panOffsets ) || panOffsets == NULL )
+        fpPRead = NULL;
+
+    uint16 nPredictor = PREDICTOR_NONE;
+    if ( nCompression == COMPRESSION_LZW ||
+         nCompression == COMPRESSION_ADOBE_DEFLATE )
+    {
+        TIFFGetField( hTIFF, TIFFTAG_PREDICTOR, &nPredictor );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Bound the memory used by the decoded blocks to a fraction of    */
+/*      the block cache, and make each thread handle a few blocks.      */
+/* -------------------------------------------------------------------- */
+    const int nThreads = poPool->GetThreadCount();
+    GIntBig nMaxBlocks = GDALGetCacheMax64() / 4 / nBlockBufSize;
+    if( nMaxBlocks > 4 * nThreads )
+        nMaxBlocks = 4 * nThreads;
+    if( nMaxBlocks < 2 )
+        return;
+
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    const int nBandOffset = nBlockId - (nBlockId % nBlocksPerBand);
+    const int nBlockIdBand0 = nBlockId % nBlocksPerBand;
+    const int iBand = (nPlanarConfig == PLANARCONFIG_SEPARATE) ?
+                                    nBlockId / nBlocksPerBand + 1 : 1;
+    if( iBand > nBands )
+        return;
+    GTiffRasterBand* poBand = (GTiffRasterBand*) GetRasterBand(iBand);
+
+    int nBlockXOff = nBlockIdBand0 % nBlocksPerRow;
+    int nBlockYOff = nBlockIdBand0 / nBlocksPerRow;
+
+    std::vector<int> anBlockIds;
+    for( ; nBlockYOff <= nMTReadBlockYOff2 &&
+           (int)anBlockIds.size() < nMaxBlocks; nBlockYOff ++ )
+    {
+        for( ; nBlockXOff <= nMTReadBlockXOff2 &&
+               (int)anBlockIds.size() < nMaxBlocks; nBlockXOff ++ )
+        {
+            const int nCurBlockId = nBandOffset +
+                                    nBlockXOff + nBlockYOff * nBlocksPerRow;
+            if( nCurBlockId != nBlockId )
+            {
+                // Skip blocks that will not need to be decoded
+                if( nCurBlockId == nLoadedBlock &&
+                    nBands > 1 && nPlanarConfig == PLANARCONFIG_CONTIG )
+                    continue;
+                GDALRasterBlock* poBlock =
+                    poBand->TryGetLockedBlockRef(nBlockXOff, nBlockYOff);
+                if( poBlock != NULL )
+                {
+                    poBlock->DropLock();
+                    continue;
+                }
+            }
+            if( !IsBlockAvailable(nCurBlockId) ||
+                panByteCounts[nCurBlockId] == 0 ||
+                panByteCounts[nCurBlockId] > INT_MAX )
+                continue;
+            anBlockIds.push_back(nCurBlockId);
+        }
+        nBlockXOff = nMTReadBlockXOff1;
+    }
+    if( anBlockIds.size() < 2 )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      Read the raw strips/tiles in the calling thread, unless the     */
+/*      threads can do it with VSIFPReadL().                            */
+/* -------------------------------------------------------------------- */
+    asDecompressionJobs.resize(anBlockIds.size());
+    memset(&asDecompressionJobs[0], 0,
+           asDecompressionJobs.size() * sizeof(GTiffDecompressionJob));
+    std::vector<void*> apJobs;
+    for( size_t i = 0; i < anBlockIds.size(); i++ )
+    {
+        const int nCurBlockId = anBlockIds[i];
+        GTiffDecompressionJob* psJob = &asDecompressionJobs[i];
+        psJob->poDS = this;
+        psJob->bTIFFIsBigEndian = TIFFIsBigEndian(hTIFF);
+        psJob->nPredictor = nPredictor;
+        psJob->nStripOrTile = nCurBlockId;
+
+        const int nCurBlockYOff = (nCurBlockId % nBlocksPerBand) / nBlocksPerRow;
+        psJob->nHeight = nBlockYSize;
+        psJob->nReqSize = nBlockBufSize;
+        if( (nCurBlockYOff+1) * nBlockYSize > (uint32)nRasterYSize )
+        {
+            // See LoadBlockBuf() for the partially encoded bottom blocks
+            const int nRows = nBlockYSize -
+                (((nCurBlockYOff+1) * nBlockYSize) % nRasterYSize);
+            psJob->nReqSize = (nBlockBufSize / nBlockYSize) * nRows;
+            if( !bIsTiled )
+                psJob->nHeight = nRows;
+        }
+
+        psJob->nCompressedBufferSize = static_cast<int>(panByteCounts[nCurBlockId]);
+        psJob->pabyCompressedBuffer = (GByte*)
+                            VSI_MALLOC_VERBOSE(psJob->nCompressedBufferSize);
+        psJob->pabyBuffer = (GByte*) VSI_CALLOC_VERBOSE(1, nBlockBufSize);
+        psJob->nBufferSize = nBlockBufSize;
+        if( psJob->pabyCompressedBuffer == NULL || psJob->pabyBuffer == NULL )
+            continue;
+
+        if( fpPRead != NULL )
+        {
+            psJob->fpPRead = fpPRead;
+            psJob->nCompressedOffset = panOffsets[nCurBlockId];
+        }
+        else
+        {
+            const tmsize_t nRead = bIsTiled ?
+                TIFFReadRawTile(hTIFF, nCurBlockId, psJob->pabyCompressedBuffer,
+                                psJob->nCompressedBufferSize) :
+                TIFFReadRawStrip(hTIFF, nCurBlockId, psJob->pabyCompressedBuffer,
+                                 psJob->nCompressedBufferSize);
+            if( nRead != psJob->nCompressedBufferSize )
+                continue;
+        }
+
+        psJob->pszTmpFilename =
+            CPLStrdup(CPLSPrintf("/vsimem/gtiff/thread/decompress_job/%p",
+                                 psJob));
+        apJobs.push_back(psJob);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Decode them in the worker threads.                              */
+/* -------------------------------------------------------------------- */
+    poPool->SubmitJobs(ThreadDecompressionFunc, apJobs);
+    poPool->WaitCompletion();
+
+    for( size_t i = 0; i < asDecompressionJobs.size(); i++ )
+    {
+        // Failed jobs are registered too, so that FetchPreDecodedBlock()
+        // does not trigger a new batch for them
+        oMapBlockIdToDecompressionJob[asDecompressionJobs[i].nStripOrTile] =
+                                                            static_cast<int>(i);
+        CPLFree(asDecompressionJobs[i].pabyCompressedBuffer);
+        asDecompressionJobs[i].pabyCompressedBuffer = NULL;
+    }
+}
+
+/************************************************************************/
+/*                        FetchPreDecodedBlock()                        */
+/*                                                                      */
+/*      Copy the content of a block decoded by a worker thread into     */
+/*      pabyDst. Returns FALSE if the block must be read as usual.      */
+/************************************************************************/
+
+int GTiffDataset::FetchPreDecodedBlock(int nBlockId, GByte* pabyDst,
+                                       int nReqSize)
+{
+    if( nMultiThreadedReadDepth == 0 )
+        return FALSE;
+
+    std::map<int, int>::iterator oIter =
+                            oMapBlockIdToDecompressionJob.find(nBlockId);
+    if( oIter == oMapBlockIdToDecompressionJob.end() )
+    {
+        const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+        const int nBlockIdBand0 = nBlockId % nBlocksPerBand;
+        const int nBlockXOff = nBlockIdBand0 % nBlocksPerRow;
+        const int nBlockYOff = nBlockIdBand0 / nBlocksPerRow;
+        if( nBlockXOff < nMTReadBlockXOff1 || nBlockXOff > nMTReadBlockXOff2 ||
+            nBlockYOff < nMTReadBlockYOff1 || nBlockYOff > nMTReadBlockYOff2 )
+            return FALSE;
+
+        DecompressBlocksInThreads(nBlockId);
+
+        oIter = oMapBlockIdToDecompressionJob.find(nBlockId);
+        if( oIter == oMapBlockIdToDecompressionJob.end() )
+            return FALSE;
+    }
+
+    GTiffDecompressionJob* psJob = &asDecompressionJobs[oIter->second];
+    const int bSuccess = psJob->bSuccess && psJob->pabyBuffer != NULL &&
+                         nReqSize <= psJob->nReqSize;
+    if( bSuccess )
+        memcpy(pabyDst, psJob->pabyBuffer, nReqSize);
+
+    // Each block is consumed only once
+    CPLFree(psJob->pabyBuffer);
+    psJob->pabyBuffer = NULL;
+    oMapBlockIdToDecompressionJob.erase(oIter);
+
+    return bSuccess;
+}
+
 /************************************************************************/
 /*                          DiscardLsb()                               */
 /************************************************************************/
@@ -7091,7 +7628,11 @@ CPLErr GTiffDataset::LoadBlockBuf( int nBlockId, int bReadFromDisk )
 /* -------------------------------------------------------------------- */
 /*      Load the block, if it isn't our current block.                  */
 /* -------------------------------------------------------------------- */
-    if( TIFFIsTiled( hTIFF ) )
+    if( FetchPreDecodedBlock( nBlockId, pabyBlockBuf, nBlockReqSize ) )
+    {
+        /* nothing to do */
+    }
+    else if( TIFFIsTiled( hTIFF ) )
     {
         if( TIFFReadEncodedTile(hTIFF, nBlockId, pabyBlockBuf,
                                 nBlockReqSize) == -1
@@ -9848,6 +10389,10 @@ GDALDataset *GTiffDataset::Open( GDALOpenInfo * poOpenInfo )
     {
         poDS->InitCreationOrOpenOptions(poOpenInfo->papszOpenOptions);
     }
+    else
+    {
+        poDS->InitDecompressionThreads(poOpenInfo->papszOpenOptions);
+    }
 
     if( nCompression == COMPRESSION_JPEG && poOpenInfo->eAccess == GA_Update )
     {
@@ -15123,7 +15668,7 @@ void GDALRegister_GTiff()
                                    szCreateOptions );
         poDriver->SetMetadataItem( GDAL_DMD_OPENOPTIONLIST, 
 "<OpenOptionList>"
-"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression. Can be set to ALL_CPUS' default='1'/>"
+"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression (update mode) or decompression (read-only mode). Can be set to ALL_CPUS' default='1'/>"
 "   <Option name='GEOTIFF_KEYS_FLAVOR' type='string-select' default='STANDARD' description='Which flavor of GeoTIFF keys must be used (for writing)'>"
 "       <Value>STANDARD</Value>"
 "       <Value>ESRI_PE</Value>"
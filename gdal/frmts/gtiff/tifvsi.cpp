@@ -209,11 +209,25 @@ _tiffSizeProc(thandle_t th)
     return file_size;
 }
 
+/* When the underlying handle is memory mapped (VSI_USE_MMAP=YES), let */
+/* libtiff read strips and tiles directly from the mapping. */
 static int
 _tiffMapProc(thandle_t th, tdata_t* pbase, toff_t* psize)
 {
-	(void) th; (void) pbase; (void) psize;
-	return (0);
+    GDALTiffHandle* psGTH = (GDALTiffHandle*) th;
+    if( VSIFGetDirectPointerL( psGTH->fpL, 0, 0 ) == NULL )
+        return 0;
+
+    const toff_t nSize = _tiffSizeProc(th);
+    if( nSize != (toff_t)(size_t)nSize )
+        return 0;
+    const void* pBase = VSIFGetDirectPointerL( psGTH->fpL, 0, (size_t)nSize );
+    if( pBase == NULL )
+        return 0;
+
+    *pbase = (tdata_t) pBase;
+    *psize = nSize;
+    return 1;
 }
 
 static void
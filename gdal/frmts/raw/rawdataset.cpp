@@ -262,6 +262,29 @@ CPLErr RawRasterBand::FlushCache()
     return CE_None;
 }
 
+/************************************************************************/
+/*                         ComputeLineExtent()                          */
+/*                                                                      */
+/*      Return the file offset and number of bytes to read for a        */
+/*      scanline, taking care not to request more bytes than needed.    */
+/************************************************************************/
+
+void RawRasterBand::ComputeLineExtent( int iLine, vsi_l_offset &nReadStart,
+                                       size_t &nBytesToRead )
+
+{
+    if( nPixelOffset >= 0 )
+        nReadStart = nImgOffset + (vsi_l_offset)iLine * nLineOffset;
+    else
+    {
+        nReadStart = nImgOffset + (vsi_l_offset)iLine * nLineOffset
+            - std::abs(nPixelOffset) * (nBlockXSize-1);
+    }
+
+    nBytesToRead = std::abs(nPixelOffset) * (nBlockXSize - 1)
+        + GDALGetDataTypeSize(GetRasterDataType()) / 8;
+}
+
 /************************************************************************/
 /*                             AccessLine()                             */
 /************************************************************************/
@@ -279,18 +302,14 @@ CPLErr RawRasterBand::AccessLine( int iLine )
 /*      Figure out where to start reading.                              */
 /* -------------------------------------------------------------------- */
     vsi_l_offset nReadStart;
-    if( nPixelOffset >= 0 )
-        nReadStart = nImgOffset + (vsi_l_offset)iLine * nLineOffset;
-    else
-    {
-        nReadStart = nImgOffset + (vsi_l_offset)iLine * nLineOffset
-            - std::abs(nPixelOffset) * (nBlockXSize-1);
-    }
+    size_t nBytesToRead;
+    ComputeLineExtent( iLine, nReadStart, nBytesToRead );
 
 /* -------------------------------------------------------------------- */
-/*      Seek to the right line.                                         */
+/*      Seek to the right line, unless we can use a positional read.    */
 /* -------------------------------------------------------------------- */
-    if( Seek(nReadStart, SEEK_SET) == -1 )
+    const bool bUsePRead = bIsVSIL && VSIFHasPReadL(fpRawL);
+    if( !bUsePRead && Seek(nReadStart, SEEK_SET) == -1 )
     {
         if (poDS != NULL && poDS->GetAccess() == GA_ReadOnly)
         {
@@ -308,14 +327,12 @@ CPLErr RawRasterBand::AccessLine( int iLine )
     }
 
 /* -------------------------------------------------------------------- */
-/*      Read the line.  Take care not to request any more bytes than    */
-/*      are needed, and not to lose a partially successful scanline     */
-/*      read.                                                           */
+/*      Read the line.  Take care not to lose a partially successful    */
+/*      scanline read.                                                  */
 /* -------------------------------------------------------------------- */
-    const size_t nBytesToRead = std::abs(nPixelOffset) * (nBlockXSize - 1)
-        + GDALGetDataTypeSize(GetRasterDataType()) / 8;
-
-    const size_t nBytesActuallyRead = Read( pLineBuffer, 1, nBytesToRead );
+    const size_t nBytesActuallyRead = bUsePRead ?
+        VSIFPReadL( pLineBuffer, nBytesToRead, nReadStart, fpRawL ) :
+        Read( pLineBuffer, 1, nBytesToRead );
     if( nBytesActuallyRead < nBytesToRead )
     {
         if (poDS != NULL && poDS->GetAccess() == GA_ReadOnly)
@@ -368,6 +385,30 @@ CPLErr RawRasterBand::IReadBlock( CPL_UNUSED int nBlockXOff,
     if (pLineBuffer == NULL)
         return CE_Failure;
 
+/* -------------------------------------------------------------------- */
+/*      If the file is memory mapped and no byte swapping is needed,    */
+/*      copy straight from the mapping to the user block buffer.        */
+/* -------------------------------------------------------------------- */
+    if( bIsVSIL && (bNativeOrder || eDataType == GDT_Byte) )
+    {
+        vsi_l_offset nReadStart;
+        size_t nBytesToRead;
+        ComputeLineExtent( nBlockYOff, nReadStart, nBytesToRead );
+
+        const GByte* pabyLine = reinterpret_cast<const GByte *>(
+            VSIFGetDirectPointerL( fpRawL, nReadStart, nBytesToRead ) );
+        if( pabyLine != NULL )
+        {
+            GDALCopyWords( pabyLine + (reinterpret_cast<GByte *>(pLineStart) -
+                                       reinterpret_cast<GByte *>(pLineBuffer)),
+                           eDataType, nPixelOffset,
+                           pImage, eDataType,
+                           GDALGetDataTypeSize(eDataType)/8,
+                           nBlockXSize );
+            return CE_None;
+        }
+    }
+
     CPLErr eErr = AccessLine( nBlockYOff );
 
 /* -------------------------------------------------------------------- */
@@ -500,9 +541,10 @@ CPLErr RawRasterBand::AccessBlock( vsi_l_offset nBlockOff, size_t nBlockSize,
                                    void * pData )
 {
 /* -------------------------------------------------------------------- */
-/*      Seek to the right block.                                        */
+/*      Seek to the right block, unless we can use a positional read.   */
 /* -------------------------------------------------------------------- */
-    if( Seek( nBlockOff, SEEK_SET ) == -1 )
+    const bool bUsePRead = bIsVSIL && VSIFHasPReadL(fpRawL);
+    if( !bUsePRead && Seek( nBlockOff, SEEK_SET ) == -1 )
     {
         memset( pData, 0, nBlockSize );
         return CE_None;
@@ -511,7 +553,9 @@ CPLErr RawRasterBand::AccessBlock( vsi_l_offset nBlockOff, size_t nBlockSize,
 /* -------------------------------------------------------------------- */
 /*      Read the block.                                                 */
 /* -------------------------------------------------------------------- */
-    const size_t nBytesActuallyRead = Read( pData, 1, nBlockSize );
+    const size_t nBytesActuallyRead = bUsePRead ?
+        VSIFPReadL( pData, nBlockSize, nBlockOff, fpRawL ) :
+        Read( pData, 1, nBlockSize );
     if( nBytesActuallyRead < nBlockSize )
     {
 
@@ -708,12 +752,22 @@ CPLErr RawRasterBand::IRasterIO( GDALRWFlag eRWFlag,
                        + static_cast<vsi_l_offset>( iLine * dfSrcYInc ) )
                     * nLineOffset
                     + nXOff * nPixelOffset;
-                if ( AccessBlock( nOffset,
-                                  nBytesToRW, pabyData ) != CE_None )
+
+                // Use the memory mapping directly when possible.
+                const GByte* pabySrc = NULL;
+                if( bIsVSIL && (bNativeOrder || eDataType == GDT_Byte) )
+                    pabySrc = reinterpret_cast<const GByte *>(
+                        VSIFGetDirectPointerL( fpRawL, nOffset, nBytesToRW ) );
+                if( pabySrc == NULL )
                 {
-                    CPLError( CE_Failure, CPLE_FileIO,
-                              "Failed to read " CPL_FRMT_GUIB " bytes at " CPL_FRMT_GUIB ".",
-                              static_cast<GUIntBig>(nBytesToRW), nOffset );
+                    if ( AccessBlock( nOffset,
+                                      nBytesToRW, pabyData ) != CE_None )
+                    {
+                        CPLError( CE_Failure, CPLE_FileIO,
+                                  "Failed to read " CPL_FRMT_GUIB " bytes at " CPL_FRMT_GUIB ".",
+                                  static_cast<GUIntBig>(nBytesToRW), nOffset );
+                    }
+                    pabySrc = pabyData;
                 }
 
 /* -------------------------------------------------------------------- */
@@ -722,7 +776,7 @@ CPLErr RawRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 /* -------------------------------------------------------------------- */
                 if ( nXSize == nBufXSize && nYSize == nBufYSize )
                 {
-                    GDALCopyWords( pabyData, eDataType, nPixelOffset,
+                    GDALCopyWords( pabySrc, eDataType, nPixelOffset,
                                    reinterpret_cast<GByte *>( pData ) +
                                    static_cast<vsi_l_offset>( iLine ) *
                                    nLineSpace,
@@ -733,7 +787,7 @@ CPLErr RawRasterBand::IRasterIO( GDALRWFlag eRWFlag,
                     for ( int iPixel = 0; iPixel < nBufXSize; iPixel++ )
                     {
                         GDALCopyWords(
-                            pabyData +
+                            pabySrc +
                             static_cast<vsi_l_offset>( iPixel * dfSrcXInc ) *
                             nPixelOffset,
                             eDataType, nPixelOffset,
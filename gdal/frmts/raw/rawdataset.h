@@ -108,6 +108,8 @@ protected:
 
     CPLErr      AccessBlock( vsi_l_offset nBlockOff, size_t nBlockSize,
                              void * pData );
+    void        ComputeLineExtent( int iLine, vsi_l_offset &nReadStart,
+                                   size_t &nBytesToRead );
     int         IsSignificantNumberOfLinesLoaded( int nLineOff, int nLines );
     void        Initialize();
 
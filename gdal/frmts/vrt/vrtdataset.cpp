@@ -32,9 +32,11 @@
 
 #include "cpl_minixml.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "ogr_spatialref.h"
 
 #include <algorithm>
+#include <new>
 
 CPL_CVSID("$Id$");
 
@@ -52,7 +54,8 @@ VRTDataset::VRTDataset( int nXSize, int nYSize ) :
     m_bWritable(TRUE),
     m_pszVRTPath(NULL),
     m_poMaskBand(NULL),
-    m_bCompatibleForDatasetIO(-1)
+    m_bCompatibleForDatasetIO(-1),
+    m_poSourceThreadPool(NULL)
 {
     nRasterXSize = nXSize;
     nRasterYSize = nYSize;
@@ -107,6 +110,47 @@ VRTDataset::~VRTDataset()
         delete m_apoOverviews[i];
     for(size_t i=0;i<m_apoOverviewsBak.size();i++)
         delete m_apoOverviewsBak[i];
+
+    delete m_poSourceThreadPool;
+}
+
+/************************************************************************/
+/*                        GetSourceThreadPool()                         */
+/*                                                                      */
+/*      Returns the pool of threads used to read the sources of the     */
+/*      bands concurrently, or NULL if VRT_NUM_THREADS does not ask     */
+/*      for more than one thread.                                       */
+/************************************************************************/
+
+CPLWorkerThreadPool *VRTDataset::GetSourceThreadPool()
+
+{
+    const char* pszThreads = CPLGetConfigOption( "VRT_NUM_THREADS", "1" );
+    int nThreads;
+    if( EQUAL(pszThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszThreads);
+    if( nThreads > 128 )
+        nThreads = 128;
+    if( nThreads <= 1 )
+        return NULL;
+
+    if( m_poSourceThreadPool != NULL &&
+        m_poSourceThreadPool->GetThreadCount() == nThreads )
+        return m_poSourceThreadPool;
+
+    delete m_poSourceThreadPool;
+    m_poSourceThreadPool = new (std::nothrow) CPLWorkerThreadPool();
+    if( m_poSourceThreadPool == NULL ||
+        !m_poSourceThreadPool->Setup( nThreads, NULL, NULL ) )
+    {
+        CPLDebug( "VRT", "Cannot create worker threads. "
+                  "Falling back to sequential reading of sources" );
+        delete m_poSourceThreadPool;
+        m_poSourceThreadPool = NULL;
+    }
+    return m_poSourceThreadPool;
 }
 
 /************************************************************************/
@@ -777,9 +821,31 @@ GDALDataset *VRTDataset::Open( GDALOpenInfo * poOpenInfo )
 
 /* -------------------------------------------------------------------- */
 /*      Turn the XML representation into a VRTDataset.                  */
+/*                                                                      */
+/*      VRTs with a huge number of sources can optionally be reopened   */
+/*      from a binary cache of their sources, which avoids building     */
+/*      the XML tree of their sources.                                  */
 /* -------------------------------------------------------------------- */
-    VRTDataset *poDS = reinterpret_cast<VRTDataset *>(
-        OpenXML( pszXML, pszVRTPath, poOpenInfo->eAccess ) );
+    const bool bUseSourceCache =
+        fp != NULL &&
+        poOpenInfo->eAccess == GA_ReadOnly &&
+        strcmp(poOpenInfo->pszFilename, "/vsistdin/") != 0 &&
+        CSLFetchNameValue(poOpenInfo->papszOpenOptions, "ROOT_PATH") == NULL &&
+        CSLTestBoolean(CPLGetConfigOption("VRT_SOURCE_CACHE", "NO"));
+
+    VRTDataset *poDS = NULL;
+    if( bUseSourceCache )
+        poDS = reinterpret_cast<VRTDataset *>(
+            OpenFromSourceCache( poOpenInfo->pszFilename, pszVRTPath ) );
+
+    if( poDS == NULL )
+    {
+        poDS = reinterpret_cast<VRTDataset *>(
+            OpenXML( pszXML, pszVRTPath, poOpenInfo->eAccess ) );
+
+        if( poDS != NULL && bUseSourceCache )
+            poDS->WriteSourceCache( poOpenInfo->pszFilename, pszVRTPath );
+    }
 
     if( poDS != NULL )
         poDS->m_bNeedsFlush = FALSE;
@@ -981,6 +1047,17 @@ CPLErr VRTDataset::AddBand( GDALDataType eType, char **papszOptions )
             if (pszFuncName != NULL)
                 poDerivedBand->SetPixelFunctionName(pszFuncName);
 
+            const char* pszExpression =
+                CSLFetchNameValue(papszOptions, "PixelFunctionExpression");
+            if (pszExpression != NULL &&
+                poDerivedBand->SetPixelFunctionExpression(pszExpression)
+                                                            != CE_None) {
+                delete poDerivedBand;
+                return CE_Failure;
+            }
+            poDerivedBand->SetPropagateNoData(
+                CSLFetchBoolean(papszOptions, "PropagateNoData", FALSE));
+
             const char* pszTransferTypeName =
                 CSLFetchNameValue(papszOptions, "SourceTransferType");
             if (pszTransferTypeName != NULL) {
@@ -1258,14 +1335,7 @@ int VRTDataset::CheckCompatibleForDatasetIO()
                 if (!EQUAL(poSource->GetType(), "SimpleSource"))
                     return FALSE;
 
-                GDALRasterBand *srcband = poSource->GetBand();
-                if (srcband == NULL)
-                    return FALSE;
-                if (srcband->GetDataset() == NULL)
-                    return FALSE;
-                if (srcband->GetDataset()->GetRasterCount() <= iBand)
-                    return FALSE;
-                if (srcband->GetDataset()->GetRasterBand(iBand + 1) != srcband)
+                if (!poSource->IsBandOfSrcDataset(iBand + 1))
                     return FALSE;
                 osResampling = poSource->GetResampling();
             }
@@ -1291,14 +1361,7 @@ int VRTDataset::CheckCompatibleForDatasetIO()
                 if (!poSource->IsSameExceptBandNumber(poRefSource))
                     return FALSE;
 
-                GDALRasterBand *srcband = poSource->GetBand();
-                if (srcband == NULL)
-                    return FALSE;
-                if (srcband->GetDataset() == NULL)
-                    return FALSE;
-                if (srcband->GetDataset()->GetRasterCount() <= iBand)
-                    return FALSE;
-                if (srcband->GetDataset()->GetRasterBand(iBand + 1) != srcband)
+                if (!poSource->IsBandOfSrcDataset(iBand + 1))
                     return FALSE;
                 if (osResampling.compare(poSource->GetResampling()) != 0)
                     return FALSE;
@@ -1369,6 +1432,42 @@ GDALDataset* VRTDataset::GetSingleSimpleSource()
     return poSrcDS;
 }
 
+/************************************************************************/
+/*                         VRTDatasetSourceIO()                         */
+/*                                                                      */
+/*      Reads the bands of one source of a dataset level request.       */
+/************************************************************************/
+
+typedef struct
+{
+    int             nXOff;
+    int             nYOff;
+    int             nXSize;
+    int             nYSize;
+    void           *pData;
+    int             nBufXSize;
+    int             nBufYSize;
+    GDALDataType    eBufType;
+    int             nBandCount;
+    int            *panBandMap;
+    GSpacing        nPixelSpace;
+    GSpacing        nLineSpace;
+    GSpacing        nBandSpace;
+} VRTDatasetSourceIOArgs;
+
+static CPLErr VRTDatasetSourceIO( VRTSource *poSource, void *pUserData,
+                                  GDALRasterIOExtraArg *psExtraArg )
+{
+    VRTDatasetSourceIOArgs* psArgs
+        = static_cast<VRTDatasetSourceIOArgs *>( pUserData );
+    return reinterpret_cast<VRTSimpleSource *>( poSource )->DatasetRasterIO(
+                psArgs->nXOff, psArgs->nYOff, psArgs->nXSize, psArgs->nYSize,
+                psArgs->pData, psArgs->nBufXSize, psArgs->nBufYSize,
+                psArgs->eBufType, psArgs->nBandCount, psArgs->panBandMap,
+                psArgs->nPixelSpace, psArgs->nLineSpace, psArgs->nBandSpace,
+                psExtraArg );
+}
+
 /************************************************************************/
 /*                              IRasterIO()                             */
 /************************************************************************/
@@ -1478,43 +1577,33 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
             poBand->nSources = nSavedSources;
         }
 
-        CPLErr eErr = CE_None;
-
-        GDALProgressFunc  pfnProgressGlobal = psExtraArg->pfnProgress;
-        void             *pProgressDataGlobal = psExtraArg->pProgressData;
-
         // Use the last band, because when sources reference a GDALProxyDataset,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand* poBand = reinterpret_cast<VRTSourcedRasterBand *>(
             papoBands[nBands - 1] );
-        for( int iSource = 0;
-             eErr == CE_None && iSource < poBand->nSources;
-             iSource++ )
-        {
-            psExtraArg->pfnProgress = GDALScaledProgress;
-            psExtraArg->pProgressData = 
-                GDALCreateScaledProgress( 1.0 * iSource / poBand->nSources,
-                                        1.0 * (iSource + 1) / poBand->nSources,
-                                        pfnProgressGlobal,
-                                        pProgressDataGlobal );
-
-            VRTSimpleSource* poSource = reinterpret_cast<VRTSimpleSource *>(
-                poBand->papoSources[iSource] );
-
-            eErr = poSource->DatasetRasterIO( nXOff, nYOff, nXSize, nYSize,
-                                              pData, nBufXSize, nBufYSize,
-                                              eBufType,
-                                              nBandCount, panBandMap,
-                                              nPixelSpace, nLineSpace, nBandSpace,
-                                              psExtraArg);
-
-            GDALDestroyScaledProgress( psExtraArg->pProgressData );
-        }
-
-        psExtraArg->pfnProgress = pfnProgressGlobal;
-        psExtraArg->pProgressData = pProgressDataGlobal;
-
-        return eErr;
+        std::vector<int> anSources;
+        poBand->GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize, anSources );
+
+        VRTDatasetSourceIOArgs sArgs;
+        sArgs.nXOff = nXOff;
+        sArgs.nYOff = nYOff;
+        sArgs.nXSize = nXSize;
+        sArgs.nYSize = nYSize;
+        sArgs.pData = pData;
+        sArgs.nBufXSize = nBufXSize;
+        sArgs.nBufYSize = nBufYSize;
+        sArgs.eBufType = eBufType;
+        sArgs.nBandCount = nBandCount;
+        sArgs.panBandMap = panBandMap;
+        sArgs.nPixelSpace = nPixelSpace;
+        sArgs.nLineSpace = nLineSpace;
+        sArgs.nBandSpace = nBandSpace;
+
+        return poBand->SourcesRasterIO( anSources,
+                                        nXOff, nYOff, nXSize, nYSize,
+                                        nBufXSize, nBufYSize,
+                                        VRTDatasetSourceIO, &sArgs,
+                                        psExtraArg );
     }
 
     return GDALDataset::IRasterIO(eRWFlag, nXOff, nYOff, nXSize, nYSize,
@@ -39,6 +39,8 @@
 #include <map>
 #include <vector>
 
+class CPLWorkerThreadPool;
+
 int VRTApplyMetadata( CPLXMLNode *, GDALMajorObject * );
 CPLXMLNode *VRTSerializeMetadata( GDALMajorObject * );
 
@@ -113,6 +115,10 @@ public:
 
 typedef VRTSource *(*VRTSourceParser)(CPLXMLNode *, const char *);
 
+/* Reads one source into the request buffer described by pUserData. */
+typedef CPLErr (*VRTSourceIOFunc)( VRTSource *poSource, void *pUserData,
+                                   GDALRasterIOExtraArg *psExtraArg );
+
 VRTSource *VRTParseCoreSources( CPLXMLNode *psTree, const char * );
 VRTSource *VRTParseFilterSources( CPLXMLNode *psTree, const char * );
 
@@ -147,6 +153,8 @@ class CPL_DLL VRTDataset : public GDALDataset
     std::vector<GDALDataset*> m_apoOverviews;
     std::vector<GDALDataset*> m_apoOverviewsBak;
 
+    CPLWorkerThreadPool *m_poSourceThreadPool;
+
   protected:
     virtual int         CloseDependentDatasets();
 
@@ -199,6 +207,9 @@ class CPL_DLL VRTDataset : public GDALDataset
     virtual CPLErr IBuildOverviews( const char *, int, int *,
                                     int, int *, GDALProgressFunc, void * );
 
+    /* Used by VRTSourcedRasterBand to read sources concurrently */
+    CPLWorkerThreadPool *GetSourceThreadPool();
+
     /* Used by PDF driver for example */
     GDALDataset*        GetSingleSimpleSource();
     void                BuildVirtualOverviews();
@@ -208,6 +219,10 @@ class CPL_DLL VRTDataset : public GDALDataset
     static int          Identify( GDALOpenInfo * );
     static GDALDataset *Open( GDALOpenInfo * );
     static GDALDataset *OpenXML( const char *, const char * = NULL, GDALAccess eAccess = GA_ReadOnly );
+    static GDALDataset *OpenFromSourceCache( const char *pszFilename,
+                                             const char *pszVRTPath );
+    void                WriteSourceCache( const char *pszFilename,
+                                          const char *pszVRTPath );
     static GDALDataset *Create( const char * pszName,
                                 int nXSize, int nYSize, int nBands,
                                 GDALDataType eType, char ** papszOptions );
@@ -456,10 +471,28 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
     CPLString      m_osLastLocationInfo;
     char         **m_papszSourceList;
 
+    /* Grid index of the destination windows of the sources, built by */
+    /* GetSourcesInWindow() for bands with many sources. Cell i lists  */
+    /* the sources m_anIndexCellSources[m_anIndexCellStart[i] ...      */
+    /* m_anIndexCellStart[i+1]-1]. */
+    int            m_nIndexedSources;
+    VRTSource    **m_papoIndexedSources;
+    double         m_dfIndexCellXSize;
+    double         m_dfIndexCellYSize;
+    int            m_nIndexCellsX;
+    int            m_nIndexCellsY;
+    std::vector<int> m_anIndexCellStart;
+    std::vector<int> m_anIndexCellSources;
+    std::vector<int> m_anIndexUngriddedSources;
+
     void           Initialize( int nXSize, int nYSize );
 
     int            CanUseSourcesMinMaxImplementations();
 
+    void           BuildSourceIndex();
+    static int     GetIndexCell( double dfCoord, double dfCellSize,
+                                 int nCells );
+
   public:
     int            nSources;
     VRTSource    **papoSources;
@@ -540,6 +573,17 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
 
     virtual CPLErr IReadBlock( int, int, void * );
 
+    void           GetSourcesInWindow( int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       std::vector<int>& anSources );
+    void           InvalidateSourceIndex();
+    CPLErr         SourcesRasterIO( const std::vector<int>& anSources,
+                                    int nXOff, int nYOff,
+                                    int nXSize, int nYSize,
+                                    int nBufXSize, int nBufYSize,
+                                    VRTSourceIOFunc pfnIO, void *pUserData,
+                                    GDALRasterIOExtraArg* psExtraArg );
+
     virtual void   GetFileList(char*** ppapszFileList, int *pnSize,
                                int *pnMaxSize, CPLHashSet* hSetFiles);
 
@@ -602,12 +646,76 @@ class VRTPansharpenedRasterBand : public VRTRasterBand
     int                 GetIndexAsPansharpenedBand() const { return m_nIndexAsPansharpenedBand; }
 };
 
+/************************************************************************/
+/*                            VRTExpression                             */
+/************************************************************************/
+
+class CPL_DLL VRTExpression
+{
+  public:
+    typedef enum
+    {
+        OP_CONST, OP_LOAD, OP_NODATA,
+        OP_NEG, OP_NOT,
+        OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_POW,
+        OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE, OP_AND, OP_OR,
+        OP_COND,
+        OP_ABS, OP_SQRT, OP_EXP, OP_LOG, OP_LOG10,
+        OP_SIN, OP_COS, OP_TAN, OP_ASIN, OP_ACOS, OP_ATAN,
+        OP_FLOOR, OP_CEIL, OP_ISNAN, OP_ISNODATA,
+        OP_MIN, OP_MAX, OP_ATAN2, OP_FMOD
+    } Opcode;
+
+    typedef struct
+    {
+        Opcode  eOp;
+        int     nSource;      /* OP_LOAD: 0-based source index */
+        double  dfValue;      /* OP_CONST, or constant second operand */
+        int     bConstOperand;
+    } Instruction;
+
+  private:
+    CPLString                 m_osExpression;
+    std::vector<Instruction>  m_aoProgram;
+    std::vector<int>          m_anUsedSources;
+    int                       m_nStackDepth;
+
+                   VRTExpression();
+
+    void           Emit( Opcode eOp, int nSource = 0, double dfValue = 0.0 );
+    void           Finalize();
+
+    friend class   VRTExpressionParser;
+
+  public:
+    static VRTExpression *Compile( const char *pszExpression );
+
+    const char    *GetExpression() const { return m_osExpression.c_str(); }
+    const std::vector<int>& GetUsedSources() const { return m_anUsedSources; }
+    int            GetMaxSourceIndex() const;
+    int            GetStackDepth() const { return m_nStackDepth; }
+
+    const double  *Evaluate( const double * const *papadfSources,
+                             int nCount, double dfNoData,
+                             int bPropagateNoData,
+                             double *padfWork ) const;
+};
+
 /************************************************************************/
 /*                         VRTDerivedRasterBand                         */
 /************************************************************************/
 
 class CPL_DLL VRTDerivedRasterBand : public VRTSourcedRasterBand
 {
+    VRTExpression *m_poExpression;
+    int            m_bPropagateNoData;
+
+    CPLErr         ExpressionRasterIO( int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       void *pData, int nBufXSize,
+                                       int nBufYSize, GDALDataType eBufType,
+                                       GSpacing nPixelSpace,
+                                       GSpacing nLineSpace );
 
  public:
     char *pszFuncName;
@@ -628,6 +736,10 @@ class CPL_DLL VRTDerivedRasterBand : public VRTSourcedRasterBand
     static GDALDerivedPixelFunc GetPixelFunction(const char *pszFuncName);
 
     void SetPixelFunctionName(const char *pszFuncName);
+    CPLErr SetPixelFunctionExpression(const char *pszExpression);
+    const char *GetPixelFunctionExpression() const;
+    void SetPropagateNoData(int bPropagateNoData)
+                                { m_bPropagateNoData = bPropagateNoData; }
     void SetSourceTransferType(GDALDataType eDataType);
 
     virtual CPLErr         XMLInit( CPLXMLNode *, const char * );
@@ -733,7 +845,22 @@ protected:
     int                 m_bRelativeToVRTOri;
     CPLString           m_osSourceFileNameOri;
 
+    /* When XMLInit() finds complete SourceProperties, the proxy dataset */
+    /* is only created on first use, from the following description. */
+    int                 m_bPendingOpen;
+    CPLString           m_osSrcDSName;
+    int                 m_nSrcBand;
+    int                 m_bGetMaskBand;
+    int                 m_nSrcRasterXSize;
+    int                 m_nSrcRasterYSize;
+    GDALDataType        m_eSrcDataType;
+    int                 m_nSrcBlockXSize;
+    int                 m_nSrcBlockYSize;
+    int                 m_bSrcShared;
+    char              **m_papszSrcOpenOptions;
+
     int                 NeedMaxValAdjustment() const;
+    int                 OpenPendingSource();
 
 public:
             VRTSimpleSource();
@@ -748,6 +875,8 @@ public:
     void           SetSrcMaskBand( GDALRasterBand * );
     void           SetSrcWindow( double, double, double, double );
     void           SetDstWindow( double, double, double, double );
+    int            GetDstWindow( double *pdfXOff, double *pdfYOff,
+                                 double *pdfXSize, double *pdfYSize ) const;
     void           SetNoDataValue( double dfNoDataValue );
     const CPLString& GetResampling() const { return m_osResampling; }
     void           SetResampling( const char* pszResampling );
@@ -791,6 +920,8 @@ public:
 
     GDALRasterBand* GetBand();
     int             IsSameExceptBandNumber(VRTSimpleSource* poOtherSource);
+    int             IsBandOfSrcDataset( int nBand );
+    const char*     GetSrcDatasetName();
     CPLErr          DatasetRasterIO(
                                int nXOff, int nYOff, int nXSize, int nYSize,
                                void * pData, int nBufXSize, int nBufYSize,
@@ -803,6 +934,10 @@ public:
     void             UnsetPreservedRelativeFilenames();
 
     void                SetMaxValue(int nVal) { m_nMaxValue = nVal; }
+
+    virtual int    WriteToSourceCache( CPLString& osRecord );
+    virtual int    ReadFromSourceCache( const GByte** ppabyData,
+                                        const GByte* pabyEnd );
 };
 
 /************************************************************************/
@@ -902,6 +1037,10 @@ public:
     virtual CPLErr XMLInit( CPLXMLNode *, const char * );
     virtual const char* GetType() { return "ComplexSource"; }
 
+    virtual int    WriteToSourceCache( CPLString& osRecord );
+    virtual int    ReadFromSourceCache( const GByte** ppabyData,
+                                        const GByte* pabyEnd );
+
     double  LookupValue( double dfInput );
 
     void    SetLinearScaling(double dfOffset, double dfScale);
@@ -948,6 +1087,8 @@ public:
                               GDALDataType eBufType, 
                               GSpacing nPixelSpace, GSpacing nLineSpace,
                               GDALRasterIOExtraArg* psExtraArg );
+
+    virtual int     WriteToSourceCache( CPLString& ) { return FALSE; }
 };
 
 /************************************************************************/
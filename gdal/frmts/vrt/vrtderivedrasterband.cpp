@@ -47,6 +47,8 @@ static std::map<CPLString, GDALDerivedPixelFunc> osMapPixelFunction;
 
 VRTDerivedRasterBand::VRTDerivedRasterBand(GDALDataset *poDSIn, int nBandIn) :
     VRTSourcedRasterBand( poDSIn, nBandIn ),
+    m_poExpression(NULL),
+    m_bPropagateNoData(FALSE),
     pszFuncName(NULL),
     eSourceTransferType(GDT_Unknown)
 {}
@@ -59,6 +61,8 @@ VRTDerivedRasterBand::VRTDerivedRasterBand(GDALDataset *poDSIn, int nBandIn,
 					   GDALDataType eType, 
 					   int nXSize, int nYSize) :
     VRTSourcedRasterBand(poDSIn, nBandIn, eType, nXSize, nYSize),
+    m_poExpression(NULL),
+    m_bPropagateNoData(FALSE),
     pszFuncName(NULL),
     eSourceTransferType(GDT_Unknown)
 {}
@@ -71,6 +75,7 @@ VRTDerivedRasterBand::~VRTDerivedRasterBand()
 
 {
     CPLFree( pszFuncName );
+    delete m_poExpression;
 }
 
 /************************************************************************/
@@ -174,6 +179,45 @@ void VRTDerivedRasterBand::SetPixelFunctionName(const char *pszFuncNameIn)
     pszFuncName = CPLStrdup( pszFuncNameIn );
 }
 
+/************************************************************************/
+/*                      SetPixelFunctionExpression()                    */
+/************************************************************************/
+
+/**
+ * Set an expression computing the pixels of this derived band from its
+ * sources, instead of a registered pixel function.  B1 is the first
+ * source, B2 the second one, etc.  See the VRT tutorial for the syntax.
+ *
+ * @param pszExpression the expression, or NULL to unset it.
+ *
+ * @return CE_None, or CE_Failure if the expression is invalid.
+ */
+CPLErr VRTDerivedRasterBand::SetPixelFunctionExpression(
+                                                const char *pszExpression)
+{
+    VRTExpression *poExpression = NULL;
+    if( pszExpression != NULL )
+    {
+        poExpression = VRTExpression::Compile( pszExpression );
+        if( poExpression == NULL )
+            return CE_Failure;
+    }
+
+    delete m_poExpression;
+    m_poExpression = poExpression;
+    return CE_None;
+}
+
+/************************************************************************/
+/*                      GetPixelFunctionExpression()                    */
+/************************************************************************/
+
+/** Return the expression set with SetPixelFunctionExpression(), or NULL. */
+const char *VRTDerivedRasterBand::GetPixelFunctionExpression() const
+{
+    return m_poExpression ? m_poExpression->GetExpression() : NULL;
+}
+
 /************************************************************************/
 /*                         SetSourceTransferType()                      */
 /************************************************************************/
@@ -310,6 +354,11 @@ CPLErr VRTDerivedRasterBand::IRasterIO(GDALRWFlag eRWFlag,
             return CE_None;
     }
 
+    if( m_poExpression != NULL )
+        return ExpressionRasterIO( nXOff, nYOff, nXSize, nYSize,
+                                   pData, nBufXSize, nBufYSize, eBufType,
+                                   nPixelSpace, nLineSpace );
+
     /* ---- Get pixel function for band ---- */
     GDALDerivedPixelFunc pfnPixelFunc
         = VRTDerivedRasterBand::GetPixelFunction(this->pszFuncName);
@@ -390,6 +439,144 @@ CPLErr VRTDerivedRasterBand::IRasterIO(GDALRWFlag eRWFlag,
     return eErr;
 }
 
+/************************************************************************/
+/*                         ExpressionRasterIO()                         */
+/*                                                                      */
+/*      Read the sources used by the expression, and evaluate it one    */
+/*      buffer line at a time.                                          */
+/************************************************************************/
+
+CPLErr VRTDerivedRasterBand::ExpressionRasterIO( int nXOff, int nYOff,
+                                                 int nXSize, int nYSize,
+                                                 void *pData, int nBufXSize,
+                                                 int nBufYSize,
+                                                 GDALDataType eBufType,
+                                                 GSpacing nPixelSpace,
+                                                 GSpacing nLineSpace )
+{
+    if( m_poExpression->GetMaxSourceIndex() > nSources )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Pixel function expression '%s' uses B%d, "
+                  "but the band has only %d sources.",
+                  m_poExpression->GetExpression(),
+                  m_poExpression->GetMaxSourceIndex(), nSources );
+        return CE_Failure;
+    }
+
+    /* Sources are evaluated as Float64, but may be transferred as */
+    /* Float32 to halve the memory used. */
+    const GDALDataType eSrcType =
+        (eSourceTransferType == GDT_Float32) ? GDT_Float32 : GDT_Float64;
+    const int nSrcTypeSize = GDALGetDataTypeSize(eSrcType) / 8;
+
+    double dfNoData = CPLAtof("nan");
+    if( m_bNoDataValueSet )
+    {
+        dfNoData = m_dfNoDataValue;
+        if( eSrcType == GDT_Float32 && !CPLIsNan(dfNoData) )
+            dfNoData = static_cast<float>(dfNoData);
+    }
+
+    const std::vector<int>& anUsedSources = m_poExpression->GetUsedSources();
+    const size_t nBufPixels = static_cast<size_t>(nBufXSize) * nBufYSize;
+
+    std::vector<GByte*> apabySrcBuffers( nSources, static_cast<GByte*>(NULL) );
+    std::vector<const double*> apadfSrcLines( nSources,
+                                              static_cast<double*>(NULL) );
+    double *padfWork = static_cast<double *>(
+        VSI_MALLOC3_VERBOSE( m_poExpression->GetStackDepth() +
+                             (eSrcType == GDT_Float32 ?
+                                static_cast<int>(anUsedSources.size()) : 0),
+                             nBufXSize, sizeof(double) ) );
+    CPLErr eErr = (padfWork != NULL) ? CE_None : CE_Failure;
+
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+
+/* -------------------------------------------------------------------- */
+/*      Read the used sources, in buffers initialized with the          */
+/*      nodata value, as in IRasterIO().                                */
+/* -------------------------------------------------------------------- */
+    for( size_t i = 0; i < anUsedSources.size() && eErr == CE_None; i++ )
+    {
+        const int iSource = anUsedSources[i];
+        GByte *pabyBuffer = static_cast<GByte *>(
+            VSI_MALLOC2_VERBOSE( nBufPixels, nSrcTypeSize ) );
+        if( pabyBuffer == NULL )
+        {
+            eErr = CE_Failure;
+            break;
+        }
+        apabySrcBuffers[iSource] = pabyBuffer;
+
+        if( !m_bNoDataValueSet || m_dfNoDataValue == 0 )
+            memset( pabyBuffer, 0, nBufPixels * nSrcTypeSize );
+        else
+            GDALCopyWords( &m_dfNoDataValue, GDT_Float64, 0,
+                           pabyBuffer, eSrcType, nSrcTypeSize,
+                           static_cast<int>(nBufPixels) );
+
+        eErr = papoSources[iSource]->RasterIO(
+            nXOff, nYOff, nXSize, nYSize,
+            pabyBuffer, nBufXSize, nBufYSize,
+            eSrcType, nSrcTypeSize,
+            static_cast<GSpacing>(nSrcTypeSize) * nBufXSize, &sExtraArg );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Evaluate the expression line by line.                           */
+/* -------------------------------------------------------------------- */
+    double *padfConvertedLines =
+        padfWork ? padfWork +
+            static_cast<size_t>(m_poExpression->GetStackDepth()) * nBufXSize
+                 : NULL;
+    const int nBufTypeSize = GDALGetDataTypeSize(eBufType) / 8;
+
+    for( int iLine = 0; iLine < nBufYSize && eErr == CE_None; iLine++ )
+    {
+        const size_t nLineOffset = static_cast<size_t>(iLine) * nBufXSize;
+        for( size_t i = 0; i < anUsedSources.size(); i++ )
+        {
+            const int iSource = anUsedSources[i];
+            if( eSrcType == GDT_Float64 )
+            {
+                apadfSrcLines[iSource] = reinterpret_cast<double *>(
+                    apabySrcBuffers[iSource]) + nLineOffset;
+            }
+            else
+            {
+                double *padfLine = padfConvertedLines + i * nBufXSize;
+                GDALCopyWords( reinterpret_cast<float *>(
+                                   apabySrcBuffers[iSource]) + nLineOffset,
+                               GDT_Float32, sizeof(float),
+                               padfLine, GDT_Float64, sizeof(double),
+                               nBufXSize );
+                apadfSrcLines[iSource] = padfLine;
+            }
+        }
+
+        const double *padfResult = m_poExpression->Evaluate(
+            apadfSrcLines.empty() ? NULL : &apadfSrcLines[0], nBufXSize, dfNoData, m_bPropagateNoData,
+            padfWork );
+
+        GByte *pabyDstLine = static_cast<GByte *>(pData) + nLineSpace * iLine;
+        if( eBufType == GDT_Float64 && nPixelSpace == nBufTypeSize )
+            memcpy( pabyDstLine, padfResult, sizeof(double) * nBufXSize );
+        else
+            GDALCopyWords( const_cast<double *>(padfResult), GDT_Float64,
+                           sizeof(double),
+                           pabyDstLine, eBufType,
+                           static_cast<int>(nPixelSpace), nBufXSize );
+    }
+
+    for( int iSource = 0; iSource < nSources; iSource++ )
+        VSIFree( apabySrcBuffers[iSource] );
+    VSIFree( padfWork );
+
+    return eErr;
+}
+
 /************************************************************************/
 /*                              XMLInit()                               */
 /************************************************************************/
@@ -411,6 +598,26 @@ CPLErr VRTDerivedRasterBand::XMLInit( CPLXMLNode *psTree,
 	eSourceTransferType = GDALGetDataTypeByName( pszTypeName );
     }
 
+    /* ---- Read optional built-in expression ---- */
+    const char *pszExpression =
+        CPLGetXMLValue( psTree, "PixelFunctionExpression", NULL );
+    if( pszExpression != NULL )
+    {
+        if( SetPixelFunctionExpression( pszExpression ) != CE_None )
+            return CE_Failure;
+        if( m_poExpression->GetMaxSourceIndex() > nSources )
+        {
+            CPLError( CE_Failure, CPLE_AppDefined,
+                      "PixelFunctionExpression '%s' uses B%d, "
+                      "but the band has only %d sources.",
+                      pszExpression, m_poExpression->GetMaxSourceIndex(),
+                      nSources );
+            return CE_Failure;
+        }
+    }
+    m_bPropagateNoData =
+        CSLTestBoolean( CPLGetXMLValue( psTree, "PropagateNoData", "NO" ) );
+
     return CE_None;
 }
 
@@ -435,6 +642,11 @@ CPLXMLNode *VRTDerivedRasterBand::SerializeToXML(const char *pszVRTPath)
     if( this->eSourceTransferType != GDT_Unknown)
         CPLSetXMLValue( psTree, "SourceTransferType",
 		        GDALGetDataTypeName( eSourceTransferType ) );
+    if( m_poExpression != NULL )
+        CPLSetXMLValue( psTree, "PixelFunctionExpression",
+                        m_poExpression->GetExpression() );
+    if( m_bPropagateNoData )
+        CPLSetXMLValue( psTree, "PropagateNoData", "YES" );
 
     return psTree;
 }
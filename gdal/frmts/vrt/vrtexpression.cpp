@@ -0,0 +1,876 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Compiler and scanline evaluator of the pixel function
+ *           expressions of VRTDerivedRasterBand.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "vrtdataset.h"
+#include "cpl_string.h"
+
+#include <algorithm>
+#include <math.h>
+
+CPL_CVSID("$Id$");
+
+/*
+ * Expressions are compiled into a program for a stack machine, in reverse
+ * polish notation. Each instruction is applied to whole scanlines at once,
+ * so that the dispatch cost is paid once per line rather than once per
+ * pixel, and the inner loops are simple enough to be vectorized by the
+ * compiler. Instructions whose operands are all constant are folded at
+ * compile time, and a constant second operand of a binary instruction is
+ * stored in the instruction instead of being expanded to a whole line.
+ *
+ * Grammar, by increasing precedence:
+ *   expr    := or [ '?' expr ':' expr ]
+ *   or      := and { '||' and }
+ *   and     := eq { '&&' eq }
+ *   eq      := rel { ( '==' | '!=' ) rel }
+ *   rel     := add { ( '<' | '<=' | '>' | '>=' ) add }
+ *   add     := mul { ( '+' | '-' ) mul }
+ *   mul     := unary { ( '*' | '/' ) unary }
+ *   unary   := ( '-' | '+' | '!' ) unary | power
+ *   power   := primary [ '^' unary ]
+ *   primary := number | B<n> | NODATA | function '(' expr {',' expr} ')'
+ *            | '(' expr ')'
+ */
+
+static const int VRT_EXPRESSION_MAX_STACK_DEPTH = 64;
+static const int VRT_EXPRESSION_MAX_RECURSION = 256;
+
+/************************************************************************/
+/*                          VRTExpressionArity()                        */
+/************************************************************************/
+
+static int VRTExpressionArity( VRTExpression::Opcode eOp )
+{
+    switch( eOp )
+    {
+        case VRTExpression::OP_CONST:
+        case VRTExpression::OP_LOAD:
+        case VRTExpression::OP_NODATA:
+            return 0;
+
+        case VRTExpression::OP_ADD:
+        case VRTExpression::OP_SUB:
+        case VRTExpression::OP_MUL:
+        case VRTExpression::OP_DIV:
+        case VRTExpression::OP_POW:
+        case VRTExpression::OP_EQ:
+        case VRTExpression::OP_NE:
+        case VRTExpression::OP_LT:
+        case VRTExpression::OP_LE:
+        case VRTExpression::OP_GT:
+        case VRTExpression::OP_GE:
+        case VRTExpression::OP_AND:
+        case VRTExpression::OP_OR:
+        case VRTExpression::OP_MIN:
+        case VRTExpression::OP_MAX:
+        case VRTExpression::OP_ATAN2:
+        case VRTExpression::OP_FMOD:
+            return 2;
+
+        case VRTExpression::OP_COND:
+            return 3;
+
+        default:
+            return 1;
+    }
+}
+
+/************************************************************************/
+/*                       VRTExpressionApply()                           */
+/*                                                                      */
+/*      Apply a non-leaf instruction to nCount values of its operands.  */
+/*      padfOut may alias the first operand.                            */
+/************************************************************************/
+
+#define VRT_UNARY_OP(EXPR)                                              \
+    for( int i = 0; i < nCount; i++ )                                   \
+    {                                                                   \
+        const double a = padfA[i];                                      \
+        padfOut[i] = (EXPR);                                            \
+    }                                                                   \
+    break;
+
+#define VRT_BINARY_OP(EXPR)                                             \
+    if( psInstr->bConstOperand )                                        \
+    {                                                                   \
+        const double b = psInstr->dfValue;                              \
+        for( int i = 0; i < nCount; i++ )                               \
+        {                                                               \
+            const double a = padfA[i];                                  \
+            padfOut[i] = (EXPR);                                        \
+        }                                                               \
+    }                                                                   \
+    else                                                                \
+    {                                                                   \
+        const double *padfB = papadfArgs[1];                            \
+        for( int i = 0; i < nCount; i++ )                               \
+        {                                                               \
+            const double a = padfA[i];                                  \
+            const double b = padfB[i];                                  \
+            padfOut[i] = (EXPR);                                        \
+        }                                                               \
+    }                                                                   \
+    break;
+
+static void VRTExpressionApply( const VRTExpression::Instruction *psInstr,
+                                const double * const *papadfArgs,
+                                double *padfOut, int nCount,
+                                double dfNoData )
+{
+    const double *padfA = papadfArgs[0];
+
+    switch( psInstr->eOp )
+    {
+        case VRTExpression::OP_NEG:   VRT_UNARY_OP(-a)
+        case VRTExpression::OP_NOT:   VRT_UNARY_OP(a == 0.0 ? 1.0 : 0.0)
+        case VRTExpression::OP_ABS:   VRT_UNARY_OP(fabs(a))
+        case VRTExpression::OP_SQRT:  VRT_UNARY_OP(sqrt(a))
+        case VRTExpression::OP_EXP:   VRT_UNARY_OP(exp(a))
+        case VRTExpression::OP_LOG:   VRT_UNARY_OP(log(a))
+        case VRTExpression::OP_LOG10: VRT_UNARY_OP(log10(a))
+        case VRTExpression::OP_SIN:   VRT_UNARY_OP(sin(a))
+        case VRTExpression::OP_COS:   VRT_UNARY_OP(cos(a))
+        case VRTExpression::OP_TAN:   VRT_UNARY_OP(tan(a))
+        case VRTExpression::OP_ASIN:  VRT_UNARY_OP(asin(a))
+        case VRTExpression::OP_ACOS:  VRT_UNARY_OP(acos(a))
+        case VRTExpression::OP_ATAN:  VRT_UNARY_OP(atan(a))
+        case VRTExpression::OP_FLOOR: VRT_UNARY_OP(floor(a))
+        case VRTExpression::OP_CEIL:  VRT_UNARY_OP(ceil(a))
+        case VRTExpression::OP_ISNAN: VRT_UNARY_OP(CPLIsNan(a) ? 1.0 : 0.0)
+
+        case VRTExpression::OP_ISNODATA:
+            if( CPLIsNan(dfNoData) )
+            {
+                VRT_UNARY_OP(CPLIsNan(a) ? 1.0 : 0.0)
+            }
+            else
+            {
+                VRT_UNARY_OP(a == dfNoData ? 1.0 : 0.0)
+            }
+
+        case VRTExpression::OP_ADD:   VRT_BINARY_OP(a + b)
+        case VRTExpression::OP_SUB:   VRT_BINARY_OP(a - b)
+        case VRTExpression::OP_MUL:   VRT_BINARY_OP(a * b)
+        case VRTExpression::OP_DIV:   VRT_BINARY_OP(a / b)
+        case VRTExpression::OP_POW:   VRT_BINARY_OP(pow(a, b))
+        case VRTExpression::OP_EQ:    VRT_BINARY_OP(a == b ? 1.0 : 0.0)
+        case VRTExpression::OP_NE:    VRT_BINARY_OP(a != b ? 1.0 : 0.0)
+        case VRTExpression::OP_LT:    VRT_BINARY_OP(a < b ? 1.0 : 0.0)
+        case VRTExpression::OP_LE:    VRT_BINARY_OP(a <= b ? 1.0 : 0.0)
+        case VRTExpression::OP_GT:    VRT_BINARY_OP(a > b ? 1.0 : 0.0)
+        case VRTExpression::OP_GE:    VRT_BINARY_OP(a >= b ? 1.0 : 0.0)
+        case VRTExpression::OP_AND:
+            VRT_BINARY_OP((a != 0.0 && b != 0.0) ? 1.0 : 0.0)
+        case VRTExpression::OP_OR:
+            VRT_BINARY_OP((a != 0.0 || b != 0.0) ? 1.0 : 0.0)
+        case VRTExpression::OP_MIN:   VRT_BINARY_OP(b < a ? b : a)
+        case VRTExpression::OP_MAX:   VRT_BINARY_OP(b > a ? b : a)
+        case VRTExpression::OP_ATAN2: VRT_BINARY_OP(atan2(a, b))
+        case VRTExpression::OP_FMOD:  VRT_BINARY_OP(fmod(a, b))
+
+        case VRTExpression::OP_COND:
+        {
+            /* Both branches have been computed: select per pixel. */
+            const double *padfIfTrue = papadfArgs[1];
+            const double *padfIfFalse = papadfArgs[2];
+            for( int i = 0; i < nCount; i++ )
+                padfOut[i] = padfA[i] != 0.0 ? padfIfTrue[i] : padfIfFalse[i];
+            break;
+        }
+
+        default:
+            CPLAssert(FALSE);
+            break;
+    }
+}
+
+#undef VRT_UNARY_OP
+#undef VRT_BINARY_OP
+
+/************************************************************************/
+/* ==================================================================== */
+/*                          VRTExpressionParser                         */
+/* ==================================================================== */
+/************************************************************************/
+
+typedef struct
+{
+    const char             *pszName;
+    VRTExpression::Opcode   eOp;
+    int                     nArgs;
+} VRTExpressionFunction;
+
+static const VRTExpressionFunction asVRTExpressionFunctions[] =
+{
+    { "abs",      VRTExpression::OP_ABS,      1 },
+    { "sqrt",     VRTExpression::OP_SQRT,     1 },
+    { "exp",      VRTExpression::OP_EXP,      1 },
+    { "log",      VRTExpression::OP_LOG,      1 },
+    { "log10",    VRTExpression::OP_LOG10,    1 },
+    { "sin",      VRTExpression::OP_SIN,      1 },
+    { "cos",      VRTExpression::OP_COS,      1 },
+    { "tan",      VRTExpression::OP_TAN,      1 },
+    { "asin",     VRTExpression::OP_ASIN,     1 },
+    { "acos",     VRTExpression::OP_ACOS,     1 },
+    { "atan",     VRTExpression::OP_ATAN,     1 },
+    { "floor",    VRTExpression::OP_FLOOR,    1 },
+    { "ceil",     VRTExpression::OP_CEIL,     1 },
+    { "isnan",    VRTExpression::OP_ISNAN,    1 },
+    { "isnodata", VRTExpression::OP_ISNODATA, 1 },
+    { "min",      VRTExpression::OP_MIN,      2 },
+    { "max",      VRTExpression::OP_MAX,      2 },
+    { "pow",      VRTExpression::OP_POW,      2 },
+    { "atan2",    VRTExpression::OP_ATAN2,    2 },
+    { "fmod",     VRTExpression::OP_FMOD,     2 }
+};
+
+class VRTExpressionParser
+{
+    VRTExpression *m_poExpr;
+    const char    *m_pszStart;
+    const char    *m_pszCur;
+    int            m_nRecursion;
+
+    void           SkipSpaces();
+    bool           Match( const char *pszToken );
+    bool           Error( const char *pszMsg );
+
+    bool           ParseConditional();
+    bool           ParseOr();
+    bool           ParseAnd();
+    bool           ParseEquality();
+    bool           ParseRelational();
+    bool           ParseAdditive();
+    bool           ParseMultiplicative();
+    bool           ParseUnary();
+    bool           ParsePower();
+    bool           ParsePrimary();
+    bool           ParseIdentifier();
+
+  public:
+                   VRTExpressionParser( VRTExpression *poExpr,
+                                        const char *pszExpression ) :
+                       m_poExpr(poExpr), m_pszStart(pszExpression),
+                       m_pszCur(pszExpression), m_nRecursion(0) {}
+
+    bool           Parse();
+};
+
+/************************************************************************/
+/*                             SkipSpaces()                             */
+/************************************************************************/
+
+void VRTExpressionParser::SkipSpaces()
+{
+    while( isspace(static_cast<unsigned char>(*m_pszCur)) )
+        m_pszCur++;
+}
+
+/************************************************************************/
+/*                               Match()                                */
+/************************************************************************/
+
+bool VRTExpressionParser::Match( const char *pszToken )
+{
+    SkipSpaces();
+    const size_t nLen = strlen(pszToken);
+    if( strncmp(m_pszCur, pszToken, nLen) != 0 )
+        return false;
+    m_pszCur += nLen;
+    return true;
+}
+
+/************************************************************************/
+/*                         VRTExpressionQuote()                         */
+/*                                                                      */
+/*      Beginning of an expression, for error messages.                 */
+/************************************************************************/
+
+static CPLString VRTExpressionQuote( const char *pszExpression )
+{
+    CPLString osQuoted( pszExpression );
+    if( osQuoted.size() > 64 )
+        osQuoted = osQuoted.substr( 0, 64 ) + "...";
+    return osQuoted;
+}
+
+/************************************************************************/
+/*                               Error()                                */
+/************************************************************************/
+
+bool VRTExpressionParser::Error( const char *pszMsg )
+{
+    CPLError( CE_Failure, CPLE_AppDefined,
+              "Invalid pixel function expression '%s': %s at position %d.",
+              VRTExpressionQuote(m_pszStart).c_str(), pszMsg,
+              static_cast<int>(m_pszCur - m_pszStart) );
+    return false;
+}
+
+/************************************************************************/
+/*                               Parse()                                */
+/************************************************************************/
+
+bool VRTExpressionParser::Parse()
+{
+    if( !ParseConditional() )
+        return false;
+    SkipSpaces();
+    if( *m_pszCur != '\0' )
+        return Error("unexpected character");
+    return true;
+}
+
+/************************************************************************/
+/*                          ParseConditional()                          */
+/************************************************************************/
+
+bool VRTExpressionParser::ParseConditional()
+{
+    /* Recursion through the branches of '?', parentheses and function */
+    /* arguments. */
+    if( m_nRecursion == VRT_EXPRESSION_MAX_RECURSION )
+        return Error("expression too deeply nested");
+
+    m_nRecursion++;
+    bool bRet = ParseOr();
+    if( bRet && Match("?") )
+    {
+        bRet = ParseConditional();
+        if( bRet && !Match(":") )
+            bRet = Error("':' expected");
+        if( bRet )
+            bRet = ParseConditional();
+        if( bRet )
+            m_poExpr->Emit( VRTExpression::OP_COND );
+    }
+    m_nRecursion--;
+    return bRet;
+}
+
+/************************************************************************/
+/*                      Binary operator levels.                         */
+/************************************************************************/
+
+bool VRTExpressionParser::ParseOr()
+{
+    if( !ParseAnd() )
+        return false;
+    while( Match("||") )
+    {
+        if( !ParseAnd() )
+            return false;
+        m_poExpr->Emit( VRTExpression::OP_OR );
+    }
+    return true;
+}
+
+bool VRTExpressionParser::ParseAnd()
+{
+    if( !ParseEquality() )
+        return false;
+    while( Match("&&") )
+    {
+        if( !ParseEquality() )
+            return false;
+        m_poExpr->Emit( VRTExpression::OP_AND );
+    }
+    return true;
+}
+
+bool VRTExpressionParser::ParseEquality()
+{
+    if( !ParseRelational() )
+        return false;
+    while( true )
+    {
+        VRTExpression::Opcode eOp;
+        if( Match("==") )
+            eOp = VRTExpression::OP_EQ;
+        else if( Match("!=") )
+            eOp = VRTExpression::OP_NE;
+        else
+            return true;
+        if( !ParseRelational() )
+            return false;
+        m_poExpr->Emit( eOp );
+    }
+}
+
+bool VRTExpressionParser::ParseRelational()
+{
+    if( !ParseAdditive() )
+        return false;
+    while( true )
+    {
+        VRTExpression::Opcode eOp;
+        if( Match("<=") )
+            eOp = VRTExpression::OP_LE;
+        else if( Match(">=") )
+            eOp = VRTExpression::OP_GE;
+        else if( Match("<") )
+            eOp = VRTExpression::OP_LT;
+        else if( Match(">") )
+            eOp = VRTExpression::OP_GT;
+        else
+            return true;
+        if( !ParseAdditive() )
+            return false;
+        m_poExpr->Emit( eOp );
+    }
+}
+
+bool VRTExpressionParser::ParseAdditive()
+{
+    if( !ParseMultiplicative() )
+        return false;
+    while( true )
+    {
+        VRTExpression::Opcode eOp;
+        if( Match("+") )
+            eOp = VRTExpression::OP_ADD;
+        else if( Match("-") )
+            eOp = VRTExpression::OP_SUB;
+        else
+            return true;
+        if( !ParseMultiplicative() )
+            return false;
+        m_poExpr->Emit( eOp );
+    }
+}
+
+bool VRTExpressionParser::ParseMultiplicative()
+{
+    if( !ParseUnary() )
+        return false;
+    while( true )
+    {
+        VRTExpression::Opcode eOp;
+        if( Match("*") )
+            eOp = VRTExpression::OP_MUL;
+        else if( Match("/") )
+            eOp = VRTExpression::OP_DIV;
+        else
+            return true;
+        if( !ParseUnary() )
+            return false;
+        m_poExpr->Emit( eOp );
+    }
+}
+
+/************************************************************************/
+/*                             ParseUnary()                             */
+/************************************************************************/
+
+bool VRTExpressionParser::ParseUnary()
+{
+    /* Recursion through unary operators and the exponent of '^'. */
+    if( m_nRecursion == VRT_EXPRESSION_MAX_RECURSION )
+        return Error("expression too deeply nested");
+
+    m_nRecursion++;
+    bool bRet;
+    if( Match("-") )
+    {
+        bRet = ParseUnary();
+        if( bRet )
+            m_poExpr->Emit( VRTExpression::OP_NEG );
+    }
+    else if( Match("+") )
+    {
+        bRet = ParseUnary();
+    }
+    else if( Match("!") )
+    {
+        bRet = ParseUnary();
+        if( bRet )
+            m_poExpr->Emit( VRTExpression::OP_NOT );
+    }
+    else
+    {
+        bRet = ParsePower();
+    }
+    m_nRecursion--;
+    return bRet;
+}
+
+/************************************************************************/
+/*                             ParsePower()                             */
+/************************************************************************/
+
+bool VRTExpressionParser::ParsePower()
+{
+    if( !ParsePrimary() )
+        return false;
+    if( Match("^") )
+    {
+        /* Right associative, and binds tighter than a unary minus on */
+        /* its left: -2^2 is -4 and 2^-1 is 0.5. */
+        if( !ParseUnary() )
+            return false;
+        m_poExpr->Emit( VRTExpression::OP_POW );
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                            ParsePrimary()                            */
+/************************************************************************/
+
+bool VRTExpressionParser::ParsePrimary()
+{
+    SkipSpaces();
+
+    if( Match("(") )
+    {
+        if( !ParseConditional() )
+            return false;
+        if( !Match(")") )
+            return Error("')' expected");
+        return true;
+    }
+
+    if( isdigit(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '.' )
+    {
+        char *pszEnd = NULL;
+        const double dfValue = CPLStrtod(m_pszCur, &pszEnd);
+        if( pszEnd == m_pszCur )
+            return Error("invalid number");
+        m_pszCur = pszEnd;
+        m_poExpr->Emit( VRTExpression::OP_CONST, 0, dfValue );
+        return true;
+    }
+
+    if( isalpha(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '_' )
+        return ParseIdentifier();
+
+    if( *m_pszCur == '\0' )
+        return Error("unexpected end of expression");
+    return Error("unexpected character");
+}
+
+/************************************************************************/
+/*                          ParseIdentifier()                           */
+/************************************************************************/
+
+bool VRTExpressionParser::ParseIdentifier()
+{
+    const char *pszIdentStart = m_pszCur;
+    while( isalnum(static_cast<unsigned char>(*m_pszCur)) || *m_pszCur == '_' )
+        m_pszCur++;
+    CPLString osIdent;
+    osIdent.assign( pszIdentStart, m_pszCur - pszIdentStart );
+
+/* -------------------------------------------------------------------- */
+/*      Source reference: B1 is the first source of the band.           */
+/* -------------------------------------------------------------------- */
+    if( (osIdent[0] == 'B' || osIdent[0] == 'b') && osIdent.size() > 1 &&
+        osIdent.size() < 10 &&
+        strspn(osIdent.c_str() + 1, "0123456789") == osIdent.size() - 1 )
+    {
+        const int nSource = atoi(osIdent.c_str() + 1);
+        if( nSource < 1 )
+        {
+            m_pszCur = pszIdentStart;
+            return Error("source numbers start at B1");
+        }
+        m_poExpr->Emit( VRTExpression::OP_LOAD, nSource - 1 );
+        return true;
+    }
+
+    if( EQUAL(osIdent, "NODATA") )
+    {
+        m_poExpr->Emit( VRTExpression::OP_NODATA );
+        return true;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Function call.                                                  */
+/* -------------------------------------------------------------------- */
+    const VRTExpressionFunction *psFunc = NULL;
+    for( size_t i = 0; i < CPL_ARRAYSIZE(asVRTExpressionFunctions); i++ )
+    {
+        if( EQUAL(osIdent, asVRTExpressionFunctions[i].pszName) )
+        {
+            psFunc = &asVRTExpressionFunctions[i];
+            break;
+        }
+    }
+    if( psFunc == NULL )
+    {
+        m_pszCur = pszIdentStart;
+        return Error(CPLSPrintf("unknown identifier '%s'", osIdent.c_str()));
+    }
+
+    if( !Match("(") )
+        return Error("'(' expected");
+    for( int iArg = 0; iArg < psFunc->nArgs; iArg++ )
+    {
+        if( iArg > 0 && !Match(",") )
+            return Error(CPLSPrintf("%s() expects %d arguments",
+                                    psFunc->pszName, psFunc->nArgs));
+        if( !ParseConditional() )
+            return false;
+    }
+    if( !Match(")") )
+        return Error("')' expected");
+
+    m_poExpr->Emit( psFunc->eOp );
+    return true;
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                             VRTExpression                            */
+/* ==================================================================== */
+/************************************************************************/
+
+/************************************************************************/
+/*                           VRTExpression()                            */
+/************************************************************************/
+
+VRTExpression::VRTExpression() :
+    m_nStackDepth(0)
+{}
+
+/************************************************************************/
+/*                                Emit()                                */
+/************************************************************************/
+
+void VRTExpression::Emit( Opcode eOp, int nSource, double dfValue )
+{
+    Instruction sInstr;
+    sInstr.eOp = eOp;
+    sInstr.nSource = nSource;
+    sInstr.dfValue = dfValue;
+    sInstr.bConstOperand = FALSE;
+
+    const int nArgs = VRTExpressionArity(eOp);
+    const int nProgramSize = static_cast<int>(m_aoProgram.size());
+
+/* -------------------------------------------------------------------- */
+/*      Fold instructions whose operands are all constant. The          */
+/*      operands of the instruction are the last ones emitted, and      */
+/*      each constant is a complete operand on its own.                 */
+/* -------------------------------------------------------------------- */
+    bool bAllConst = nArgs > 0 && eOp != OP_ISNODATA;
+    for( int i = 0; bAllConst && i < nArgs; i++ )
+        bAllConst = m_aoProgram[nProgramSize - 1 - i].eOp == OP_CONST;
+    if( bAllConst )
+    {
+        double adfArgs[3];
+        const double *apadfArgs[3];
+        for( int i = 0; i < nArgs; i++ )
+        {
+            adfArgs[i] = m_aoProgram[nProgramSize - nArgs + i].dfValue;
+            apadfArgs[i] = &adfArgs[i];
+        }
+        double dfResult = 0.0;
+        VRTExpressionApply( &sInstr, apadfArgs, &dfResult, 1, 0.0 );
+        m_aoProgram.resize( nProgramSize - nArgs );
+        Emit( OP_CONST, 0, dfResult );
+        return;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      A constant second operand is stored in the instruction.         */
+/* -------------------------------------------------------------------- */
+    if( nArgs == 2 && m_aoProgram[nProgramSize - 1].eOp == OP_CONST )
+    {
+        sInstr.dfValue = m_aoProgram[nProgramSize - 1].dfValue;
+        sInstr.bConstOperand = TRUE;
+        m_aoProgram.resize( nProgramSize - 1 );
+    }
+
+    m_aoProgram.push_back( sInstr );
+}
+
+/************************************************************************/
+/*                              Finalize()                              */
+/************************************************************************/
+
+void VRTExpression::Finalize()
+{
+    int nDepth = 0;
+    m_nStackDepth = 0;
+    m_anUsedSources.clear();
+    for( size_t i = 0; i < m_aoProgram.size(); i++ )
+    {
+        const Instruction& sInstr = m_aoProgram[i];
+        const int nArgs = VRTExpressionArity(sInstr.eOp);
+        nDepth += 1 - (nArgs - (sInstr.bConstOperand ? 1 : 0));
+        m_nStackDepth = std::max(m_nStackDepth, nDepth);
+
+        if( sInstr.eOp == OP_LOAD &&
+            std::find(m_anUsedSources.begin(), m_anUsedSources.end(),
+                      sInstr.nSource) == m_anUsedSources.end() )
+            m_anUsedSources.push_back( sInstr.nSource );
+    }
+    CPLAssert( nDepth == 1 );
+    std::sort( m_anUsedSources.begin(), m_anUsedSources.end() );
+}
+
+/************************************************************************/
+/*                              Compile()                               */
+/************************************************************************/
+
+/**
+ * Compile a pixel function expression.
+ *
+ * @param pszExpression the expression, for example "(B1-B2)/(B1+B2)".
+ *
+ * @return a new expression to delete by the caller, or NULL if the
+ * expression is invalid, in which case an error has been emitted.
+ */
+VRTExpression *VRTExpression::Compile( const char *pszExpression )
+{
+    VRTExpression *poExpr = new VRTExpression();
+    poExpr->m_osExpression = pszExpression;
+
+    VRTExpressionParser oParser( poExpr, pszExpression );
+    if( !oParser.Parse() )
+    {
+        delete poExpr;
+        return NULL;
+    }
+
+    poExpr->Finalize();
+    if( poExpr->m_nStackDepth > VRT_EXPRESSION_MAX_STACK_DEPTH )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Invalid pixel function expression '%s': "
+                  "expression too deeply nested.",
+                  VRTExpressionQuote(pszExpression).c_str() );
+        delete poExpr;
+        return NULL;
+    }
+
+    return poExpr;
+}
+
+/************************************************************************/
+/*                         GetMaxSourceIndex()                          */
+/************************************************************************/
+
+/** Return the highest 1-based source number used, or 0. */
+int VRTExpression::GetMaxSourceIndex() const
+{
+    if( m_anUsedSources.empty() )
+        return 0;
+    return m_anUsedSources.back() + 1;
+}
+
+/************************************************************************/
+/*                              Evaluate()                              */
+/************************************************************************/
+
+/**
+ * Evaluate the expression on nCount pixels.
+ *
+ * @param papadfSources the values of the sources, indexed by 0-based
+ * source number. Only the sources of GetUsedSources() are accessed.
+ * @param nCount number of pixels.
+ * @param dfNoData value of NODATA, or NaN if the band has no nodata value.
+ * @param bPropagateNoData whether pixels for which one of the used sources
+ * is nodata are set to nodata.
+ * @param padfWork work buffer of GetStackDepth() * nCount values.
+ *
+ * @return the nCount results, that point either in padfWork or in one of
+ * the source lines.
+ */
+const double *VRTExpression::Evaluate( const double * const *papadfSources,
+                                       int nCount, double dfNoData,
+                                       int bPropagateNoData,
+                                       double *padfWork ) const
+{
+    const double *apadfStack[VRT_EXPRESSION_MAX_STACK_DEPTH];
+    int nDepth = 0;
+
+    for( size_t iInstr = 0; iInstr < m_aoProgram.size(); iInstr++ )
+    {
+        const Instruction *psInstr = &m_aoProgram[iInstr];
+        switch( psInstr->eOp )
+        {
+            case OP_LOAD:
+                apadfStack[nDepth++] = papadfSources[psInstr->nSource];
+                break;
+
+            case OP_CONST:
+            case OP_NODATA:
+            {
+                double *padfOut = padfWork + nDepth * nCount;
+                std::fill( padfOut, padfOut + nCount,
+                           psInstr->eOp == OP_CONST ? psInstr->dfValue
+                                                    : dfNoData );
+                apadfStack[nDepth++] = padfOut;
+                break;
+            }
+
+            default:
+            {
+                nDepth -= VRTExpressionArity(psInstr->eOp) -
+                          (psInstr->bConstOperand ? 1 : 0);
+                double *padfOut = padfWork + nDepth * nCount;
+                VRTExpressionApply( psInstr, apadfStack + nDepth,
+                                    padfOut, nCount, dfNoData );
+                apadfStack[nDepth++] = padfOut;
+                break;
+            }
+        }
+    }
+    CPLAssert( nDepth == 1 );
+
+    if( !bPropagateNoData || m_anUsedSources.empty() )
+        return apadfStack[0];
+
+    if( apadfStack[0] != padfWork )
+        memcpy( padfWork, apadfStack[0], sizeof(double) * nCount );
+    for( size_t i = 0; i < m_anUsedSources.size(); i++ )
+    {
+        const double *padfSrc = papadfSources[m_anUsedSources[i]];
+        if( CPLIsNan(dfNoData) )
+        {
+            for( int j = 0; j < nCount; j++ )
+            {
+                if( CPLIsNan(padfSrc[j]) )
+                    padfWork[j] = dfNoData;
+            }
+        }
+        else
+        {
+            for( int j = 0; j < nCount; j++ )
+            {
+                if( padfSrc[j] == dfNoData )
+                    padfWork[j] = dfNoData;
+            }
+        }
+    }
+    return padfWork;
+}
@@ -0,0 +1,628 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  Virtual GDAL Datasets
+ * Purpose:  Binary sidecar cache of the sources of a VRT file, so that
+ *           VRTs with huge numbers of sources can be reopened without
+ *           parsing their XML again.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "vrtdataset.h"
+#include "cpl_atomic_ops.h"
+#include "cpl_minixml.h"
+#include "cpl_string.h"
+
+#include <vector>
+
+CPL_CVSID("$Id$");
+
+/*
+ * The cache of foo.vrt is foo.vrt.srccache. It is written in the native
+ * byte order of the machine and contains:
+ *  - the "VRTSRCC1" signature and the 32-bit integer 1, to detect byte
+ *    order mismatches,
+ *  - the size and modification time of foo.vrt and the directory used to
+ *    resolve its relative source filenames, which must all match for the
+ *    cache to be used,
+ *  - the size of the cache file itself, to reject truncated files,
+ *  - the XML of the dataset without the sources of its cached bands,
+ *  - for each band, its number of cached sources followed by, for each
+ *    source, its type and the record written by WriteToSourceCache().
+ * Bands with sources that cannot be cached (filtered sources, sources
+ * without SourceProperties, ...) keep their sources in the XML.
+ */
+
+static const char VRT_SOURCE_CACHE_SIGNATURE[] = "VRTSRCC1";
+static const char VRT_SOURCE_CACHE_EXTENSION[] = "srccache";
+
+/* Distinguishes the temporary files of the threads of a process */
+static volatile int nVRTSourceCacheTmpCounter = 0;
+
+/************************************************************************/
+/*                   Serialization helper functions.                    */
+/************************************************************************/
+
+static void VRTCacheWriteInt( CPLString& osRecord, int nVal )
+{
+    osRecord.append( reinterpret_cast<const char*>(&nVal), sizeof(nVal) );
+}
+
+static void VRTCacheWriteDouble( CPLString& osRecord, double dfVal )
+{
+    osRecord.append( reinterpret_cast<const char*>(&dfVal), sizeof(dfVal) );
+}
+
+static void VRTCacheWriteString( CPLString& osRecord, const char* pszVal )
+{
+    const int nLen = static_cast<int>(strlen(pszVal));
+    VRTCacheWriteInt( osRecord, nLen );
+    osRecord.append( pszVal, nLen );
+}
+
+static bool VRTCacheReadInt( const GByte** ppabyData, const GByte* pabyEnd,
+                             int* pnVal )
+{
+    if( pabyEnd - *ppabyData < static_cast<int>(sizeof(int)) )
+        return false;
+    memcpy( pnVal, *ppabyData, sizeof(int) );
+    *ppabyData += sizeof(int);
+    return true;
+}
+
+static bool VRTCacheReadDouble( const GByte** ppabyData, const GByte* pabyEnd,
+                                double* pdfVal )
+{
+    if( pabyEnd - *ppabyData < static_cast<int>(sizeof(double)) )
+        return false;
+    memcpy( pdfVal, *ppabyData, sizeof(double) );
+    *ppabyData += sizeof(double);
+    return true;
+}
+
+static bool VRTCacheReadString( const GByte** ppabyData, const GByte* pabyEnd,
+                                CPLString& osVal )
+{
+    int nLen = 0;
+    if( !VRTCacheReadInt( ppabyData, pabyEnd, &nLen ) ||
+        nLen < 0 || pabyEnd - *ppabyData < nLen )
+        return false;
+    osVal.assign( reinterpret_cast<const char*>(*ppabyData), nLen );
+    *ppabyData += nLen;
+    return true;
+}
+
+/************************************************************************/
+/*                 VRTSimpleSource::WriteToSourceCache()                */
+/*                                                                      */
+/*      Only sources whose opening is still pending, that is whose      */
+/*      XML had complete SourceProperties, can be cached.               */
+/************************************************************************/
+
+int VRTSimpleSource::WriteToSourceCache( CPLString& osRecord )
+
+{
+    if( !m_bPendingOpen )
+        return FALSE;
+
+    VRTCacheWriteString( osRecord, m_osSrcDSName );
+    VRTCacheWriteString( osRecord, m_osSourceFileNameOri );
+    VRTCacheWriteInt( osRecord, m_bRelativeToVRTOri );
+    VRTCacheWriteInt( osRecord, m_nSrcBand );
+    VRTCacheWriteInt( osRecord, m_bGetMaskBand );
+    VRTCacheWriteInt( osRecord, m_nSrcRasterXSize );
+    VRTCacheWriteInt( osRecord, m_nSrcRasterYSize );
+    VRTCacheWriteInt( osRecord, static_cast<int>(m_eSrcDataType) );
+    VRTCacheWriteInt( osRecord, m_nSrcBlockXSize );
+    VRTCacheWriteInt( osRecord, m_nSrcBlockYSize );
+    VRTCacheWriteInt( osRecord, m_bSrcShared );
+    VRTCacheWriteInt( osRecord, CSLCount(m_papszSrcOpenOptions) );
+    for( char** papszIter = m_papszSrcOpenOptions;
+         papszIter && *papszIter; ++papszIter )
+        VRTCacheWriteString( osRecord, *papszIter );
+    VRTCacheWriteString( osRecord, m_osResampling );
+    VRTCacheWriteDouble( osRecord, m_dfSrcXOff );
+    VRTCacheWriteDouble( osRecord, m_dfSrcYOff );
+    VRTCacheWriteDouble( osRecord, m_dfSrcXSize );
+    VRTCacheWriteDouble( osRecord, m_dfSrcYSize );
+    VRTCacheWriteDouble( osRecord, m_dfDstXOff );
+    VRTCacheWriteDouble( osRecord, m_dfDstYOff );
+    VRTCacheWriteDouble( osRecord, m_dfDstXSize );
+    VRTCacheWriteDouble( osRecord, m_dfDstYSize );
+    VRTCacheWriteInt( osRecord, m_bNoDataSet );
+    VRTCacheWriteDouble( osRecord, m_dfNoDataValue );
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                VRTSimpleSource::ReadFromSourceCache()                */
+/************************************************************************/
+
+int VRTSimpleSource::ReadFromSourceCache( const GByte** ppabyData,
+                                          const GByte* pabyEnd )
+
+{
+    int nDataType = 0;
+    int nOpenOptions = 0;
+    if( !VRTCacheReadString( ppabyData, pabyEnd, m_osSrcDSName ) ||
+        !VRTCacheReadString( ppabyData, pabyEnd, m_osSourceFileNameOri ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_bRelativeToVRTOri ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_nSrcBand ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_bGetMaskBand ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_nSrcRasterXSize ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_nSrcRasterYSize ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &nDataType ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_nSrcBlockXSize ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_nSrcBlockYSize ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_bSrcShared ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &nOpenOptions ) )
+        return FALSE;
+
+    if( nDataType <= GDT_Unknown || nDataType >= GDT_TypeCount ||
+        m_nSrcBand <= 0 || nOpenOptions < 0 )
+        return FALSE;
+    m_eSrcDataType = static_cast<GDALDataType>(nDataType);
+
+    for( int i = 0; i < nOpenOptions; i++ )
+    {
+        CPLString osOption;
+        if( !VRTCacheReadString( ppabyData, pabyEnd, osOption ) )
+            return FALSE;
+        m_papszSrcOpenOptions = CSLAddString( m_papszSrcOpenOptions,
+                                              osOption );
+    }
+
+    if( !VRTCacheReadString( ppabyData, pabyEnd, m_osResampling ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfSrcXOff ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfSrcYOff ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfSrcXSize ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfSrcYSize ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfDstXOff ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfDstYOff ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfDstXSize ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfDstYSize ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_bNoDataSet ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfNoDataValue ) )
+        return FALSE;
+
+    m_bPendingOpen = TRUE;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                VRTComplexSource::WriteToSourceCache()                */
+/************************************************************************/
+
+int VRTComplexSource::WriteToSourceCache( CPLString& osRecord )
+
+{
+    if( !VRTSimpleSource::WriteToSourceCache( osRecord ) )
+        return FALSE;
+
+    VRTCacheWriteInt( osRecord, static_cast<int>(m_eScalingType) );
+    VRTCacheWriteDouble( osRecord, m_dfScaleOff );
+    VRTCacheWriteDouble( osRecord, m_dfScaleRatio );
+    VRTCacheWriteInt( osRecord, m_bSrcMinMaxDefined );
+    VRTCacheWriteDouble( osRecord, m_dfSrcMin );
+    VRTCacheWriteDouble( osRecord, m_dfSrcMax );
+    VRTCacheWriteDouble( osRecord, m_dfDstMin );
+    VRTCacheWriteDouble( osRecord, m_dfDstMax );
+    VRTCacheWriteDouble( osRecord, m_dfExponent );
+    VRTCacheWriteInt( osRecord, m_nColorTableComponent );
+    VRTCacheWriteInt( osRecord, m_nLUTItemCount );
+    for( int i = 0; i < m_nLUTItemCount; i++ )
+    {
+        VRTCacheWriteDouble( osRecord, m_padfLUTInputs[i] );
+        VRTCacheWriteDouble( osRecord, m_padfLUTOutputs[i] );
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*               VRTComplexSource::ReadFromSourceCache()                */
+/************************************************************************/
+
+int VRTComplexSource::ReadFromSourceCache( const GByte** ppabyData,
+                                           const GByte* pabyEnd )
+
+{
+    if( !VRTSimpleSource::ReadFromSourceCache( ppabyData, pabyEnd ) )
+        return FALSE;
+
+    int nScalingType = 0;
+    int nLUTItemCount = 0;
+    if( !VRTCacheReadInt( ppabyData, pabyEnd, &nScalingType ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfScaleOff ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfScaleRatio ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_bSrcMinMaxDefined ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfSrcMin ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfSrcMax ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfDstMin ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfDstMax ) ||
+        !VRTCacheReadDouble( ppabyData, pabyEnd, &m_dfExponent ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &m_nColorTableComponent ) ||
+        !VRTCacheReadInt( ppabyData, pabyEnd, &nLUTItemCount ) )
+        return FALSE;
+
+    if( nScalingType != VRT_SCALING_NONE &&
+        nScalingType != VRT_SCALING_LINEAR &&
+        nScalingType != VRT_SCALING_EXPONENTIAL )
+        return FALSE;
+    m_eScalingType = static_cast<VRTComplexSourceScaling>(nScalingType);
+
+    if( nLUTItemCount < 0 ||
+        (pabyEnd - *ppabyData) / (2 * sizeof(double)) <
+                                    static_cast<size_t>(nLUTItemCount) )
+        return FALSE;
+    if( nLUTItemCount > 0 )
+    {
+        m_padfLUTInputs = static_cast<double *>(
+            VSI_MALLOC2_VERBOSE(nLUTItemCount, sizeof(double)) );
+        m_padfLUTOutputs = static_cast<double *>(
+            VSI_MALLOC2_VERBOSE(nLUTItemCount, sizeof(double)) );
+        if( m_padfLUTInputs == NULL || m_padfLUTOutputs == NULL )
+            return FALSE;
+        m_nLUTItemCount = nLUTItemCount;
+        for( int i = 0; i < nLUTItemCount; i++ )
+        {
+            VRTCacheReadDouble( ppabyData, pabyEnd, &m_padfLUTInputs[i] );
+            VRTCacheReadDouble( ppabyData, pabyEnd, &m_padfLUTOutputs[i] );
+        }
+    }
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                      VRTGetSourceCacheHeader()                       */
+/*                                                                      */
+/*      Returns the header identifying the state of the VRT file the    */
+/*      cache is derived from, or an empty string if it cannot be       */
+/*      established.                                                    */
+/************************************************************************/
+
+static CPLString VRTGetSourceCacheHeader( const char* pszFilename,
+                                          const char* pszVRTPath )
+{
+    CPLString osHeader;
+    VSIStatBufL sStat;
+    if( VSIStatL( pszFilename, &sStat ) != 0 )
+        return osHeader;
+
+    osHeader.append( VRT_SOURCE_CACHE_SIGNATURE,
+                     strlen(VRT_SOURCE_CACHE_SIGNATURE) );
+    VRTCacheWriteInt( osHeader, 1 );
+    VRTCacheWriteDouble( osHeader, static_cast<double>(sStat.st_size) );
+    VRTCacheWriteDouble( osHeader, static_cast<double>(sStat.st_mtime) );
+    VRTCacheWriteString( osHeader, pszVRTPath ? pszVRTPath : "" );
+    return osHeader;
+}
+
+/************************************************************************/
+/*                          WriteSourceCache()                          */
+/************************************************************************/
+
+void VRTDataset::WriteSourceCache( const char *pszFilename,
+                                   const char *pszVRTPath )
+
+{
+    CPLString osHeader = VRTGetSourceCacheHeader( pszFilename, pszVRTPath );
+    if( osHeader.empty() )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the records of the bands whose sources can all be       */
+/*      cached.                                                         */
+/* -------------------------------------------------------------------- */
+    std::vector<CPLString> aosBandRecords( nBands );
+    std::vector<bool> abBandCached( nBands, false );
+    int nCachedSources = 0;
+
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        VRTRasterBand* poBand
+            = reinterpret_cast<VRTRasterBand *>( papoBands[iBand] );
+        if( !poBand->IsSourcedRasterBand() )
+            continue;
+        VRTSourcedRasterBand* poSrcBand
+            = reinterpret_cast<VRTSourcedRasterBand *>( poBand );
+        if( poSrcBand->nSources == 0 )
+            continue;
+
+        CPLString& osRecords = aosBandRecords[iBand];
+        VRTCacheWriteInt( osRecords, poSrcBand->nSources );
+        bool bOK = true;
+        for( int iSource = 0; bOK && iSource < poSrcBand->nSources; iSource++ )
+        {
+            VRTSource* poSource = poSrcBand->papoSources[iSource];
+            if( !poSource->IsSimpleSource() )
+            {
+                bOK = false;
+                break;
+            }
+            VRTSimpleSource* poSimpleSource
+                = reinterpret_cast<VRTSimpleSource *>( poSource );
+            VRTCacheWriteString( osRecords, poSimpleSource->GetType() );
+            bOK = CPL_TO_BOOL(poSimpleSource->WriteToSourceCache(osRecords));
+        }
+        if( bOK )
+        {
+            abBandCached[iBand] = true;
+            nCachedSources += poSrcBand->nSources;
+        }
+    }
+
+    if( nCachedSources == 0 )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      Serialize the dataset without the cached sources.               */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anSavedSources( nBands, 0 );
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        if( !abBandCached[iBand] )
+            continue;
+        VRTSourcedRasterBand* poSrcBand
+            = reinterpret_cast<VRTSourcedRasterBand *>( papoBands[iBand] );
+        anSavedSources[iBand] = poSrcBand->nSources;
+        poSrcBand->nSources = 0;
+    }
+
+    CPLXMLNode* psTree = SerializeToXML( pszVRTPath );
+
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        if( abBandCached[iBand] )
+            reinterpret_cast<VRTSourcedRasterBand *>(
+                papoBands[iBand] )->nSources = anSavedSources[iBand];
+    }
+
+    if( psTree == NULL )
+        return;
+    char* pszXML = CPLSerializeXMLTree( psTree );
+    CPLDestroyXMLNode( psTree );
+
+/* -------------------------------------------------------------------- */
+/*      Compute the size of the file, so that truncated or appended     */
+/*      caches are rejected before being parsed.                        */
+/* -------------------------------------------------------------------- */
+    CPLString osPayload;
+    VRTCacheWriteString( osPayload, pszXML );
+    CPLFree( pszXML );
+    VRTCacheWriteInt( osPayload, nBands );
+
+    GUIntBig nFileSize = osHeader.size() + sizeof(double) + osPayload.size();
+    for( int iBand = 0; iBand < nBands; iBand++ )
+    {
+        if( abBandCached[iBand] )
+            nFileSize += aosBandRecords[iBand].size();
+        else
+            nFileSize += sizeof(int);
+    }
+    VRTCacheWriteDouble( osHeader, static_cast<double>(nFileSize) );
+    osHeader += osPayload;
+
+/* -------------------------------------------------------------------- */
+/*      Write the file under a temporary name, and rename it once       */
+/*      complete, so that concurrent readers never see a partial        */
+/*      cache.                                                          */
+/* -------------------------------------------------------------------- */
+    const CPLString osCacheFilename
+        = CPLSPrintf( "%s.%s", pszFilename, VRT_SOURCE_CACHE_EXTENSION );
+    const CPLString osTmpFilename
+        = CPLSPrintf( "%s.tmp" CPL_FRMT_GIB "_%d", osCacheFilename.c_str(),
+                      CPLGetPID(), CPLAtomicInc(&nVRTSourceCacheTmpCounter) );
+    VSILFILE* fp = VSIFOpenL( osTmpFilename, "wb" );
+    if( fp == NULL )
+    {
+        CPLDebug( "VRT", "Cannot create %s", osTmpFilename.c_str() );
+        return;
+    }
+
+    bool bOK = VSIFWriteL( osHeader.data(), 1, osHeader.size(), fp )
+                                                        == osHeader.size();
+    for( int iBand = 0; bOK && iBand < nBands; iBand++ )
+    {
+        if( abBandCached[iBand] )
+        {
+            const CPLString& osRecords = aosBandRecords[iBand];
+            bOK = VSIFWriteL( osRecords.data(), 1, osRecords.size(), fp )
+                                                        == osRecords.size();
+        }
+        else
+        {
+            const int nZero = 0;
+            bOK = VSIFWriteL( &nZero, sizeof(nZero), 1, fp ) == 1;
+        }
+    }
+    if( VSIFCloseL( fp ) != 0 )
+        bOK = false;
+
+    if( bOK && VSIRename( osTmpFilename, osCacheFilename ) != 0 )
+    {
+        // rename() does not replace an existing file on Windows.
+        VSIUnlink( osCacheFilename );
+        bOK = VSIRename( osTmpFilename, osCacheFilename ) == 0;
+    }
+
+    if( !bOK )
+    {
+        CPLDebug( "VRT", "Failed to write %s", osCacheFilename.c_str() );
+        VSIUnlink( osTmpFilename );
+    }
+    else
+    {
+        CPLDebug( "VRT", "Wrote %d sources in %s", nCachedSources,
+                  osCacheFilename.c_str() );
+    }
+}
+
+/************************************************************************/
+/*                        OpenFromSourceCache()                         */
+/*                                                                      */
+/*      Returns NULL if there is no valid cache for the VRT file, in    */
+/*      which case it must be opened from its XML.                      */
+/************************************************************************/
+
+GDALDataset *VRTDataset::OpenFromSourceCache( const char *pszFilename,
+                                              const char *pszVRTPath )
+
+{
+    const CPLString osCacheFilename
+        = CPLSPrintf( "%s.%s", pszFilename, VRT_SOURCE_CACHE_EXTENSION );
+    VSILFILE* fp = VSIFOpenL( osCacheFilename, "rb" );
+    if( fp == NULL )
+        return NULL;
+
+    GByte* pabyCache = NULL;
+    vsi_l_offset nCacheSize = 0;
+    const int bIngested
+        = VSIIngestFile( fp, NULL, &pabyCache, &nCacheSize, -1 );
+    CPL_IGNORE_RET_VAL(VSIFCloseL( fp ));
+    if( !bIngested )
+        return NULL;
+
+    const GByte* pabyData = pabyCache;
+    const GByte* pabyEnd = pabyCache + nCacheSize;
+
+/* -------------------------------------------------------------------- */
+/*      Check that the cache corresponds to the current VRT file.       */
+/* -------------------------------------------------------------------- */
+    const CPLString osHeader = VRTGetSourceCacheHeader( pszFilename,
+                                                        pszVRTPath );
+    if( osHeader.empty() ||
+        static_cast<vsi_l_offset>(osHeader.size()) > nCacheSize ||
+        memcmp( pabyData, osHeader.data(), osHeader.size() ) != 0 )
+    {
+        CPLDebug( "VRT", "%s is outdated. Ignoring it",
+                  osCacheFilename.c_str() );
+        VSIFree( pabyCache );
+        return NULL;
+    }
+    pabyData += osHeader.size();
+
+    double dfFileSize = 0.0;
+    if( !VRTCacheReadDouble( &pabyData, pabyEnd, &dfFileSize ) ||
+        dfFileSize != static_cast<double>(nCacheSize) )
+    {
+        CPLDebug( "VRT", "%s does not have the expected size. Ignoring it",
+                  osCacheFilename.c_str() );
+        VSIFree( pabyCache );
+        return NULL;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Instantiate the dataset from the XML without cached sources.    */
+/* -------------------------------------------------------------------- */
+    CPLString osXML;
+    int nBandCount = 0;
+    if( !VRTCacheReadString( &pabyData, pabyEnd, osXML ) ||
+        !VRTCacheReadInt( &pabyData, pabyEnd, &nBandCount ) )
+    {
+        VSIFree( pabyCache );
+        return NULL;
+    }
+
+    VRTDataset* poDS = reinterpret_cast<VRTDataset *>(
+        OpenXML( osXML, pszVRTPath, GA_ReadOnly ) );
+    if( poDS == NULL || poDS->GetRasterCount() != nBandCount )
+    {
+        delete poDS;
+        VSIFree( pabyCache );
+        return NULL;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Add the cached sources.                                         */
+/* -------------------------------------------------------------------- */
+    bool bOK = true;
+    for( int iBand = 0; bOK && iBand < nBandCount; iBand++ )
+    {
+        int nSources = 0;
+        if( !VRTCacheReadInt( &pabyData, pabyEnd, &nSources ) || nSources < 0 )
+        {
+            bOK = false;
+            break;
+        }
+        if( nSources == 0 )
+            continue;
+
+        VRTRasterBand* poBand
+            = reinterpret_cast<VRTRasterBand *>( poDS->papoBands[iBand] );
+        if( !poBand->IsSourcedRasterBand() )
+        {
+            bOK = false;
+            break;
+        }
+        VRTSourcedRasterBand* poSrcBand
+            = reinterpret_cast<VRTSourcedRasterBand *>( poBand );
+
+        for( int iSource = 0; iSource < nSources; iSource++ )
+        {
+            CPLString osType;
+            if( !VRTCacheReadString( &pabyData, pabyEnd, osType ) )
+            {
+                bOK = false;
+                break;
+            }
+
+            VRTSimpleSource* poSource;
+            if( osType == "SimpleSource" )
+                poSource = new VRTSimpleSource();
+            else if( osType == "AveragedSource" )
+                poSource = new VRTAveragedSource();
+            else if( osType == "ComplexSource" )
+                poSource = new VRTComplexSource();
+            else
+            {
+                bOK = false;
+                break;
+            }
+
+            if( !poSource->ReadFromSourceCache( &pabyData, pabyEnd ) )
+            {
+                delete poSource;
+                bOK = false;
+                break;
+            }
+            poSrcBand->AddSource( poSource );
+        }
+    }
+
+    VSIFree( pabyCache );
+
+    if( !bOK || pabyData != pabyEnd )
+    {
+        CPLDebug( "VRT", "%s is corrupted. Ignoring it",
+                  osCacheFilename.c_str() );
+        delete poDS;
+        return NULL;
+    }
+
+    return poDS;
+}
@@ -31,6 +31,10 @@
 #include "vrtdataset.h"
 #include "cpl_minixml.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
+
+#include <algorithm>
+#include <map>
 
 CPL_CVSID("$Id$");
 
@@ -97,6 +101,12 @@ void VRTSourcedRasterBand::Initialize( int nXSize, int nYSize )
     bEqualAreas = FALSE;
     m_nRecursionCounter = 0;
     m_papszSourceList = NULL;
+    m_nIndexedSources = 0;
+    m_papoIndexedSources = NULL;
+    m_dfIndexCellXSize = 0.0;
+    m_dfIndexCellYSize = 0.0;
+    m_nIndexCellsX = 0;
+    m_nIndexCellsY = 0;
 }
 
 /************************************************************************/
@@ -110,6 +120,40 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
     CSLDestroy(m_papszSourceList);
 }
 
+/************************************************************************/
+/*                           VRTBandSourceIO()                          */
+/*                                                                      */
+/*      Reads one source of a band level request.                       */
+/************************************************************************/
+
+typedef struct
+{
+    int             nXOff;
+    int             nYOff;
+    int             nXSize;
+    int             nYSize;
+    void           *pData;
+    int             nBufXSize;
+    int             nBufYSize;
+    GDALDataType    eBufType;
+    GSpacing        nPixelSpace;
+    GSpacing        nLineSpace;
+} VRTBandSourceIOArgs;
+
+static CPLErr VRTBandSourceIO( VRTSource *poSource, void *pUserData,
+                               GDALRasterIOExtraArg *psExtraArg )
+{
+    VRTBandSourceIOArgs* psArgs
+        = static_cast<VRTBandSourceIOArgs *>( pUserData );
+    return poSource->RasterIO( psArgs->nXOff, psArgs->nYOff,
+                               psArgs->nXSize, psArgs->nYSize,
+                               psArgs->pData,
+                               psArgs->nBufXSize, psArgs->nBufYSize,
+                               psArgs->eBufType,
+                               psArgs->nPixelSpace, psArgs->nLineSpace,
+                               psExtraArg );
+}
+
 /************************************************************************/
 /*                             IRasterIO()                              */
 /************************************************************************/
@@ -124,23 +168,31 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 
 {
     // If resampling with non-nearest neighbour, we need to be carefull
-    // if the VRT band exposes a nodata value, but the sources do not have it
+    // if the VRT band exposes a nodata value, but the sources do not have it.
+    // Only the sources that may be read are checked, so as not to open
+    // deferred sources outside of the request window.
     if (eRWFlag == GF_Read &&
         (nXSize != nBufXSize || nYSize != nBufYSize) &&
         psExtraArg->eResampleAlg != GRIORA_NearestNeighbour &&
         m_bNoDataValueSet )
     {
-        for( int i = 0; i < nSources; i++ )
+        std::vector<int> anCheckedSources;
+        GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize, anCheckedSources );
+        for( size_t i = 0; i < anCheckedSources.size(); i++ )
         {
+            VRTSource* poVRTSource = papoSources[anCheckedSources[i]];
             bool bFallbackToBase = false;
-            if( !papoSources[i]->IsSimpleSource() )
+            if( !poVRTSource->IsSimpleSource() )
                 bFallbackToBase = true;
             else
             {
                 VRTSimpleSource* poSource
-                    = reinterpret_cast<VRTSimpleSource *>( papoSources[i] );
+                    = reinterpret_cast<VRTSimpleSource *>( poVRTSource );
+                GDALRasterBand* poSrcBand = poSource->GetBand();
                 int bSrcHasNoData = FALSE;
-                double dfSrcNoData = poSource->GetBand()->GetNoDataValue(&bSrcHasNoData);
+                double dfSrcNoData = 0.0;
+                if( poSrcBand != NULL )
+                    dfSrcNoData = poSrcBand->GetNoDataValue(&bSrcHasNoData);
                 if( !bSrcHasNoData || dfSrcNoData != m_dfNoDataValue )
                     bFallbackToBase = true;
             }
@@ -229,35 +281,31 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
 
     m_nRecursionCounter ++;
 
-    GDALProgressFunc  pfnProgressGlobal = psExtraArg->pfnProgress;
-    void             *pProgressDataGlobal = psExtraArg->pProgressData;
-
 /* -------------------------------------------------------------------- */
-/*      Overlay each source in turn over top this.                      */
+/*      Overlay each source in turn over top this. Only the sources     */
+/*      whose destination window may intersect the request are          */
+/*      considered.                                                     */
 /* -------------------------------------------------------------------- */
-    CPLErr eErr = CE_None;
-    for( int iSource = 0; eErr == CE_None && iSource < nSources; iSource++ )
-    {
-        psExtraArg->pfnProgress = GDALScaledProgress;
-        psExtraArg->pProgressData = 
-                GDALCreateScaledProgress( 1.0 * iSource / nSources,
-                                        1.0 * (iSource + 1) / nSources,
-                                        pfnProgressGlobal,
-                                        pProgressDataGlobal );
-        if( psExtraArg->pProgressData == NULL )
-            psExtraArg->pfnProgress = NULL;
-
-        eErr = 
-            papoSources[iSource]->RasterIO( nXOff, nYOff, nXSize, nYSize, 
-                                            pData, nBufXSize, nBufYSize, 
-                                            eBufType, nPixelSpace, nLineSpace,
-                                            psExtraArg);
-
-        GDALDestroyScaledProgress( psExtraArg->pProgressData );
-    }
-
-    psExtraArg->pfnProgress = pfnProgressGlobal;
-    psExtraArg->pProgressData = pProgressDataGlobal;
+    std::vector<int> anSources;
+    GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize, anSources );
+
+    VRTBandSourceIOArgs sArgs;
+    sArgs.nXOff = nXOff;
+    sArgs.nYOff = nYOff;
+    sArgs.nXSize = nXSize;
+    sArgs.nYSize = nYSize;
+    sArgs.pData = pData;
+    sArgs.nBufXSize = nBufXSize;
+    sArgs.nBufYSize = nBufYSize;
+    sArgs.eBufType = eBufType;
+    sArgs.nPixelSpace = nPixelSpace;
+    sArgs.nLineSpace = nLineSpace;
+
+    const CPLErr eErr = SourcesRasterIO( anSources,
+                                         nXOff, nYOff, nXSize, nYSize,
+                                         nBufXSize, nBufYSize,
+                                         VRTBandSourceIO, &sArgs,
+                                         psExtraArg );
 
     m_nRecursionCounter --;
 
@@ -296,6 +344,508 @@ CPLErr VRTSourcedRasterBand::IReadBlock( int nBlockXOff, int nBlockYOff,
                       nPixelSize, nPixelSize * nBlockXSize, &sExtraArg );
 }
 
+/************************************************************************/
+/*                         InvalidateSourceIndex()                      */
+/*                                                                      */
+/*      Must be called when sources are added, removed or replaced.     */
+/*      Sources appended with AddSource() are detected anyway.          */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourceIndex()
+
+{
+    m_nIndexedSources = 0;
+    m_papoIndexedSources = NULL;
+    m_nIndexCellsX = 0;
+    m_nIndexCellsY = 0;
+    m_anIndexCellStart.clear();
+    m_anIndexCellSources.clear();
+    m_anIndexUngriddedSources.clear();
+}
+
+/************************************************************************/
+/*                          BuildSourceIndex()                          */
+/*                                                                      */
+/*      Builds a regular grid over the band, whose cells list the       */
+/*      simple sources whose destination window touches them. Sources   */
+/*      without a destination window, non simple sources and sources    */
+/*      covering too many cells are put in a separate list that is      */
+/*      returned for any request.                                       */
+/************************************************************************/
+
+/* Below this number of sources, a linear scan is cheap enough. */
+static const int VRT_SOURCE_INDEX_MIN_SOURCES = 64;
+
+/* Sources covering more cells than this are not registered in the grid. */
+static const int VRT_SOURCE_INDEX_MAX_CELLS_PER_SOURCE = 64;
+
+void VRTSourcedRasterBand::BuildSourceIndex()
+
+{
+    InvalidateSourceIndex();
+    m_nIndexedSources = nSources;
+    m_papoIndexedSources = papoSources;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the destination windows.                                */
+/* -------------------------------------------------------------------- */
+    std::vector<double> adfWindows(4 * nSources);
+    std::vector<bool> abHasWindow(nSources, false);
+    double dfSumXSize = 0.0;
+    double dfSumYSize = 0.0;
+    int nWindows = 0;
+
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !papoSources[iSource]->IsSimpleSource() )
+            continue;
+        VRTSimpleSource* poSource
+            = reinterpret_cast<VRTSimpleSource *>( papoSources[iSource] );
+        double* padfWin = &adfWindows[4 * iSource];
+        if( !poSource->GetDstWindow( padfWin, padfWin + 1,
+                                     padfWin + 2, padfWin + 3 ) ||
+            !(padfWin[2] >= 0.0) || !(padfWin[3] >= 0.0) ||
+            CPLIsNan(padfWin[0]) || CPLIsNan(padfWin[1]) )
+            continue;
+        abHasWindow[iSource] = true;
+        dfSumXSize += padfWin[2];
+        dfSumYSize += padfWin[3];
+        nWindows ++;
+    }
+
+    if( nWindows == 0 )
+    {
+        for( int iSource = 0; iSource < nSources; iSource++ )
+            m_anIndexUngriddedSources.push_back(iSource);
+        return;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Cells of the size of an average source, but no more than       */
+/*      about 4 cells per source.                                       */
+/* -------------------------------------------------------------------- */
+    m_dfIndexCellXSize = std::max(1.0, dfSumXSize / nWindows);
+    m_dfIndexCellYSize = std::max(1.0, dfSumYSize / nWindows);
+    double dfCellsX = std::max(1.0, ceil(nRasterXSize / m_dfIndexCellXSize));
+    double dfCellsY = std::max(1.0, ceil(nRasterYSize / m_dfIndexCellYSize));
+    const double dfMaxCells = 4.0 * nWindows;
+    if( dfCellsX * dfCellsY > dfMaxCells )
+    {
+        const double dfRatio = sqrt(dfCellsX * dfCellsY / dfMaxCells);
+        m_dfIndexCellXSize *= dfRatio;
+        m_dfIndexCellYSize *= dfRatio;
+        dfCellsX = std::max(1.0, ceil(nRasterXSize / m_dfIndexCellXSize));
+        dfCellsY = std::max(1.0, ceil(nRasterYSize / m_dfIndexCellYSize));
+    }
+    m_nIndexCellsX = static_cast<int>(dfCellsX);
+    m_nIndexCellsY = static_cast<int>(dfCellsY);
+    const int nCells = m_nIndexCellsX * m_nIndexCellsY;
+
+/* -------------------------------------------------------------------- */
+/*      Compute the cell range of each source. Windows are considered   */
+/*      as closed intervals, consistently with GetSrcDstWindow().       */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anRanges(4 * nSources);
+    m_anIndexCellStart.resize(nCells + 1, 0);
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !abHasWindow[iSource] )
+        {
+            m_anIndexUngriddedSources.push_back(iSource);
+            continue;
+        }
+        const double* padfWin = &adfWindows[4 * iSource];
+        int* panRange = &anRanges[4 * iSource];
+        panRange[0] = GetIndexCell( padfWin[0], m_dfIndexCellXSize,
+                                    m_nIndexCellsX );
+        panRange[1] = GetIndexCell( padfWin[1], m_dfIndexCellYSize,
+                                    m_nIndexCellsY );
+        panRange[2] = GetIndexCell( padfWin[0] + padfWin[2],
+                                    m_dfIndexCellXSize, m_nIndexCellsX );
+        panRange[3] = GetIndexCell( padfWin[1] + padfWin[3],
+                                    m_dfIndexCellYSize, m_nIndexCellsY );
+        if( static_cast<GIntBig>(panRange[2] - panRange[0] + 1) *
+                (panRange[3] - panRange[1] + 1) >
+                                    VRT_SOURCE_INDEX_MAX_CELLS_PER_SOURCE )
+        {
+            abHasWindow[iSource] = false;
+            m_anIndexUngriddedSources.push_back(iSource);
+            continue;
+        }
+        for( int iY = panRange[1]; iY <= panRange[3]; iY++ )
+            for( int iX = panRange[0]; iX <= panRange[2]; iX++ )
+                m_anIndexCellStart[iY * m_nIndexCellsX + iX + 1] ++;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Fill the cells, in increasing source order.                     */
+/* -------------------------------------------------------------------- */
+    for( int iCell = 0; iCell < nCells; iCell++ )
+        m_anIndexCellStart[iCell + 1] += m_anIndexCellStart[iCell];
+    m_anIndexCellSources.resize(m_anIndexCellStart[nCells]);
+
+    std::vector<int> anFill(m_anIndexCellStart.begin(),
+                            m_anIndexCellStart.end() - 1);
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !abHasWindow[iSource] )
+            continue;
+        const int* panRange = &anRanges[4 * iSource];
+        for( int iY = panRange[1]; iY <= panRange[3]; iY++ )
+            for( int iX = panRange[0]; iX <= panRange[2]; iX++ )
+                m_anIndexCellSources[anFill[iY * m_nIndexCellsX + iX]++]
+                                                                    = iSource;
+    }
+
+    CPLDebug( "VRT", "Indexed %d sources in a %dx%d grid, %d ungridded",
+              nSources, m_nIndexCellsX, m_nIndexCellsY,
+              static_cast<int>(m_anIndexUngriddedSources.size()) );
+}
+
+/************************************************************************/
+/*                           GetIndexCell()                             */
+/************************************************************************/
+
+int VRTSourcedRasterBand::GetIndexCell( double dfCoord, double dfCellSize,
+                                        int nCells )
+
+{
+    const double dfCell = floor(dfCoord / dfCellSize);
+    if( !(dfCell >= 0.0) )
+        return 0;
+    if( dfCell >= nCells - 1 )
+        return nCells - 1;
+    return static_cast<int>(dfCell);
+}
+
+/************************************************************************/
+/*                        GetSourcesInWindow()                          */
+/*                                                                      */
+/*      Returns, in increasing order, the indices of the sources whose  */
+/*      destination window may intersect the passed window. This is a   */
+/*      superset of the sources that actually contribute to it.         */
+/************************************************************************/
+
+void VRTSourcedRasterBand::GetSourcesInWindow( int nXOff, int nYOff,
+                                               int nXSize, int nYSize,
+                                               std::vector<int>& anSources )
+
+{
+    anSources.clear();
+
+    if( nSources < VRT_SOURCE_INDEX_MIN_SOURCES )
+    {
+        for( int iSource = 0; iSource < nSources; iSource++ )
+            anSources.push_back(iSource);
+        return;
+    }
+
+    if( m_nIndexedSources != nSources || m_papoIndexedSources != papoSources )
+        BuildSourceIndex();
+
+    anSources = m_anIndexUngriddedSources;
+    if( m_nIndexCellsX == 0 )
+        return;
+
+    const int nMinX = GetIndexCell( nXOff, m_dfIndexCellXSize,
+                                    m_nIndexCellsX );
+    const int nMinY = GetIndexCell( nYOff, m_dfIndexCellYSize,
+                                    m_nIndexCellsY );
+    const int nMaxX = GetIndexCell( static_cast<double>(nXOff) + nXSize,
+                                    m_dfIndexCellXSize, m_nIndexCellsX );
+    const int nMaxY = GetIndexCell( static_cast<double>(nYOff) + nYSize,
+                                    m_dfIndexCellYSize, m_nIndexCellsY );
+    for( int iY = nMinY; iY <= nMaxY; iY++ )
+    {
+        for( int iX = nMinX; iX <= nMaxX; iX++ )
+        {
+            const int iCell = iY * m_nIndexCellsX + iX;
+            anSources.insert( anSources.end(),
+                m_anIndexCellSources.begin() + m_anIndexCellStart[iCell],
+                m_anIndexCellSources.begin() + m_anIndexCellStart[iCell + 1] );
+        }
+    }
+
+    // Sources spanning several cells are listed several times.
+    std::sort( anSources.begin(), anSources.end() );
+    anSources.erase( std::unique( anSources.begin(), anSources.end() ),
+                     anSources.end() );
+}
+
+/************************************************************************/
+/*                          VRTSourceIOJobFunc()                        */
+/************************************************************************/
+
+/* Maximum number of sources whose overlaps are checked against each */
+/* other when scheduling concurrent reads. */
+static const int VRT_SOURCE_IO_BATCH_SIZE = 1024;
+
+typedef struct
+{
+    VRTSourceIOFunc          pfnIO;
+    void                    *pUserData;
+    GDALRasterIOExtraArg     sExtraArg;
+    std::vector<VRTSource*>  apoSources;
+    CPLErr                   eErr;
+    int                      bDone;
+} VRTSourceIOJob;
+
+static void VRTSourceIOJobFunc( void *pData )
+{
+    VRTSourceIOJob* psJob = static_cast<VRTSourceIOJob *>( pData );
+
+    // Sources that are themselves VRTs are read sequentially by the
+    // worker threads. The job may also run in the calling thread, whose
+    // setting must be restored afterwards.
+    const char* pszPrevValue
+        = CPLGetThreadLocalConfigOption( "VRT_NUM_THREADS", NULL );
+    const bool bHadPrevValue = pszPrevValue != NULL;
+    CPLString osPrevValue( bHadPrevValue ? pszPrevValue : "" );
+    CPLSetThreadLocalConfigOption( "VRT_NUM_THREADS", "1" );
+
+    for( size_t i = 0;
+         psJob->eErr == CE_None && i < psJob->apoSources.size(); i++ )
+    {
+        psJob->eErr = psJob->pfnIO( psJob->apoSources[i], psJob->pUserData,
+                                    &psJob->sExtraArg );
+    }
+
+    CPLSetThreadLocalConfigOption( "VRT_NUM_THREADS",
+                            bHadPrevValue ? osPrevValue.c_str() : NULL );
+    psJob->bDone = TRUE;
+}
+
+/************************************************************************/
+/*                          SourcesRasterIO()                           */
+/*                                                                      */
+/*      Calls pfnIO on the passed sources, in order. If the dataset     */
+/*      has a pool of source threads (VRT_NUM_THREADS), the sources     */
+/*      whose area in the output buffer does not overlap the one of     */
+/*      a previous source are read concurrently. Sources sharing the    */
+/*      same source dataset name are always read by the same thread:    */
+/*      the proxies of a same file share the dataset opened by the      */
+/*      pool, and datasets are not thread-safe.                         */
+/************************************************************************/
+
+CPLErr VRTSourcedRasterBand::SourcesRasterIO(
+                                    const std::vector<int>& anSources,
+                                    int nXOff, int nYOff,
+                                    int nXSize, int nYSize,
+                                    int nBufXSize, int nBufYSize,
+                                    VRTSourceIOFunc pfnIO, void *pUserData,
+                                    GDALRasterIOExtraArg* psExtraArg )
+
+{
+    const int nCandidates = static_cast<int>(anSources.size());
+    GDALProgressFunc  pfnProgressGlobal = psExtraArg->pfnProgress;
+    void             *pProgressDataGlobal = psExtraArg->pProgressData;
+
+    CPLWorkerThreadPool *poThreadPool = NULL;
+    if( nCandidates > 1 && poDS != NULL )
+        poThreadPool
+            = reinterpret_cast<VRTDataset *>( poDS )->GetSourceThreadPool();
+
+/* -------------------------------------------------------------------- */
+/*      Sequential reading.                                             */
+/* -------------------------------------------------------------------- */
+    if( poThreadPool == NULL )
+    {
+        CPLErr eErr = CE_None;
+        for( int i = 0; eErr == CE_None && i < nCandidates; i++ )
+        {
+            psExtraArg->pfnProgress = GDALScaledProgress;
+            psExtraArg->pProgressData = 
+                    GDALCreateScaledProgress( 1.0 * i / nCandidates,
+                                            1.0 * (i + 1) / nCandidates,
+                                            pfnProgressGlobal,
+                                            pProgressDataGlobal );
+            if( psExtraArg->pProgressData == NULL )
+                psExtraArg->pfnProgress = NULL;
+
+            eErr = pfnIO( papoSources[anSources[i]], pUserData, psExtraArg );
+
+            GDALDestroyScaledProgress( psExtraArg->pProgressData );
+        }
+
+        psExtraArg->pfnProgress = pfnProgressGlobal;
+        psExtraArg->pProgressData = pProgressDataGlobal;
+
+        return eErr;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Concurrent reading, by batches of sources. Each source is       */
+/*      assigned to the level following the highest level of the        */
+/*      previous sources it overlaps in the output buffer. The levels   */
+/*      are read one after the other, and the sources of a level        */
+/*      concurrently.                                                   */
+/* -------------------------------------------------------------------- */
+    const double dfScaleX = nBufXSize / static_cast<double>(nXSize);
+    const double dfScaleY = nBufYSize / static_cast<double>(nYSize);
+
+    std::vector<int> anXMin, anYMin, anXMax, anYMax, anLevel;
+    std::vector<CPLString> aosKeys;
+
+    int nDone = 0;
+    for( int iBatchStart = 0; iBatchStart < nCandidates;
+         iBatchStart += VRT_SOURCE_IO_BATCH_SIZE )
+    {
+        const int nBatch = std::min( VRT_SOURCE_IO_BATCH_SIZE,
+                                     nCandidates - iBatchStart );
+        anXMin.resize( nBatch );
+        anYMin.resize( nBatch );
+        anXMax.resize( nBatch );
+        anYMax.resize( nBatch );
+        anLevel.resize( nBatch );
+        aosKeys.resize( nBatch );
+
+        int nLevels = 0;
+        for( int i = 0; i < nBatch; i++ )
+        {
+            VRTSource* poSource = papoSources[anSources[iBatchStart + i]];
+
+            // By default, the source may write anywhere in the buffer.
+            anXMin[i] = 0;
+            anYMin[i] = 0;
+            anXMax[i] = nBufXSize;
+            anYMax[i] = nBufYSize;
+            // Sources without a dataset name are all read by one job.
+            aosKeys[i].clear();
+            bool bKeyed = false;
+
+            if( poSource->IsSimpleSource() )
+            {
+                VRTSimpleSource* poSimpleSource
+                    = reinterpret_cast<VRTSimpleSource *>( poSource );
+                // Also creates the proxy of deferred sources in this
+                // thread.
+                const char* pszDSName = poSimpleSource->GetBand() != NULL ?
+                    poSimpleSource->GetSrcDatasetName() : NULL;
+                if( pszDSName != NULL && pszDSName[0] != '\0' )
+                {
+                    aosKeys[i] = pszDSName;
+                    bKeyed = true;
+                }
+
+                // Conservative bounds of the output window computed by
+                // GetSrcDstWindow().
+                double dfDstXOff, dfDstYOff, dfDstXSize, dfDstYSize;
+                if( bKeyed &&
+                    poSimpleSource->GetDstWindow( &dfDstXOff, &dfDstYOff,
+                                                  &dfDstXSize, &dfDstYSize ) )
+                {
+                    const double dfXMin
+                        = floor( (dfDstXOff - nXOff) * dfScaleX + 0.0005 );
+                    const double dfYMin
+                        = floor( (dfDstYOff - nYOff) * dfScaleY + 0.0005 );
+                    const double dfXMax
+                        = ceil( (dfDstXOff + dfDstXSize - nXOff) * dfScaleX
+                                - 0.0005 );
+                    const double dfYMax
+                        = ceil( (dfDstYOff + dfDstYSize - nYOff) * dfScaleY
+                                - 0.0005 );
+                    anXMin[i] = static_cast<int>(
+                        std::max( 0.0, std::min( dfXMin, 1.0 * nBufXSize ) ) );
+                    anYMin[i] = static_cast<int>(
+                        std::max( 0.0, std::min( dfYMin, 1.0 * nBufYSize ) ) );
+                    anXMax[i] = static_cast<int>(
+                        std::max( 0.0, std::min( dfXMax, 1.0 * nBufXSize ) ) );
+                    anYMax[i] = static_cast<int>(
+                        std::max( 0.0, std::min( dfYMax, 1.0 * nBufYSize ) ) );
+                }
+            }
+
+            int nLevel = 0;
+            for( int j = 0; j < i; j++ )
+            {
+                if( anLevel[j] >= nLevel &&
+                    anXMin[i] < anXMax[j] && anXMin[j] < anXMax[i] &&
+                    anYMin[i] < anYMax[j] && anYMin[j] < anYMax[i] )
+                {
+                    nLevel = anLevel[j] + 1;
+                }
+            }
+            anLevel[i] = nLevel;
+            nLevels = std::max( nLevels, nLevel + 1 );
+        }
+
+        for( int iLevel = 0; iLevel < nLevels; iLevel++ )
+        {
+            // One job per source dataset name.
+            std::vector<VRTSourceIOJob> asJobs;
+            std::map<CPLString, int> oMapKeyToJob;
+            for( int i = 0; i < nBatch; i++ )
+            {
+                if( anLevel[i] != iLevel )
+                    continue;
+
+                int iJob;
+                std::map<CPLString, int>::iterator oIter
+                    = oMapKeyToJob.find( aosKeys[i] );
+                if( oIter != oMapKeyToJob.end() )
+                {
+                    iJob = oIter->second;
+                }
+                else
+                {
+                    iJob = static_cast<int>(asJobs.size());
+                    oMapKeyToJob[aosKeys[i]] = iJob;
+                    asJobs.resize( iJob + 1 );
+                    asJobs[iJob].pfnIO = pfnIO;
+                    asJobs[iJob].pUserData = pUserData;
+                    asJobs[iJob].sExtraArg = *psExtraArg;
+                    asJobs[iJob].sExtraArg.pfnProgress = NULL;
+                    asJobs[iJob].sExtraArg.pProgressData = NULL;
+                    asJobs[iJob].eErr = CE_None;
+                    asJobs[iJob].bDone = FALSE;
+                }
+                asJobs[iJob].apoSources.push_back(
+                                papoSources[anSources[iBatchStart + i]] );
+                nDone ++;
+            }
+
+            if( asJobs.size() == 1 )
+            {
+                VRTSourceIOJobFunc( &asJobs[0] );
+            }
+            else
+            {
+                std::vector<void*> apJobs;
+                for( size_t iJob = 0; iJob < asJobs.size(); iJob++ )
+                    apJobs.push_back( &asJobs[iJob] );
+                if( !poThreadPool->SubmitJobs( VRTSourceIOJobFunc, apJobs ) )
+                {
+                    // Run in this thread the jobs that have not been run
+                    // by the pool.
+                    poThreadPool->WaitCompletion();
+                    for( size_t iJob = 0; iJob < asJobs.size(); iJob++ )
+                    {
+                        if( !asJobs[iJob].bDone )
+                            VRTSourceIOJobFunc( &asJobs[iJob] );
+                    }
+                }
+                poThreadPool->WaitCompletion();
+            }
+
+            for( size_t iJob = 0; iJob < asJobs.size(); iJob++ )
+            {
+                if( asJobs[iJob].eErr != CE_None )
+                    return asJobs[iJob].eErr;
+            }
+
+            if( pfnProgressGlobal != NULL &&
+                !pfnProgressGlobal( 1.0 * nDone / nCandidates, "",
+                                    pProgressDataGlobal ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+                return CE_Failure;
+            }
+        }
+    }
+
+    return CE_None;
+}
+
 
 /************************************************************************/
 /*                    CanUseSourcesMinMaxImplementations()              */
@@ -1336,6 +1886,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem( const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourceIndex();
             reinterpret_cast<VRTDataset *>( poDS )->SetNeedsFlush();
             return CE_None;
         }
@@ -1367,6 +1918,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata( char **papszNewMD, const char *pszDoma
             CPLFree( papoSources );
             papoSources = NULL;
             nSources = 0;
+            InvalidateSourceIndex();
         }
 
         for( int i = 0; i < CSLCount(papszNewMD); i++ )
@@ -1426,6 +1978,7 @@ int VRTSourcedRasterBand::CloseDependentDatasets()
     CPLFree( papoSources );
     papoSources = NULL;
     nSources = 0;
+    InvalidateSourceIndex();
 
     return TRUE;
 }
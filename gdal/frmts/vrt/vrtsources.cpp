@@ -92,6 +92,16 @@ VRTSimpleSource::VRTSimpleSource() :
     m_dfNoDataValue = VRT_NODATA_UNSET;
     m_bRelativeToVRTOri = -1;
     m_nMaxValue = 0;
+    m_bPendingOpen = FALSE;
+    m_nSrcBand = 0;
+    m_bGetMaskBand = FALSE;
+    m_nSrcRasterXSize = 0;
+    m_nSrcRasterYSize = 0;
+    m_eSrcDataType = GDT_Unknown;
+    m_nSrcBlockXSize = 0;
+    m_nSrcBlockYSize = 0;
+    m_bSrcShared = FALSE;
+    m_papszSrcOpenOptions = NULL;
 }
 
 /************************************************************************/
@@ -101,6 +111,9 @@ VRTSimpleSource::VRTSimpleSource() :
 VRTSimpleSource::VRTSimpleSource(const VRTSimpleSource* poSrcSource,
                                  double dfXDstRatio, double dfYDstRatio)
 {
+    // The copy shares the source band, so it must be opened now.
+    const_cast<VRTSimpleSource*>(poSrcSource)->OpenPendingSource();
+
     m_poRasterBand = poSrcSource->m_poRasterBand;
     m_poMaskBandMainBand = poSrcSource->m_poMaskBandMainBand;
     m_bNoDataSet = poSrcSource->m_bNoDataSet;
@@ -115,6 +128,16 @@ VRTSimpleSource::VRTSimpleSource(const VRTSimpleSource* poSrcSource,
     m_dfDstYSize = poSrcSource->m_dfDstYSize * dfYDstRatio;
     m_bRelativeToVRTOri = -1;
     m_nMaxValue = poSrcSource->m_nMaxValue;
+    m_bPendingOpen = FALSE;
+    m_nSrcBand = 0;
+    m_bGetMaskBand = FALSE;
+    m_nSrcRasterXSize = 0;
+    m_nSrcRasterYSize = 0;
+    m_eSrcDataType = GDT_Unknown;
+    m_nSrcBlockXSize = 0;
+    m_nSrcBlockYSize = 0;
+    m_bSrcShared = FALSE;
+    m_papszSrcOpenOptions = NULL;
 }
 
 /************************************************************************/
@@ -144,6 +167,51 @@ VRTSimpleSource::~VRTSimpleSource()
         else
             m_poRasterBand->GetDataset()->Dereference();
     }
+
+    CSLDestroy( m_papszSrcOpenOptions );
+}
+
+/************************************************************************/
+/*                         OpenPendingSource()                          */
+/*                                                                      */
+/*      Create the proxy dataset of a source whose opening has been     */
+/*      deferred by XMLInit(). Returns TRUE if a source band is         */
+/*      available.                                                      */
+/************************************************************************/
+
+int VRTSimpleSource::OpenPendingSource()
+
+{
+    if( !m_bPendingOpen )
+        return m_poRasterBand != NULL;
+    m_bPendingOpen = FALSE;
+
+    GDALProxyPoolDataset* proxyDS
+        = new GDALProxyPoolDataset( m_osSrcDSName,
+                                    m_nSrcRasterXSize, m_nSrcRasterYSize,
+                                    GA_ReadOnly, m_bSrcShared );
+    proxyDS->SetOpenOptions( m_papszSrcOpenOptions );
+    CSLDestroy( m_papszSrcOpenOptions );
+    m_papszSrcOpenOptions = NULL;
+
+    /* Only the information of rasterBand nSrcBand will be accurate */
+    /* but that's OK since we only use that band afterwards */
+    for( int i = 1; i <= m_nSrcBand; i++ )
+        proxyDS->AddSrcBandDescription( m_eSrcDataType, m_nSrcBlockXSize,
+                                        m_nSrcBlockYSize );
+    if( m_bGetMaskBand )
+        reinterpret_cast<GDALProxyPoolRasterBand*>(
+            proxyDS->GetRasterBand(m_nSrcBand) )->AddSrcMaskBandDescription(
+                m_eSrcDataType, m_nSrcBlockXSize, m_nSrcBlockYSize );
+
+    m_poRasterBand = proxyDS->GetRasterBand( m_nSrcBand );
+    if( m_bGetMaskBand )
+    {
+        m_poMaskBandMainBand = m_poRasterBand;
+        m_poRasterBand = m_poRasterBand->GetMaskBand();
+    }
+
+    return m_poRasterBand != NULL;
 }
 
 /************************************************************************/
@@ -164,6 +232,7 @@ void VRTSimpleSource::SetSrcBand( GDALRasterBand *poNewSrcBand )
 
 {
     m_poRasterBand = poNewSrcBand;
+    m_bPendingOpen = FALSE;
 }
 
 
@@ -177,6 +246,7 @@ void VRTSimpleSource::SetSrcMaskBand( GDALRasterBand *poNewSrcBand )
 {
     m_poRasterBand = poNewSrcBand->GetMaskBand();
     m_poMaskBandMainBand = poNewSrcBand;
+    m_bPendingOpen = FALSE;
 }
 
 /************************************************************************/
@@ -207,6 +277,28 @@ void VRTSimpleSource::SetDstWindow( double dfNewXOff, double dfNewYOff,
     m_dfDstYSize = dfNewYSize;
 }
 
+/************************************************************************/
+/*                            GetDstWindow()                            */
+/*                                                                      */
+/*      Returns FALSE if no destination window has been set, in which   */
+/*      case the source covers the whole band.                          */
+/************************************************************************/
+
+int VRTSimpleSource::GetDstWindow( double *pdfXOff, double *pdfYOff,
+                                   double *pdfXSize, double *pdfYSize ) const
+
+{
+    if( m_dfDstXOff == -1 && m_dfDstYOff == -1
+        && m_dfDstXSize == -1 && m_dfDstYSize == -1 )
+        return FALSE;
+
+    *pdfXOff = m_dfDstXOff;
+    *pdfYOff = m_dfDstYOff;
+    *pdfXSize = m_dfDstXSize;
+    *pdfYSize = m_dfDstYSize;
+    return TRUE;
+}
+
 /************************************************************************/
 /*                           SetNoDataValue()                           */
 /************************************************************************/
@@ -246,7 +338,7 @@ CPLXMLNode *VRTSimpleSource::SerializeToXML( const char *pszVRTPath )
     const char      *pszRelativePath;
     int              nBlockXSize, nBlockYSize;
 
-    if( m_poRasterBand == NULL )
+    if( !OpenPendingSource() )
         return NULL;
 
     GDALDataset     *poDS;
@@ -566,7 +658,6 @@ CPLErr VRTSimpleSource::XMLInit( CPLXMLNode *psSrc, const char *pszVRTPath )
     if( strstr(pszSrcDSName,"<VRTDataset") != NULL )
         papszOpenOptions = CSLSetNameValue(papszOpenOptions, "ROOT_PATH", pszVRTPath);
 
-    GDALDataset *poSrcDS;
     if (nRasterXSize == 0 || nRasterYSize == 0 || eDataType == (GDALDataType)-1 ||
         nBlockXSize == 0 || nBlockYSize == 0)
     {
@@ -576,52 +667,56 @@ CPLErr VRTSimpleSource::XMLInit( CPLXMLNode *psSrc, const char *pszVRTPath )
         int nOpenFlags = GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
         if( bShared )
             nOpenFlags |= GDAL_OF_SHARED;
-        poSrcDS = (GDALDataset *) GDALOpenEx(
+        GDALDataset *poSrcDS = (GDALDataset *) GDALOpenEx(
                     pszSrcDSName, nOpenFlags, NULL,
                     (const char* const* )papszOpenOptions, NULL );
-    }
-    else
-    {
-        /* -------------------------------------------------------------------- */
-        /*      Create a proxy dataset                                          */
-        /* -------------------------------------------------------------------- */
-        int i;
-        GDALProxyPoolDataset* proxyDS = new GDALProxyPoolDataset(pszSrcDSName, nRasterXSize, nRasterYSize, GA_ReadOnly, bShared);
-        proxyDS->SetOpenOptions(papszOpenOptions);
-        poSrcDS = proxyDS;
-
-        /* Only the information of rasterBand nSrcBand will be accurate */
-        /* but that's OK since we only use that band afterwards */
-        for(i=1;i<=nSrcBand;i++)
-            proxyDS->AddSrcBandDescription(eDataType, nBlockXSize, nBlockYSize);
-        if (bGetMaskBand)
-            ((GDALProxyPoolRasterBand*)proxyDS->GetRasterBand(nSrcBand))->AddSrcMaskBandDescription(eDataType, nBlockXSize, nBlockYSize);
-    }
 
-    CSLDestroy(papszOpenOptions);
+        CSLDestroy(papszOpenOptions);
 
-    CPLFree( pszSrcDSName );
+        CPLFree( pszSrcDSName );
 
-    if( poSrcDS == NULL )
-        return CE_Failure;
+        if( poSrcDS == NULL )
+            return CE_Failure;
 
 /* -------------------------------------------------------------------- */
 /*      Get the raster band.                                            */
 /* -------------------------------------------------------------------- */
 
-    m_poRasterBand = poSrcDS->GetRasterBand(nSrcBand);
-    if( m_poRasterBand == NULL )
-    {
-        if( poSrcDS->GetShared() )
-            GDALClose( (GDALDatasetH) poSrcDS );
-        return CE_Failure;
-    }
-    if (bGetMaskBand)
-    {
-        m_poMaskBandMainBand = m_poRasterBand;
-        m_poRasterBand = m_poRasterBand->GetMaskBand();
+        m_poRasterBand = poSrcDS->GetRasterBand(nSrcBand);
         if( m_poRasterBand == NULL )
+        {
+            if( poSrcDS->GetShared() )
+                GDALClose( (GDALDatasetH) poSrcDS );
             return CE_Failure;
+        }
+        if (bGetMaskBand)
+        {
+            m_poMaskBandMainBand = m_poRasterBand;
+            m_poRasterBand = m_poRasterBand->GetMaskBand();
+            if( m_poRasterBand == NULL )
+                return CE_Failure;
+        }
+    }
+    else
+    {
+        /* -------------------------------------------------------------------- */
+        /*      The proxy dataset will be created on first use of the source.   */
+        /*      This saves time and memory for VRTs with huge numbers of        */
+        /*      sources, most of which are never read.                          */
+        /* -------------------------------------------------------------------- */
+        m_bPendingOpen = TRUE;
+        m_osSrcDSName = pszSrcDSName;
+        m_nSrcBand = nSrcBand;
+        m_bGetMaskBand = bGetMaskBand;
+        m_nSrcRasterXSize = nRasterXSize;
+        m_nSrcRasterYSize = nRasterYSize;
+        m_eSrcDataType = eDataType;
+        m_nSrcBlockXSize = nBlockXSize;
+        m_nSrcBlockYSize = nBlockYSize;
+        m_bSrcShared = bShared;
+        m_papszSrcOpenOptions = papszOpenOptions;
+
+        CPLFree( pszSrcDSName );
     }
 
 /* -------------------------------------------------------------------- */
@@ -664,8 +759,14 @@ void VRTSimpleSource::GetFileList(char*** ppapszFileList, int *pnSize,
                                   int *pnMaxSize, CPLHashSet* hSetFiles)
 {
     const char* pszFilename;
-    if (m_poRasterBand != NULL && m_poRasterBand->GetDataset() != NULL &&
-        (pszFilename = m_poRasterBand->GetDataset()->GetDescription()) != NULL)
+    if( m_bPendingOpen )
+        pszFilename = m_osSrcDSName.c_str();
+    else if( m_poRasterBand != NULL && m_poRasterBand->GetDataset() != NULL )
+        pszFilename = m_poRasterBand->GetDataset()->GetDescription();
+    else
+        pszFilename = NULL;
+
+    if( pszFilename != NULL )
     {
 /* -------------------------------------------------------------------- */
 /*      Is the filename even a real filesystem object?                  */
@@ -716,6 +817,7 @@ void VRTSimpleSource::GetFileList(char*** ppapszFileList, int *pnSize,
 
 GDALRasterBand* VRTSimpleSource::GetBand()
 {
+    OpenPendingSource();
     return m_poMaskBandMainBand ? NULL : m_poRasterBand;
 }
 
@@ -735,11 +837,44 @@ int VRTSimpleSource::IsSameExceptBandNumber(VRTSimpleSource* poOtherSource)
            m_dfDstYSize == poOtherSource->m_dfDstYSize &&
            m_bNoDataSet == poOtherSource->m_bNoDataSet &&
            m_dfNoDataValue == poOtherSource->m_dfNoDataValue &&
-           GetBand() != NULL && poOtherSource->GetBand() != NULL &&
-           GetBand()->GetDataset() != NULL &&
-           poOtherSource->GetBand()->GetDataset() != NULL &&
-           EQUAL(GetBand()->GetDataset()->GetDescription(),
-                 poOtherSource->GetBand()->GetDataset()->GetDescription());
+           GetSrcDatasetName() != NULL &&
+           poOtherSource->GetSrcDatasetName() != NULL &&
+           EQUAL(GetSrcDatasetName(), poOtherSource->GetSrcDatasetName());
+}
+
+/************************************************************************/
+/*                         IsBandOfSrcDataset()                         */
+/*                                                                      */
+/*      Returns TRUE if the source is band nBand of its dataset (and    */
+/*      not a mask band). Deferred sources are not opened.              */
+/************************************************************************/
+
+int VRTSimpleSource::IsBandOfSrcDataset( int nBand )
+{
+    if( m_bPendingOpen )
+        return !m_bGetMaskBand && m_nSrcBand == nBand;
+
+    if( m_poMaskBandMainBand != NULL || m_poRasterBand == NULL )
+        return FALSE;
+    GDALDataset* poDS = m_poRasterBand->GetDataset();
+    return poDS != NULL && poDS->GetRasterCount() >= nBand &&
+           poDS->GetRasterBand(nBand) == m_poRasterBand;
+}
+
+/************************************************************************/
+/*                         GetSrcDatasetName()                          */
+/*                                                                      */
+/*      Returns the name of the source dataset, or NULL. Deferred       */
+/*      sources are not opened.                                         */
+/************************************************************************/
+
+const char* VRTSimpleSource::GetSrcDatasetName()
+{
+    if( m_bPendingOpen )
+        return m_osSrcDSName.c_str();
+    if( m_poRasterBand == NULL || m_poRasterBand->GetDataset() == NULL )
+        return NULL;
+    return m_poRasterBand->GetDataset()->GetDescription();
 }
 
 /************************************************************************/
@@ -811,6 +946,9 @@ VRTSimpleSource::GetSrcDstWindow( int nXOff, int nYOff, int nXSize, int nYSize,
             return FALSE;
     }
 
+    if( !OpenPendingSource() )
+        return FALSE;
+
 /* -------------------------------------------------------------------- */
 /*      This request window corresponds to the whole output buffer.     */
 /* -------------------------------------------------------------------- */
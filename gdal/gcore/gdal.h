@@ -242,6 +242,9 @@ typedef void *GDALRasterAttributeTableH;
 /** Opaque type used for the C bindings of the C++ GDALAsyncReader class */
 typedef void *GDALAsyncReaderH;
 
+/** Opaque type used for the C bindings of the C++ GDALPrefetchRequest class */
+typedef void *GDALPrefetchRequestH;
+
 /** Type to express pixel, line or band spacing. Signed 64 bit integer. */
 typedef GIntBig GSpacing;
 
@@ -571,6 +574,25 @@ GDALBeginAsyncReader(GDALDatasetH hDS, int nXOff, int nYOff,
 void  CPL_DLL CPL_STDCALL 
 GDALEndAsyncReader(GDALDatasetH hDS, GDALAsyncReaderH hAsynchReaderH);
 
+/** Callback of GDALDatasetBeginPrefetch(), called from a background thread
+    once the blocks of the window of index iWindow have been loaded */
+typedef void (CPL_STDCALL *GDALPrefetchCallback)( GDALDatasetH hDS,
+                                                  int iWindow,
+                                                  CPLErr eErr,
+                                                  void *pCallbackData );
+
+GDALPrefetchRequestH CPL_DLL CPL_STDCALL
+GDALDatasetBeginPrefetch( GDALDatasetH hDS, int nWindowCount,
+                          const int *panWindows,
+                          int nBandCount, int *panBandMap,
+                          GDALPrefetchCallback pfnCallback,
+                          void *pCallbackData,
+                          char **papszOptions ) CPL_WARN_UNUSED_RESULT;
+int CPL_DLL CPL_STDCALL
+GDALPrefetchRequestWait( GDALPrefetchRequestH hRequest, double dfTimeout );
+void CPL_DLL CPL_STDCALL
+GDALDatasetEndPrefetch( GDALDatasetH hDS, GDALPrefetchRequestH hRequest );
+
 CPLErr CPL_DLL CPL_STDCALL GDALDatasetRasterIO( 
     GDALDatasetH hDS, GDALRWFlag eRWFlag,
     int nDSXOff, int nDSYOff, int nDSXSize, int nDSYSize,
@@ -1061,6 +1083,56 @@ GIntBig CPL_DLL CPL_STDCALL GDALGetCacheUsed64(void);
 
 int CPL_DLL CPL_STDCALL GDALFlushCacheBlock(void);
 
+/*! Hint on how the blocks of a dataset should be kept in the block cache */
+typedef enum {
+    /*! Regular least-recently-used eviction */  GBCP_Normal = 0,
+    /*! Blocks are read once: evicted before the ones of other datasets */
+                                                 GBCP_Streaming = 1,
+    /*! Blocks are frequently accessed: evicted after the ones of other datasets */
+                                                 GBCP_Hot = 2
+} GDALBlockCachePriority;
+
+void CPL_DLL CPL_STDCALL GDALDatasetSetBlockCacheMax( GDALDatasetH, GIntBig nBytes );
+GIntBig CPL_DLL CPL_STDCALL GDALDatasetGetBlockCacheMax( GDALDatasetH );
+GIntBig CPL_DLL CPL_STDCALL GDALDatasetGetBlockCacheUsed( GDALDatasetH );
+void CPL_DLL CPL_STDCALL GDALDatasetSetBlockCachePriority( GDALDatasetH,
+                                                  GDALBlockCachePriority );
+GDALBlockCachePriority CPL_DLL CPL_STDCALL
+                         GDALDatasetGetBlockCachePriority( GDALDatasetH );
+
+/*! Statistics on the block cache, see GDALGetBlockCacheStatistics() */
+typedef struct
+{
+    /*! Number of block requests served from the cache */
+    GIntBig nHits;
+    /*! Number of blocks that had to be loaded in the cache */
+    GIntBig nMisses;
+    /*! Number of bytes of the blocks read from the drivers */
+    GIntBig nBytesRead;
+    /*! Number of blocks evicted to make room for other blocks */
+    GIntBig nEvictions;
+    /*! Number of evicted blocks that were dirty and had to be written */
+    GIntBig nDirtyFlushes;
+    /*! Memory currently used by the cached blocks, in bytes */
+    GIntBig nCacheUsed;
+    /*! Maximum memory used by the cached blocks, in bytes */
+    GIntBig nCacheHighWaterMark;
+    /*! Number of times a lock of the block cache was taken (global only) */
+    GIntBig nLockAcquisitions;
+    /*! Number of times a thread had to wait for such a lock (global only) */
+    GIntBig nLockContentions;
+    /*! Time spent waiting for such locks, in seconds (global only) */
+    double  dfLockWaitTime;
+} GDALBlockCacheStatistics;
+
+void CPL_DLL CPL_STDCALL GDALGetBlockCacheStatistics(
+                                        GDALBlockCacheStatistics* psStats );
+void CPL_DLL CPL_STDCALL GDALResetBlockCacheStatistics( void );
+void CPL_DLL CPL_STDCALL GDALDatasetGetBlockCacheStatistics(
+                        GDALDatasetH, GDALBlockCacheStatistics* psStats );
+void CPL_DLL CPL_STDCALL GDALGetRasterBandBlockCacheStatistics(
+                        GDALRasterBandH, GDALBlockCacheStatistics* psStats );
+
 /* ==================================================================== */
 /*      GDAL virtual memory                                             */
 /* ==================================================================== */
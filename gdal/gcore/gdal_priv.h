@@ -44,6 +44,7 @@ class GDALRasterAttributeTable;
 class GDALProxyDataset;
 class GDALProxyRasterBand;
 class GDALAsyncReader;
+class GDALPrefetchRequest;
 
 /* -------------------------------------------------------------------- */
 /*      Pull in the public declarations.  This gets the C apis, and     */
@@ -389,6 +390,8 @@ class CPL_DLL GDALDataset : public GDALMajorObject
     char            **papszOpenOptions;
 
     friend class GDALRasterBand;
+    friend class GDALDefaultAsyncReader;
+    friend class GDALPrefetchRequest;
 
     int                 EnterReadWrite(GDALRWFlag eRWFlag);
     void                LeaveReadWrite();
@@ -447,6 +450,14 @@ class CPL_DLL GDALDataset : public GDALMajorObject
                          char **papszOptions);
     virtual void EndAsyncReader(GDALAsyncReader *);
 
+    GDALPrefetchRequest* BeginPrefetch( int nWindowCount,
+                                        const int* panWindows,
+                                        int nBandCount, int* panBandMap,
+                                        GDALPrefetchCallback pfnCallback,
+                                        void* pCallbackData,
+                                        char** papszOptions );
+    void        EndPrefetch( GDALPrefetchRequest* poRequest );
+
     CPLErr      RasterIO( GDALRWFlag, int, int, int, int,
                           void *, int, int, GDALDataType,
                           int, int *, GSpacing, GSpacing, GSpacing,
@@ -474,9 +485,25 @@ class CPL_DLL GDALDataset : public GDALMajorObject
 
     void ReportError(CPLErr eErrClass, CPLErrorNum err_no, const char *fmt, ...)  CPL_PRINT_FUNC_FORMAT (4, 5);
 
+    void        SetBlockCacheMax( GIntBig nBytes );
+    GIntBig     GetBlockCacheMax() const;
+    GIntBig     GetBlockCacheUsed() const;
+    void        SetBlockCachePriority( GDALBlockCachePriority ePriority );
+    GDALBlockCachePriority GetBlockCachePriority() const;
+    void        GetBlockCacheStatistics( GDALBlockCacheStatistics* psStats ) const;
+
 private:
     void           *m_hPrivateData;
 
+    friend class GDALRasterBlock;
+    GDALBlockCacheStatistics* GetBlockCacheStatisticsRef();
+
+    bool            RegisterAsyncRequest();
+    void            UnregisterAsyncRequest();
+    bool            RegisterPrefetchWindow( const char* pszKey );
+    void            UnregisterPrefetchWindow( const char* pszKey );
+    CPLMutex*       GetReadWriteMutex();
+
     OGRLayer*       BuildLayerFromSelectInfo(swq_select* psSelectInfo,
                                              OGRGeometry *poSpatialFilter,
                                              const char *pszDialect,
@@ -581,11 +608,26 @@ class CPL_DLL GDALRasterBlock
 
     int                  bMustDetach;
 
+    int                  nCacheShard;
+    int                  nTouchStamp;
+    int                  nCacheRank;
+
     void        Detach_unlocked( void );
     void        Touch_unlocked( void );
+    void        UpdateCacheUsed_unlocked( GIntBig nDelta );
+    GDALBlockCacheStatistics* GetDatasetCacheStatistics();
+    GDALBlockCacheStatistics* GetBandCacheStatistics();
+    void        RecordEviction_unlocked();
 
     void        RecycleFor( int nXOffIn, int nYOffIn );
 
+    static int  DetachBlocksToEvict( int iShard, GDALDataset* poQuotaDS,
+                                     int nMaxRank, GIntBig nTargetUsage,
+                                     GDALRasterBlock** papoBlocks,
+                                     bool* pbExhausted );
+    static void FreeEvictedBlocks( GDALRasterBlock** papoBlocks, int nBlocks,
+                                   int nSizeInBytes, void** ppNewData );
+
   public:
                 GDALRasterBlock( GDALRasterBand *, int, int );
                 GDALRasterBlock( int nXOffIn, int nYOffIn ); /* only for lookup purpose */
@@ -613,6 +655,7 @@ class CPL_DLL GDALRasterBlock
 
     int          TakeLock();
     int          DropLockForRemovalFromStorage();
+    void         RecordBlockRead();
 
     /// @brief Accessor to source GDALRasterBand object.
     /// @return source raster band of the raster block.
@@ -622,6 +665,12 @@ class CPL_DLL GDALRasterBlock
     static int  FlushCacheBlock(int bDirtyBlocksOnly = FALSE);
     static void Verify();
 
+    static void GetLockStatistics( GIntBig* pnAcquisitions,
+                                   GIntBig* pnContentions,
+                                   double* pdfWaitTime );
+    static void GetCacheStatistics( GDALBlockCacheStatistics* psStats );
+    static void ResetCacheStatistics();
+
 #ifdef notdef
     static void CheckNonOrphanedBlocks(GDALRasterBand* poBand);
     void        DumpBlock();
@@ -683,6 +732,10 @@ class CPL_DLL GDALAbstractBandBlockCache
         CPLMutex         *hCondMutex;
         volatile int      nKeepAliveCounter;
 
+        // Statistics of the blocks of the band, updated by GDALRasterBlock
+        // with the lock of the cache shard of the band held
+        GDALBlockCacheStatistics sStats;
+
     protected:
         GDALRasterBand   *poBand;
 
@@ -696,6 +749,7 @@ class CPL_DLL GDALAbstractBandBlockCache
 
             GDALRasterBlock* CreateBlock(int nXBlockOff, int nYBlockOff);
             void             AddBlockToFreeList( GDALRasterBlock * );
+            GDALBlockCacheStatistics* GetStatisticsRef() { return &sStats; }
 
             virtual int              Init() = 0;
             virtual int              IsInitOK() = 0;
@@ -828,6 +882,7 @@ class CPL_DLL GDALRasterBand : public GDALMajorObject
     GDALRasterBlock *GetLockedBlockRef( int nXBlockOff, int nYBlockOff, 
                                         int bJustInitialize = FALSE ) CPL_WARN_UNUSED_RESULT;
     CPLErr      FlushBlock( int, int, int bWriteDirtyBlock = TRUE );
+    void        GetBlockCacheStatistics( GDALBlockCacheStatistics* psStats ) const;
 
     unsigned char*  GetIndexColorTranslationTo(/* const */ GDALRasterBand* poReferenceBand,
                                                unsigned char* pTranslationTable = NULL,
@@ -1183,6 +1238,62 @@ class CPL_DLL GDALAsyncReader
     virtual void UnlockBuffer();
 };
 
+/* ******************************************************************** */
+/*                        GDALPrefetchRequest                           */
+/* ******************************************************************** */
+
+/**
+ * Class used as a session object for requests loading windows of a
+ * dataset into the block cache in a background thread.  They are created
+ * with GDALDataset::BeginPrefetch(), and destroyed with
+ * GDALDataset::EndPrefetch().
+ *
+ * @since GDAL 2.1
+ */
+class CPL_DLL GDALPrefetchRequest
+{
+    friend class GDALDataset;
+
+    GDALDataset*          poDS;
+    int                   nWindowCount;
+    int*                  panWindows;
+    int                   nBandCount;
+    int*                  panBandMap;
+    GDALPrefetchCallback  pfnCallback;
+    void*                 pCallbackData;
+
+    // Windows identical to a previous one of the request, not loaded again
+    GByte*                pabyDuplicateWindows;
+    // Windows registered with GDALDataset::RegisterPrefetchWindow()
+    char**                papszRegisteredWindows;
+    bool                  bRegistered;
+
+    CPLJoinableThread*    hThread;
+    CPLMutex*             hMutex;
+    CPLCond*              hCond;
+    volatile int          nCompletedWindows;
+    volatile int          bStop;
+    CPLErr                eErr;
+
+    GDALPrefetchRequest( GDALDataset* poDS, int nWindowCount,
+                         const int* panWindows,
+                         int nBandCount, const int* panBandMap,
+                         GDALPrefetchCallback pfnCallback,
+                         void* pCallbackData );
+    ~GDALPrefetchRequest();
+
+    bool            Start( char** papszOptions );
+    void            Stop();
+    CPLString       GetWindowKey( int iWindow ) const;
+    static void     ThreadFunction( void* pData );
+    CPLErr          LoadWindow( int iWindow );
+
+  public:
+    int             Wait( double dfTimeout = -1.0 );
+    int             GetCompletedWindowCount();
+    CPLErr          GetLastErr();
+};
+
 /* ==================================================================== */
 /*      An assortment of overview related stuff.                        */
 /* ==================================================================== */
@@ -391,6 +391,10 @@ void CPL_DLL GDALProxyPoolDatasetAddSrcBandDescription( GDALProxyPoolDatasetH hP
                                                         GDALDataType eDataType,
                                                         int nBlockXSize, int nBlockYSize);
 
+void CPL_DLL GDALProxyPoolGetStatistics( GIntBig* pnHits, GIntBig* pnOpens,
+                                         GIntBig* pnCloses,
+                                         GIntBig* pnEvictions );
+
 CPL_C_END
 
 #endif /* GDAL_PROXY_H_INCLUDED */
@@ -49,6 +49,7 @@ GDALAbstractBandBlockCache::GDALAbstractBandBlockCache(GDALRasterBand* poBandIn)
     nKeepAliveCounter(0)
 {
     poBand = poBandIn;
+    memset(&sStats, 0, sizeof(sStats));
     if( hCondMutex )
         CPLReleaseMutex(hCondMutex);
 }
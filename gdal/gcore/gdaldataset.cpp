@@ -61,10 +61,35 @@ GDALGetDefaultAsyncReader( GDALDataset *poDS,
                              int nBandSpace, char **papszOptions);
 CPL_C_END
 
+/* State shared by the asynchronous readers and prefetch requests of a */
+/* dataset. Created by the first one and destroyed with the last one, */
+/* under the protection of hDLMutex */
+typedef struct
+{
+    /* Number of asynchronous readers and prefetch requests whose */
+    /* background thread may access the dataset */
+    int                  nPendingRequests;
+
+    /* Serializes the accesses to a dataset opened in read-only mode. */
+    /* In update mode, the mutex of GDALDatasetPrivate is used */
+    CPLMutex            *hMutex;
+
+    /* Windows passed to AdviseRead() by the pending prefetch requests, */
+    /* with the number of requests they are pending in */
+    std::map<CPLString, int> oMapPendingWindows;
+} GDALDatasetAsyncState;
+
 typedef struct
 {
     CPLMutex* hMutex;
     int       nMutexTakenCount;
+
+    GIntBig                  nBlockCacheMax;
+    GDALBlockCacheStatistics sBlockCacheStats;
+    GDALBlockCachePriority   eBlockCachePriority;
+
+    /* Non NULL while asynchronous requests are pending */
+    GDALDatasetAsyncState * volatile psAsyncState;
 } GDALDatasetPrivate;
 
 typedef struct
@@ -207,6 +232,8 @@ void GDALDataset::Init(int bForceCachedIOIn)
 
     m_poStyleTable = NULL;
     m_hPrivateData = VSI_CALLOC_VERBOSE(1, sizeof(GDALDatasetPrivate));
+    if( m_hPrivateData != NULL )
+        ((GDALDatasetPrivate* )m_hPrivateData)->eBlockCachePriority = GBCP_Normal;
 }
 
 /************************************************************************/
@@ -410,6 +437,310 @@ void CPL_STDCALL GDALFlushCache( GDALDatasetH hDS )
     ((GDALDataset *) hDS)->FlushCache();
 }
 
+/************************************************************************/
+/*                          SetBlockCacheMax()                          */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum block cache memory of this dataset.
+ *
+ * By default, the blocks of all datasets share the global block cache
+ * (see GDALSetCacheMax64()). This method sets an additional budget for
+ * the blocks of the bands of this dataset: when loading a new block would
+ * make them exceed it, the least recently used blocks of this dataset are
+ * evicted first, instead of the ones of other datasets. This is useful to
+ * prevent a large processing job from evicting the blocks that other
+ * datasets of the process frequently access.
+ *
+ * The budget is enforced when new blocks are loaded in the cache, so
+ * lowering it does not immediately release memory (use FlushCache() for
+ * that).
+ *
+ * This method is the same as the C function GDALDatasetSetBlockCacheMax().
+ *
+ * @param nBytes the maximum number of bytes for the blocks of this dataset,
+ *               or 0 for no limit other than the global one.
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALDataset::SetBlockCacheMax( GIntBig nBytes )
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    if( psPrivate != NULL )
+        psPrivate->nBlockCacheMax = (nBytes > 0) ? nBytes : 0;
+}
+
+/************************************************************************/
+/*                          GetBlockCacheMax()                          */
+/************************************************************************/
+
+/**
+ * \brief Get the maximum block cache memory of this dataset.
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheMax().
+ *
+ * @return the budget in bytes, or 0 if the dataset has no specific limit.
+ *
+ * @since GDAL 2.1
+ */
+
+GIntBig GDALDataset::GetBlockCacheMax() const
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    return psPrivate != NULL ? psPrivate->nBlockCacheMax : 0;
+}
+
+/************************************************************************/
+/*                         GetBlockCacheUsed()                          */
+/************************************************************************/
+
+/**
+ * \brief Get the block cache memory used by this dataset.
+ *
+ * This method is the same as the C function GDALDatasetGetBlockCacheUsed().
+ *
+ * @return the number of bytes of the cached blocks of the bands of this
+ * dataset.
+ *
+ * @since GDAL 2.1
+ */
+
+GIntBig GDALDataset::GetBlockCacheUsed() const
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    return psPrivate != NULL ? psPrivate->sBlockCacheStats.nCacheUsed : 0;
+}
+
+/************************************************************************/
+/*                     GetBlockCacheStatisticsRef()                     */
+/************************************************************************/
+
+/* Only used by GDALRasterBlock, with the lock of the cache shard of */
+/* the dataset held, to update the statistics */
+GDALBlockCacheStatistics* GDALDataset::GetBlockCacheStatisticsRef()
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    return psPrivate != NULL ? &(psPrivate->sBlockCacheStats) : NULL;
+}
+
+/************************************************************************/
+/*                      GetBlockCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Get statistics on the cached blocks of this dataset.
+ *
+ * The counters cover the blocks of all the bands of the dataset (but not
+ * of its overviews or mask bands when they are implemented by another
+ * dataset) since it has been opened. The lock related members of the
+ * structure are set to 0: use GDALGetBlockCacheStatistics() for them.
+ *
+ * This method is the same as the C function
+ * GDALDatasetGetBlockCacheStatistics().
+ *
+ * @param psStats the structure to fill.
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALDataset::GetBlockCacheStatistics(
+                                GDALBlockCacheStatistics* psStats ) const
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    if( psPrivate != NULL )
+        *psStats = psPrivate->sBlockCacheStats;
+    else
+        memset(psStats, 0, sizeof(GDALBlockCacheStatistics));
+}
+
+/************************************************************************/
+/*                 GDALDatasetGetBlockCacheStatistics()                 */
+/************************************************************************/
+
+/**
+ * \brief Get statistics on the cached blocks of a dataset.
+ *
+ * @see GDALDataset::GetBlockCacheStatistics()
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALDatasetGetBlockCacheStatistics(
+                    GDALDatasetH hDS, GDALBlockCacheStatistics* psStats )
+
+{
+    VALIDATE_POINTER0( hDS, "GDALDatasetGetBlockCacheStatistics" );
+    VALIDATE_POINTER0( psStats, "GDALDatasetGetBlockCacheStatistics" );
+
+    ((GDALDataset *) hDS)->GetBlockCacheStatistics( psStats );
+}
+
+/************************************************************************/
+/*                     GDALDatasetSetBlockCacheMax()                    */
+/************************************************************************/
+
+/**
+ * \brief Set the maximum block cache memory of a dataset.
+ *
+ * @see GDALDataset::SetBlockCacheMax()
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALDatasetSetBlockCacheMax( GDALDatasetH hDS,
+                                              GIntBig nBytes )
+
+{
+    VALIDATE_POINTER0( hDS, "GDALDatasetSetBlockCacheMax" );
+
+    ((GDALDataset *) hDS)->SetBlockCacheMax( nBytes );
+}
+
+/************************************************************************/
+/*                     GDALDatasetGetBlockCacheMax()                    */
+/************************************************************************/
+
+/**
+ * \brief Get the maximum block cache memory of a dataset.
+ *
+ * @see GDALDataset::GetBlockCacheMax()
+ *
+ * @return the budget in bytes, or 0 if the dataset has no specific limit.
+ *
+ * @since GDAL 2.1
+ */
+
+GIntBig CPL_STDCALL GDALDatasetGetBlockCacheMax( GDALDatasetH hDS )
+
+{
+    VALIDATE_POINTER1( hDS, "GDALDatasetGetBlockCacheMax", 0 );
+
+    return ((GDALDataset *) hDS)->GetBlockCacheMax();
+}
+
+/************************************************************************/
+/*                    GDALDatasetGetBlockCacheUsed()                    */
+/************************************************************************/
+
+/**
+ * \brief Get the block cache memory used by a dataset.
+ *
+ * @see GDALDataset::GetBlockCacheUsed()
+ *
+ * @return the number of bytes of the cached blocks of the bands of the
+ * dataset.
+ *
+ * @since GDAL 2.1
+ */
+
+GIntBig CPL_STDCALL GDALDatasetGetBlockCacheUsed( GDALDatasetH hDS )
+
+{
+    VALIDATE_POINTER1( hDS, "GDALDatasetGetBlockCacheUsed", 0 );
+
+    return ((GDALDataset *) hDS)->GetBlockCacheUsed();
+}
+
+/************************************************************************/
+/*                       SetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ * \brief Set the block cache priority of this dataset.
+ *
+ * When the global block cache is full, the blocks of GBCP_Streaming datasets
+ * are evicted before the ones of GBCP_Normal datasets, which are evicted
+ * before the ones of GBCP_Hot datasets. Within a priority, the least
+ * recently used blocks are evicted first.
+ *
+ * GBCP_Streaming is intended for datasets whose blocks are read once, for
+ * example the source of a gdal_translate or gdalwarp job, so that they do
+ * not evict the blocks of latency-sensitive readers in the same process.
+ *
+ * This method is the same as the C function
+ * GDALDatasetSetBlockCachePriority().
+ *
+ * @param ePriority the new priority.
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALDataset::SetBlockCachePriority( GDALBlockCachePriority ePriority )
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    if( psPrivate != NULL )
+        psPrivate->eBlockCachePriority = ePriority;
+}
+
+/************************************************************************/
+/*                       GetBlockCachePriority()                        */
+/************************************************************************/
+
+/**
+ * \brief Get the block cache priority of this dataset.
+ *
+ * This method is the same as the C function
+ * GDALDatasetGetBlockCachePriority().
+ *
+ * @since GDAL 2.1
+ */
+
+GDALBlockCachePriority GDALDataset::GetBlockCachePriority() const
+
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    return psPrivate != NULL ? psPrivate->eBlockCachePriority : GBCP_Normal;
+}
+
+/************************************************************************/
+/*                  GDALDatasetSetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ * \brief Set the block cache priority of a dataset.
+ *
+ * @see GDALDataset::SetBlockCachePriority()
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALDatasetSetBlockCachePriority(
+                        GDALDatasetH hDS, GDALBlockCachePriority ePriority )
+
+{
+    VALIDATE_POINTER0( hDS, "GDALDatasetSetBlockCachePriority" );
+
+    ((GDALDataset *) hDS)->SetBlockCachePriority( ePriority );
+}
+
+/************************************************************************/
+/*                  GDALDatasetGetBlockCachePriority()                  */
+/************************************************************************/
+
+/**
+ * \brief Get the block cache priority of a dataset.
+ *
+ * @see GDALDataset::GetBlockCachePriority()
+ *
+ * @since GDAL 2.1
+ */
+
+GDALBlockCachePriority CPL_STDCALL
+                    GDALDatasetGetBlockCachePriority( GDALDatasetH hDS )
+
+{
+    VALIDATE_POINTER1( hDS, "GDALDatasetGetBlockCachePriority", GBCP_Normal );
+
+    return ((GDALDataset *) hDS)->GetBlockCachePriority();
+}
+
 /************************************************************************/
 /*                        BlockBasedFlushCache()                        */
 /*                                                                      */
@@ -3228,6 +3559,178 @@ void CPL_STDCALL GDALEndAsyncReader(GDALDatasetH hDS, GDALAsyncReaderH hAsyncRea
     ((GDALDataset *) hDS) -> EndAsyncReader((GDALAsyncReader *)hAsyncReaderH);	
 }
 
+/************************************************************************/
+/*                           BeginPrefetch()                            */
+/************************************************************************/
+
+/**
+ * \brief Load windows of the dataset into the block cache in the background.
+ *
+ * This method passes the windows to AdviseRead(), and starts a background
+ * thread that, for each window in turn, reads all the blocks of the
+ * requested bands intersecting it into the block cache, so that subsequent
+ * RasterIO() requests on those windows are served from memory. This allows
+ * an application to overlap the reading and decoding of the next window
+ * with the processing of the current one.
+ *
+ * A window is advised only once while it is pending, even if it is repeated
+ * in the list or in other pending requests on the dataset, and repeated
+ * windows of a request are only loaded once.
+ *
+ * While the request is pending, the accesses to the dataset made through
+ * RasterIO() and ReadBlock() are serialized with the ones of the background
+ * thread. Other accesses to the dataset, from any thread, should be avoided.
+ * The block cache should be large enough to hold the blocks of the windows
+ * that have been prefetched but not yet used, otherwise they may be evicted
+ * before being used.
+ *
+ * The session object must be destroyed with EndPrefetch() before the dataset
+ * is closed, and not while other threads access the dataset.
+ *
+ * This method is the same as the C function GDALDatasetBeginPrefetch().
+ *
+ * @param nWindowCount number of windows.
+ * @param panWindows array of 4 * nWindowCount values, with the pixel offset,
+ * line offset, width and height of each window.
+ * @param nBandCount the number of bands to load, or 0 for all bands.
+ * @param panBandMap the list of nBandCount band numbers (1-based), or NULL
+ * to select the first nBandCount bands.
+ * @param pfnCallback function called from the background thread once each
+ * window has been loaded, or NULL.
+ * @param pCallbackData user data passed to pfnCallback.
+ * @param papszOptions options passed to AdviseRead(), or NULL.
+ *
+ * @return the session object, or NULL in case of error.
+ *
+ * @since GDAL 2.1
+ */
+
+GDALPrefetchRequest* GDALDataset::BeginPrefetch( int nWindowCount,
+                                                 const int* panWindows,
+                                                 int nBandCount,
+                                                 int* panBandMap,
+                                                 GDALPrefetchCallback pfnCallback,
+                                                 void* pCallbackData,
+                                                 char** papszOptions )
+{
+    if( nWindowCount < 0 || (nWindowCount > 0 && panWindows == NULL) )
+    {
+        ReportError( CE_Failure, CPLE_IllegalArg,
+                     "Invalid window list in BeginPrefetch()" );
+        return NULL;
+    }
+    if( nBandCount == 0 )
+        nBandCount = GetRasterCount();
+    if( nBandCount < 0 || nBandCount > GetRasterCount() )
+    {
+        ReportError( CE_Failure, CPLE_IllegalArg,
+                     "Invalid band count in BeginPrefetch()" );
+        return NULL;
+    }
+
+    for( int i = 0; i < nWindowCount; i++ )
+    {
+        const int* panWindow = panWindows + 4 * i;
+        if( panWindow[0] < 0 || panWindow[1] < 0 ||
+            panWindow[2] < 1 || panWindow[3] < 1 ||
+            panWindow[2] > nRasterXSize - panWindow[0] ||
+            panWindow[3] > nRasterYSize - panWindow[1] )
+        {
+            ReportError( CE_Failure, CPLE_IllegalArg,
+                         "Window %d (%d,%d,%d,%d) of BeginPrefetch() "
+                         "is out of the raster",
+                         i, panWindow[0], panWindow[1],
+                         panWindow[2], panWindow[3] );
+            return NULL;
+        }
+    }
+
+    GDALPrefetchRequest* poRequest =
+        new GDALPrefetchRequest( this, nWindowCount, panWindows,
+                                 nBandCount, panBandMap,
+                                 pfnCallback, pCallbackData );
+    if( !poRequest->Start( papszOptions ) )
+    {
+        delete poRequest;
+        return NULL;
+    }
+    return poRequest;
+}
+
+/************************************************************************/
+/*                      GDALDatasetBeginPrefetch()                      */
+/************************************************************************/
+
+/**
+ * \brief Load windows of the dataset into the block cache in the background.
+ *
+ * @see GDALDataset::BeginPrefetch()
+ *
+ * @since GDAL 2.1
+ */
+
+GDALPrefetchRequestH CPL_STDCALL
+GDALDatasetBeginPrefetch( GDALDatasetH hDS, int nWindowCount,
+                          const int *panWindows,
+                          int nBandCount, int *panBandMap,
+                          GDALPrefetchCallback pfnCallback,
+                          void *pCallbackData,
+                          char **papszOptions )
+
+{
+    VALIDATE_POINTER1( hDS, "GDALDatasetBeginPrefetch", NULL );
+
+    return (GDALPrefetchRequestH)((GDALDataset *) hDS)->
+        BeginPrefetch( nWindowCount, panWindows, nBandCount, panBandMap,
+                       pfnCallback, pCallbackData, papszOptions );
+}
+
+/************************************************************************/
+/*                            EndPrefetch()                             */
+/************************************************************************/
+
+/**
+ * \brief End a prefetch request.
+ *
+ * The windows whose loading has not started yet are skipped, the end of
+ * the loading of the current one is waited for, and the resources of the
+ * request are released.
+ *
+ * This method is the same as the C function GDALDatasetEndPrefetch().
+ *
+ * @param poRequest the object returned by BeginPrefetch().
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALDataset::EndPrefetch( GDALPrefetchRequest* poRequest )
+
+{
+    delete poRequest;
+}
+
+/************************************************************************/
+/*                       GDALDatasetEndPrefetch()                       */
+/************************************************************************/
+
+/**
+ * \brief End a prefetch request.
+ *
+ * @see GDALDataset::EndPrefetch()
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALDatasetEndPrefetch( GDALDatasetH hDS,
+                                         GDALPrefetchRequestH hRequest )
+
+{
+    VALIDATE_POINTER0( hDS, "GDALDatasetEndPrefetch" );
+    VALIDATE_POINTER0( hRequest, "GDALDatasetEndPrefetch" );
+
+    ((GDALDataset *) hDS)->EndPrefetch( (GDALPrefetchRequest *) hRequest );
+}
+
 /************************************************************************/
 /*                       CloseDependentDatasets()                       */
 /************************************************************************/
@@ -6041,7 +6544,16 @@ OGRErr GDALDatasetRollbackTransaction(GDALDatasetH hDS)
 int GDALDataset::EnterReadWrite(GDALRWFlag eRWFlag)
 {
     GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
-    if( psPrivate != NULL && eAccess == GA_Update && (eRWFlag == GF_Write || psPrivate->hMutex != NULL) )
+    if( psPrivate != NULL && eAccess != GA_Update &&
+        psPrivate->psAsyncState != NULL )
+    {
+        // Read-only dataset accessed by the thread of an asynchronous request
+        CPLAcquireMutex(psPrivate->psAsyncState->hMutex, 1000.0);
+        psPrivate->nMutexTakenCount ++;
+        return TRUE;
+    }
+    if( psPrivate != NULL && eAccess == GA_Update &&
+        (eRWFlag == GF_Write || psPrivate->hMutex != NULL) )
     {
         // There should be no race related to creating this mutex since
         // it should be first created through IWriteBlock() / IRasterIO()
@@ -6066,10 +6578,23 @@ void GDALDataset::LeaveReadWrite()
     if( psPrivate )
     {
         psPrivate->nMutexTakenCount --;
-        CPLReleaseMutex(psPrivate->hMutex);
+        CPLReleaseMutex(GetReadWriteMutex());
     }
 }
 
+/************************************************************************/
+/*                         GetReadWriteMutex()                          */
+/************************************************************************/
+
+/* Returns the mutex taken by EnterReadWrite() */
+CPLMutex* GDALDataset::GetReadWriteMutex()
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    if( eAccess != GA_Update && psPrivate->psAsyncState != NULL )
+        return psPrivate->psAsyncState->hMutex;
+    return psPrivate->hMutex;
+}
+
 /************************************************************************/
 /*                      TemporarilyDropReadWriteLock()                  */
 /************************************************************************/
@@ -6080,7 +6605,7 @@ void GDALDataset::TemporarilyDropReadWriteLock()
     if( psPrivate )
     {
         for(int i=0;i<psPrivate->nMutexTakenCount;i++)
-            CPLReleaseMutex(psPrivate->hMutex);
+            CPLReleaseMutex(GetReadWriteMutex());
     }
 }
 
@@ -6094,8 +6619,105 @@ void GDALDataset::ReacquireReadWriteLock()
     if( psPrivate )
     {
         for(int i=0;i<psPrivate->nMutexTakenCount;i++)
-            CPLAcquireMutex(psPrivate->hMutex, 1000.0);
+            CPLAcquireMutex(GetReadWriteMutex(), 1000.0);
+    }
+}
+
+/************************************************************************/
+/*                        RegisterAsyncRequest()                        */
+/************************************************************************/
+
+/* Called before starting the background thread of an asynchronous reader */
+/* or prefetch request, so that EnterReadWrite() serializes the accesses */
+/* to the dataset with it, even in read-only mode */
+bool GDALDataset::RegisterAsyncRequest()
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    if( psPrivate == NULL )
+        return false;
+
+    if( eAccess == GA_Update )
+    {
+        // Once created, the mutex is used by EnterReadWrite() for reads too
+        if( !CPLCreateOrAcquireMutex(&(psPrivate->hMutex), 1000.0) )
+            return false;
+        CPLReleaseMutex(psPrivate->hMutex);
+    }
+
+    CPLMutexHolderD( &hDLMutex );
+    if( psPrivate->psAsyncState == NULL )
+    {
+        GDALDatasetAsyncState* psAsyncState = new GDALDatasetAsyncState();
+        psAsyncState->nPendingRequests = 0;
+        psAsyncState->hMutex = NULL;
+        if( eAccess != GA_Update )
+        {
+            psAsyncState->hMutex = CPLCreateMutex();
+            if( psAsyncState->hMutex == NULL )
+            {
+                delete psAsyncState;
+                return false;
+            }
+            CPLReleaseMutex(psAsyncState->hMutex);
+        }
+        psPrivate->psAsyncState = psAsyncState;
     }
+    psPrivate->psAsyncState->nPendingRequests ++;
+    return true;
+}
+
+/************************************************************************/
+/*                       UnregisterAsyncRequest()                       */
+/************************************************************************/
+
+/* Called once the background thread of an asynchronous reader or */
+/* prefetch request, successfully registered, has terminated. The state */
+/* is destroyed with the last request, so this must not run concurrently */
+/* with other accesses to the dataset */
+void GDALDataset::UnregisterAsyncRequest()
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    CPLMutexHolderD( &hDLMutex );
+    GDALDatasetAsyncState* psAsyncState = psPrivate->psAsyncState;
+    CPLAssert( psAsyncState != NULL );
+    psAsyncState->nPendingRequests --;
+    if( psAsyncState->nPendingRequests == 0 )
+    {
+        CPLAssert( psAsyncState->oMapPendingWindows.empty() );
+        psPrivate->psAsyncState = NULL;
+        if( psAsyncState->hMutex != NULL )
+            CPLDestroyMutex(psAsyncState->hMutex);
+        delete psAsyncState;
+    }
+}
+
+/************************************************************************/
+/*                       RegisterPrefetchWindow()                       */
+/************************************************************************/
+
+/* Called by a registered prefetch request for each of its windows. */
+/* Returns true if no other pending request has already advised it. */
+bool GDALDataset::RegisterPrefetchWindow( const char* pszKey )
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    CPLMutexHolderD( &hDLMutex );
+    CPLAssert( psPrivate->psAsyncState != NULL );
+    return ++(psPrivate->psAsyncState->oMapPendingWindows[pszKey]) == 1;
+}
+
+/************************************************************************/
+/*                      UnregisterPrefetchWindow()                      */
+/************************************************************************/
+
+void GDALDataset::UnregisterPrefetchWindow( const char* pszKey )
+{
+    GDALDatasetPrivate* psPrivate = (GDALDatasetPrivate* )m_hPrivateData;
+    CPLMutexHolderD( &hDLMutex );
+    CPLAssert( psPrivate->psAsyncState != NULL );
+    std::map<CPLString, int>& oMap = psPrivate->psAsyncState->oMapPendingWindows;
+    std::map<CPLString, int>::iterator oIter = oMap.find(pszKey);
+    if( oIter != oMap.end() && --(oIter->second) == 0 )
+        oMap.erase(oIter);
 }
 
 /************************************************************************/
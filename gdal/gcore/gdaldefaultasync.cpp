@@ -29,6 +29,9 @@
  ****************************************************************************/
 
 #include "gdal_priv.h"
+#include "cpl_multiproc.h"
+
+#include <set>
 
 CPL_CVSID("$Id: gdaldataset.cpp 16796 2009-04-17 23:35:04Z normanb $");
 
@@ -193,17 +196,59 @@ void CPL_STDCALL GDALARUnlockBuffer(GDALAsyncReaderH hARIO)
     ((GDALAsyncReader *)hARIO)->UnlockBuffer();
 }
 
+/************************************************************************/
+/*                         GDALAsyncTimedWait()                         */
+/************************************************************************/
+
+/* Wait for hCond to be signaled, with hMutex held. As there is no timed */
+/* wait on condition variables in CPL, a finite timeout is implemented by */
+/* polling: *pdfWaited is incremented by the time spent. */
+static void GDALAsyncTimedWait( CPLCond* hCond, CPLMutex* hMutex,
+                                double dfTimeout, double* pdfWaited )
+{
+    if( dfTimeout < 0 )
+    {
+        CPLCondWait( hCond, hMutex );
+        return;
+    }
+    const double dfSlice = MIN(0.01, dfTimeout - *pdfWaited);
+    CPLReleaseMutex( hMutex );
+    CPLSleep( dfSlice );
+    CPLAcquireMutex( hMutex, 1000.0 );
+    *pdfWaited += dfSlice;
+}
+
 /************************************************************************/
 /* ==================================================================== */
 /*                     GDALDefaultAsyncReader                           */
 /* ==================================================================== */
 /************************************************************************/
 
+/* The request is read by a background thread, in chunks of whole blocks */
+/* rows, which are reported by GetNextUpdatedRegion() as soon as they are */
+/* available. The accesses of the thread to the dataset are serialized */
+/* with the ones of the other threads through GDALDataset::EnterReadWrite() */
+
 class GDALDefaultAsyncReader : public GDALAsyncReader
 {
   private:
     char **         papszOptions;
 
+    CPLJoinableThread* hThread;
+    CPLMutex*       hMutex;
+    CPLCond*        hCond;
+    CPLMutex*       hBufferMutex;
+    int             nChunkLines;
+    volatile int    nLinesRead;
+    int             nLinesReported;
+    volatile int    bStop;
+    volatile int    bDone;
+    CPLErr          eErr;
+
+    static void     ThreadFunction( void* pData );
+    CPLErr          ReadLines( int nBufYOff, int nLines );
+    void            ComputeChunkLines();
+
   public:
     GDALDefaultAsyncReader(GDALDataset* poDS,
                              int nXOff, int nYOff,
@@ -216,11 +261,15 @@ class GDALDefaultAsyncReader : public GDALAsyncReader
                              int nBandSpace, char **papszOptions);
     ~GDALDefaultAsyncReader();
 
+    bool            Start();
+
     virtual GDALAsyncStatusType GetNextUpdatedRegion(double dfTimeout,
                                                      int* pnBufXOff,
                                                      int* pnBufYOff,
                                                      int* pnBufXSize,
                                                      int* pnBufYSize);
+    virtual int LockBuffer( double dfTimeout = -1.0 );
+    virtual void UnlockBuffer();
 };
 
 /************************************************************************/
@@ -239,12 +288,17 @@ GDALGetDefaultAsyncReader( GDALDataset* poDS,
                              int nBandSpace, char **papszOptions)
 
 {
-    return new GDALDefaultAsyncReader( poDS,
-                                         nXOff, nYOff, nXSize, nYSize,
-                                         pBuf, nBufXSize, nBufYSize, eBufType,
-                                         nBandCount, panBandMap,
-                                         nPixelSpace, nLineSpace, nBandSpace,
-                                         papszOptions );
+    GDALDefaultAsyncReader* poReader =
+        new GDALDefaultAsyncReader( poDS,
+                                    nXOff, nYOff, nXSize, nYSize,
+                                    pBuf, nBufXSize, nBufYSize, eBufType,
+                                    nBandCount, panBandMap,
+                                    nPixelSpace, nLineSpace, nBandSpace,
+                                    papszOptions );
+    // If the thread cannot be started, GetNextUpdatedRegion() will read
+    // the request synchronously
+    poReader->Start();
+    return poReader;
 }
 
 /************************************************************************/
@@ -260,8 +314,17 @@ GDALDefaultAsyncReader( GDALDataset* poDSIn,
                           GDALDataType eBufTypeIn,
                           int nBandCountIn, int* panBandMapIn,
                           int nPixelSpaceIn, int nLineSpaceIn,
-                          int nBandSpaceIn, char **papszOptionsIn) 
-
+                          int nBandSpaceIn, char **papszOptionsIn) :
+    hThread(NULL),
+    hMutex(NULL),
+    hCond(NULL),
+    hBufferMutex(NULL),
+    nChunkLines(nBufYSizeIn),
+    nLinesRead(0),
+    nLinesReported(0),
+    bStop(FALSE),
+    bDone(FALSE),
+    eErr(CE_None)
 {
     poDS = poDSIn;
     nXOff = nXOffIn;
@@ -283,6 +346,14 @@ GDALDefaultAsyncReader( GDALDataset* poDSIn,
             panBandMap[i] = i+1;
     }
 
+    // Resolve the default spacings, as the request is read in chunks
+    if( nPixelSpaceIn == 0 )
+        nPixelSpaceIn = GDALGetDataTypeSize( eBufType ) / 8;
+    if( nLineSpaceIn == 0 )
+        nLineSpaceIn = nPixelSpaceIn * nBufXSize;
+    if( nBandSpaceIn == 0 )
+        nBandSpaceIn = nLineSpaceIn * nBufYSize;
+
     nPixelSpace = nPixelSpaceIn;
     nLineSpace = nLineSpaceIn;
     nBandSpace = nBandSpaceIn;
@@ -297,36 +368,547 @@ GDALDefaultAsyncReader( GDALDataset* poDSIn,
 GDALDefaultAsyncReader::~GDALDefaultAsyncReader()
 
 {
+    if( hThread != NULL )
+    {
+        bStop = TRUE;
+        CPLJoinThread( hThread );
+        poDS->UnregisterAsyncRequest();
+    }
+    if( hCond != NULL )
+        CPLDestroyCond( hCond );
+    if( hMutex != NULL )
+        CPLDestroyMutex( hMutex );
+    if( hBufferMutex != NULL )
+        CPLDestroyMutex( hBufferMutex );
+
     CPLFree( panBandMap );
     CSLDestroy( papszOptions );
 }
 
+/************************************************************************/
+/*                         ComputeChunkLines()                          */
+/************************************************************************/
+
+void GDALDefaultAsyncReader::ComputeChunkLines()
+{
+    // Reading a part of the window gives the same result as the whole
+    // request only if the buffer lines map to source lines in the same way,
+    // which is the case for integral subsampling factors.
+    nChunkLines = nBufYSize;
+    if( nBandCount == 0 || nYSize % nBufYSize != 0 )
+        return;
+    GDALRasterBand* poBand = poDS->GetRasterBand( panBandMap[0] );
+    if( poBand == NULL )
+        return;
+
+    const int nFactor = nYSize / nBufYSize;
+    int nBlockXSize, nBlockYSize;
+    poBand->GetBlockSize( &nBlockXSize, &nBlockYSize );
+
+    // Chunks of whole blocks rows, large enough so that the cost of the
+    // notifications is negligible
+    int nBlockBufLines = MAX(1, nBlockYSize / nFactor);
+    const GIntBig nBytesPerLine =
+        MAX(1, (GIntBig)nBufXSize * nBandCount *
+                    (GDALGetDataTypeSize( eBufType ) / 8));
+    const GIntBig nMinChunkBytes = 1024 * 1024;
+    GIntBig nLines = nBlockBufLines;
+    while( nLines * nBytesPerLine < nMinChunkBytes && nLines < nBufYSize )
+        nLines += nBlockBufLines;
+    nChunkLines = (int)MIN(nLines, (GIntBig)nBufYSize);
+}
+
+/************************************************************************/
+/*                               Start()                                */
+/************************************************************************/
+
+bool GDALDefaultAsyncReader::Start()
+{
+    ComputeChunkLines();
+
+    hMutex = CPLCreateMutex();
+    if( hMutex == NULL )
+        return false;
+    CPLReleaseMutex( hMutex );
+    hBufferMutex = CPLCreateMutex();
+    if( hBufferMutex == NULL )
+        return false;
+    CPLReleaseMutex( hBufferMutex );
+    hCond = CPLCreateCond();
+    if( hCond == NULL )
+        return false;
+
+    if( !poDS->RegisterAsyncRequest() )
+        return false;
+    hThread = CPLCreateJoinableThread( ThreadFunction, this );
+    if( hThread == NULL )
+    {
+        poDS->UnregisterAsyncRequest();
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             ReadLines()                              */
+/************************************************************************/
+
+CPLErr GDALDefaultAsyncReader::ReadLines( int nBufYOff, int nLines )
+{
+    const int nFactor = (nLines == nBufYSize) ? 0 : nYSize / nBufYSize;
+
+    return poDS->RasterIO( GF_Read, nXOff,
+                           nFactor ? nYOff + nBufYOff * nFactor : nYOff,
+                           nXSize, nFactor ? nLines * nFactor : nYSize,
+                           (GByte*)pBuf + (GIntBig)nBufYOff * nLineSpace,
+                           nBufXSize, nLines, eBufType,
+                           nBandCount, panBandMap,
+                           nPixelSpace, nLineSpace, nBandSpace,
+                           NULL );
+}
+
+/************************************************************************/
+/*                           ThreadFunction()                           */
+/************************************************************************/
+
+void GDALDefaultAsyncReader::ThreadFunction( void* pData )
+{
+    GDALDefaultAsyncReader* poThis = (GDALDefaultAsyncReader*) pData;
+
+    for( int iLine = 0; iLine < poThis->nBufYSize && !poThis->bStop;
+         iLine += poThis->nChunkLines )
+    {
+        const int nLines = MIN(poThis->nChunkLines, poThis->nBufYSize - iLine);
+
+        CPLAcquireMutex( poThis->hBufferMutex, 1000.0 );
+        CPLErr eErr = poThis->ReadLines( iLine, nLines );
+        CPLReleaseMutex( poThis->hBufferMutex );
+
+        CPLAcquireMutex( poThis->hMutex, 1000.0 );
+        if( eErr != CE_None )
+            poThis->eErr = eErr;
+        else
+            poThis->nLinesRead = iLine + nLines;
+        CPLCondSignal( poThis->hCond );
+        CPLReleaseMutex( poThis->hMutex );
+
+        if( eErr != CE_None )
+            break;
+    }
+
+    CPLAcquireMutex( poThis->hMutex, 1000.0 );
+    poThis->bDone = TRUE;
+    CPLCondSignal( poThis->hCond );
+    CPLReleaseMutex( poThis->hMutex );
+}
+
 /************************************************************************/
 /*                        GetNextUpdatedRegion()                        */
 /************************************************************************/
 
 GDALAsyncStatusType
-GDALDefaultAsyncReader::GetNextUpdatedRegion(CPL_UNUSED double dfTimeout,
+GDALDefaultAsyncReader::GetNextUpdatedRegion(double dfTimeout,
                                              int* pnBufXOff,
                                              int* pnBufYOff,
                                              int* pnBufXSize,
                                              int* pnBufYSize )
 {
-    CPLErr eErr;
-
-    eErr = poDS->RasterIO( GF_Read, nXOff, nYOff, nXSize, nYSize,
-                           pBuf, nBufXSize, nBufYSize, eBufType,
-                           nBandCount, panBandMap,
-                           nPixelSpace, nLineSpace, nBandSpace,
-                           NULL );
-
     *pnBufXOff = 0;
     *pnBufYOff = 0;
-    *pnBufXSize = nBufXSize;
-    *pnBufYSize = nBufYSize;
+    *pnBufXSize = 0;
+    *pnBufYSize = 0;
+
+/* -------------------------------------------------------------------- */
+/*      No background thread: read the whole request now.               */
+/* -------------------------------------------------------------------- */
+    if( hThread == NULL )
+    {
+        if( nLinesReported == nBufYSize )
+            return GARIO_COMPLETE;
+
+        CPLErr eErrRead = ReadLines( 0, nBufYSize );
+        if( eErrRead != CE_None )
+            return GARIO_ERROR;
 
-    if( eErr == CE_None )
+        nLinesReported = nBufYSize;
+        *pnBufXSize = nBufXSize;
+        *pnBufYSize = nBufYSize;
         return GARIO_COMPLETE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Wait for lines not reported yet.                                */
+/* -------------------------------------------------------------------- */
+    CPLAcquireMutex( hMutex, 1000.0 );
+    double dfWaited = 0.0;
+    while( nLinesRead == nLinesReported && !bDone &&
+           (dfTimeout < 0 || dfWaited < dfTimeout) )
+    {
+        GDALAsyncTimedWait( hCond, hMutex, dfTimeout, &dfWaited );
+    }
+
+    GDALAsyncStatusType eStatus;
+    if( eErr != CE_None )
+    {
+        eStatus = GARIO_ERROR;
+    }
     else
-        return GARIO_ERROR;
+    {
+        if( nLinesRead > nLinesReported )
+        {
+            *pnBufYOff = nLinesReported;
+            *pnBufXSize = nBufXSize;
+            *pnBufYSize = nLinesRead - nLinesReported;
+            nLinesReported = nLinesRead;
+        }
+        if( nLinesReported == nBufYSize )
+            eStatus = GARIO_COMPLETE;
+        else if( *pnBufYSize > 0 )
+            eStatus = GARIO_UPDATE;
+        else
+            eStatus = GARIO_PENDING;
+    }
+    CPLReleaseMutex( hMutex );
+
+    return eStatus;
+}
+
+/************************************************************************/
+/*                             LockBuffer()                             */
+/************************************************************************/
+
+int GDALDefaultAsyncReader::LockBuffer( double dfTimeout )
+{
+    if( hBufferMutex == NULL )
+        return TRUE;
+    return CPLAcquireMutex( hBufferMutex, dfTimeout < 0 ? 1000.0 : dfTimeout );
+}
+
+/************************************************************************/
+/*                            UnlockBuffer()                            */
+/************************************************************************/
+
+void GDALDefaultAsyncReader::UnlockBuffer()
+{
+    if( hBufferMutex != NULL )
+        CPLReleaseMutex( hBufferMutex );
+}
+
+/************************************************************************/
+/* ==================================================================== */
+/*                         GDALPrefetchRequest                          */
+/* ==================================================================== */
+/************************************************************************/
+
+/************************************************************************/
+/*                        GDALPrefetchRequest()                         */
+/************************************************************************/
+
+GDALPrefetchRequest::GDALPrefetchRequest( GDALDataset* poDSIn,
+                                          int nWindowCountIn,
+                                          const int* panWindowsIn,
+                                          int nBandCountIn,
+                                          const int* panBandMapIn,
+                                          GDALPrefetchCallback pfnCallbackIn,
+                                          void* pCallbackDataIn ) :
+    poDS(poDSIn),
+    nWindowCount(nWindowCountIn),
+    panWindows(NULL),
+    nBandCount(nBandCountIn),
+    panBandMap(NULL),
+    pfnCallback(pfnCallbackIn),
+    pCallbackData(pCallbackDataIn),
+    pabyDuplicateWindows(NULL),
+    papszRegisteredWindows(NULL),
+    bRegistered(false),
+    hThread(NULL),
+    hMutex(NULL),
+    hCond(NULL),
+    nCompletedWindows(0),
+    bStop(FALSE),
+    eErr(CE_None)
+{
+    panWindows = (int*) CPLMalloc( sizeof(int) * 4 * MAX(1, nWindowCount) );
+    if( nWindowCount > 0 )
+        memcpy( panWindows, panWindowsIn, sizeof(int) * 4 * nWindowCount );
+
+    panBandMap = (int*) CPLMalloc( sizeof(int) * MAX(1, nBandCount) );
+    for( int i = 0; i < nBandCount; i++ )
+        panBandMap[i] = (panBandMapIn != NULL) ? panBandMapIn[i] : i + 1;
+
+    pabyDuplicateWindows = (GByte*) CPLCalloc( 1, MAX(1, nWindowCount) );
+}
+
+/************************************************************************/
+/*                        ~GDALPrefetchRequest()                        */
+/************************************************************************/
+
+GDALPrefetchRequest::~GDALPrefetchRequest()
+{
+    if( hThread != NULL )
+    {
+        bStop = TRUE;
+        CPLJoinThread( hThread );
+    }
+    for( char** papszIter = papszRegisteredWindows;
+         papszIter != NULL && *papszIter != NULL; ++papszIter )
+    {
+        poDS->UnregisterPrefetchWindow( *papszIter );
+    }
+    CSLDestroy( papszRegisteredWindows );
+    if( bRegistered )
+        poDS->UnregisterAsyncRequest();
+    if( hCond != NULL )
+        CPLDestroyCond( hCond );
+    if( hMutex != NULL )
+        CPLDestroyMutex( hMutex );
+    CPLFree( panWindows );
+    CPLFree( panBandMap );
+    CPLFree( pabyDuplicateWindows );
+}
+
+/************************************************************************/
+/*                            GetWindowKey()                            */
+/************************************************************************/
+
+/* Identifies a window and its bands in the pending windows of a dataset */
+CPLString GDALPrefetchRequest::GetWindowKey( int iWindow ) const
+{
+    const int* panWindow = panWindows + 4 * iWindow;
+    CPLString osKey;
+    osKey.Printf( "%d,%d,%d,%d:", panWindow[0], panWindow[1],
+                  panWindow[2], panWindow[3] );
+    for( int i = 0; i < nBandCount; i++ )
+        osKey += CPLSPrintf( "%d,", panBandMap[i] );
+    return osKey;
+}
+
+/************************************************************************/
+/*                               Start()                                */
+/************************************************************************/
+
+bool GDALPrefetchRequest::Start( char** papszOptions )
+{
+    hMutex = CPLCreateMutex();
+    if( hMutex == NULL )
+        return false;
+    CPLReleaseMutex( hMutex );
+    hCond = CPLCreateCond();
+    if( hCond == NULL )
+        return false;
+
+    if( !poDS->RegisterAsyncRequest() )
+        return false;
+    bRegistered = true;
+
+/* -------------------------------------------------------------------- */
+/*      Advise the windows to the driver, skipping the ones that are    */
+/*      repeated in the list or already advised by another pending      */
+/*      request, so that drivers do not queue them several times.      */
+/* -------------------------------------------------------------------- */
+    std::set<CPLString> oSetWindows;
+    for( int i = 0; i < nWindowCount; i++ )
+    {
+        const CPLString osKey( GetWindowKey( i ) );
+        if( !oSetWindows.insert( osKey ).second )
+        {
+            pabyDuplicateWindows[i] = TRUE;
+            continue;
+        }
+
+        const bool bFirst = poDS->RegisterPrefetchWindow( osKey );
+        papszRegisteredWindows = CSLAddString( papszRegisteredWindows, osKey );
+        if( !bFirst )
+            continue;
+
+        /* AdviseRead() is cheap, and some drivers are able to start */
+        /* fetching the data themselves */
+        const int* panWindow = panWindows + 4 * i;
+        if( poDS->AdviseRead( panWindow[0], panWindow[1],
+                              panWindow[2], panWindow[3],
+                              panWindow[2], panWindow[3], GDT_Unknown,
+                              nBandCount, panBandMap,
+                              papszOptions ) != CE_None )
+        {
+            return false;
+        }
+    }
+
+    hThread = CPLCreateJoinableThread( ThreadFunction, this );
+    if( hThread == NULL )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Cannot start the prefetch thread" );
+        return false;
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                             LoadWindow()                             */
+/************************************************************************/
+
+CPLErr GDALPrefetchRequest::LoadWindow( int iWindow )
+{
+    const int* panWindow = panWindows + 4 * iWindow;
+    CPLErr eWindowErr = CE_None;
+
+    for( int iBand = 0; iBand < nBandCount && eWindowErr == CE_None; iBand++ )
+    {
+        GDALRasterBand* poBand = poDS->GetRasterBand( panBandMap[iBand] );
+        if( poBand == NULL )
+            return CE_Failure;
+
+        int nBlockXSize, nBlockYSize;
+        poBand->GetBlockSize( &nBlockXSize, &nBlockYSize );
+        const int nXBlockStart = panWindow[0] / nBlockXSize;
+        const int nXBlockEnd = (panWindow[0] + panWindow[2] - 1) / nBlockXSize;
+        const int nYBlockStart = panWindow[1] / nBlockYSize;
+        const int nYBlockEnd = (panWindow[1] + panWindow[3] - 1) / nBlockYSize;
+
+        for( int nYBlock = nYBlockStart;
+             nYBlock <= nYBlockEnd && eWindowErr == CE_None; nYBlock++ )
+        {
+            if( bStop )
+                return CE_Failure;
+
+            // Release the dataset between blocks rows to let other threads
+            // access it
+            const int bCallLeaveReadWrite = poDS->EnterReadWrite(GF_Read);
+            for( int nXBlock = nXBlockStart; nXBlock <= nXBlockEnd; nXBlock++ )
+            {
+                GDALRasterBlock* poBlock =
+                    poBand->GetLockedBlockRef( nXBlock, nYBlock );
+                if( poBlock == NULL )
+                {
+                    eWindowErr = CE_Failure;
+                    break;
+                }
+                poBlock->DropLock();
+            }
+            if( bCallLeaveReadWrite )
+                poDS->LeaveReadWrite();
+        }
+    }
+
+    return eWindowErr;
+}
+
+/************************************************************************/
+/*                           ThreadFunction()                           */
+/************************************************************************/
+
+void GDALPrefetchRequest::ThreadFunction( void* pData )
+{
+    GDALPrefetchRequest* poThis = (GDALPrefetchRequest*) pData;
+
+    for( int iWindow = 0; iWindow < poThis->nWindowCount; iWindow++ )
+    {
+        if( poThis->bStop )
+            break;
+
+        // A failure does not prevent loading the next windows. Repeated
+        // windows have already been loaded
+        const CPLErr eWindowErr = poThis->pabyDuplicateWindows[iWindow] ?
+            CE_None : poThis->LoadWindow( iWindow );
+        if( poThis->bStop )
+            break;
+
+        if( poThis->pfnCallback != NULL )
+            poThis->pfnCallback( (GDALDatasetH) poThis->poDS, iWindow,
+                                 eWindowErr, poThis->pCallbackData );
+
+        CPLAcquireMutex( poThis->hMutex, 1000.0 );
+        if( eWindowErr != CE_None )
+            poThis->eErr = eWindowErr;
+        poThis->nCompletedWindows ++;
+        CPLCondSignal( poThis->hCond );
+        CPLReleaseMutex( poThis->hMutex );
+    }
+}
+
+/************************************************************************/
+/*                                Wait()                                */
+/************************************************************************/
+
+/**
+ * \brief Wait for the windows of a prefetch request to be loaded.
+ *
+ * This method is the same as the C function GDALPrefetchRequestWait().
+ *
+ * @param dfTimeout the maximum number of seconds to wait. Use -1 to wait
+ * indefinitely, or zero to not wait at all.
+ *
+ * @return TRUE if all the windows have been processed, FALSE if the timeout
+ * has expired before. GetLastErr() reports if some of them failed.
+ *
+ * @since GDAL 2.1
+ */
+
+int GDALPrefetchRequest::Wait( double dfTimeout )
+{
+    CPLAcquireMutex( hMutex, 1000.0 );
+    double dfWaited = 0.0;
+    while( nCompletedWindows < nWindowCount &&
+           (dfTimeout < 0 || dfWaited < dfTimeout) )
+    {
+        GDALAsyncTimedWait( hCond, hMutex, dfTimeout, &dfWaited );
+    }
+    const int bComplete = (nCompletedWindows == nWindowCount);
+    CPLReleaseMutex( hMutex );
+    return bComplete;
+}
+
+/************************************************************************/
+/*                      GetCompletedWindowCount()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the number of windows that have been processed.
+ *
+ * Windows are processed in the order in which they were submitted.
+ *
+ * @since GDAL 2.1
+ */
+
+int GDALPrefetchRequest::GetCompletedWindowCount()
+{
+    return nCompletedWindows;
+}
+
+/************************************************************************/
+/*                            GetLastErr()                              */
+/************************************************************************/
+
+/**
+ * \brief Return CE_Failure if the loading of a window has failed.
+ *
+ * @since GDAL 2.1
+ */
+
+CPLErr GDALPrefetchRequest::GetLastErr()
+{
+    CPLAcquireMutex( hMutex, 1000.0 );
+    const CPLErr eRet = eErr;
+    CPLReleaseMutex( hMutex );
+    return eRet;
+}
+
+/************************************************************************/
+/*                      GDALPrefetchRequestWait()                       */
+/************************************************************************/
+
+/**
+ * \brief Wait for the windows of a prefetch request to be loaded.
+ *
+ * @see GDALPrefetchRequest::Wait()
+ *
+ * @since GDAL 2.1
+ */
+
+int CPL_STDCALL GDALPrefetchRequestWait( GDALPrefetchRequestH hRequest,
+                                         double dfTimeout )
+{
+    VALIDATE_POINTER1( hRequest, "GDALPrefetchRequestWait", FALSE );
+    return ((GDALPrefetchRequest*) hRequest)->Wait( dfTimeout );
 }
@@ -29,14 +29,21 @@
  ****************************************************************************/
 
 #include "gdal_proxy.h"
+#include "cpl_atomic_ops.h"
 #include "cpl_multiproc.h"
 
+#include <limits.h>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 CPL_CVSID("$Id$");
 
-/* We *must* share the same mutex as the gdaldataset.cpp file, as we are */
-/* doing GDALOpen() calls that can indirectly call GDALOpenShared() on */
-/* an auxiliary dataset ... */
-/* Then we could get dead-locks in multi-threaded use case */
+/* The opening and closing of the underlying datasets is done without */
+/* holding any lock, as they can take long (network file systems) and */
+/* GDALOpen() can indirectly call GDALOpenShared() on an auxiliary */
+/* dataset, or open a VRT whose sources are themselves proxy pool */
+/* datasets. Holding a pool lock there could lead to dead-locks. */
 
 /* ******************************************************************** */
 /*                         GDALDatasetPool                              */
@@ -45,11 +52,25 @@ CPL_CVSID("$Id$");
 /* This class is a singleton that maintains a pool of opened datasets */
 /* The cache uses a LRU strategy */
 
+/* The entries are split into shards, according to the hash of their */
+/* filename, each with its own LRU list and mutex, so that threads */
+/* working on different datasets do not serialize on a single lock. The */
+/* maximum size applies to the whole pool, and the entry evicted when it */
+/* is reached is the least recently used one of all shards. */
+
+static const int GDAL_DATASET_POOL_SHARD_COUNT = 16;
+
 class GDALDatasetPool;
 static GDALDatasetPool* singleton = NULL;
 
 void GDALNullifyProxyPoolSingleton() { singleton = NULL; }
 
+/* Statistics of the previous instances of the singleton */
+static GIntBig nPreviousPoolsHits = 0;
+static GIntBig nPreviousPoolsOpens = 0;
+static GIntBig nPreviousPoolsCloses = 0;
+static GIntBig nPreviousPoolsEvictions = 0;
+
 struct _GDALProxyPoolCacheEntry
 {
     GIntBig       responsiblePID;
@@ -59,10 +80,27 @@ struct _GDALProxyPoolCacheEntry
     /* Ref count of the cached dataset */
     int           refCount;
 
+    /* Value of the pool use counter at the last reference */
+    int           lastUse;
+
     GDALProxyPoolCacheEntry* prev;
     GDALProxyPoolCacheEntry* next;
 };
 
+typedef struct
+{
+    CPLMutex                *hMutex;
+    int                      currentSize;
+    GDALProxyPoolCacheEntry *firstEntry;
+    GDALProxyPoolCacheEntry *lastEntry;
+
+    /* Statistics */
+    GIntBig                  nHits;
+    GIntBig                  nOpens;
+    GIntBig                  nCloses;
+    GIntBig                  nEvictions;
+} GDALDatasetPoolShard;
+
 class GDALDatasetPool
 {
     private:
@@ -73,30 +111,43 @@ class GDALDatasetPool
         int refCount;
 
         int maxSize;
+        CPLMutex* hSizeMutex;
         int currentSize;
-        GDALProxyPoolCacheEntry* firstEntry;
-        GDALProxyPoolCacheEntry* lastEntry;
-
-        /* This variable prevents a dataset that is going to be opened in GDALDatasetPool::_RefDataset */
-        /* from increasing refCount if, during its opening, it creates a GDALProxyPoolDataset */
-        /* We increment it before opening or closing a cached dataset and decrement it afterwards */
-        /* The typical use case is a VRT made of simple sources that are VRT */
-        /* We don't want the "inner" VRT to take a reference on the pool, otherwise there is */
-        /* a high chance that this reference will not be dropped and the pool remain ghost */
+        volatile int useCounter;
+        GDALDatasetPoolShard asShards[GDAL_DATASET_POOL_SHARD_COUNT];
+
+        /* This variable prevents the pool from being destroyed by the */
+        /* closing of the datasets in GDALDestroyDriverManager(). */
+        /* The datasets opened or closed by the pool itself do not take a */
+        /* reference on the pool either: see GDALDatasetPoolGetThreadDisableRefCount() */
         int refCountOfDisableRefCount;
 
         /* Caution : to be sure that we don't run out of entries, size must be at */
         /* least greater or equal than the maximum number of threads */
         GDALDatasetPool(int maxSize);
         ~GDALDatasetPool();
+
+        GDALDatasetPoolShard* GetShard(const char* pszFileName);
+        static void Unlink(GDALDatasetPoolShard* shard,
+                           GDALProxyPoolCacheEntry* entry);
+        static void Prepend(GDALDatasetPoolShard* shard,
+                            GDALProxyPoolCacheEntry* entry);
+        static GDALProxyPoolCacheEntry* FindUnused(GDALDatasetPoolShard* shard);
         GDALProxyPoolCacheEntry* _RefDataset(const char* pszFileName,
                                              GDALAccess eAccess,
                                              char** papszOpenOptions,
                                              int bShared);
+        bool ReserveSlot();
+        void ReleaseSlot();
+        GDALProxyPoolCacheEntry* EvictLRUEntry();
+        static void CloseEntry(GDALProxyPoolCacheEntry* entry);
+        void _UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry);
         void _CloseDataset(const char* pszFileName, GDALAccess eAccess);
+        void _GetStatistics(GIntBig* pnHits, GIntBig* pnOpens,
+                            GIntBig* pnCloses, GIntBig* pnEvictions);
 
         void ShowContent();
-        void CheckLinks();
+        void CheckLinks(GDALDatasetPoolShard* shard);
 
     public:
         static void Ref();
@@ -107,11 +158,55 @@ class GDALDatasetPool
                                                    int bShared);
         static void UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry);
         static void CloseDataset(const char* pszFileName, GDALAccess eAccess);
+        static void GetStatistics(GIntBig* pnHits, GIntBig* pnOpens,
+                                  GIntBig* pnCloses, GIntBig* pnEvictions);
 
         static void PreventDestroy();
         static void ForceDestroy();
 };
 
+/************************************************************************/
+/*              GDALDatasetPoolGetThreadDisableRefCount()               */
+/************************************************************************/
+
+/* Counter, specific to the current thread, that is incremented while the */
+/* pool opens or closes a dataset. The GDALProxyPoolDataset created while */
+/* it is not zero do not take a reference on the pool. */
+/* The typical use case is a VRT made of simple sources that are VRT */
+/* We don't want the "inner" VRT to take a reference on the pool, otherwise there is */
+/* a high chance that this reference will not be dropped and the pool remain ghost */
+/* As datasets are opened and closed without holding a lock, this must */
+/* not affect the GDALProxyPoolDataset created at the same time by other threads. */
+
+static int* GDALDatasetPoolGetThreadDisableRefCount()
+{
+    int* pnCount = (int*) CPLGetTLS( CTLS_GDALDATASETPOOL_DISABLEREFCOUNT );
+    if( pnCount == NULL )
+    {
+        pnCount = (int*) CPLCalloc(1, sizeof(int));
+        CPLSetTLS( CTLS_GDALDATASETPOOL_DISABLEREFCOUNT, pnCount, TRUE );
+    }
+    return pnCount;
+}
+
+/************************************************************************/
+/*                    GDALDatasetPoolGetFileLimit()                     */
+/************************************************************************/
+
+/* Return the maximum number of files that the process can open. */
+static int GDALDatasetPoolGetFileLimit()
+{
+#ifdef _WIN32
+    return _getmaxstdio();
+#else
+    struct rlimit sLimit;
+    if( getrlimit(RLIMIT_NOFILE, &sLimit) != 0 )
+        return 1024;
+    if( sLimit.rlim_cur == RLIM_INFINITY || sLimit.rlim_cur > INT_MAX )
+        return INT_MAX;
+    return static_cast<int>(sLimit.rlim_cur);
+#endif
+}
 
 /************************************************************************/
 /*                         GDALDatasetPool()                            */
@@ -120,11 +215,12 @@ class GDALDatasetPool
 GDALDatasetPool::GDALDatasetPool(int maxSizeIn)
 {
     maxSize = maxSizeIn;
+    hSizeMutex = NULL;
     currentSize = 0;
-    firstEntry = NULL;
-    lastEntry = NULL;
+    useCounter = 0;
     refCount = 0;
     refCountOfDisableRefCount = 0;
+    memset(asShards, 0, sizeof(asShards));
 }
 
 /************************************************************************/
@@ -133,22 +229,52 @@ GDALDatasetPool::GDALDatasetPool(int maxSizeIn)
 
 GDALDatasetPool::~GDALDatasetPool()
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-    while(cur)
+    /* Detach all entries before closing them, so that the closing of */
+    /* inner proxy pool datasets does not find them. */
+    GDALProxyPoolCacheEntry* entries = NULL;
+    GIntBig nRemainingEntries = 0;
+    for( int i = 0; i < GDAL_DATASET_POOL_SHARD_COUNT; i++ )
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
-        CPLFree(cur->pszFileName);
-        CPLAssert(cur->refCount == 0);
-        if (cur->poDS)
+        GDALDatasetPoolShard* shard = &asShards[i];
+        if( shard->lastEntry )
         {
-            GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
-            GDALClose(cur->poDS);
+            shard->lastEntry->next = entries;
+            entries = shard->firstEntry;
         }
-        CPLFree(cur);
-        cur = next;
+        nRemainingEntries += shard->currentSize;
+        shard->firstEntry = shard->lastEntry = NULL;
+        shard->currentSize = 0;
     }
-    GDALSetResponsiblePIDForCurrentThread(responsiblePID);
+
+    /* The entries still in the pool are closed below. */
+    GIntBig nHits, nOpens, nCloses, nEvictions;
+    _GetStatistics(&nHits, &nOpens, &nCloses, &nEvictions);
+    nCloses += nRemainingEntries;
+    if( nOpens > 0 )
+        CPLDebug("GDAL",
+                 "Dataset pool: " CPL_FRMT_GIB " hits, " CPL_FRMT_GIB " opens, "
+                 CPL_FRMT_GIB " closes (" CPL_FRMT_GIB " evictions)",
+                 nHits, nOpens, nCloses, nEvictions);
+    nPreviousPoolsHits += nHits;
+    nPreviousPoolsOpens += nOpens;
+    nPreviousPoolsCloses += nCloses;
+    nPreviousPoolsEvictions += nEvictions;
+
+    while( entries )
+    {
+        GDALProxyPoolCacheEntry* next = entries->next;
+        CPLAssert(entries->refCount == 0);
+        CloseEntry(entries);
+        entries = next;
+    }
+
+    for( int i = 0; i < GDAL_DATASET_POOL_SHARD_COUNT; i++ )
+    {
+        if( asShards[i].hMutex )
+            CPLDestroyMutex(asShards[i].hMutex);
+    }
+    if( hSizeMutex )
+        CPLDestroyMutex(hSizeMutex);
 }
 
 /************************************************************************/
@@ -157,14 +283,19 @@ GDALDatasetPool::~GDALDatasetPool()
 
 void GDALDatasetPool::ShowContent()
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
     int i = 0;
-    while(cur)
+    for( int iShard = 0; iShard < GDAL_DATASET_POOL_SHARD_COUNT; iShard++ )
     {
-        printf("[%d] pszFileName=%s, refCount=%d, responsiblePID=%d\n",
-               i, cur->pszFileName, cur->refCount, (int)cur->responsiblePID);
-        i++;
-        cur = cur->next;
+        CPLMutexHolderD( &asShards[iShard].hMutex );
+        GDALProxyPoolCacheEntry* cur = asShards[iShard].firstEntry;
+        while(cur)
+        {
+            printf("[%d] shard=%d, pszFileName=%s, refCount=%d, responsiblePID=%d\n",
+                   i, iShard, cur->pszFileName, cur->refCount,
+                   (int)cur->responsiblePID);
+            i++;
+            cur = cur->next;
+        }
     }
 }
 
@@ -172,19 +303,180 @@ void GDALDatasetPool::ShowContent()
 /*                             CheckLinks()                             */
 /************************************************************************/
 
-void GDALDatasetPool::CheckLinks()
+void GDALDatasetPool::CheckLinks(GDALDatasetPoolShard* shard)
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
+    GDALProxyPoolCacheEntry* cur = shard->firstEntry;
     int i = 0;
     while(cur)
     {
-        CPLAssert(cur == firstEntry || cur->prev->next == cur);
-        CPLAssert(cur == lastEntry || cur->next->prev == cur);
+        CPLAssert(cur == shard->firstEntry || cur->prev->next == cur);
+        CPLAssert(cur == shard->lastEntry || cur->next->prev == cur);
         i++;
-	CPLAssert(cur->next != NULL || cur == lastEntry);
+        CPLAssert(cur->next != NULL || cur == shard->lastEntry);
         cur = cur->next;
     }
-    CPLAssert(i == currentSize);
+    CPLAssert(i == shard->currentSize);
+}
+
+/************************************************************************/
+/*                              GetShard()                              */
+/************************************************************************/
+
+GDALDatasetPoolShard* GDALDatasetPool::GetShard(const char* pszFileName)
+{
+    return &asShards[CPLHashSetHashStr(pszFileName) %
+                     GDAL_DATASET_POOL_SHARD_COUNT];
+}
+
+/************************************************************************/
+/*                          Unlink() / Prepend()                        */
+/*                                                                      */
+/*      Must be called with the mutex of the shard held.                */
+/************************************************************************/
+
+void GDALDatasetPool::Unlink(GDALDatasetPoolShard* shard,
+                             GDALProxyPoolCacheEntry* entry)
+{
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        shard->firstEntry = entry->next;
+    if (entry->next)
+        entry->next->prev = entry->prev;
+    else
+        shard->lastEntry = entry->prev;
+    entry->prev = NULL;
+    entry->next = NULL;
+    shard->currentSize --;
+}
+
+void GDALDatasetPool::Prepend(GDALDatasetPoolShard* shard,
+                              GDALProxyPoolCacheEntry* entry)
+{
+    entry->prev = NULL;
+    entry->next = shard->firstEntry;
+    if (shard->firstEntry)
+        shard->firstEntry->prev = entry;
+    else
+        shard->lastEntry = entry;
+    shard->firstEntry = entry;
+    shard->currentSize ++;
+#ifdef DEBUG_PROXY_POOL
+    CheckLinks(shard);
+#endif
+}
+
+/************************************************************************/
+/*                            FindUnused()                              */
+/*                                                                      */
+/*      Return the least recently used entry of the shard that is not   */
+/*      referenced. Must be called with the mutex of the shard held.    */
+/************************************************************************/
+
+GDALProxyPoolCacheEntry* GDALDatasetPool::FindUnused(GDALDatasetPoolShard* shard)
+{
+    for( GDALProxyPoolCacheEntry* cur = shard->lastEntry; cur; cur = cur->prev )
+    {
+        if (cur->refCount == 0)
+            return cur;
+    }
+    return NULL;
+}
+
+/************************************************************************/
+/*                            CloseEntry()                              */
+/*                                                                      */
+/*      Close the dataset of a detached entry and free the entry.       */
+/************************************************************************/
+
+void GDALDatasetPool::CloseEntry(GDALProxyPoolCacheEntry* entry)
+{
+    if (entry->poDS)
+    {
+        /* Close by pretending we are the thread that GDALOpen'ed this */
+        /* dataset */
+        GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+        GDALSetResponsiblePIDForCurrentThread(entry->responsiblePID);
+
+        int* pnDisableRefCount = GDALDatasetPoolGetThreadDisableRefCount();
+        (*pnDisableRefCount) ++;
+        GDALClose(entry->poDS);
+        (*pnDisableRefCount) --;
+
+        GDALSetResponsiblePIDForCurrentThread(responsiblePID);
+    }
+    CPLFree(entry->pszFileName);
+    CPLFree(entry);
+}
+
+/************************************************************************/
+/*                     ReserveSlot() / ReleaseSlot()                    */
+/*                                                                      */
+/*      Account for a dataset entering or leaving the pool.             */
+/************************************************************************/
+
+bool GDALDatasetPool::ReserveSlot()
+{
+    CPLMutexHolderD( &hSizeMutex );
+    if (currentSize == maxSize)
+        return false;
+    currentSize ++;
+    return true;
+}
+
+void GDALDatasetPool::ReleaseSlot()
+{
+    CPLMutexHolderD( &hSizeMutex );
+    currentSize --;
+}
+
+/************************************************************************/
+/*                           EvictLRUEntry()                            */
+/*                                                                      */
+/*      Detach the least recently used unreferenced entry of the whole  */
+/*      pool. The shard mutexes are taken one at a time.                */
+/************************************************************************/
+
+GDALProxyPoolCacheEntry* GDALDatasetPool::EvictLRUEntry()
+{
+    for( int iIter = 0; iIter < 2 * GDAL_DATASET_POOL_SHARD_COUNT; iIter++ )
+    {
+        GDALDatasetPoolShard* bestShard = NULL;
+        GDALProxyPoolCacheEntry* bestEntry = NULL;
+        int bestLastUse = 0;
+
+        for( int i = 0; i < GDAL_DATASET_POOL_SHARD_COUNT; i++ )
+        {
+            GDALDatasetPoolShard* shard = &asShards[i];
+            CPLMutexHolderD( &shard->hMutex );
+            GDALProxyPoolCacheEntry* cur = FindUnused(shard);
+            /* Wrap-around safe comparison of the use counters */
+            if( cur != NULL &&
+                (bestEntry == NULL ||
+                 (int)((unsigned)cur->lastUse - (unsigned)bestLastUse) < 0) )
+            {
+                bestShard = shard;
+                bestEntry = cur;
+                bestLastUse = cur->lastUse;
+            }
+        }
+
+        if( bestEntry == NULL )
+            return NULL;
+
+        /* The entry may have been referenced or evicted by another */
+        /* thread in the meantime. */
+        CPLMutexHolderD( &bestShard->hMutex );
+        GDALProxyPoolCacheEntry* cur = FindUnused(bestShard);
+        if( cur == bestEntry && cur->lastUse == bestLastUse )
+        {
+            Unlink(bestShard, cur);
+            bestShard->nCloses ++;
+            bestShard->nEvictions ++;
+            return cur;
+        }
+    }
+    return NULL;
 }
 
 /************************************************************************/
@@ -196,49 +488,70 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
                                                       char** papszOpenOptions,
                                                       int bShared)
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
+    GDALDatasetPoolShard* shard = GetShard(pszFileName);
     GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-    GDALProxyPoolCacheEntry* lastEntryWithZeroRefCount = NULL;
 
-    while(cur)
+/* -------------------------------------------------------------------- */
+/*      Look for the dataset in the pool. For a non shared dataset,     */
+/*      prefer an entry opened by the current thread.                   */
+/* -------------------------------------------------------------------- */
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
+        CPLMutexHolderD( &shard->hMutex );
+        GDALProxyPoolCacheEntry* found = NULL;
+        for( GDALProxyPoolCacheEntry* cur = shard->firstEntry; cur; cur = cur->next )
+        {
+            if (strcmp(cur->pszFileName, pszFileName) != 0)
+                continue;
+            if (bShared && cur->responsiblePID == responsiblePID)
+            {
+                found = cur;
+                break;
+            }
+            if (!bShared && cur->refCount == 0)
+            {
+                if (found == NULL)
+                    found = cur;
+                if (cur->responsiblePID == responsiblePID)
+                {
+                    found = cur;
+                    break;
+                }
+            }
+        }
 
-        if (strcmp(cur->pszFileName, pszFileName) == 0 &&
-            ((bShared && cur->responsiblePID == responsiblePID) ||
-             (!bShared && cur->refCount == 0)) )
+        if (found)
         {
-            if (cur != firstEntry)
+            if (found != shard->firstEntry)
             {
                 /* Move to begin */
-                if (cur->next)
-                    cur->next->prev = cur->prev;
-                else
-                    lastEntry = cur->prev;
-                cur->prev->next = cur->next;
-                cur->prev = NULL;
-                firstEntry->prev = cur;
-                cur->next = firstEntry;
-                firstEntry = cur;
-
-#ifdef DEBUG_PROXY_POOL
-                CheckLinks();
-#endif
+                Unlink(shard, found);
+                Prepend(shard, found);
             }
-
-            cur->refCount ++;
-            return cur;
+            found->refCount ++;
+            found->lastUse = CPLAtomicInc(&useCounter);
+            shard->nHits ++;
+            return found;
         }
-
-        if (cur->refCount == 0)
-            lastEntryWithZeroRefCount = cur;
-
-        cur = next;
     }
 
-    if (currentSize == maxSize)
+/* -------------------------------------------------------------------- */
+/*      Reserve a place in the pool, by closing the least recently      */
+/*      used dataset if the pool is full.                               */
+/*      Slots held by datasets being opened or closed by other threads  */
+/*      are not visible to the scan, so give them a short while to      */
+/*      settle before concluding that the pool is really exhausted.     */
+/* -------------------------------------------------------------------- */
+    int nAttempts = 0;
+    while (!ReserveSlot())
     {
-        if (lastEntryWithZeroRefCount == NULL)
+        GDALProxyPoolCacheEntry* evicted = EvictLRUEntry();
+        if (evicted != NULL)
+        {
+            /* The new entry takes the place of the evicted one */
+            CloseEntry(evicted);
+            break;
+        }
+        if (++nAttempts == 100)
         {
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Too many threads are running for the current value of the dataset pool size (%d).\n"
@@ -246,74 +559,69 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
                      "Try increasing GDAL_MAX_DATASET_POOL_SIZE.", maxSize);
             return NULL;
         }
+        CPLSleep(0.001);
+    }
 
-        lastEntryWithZeroRefCount->pszFileName[0] = '\0';
-        if (lastEntryWithZeroRefCount->poDS)
-        {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(lastEntryWithZeroRefCount->responsiblePID);
+/* -------------------------------------------------------------------- */
+/*      Open the dataset without holding any lock.                      */
+/* -------------------------------------------------------------------- */
+    int* pnDisableRefCount = GDALDatasetPoolGetThreadDisableRefCount();
+    (*pnDisableRefCount) ++;
+    int nFlag = ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) | GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
+    GDALDataset* poDS = (GDALDataset*) GDALOpenEx( pszFileName, nFlag, NULL,
+                           (const char* const* )papszOpenOptions, NULL );
+    (*pnDisableRefCount) --;
 
-            refCountOfDisableRefCount ++;
-            GDALClose(lastEntryWithZeroRefCount->poDS);
-            refCountOfDisableRefCount --;
+    GDALProxyPoolCacheEntry* cur =
+        (GDALProxyPoolCacheEntry*) CPLMalloc(sizeof(GDALProxyPoolCacheEntry));
+    cur->pszFileName = CPLStrdup(pszFileName);
+    cur->responsiblePID = responsiblePID;
+    cur->poDS = poDS;
+    cur->refCount = 1;
+    cur->lastUse = CPLAtomicInc(&useCounter);
 
-            lastEntryWithZeroRefCount->poDS = NULL;
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-        }
-        CPLFree(lastEntryWithZeroRefCount->pszFileName);
-
-        /* Recycle this entry for the to-be-opened dataset and */
-        /* moves it to the top of the list */
-        if (lastEntryWithZeroRefCount->prev)
-            lastEntryWithZeroRefCount->prev->next = lastEntryWithZeroRefCount->next;
-        else {
-            CPLAssert(0);
+    GDALProxyPoolCacheEntry* other = NULL;
+    {
+        CPLMutexHolderD( &shard->hMutex );
+        shard->nOpens ++;
+
+        if (bShared)
+        {
+            for( other = shard->firstEntry; other; other = other->next )
+            {
+                if (other->responsiblePID == responsiblePID &&
+                    strcmp(other->pszFileName, pszFileName) == 0)
+                    break;
+            }
         }
-        if (lastEntryWithZeroRefCount->next)
-            lastEntryWithZeroRefCount->next->prev = lastEntryWithZeroRefCount->prev;
-        else
+
+        if (other == NULL)
         {
-            CPLAssert(lastEntryWithZeroRefCount == lastEntry);
-            lastEntry->prev->next = NULL;
-            lastEntry = lastEntry->prev;
+            Prepend(shard, cur);
+            return cur;
         }
-        lastEntryWithZeroRefCount->prev = NULL;
-        lastEntryWithZeroRefCount->next = firstEntry;
-        firstEntry->prev = lastEntryWithZeroRefCount;
-        cur = firstEntry = lastEntryWithZeroRefCount;
-#ifdef DEBUG_PROXY_POOL
-        CheckLinks();
-#endif
-    }
-    else
-    {
-        /* Prepend */
-        cur = (GDALProxyPoolCacheEntry*) CPLMalloc(sizeof(GDALProxyPoolCacheEntry));
-        if (lastEntry == NULL)
-            lastEntry = cur;
-        cur->prev = NULL;
-        cur->next = firstEntry;
-        if (firstEntry)
-            firstEntry->prev = cur;
-        firstEntry = cur;
-        currentSize ++;
-#ifdef DEBUG_PROXY_POOL
-        CheckLinks();
-#endif
+
+        other->refCount ++;
+        other->lastUse = cur->lastUse;
+        shard->nCloses ++;
     }
 
-    cur->pszFileName = CPLStrdup(pszFileName);
-    cur->responsiblePID = responsiblePID;
-    cur->refCount = 1;
+    /* Another thread has opened the same shared dataset meanwhile. */
+    /* Use its entry, and close ours. */
+    ReleaseSlot();
+    CloseEntry(cur);
+    return other;
+}
 
-    refCountOfDisableRefCount ++;
-    int nFlag = ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) | GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
-    cur->poDS = (GDALDataset*) GDALOpenEx( pszFileName, nFlag, NULL,
-                           (const char* const* )papszOpenOptions, NULL );
-    refCountOfDisableRefCount --;
+/************************************************************************/
+/*                           _UnrefDataset()                            */
+/************************************************************************/
 
-    return cur;
+void GDALDatasetPool::_UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
+{
+    GDALDatasetPoolShard* shard = GetShard(cacheEntry->pszFileName);
+    CPLMutexHolderD( &shard->hMutex );
+    cacheEntry->refCount --;
 }
 
 /************************************************************************/
@@ -322,33 +630,42 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
 
 void GDALDatasetPool::_CloseDataset(const char* pszFileName, CPL_UNUSED GDALAccess eAccess)
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    GDALDatasetPoolShard* shard = GetShard(pszFileName);
+    GDALProxyPoolCacheEntry* cur;
 
-    while(cur)
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
-
-        CPLAssert(cur->pszFileName);
-        if (strcmp(cur->pszFileName, pszFileName) == 0 && cur->refCount == 0 &&
-            cur->poDS != NULL )
+        CPLMutexHolderD( &shard->hMutex );
+        for( cur = shard->firstEntry; cur; cur = cur->next )
         {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
-
-            refCountOfDisableRefCount ++;
-            GDALClose(cur->poDS);
-            refCountOfDisableRefCount --;
+            if (strcmp(cur->pszFileName, pszFileName) == 0 &&
+                cur->refCount == 0 && cur->poDS != NULL)
+                break;
+        }
+        if (cur == NULL)
+            return;
+        Unlink(shard, cur);
+        shard->nCloses ++;
+    }
 
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
+    CloseEntry(cur);
+    ReleaseSlot();
+}
 
-            cur->poDS = NULL;
-            cur->pszFileName[0] = '\0';
-            break;
-        }
+/************************************************************************/
+/*                          _GetStatistics()                            */
+/************************************************************************/
 
-        cur = next;
+void GDALDatasetPool::_GetStatistics(GIntBig* pnHits, GIntBig* pnOpens,
+                                     GIntBig* pnCloses, GIntBig* pnEvictions)
+{
+    *pnHits = *pnOpens = *pnCloses = *pnEvictions = 0;
+    for( int i = 0; i < GDAL_DATASET_POOL_SHARD_COUNT; i++ )
+    {
+        CPLMutexHolderD( &asShards[i].hMutex );
+        *pnHits += asShards[i].nHits;
+        *pnOpens += asShards[i].nOpens;
+        *pnCloses += asShards[i].nCloses;
+        *pnEvictions += asShards[i].nEvictions;
     }
 }
 
@@ -361,12 +678,24 @@ void GDALDatasetPool::Ref()
     CPLMutexHolderD( GDALGetphDLMutex() );
     if (singleton == NULL)
     {
+        /* Keep some margin for the shared libraries, the files opened */
+        /* by the application, and the datasets using several files. */
+        const int maxAllowedSize =
+            MAX(1000, GDALDatasetPoolGetFileLimit() / 4 * 3);
         int maxSize = atoi(CPLGetConfigOption("GDAL_MAX_DATASET_POOL_SIZE", "100"));
-        if (maxSize < 2 || maxSize > 1000)
+        if (maxSize < 2)
             maxSize = 100;
+        else if (maxSize > maxAllowedSize)
+        {
+            CPLDebug("GDAL", "GDAL_MAX_DATASET_POOL_SIZE limited to %d "
+                     "due to the maximum number of open files",
+                     maxAllowedSize);
+            maxSize = maxAllowedSize;
+        }
         singleton = new GDALDatasetPool(maxSize);
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (singleton->refCountOfDisableRefCount == 0 &&
+        *GDALDatasetPoolGetThreadDisableRefCount() == 0)
       singleton->refCount++;
 }
 
@@ -400,7 +729,8 @@ void GDALDatasetPool::Unref()
         CPLAssert(0);
         return;
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (singleton->refCountOfDisableRefCount == 0 &&
+        *GDALDatasetPoolGetThreadDisableRefCount() == 0)
     {
       singleton->refCount--;
       if (singleton->refCount == 0)
@@ -441,7 +771,6 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName,
                                                      char** papszOpenOptions,
                                                      int bShared)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
     return singleton->_RefDataset(pszFileName, eAccess, papszOpenOptions, bShared);
 }
 
@@ -451,8 +780,7 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName,
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
-    cacheEntry->refCount --;
+    singleton->_UnrefDataset(cacheEntry);
 }
 
 /************************************************************************/
@@ -461,10 +789,64 @@ void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
 
 void GDALDatasetPool::CloseDataset(const char* pszFileName, GDALAccess eAccess)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
     singleton->_CloseDataset(pszFileName, eAccess);
 }
 
+/************************************************************************/
+/*                          GetStatistics()                             */
+/************************************************************************/
+
+void GDALDatasetPool::GetStatistics(GIntBig* pnHits, GIntBig* pnOpens,
+                                    GIntBig* pnCloses, GIntBig* pnEvictions)
+{
+    CPLMutexHolderD( GDALGetphDLMutex() );
+    if (singleton)
+        singleton->_GetStatistics(pnHits, pnOpens, pnCloses, pnEvictions);
+    else
+        *pnHits = *pnOpens = *pnCloses = *pnEvictions = 0;
+    *pnHits += nPreviousPoolsHits;
+    *pnOpens += nPreviousPoolsOpens;
+    *pnCloses += nPreviousPoolsCloses;
+    *pnEvictions += nPreviousPoolsEvictions;
+}
+
+/************************************************************************/
+/*                     GDALProxyPoolGetStatistics()                     */
+/************************************************************************/
+
+/**
+ * Return counters of the activity of the pool of datasets opened by
+ * GDALProxyPoolDataset objects (used for example by the VRT sources) since
+ * the start of the process.
+ *
+ * A high number of evictions compared to the number of hits means that the
+ * pool is too small for the working set of datasets, and that
+ * GDAL_MAX_DATASET_POOL_SIZE should be increased.
+ *
+ * @param pnHits number of requests served by an already opened dataset,
+ * or NULL.
+ * @param pnOpens number of datasets opened, or NULL.
+ * @param pnCloses number of datasets closed, or NULL.
+ * @param pnEvictions number of datasets closed to make room for another
+ * one, or NULL.
+ *
+ * @since GDAL 2.1
+ */
+void GDALProxyPoolGetStatistics(GIntBig* pnHits, GIntBig* pnOpens,
+                                GIntBig* pnCloses, GIntBig* pnEvictions)
+{
+    GIntBig nHits, nOpens, nCloses, nEvictions;
+    GDALDatasetPool::GetStatistics(&nHits, &nOpens, &nCloses, &nEvictions);
+    if (pnHits)
+        *pnHits = nHits;
+    if (pnOpens)
+        *pnOpens = nOpens;
+    if (pnCloses)
+        *pnCloses = nCloses;
+    if (pnEvictions)
+        *pnEvictions = nEvictions;
+}
+
 CPL_C_START
 
 typedef struct
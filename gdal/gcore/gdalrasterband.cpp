@@ -966,6 +966,58 @@ CPLErr GDALRasterBand::FlushBlock( int nXBlockOff, int nYBlockOff,
     return poBandBlockCache->FlushBlock( nXBlockOff, nYBlockOff, bWriteDirtyBlock );
 }
 
+/************************************************************************/
+/*                      GetBlockCacheStatistics()                       */
+/************************************************************************/
+
+/**
+ * \brief Get statistics on the cached blocks of this band.
+ *
+ * The counters cover the blocks of the band since its block cache has
+ * been initialized, which happens on the first access to its blocks. The
+ * lock related members of the structure are set to 0: use
+ * GDALGetBlockCacheStatistics() for them.
+ *
+ * This method is the same as the C function
+ * GDALGetRasterBandBlockCacheStatistics().
+ *
+ * @param psStats the structure to fill.
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALRasterBand::GetBlockCacheStatistics(
+                                GDALBlockCacheStatistics* psStats ) const
+
+{
+    if( poBandBlockCache != NULL )
+        *psStats = *(poBandBlockCache->GetStatisticsRef());
+    else
+        memset(psStats, 0, sizeof(GDALBlockCacheStatistics));
+}
+
+/************************************************************************/
+/*               GDALGetRasterBandBlockCacheStatistics()                */
+/************************************************************************/
+
+/**
+ * \brief Get statistics on the cached blocks of a raster band.
+ *
+ * @see GDALRasterBand::GetBlockCacheStatistics()
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALGetRasterBandBlockCacheStatistics(
+                    GDALRasterBandH hBand, GDALBlockCacheStatistics* psStats )
+
+{
+    VALIDATE_POINTER0( hBand, "GDALGetRasterBandBlockCacheStatistics" );
+    VALIDATE_POINTER0( psStats, "GDALGetRasterBandBlockCacheStatistics" );
+
+    ((GDALRasterBand *) hBand)->GetBlockCacheStatistics( psStats );
+}
+
 /************************************************************************/
 /*                        TryGetLockedBlockRef()                        */
 /************************************************************************/
@@ -1147,6 +1199,8 @@ GDALRasterBlock * GDALRasterBand::GetLockedBlockRef( int nXBlockOff,
 
         if( !bJustInitialize )
         {
+            poBlock->RecordBlockRead();
+
             nBlockReads++;
             if( nBlockReads == nBlocksPerRow * nBlocksPerColumn + 1 
                 && nBand == 1 && poDS != NULL )
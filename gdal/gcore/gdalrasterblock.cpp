@@ -32,19 +32,76 @@
 #include "gdal_priv.h"
 #include "cpl_multiproc.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
 CPL_CVSID("$Id$");
 
 static bool bCacheMaxInitialized = false;
 static GIntBig nCacheMax = 40 * 1024*1024; /* Will later be overriden by the default 5% if GDAL_CACHEMAX not defined */
-static volatile GIntBig nCacheUsed = 0;
+/* -------------------------------------------------------------------- */
+/*      The LRU list of cached blocks is split into several shards,     */
+/*      each one protected by its own lock, so that threads working     */
+/*      on different datasets do not serialize on a single mutex.       */
+/*      All the blocks of a dataset go into the same shard. Blocks      */
+/*      are stamped with a global touch counter so that eviction can    */
+/*      pick the shard whose least recently used block is the oldest,   */
+/*      which approximates a global LRU. The memory used by the cache   */
+/*      is the sum of the per-shard usages, checked against             */
+/*      GDAL_CACHEMAX without taking all the locks.                     */
+/*                                                                      */
+/*      Blocks also have an eviction rank derived from the cache        */
+/*      priority of their dataset: the blocks of streaming datasets     */
+/*      are evicted before the normal ones, which are evicted before    */
+/*      the ones of hot datasets.                                       */
+/* -------------------------------------------------------------------- */
+
+#define GDAL_RB_MAX_SHARDS      64
+
+#define GDAL_RB_RANK_STREAMING  0
+#define GDAL_RB_RANK_NORMAL     1
+#define GDAL_RB_RANK_HOT        2
+#define GDAL_RB_RANK_COUNT      3
+
+typedef struct
+{
+    CPLLock         *hLock;
+    volatile int     nLockUsers;       /* threads holding or waiting for hLock */
+
+    GDALRasterBlock *poOldest;         /* tail */
+    GDALRasterBlock *poNewest;         /* head */
+    volatile int     nOldestTouch;     /* touch stamp of poOldest */
 
-static GDALRasterBlock *poOldest = NULL;    /* tail */
-static GDALRasterBlock *poNewest = NULL;    /* head */
+    volatile GIntBig nCacheUsed;
+    volatile GIntBig anCacheUsedPerRank[GDAL_RB_RANK_COUNT];
+
+    /* Lock statistics, updated while holding hLock */
+    GIntBig          nLockAcquisitions;
+    GIntBig          nLockContentions;
+    double           dfLockWaitTime;
+
+    /* Cache statistics, updated while holding hLock */
+    GIntBig          nHits;
+    GIntBig          nMisses;
+    GIntBig          nBytesRead;
+    GIntBig          nEvictions;
+    GIntBig          nDirtyFlushes;
+
+    /* Avoid false sharing between the shards of the array */
+    char             abyPadding[64];
+} GDALRBShard;
+
+static GDALRBShard asShards[GDAL_RB_MAX_SHARDS];
+static volatile int nShards = 0;
+static volatile int nTouchCounter = 0;
+static volatile GIntBig nCacheHighWaterMark = 0;
 
 #if 0
 static CPLMutex *hRBLock = NULL;
 #define INITIALIZE_LOCK         CPLMutexHolderD( &hRBLock )
-#define TAKE_LOCK               CPLMutexHolderOptionalLockD( hRBLock )
 #define DESTROY_LOCK            CPLDestroyMutex( hRBLock )
 #else
 
@@ -77,11 +134,211 @@ static CPLLockType GetLockType()
 
 #define INITIALIZE_LOCK         CPLLockHolderD( &hRBLock, GetLockType() ); \
                                 CPLLockSetDebugPerf(hRBLock, bDebugContention)
-#define TAKE_LOCK               CPLLockHolderOptionalLockD( hRBLock )
 #define DESTROY_LOCK            CPLDestroyLock( hRBLock )
 
 #endif
 
+/************************************************************************/
+/*                          GDALRBGetTime()                             */
+/************************************************************************/
+
+/* Only used to measure the time spent waiting for a contended shard lock */
+static double GDALRBGetTime()
+{
+#ifdef _WIN32
+    return GetTickCount() / 1000.0;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+#endif
+}
+
+/************************************************************************/
+/*                       GDALRBShardLockHolder                          */
+/************************************************************************/
+
+class GDALRBShardLockHolder
+{
+    GDALRBShard *psShard;
+
+  public:
+    explicit GDALRBShardLockHolder( GDALRBShard* psShardIn ) :
+        psShard(psShardIn)
+    {
+        /* Like CPLLockHolderOptionalLockD(), this is a no-op if the */
+        /* locks have not been created (or have been destroyed) */
+        if( psShard->hLock == NULL )
+        {
+            psShard = NULL;
+            return;
+        }
+
+        /* If another thread holds or waits for the lock, we will have */
+        /* to wait, so measure how long it takes. */
+        const bool bContended = CPLAtomicInc(&(psShard->nLockUsers)) > 1;
+        const double dfStart = bContended ? GDALRBGetTime() : 0.0;
+        CPLAcquireLock( psShard->hLock );
+        psShard->nLockAcquisitions ++;
+        if( bContended )
+        {
+            psShard->nLockContentions ++;
+            psShard->dfLockWaitTime += GDALRBGetTime() - dfStart;
+        }
+    }
+
+    ~GDALRBShardLockHolder()
+    {
+        if( psShard != NULL )
+        {
+            CPLReleaseLock( psShard->hLock );
+            CPLAtomicDec(&(psShard->nLockUsers));
+        }
+    }
+};
+
+#define TAKE_SHARD_LOCK(psShard) GDALRBShardLockHolder oShardHolder(psShard)
+
+/************************************************************************/
+/*                          GDALRBInitShards()                          */
+/************************************************************************/
+
+static void GDALRBInitShards()
+{
+    INITIALIZE_LOCK;
+
+    if( nShards > 0 )
+        return;
+
+/* -------------------------------------------------------------------- */
+/*      By default, use as many shards as CPUs, but not more than 16,   */
+/*      so that the per-shard LRU lists remain long enough for the      */
+/*      eviction order to be close to a global LRU.                     */
+/* -------------------------------------------------------------------- */
+    const char* pszShards = CPLGetConfigOption("GDAL_RB_SHARDS", "AUTO");
+    int nNewShards;
+    if( EQUAL(pszShards, "AUTO") )
+        nNewShards = MIN(16, CPLGetNumCPUs());
+    else
+        nNewShards = atoi(pszShards);
+    if( nNewShards < 1 )
+        nNewShards = 1;
+    else if( nNewShards > GDAL_RB_MAX_SHARDS )
+        nNewShards = GDAL_RB_MAX_SHARDS;
+
+    for( int i = 0; i < nNewShards; i++ )
+    {
+        GDALRBShard* psShard = &asShards[i];
+        psShard->hLock = CPLCreateLock(GetLockType());
+        if( psShard->hLock != NULL )
+            CPLLockSetDebugPerf(psShard->hLock, bDebugContention);
+        psShard->nLockUsers = 0;
+        psShard->poOldest = NULL;
+        psShard->poNewest = NULL;
+        psShard->nOldestTouch = 0;
+        psShard->nCacheUsed = 0;
+        for( int iRank = 0; iRank < GDAL_RB_RANK_COUNT; iRank++ )
+            psShard->anCacheUsedPerRank[iRank] = 0;
+        psShard->nLockAcquisitions = 0;
+        psShard->nLockContentions = 0;
+        psShard->dfLockWaitTime = 0.0;
+        psShard->nHits = 0;
+        psShard->nMisses = 0;
+        psShard->nBytesRead = 0;
+        psShard->nEvictions = 0;
+        psShard->nDirtyFlushes = 0;
+    }
+
+    nShards = nNewShards;
+}
+
+/************************************************************************/
+/*                         GDALRBGetShardIdx()                          */
+/************************************************************************/
+
+static int GDALRBGetShardIdx( GDALRasterBand* poBand )
+{
+    if( nShards == 0 )
+        GDALRBInitShards();
+    if( nShards == 1 )
+        return 0;
+
+    /* Blocks of all the bands of a dataset go into the same shard, so */
+    /* that the eviction order among them is unchanged. */
+    GDALDataset* poDS = poBand->GetDataset();
+    const GUIntBig nPtr = (poDS != NULL) ? (GUIntBig)(size_t)poDS :
+                                           (GUIntBig)(size_t)poBand;
+    GUIntBig nHash = nPtr / sizeof(void*);
+    nHash ^= nHash >> 17;
+    nHash *= 0x9E3779B1U;
+    nHash ^= nHash >> 15;
+    return (int)(nHash % nShards);
+}
+
+/************************************************************************/
+/*                        GDALRBGetCacheUsed()                          */
+/************************************************************************/
+
+/* Approximate as the shards are not locked */
+static GIntBig GDALRBGetCacheUsed()
+{
+    GIntBig nTotal = 0;
+    for( int i = 0; i < nShards; i++ )
+        nTotal += asShards[i].nCacheUsed;
+    return nTotal;
+}
+
+/************************************************************************/
+/*                     GDALRBSelectEvictionShard()                      */
+/************************************************************************/
+
+/* Returns the index of the non-exhausted shard, with blocks of rank lower */
+/* or equal to nMaxRank, whose least recently used block is the oldest, or */
+/* -1 if there is none. */
+static int GDALRBSelectEvictionShard( const bool* pabExhausted, int nMaxRank )
+{
+    const unsigned int nNow = (unsigned int)nTouchCounter;
+    int iBest = -1;
+    unsigned int nBestAge = 0;
+    for( int i = 0; i < nShards; i++ )
+    {
+        if( pabExhausted[i] || asShards[i].poOldest == NULL )
+            continue;
+        GIntBig nCandidateBytes = 0;
+        for( int iRank = 0; iRank <= nMaxRank; iRank++ )
+            nCandidateBytes += asShards[i].anCacheUsedPerRank[iRank];
+        if( nCandidateBytes <= 0 )
+            continue;
+        const unsigned int nAge = nNow - (unsigned int)asShards[i].nOldestTouch;
+        if( iBest < 0 || nAge > nBestAge )
+        {
+            iBest = i;
+            nBestAge = nAge;
+        }
+    }
+    return iBest;
+}
+
+/************************************************************************/
+/*                           GDALRBGetRank()                            */
+/************************************************************************/
+
+static int GDALRBGetRank( GDALRasterBand* poBand )
+{
+    GDALDataset* poDS = poBand->GetDataset();
+    if( poDS == NULL )
+        return GDAL_RB_RANK_NORMAL;
+    switch( poDS->GetBlockCachePriority() )
+    {
+        case GBCP_Streaming:
+            return GDAL_RB_RANK_STREAMING;
+        case GBCP_Hot:
+            return GDAL_RB_RANK_HOT;
+        default:
+            return GDAL_RB_RANK_NORMAL;
+    }
+}
+
 //#define ENABLE_DEBUG
 
 /************************************************************************/
@@ -145,13 +402,13 @@ void CPL_STDCALL GDALSetCacheMax64( GIntBig nNewSizeInBytes )
 /*      Flush blocks till we are under the new limit or till we         */
 /*      can't seem to flush anymore.                                    */
 /* -------------------------------------------------------------------- */
-    while( nCacheUsed > nCacheMax )
+    while( GDALRBGetCacheUsed() > nCacheMax )
     {
-        GIntBig nOldCacheUsed = nCacheUsed;
+        GIntBig nOldCacheUsed = GDALRBGetCacheUsed();
 
         GDALFlushCacheBlock();
 
-        if( nCacheUsed == nOldCacheUsed )
+        if( GDALRBGetCacheUsed() == nOldCacheUsed )
             break;
     }
 }
@@ -221,9 +478,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 {
     if( !bCacheMaxInitialized )
     {
-        {
-            INITIALIZE_LOCK;
-        }
+        GDALRBInitShards();
         bSleepsForBockCacheDebug = CPL_TO_BOOL(CSLTestBoolean(CPLGetConfigOption("GDAL_DEBUG_BLOCK_CACHE", "NO")));
 
         const char* pszCacheMax = CPLGetConfigOption("GDAL_CACHEMAX","5%");
@@ -281,6 +536,7 @@ GIntBig CPL_STDCALL GDALGetCacheMax64()
 
 int CPL_STDCALL GDALGetCacheUsed()
 {
+    const GIntBig nCacheUsed = GDALRBGetCacheUsed();
     if (nCacheUsed > INT_MAX)
     {
         static bool bHasWarned = false;
@@ -311,7 +567,56 @@ int CPL_STDCALL GDALGetCacheUsed()
 
 GIntBig CPL_STDCALL GDALGetCacheUsed64()
 {
-    return nCacheUsed;
+    return GDALRBGetCacheUsed();
+}
+
+/************************************************************************/
+/*                    GDALGetBlockCacheStatistics()                     */
+/************************************************************************/
+
+/**
+ * \brief Get statistics on the block cache.
+ *
+ * The statistics cover all the datasets since the start of the process or
+ * the last call to GDALResetBlockCacheStatistics(): number of block
+ * requests served from the cache (hits) or requiring a new block (misses),
+ * number of bytes read from the drivers, number of evictions and of dirty
+ * blocks written when evicted, current and maximum memory usage, and usage
+ * and contention of the locks of the cache. Per-dataset and per-band
+ * statistics can be retrieved with GDALDatasetGetBlockCacheStatistics() and
+ * GDALGetRasterBandBlockCacheStatistics().
+ *
+ * The values are approximate when other threads use the cache.
+ *
+ * @param psStats the structure to fill.
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALGetBlockCacheStatistics( GDALBlockCacheStatistics* psStats )
+
+{
+    VALIDATE_POINTER0( psStats, "GDALGetBlockCacheStatistics" );
+
+    GDALRasterBlock::GetCacheStatistics( psStats );
+}
+
+/************************************************************************/
+/*                   GDALResetBlockCacheStatistics()                    */
+/************************************************************************/
+
+/**
+ * \brief Reset the counters of the block cache statistics.
+ *
+ * @see GDALGetBlockCacheStatistics()
+ *
+ * @since GDAL 2.1
+ */
+
+void CPL_STDCALL GDALResetBlockCacheStatistics()
+
+{
+    GDALRasterBlock::ResetCacheStatistics();
 }
 
 /************************************************************************/
@@ -391,15 +696,40 @@ int CPL_STDCALL GDALFlushCacheBlock()
 int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
 
 {
-    GDALRasterBlock *poTarget;
+    GDALRasterBlock *poTarget = NULL;
 
+    if( nShards == 0 )
+        GDALRBInitShards();
+
+/* -------------------------------------------------------------------- */
+/*      Visit the shards from the one with the oldest block to the one  */
+/*      with the most recent one, until a flushable block is found,     */
+/*      first considering only the blocks of streaming datasets, then   */
+/*      the normal ones, and eventually the hot ones.                   */
+/* -------------------------------------------------------------------- */
+    bool abExhausted[GDAL_RB_MAX_SHARDS];
+    int nMaxRank = GDAL_RB_RANK_STREAMING;
+    memset(abExhausted, 0, sizeof(abExhausted));
+    while( poTarget == NULL )
     {
-        INITIALIZE_LOCK;
-        poTarget = poOldest;
+        const int iShard = GDALRBSelectEvictionShard(abExhausted, nMaxRank);
+        if( iShard < 0 )
+        {
+            if( nMaxRank == GDAL_RB_RANK_HOT )
+                return FALSE;
+            nMaxRank ++;
+            memset(abExhausted, 0, sizeof(abExhausted));
+            continue;
+        }
+        abExhausted[iShard] = true;
+
+        TAKE_SHARD_LOCK(&asShards[iShard]);
+        poTarget = asShards[iShard].poOldest;
 
         while( poTarget != NULL )
         {
-            if( !bDirtyBlocksOnly || poTarget->GetDirty() )
+            if( poTarget->nCacheRank <= nMaxRank &&
+                (!bDirtyBlocksOnly || poTarget->GetDirty()) )
             {
                 if( CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1) )
                     break;
@@ -408,10 +738,11 @@ int GDALRasterBlock::FlushCacheBlock(int bDirtyBlocksOnly)
         }
 
         if( poTarget == NULL )
-            return FALSE;
+            continue;
         if( bSleepsForBockCacheDebug )
             CPLSleep(CPLAtof(CPLGetConfigOption("GDAL_RB_FLUSHBLOCK_SLEEP_AFTER_DROP_LOCK", "0")));
 
+        poTarget->RecordEviction_unlocked();
         poTarget->Detach_unlocked();
         poTarget->GetBand()->UnreferenceBlock(poTarget);
     }
@@ -501,6 +832,10 @@ GDALRasterBlock::GDALRasterBlock( GDALRasterBand *poBandIn,
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = TRUE;
+
+    nCacheShard = GDALRBGetShardIdx(poBand);
+    nTouchStamp = 0;
+    nCacheRank = GDAL_RB_RANK_NORMAL;
 }
 
 /************************************************************************/
@@ -536,6 +871,10 @@ GDALRasterBlock::GDALRasterBlock( int nXOffIn, int nYOffIn )
     nXOff = nXOffIn;
     nYOff = nYOffIn;
     bMustDetach = FALSE;
+
+    nCacheShard = 0;
+    nTouchStamp = 0;
+    nCacheRank = GDAL_RB_RANK_NORMAL;
 }
 
 /************************************************************************/
@@ -607,19 +946,25 @@ void GDALRasterBlock::Detach()
 {
     if( bMustDetach )
     {
-        TAKE_LOCK;
+        TAKE_SHARD_LOCK(&asShards[nCacheShard]);
         Detach_unlocked();
     }
 }
 
 void GDALRasterBlock::Detach_unlocked()
 {
-    if( poOldest == this )
-        poOldest = poPrevious;
+    GDALRBShard* psShard = &asShards[nCacheShard];
+
+    if( psShard->poOldest == this )
+    {
+        psShard->poOldest = poPrevious;
+        if( poPrevious != NULL )
+            psShard->nOldestTouch = poPrevious->nTouchStamp;
+    }
 
-    if( poNewest == this )
+    if( psShard->poNewest == this )
     {
-        poNewest = poNext;
+        psShard->poNewest = poNext;
     }
 
     if( poPrevious != NULL )
@@ -633,7 +978,7 @@ void GDALRasterBlock::Detach_unlocked()
     bMustDetach = FALSE;
 
     if( pData )
-        nCacheUsed -= GetBlockSize();
+        UpdateCacheUsed_unlocked( -GetBlockSize() );
 
 #ifdef ENABLE_DEBUG
     Verify();
@@ -653,27 +998,32 @@ void GDALRasterBlock::Detach_unlocked()
 void GDALRasterBlock::Verify()
 
 {
-    TAKE_LOCK;
-
-    CPLAssert( (poNewest == NULL && poOldest == NULL)
-               || (poNewest != NULL && poOldest != NULL) );
-
-    if( poNewest != NULL )
+    for( int iShard = 0; iShard < nShards; iShard++ )
     {
-        CPLAssert( poNewest->poPrevious == NULL );
-        CPLAssert( poOldest->poNext == NULL );
+        GDALRBShard* psShard = &asShards[iShard];
+        TAKE_SHARD_LOCK(psShard);
 
-        GDALRasterBlock* poLast = NULL;
-        for( GDALRasterBlock *poBlock = poNewest;
-             poBlock != NULL;
-             poBlock = poBlock->poNext )
+        CPLAssert( (psShard->poNewest == NULL && psShard->poOldest == NULL)
+                || (psShard->poNewest != NULL && psShard->poOldest != NULL) );
+
+        if( psShard->poNewest != NULL )
         {
-            CPLAssert( poBlock->poPrevious == poLast );
+            CPLAssert( psShard->poNewest->poPrevious == NULL );
+            CPLAssert( psShard->poOldest->poNext == NULL );
 
-            poLast = poBlock;
-        }
+            GDALRasterBlock* poLast = NULL;
+            for( GDALRasterBlock *poBlock = psShard->poNewest;
+                poBlock != NULL;
+                poBlock = poBlock->poNext )
+            {
+                CPLAssert( poBlock->poPrevious == poLast );
+                CPLAssert( poBlock->nCacheShard == iShard );
+
+                poLast = poBlock;
+            }
 
-        CPLAssert( poOldest == poLast );
+            CPLAssert( psShard->poOldest == poLast );
+        }
     }
 }
 
@@ -684,8 +1034,9 @@ void GDALRasterBlock::Verify() {}
 #ifdef notdef
 void GDALRasterBlock::CheckNonOrphanedBlocks(GDALRasterBand* poBand)
 {
-    TAKE_LOCK;
-    for( GDALRasterBlock *poBlock = poNewest; 
+    GDALRBShard* psShard = &asShards[GDALRBGetShardIdx(poBand)];
+    TAKE_SHARD_LOCK(psShard);
+    for( GDALRasterBlock *poBlock = psShard->poNewest; 
                           poBlock != NULL;
                           poBlock = poBlock->poNext )
     {
@@ -757,7 +1108,7 @@ CPLErr GDALRasterBlock::Write()
 void GDALRasterBlock::Touch()
 
 {
-    TAKE_LOCK;
+    TAKE_SHARD_LOCK(&asShards[nCacheShard]);
     Touch_unlocked();
 }
 
@@ -765,21 +1116,44 @@ void GDALRasterBlock::Touch()
 void GDALRasterBlock::Touch_unlocked()
 
 {
-    if( poNewest == this )
+    GDALRBShard* psShard = &asShards[nCacheShard];
+
+    nTouchStamp = CPLAtomicInc(&nTouchCounter);
+
+    // Follow changes of the cache priority of the dataset
+    if( pData != NULL && bMustDetach )
+    {
+        const int nRank = GDALRBGetRank(poBand);
+        if( nRank != nCacheRank )
+        {
+            psShard->anCacheUsedPerRank[nCacheRank] -= GetBlockSize();
+            psShard->anCacheUsedPerRank[nRank] += GetBlockSize();
+            nCacheRank = nRank;
+        }
+    }
+
+    if( psShard->poNewest == this )
+    {
+        if( psShard->poOldest == this )
+            psShard->nOldestTouch = nTouchStamp;
         return;
+    }
 
     // In theory, we should not try to touch a block that has been detached
     CPLAssert(bMustDetach);
     if( !bMustDetach )
     {
         if( pData )
-            nCacheUsed += GetBlockSize();
+            UpdateCacheUsed_unlocked( GetBlockSize() );
 
         bMustDetach = TRUE;
     }
 
-    if( poOldest == this )
-        poOldest = this->poPrevious;
+    if( psShard->poOldest == this )
+    {
+        psShard->poOldest = this->poPrevious;
+        psShard->nOldestTouch = psShard->poOldest->nTouchStamp;
+    }
 
     if( poPrevious != NULL )
         poPrevious->poNext = poNext;
@@ -788,25 +1162,208 @@ void GDALRasterBlock::Touch_unlocked()
         poNext->poPrevious = poPrevious;
 
     poPrevious = NULL;
-    poNext = poNewest;
+    poNext = psShard->poNewest;
 
-    if( poNewest != NULL )
+    if( psShard->poNewest != NULL )
     {
-        CPLAssert( poNewest->poPrevious == NULL );
-        poNewest->poPrevious = this;
+        CPLAssert( psShard->poNewest->poPrevious == NULL );
+        psShard->poNewest->poPrevious = this;
     }
-    poNewest = this;
+    psShard->poNewest = this;
 
-    if( poOldest == NULL )
+    if( psShard->poOldest == NULL )
     {
         CPLAssert( poPrevious == NULL && poNext == NULL );
-        poOldest = this;
+        psShard->poOldest = this;
+        psShard->nOldestTouch = nTouchStamp;
     }
 #ifdef ENABLE_DEBUG
     Verify();
 #endif
 }
 
+/************************************************************************/
+/*                       UpdateCacheUsed_unlocked()                     */
+/************************************************************************/
+
+/* Must be called with the lock of the shard of the block held */
+void GDALRasterBlock::UpdateCacheUsed_unlocked( GIntBig nDelta )
+{
+    GDALRBShard* psShard = &asShards[nCacheShard];
+    psShard->nCacheUsed += nDelta;
+    psShard->anCacheUsedPerRank[nCacheRank] += nDelta;
+
+    GDALBlockCacheStatistics* apsStats[2] = { GetDatasetCacheStatistics(),
+                                              GetBandCacheStatistics() };
+    for( int i = 0; i < 2; i++ )
+    {
+        if( apsStats[i] == NULL )
+            continue;
+        apsStats[i]->nCacheUsed += nDelta;
+        if( apsStats[i]->nCacheUsed > apsStats[i]->nCacheHighWaterMark )
+            apsStats[i]->nCacheHighWaterMark = apsStats[i]->nCacheUsed;
+    }
+}
+
+/************************************************************************/
+/*                     GetDatasetCacheStatistics()                      */
+/************************************************************************/
+
+/* Returns the cache statistics of the dataset of the block, or NULL. */
+/* They must only be modified with the lock of the shard of the block held */
+GDALBlockCacheStatistics* GDALRasterBlock::GetDatasetCacheStatistics()
+{
+    GDALDataset* poDS = poBand->GetDataset();
+    return (poDS != NULL) ? poDS->GetBlockCacheStatisticsRef() : NULL;
+}
+
+/************************************************************************/
+/*                       GetBandCacheStatistics()                       */
+/************************************************************************/
+
+/* Returns the cache statistics of the band of the block, or NULL. */
+/* They must only be modified with the lock of the shard of the block held */
+GDALBlockCacheStatistics* GDALRasterBlock::GetBandCacheStatistics()
+{
+    return (poBand->poBandBlockCache != NULL) ?
+                poBand->poBandBlockCache->GetStatisticsRef() : NULL;
+}
+
+/************************************************************************/
+/*                      RecordEviction_unlocked()                       */
+/************************************************************************/
+
+/* Must be called with the lock of the shard of the block held */
+void GDALRasterBlock::RecordEviction_unlocked()
+{
+    GDALRBShard* psShard = &asShards[nCacheShard];
+    GDALBlockCacheStatistics* psDSStats = GetDatasetCacheStatistics();
+    GDALBlockCacheStatistics* psBandStats = GetBandCacheStatistics();
+    psShard->nEvictions ++;
+    if( psDSStats != NULL )
+        psDSStats->nEvictions ++;
+    if( psBandStats != NULL )
+        psBandStats->nEvictions ++;
+    if( GetDirty() )
+    {
+        psShard->nDirtyFlushes ++;
+        if( psDSStats != NULL )
+            psDSStats->nDirtyFlushes ++;
+        if( psBandStats != NULL )
+            psBandStats->nDirtyFlushes ++;
+    }
+}
+
+/************************************************************************/
+/*                        DetachBlocksToEvict()                         */
+/************************************************************************/
+
+/* Detach from the cache, and unreference from their band, up to 64 of the */
+/* least recently used unlocked blocks of a shard, until the cache usage */
+/* (or the one of poQuotaDS if not NULL) is not above nTargetUsage. */
+/* Only blocks of rank lower or equal to nMaxRank, and belonging to */
+/* poQuotaDS if not NULL, are considered. A dirty block ends the batch. */
+/* *pbExhausted is set if no more candidate block is found. */
+
+int GDALRasterBlock::DetachBlocksToEvict( int iShard, GDALDataset* poQuotaDS,
+                                          int nMaxRank, GIntBig nTargetUsage,
+                                          GDALRasterBlock** papoBlocks,
+                                          bool* pbExhausted )
+{
+    GDALRBShard* psShard = &asShards[iShard];
+    int nBlocks = 0;
+
+    TAKE_SHARD_LOCK(psShard);
+
+    GDALRasterBlock *poTarget = psShard->poOldest;
+    while( (poQuotaDS != NULL ? poQuotaDS->GetBlockCacheUsed() :
+                                GDALRBGetCacheUsed()) > nTargetUsage )
+    {
+        while( poTarget != NULL )
+        {
+            if( poTarget->nCacheRank <= nMaxRank &&
+                (poQuotaDS == NULL ||
+                 poTarget->GetBand()->GetDataset() == poQuotaDS) &&
+                CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1) )
+                break;
+            poTarget = poTarget->poPrevious;
+        }
+
+        if( poTarget == NULL )
+        {
+            *pbExhausted = true;
+            break;
+        }
+
+        if( bSleepsForBockCacheDebug )
+            CPLSleep(CPLAtof(CPLGetConfigOption("GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK", "0")));
+
+        GDALRasterBlock* _poPrevious = poTarget->poPrevious;
+
+        poTarget->RecordEviction_unlocked();
+        poTarget->Detach_unlocked();
+        poTarget->GetBand()->UnreferenceBlock(poTarget);
+
+        papoBlocks[nBlocks++] = poTarget;
+        if( poTarget->GetDirty() )
+        {
+            // Only free one dirty block at a time so that
+            // other dirty blocks of other bands with the same coordinates
+            // can be found with TryGetLockedBlock()
+            break;
+        }
+        if( nBlocks == 64 )
+            break;
+
+        poTarget = _poPrevious;
+    }
+
+    return nBlocks;
+}
+
+/************************************************************************/
+/*                         FreeEvictedBlocks()                          */
+/************************************************************************/
+
+/* Write if needed, and free blocks returned by DetachBlocksToEvict(). */
+/* If *ppNewData is NULL, the data buffer of the first block of */
+/* nSizeInBytes bytes is recycled into it. */
+
+void GDALRasterBlock::FreeEvictedBlocks( GDALRasterBlock** papoBlocks,
+                                         int nBlocks, int nSizeInBytes,
+                                         void** ppNewData )
+{
+    for(int i=0;i<nBlocks;i++)
+    {
+        GDALRasterBlock *poBlock = papoBlocks[i];
+
+        if( poBlock->GetDirty() )
+        {
+            CPLErr eErr = poBlock->Write();
+            if( eErr != CE_None )
+            {
+                /* Save the error for later reporting */
+                poBlock->GetBand()->SetFlushBlockErr(eErr);
+            }
+        }
+
+        /* Try to recycle the data of an existing block */
+        void* pDataBlock = poBlock->pData;
+        if( *ppNewData == NULL && pDataBlock != NULL &&
+            poBlock->GetBlockSize() == nSizeInBytes )
+        {
+            *ppNewData = pDataBlock;
+        }
+        else
+        {
+            VSIFree(poBlock->pData);
+        }
+        poBlock->pData = NULL;
+
+        poBlock->GetBand()->AddBlockToFreeList(poBlock);
+    }
+}
+
 /************************************************************************/
 /*                            Internalize()                             */
 /************************************************************************/
@@ -837,103 +1394,85 @@ CPLErr GDALRasterBlock::Internalize()
     /* No risk of overflow as it is checked in GDALRasterBand::InitBlockInfo() */
     nSizeInBytes = GetBlockSize();
 
-/* -------------------------------------------------------------------- */
-/*      Flush old blocks if we are nearing our memory limit.            */
-/* -------------------------------------------------------------------- */
-    bool bFirstIter = true;
-    bool bLoopAgain = false;
-    do
+    GDALRBShard* psShard = &asShards[nCacheShard];
     {
-        bLoopAgain = false;
-        GDALRasterBlock* apoBlocksToFree[64];
-        int nBlocksToFree = 0;
-        {
-            TAKE_LOCK;
+        TAKE_SHARD_LOCK(psShard);
+        nCacheRank = GDALRBGetRank(poBand);
+        UpdateCacheUsed_unlocked( nSizeInBytes );
+
+        psShard->nMisses ++;
+        GDALBlockCacheStatistics* psDSStats = GetDatasetCacheStatistics();
+        if( psDSStats != NULL )
+            psDSStats->nMisses ++;
+        GDALBlockCacheStatistics* psBandStats = GetBandCacheStatistics();
+        if( psBandStats != NULL )
+            psBandStats->nMisses ++;
+    }
 
-            if( bFirstIter )
-                nCacheUsed += nSizeInBytes;
-            GDALRasterBlock *poTarget = poOldest;
-            while( nCacheUsed > nCurCacheMax )
-            {
-                while( poTarget != NULL ) 
-                {
-                    if( CPLAtomicCompareAndExchange(&(poTarget->nLockCount), 0, -1) )
-                        break;
-                    poTarget = poTarget->poPrevious;
-                }
+    // Racy, but only meant to give an order of magnitude
+    const GIntBig nCacheUsedAfter = GDALRBGetCacheUsed();
+    if( nCacheUsedAfter > nCacheHighWaterMark )
+        nCacheHighWaterMark = nCacheUsedAfter;
 
-                if( poTarget != NULL )
-                {
-                    if( bSleepsForBockCacheDebug )
-                        CPLSleep(CPLAtof(CPLGetConfigOption("GDAL_RB_INTERNALIZE_SLEEP_AFTER_DROP_LOCK", "0")));
-
-                    GDALRasterBlock* _poPrevious = poTarget->poPrevious;
-
-                    poTarget->Detach_unlocked();
-                    poTarget->GetBand()->UnreferenceBlock(poTarget);
-
-                    apoBlocksToFree[nBlocksToFree++] = poTarget;
-                    if( poTarget->GetDirty() )
-                    {
-                        // Only free one dirty block at a time so that
-                        // other dirty blocks of other bands with the same coordinates
-                        // can be found with TryGetLockedBlock()
-                        bLoopAgain = ( nCacheUsed > nCurCacheMax );
-                        break;
-                    }
-                    if( nBlocksToFree == 64 )
-                    {
-                        bLoopAgain = ( nCacheUsed > nCurCacheMax );
-                        break;
-                    }
-
-                    poTarget = _poPrevious;
-                }
-                else
-                    break;
-            }
+    GDALRasterBlock* apoBlocksToFree[64];
 
-        /* -------------------------------------------------------------------- */
-        /*      Add this block to the list.                                     */
-        /* -------------------------------------------------------------------- */
-            if( !bLoopAgain )
-                Touch_unlocked();
+/* -------------------------------------------------------------------- */
+/*      If the dataset has its own cache budget, first evict its        */
+/*      oldest blocks until it fits within it. All the blocks of a      */
+/*      dataset are in the same shard.                                  */
+/* -------------------------------------------------------------------- */
+    GDALDataset* poDS = poBand->GetDataset();
+    const GIntBig nDSCacheMax = (poDS != NULL) ? poDS->GetBlockCacheMax() : 0;
+    if( nDSCacheMax > 0 )
+    {
+        bool bExhausted = false;
+        while( !bExhausted && poDS->GetBlockCacheUsed() > nDSCacheMax )
+        {
+            const int nBlocksToFree =
+                DetachBlocksToEvict( nCacheShard, poDS, GDAL_RB_RANK_HOT,
+                                     nDSCacheMax,
+                                     apoBlocksToFree, &bExhausted );
+            FreeEvictedBlocks( apoBlocksToFree, nBlocksToFree,
+                               nSizeInBytes, &pNewData );
         }
+    }
 
-        bFirstIter = false;
-
-        /* Now free blocks we have detached and removed from their band */
-        for(int i=0;i<nBlocksToFree;i++)
+/* -------------------------------------------------------------------- */
+/*      Flush old blocks if we are nearing our memory limit.            */
+/*      The victims are taken from the shard whose least recently       */
+/*      used block is the oldest, which is not necessarily the shard    */
+/*      of this block. Blocks of streaming datasets go first, and       */
+/*      blocks of hot datasets last.                                    */
+/* -------------------------------------------------------------------- */
+    for( int nMaxRank = GDAL_RB_RANK_STREAMING;
+         nMaxRank <= GDAL_RB_RANK_HOT && GDALRBGetCacheUsed() > nCurCacheMax;
+         nMaxRank++ )
+    {
+        bool abExhausted[GDAL_RB_MAX_SHARDS];
+        memset(abExhausted, 0, sizeof(abExhausted));
+        while( GDALRBGetCacheUsed() > nCurCacheMax )
         {
-            GDALRasterBlock *poBlock = apoBlocksToFree[i];
-
-            if( poBlock->GetDirty() )
-            {
-                CPLErr eErr = poBlock->Write();
-                if( eErr != CE_None )
-                {
-                    /* Save the error for later reporting */
-                    poBlock->GetBand()->SetFlushBlockErr(eErr);
-                }
-            }
-
-            /* Try to recycle the data of an existing block */
-            void* pDataBlock = poBlock->pData;
-            if( pNewData == NULL && pDataBlock != NULL &&
-                poBlock->GetBlockSize() == nSizeInBytes )
-            {
-                pNewData = pDataBlock;
-            }
-            else
-            {
-                VSIFree(poBlock->pData);
-            }
-            poBlock->pData = NULL;
-
-            poBlock->GetBand()->AddBlockToFreeList(poBlock);
+            const int iVictimShard =
+                GDALRBSelectEvictionShard(abExhausted, nMaxRank);
+            if( iVictimShard < 0 )
+                break;
+
+            const int nBlocksToFree =
+                DetachBlocksToEvict( iVictimShard, NULL, nMaxRank,
+                                     nCurCacheMax, apoBlocksToFree,
+                                     &abExhausted[iVictimShard] );
+            FreeEvictedBlocks( apoBlocksToFree, nBlocksToFree,
+                               nSizeInBytes, &pNewData );
         }
     }
-    while(bLoopAgain);
+
+/* -------------------------------------------------------------------- */
+/*      Add this block to the list.                                     */
+/* -------------------------------------------------------------------- */
+    {
+        TAKE_SHARD_LOCK(psShard);
+        Touch_unlocked();
+    }
 
     if( pNewData == NULL )
     {
@@ -990,11 +1529,132 @@ void GDALRasterBlock::MarkClean()
 
 void GDALRasterBlock::DestroyRBMutex()
 {
+    for( int i = 0; i < nShards; i++ )
+    {
+        if( asShards[i].hLock != NULL )
+            CPLDestroyLock( asShards[i].hLock );
+        asShards[i].hLock = NULL;
+    }
+    nShards = 0;
+
     if( hRBLock != NULL )
         DESTROY_LOCK;
     hRBLock = NULL;
 }
 
+/************************************************************************/
+/*                         GetLockStatistics()                          */
+/************************************************************************/
+
+/**
+ * Return statistics on the locks protecting the block cache.
+ *
+ * The block cache is split into several shards (see the GDAL_RB_SHARDS
+ * configuration option), each one with its own lock. The returned values
+ * are summed over all the shards, and are approximate as the locks are not
+ * taken while collecting them.
+ *
+ * @param pnAcquisitions pointer to the number of times a lock was taken,
+ *                       or NULL.
+ * @param pnContentions pointer to the number of times a thread had to wait
+ *                      for a lock held by another thread, or NULL.
+ * @param pdfWaitTime pointer to the total time, in seconds, spent waiting
+ *                    for contended locks, or NULL.
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALRasterBlock::GetLockStatistics( GIntBig* pnAcquisitions,
+                                         GIntBig* pnContentions,
+                                         double* pdfWaitTime )
+{
+    GIntBig nAcquisitions = 0;
+    GIntBig nContentions = 0;
+    double dfWaitTime = 0.0;
+    for( int i = 0; i < nShards; i++ )
+    {
+        nAcquisitions += asShards[i].nLockAcquisitions;
+        nContentions += asShards[i].nLockContentions;
+        dfWaitTime += asShards[i].dfLockWaitTime;
+    }
+    if( pnAcquisitions )
+        *pnAcquisitions = nAcquisitions;
+    if( pnContentions )
+        *pnContentions = nContentions;
+    if( pdfWaitTime )
+        *pdfWaitTime = dfWaitTime;
+}
+
+/************************************************************************/
+/*                         GetCacheStatistics()                         */
+/************************************************************************/
+
+/**
+ * Return statistics on the whole block cache.
+ *
+ * The values are approximate as the locks of the cache are not taken while
+ * collecting them.
+ *
+ * C++ analog to the C function GDALGetBlockCacheStatistics().
+ *
+ * @param psStats the structure to fill.
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALRasterBlock::GetCacheStatistics( GDALBlockCacheStatistics* psStats )
+{
+    memset(psStats, 0, sizeof(GDALBlockCacheStatistics));
+    for( int i = 0; i < nShards; i++ )
+    {
+        psStats->nHits += asShards[i].nHits;
+        psStats->nMisses += asShards[i].nMisses;
+        psStats->nBytesRead += asShards[i].nBytesRead;
+        psStats->nEvictions += asShards[i].nEvictions;
+        psStats->nDirtyFlushes += asShards[i].nDirtyFlushes;
+    }
+    psStats->nCacheUsed = GDALRBGetCacheUsed();
+    psStats->nCacheHighWaterMark = nCacheHighWaterMark;
+    if( psStats->nCacheHighWaterMark < psStats->nCacheUsed )
+        psStats->nCacheHighWaterMark = psStats->nCacheUsed;
+    GetLockStatistics( &psStats->nLockAcquisitions,
+                       &psStats->nLockContentions,
+                       &psStats->dfLockWaitTime );
+}
+
+/************************************************************************/
+/*                        ResetCacheStatistics()                        */
+/************************************************************************/
+
+/**
+ * Reset the counters of the block cache statistics.
+ *
+ * The high water mark is reset to the current memory usage of the cache.
+ * The statistics of the datasets are not affected.
+ *
+ * C++ analog to the C function GDALResetBlockCacheStatistics().
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALRasterBlock::ResetCacheStatistics()
+{
+    for( int i = 0; i < nShards; i++ )
+    {
+        GDALRBShard* psShard = &asShards[i];
+        TAKE_SHARD_LOCK(psShard);
+        psShard->nHits = 0;
+        psShard->nMisses = 0;
+        psShard->nBytesRead = 0;
+        psShard->nEvictions = 0;
+        psShard->nDirtyFlushes = 0;
+        psShard->nLockAcquisitions = 0;
+        psShard->nLockContentions = 0;
+        psShard->dfLockWaitTime = 0.0;
+    }
+    nCacheHighWaterMark = GDALRBGetCacheUsed();
+}
+
 /************************************************************************/
 /*                              TakeLock()                              */
 /************************************************************************/
@@ -1028,14 +1688,50 @@ int GDALRasterBlock::TakeLock()
         DropLock();
 
         // wait for the block having been unreferenced
-        TAKE_LOCK;
+        TAKE_SHARD_LOCK(&asShards[nCacheShard]);
 
         return FALSE;
     }
-    Touch();
+
+    GDALRBShard* psShard = &asShards[nCacheShard];
+    TAKE_SHARD_LOCK(psShard);
+    Touch_unlocked();
+    psShard->nHits ++;
+    GDALBlockCacheStatistics* psDSStats = GetDatasetCacheStatistics();
+    if( psDSStats != NULL )
+        psDSStats->nHits ++;
+    GDALBlockCacheStatistics* psBandStats = GetBandCacheStatistics();
+    if( psBandStats != NULL )
+        psBandStats->nHits ++;
     return TRUE;
 }
 
+/************************************************************************/
+/*                          RecordBlockRead()                           */
+/************************************************************************/
+
+/**
+ * Account for the block having been read from the driver.
+ *
+ * Should only be used by GDALRasterBand::GetLockedBlockRef(), to maintain
+ * the statistics returned by GDALGetBlockCacheStatistics().
+ *
+ * @since GDAL 2.1
+ */
+
+void GDALRasterBlock::RecordBlockRead()
+{
+    GDALRBShard* psShard = &asShards[nCacheShard];
+    TAKE_SHARD_LOCK(psShard);
+    psShard->nBytesRead += GetBlockSize();
+    GDALBlockCacheStatistics* psDSStats = GetDatasetCacheStatistics();
+    if( psDSStats != NULL )
+        psDSStats->nBytesRead += GetBlockSize();
+    GDALBlockCacheStatistics* psBandStats = GetBandCacheStatistics();
+    if( psBandStats != NULL )
+        psBandStats->nBytesRead += GetBlockSize();
+}
+
 /************************************************************************/
 /*                      DropLockForRemovalFromStorage()                 */
 /************************************************************************/
@@ -1062,7 +1758,7 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 #endif
 
     // Wait for the block for having been unreferenced
-    TAKE_LOCK;
+    TAKE_SHARD_LOCK(&asShards[nCacheShard]);
 
     return FALSE;
 }
@@ -1071,14 +1767,17 @@ int GDALRasterBlock::DropLockForRemovalFromStorage()
 void GDALRasterBlock::DumpAll()
 {
     int iBlock = 0;
-    for( GDALRasterBlock *poBlock = poNewest; 
-                            poBlock != NULL;
-                            poBlock = poBlock->poNext )
+    for( int iShard = 0; iShard < nShards; iShard++ )
     {
-        printf("Block %d\n", iBlock);
-        poBlock->DumpBlock();
-        printf("\n");
-        iBlock ++;
+        for( GDALRasterBlock *poBlock = asShards[iShard].poNewest;
+                                poBlock != NULL;
+                                poBlock = poBlock->poNext )
+        {
+            printf("Block %d (shard %d)\n", iBlock, iShard);
+            poBlock->DumpBlock();
+            printf("\n");
+            iBlock ++;
+        }
     }
 }
 
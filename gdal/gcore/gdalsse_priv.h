@@ -728,6 +728,16 @@ class XMMReg4Double
         return reg;
     }
 
+    template<class T>
+    static inline XMMReg4Double Load2ValLowAndHigh(const T* ptrLow,
+                                                   const T* ptrHigh)
+    {
+        XMMReg4Double reg;
+        reg.low.nsLoad2Val(ptrLow);
+        reg.high.nsLoad2Val(ptrHigh);
+        return reg;
+    }
+
     static inline XMMReg4Double Equals(const XMMReg4Double& expr1, const XMMReg4Double& expr2)
     {
         XMMReg4Double reg;
@@ -850,6 +860,12 @@ class XMMReg4Double
         low.Store2Val(ptr);
         high.Store2Val(ptr+2);
     }
+
+    void Store4Val(double* ptr) const
+    {
+        low.Store2Double(ptr);
+        high.Store2Double(ptr+2);
+    }
 };
 
 #endif /* GDALSSE_PRIV_H_INCLUDED */
@@ -30,6 +30,20 @@
 
 #include "gdal_priv.h"
 #include "gdalwarper.h"
+#include "cpl_worker_thread_pool.h"
+#include "overview_simd.h"
+#include <list>
+#include <vector>
+
+/* We restrict to 64bit processors because they are guaranteed to have SSE2 */
+/* Could possibly be used too on 32bit, but we would need to check at runtime */
+#if defined(__x86_64) || defined(_M_X64)
+#define USE_SSE2
+#endif
+
+#ifdef USE_SSE2
+#include <gdalsse_priv.h>
+#endif
 
 CPL_CVSID("$Id$");
 
@@ -209,6 +223,128 @@ static bool ReadColorTableAsArray(const GDALColorTable* poColorTable,
     return true;
 }
 
+/************************************************************************/
+/*                    GDALResampleAverage2x2SSE2()                      */
+/************************************************************************/
+
+/* Computes the rounded average of the 2x2 source pixels of pSrcRow1 and  */
+/* pSrcRow2 for as many destination pixels as the vectors allow, and       */
+/* returns their number. The caller finishes the line. */
+
+template<class T> static inline int GDALResampleAverage2x2SSE2(
+                                    const T* /* pSrcRow1 */,
+                                    const T* /* pSrcRow2 */,
+                                    T* /* pDst */, int /* nDstXWidth */ )
+{
+    return 0;
+}
+
+#ifdef USE_SSE2
+
+template<> inline int GDALResampleAverage2x2SSE2<GByte>(
+                                    const GByte* pSrcRow1,
+                                    const GByte* pSrcRow2,
+                                    GByte* pDst, int nDstXWidth )
+{
+    /* The sum of 4 bytes fits on 16 bits */
+    const __m128i v_lowbytes = _mm_set1_epi16(0x00FF);
+    const __m128i v_two = _mm_set1_epi16(2);
+    int i = 0;
+    for( ; i + 15 < nDstXWidth; i += 16 )
+    {
+        __m128i v_res[2];
+        for( int k = 0; k < 2; k++ )
+        {
+            const __m128i v_row1 = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pSrcRow1 + 2 * i + 16 * k));
+            const __m128i v_row2 = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pSrcRow2 + 2 * i + 16 * k));
+            __m128i v_sum = _mm_add_epi16(_mm_and_si128(v_row1, v_lowbytes),
+                                          _mm_srli_epi16(v_row1, 8));
+            v_sum = _mm_add_epi16(v_sum, _mm_and_si128(v_row2, v_lowbytes));
+            v_sum = _mm_add_epi16(v_sum, _mm_srli_epi16(v_row2, 8));
+            v_res[k] = _mm_srli_epi16(_mm_add_epi16(v_sum, v_two), 2);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i),
+                         _mm_packus_epi16(v_res[0], v_res[1]));
+    }
+    return i;
+}
+
+template<> inline int GDALResampleAverage2x2SSE2<GUInt16>(
+                                    const GUInt16* pSrcRow1,
+                                    const GUInt16* pSrcRow2,
+                                    GUInt16* pDst, int nDstXWidth )
+{
+    /* The sum of 4 words fits on 32 bits */
+    const __m128i v_lowwords = _mm_set1_epi32(0xFFFF);
+    const __m128i v_two = _mm_set1_epi32(2);
+    const __m128i v_32768_32 = _mm_set1_epi32(32768);
+    const __m128i v_32768_16 = _mm_set1_epi16(-32768);
+    int i = 0;
+    for( ; i + 7 < nDstXWidth; i += 8 )
+    {
+        __m128i v_res[2];
+        for( int k = 0; k < 2; k++ )
+        {
+            const __m128i v_row1 = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pSrcRow1 + 2 * i + 8 * k));
+            const __m128i v_row2 = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(pSrcRow2 + 2 * i + 8 * k));
+            __m128i v_sum = _mm_add_epi32(_mm_and_si128(v_row1, v_lowwords),
+                                          _mm_srli_epi32(v_row1, 16));
+            v_sum = _mm_add_epi32(v_sum, _mm_and_si128(v_row2, v_lowwords));
+            v_sum = _mm_add_epi32(v_sum, _mm_srli_epi32(v_row2, 16));
+            v_res[k] = _mm_srli_epi32(_mm_add_epi32(v_sum, v_two), 2);
+        }
+        /* SSE2 has no unsigned 32 to 16 bit pack, so shift to the signed */
+        /* range before packing, and back after. */
+        const __m128i v_packed = _mm_packs_epi32(
+            _mm_sub_epi32(v_res[0], v_32768_32),
+            _mm_sub_epi32(v_res[1], v_32768_32));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + i),
+                         _mm_add_epi16(v_packed, v_32768_16));
+    }
+    return i;
+}
+
+template<> inline int GDALResampleAverage2x2SSE2<float>(
+                                    const float* pSrcRow1,
+                                    const float* pSrcRow2,
+                                    float* pDst, int nDstXWidth )
+{
+    /* Sum in double precision, and in the same order as the scalar code, */
+    /* so that results are identical. */
+    const __m128d v_quarter = _mm_set1_pd(0.25);
+    int i = 0;
+    for( ; i + 3 < nDstXWidth; i += 4 )
+    {
+        const __m128 v_row1a = _mm_loadu_ps(pSrcRow1 + 2 * i);
+        const __m128 v_row1b = _mm_loadu_ps(pSrcRow1 + 2 * i + 4);
+        const __m128 v_row2a = _mm_loadu_ps(pSrcRow2 + 2 * i);
+        const __m128 v_row2b = _mm_loadu_ps(pSrcRow2 + 2 * i + 4);
+        const __m128 v_even1 = _mm_shuffle_ps(v_row1a, v_row1b, _MM_SHUFFLE(2,0,2,0));
+        const __m128 v_odd1 = _mm_shuffle_ps(v_row1a, v_row1b, _MM_SHUFFLE(3,1,3,1));
+        const __m128 v_even2 = _mm_shuffle_ps(v_row2a, v_row2b, _MM_SHUFFLE(2,0,2,0));
+        const __m128 v_odd2 = _mm_shuffle_ps(v_row2a, v_row2b, _MM_SHUFFLE(3,1,3,1));
+
+        __m128d v_low = _mm_add_pd(_mm_cvtps_pd(v_even1), _mm_cvtps_pd(v_odd1));
+        v_low = _mm_add_pd(v_low, _mm_cvtps_pd(v_even2));
+        v_low = _mm_add_pd(v_low, _mm_cvtps_pd(v_odd2));
+        __m128d v_high = _mm_add_pd(_mm_cvtps_pd(_mm_movehl_ps(v_even1, v_even1)),
+                                    _mm_cvtps_pd(_mm_movehl_ps(v_odd1, v_odd1)));
+        v_high = _mm_add_pd(v_high, _mm_cvtps_pd(_mm_movehl_ps(v_even2, v_even2)));
+        v_high = _mm_add_pd(v_high, _mm_cvtps_pd(_mm_movehl_ps(v_odd2, v_odd2)));
+
+        _mm_storeu_ps(pDst + i, _mm_movelh_ps(
+            _mm_cvtpd_ps(_mm_mul_pd(v_low, v_quarter)),
+            _mm_cvtpd_ps(_mm_mul_pd(v_high, v_quarter))));
+    }
+    return i;
+}
+
+#endif /* USE_SSE2 */
+
 /************************************************************************/
 /*                    GDALResampleChunk32R_Average()                    */
 /************************************************************************/
@@ -301,6 +437,13 @@ GDALResampleChunk32R_AverageT( double dfXRatioDstToSrc,
             bSrcXSpacingIsTwo = false;
     }
 
+#ifdef USE_SSE2
+    const bool bUseSSE2 =
+        CSLTestBoolean(CPLGetConfigOption("GDAL_USE_SSE", "YES")) != FALSE;
+#else
+    const bool bUseSSE2 = false;
+#endif
+
 /* ==================================================================== */
 /*      Loop over destination scanlines.                                */
 /* ==================================================================== */
@@ -331,11 +474,19 @@ GDALResampleChunk32R_AverageT( double dfXRatioDstToSrc,
         if (poColorTable == NULL)
         {
             if (bSrcXSpacingIsTwo && nSrcYOff2 == nSrcYOff + 2 &&
-                pabyChunkNodataMask == NULL && (eWrkDataType == GDT_Byte || eWrkDataType == GDT_UInt16))
+                pabyChunkNodataMask == NULL)
             {
                 /* Optimized case : no nodata, overview by a factor of 2 and regular x and y src spacing */
                 T* pSrcScanlineShifted = pChunk + panSrcXOffShifted[0] + (nSrcYOff - nChunkYOff) * nChunkXSize;
-                for( iDstPixel = 0; iDstPixel < nDstXWidth; iDstPixel++ )
+                iDstPixel = 0;
+                if( bUseSSE2 )
+                {
+                    iDstPixel = GDALResampleAverage2x2SSE2(
+                        pSrcScanlineShifted, pSrcScanlineShifted + nChunkXSize,
+                        pDstScanline, nDstXWidth);
+                    pSrcScanlineShifted += 2 * iDstPixel;
+                }
+                for( ; iDstPixel < nDstXWidth; iDstPixel++ )
                 {
                     Tsum nTotal;
 
@@ -344,7 +495,10 @@ GDALResampleChunk32R_AverageT( double dfXRatioDstToSrc,
                     nTotal += pSrcScanlineShifted[nChunkXSize];
                     nTotal += pSrcScanlineShifted[1+nChunkXSize];
 
-                    pDstScanline[iDstPixel] = (T) ((nTotal + 2) / 4);
+                    if( eWrkDataType == GDT_Float32 )
+                        pDstScanline[iDstPixel] = (T) (nTotal / 4);
+                    else
+                        pDstScanline[iDstPixel] = (T) ((nTotal + 2) / 4);
                     pSrcScanlineShifted += 2;
                 }
             }
@@ -1103,14 +1257,7 @@ template<class T> static inline void GDALResampleConvolutionVertical_2cols(
     dfRes1 = dfVal1 + dfVal2;
     dfRes2 = dfVal3 + dfVal4;
 }
-/* We restrict to 64bit processors because they are guaranteed to have SSE2 */
-/* Could possibly be used too on 32bit, but we would need to check at runtime */
-#if defined(__x86_64) || defined(_M_X64)
-#define USE_SSE2
-#endif
-
 #ifdef USE_SSE2
-#include <gdalsse_priv.h>
 
 /************************************************************************/
 /*              GDALResampleConvolutionHorizontalSSE2<T>                */
@@ -1433,6 +1580,11 @@ GDALResampleChunk32R_ConvolutionT( double dfXRatioDstToSrc, double dfYRatioDstTo
     int nChunkRightXOff = nChunkXOff + nChunkXSize;
 #ifdef USE_SSE2
     bool bSrcPixelCountLess8 = dfXScaledRadius < 4;
+#endif
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+    const bool bUseAVX =
+        CSLTestBoolean(CPLGetConfigOption("GDAL_USE_AVX", "YES")) &&
+        CPLHaveRuntimeAVX();
 #endif
     for( int iDstPixel = nDstXOff; iDstPixel < nDstXOff2; iDstPixel++ )
     {
@@ -1488,6 +1640,17 @@ GDALResampleChunk32R_ConvolutionT( double dfXRatioDstToSrc, double dfYRatioDstTo
                     padfWeights[i] *= dfInvWeightSum;
             }
             int iSrcLineOff = 0;
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+            if( bUseAVX )
+            {
+                GDALResampleConvolutionHorizontalAVX(
+                    pChunk + (nSrcPixelStart - nChunkXOff), nChunkXSize,
+                    nHeight, padfWeights, nSrcPixelCount,
+                    padfHorizontalFiltered + iDstPixel - nDstXOff, nDstXSize);
+                iSrcLineOff = nHeight;
+            }
+            else
+#endif
 #ifdef USE_SSE2
             if( bSrcPixelCountLess8 )
             {
@@ -1612,6 +1775,17 @@ GDALResampleChunk32R_ConvolutionT( double dfXRatioDstToSrc, double dfYRatioDstTo
             }
         }
 
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+        if( pabyChunkNodataMask == NULL && bUseAVX )
+        {
+            GDALResampleConvolutionVerticalAVX(
+                padfHorizontalFilteredBand +
+                    (nSrcLineStart - nChunkYOff) * nDstXSize,
+                nDstXSize, padfWeights, nSrcLineCount,
+                pafDstScanline, nDstXSize);
+        }
+        else
+#endif
         if( pabyChunkNodataMask == NULL )
         {
             int iFilteredPixelOff = 0;
@@ -2248,6 +2422,458 @@ GDALDataType GDALGetOvrWorkDataType(const char* pszResampling,
         return GDT_Float32;
 }
 
+/************************************************************************/
+/* ==================================================================== */
+/*                     Multi-threaded overview computation              */
+/* ==================================================================== */
+/************************************************************************/
+
+/* When GDAL_NUM_THREADS is set, the source chunks are still read, and the */
+/* resulting overview blocks still written, by the calling thread, but the */
+/* resampling of each chunk is done by a worker thread into a temporary    */
+/* buffer. Several chunks are in flight at the same time, so that          */
+/* reading, resampling and writing overlap.                                */
+
+/************************************************************************/
+/*                          GDALOvrWindowBand                           */
+/*                                                                      */
+/*      Band with the dimensions of an overview, of which only a        */
+/*      window is backed by a buffer. This is what the resampling       */
+/*      functions write into, with overview coordinates.                */
+/************************************************************************/
+
+class GDALOvrWindowBand : public GDALRasterBand
+{
+    GByte      *pabyBuffer;
+    int         nWinXOff;
+    int         nWinYOff;
+    int         nWinXSize;
+    int         nWinYSize;
+
+  protected:
+    virtual CPLErr IReadBlock( int, int, void * );
+    virtual CPLErr IRasterIO( GDALRWFlag, int, int, int, int,
+                              void *, int, int, GDALDataType,
+                              GSpacing nPixelSpace, GSpacing nLineSpace,
+                              GDALRasterIOExtraArg* psExtraArg );
+
+  public:
+                GDALOvrWindowBand( GDALRasterBand* poOverview, void* pBuffer,
+                                   int nXOff, int nYOff,
+                                   int nXSize, int nYSize );
+};
+
+/************************************************************************/
+/*                         GDALOvrWindowBand()                          */
+/************************************************************************/
+
+GDALOvrWindowBand::GDALOvrWindowBand( GDALRasterBand* poOverview,
+                                      void* pBuffer,
+                                      int nXOff, int nYOff,
+                                      int nXSize, int nYSize ) :
+    pabyBuffer((GByte*)pBuffer),
+    nWinXOff(nXOff),
+    nWinYOff(nYOff),
+    nWinXSize(nXSize),
+    nWinYSize(nYSize)
+{
+    nRasterXSize = poOverview->GetXSize();
+    nRasterYSize = poOverview->GetYSize();
+    eDataType = poOverview->GetRasterDataType();
+    eAccess = GA_Update;
+    nBlockXSize = nRasterXSize;
+    nBlockYSize = 1;
+}
+
+/************************************************************************/
+/*                             IReadBlock()                             */
+/************************************************************************/
+
+CPLErr GDALOvrWindowBand::IReadBlock( int, int, void * )
+{
+    CPLError(CE_Failure, CPLE_NotSupported,
+             "GDALOvrWindowBand::IReadBlock() not supported");
+    return CE_Failure;
+}
+
+/************************************************************************/
+/*                             IRasterIO()                              */
+/************************************************************************/
+
+CPLErr GDALOvrWindowBand::IRasterIO( GDALRWFlag eRWFlag,
+                                     int nXOff, int nYOff,
+                                     int nXSize, int nYSize,
+                                     void * pData,
+                                     int nBufXSize, int nBufYSize,
+                                     GDALDataType eBufType,
+                                     GSpacing nPixelSpace,
+                                     GSpacing nLineSpace,
+                                     GDALRasterIOExtraArg* /* psExtraArg */ )
+{
+    if( nXSize != nBufXSize || nYSize != nBufYSize ||
+        nXOff < nWinXOff || nXOff + nXSize > nWinXOff + nWinXSize ||
+        nYOff < nWinYOff || nYOff + nYSize > nWinYOff + nWinYSize )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "GDALOvrWindowBand::IRasterIO(): request out of window");
+        return CE_Failure;
+    }
+
+    const int nDTSize = GDALGetDataTypeSize(eDataType) / 8;
+    for( int iLine = 0; iLine < nYSize; iLine++ )
+    {
+        const size_t nWinOffset =
+            ((size_t)(nYOff - nWinYOff + iLine) * nWinXSize +
+             (nXOff - nWinXOff)) * nDTSize;
+        GByte* pabyBufLine = (GByte*)pData + iLine * nLineSpace;
+        if( eRWFlag == GF_Write )
+            GDALCopyWords( pabyBufLine, eBufType, (int)nPixelSpace,
+                           pabyBuffer + nWinOffset, eDataType, nDTSize,
+                           nXSize );
+        else
+            GDALCopyWords( pabyBuffer + nWinOffset, eDataType, nDTSize,
+                           pabyBufLine, eBufType, (int)nPixelSpace,
+                           nXSize );
+    }
+    return CE_None;
+}
+
+typedef struct
+{
+    GDALRasterBand *poOverview;   /* final destination band */
+    void           *pChunk;       /* not owned */
+    GByte          *pabyChunkNodataMask; /* not owned */
+    int             nChunkXOff;
+    int             nChunkXSize;
+    int             nChunkYOff;
+    int             nChunkYSize;
+    int             nDstXOff;
+    int             nDstXOff2;
+    int             nDstYOff;
+    int             nDstYOff2;
+    double          dfXRatioDstToSrc;
+    double          dfYRatioDstToSrc;
+    int             bHasNoData;
+    float           fNoDataValue;
+    GDALColorTable *poColorTable;
+    GDALDataType    eSrcDataType;
+
+    void           *pDstBuffer;   /* owned */
+    GDALOvrWindowBand *poWindowBand; /* owned. Wraps pDstBuffer */
+} GDALOvrResampleTask;
+
+typedef struct
+{
+    GDALResampleFunction pfnResampleFn;
+    GDALDataType         eWrkDataType;
+    const char          *pszResampling;
+    std::vector<GDALOvrResampleTask> asTasks;
+    std::vector<void*>   apBuffers;   /* owned source buffers */
+    CPLErr               eErr;
+    int                  bFinished;
+    CPLMutex            *hMutex;
+    CPLCond             *hCond;       /* signaled when bFinished is set */
+} GDALOvrResampleJob;
+
+/************************************************************************/
+/*                        GDALOvrGetNumThreads()                        */
+/************************************************************************/
+
+static int GDALOvrGetNumThreads()
+{
+    const char* pszNumThreads = CPLGetConfigOption("GDAL_NUM_THREADS", NULL);
+    if( pszNumThreads == NULL )
+        return 1;
+    int nThreads;
+    if( EQUAL(pszNumThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszNumThreads);
+    if( nThreads > 128 )
+        nThreads = 128;
+    return nThreads;
+}
+
+/************************************************************************/
+/*                     GDALOvrResampleJobFunc()                         */
+/************************************************************************/
+
+static void GDALOvrResampleJobFunc(void* pData)
+{
+    GDALOvrResampleJob* psJob = (GDALOvrResampleJob*) pData;
+    CPLErr eErr = CE_None;
+
+    for( size_t i = 0; i < psJob->asTasks.size() && eErr == CE_None; i++ )
+    {
+        GDALOvrResampleTask& sTask = psJob->asTasks[i];
+        eErr = psJob->pfnResampleFn( sTask.dfXRatioDstToSrc,
+                                     sTask.dfYRatioDstToSrc,
+                                     0.0, 0.0,
+                                     psJob->eWrkDataType,
+                                     sTask.pChunk,
+                                     sTask.pabyChunkNodataMask,
+                                     sTask.nChunkXOff, sTask.nChunkXSize,
+                                     sTask.nChunkYOff, sTask.nChunkYSize,
+                                     sTask.nDstXOff, sTask.nDstXOff2,
+                                     sTask.nDstYOff, sTask.nDstYOff2,
+                                     sTask.poWindowBand,
+                                     psJob->pszResampling,
+                                     sTask.bHasNoData, sTask.fNoDataValue,
+                                     sTask.poColorTable,
+                                     sTask.eSrcDataType );
+    }
+
+    CPLAcquireMutex(psJob->hMutex, 1000.0);
+    psJob->eErr = eErr;
+    psJob->bFinished = TRUE;
+    CPLCondBroadcast(psJob->hCond);
+    CPLReleaseMutex(psJob->hMutex);
+}
+
+/************************************************************************/
+/*                       GDALOvrResampleJobQueue                        */
+/************************************************************************/
+
+class GDALOvrResampleJobQueue
+{
+        CPLWorkerThreadPool             *poPool;
+        CPLMutex                        *hMutex;
+        CPLCond                         *hCond;
+        int                              nMaxJobsInFlight;
+        std::list<GDALOvrResampleJob*>   oJobs;
+
+        CPLErr      RetireOldestJob();
+
+    public:
+        GDALOvrResampleJobQueue();
+       ~GDALOvrResampleJobQueue();
+
+        bool        Setup(int nThreads, GIntBig nBytesPerJob);
+
+        GDALOvrResampleJob* CreateJob(GDALResampleFunction pfnResampleFn,
+                                      GDALDataType eWrkDataType,
+                                      const char* pszResampling);
+        bool        AddTask(GDALOvrResampleJob* psJob,
+                            const GDALOvrResampleTask& sTaskIn);
+        CPLErr      SubmitJob(GDALOvrResampleJob* psJob);
+        CPLErr      WaitAllJobs();
+
+        static void FreeJob(GDALOvrResampleJob* psJob);
+};
+
+/************************************************************************/
+/*                      GDALOvrResampleJobQueue()                       */
+/************************************************************************/
+
+GDALOvrResampleJobQueue::GDALOvrResampleJobQueue() :
+    poPool(NULL), hMutex(NULL), hCond(NULL), nMaxJobsInFlight(0)
+{
+}
+
+/************************************************************************/
+/*                     ~GDALOvrResampleJobQueue()                       */
+/************************************************************************/
+
+GDALOvrResampleJobQueue::~GDALOvrResampleJobQueue()
+{
+    if( poPool != NULL )
+        poPool->WaitCompletion();
+    for( std::list<GDALOvrResampleJob*>::iterator oIter = oJobs.begin();
+         oIter != oJobs.end(); ++oIter )
+    {
+        FreeJob(*oIter);
+    }
+    delete poPool;
+    if( hCond != NULL )
+        CPLDestroyCond(hCond);
+    if( hMutex != NULL )
+        CPLDestroyMutex(hMutex);
+}
+
+/************************************************************************/
+/*                               Setup()                                */
+/************************************************************************/
+
+bool GDALOvrResampleJobQueue::Setup(int nThreads, GIntBig nBytesPerJob)
+{
+    CPLAssert(poPool == NULL);
+
+    // Allow the main thread to read the next chunks while all the workers
+    // are busy, but bound the memory used by the pending jobs
+    GIntBig nMaxJobs = 2 * nThreads;
+    if( nBytesPerJob > 0 &&
+        nMaxJobs * nBytesPerJob > GDALGetCacheMax64() )
+    {
+        nMaxJobs = MAX(2, GDALGetCacheMax64() / nBytesPerJob);
+    }
+    nMaxJobsInFlight = static_cast<int>(nMaxJobs);
+
+    hCond = CPLCreateCond();
+    if( hCond == NULL )
+        return false;
+    hMutex = CPLCreateMutex();
+    CPLReleaseMutex(hMutex);
+
+    poPool = new CPLWorkerThreadPool();
+    if( !poPool->Setup(nThreads, NULL, NULL) )
+    {
+        delete poPool;
+        poPool = NULL;
+        return false;
+    }
+
+    CPLDebug("GDAL", "Using %d threads and up to %d pending jobs "
+             "for overview computation", nThreads, nMaxJobsInFlight);
+    return true;
+}
+
+/************************************************************************/
+/*                              CreateJob()                             */
+/************************************************************************/
+
+GDALOvrResampleJob* GDALOvrResampleJobQueue::CreateJob(
+                                        GDALResampleFunction pfnResampleFn,
+                                        GDALDataType eWrkDataType,
+                                        const char* pszResampling)
+{
+    GDALOvrResampleJob* psJob = new GDALOvrResampleJob;
+    psJob->pfnResampleFn = pfnResampleFn;
+    psJob->eWrkDataType = eWrkDataType;
+    psJob->pszResampling = pszResampling;
+    psJob->eErr = CE_None;
+    psJob->bFinished = FALSE;
+    psJob->hMutex = hMutex;
+    psJob->hCond = hCond;
+    return psJob;
+}
+
+/************************************************************************/
+/*                               AddTask()                              */
+/*                                                                      */
+/*      Register the resampling of a chunk into a window of an          */
+/*      overview band. The output is written into a temporary buffer,   */
+/*      wrapped as a band with the dimensions of the overview.          */
+/************************************************************************/
+
+bool GDALOvrResampleJobQueue::AddTask(GDALOvrResampleJob* psJob,
+                                      const GDALOvrResampleTask& sTaskIn)
+{
+    GDALOvrResampleTask sTask(sTaskIn);
+    GDALRasterBand* poOverview = sTask.poOverview;
+    const GDALDataType eOvrDataType = poOverview->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSize(eOvrDataType) / 8;
+    const int nDstXSize = sTask.nDstXOff2 - sTask.nDstXOff;
+    const int nDstYSize = sTask.nDstYOff2 - sTask.nDstYOff;
+
+    sTask.pDstBuffer = VSI_MALLOC3_VERBOSE(nDstXSize, nDstYSize, nDTSize);
+    if( sTask.pDstBuffer == NULL )
+        return false;
+
+    sTask.poWindowBand = new GDALOvrWindowBand( poOverview, sTask.pDstBuffer,
+                                                sTask.nDstXOff, sTask.nDstYOff,
+                                                nDstXSize, nDstYSize );
+
+    // The convolution kernels clamp their output to NBITS
+    const char* pszNBITS = poOverview->GetMetadataItem("NBITS", "IMAGE_STRUCTURE");
+    if( pszNBITS )
+        sTask.poWindowBand->SetMetadataItem("NBITS", pszNBITS,
+                                            "IMAGE_STRUCTURE");
+
+    psJob->asTasks.push_back(sTask);
+    return true;
+}
+
+/************************************************************************/
+/*                               FreeJob()                              */
+/************************************************************************/
+
+void GDALOvrResampleJobQueue::FreeJob(GDALOvrResampleJob* psJob)
+{
+    for( size_t i = 0; i < psJob->asTasks.size(); i++ )
+    {
+        delete psJob->asTasks[i].poWindowBand;
+        VSIFree(psJob->asTasks[i].pDstBuffer);
+    }
+    for( size_t i = 0; i < psJob->apBuffers.size(); i++ )
+        VSIFree(psJob->apBuffers[i]);
+    delete psJob;
+}
+
+/************************************************************************/
+/*                           RetireOldestJob()                          */
+/*                                                                      */
+/*      Wait for the oldest submitted job to be finished, and write     */
+/*      its result into the overview bands.                             */
+/************************************************************************/
+
+CPLErr GDALOvrResampleJobQueue::RetireOldestJob()
+{
+    GDALOvrResampleJob* psJob = oJobs.front();
+    oJobs.pop_front();
+
+    CPLAcquireMutex(hMutex, 1000.0);
+    while( !psJob->bFinished )
+        CPLCondWait(hCond, hMutex);
+    CPLReleaseMutex(hMutex);
+
+    CPLErr eErr = psJob->eErr;
+    for( size_t i = 0; i < psJob->asTasks.size() && eErr == CE_None; i++ )
+    {
+        GDALOvrResampleTask& sTask = psJob->asTasks[i];
+        const int nDstXSize = sTask.nDstXOff2 - sTask.nDstXOff;
+        const int nDstYSize = sTask.nDstYOff2 - sTask.nDstYOff;
+        eErr = sTask.poOverview->RasterIO( GF_Write,
+                                           sTask.nDstXOff, sTask.nDstYOff,
+                                           nDstXSize, nDstYSize,
+                                           sTask.pDstBuffer,
+                                           nDstXSize, nDstYSize,
+                                           sTask.poOverview->GetRasterDataType(),
+                                           0, 0, NULL );
+    }
+
+    FreeJob(psJob);
+    return eErr;
+}
+
+/************************************************************************/
+/*                              SubmitJob()                             */
+/*                                                                      */
+/*      Takes ownership of psJob. Might block until a previously        */
+/*      submitted job is finished.                                      */
+/************************************************************************/
+
+CPLErr GDALOvrResampleJobQueue::SubmitJob(GDALOvrResampleJob* psJob)
+{
+    CPLErr eErr = CE_None;
+    while( eErr == CE_None && (int)oJobs.size() >= nMaxJobsInFlight )
+        eErr = RetireOldestJob();
+    if( eErr != CE_None )
+    {
+        FreeJob(psJob);
+        return eErr;
+    }
+
+    oJobs.push_back(psJob);
+    poPool->SubmitJob(GDALOvrResampleJobFunc, psJob);
+    return CE_None;
+}
+
+/************************************************************************/
+/*                             WaitAllJobs()                            */
+/************************************************************************/
+
+CPLErr GDALOvrResampleJobQueue::WaitAllJobs()
+{
+    CPLErr eErr = CE_None;
+    while( !oJobs.empty() )
+    {
+        CPLErr eErrJob = RetireOldestJob();
+        if( eErr == CE_None )
+            eErr = eErrJob;
+    }
+    return eErr;
+}
+
 /************************************************************************/
 /*                      GDALRegenerateOverviews()                       */
 /************************************************************************/
@@ -2270,6 +2896,11 @@ GDALDataType GDALGetOvrWorkDataType(const char* pszResampling,
  * that only a given RGB triplet (in case of a RGB image) will be considered as the
  * nodata value and not each value of the triplet independently per band.
  *
+ * Starting with GDAL 2.1, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads (or ALL_CPUS) so that the resampling of several
+ * chunks is done in parallel by worker threads, while the calling thread
+ * reads the source data and writes the resulting overview data.
+ *
  * @param hSrcBand the source (base level) band. 
  * @param nOverviewCount the number of downsampled bands being generated.
  * @param pahOvrBands the list of downsampled bands to be generated.
@@ -2442,6 +3073,33 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
     int bHasNoData;
     const float fNoDataValue = (float) poSrcBand->GetNoDataValue(&bHasNoData);
 
+/* -------------------------------------------------------------------- */
+/*      Setup worker threads if requested.                              */
+/* -------------------------------------------------------------------- */
+    GDALOvrResampleJobQueue* poJobQueue = NULL;
+    const int nThreads = GDALOvrGetNumThreads();
+    if( nThreads > 1 && eType != GDT_CFloat32 )
+    {
+        GIntBig nBytesPerJob = (GIntBig)nMaxChunkYSizeQueried * nWidth *
+            (GDALGetDataTypeSize(eType)/8 + (bUseNoDataMask ? 1 : 0));
+        for( int iOverview = 0; iOverview < nOverviewCount; iOverview ++ )
+        {
+            const int nDstWidth = papoOvrBands[iOverview]->GetXSize();
+            const double dfYRatioDstToSrc =
+                (double)nHeight / papoOvrBands[iOverview]->GetYSize();
+            nBytesPerJob += (GIntBig)nDstWidth *
+                (1 + (int)(nFullResYChunk / dfYRatioDstToSrc)) *
+                (GDALGetDataTypeSize(
+                    papoOvrBands[iOverview]->GetRasterDataType()) / 8);
+        }
+        poJobQueue = new GDALOvrResampleJobQueue();
+        if( !poJobQueue->Setup(nThreads, nBytesPerJob) )
+        {
+            delete poJobQueue;
+            poJobQueue = NULL;
+        }
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Loop over image operating on chunks.                            */
 /* -------------------------------------------------------------------- */
@@ -2556,6 +3214,72 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
             }
         }
 
+        if( poJobQueue != NULL )
+        {
+            if( eErr != CE_None )
+                break;
+
+/* -------------------------------------------------------------------- */
+/*      Hand the chunk over to a worker thread, and allocate new        */
+/*      buffers to read the next one.                                   */
+/* -------------------------------------------------------------------- */
+            GDALOvrResampleJob* psJob =
+                poJobQueue->CreateJob(pfnResampleFn, eType, pszResampling);
+            psJob->apBuffers.push_back(pChunk);
+            psJob->apBuffers.push_back(pabyChunkNodataMask);
+
+            for( int iOverview = 0; iOverview < nOverviewCount && eErr == CE_None; iOverview++ )
+            {
+                const int nDstWidth = papoOvrBands[iOverview]->GetXSize();
+                const int nDstHeight = papoOvrBands[iOverview]->GetYSize();
+                const double dfYRatioDstToSrc = (double)nHeight / nDstHeight;
+
+                GDALOvrResampleTask sTask;
+                memset(&sTask, 0, sizeof(sTask));
+                sTask.poOverview = papoOvrBands[iOverview];
+                sTask.pChunk = pChunk;
+                sTask.pabyChunkNodataMask = pabyChunkNodataMask;
+                sTask.nChunkXOff = 0;
+                sTask.nChunkXSize = nWidth;
+                sTask.nChunkYOff = nChunkYOffQueried;
+                sTask.nChunkYSize = nChunkYSizeQueried;
+                sTask.nDstXOff = 0;
+                sTask.nDstXOff2 = nDstWidth;
+                sTask.nDstYOff = (int) (0.5 + nChunkYOff/dfYRatioDstToSrc);
+                sTask.nDstYOff2 = (int)
+                    (0.5 + (nChunkYOff+nFullResYChunk)/dfYRatioDstToSrc);
+                if( nChunkYOff + nFullResYChunk == nHeight )
+                    sTask.nDstYOff2 = nDstHeight;
+                if( sTask.nDstYOff2 <= sTask.nDstYOff )
+                    continue;
+                sTask.dfXRatioDstToSrc = (double)nWidth / nDstWidth;
+                sTask.dfYRatioDstToSrc = dfYRatioDstToSrc;
+                sTask.bHasNoData = bHasNoData;
+                sTask.fNoDataValue = fNoDataValue;
+                sTask.poColorTable = poColorTable;
+                sTask.eSrcDataType = poSrcBand->GetRasterDataType();
+                if( !poJobQueue->AddTask(psJob, sTask) )
+                    eErr = CE_Failure;
+            }
+
+            if( eErr == CE_None )
+                eErr = poJobQueue->SubmitJob(psJob);
+            else
+                GDALOvrResampleJobQueue::FreeJob(psJob);
+
+            pChunk = VSI_MALLOC3_VERBOSE((GDALGetDataTypeSize(eType)/8),
+                                         nMaxChunkYSizeQueried, nWidth );
+            pabyChunkNodataMask = NULL;
+            if( bUseNoDataMask )
+            {
+                pabyChunkNodataMask =
+                    (GByte*) VSI_MALLOC2_VERBOSE( nMaxChunkYSizeQueried, nWidth );
+            }
+            if( pChunk == NULL || (bUseNoDataMask && pabyChunkNodataMask == NULL))
+                eErr = CE_Failure;
+            continue;
+        }
+
         for( int iOverview = 0; iOverview < nOverviewCount && eErr == CE_None; iOverview++ )
         {
             const int nDstWidth = papoOvrBands[iOverview]->GetXSize();
@@ -2600,6 +3324,14 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
         }
     }
 
+    if( poJobQueue != NULL )
+    {
+        CPLErr eErrJobs = poJobQueue->WaitAllJobs();
+        if( eErr == CE_None )
+            eErr = eErrJobs;
+        delete poJobQueue;
+    }
+
     VSIFree( pChunk );
     VSIFree( pabyChunkNodataMask );
 
@@ -2663,6 +3395,11 @@ GDALRegenerateOverviews( GDALRasterBandH hSrcBand,
  * that only a given RGB triplet (in case of a RGB image) will be considered as the
  * nodata value and not each value of the triplet independently per band.
  *
+ * Starting with GDAL 2.1, the GDAL_NUM_THREADS configuration option can be
+ * set to a number of threads (or ALL_CPUS) so that the resampling of several
+ * chunks is done in parallel by worker threads, while the calling thread
+ * reads the source data and writes the resulting overview data.
+ *
  * @param nBands the number of bands, size of papoSrcBands and size of
  *               first dimension of papapoOverviewBands
  * @param papoSrcBands the list of source bands to downsample
@@ -2794,6 +3531,8 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
         pafNoDataValue[iBand] = (float) papoSrcBands[iBand]->GetNoDataValue(&pabHasNoData[iBand]);
     }
 
+    const int nThreads = GDALOvrGetNumThreads();
+
     /* Second pass to do the real job ! */
     double dfCurPixelCount = 0;
     CPLErr eErr = CE_None;
@@ -2867,6 +3606,24 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
             }
         }
 
+        /* Setup worker threads if requested */
+        GDALOvrResampleJobQueue* poJobQueue = NULL;
+        if( nThreads > 1 )
+        {
+            const GIntBig nBytesPerJob =
+                (GIntBig)nFullResXChunkQueried * nFullResYChunkQueried *
+                    (nBands * GDALGetDataTypeSize(eWrkDataType) / 8 +
+                     (bUseNoDataMask ? 1 : 0)) +
+                (GIntBig)nDstBlockXSize * nDstBlockYSize * nBands *
+                    (GDALGetDataTypeSize(eDataType) / 8);
+            poJobQueue = new GDALOvrResampleJobQueue();
+            if( !poJobQueue->Setup(nThreads, nBytesPerJob) )
+            {
+                delete poJobQueue;
+                poJobQueue = NULL;
+            }
+        }
+
         int nDstYOff;
         /* Iterate on destination overview, block by block */
         for( nDstYOff = 0; nDstYOff < nDstHeight && eErr == CE_None; nDstYOff += nDstBlockYSize )
@@ -2964,6 +3721,60 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
                                                                GDT_Byte, 0, 0, NULL );
                 }
 
+                if( poJobQueue != NULL && eErr == CE_None )
+                {
+                    /* Hand the chunks over to a worker thread, and allocate */
+                    /* new buffers to read the next ones */
+                    GDALOvrResampleJob* psJob = poJobQueue->CreateJob(
+                                pfnResampleFn, eWrkDataType, pszResampling);
+                    psJob->apBuffers.push_back(pabyChunkNoDataMask);
+                    for(int iBand=0;iBand<nBands;iBand++)
+                    {
+                        psJob->apBuffers.push_back(papaChunk[iBand]);
+
+                        GDALOvrResampleTask sTask;
+                        memset(&sTask, 0, sizeof(sTask));
+                        sTask.poOverview = papapoOverviewBands[iBand][iOverview];
+                        sTask.pChunk = papaChunk[iBand];
+                        sTask.pabyChunkNodataMask = pabyChunkNoDataMask;
+                        sTask.nChunkXOff = nChunkXOffQueried;
+                        sTask.nChunkXSize = nChunkXSizeQueried;
+                        sTask.nChunkYOff = nChunkYOffQueried;
+                        sTask.nChunkYSize = nChunkYSizeQueried;
+                        sTask.nDstXOff = nDstXOff;
+                        sTask.nDstXOff2 = nDstXOff + nDstXCount;
+                        sTask.nDstYOff = nDstYOff;
+                        sTask.nDstYOff2 = nDstYOff + nDstYCount;
+                        sTask.dfXRatioDstToSrc = dfXRatioDstToSrc;
+                        sTask.dfYRatioDstToSrc = dfYRatioDstToSrc;
+                        sTask.bHasNoData = pabHasNoData[iBand];
+                        sTask.fNoDataValue = pafNoDataValue[iBand];
+                        sTask.poColorTable = NULL;
+                        sTask.eSrcDataType = eDataType;
+                        if( eErr == CE_None && !poJobQueue->AddTask(psJob, sTask) )
+                            eErr = CE_Failure;
+                    }
+
+                    if( eErr == CE_None )
+                        eErr = poJobQueue->SubmitJob(psJob);
+                    else
+                        GDALOvrResampleJobQueue::FreeJob(psJob);
+
+                    for(int iBand=0;iBand<nBands;iBand++)
+                    {
+                        papaChunk[iBand] = VSI_MALLOC3_VERBOSE(nFullResXChunkQueried, nFullResYChunkQueried, GDALGetDataTypeSize(eWrkDataType) / 8);
+                        if( papaChunk[iBand] == NULL )
+                            eErr = CE_Failure;
+                    }
+                    if( bUseNoDataMask )
+                    {
+                        pabyChunkNoDataMask = (GByte*) VSI_MALLOC2_VERBOSE(nFullResXChunkQueried, nFullResYChunkQueried);
+                        if( pabyChunkNoDataMask == NULL )
+                            eErr = CE_Failure;
+                    }
+                    continue;
+                }
+
                 /* Compute the resulting overview block */
                 for(int iBand=0;iBand<nBands && eErr == CE_None;iBand++)
                 {
@@ -2988,6 +3799,14 @@ GDALRegenerateOverviewsMultiBand(int nBands, GDALRasterBand** papoSrcBands,
             dfCurPixelCount += (double)nYCount * nSrcWidth;
         }
 
+        if( poJobQueue != NULL )
+        {
+            CPLErr eErrJobs = poJobQueue->WaitAllJobs();
+            if( eErr == CE_None )
+                eErr = eErrJobs;
+            delete poJobQueue;
+        }
+
         /* Flush the data to overviews */
         for(int iBand=0;iBand<nBands;iBand++)
         {
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  Vectorized kernels of the convolution resampling of overview.cpp
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#ifndef OVERVIEW_SIMD_H_INCLUDED
+#define OVERVIEW_SIMD_H_INCLUDED
+
+#include "cpl_port.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+
+/* Defined in alg/gdalgrid.cpp */
+int CPLHaveRuntimeAVX();
+
+/* Horizontal pass of the convolution for one destination pixel: for each */
+/* of the nHeight rows of pChunk (nChunkXSize wide, and already shifted to */
+/* the first source pixel), stores the dot product of its nSrcPixelCount  */
+/* pixels with padfWeights in padfDst[iRow * nDstStride]. */
+void GDALResampleConvolutionHorizontalAVX( const GByte* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride );
+void GDALResampleConvolutionHorizontalAVX( const GUInt16* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride );
+void GDALResampleConvolutionHorizontalAVX( const float* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride );
+
+/* Vertical pass of the convolution for one destination line: pafDst[i] */
+/* is the dot product of the column i of the nSrcLineCount lines of     */
+/* padfSrc (nStride apart) with padfWeights, for i in [0, nDstXSize[.    */
+void GDALResampleConvolutionVerticalAVX( const double* padfSrc, int nStride,
+                                         const double* padfWeights,
+                                         int nSrcLineCount,
+                                         float* pafDst, int nDstXSize );
+
+#endif /* HAVE_AVX_AT_COMPILE_TIME */
+
+#endif /* OVERVIEW_SIMD_H_INCLUDED */
@@ -0,0 +1,243 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  GDAL Core
+ * Purpose:  AVX implementation of the convolution kernels used by the
+ *           cubic, cubicspline, lanczos and bilinear overview and
+ *           RasterIO resampling.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "overview_simd.h"
+
+#ifdef HAVE_AVX_AT_COMPILE_TIME
+#include <immintrin.h>
+#include <string.h>
+
+CPL_CVSID("$Id$");
+
+/* This file is compiled with -mavx, so it must not include gdalsse_priv.h */
+/* or other headers with inline code shared with the rest of the library. */
+
+/************************************************************************/
+/*                             AVXLoad4Val()                            */
+/************************************************************************/
+
+static inline __m256d AVXLoad4Val( const GByte* ptr )
+{
+    int i;
+    memcpy(&i, ptr, 4);
+    return _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(i)));
+}
+
+static inline __m256d AVXLoad4Val( const GUInt16* ptr )
+{
+    return _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ptr))));
+}
+
+static inline __m256d AVXLoad4Val( const float* ptr )
+{
+    return _mm256_cvtps_pd(_mm_loadu_ps(ptr));
+}
+
+/************************************************************************/
+/*                      AVXHorizontalSum4Regs()                         */
+/************************************************************************/
+
+/* Returns ( sum(a0), sum(a1), sum(a2), sum(a3) ) */
+static inline __m256d AVXHorizontalSum4Regs( __m256d a0, __m256d a1,
+                                             __m256d a2, __m256d a3 )
+{
+    const __m256d t0 = _mm256_hadd_pd(a0, a1);
+    const __m256d t1 = _mm256_hadd_pd(a2, a3);
+    return _mm256_add_pd(_mm256_permute2f128_pd(t0, t1, 0x20),
+                         _mm256_permute2f128_pd(t0, t1, 0x31));
+}
+
+/************************************************************************/
+/*                 GDALResampleConvolutionHorizontalAVXT()              */
+/************************************************************************/
+
+template<class T> static void GDALResampleConvolutionHorizontalAVXT(
+                                           const T* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride )
+{
+    const int nVectorCount = nSrcPixelCount & ~3;
+    int iRow = 0;
+
+    /* 4 rows at a time, sharing the loads of the weights */
+    for( ; iRow + 3 < nHeight; iRow += 4 )
+    {
+        const T* pRow0 = pChunk + iRow * nChunkXSize;
+        const T* pRow1 = pRow0 + nChunkXSize;
+        const T* pRow2 = pRow1 + nChunkXSize;
+        const T* pRow3 = pRow2 + nChunkXSize;
+        __m256d v_acc0 = _mm256_setzero_pd();
+        __m256d v_acc1 = _mm256_setzero_pd();
+        __m256d v_acc2 = _mm256_setzero_pd();
+        __m256d v_acc3 = _mm256_setzero_pd();
+        int i = 0;
+        for( ; i < nVectorCount; i += 4 )
+        {
+            const __m256d v_weight = _mm256_loadu_pd(padfWeights + i);
+            v_acc0 = _mm256_add_pd(v_acc0,
+                        _mm256_mul_pd(AVXLoad4Val(pRow0 + i), v_weight));
+            v_acc1 = _mm256_add_pd(v_acc1,
+                        _mm256_mul_pd(AVXLoad4Val(pRow1 + i), v_weight));
+            v_acc2 = _mm256_add_pd(v_acc2,
+                        _mm256_mul_pd(AVXLoad4Val(pRow2 + i), v_weight));
+            v_acc3 = _mm256_add_pd(v_acc3,
+                        _mm256_mul_pd(AVXLoad4Val(pRow3 + i), v_weight));
+        }
+
+        double adfSum[4];
+        _mm256_storeu_pd(adfSum,
+                         AVXHorizontalSum4Regs(v_acc0, v_acc1, v_acc2, v_acc3));
+        for( ; i < nSrcPixelCount; i++ )
+        {
+            adfSum[0] += pRow0[i] * padfWeights[i];
+            adfSum[1] += pRow1[i] * padfWeights[i];
+            adfSum[2] += pRow2[i] * padfWeights[i];
+            adfSum[3] += pRow3[i] * padfWeights[i];
+        }
+        padfDst[iRow * nDstStride] = adfSum[0];
+        padfDst[(iRow + 1) * nDstStride] = adfSum[1];
+        padfDst[(iRow + 2) * nDstStride] = adfSum[2];
+        padfDst[(iRow + 3) * nDstStride] = adfSum[3];
+    }
+
+    for( ; iRow < nHeight; iRow ++ )
+    {
+        const T* pRow = pChunk + iRow * nChunkXSize;
+        __m256d v_acc = _mm256_setzero_pd();
+        int i = 0;
+        for( ; i < nVectorCount; i += 4 )
+        {
+            v_acc = _mm256_add_pd(v_acc,
+                        _mm256_mul_pd(AVXLoad4Val(pRow + i),
+                                      _mm256_loadu_pd(padfWeights + i)));
+        }
+
+        double adfSum[4];
+        _mm256_storeu_pd(adfSum, v_acc);
+        double dfSum = (adfSum[0] + adfSum[1]) + (adfSum[2] + adfSum[3]);
+        for( ; i < nSrcPixelCount; i++ )
+            dfSum += pRow[i] * padfWeights[i];
+        padfDst[iRow * nDstStride] = dfSum;
+    }
+}
+
+/************************************************************************/
+/*                 GDALResampleConvolutionHorizontalAVX()               */
+/************************************************************************/
+
+void GDALResampleConvolutionHorizontalAVX( const GByte* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride )
+{
+    GDALResampleConvolutionHorizontalAVXT(pChunk, nChunkXSize, nHeight,
+                                          padfWeights, nSrcPixelCount,
+                                          padfDst, nDstStride);
+}
+
+void GDALResampleConvolutionHorizontalAVX( const GUInt16* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride )
+{
+    GDALResampleConvolutionHorizontalAVXT(pChunk, nChunkXSize, nHeight,
+                                          padfWeights, nSrcPixelCount,
+                                          padfDst, nDstStride);
+}
+
+void GDALResampleConvolutionHorizontalAVX( const float* pChunk,
+                                           int nChunkXSize, int nHeight,
+                                           const double* padfWeights,
+                                           int nSrcPixelCount,
+                                           double* padfDst, int nDstStride )
+{
+    GDALResampleConvolutionHorizontalAVXT(pChunk, nChunkXSize, nHeight,
+                                          padfWeights, nSrcPixelCount,
+                                          padfDst, nDstStride);
+}
+
+/************************************************************************/
+/*                  GDALResampleConvolutionVerticalAVX()                */
+/************************************************************************/
+
+void GDALResampleConvolutionVerticalAVX( const double* padfSrc, int nStride,
+                                         const double* padfWeights,
+                                         int nSrcLineCount,
+                                         float* pafDst, int nDstXSize )
+{
+    int iCol = 0;
+
+    /* 8 columns at a time, sharing the broadcasts of the weights */
+    for( ; iCol + 7 < nDstXSize; iCol += 8 )
+    {
+        const double* padfCol = padfSrc + iCol;
+        __m256d v_acc0 = _mm256_setzero_pd();
+        __m256d v_acc1 = _mm256_setzero_pd();
+        for( int i = 0; i < nSrcLineCount; i++, padfCol += nStride )
+        {
+            const __m256d v_weight = _mm256_broadcast_sd(padfWeights + i);
+            v_acc0 = _mm256_add_pd(v_acc0,
+                        _mm256_mul_pd(_mm256_loadu_pd(padfCol), v_weight));
+            v_acc1 = _mm256_add_pd(v_acc1,
+                        _mm256_mul_pd(_mm256_loadu_pd(padfCol + 4), v_weight));
+        }
+        _mm_storeu_ps(pafDst + iCol, _mm256_cvtpd_ps(v_acc0));
+        _mm_storeu_ps(pafDst + iCol + 4, _mm256_cvtpd_ps(v_acc1));
+    }
+
+    for( ; iCol + 3 < nDstXSize; iCol += 4 )
+    {
+        const double* padfCol = padfSrc + iCol;
+        __m256d v_acc = _mm256_setzero_pd();
+        for( int i = 0; i < nSrcLineCount; i++, padfCol += nStride )
+        {
+            v_acc = _mm256_add_pd(v_acc,
+                        _mm256_mul_pd(_mm256_loadu_pd(padfCol),
+                                      _mm256_broadcast_sd(padfWeights + i)));
+        }
+        _mm_storeu_ps(pafDst + iCol, _mm256_cvtpd_ps(v_acc));
+    }
+
+    for( ; iCol < nDstXSize; iCol ++ )
+    {
+        double dfVal = 0.0;
+        for( int i = 0; i < nSrcLineCount; i++ )
+            dfVal += padfSrc[i * nStride + iCol] * padfWeights[i];
+        pafDst[iCol] = (float)dfVal;
+    }
+}
+
+#endif /* HAVE_AVX_AT_COMPILE_TIME */
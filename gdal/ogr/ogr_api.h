@@ -253,6 +253,7 @@ typedef void *OGRFeatureH;
 typedef void *OGRStyleTableH;
 #endif
 typedef struct OGRGeomFieldDefnHS *OGRGeomFieldDefnH;
+typedef struct OGRFeatureBatchHS *OGRFeatureBatchH;
 
 /* OGRFieldDefn */
 
@@ -352,6 +353,7 @@ OGRErr CPL_DLL OGR_F_SetGeometry( OGRFeatureH, OGRGeometryH );
 OGRGeometryH CPL_DLL OGR_F_GetGeometryRef( OGRFeatureH );
 OGRGeometryH CPL_DLL OGR_F_StealGeometry( OGRFeatureH ) CPL_WARN_UNUSED_RESULT;
 OGRFeatureH CPL_DLL OGR_F_Clone( OGRFeatureH ) CPL_WARN_UNUSED_RESULT;
+void   CPL_DLL OGR_F_Reset( OGRFeatureH );
 int    CPL_DLL OGR_F_Equal( OGRFeatureH, OGRFeatureH );
 
 int    CPL_DLL OGR_F_GetFieldCount( OGRFeatureH );
@@ -430,6 +432,20 @@ void   CPL_DLL OGR_F_FillUnsetWithDefault( OGRFeatureH hFeat,
                                            char** papszOptions );
 int    CPL_DLL OGR_F_Validate( OGRFeatureH, int nValidateFlags, int bEmitError );
 
+/* OGRFeatureBatch */
+
+OGRFeatureBatchH CPL_DLL OGR_FB_Create( OGRFeatureDefnH, int nCapacity ) CPL_WARN_UNUSED_RESULT;
+void   CPL_DLL OGR_FB_Destroy( OGRFeatureBatchH );
+int    CPL_DLL OGR_FB_GetFeatureCount( OGRFeatureBatchH );
+GIntBig CPL_DLL OGR_FB_GetFID( OGRFeatureBatchH, int iFeature );
+int    CPL_DLL OGR_FB_IsFieldSet( OGRFeatureBatchH, int iFeature, int iField );
+const int CPL_DLL *OGR_FB_GetFieldAsIntegerArray( OGRFeatureBatchH, int iField );
+const GIntBig CPL_DLL *OGR_FB_GetFieldAsInteger64Array( OGRFeatureBatchH, int iField );
+const double CPL_DLL *OGR_FB_GetFieldAsDoubleArray( OGRFeatureBatchH, int iField );
+const char CPL_DLL *OGR_FB_GetFieldAsString( OGRFeatureBatchH, int iFeature, int iField );
+const GByte CPL_DLL *OGR_FB_GetFieldAsBinary( OGRFeatureBatchH, int iFeature, int iField, int *pnBytes );
+const GByte CPL_DLL *OGR_FB_GetGeomFieldAsWkb( OGRFeatureBatchH, int iFeature, int iGeomField, size_t *pnBytes );
+
 /* -------------------------------------------------------------------- */
 /*      ogrsf_frmts.h                                                   */
 /* -------------------------------------------------------------------- */
@@ -461,6 +477,8 @@ OGRErr CPL_DLL OGR_L_SetAttributeFilter( OGRLayerH, const char * );
 void   CPL_DLL OGR_L_ResetReading( OGRLayerH );
 OGRFeatureH CPL_DLL OGR_L_GetNextFeature( OGRLayerH ) CPL_WARN_UNUSED_RESULT;
 OGRErr CPL_DLL OGR_L_SetNextByIndex( OGRLayerH, GIntBig );
+int    CPL_DLL OGR_L_GetNextFeatureBatch( OGRLayerH, OGRFeatureBatchH );
+void   CPL_DLL OGR_L_RecycleFeature( OGRLayerH, OGRFeatureH );
 OGRFeatureH CPL_DLL OGR_L_GetFeature( OGRLayerH, GIntBig )  CPL_WARN_UNUSED_RESULT;
 OGRErr CPL_DLL OGR_L_SetFeature( OGRLayerH, OGRFeatureH ) CPL_WARN_UNUSED_RESULT;
 OGRErr CPL_DLL OGR_L_CreateFeature( OGRLayerH, OGRFeatureH ) CPL_WARN_UNUSED_RESULT;
@@ -281,8 +281,11 @@ class CPL_DLL OGRFeature
     OGRField            *pauFields;
     char                *m_pszNativeData;
     char                *m_pszNativeMediaType;
+    char               **m_papszFieldBuffers;
+    int                  m_nFieldBuffers;
 
     bool                SetFieldInternal( int i, OGRField * puValue );
+    char               *AllocFieldString( int iField, const char *pszValue );
 
   protected: 
     long                nFields;
@@ -299,6 +302,8 @@ class CPL_DLL OGRFeature
 
     OGRFeatureDefn     *GetDefnRef() { return poDefn; }
 
+    void                Reset();
+
     OGRErr              SetGeometryDirectly( OGRGeometry * );
     OGRErr              SetGeometry( OGRGeometry * );
     OGRGeometry        *GetGeometryRef();
@@ -456,6 +461,102 @@ class CPL_DLL OGRFeature
     CPL_DISALLOW_COPY_ASSIGN(OGRFeature);
 };
 
+/************************************************************************/
+/*                           OGRFeatureBatch                            */
+/************************************************************************/
+
+struct OGRFeatureBatchColumn;
+
+/**
+ * A columnar buffer holding up to GetCapacity() features, filled by
+ * OGRLayer::GetNextFeatureBatch().
+ *
+ * Values are stored per field: OFTInteger, OFTInteger64 and OFTReal fields
+ * in arrays of int, GIntBig and double, OFTDate, OFTTime and OFTDateTime
+ * fields in an array of OGRField, and other field types, as well as geometry
+ * fields (as ISO WKB), in a data buffer indexed by an offset array of
+ * GetCapacity() + 1 entries.  Each field has a validity bitmap, with bit
+ * (i % 8) of byte (i / 8) set when the field of the i-th feature is set.
+ *
+ * @since GDAL 2.1
+ */
+
+class CPL_DLL OGRFeatureBatch
+{
+  private:
+    OGRFeatureDefn         *poDefn;
+    int                     nCapacity;
+    int                     nFeatureCount;
+    GIntBig                *panFIDs;
+    int                     nColumns;
+    OGRFeatureBatchColumn  *pasFields;
+    int                     nGeomColumns;
+    OGRFeatureBatchColumn  *pasGeomFields;
+
+    void                    InitColumns();
+    void                    FreeColumns();
+
+  public:
+                            OGRFeatureBatch( OGRFeatureDefn *poDefnIn,
+                                             int nCapacityIn = 1024 );
+                           ~OGRFeatureBatch();
+
+    OGRFeatureDefn         *GetDefnRef() { return poDefn; }
+    int                     GetCapacity() const { return nCapacity; }
+    int                     GetFeatureCount() const { return nFeatureCount; }
+    int                     IsFull() const { return nFeatureCount == nCapacity; }
+
+    void                    Clear();
+
+    /* Consumer side */
+    const GIntBig          *GetFIDs() const { return panFIDs; }
+    GIntBig                 GetFID( int iFeature ) const
+                                        { return panFIDs[iFeature]; }
+
+    const GByte            *GetFieldValidity( int iField ) const;
+    int                     IsFieldSet( int iFeature, int iField ) const;
+    const int              *GetFieldAsIntegerArray( int iField ) const;
+    const GIntBig          *GetFieldAsInteger64Array( int iField ) const;
+    const double           *GetFieldAsDoubleArray( int iField ) const;
+    const OGRField         *GetFieldAsDateTimeArray( int iField ) const;
+    const GByte            *GetFieldData( int iField ) const;
+    const size_t           *GetFieldOffsets( int iField ) const;
+    const char             *GetFieldAsString( int iFeature, int iField ) const;
+    const GByte            *GetFieldAsBinary( int iFeature, int iField,
+                                              int *pnBytes ) const;
+
+    const GByte            *GetGeomFieldValidity( int iGeomField ) const;
+    int                     IsGeomFieldSet( int iFeature,
+                                            int iGeomField ) const;
+    const GByte            *GetGeomFieldData( int iGeomField ) const;
+    const size_t           *GetGeomFieldOffsets( int iGeomField ) const;
+    const GByte            *GetGeomFieldAsWkb( int iFeature, int iGeomField,
+                                               size_t *pnBytes ) const;
+
+    /* Producer side: setters apply to the last added feature */
+    int                     AddFeature( GIntBig nFID );
+    int                     AddFeature( OGRFeature *poFeature );
+
+    void                    SetFieldInteger( int iField, int nValue );
+    void                    SetFieldInteger64( int iField, GIntBig nValue );
+    void                    SetFieldDouble( int iField, double dfValue );
+    void                    SetFieldString( int iField, const char *pszValue,
+                                            int nLength = -1 );
+    void                    SetFieldBinary( int iField, const GByte *pabyData,
+                                            int nBytes );
+    void                    SetField( int iField, const OGRField *psField );
+
+    GByte                  *AllocGeomFieldWkb( int iGeomField, size_t nBytes );
+    void                    SetGeomFieldWkb( int iGeomField,
+                                             const GByte *pabyWkb,
+                                             size_t nBytes );
+    OGRErr                  SetGeomField( int iGeomField,
+                                          OGRGeometry *poGeom );
+
+  private:
+    CPL_DISALLOW_COPY_ASSIGN(OGRFeatureBatch);
+};
+
 /************************************************************************/
 /*                           OGRFeatureQuery                            */
 /************************************************************************/
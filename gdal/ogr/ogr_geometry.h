@@ -72,6 +72,7 @@ class OGRMultiSurface;
 class OGRMultiPolygon;
 class OGRMultiCurve;
 class OGRMultiLineString;
+class OGRGeometryArena;
 
 typedef OGRLineString* (*OGRCurveCasterToLineString)(OGRCurve*);
 typedef OGRLinearRing* (*OGRCurveCasterToLinearRing)(OGRCurve*);
@@ -105,12 +106,17 @@ class CPL_DLL OGRGeometry
 {
   private:
     OGRSpatialReference * poSRS;                // may be NULL
+    int                   bReadOnly;            // allocated in an OGRGeometryArena
+
+    friend class OGRGeometryArena;
 
   protected:
     friend class OGRCurveCollection;
 
     int                   nCoordDimension;
 
+    int                   CheckWritable() const;
+
     OGRErr                importPreambuleFromWkt( char ** ppszInput,
                                                   int* pbHasZ, int* pbHasM,
                                                   bool* pbIsEmpty );
@@ -142,6 +148,8 @@ class CPL_DLL OGRGeometry
 
     OGRGeometry& operator=( const OGRGeometry& other );
 
+    int         IsReadOnly() const { return bReadOnly; }
+
     // standard IGeometry
     virtual int getDimension() const = 0;
     virtual int getCoordinateDimension() const;
@@ -384,6 +392,7 @@ class CPL_DLL OGRSimpleCurve: public OGRCurve
 {
   protected:
     friend class OGRGeometry;
+    friend class OGRGeometryArena;
 
     int         nPointCount;
     OGRRawPoint *paoPoints;
@@ -661,6 +670,7 @@ class CPL_DLL OGRCurveCollection
     friend class OGRCompoundCurve;
     friend class OGRCurvePolygon;
     friend class OGRPolygon;
+    friend class OGRGeometryArena;
 
     int         nCurveCount;
     OGRCurve  **papoCurves;
@@ -860,6 +870,7 @@ class CPL_DLL OGRCurvePolygon : public OGRSurface
 
   protected:
     friend class OGRPolygon;
+    friend class OGRGeometryArena;
     OGRCurveCollection oCC;
 
     static OGRPolygon* CastToPolygon(OGRCurvePolygon* poCP);
@@ -1017,6 +1028,8 @@ class CPL_DLL OGRGeometryCollection : public OGRGeometry
     OGRErr      importFromWktInternal( char **ppszInput, int nRecLevel );
 
   protected:
+    friend class OGRGeometryArena;
+
     int         nGeomCount;
     OGRGeometry **papoGeoms;
 
@@ -1281,6 +1294,9 @@ class CPL_DLL OGRGeometryFactory
   public:
     static OGRErr createFromWkb( unsigned char *, OGRSpatialReference *,
                                  OGRGeometry **, int = -1, OGRwkbVariant=wkbVariantOldOgc );
+    static OGRErr createFromWkb( unsigned char *, OGRSpatialReference *,
+                                 OGRGeometry **, int, OGRwkbVariant,
+                                 OGRGeometryArena *poArena );
     static OGRErr createFromWkt( char **, OGRSpatialReference *,
                                  OGRGeometry ** );
     static OGRErr createFromFgf( unsigned char *, OGRSpatialReference *,
@@ -1333,6 +1349,116 @@ class CPL_DLL OGRGeometryFactory
                                          const char*const* papszOptions = NULL);
 };
 
+/************************************************************************/
+/*                           OGRGeometryArena                           */
+/************************************************************************/
+
+/**
+ * Bump allocator holding geometries built from WKB.
+ *
+ * All the objects and coordinate arrays of the geometries created by
+ * OGRGeometryFactory::createFromWkb() with an arena are carved out of a few
+ * large memory blocks owned by the arena, and are released all at once by
+ * Reset() or by the destructor of the arena.
+ *
+ * Geometries allocated in an arena are read-only, as reported by
+ * OGRGeometry::IsReadOnly() : they must not be deleted (this is asserted in
+ * debug builds) or be passed to methods that take ownership of them (such as
+ * OGRFeature::SetGeometryDirectly()), and the methods that would add or
+ * remove points, parts or Z arrays fail with an error. Use clone() to get a
+ * regular heap allocated copy. Only linear geometry types are supported.
+ *
+ * @since GDAL 2.1
+ */
+
+class CPL_DLL OGRGeometryArena
+{
+    struct Block;
+    struct SRSRef;
+
+    size_t      nBlockSize;
+    Block      *psCurBlock;
+    Block      *psLargeBlocks;
+    size_t      nCurOffset;
+    size_t      nUsedSize;
+    SRSRef     *psSRSRefs;
+
+    void       *AllocateBlock( size_t nSize, int bLarge );
+
+    template<class T> T *New();
+    OGRErr      ReadPoints( OGRSimpleCurve *poCurve, unsigned char *pabyData,
+                            int nSize, int b3D, int bSwap, int *pnConsumed );
+    OGRErr      ReadGeometry( unsigned char *pabyData, int nSize,
+                              OGRwkbVariant eWkbVariant, int nRecLevel,
+                              OGRGeometry **ppoReturn, int *pnConsumed );
+
+                OGRGeometryArena( const OGRGeometryArena& );
+    OGRGeometryArena& operator=( const OGRGeometryArena& );
+
+  public:
+                OGRGeometryArena( size_t nBlockSize = 65536 );
+               ~OGRGeometryArena();
+
+    void       *Allocate( size_t nSize );
+    void        Reset();
+    size_t      GetUsedSize() const { return nUsedSize; }
+
+    OGRErr      CreateFromWkb( unsigned char *pabyData,
+                               OGRSpatialReference *poSR,
+                               OGRGeometry **ppoReturn,
+                               int nBytes = -1,
+                               OGRwkbVariant eWkbVariant = wkbVariantOldOgc );
+};
+
+/************************************************************************/
+/*                              OGRWKBView                              */
+/************************************************************************/
+
+/**
+ * Read-only view over a WKB geometry.
+ *
+ * The view computes envelopes, measures and simple spatial predicates
+ * directly from the serialized coordinates, without instantiating any
+ * OGRGeometry or copying any point array. The WKB buffer must remain valid
+ * for the lifetime of the view. Only linear geometry types (points,
+ * linestrings, polygons, their multi counterparts and collections of them)
+ * are supported; IsValid() returns FALSE for others and for corrupted data.
+ *
+ * @since GDAL 2.1
+ */
+
+class CPL_DLL OGRWKBView
+{
+    const GByte        *pabyData;
+    int                 nWkbSize;
+    OGRwkbVariant       eWkbVariant;
+    OGRwkbGeometryType  eGeometryType;
+    int                 b3D;
+    int                 nPointCount;
+
+  public:
+                OGRWKBView( const GByte *pabyData, int nBytes = -1,
+                            OGRwkbVariant eWkbVariant = wkbVariantOldOgc );
+
+    int                 IsValid() const { return nWkbSize > 0; }
+    int                 WkbSize() const { return nWkbSize; }
+    OGRwkbGeometryType  getGeometryType() const;
+    int                 Is3D() const { return b3D; }
+    int                 IsEmpty() const { return nPointCount == 0; }
+    int                 getNumPoints() const { return nPointCount; }
+
+    void                getEnvelope( OGREnvelope *psEnvelope ) const;
+    void                getEnvelope( OGREnvelope3D *psEnvelope ) const;
+    double              get_Length() const;
+    double              get_Area() const;
+
+    OGRBoolean          Contains( double dfX, double dfY ) const;
+    OGRBoolean          Intersects( const OGREnvelope& sEnvelope ) const;
+
+    OGRGeometry        *Materialize( OGRSpatialReference *poSR = NULL,
+                                     OGRGeometryArena *poArena = NULL ) const;
+};
+
 OGRwkbGeometryType CPL_DLL OGRFromOGCGeomType( const char *pszGeomType );
 const char CPL_DLL * OGRToOGCGeomType( OGRwkbGeometryType eGeomType );
 
@@ -146,6 +146,9 @@ OGRErr OGRCurveCollection::addCurveDirectly( OGRGeometry* poGeom,
                                              OGRCurve* poCurve,
                                              int bNeedRealloc )
 {
+    if( !poGeom->CheckWritable() )
+        return OGRERR_FAILURE;
+
     if( poCurve->getCoordinateDimension() == 3 && poGeom->getCoordinateDimension() != 3 )
         poGeom->setCoordinateDimension(3);
     else if( poCurve->getCoordinateDimension() != 3 && poGeom->getCoordinateDimension() == 3 )
@@ -73,6 +73,7 @@ OGRCurvePolygon::OGRCurvePolygon( const OGRCurvePolygon& other ) :
 OGRCurvePolygon::~OGRCurvePolygon()
 
 {
+    CPLAssert( !IsReadOnly() );
 }
 
 /************************************************************************/
@@ -133,6 +134,8 @@ OGRGeometry *OGRCurvePolygon::clone() const
 void OGRCurvePolygon::empty()
 
 {
+    if( !CheckWritable() )
+        return;
     oCC.empty(this);
 }
 
@@ -278,7 +281,7 @@ const OGRCurve *OGRCurvePolygon::getInteriorRingCurve( int iRing ) const
 
 OGRCurve *OGRCurvePolygon::stealExteriorRingCurve()
 {
-    if( oCC.nCurveCount == 0 )
+    if( oCC.nCurveCount == 0 || !CheckWritable() )
         return NULL;
     OGRCurve *poRet = oCC.papoCurves[0];
     oCC.papoCurves[0] = NULL;
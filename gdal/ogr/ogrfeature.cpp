@@ -61,6 +61,8 @@ OGRFeature::OGRFeature( OGRFeatureDefn * poDefnIn ) :
             poDefn(poDefnIn),
             m_pszNativeData(NULL),
             m_pszNativeMediaType(NULL),
+            m_papszFieldBuffers(NULL),
+            m_nFieldBuffers(0),
             m_pszStyleString(NULL),
             m_poStyleTable(NULL),
             m_pszTmpFieldValue(NULL)
@@ -168,6 +170,10 @@ OGRFeature::~OGRFeature()
 
     poDefn->Release();
 
+    for( i = 0; i < m_nFieldBuffers; i++ )
+        VSIFree( m_papszFieldBuffers[i] );
+    CPLFree( m_papszFieldBuffers );
+
     CPLFree( pauFields );
     CPLFree( papoGeometries );
     CPLFree(m_pszStyleString);
@@ -888,6 +894,109 @@ OGRFeatureH OGR_F_Clone( OGRFeatureH hFeat )
     return (OGRFeatureH) ((OGRFeature *) hFeat)->Clone();
 }
 
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+/**
+ * \brief Reset the feature to the state it had after construction.
+ *
+ * All fields are unset, geometries are destroyed, and the FID, style
+ * string and native data are cleared. The field array is kept, and so
+ * are the buffers of the string fields, which are reused by later
+ * SetField() calls on the same fields. A feature can thus be refilled
+ * with the content of another row without heap allocations in the
+ * common case (see OGRLayer::RecycleFeature()).
+ *
+ * This method is the same as the C function OGR_F_Reset().
+ *
+ * @since GDAL 2.1
+ */
+
+void OGRFeature::Reset()
+
+{
+    UpdateFields();
+
+    const int nFieldCount = ( pauFields != NULL ) ? poDefn->GetFieldCount() : 0;
+    for( int i = 0; i < nFieldCount; i++ )
+    {
+        if( !IsFieldSet(i) )
+            continue;
+
+        if( poDefn->GetFieldDefn(i)->GetType() == OFTString
+            && pauFields[i].String != NULL )
+        {
+            if( m_nFieldBuffers < nFieldCount )
+            {
+                char** papszNewBuffers = (char **)
+                    VSI_REALLOC_VERBOSE( m_papszFieldBuffers,
+                                         nFieldCount * sizeof(char*) );
+                if( papszNewBuffers == NULL )
+                {
+                    UnsetField(i);
+                    continue;
+                }
+                memset( papszNewBuffers + m_nFieldBuffers, 0,
+                        (nFieldCount - m_nFieldBuffers) * sizeof(char*) );
+                m_papszFieldBuffers = papszNewBuffers;
+                m_nFieldBuffers = nFieldCount;
+            }
+
+            // Keep the string buffer for the next value of this field
+            VSIFree( m_papszFieldBuffers[i] );
+            m_papszFieldBuffers[i] = pauFields[i].String;
+            pauFields[i].Set.nMarker1 = OGRUnsetMarker;
+            pauFields[i].Set.nMarker2 = OGRUnsetMarker;
+        }
+        else
+        {
+            UnsetField(i);
+        }
+    }
+
+    const int nGeomFieldCount =
+        ( papoGeometries != NULL ) ? poDefn->GetGeomFieldCount() : 0;
+    for( int i = 0; i < nGeomFieldCount; i++ )
+    {
+        delete papoGeometries[i];
+        papoGeometries[i] = NULL;
+    }
+
+    nFID = OGRNullFID;
+
+    CPLFree( m_pszStyleString );
+    m_pszStyleString = NULL;
+    delete m_poStyleTable;
+    m_poStyleTable = NULL;
+    CPLFree( m_pszNativeData );
+    m_pszNativeData = NULL;
+    CPLFree( m_pszNativeMediaType );
+    m_pszNativeMediaType = NULL;
+}
+
+/************************************************************************/
+/*                            OGR_F_Reset()                             */
+/************************************************************************/
+
+/**
+ * \brief Reset the feature to the state it had after construction.
+ *
+ * This function is the same as the C++ method OGRFeature::Reset().
+ *
+ * @param hFeat handle to the feature to reset.
+ *
+ * @since GDAL 2.1
+ */
+
+void OGR_F_Reset( OGRFeatureH hFeat )
+
+{
+    VALIDATE_POINTER0( hFeat, "OGR_F_Reset" );
+
+    ((OGRFeature *) hFeat)->Reset();
+}
+
 /************************************************************************/
 /*                           GetFieldCount()                            */
 /************************************************************************/
@@ -2713,6 +2822,50 @@ static int OGRFeatureGetIntegerValue(OGRFieldDefn *poFDefn, int nValue)
     return nValue;
 }
 
+/************************************************************************/
+/*                          AllocFieldString()                          */
+/*                                                                      */
+/*      Return a buffer holding a copy of pszValue for the string       */
+/*      field iField. The current value of the field, or the buffer     */
+/*      kept by Reset(), is reused when large enough. In all cases      */
+/*      the previous value of the field is released.                    */
+/************************************************************************/
+
+char *OGRFeature::AllocFieldString( int iField, const char *pszValue )
+
+{
+    char *pszBuffer = NULL;
+
+    if( IsFieldSet(iField) )
+        pszBuffer = pauFields[iField].String;
+    else if( iField < m_nFieldBuffers )
+    {
+        pszBuffer = m_papszFieldBuffers[iField];
+        m_papszFieldBuffers[iField] = NULL;
+    }
+
+    const size_t nLen = strlen(pszValue);
+    if( pszBuffer == NULL )
+        return VSI_STRDUP_VERBOSE( pszValue );
+
+    // A buffer is at least as large as the string it holds. pszValue may
+    // point into it, hence the memmove().
+    if( strlen(pszBuffer) >= nLen )
+    {
+        memmove( pszBuffer, pszValue, nLen + 1 );
+        return pszBuffer;
+    }
+
+    char *pszNewBuffer = (char *) VSI_REALLOC_VERBOSE( pszBuffer, nLen + 1 );
+    if( pszNewBuffer == NULL )
+    {
+        VSIFree( pszBuffer );
+        return NULL;
+    }
+    memcpy( pszNewBuffer, pszValue, nLen + 1 );
+    return pszNewBuffer;
+}
+
 /************************************************************************/
 /*                              UpdatetFields()                              */
 /************************************************************************/
@@ -2809,10 +2962,7 @@ void OGRFeature::SetField( int iField, int nValue )
 
         snprintf( szTempBuffer, sizeof(szTempBuffer), "%d", nValue );
 
-        if( IsFieldSet( iField) )
-            CPLFree( pauFields[iField].String );
-
-        pauFields[iField].String = VSI_STRDUP_VERBOSE( szTempBuffer );
+        pauFields[iField].String = AllocFieldString( iField, szTempBuffer );
         if( pauFields[iField].String == NULL )
         {
             pauFields[iField].Set.nMarker1 = OGRUnsetMarker;
@@ -2940,10 +3090,7 @@ void OGRFeature::SetField( int iField, GIntBig nValue )
 
         snprintf( szTempBuffer, sizeof(szTempBuffer), CPL_FRMT_GIB, nValue );
 
-        if( IsFieldSet( iField) )
-            CPLFree( pauFields[iField].String );
-
-        pauFields[iField].String = VSI_STRDUP_VERBOSE( szTempBuffer );
+        pauFields[iField].String = AllocFieldString( iField, szTempBuffer );
         if( pauFields[iField].String == NULL )
         {
             pauFields[iField].Set.nMarker1 = OGRUnsetMarker;
@@ -3061,10 +3208,7 @@ void OGRFeature::SetField( int iField, double dfValue )
 
         CPLsnprintf( szTempBuffer, sizeof(szTempBuffer), "%.16g", dfValue );
 
-        if( IsFieldSet( iField) )
-            CPLFree( pauFields[iField].String );
-
-        pauFields[iField].String = VSI_STRDUP_VERBOSE( szTempBuffer );
+        pauFields[iField].String = AllocFieldString( iField, szTempBuffer );
         if( pauFields[iField].String == NULL )
         {
             pauFields[iField].Set.nMarker1 = OGRUnsetMarker;
@@ -3147,10 +3291,8 @@ void OGRFeature::SetField( int iField, const char * pszValue )
     OGRFieldType eType = poFDefn->GetType();
     if( eType == OFTString )
     {
-        if( IsFieldSet(iField) )
-            CPLFree( pauFields[iField].String );
-
-        pauFields[iField].String = VSI_STRDUP_VERBOSE( pszValue ? pszValue : "" );
+        pauFields[iField].String =
+            AllocFieldString( iField, pszValue ? pszValue : "" );
         if( pauFields[iField].String == NULL )
         {
             pauFields[iField].Set.nMarker1 = OGRUnsetMarker;
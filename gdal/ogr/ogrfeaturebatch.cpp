@@ -0,0 +1,1147 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRFeatureBatch class implementation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_feature.h"
+#include "ogr_api.h"
+#include "ogr_p.h"
+
+CPL_CVSID("$Id$");
+
+/************************************************************************/
+/*                        OGRFeatureBatchColumn                         */
+/************************************************************************/
+
+struct OGRFeatureBatchColumn
+{
+    OGRFieldType  eType;
+    int           nEltSize;     /* 0 for variable size columns */
+    GByte        *pabyValidity;
+    GByte        *pabyValues;   /* fixed size columns */
+    size_t       *panOffsets;   /* variable size columns */
+    GByte        *pabyData;
+    size_t        nDataSize;
+    size_t        nDataAlloc;
+};
+
+/************************************************************************/
+/*                         GetFixedEltSize()                            */
+/************************************************************************/
+
+static int GetFixedEltSize( OGRFieldType eType )
+{
+    switch( eType )
+    {
+        case OFTInteger:
+            return (int)sizeof(int);
+        case OFTInteger64:
+            return (int)sizeof(GIntBig);
+        case OFTReal:
+            return (int)sizeof(double);
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+            return (int)sizeof(OGRField);
+        default:
+            return 0;
+    }
+}
+
+/************************************************************************/
+/*                          InitColumn()                                */
+/************************************************************************/
+
+static void InitColumn( OGRFeatureBatchColumn* psCol, OGRFieldType eType,
+                        int nCapacity )
+{
+    memset(psCol, 0, sizeof(OGRFeatureBatchColumn));
+    psCol->eType = eType;
+    psCol->nEltSize = GetFixedEltSize(eType);
+    psCol->pabyValidity = (GByte*) CPLCalloc(1, (nCapacity + 7) / 8);
+    if( psCol->nEltSize )
+        psCol->pabyValues = (GByte*) CPLCalloc(nCapacity, psCol->nEltSize);
+    else
+        psCol->panOffsets = (size_t*) CPLCalloc(nCapacity + 1, sizeof(size_t));
+}
+
+/************************************************************************/
+/*                          FreeColumn()                                */
+/************************************************************************/
+
+static void FreeColumn( OGRFeatureBatchColumn* psCol )
+{
+    CPLFree(psCol->pabyValidity);
+    CPLFree(psCol->pabyValues);
+    CPLFree(psCol->panOffsets);
+    CPLFree(psCol->pabyData);
+}
+
+/************************************************************************/
+/*                          ResetColumn()                               */
+/************************************************************************/
+
+static void ResetColumn( OGRFeatureBatchColumn* psCol, int nCapacity )
+{
+    memset(psCol->pabyValidity, 0, (nCapacity + 7) / 8);
+    if( psCol->panOffsets )
+        psCol->panOffsets[0] = 0;
+    psCol->nDataSize = 0;
+}
+
+/************************************************************************/
+/*                         StartColumnRow()                             */
+/*                                                                      */
+/*      Called when a new feature is added: the value of this row is    */
+/*      unset until a setter is called.                                 */
+/************************************************************************/
+
+static void StartColumnRow( OGRFeatureBatchColumn* psCol, int iRow )
+{
+    if( psCol->nEltSize )
+        memset(psCol->pabyValues + (size_t)iRow * psCol->nEltSize, 0,
+               psCol->nEltSize);
+    else
+        psCol->panOffsets[iRow + 1] = psCol->panOffsets[iRow];
+}
+
+/************************************************************************/
+/*                          SetValidity()                               */
+/************************************************************************/
+
+static void SetValidity( OGRFeatureBatchColumn* psCol, int iRow, int bSet )
+{
+    if( bSet )
+        psCol->pabyValidity[iRow / 8] |= (GByte)(1 << (iRow % 8));
+    else
+        psCol->pabyValidity[iRow / 8] &= (GByte)~(1 << (iRow % 8));
+}
+
+/************************************************************************/
+/*                         AllocVarValue()                              */
+/*                                                                      */
+/*      Reserve nBytes in the data buffer for the value of the last     */
+/*      row of a variable size column. Setting a value twice replaces   */
+/*      the previous one.                                               */
+/************************************************************************/
+
+static GByte* AllocVarValue( OGRFeatureBatchColumn* psCol, int iRow,
+                             size_t nBytes )
+{
+    const size_t nStart = psCol->panOffsets[iRow];
+    if( nStart + nBytes < nStart )
+        return NULL;
+    if( nStart + nBytes > psCol->nDataAlloc )
+    {
+        size_t nNewAlloc = psCol->nDataAlloc ? psCol->nDataAlloc : 4096;
+        while( nNewAlloc < nStart + nBytes )
+        {
+            if( nNewAlloc * 2 < nNewAlloc )
+                return NULL;
+            nNewAlloc *= 2;
+        }
+        GByte* pabyNew = (GByte*)VSI_REALLOC_VERBOSE(psCol->pabyData, nNewAlloc);
+        if( pabyNew == NULL )
+            return NULL;
+        psCol->pabyData = pabyNew;
+        psCol->nDataAlloc = nNewAlloc;
+    }
+    psCol->nDataSize = nStart + nBytes;
+    psCol->panOffsets[iRow + 1] = psCol->nDataSize;
+    SetValidity(psCol, iRow, TRUE);
+    return psCol->pabyData + nStart;
+}
+
+/************************************************************************/
+/*                          OGRFeatureBatch()                           */
+/************************************************************************/
+
+/**
+ * \brief Constructor
+ *
+ * The batch increments the reference count of its OGRFeatureDefn, which
+ * must be the layer definition of the layers it is used with.
+ *
+ * This method is the same as the C function OGR_FB_Create().
+ *
+ * @param poDefnIn layer definition.
+ * @param nCapacityIn maximum number of features held by the batch.
+ * @since GDAL 2.1
+ */
+
+OGRFeatureBatch::OGRFeatureBatch( OGRFeatureDefn *poDefnIn, int nCapacityIn ) :
+    poDefn(poDefnIn),
+    nCapacity(MAX(1, nCapacityIn)),
+    nFeatureCount(0),
+    panFIDs(NULL),
+    nColumns(0),
+    pasFields(NULL),
+    nGeomColumns(0),
+    pasGeomFields(NULL)
+{
+    poDefn->Reference();
+    panFIDs = (GIntBig*) CPLCalloc(nCapacity, sizeof(GIntBig));
+    InitColumns();
+}
+
+/************************************************************************/
+/*                         ~OGRFeatureBatch()                           */
+/************************************************************************/
+
+OGRFeatureBatch::~OGRFeatureBatch()
+{
+    FreeColumns();
+    CPLFree(panFIDs);
+    poDefn->Release();
+}
+
+/************************************************************************/
+/*                            InitColumns()                             */
+/************************************************************************/
+
+void OGRFeatureBatch::InitColumns()
+{
+    nColumns = poDefn->GetFieldCount();
+    pasFields = (OGRFeatureBatchColumn*)
+        CPLCalloc(MAX(1, nColumns), sizeof(OGRFeatureBatchColumn));
+    for( int i = 0; i < nColumns; i++ )
+        InitColumn(&pasFields[i], poDefn->GetFieldDefn(i)->GetType(),
+                   nCapacity);
+
+    nGeomColumns = poDefn->GetGeomFieldCount();
+    pasGeomFields = (OGRFeatureBatchColumn*)
+        CPLCalloc(MAX(1, nGeomColumns), sizeof(OGRFeatureBatchColumn));
+    for( int i = 0; i < nGeomColumns; i++ )
+        InitColumn(&pasGeomFields[i], OFTBinary, nCapacity);
+}
+
+/************************************************************************/
+/*                            FreeColumns()                             */
+/************************************************************************/
+
+void OGRFeatureBatch::FreeColumns()
+{
+    for( int i = 0; i < nColumns; i++ )
+        FreeColumn(&pasFields[i]);
+    CPLFree(pasFields);
+    pasFields = NULL;
+    nColumns = 0;
+    for( int i = 0; i < nGeomColumns; i++ )
+        FreeColumn(&pasGeomFields[i]);
+    CPLFree(pasGeomFields);
+    pasGeomFields = NULL;
+    nGeomColumns = 0;
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+/**
+ * \brief Remove all features from the batch.
+ *
+ * Buffers are kept allocated, so that refilling the batch does not
+ * allocate memory once it has grown to its working size.  If the layer
+ * definition has changed since the batch was created, the columns are
+ * recreated.
+ *
+ * @since GDAL 2.1
+ */
+
+void OGRFeatureBatch::Clear()
+{
+    nFeatureCount = 0;
+
+    bool bDefnChanged = nColumns != poDefn->GetFieldCount() ||
+                        nGeomColumns != poDefn->GetGeomFieldCount();
+    for( int i = 0; !bDefnChanged && i < nColumns; i++ )
+    {
+        if( pasFields[i].eType != poDefn->GetFieldDefn(i)->GetType() )
+            bDefnChanged = true;
+    }
+    if( bDefnChanged )
+    {
+        FreeColumns();
+        InitColumns();
+        return;
+    }
+
+    for( int i = 0; i < nColumns; i++ )
+        ResetColumn(&pasFields[i], nCapacity);
+    for( int i = 0; i < nGeomColumns; i++ )
+        ResetColumn(&pasGeomFields[i], nCapacity);
+}
+
+/************************************************************************/
+/*                             AddFeature()                             */
+/************************************************************************/
+
+/**
+ * \brief Append a feature with all its fields unset.
+ *
+ * The field setters then apply to this feature.
+ *
+ * @param nFID feature id.
+ * @return TRUE, or FALSE if the batch is full.
+ * @since GDAL 2.1
+ */
+
+int OGRFeatureBatch::AddFeature( GIntBig nFID )
+{
+    if( nFeatureCount == nCapacity )
+        return FALSE;
+
+    const int iRow = nFeatureCount++;
+    panFIDs[iRow] = nFID;
+    for( int i = 0; i < nColumns; i++ )
+        StartColumnRow(&pasFields[i], iRow);
+    for( int i = 0; i < nGeomColumns; i++ )
+        StartColumnRow(&pasGeomFields[i], iRow);
+    return TRUE;
+}
+
+/**
+ * \brief Append a copy of the content of a feature.
+ *
+ * The feature must follow the layer definition of the batch.
+ *
+ * @param poFeature feature to copy.
+ * @return TRUE, or FALSE if the batch is full.
+ * @since GDAL 2.1
+ */
+
+int OGRFeatureBatch::AddFeature( OGRFeature *poFeature )
+{
+    if( !AddFeature(poFeature->GetFID()) )
+        return FALSE;
+
+    const int nFields = MIN(nColumns, poFeature->GetFieldCount());
+    for( int i = 0; i < nFields; i++ )
+    {
+        if( poFeature->IsFieldSet(i) )
+            SetField(i, poFeature->GetRawFieldRef(i));
+    }
+
+    const int nGeomFields = MIN(nGeomColumns, poFeature->GetGeomFieldCount());
+    for( int i = 0; i < nGeomFields; i++ )
+    {
+        OGRGeometry* poGeom = poFeature->GetGeomFieldRef(i);
+        if( poGeom != NULL )
+            SetGeomField(i, poGeom);
+    }
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          SetFieldInteger()                           */
+/************************************************************************/
+
+void OGRFeatureBatch::SetFieldInteger( int iField, int nValue )
+{
+    CPLAssert( nFeatureCount > 0 && iField >= 0 && iField < nColumns );
+    OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    const int iRow = nFeatureCount - 1;
+    switch( psCol->eType )
+    {
+        case OFTInteger:
+            ((int*)psCol->pabyValues)[iRow] = nValue;
+            break;
+        case OFTInteger64:
+            ((GIntBig*)psCol->pabyValues)[iRow] = nValue;
+            break;
+        case OFTReal:
+            ((double*)psCol->pabyValues)[iRow] = nValue;
+            break;
+        default:
+        {
+            char szTmp[32];
+            snprintf(szTmp, sizeof(szTmp), "%d", nValue);
+            SetFieldString(iField, szTmp);
+            return;
+        }
+    }
+    SetValidity(psCol, iRow, TRUE);
+}
+
+/************************************************************************/
+/*                         SetFieldInteger64()                          */
+/************************************************************************/
+
+void OGRFeatureBatch::SetFieldInteger64( int iField, GIntBig nValue )
+{
+    CPLAssert( nFeatureCount > 0 && iField >= 0 && iField < nColumns );
+    OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    const int iRow = nFeatureCount - 1;
+    switch( psCol->eType )
+    {
+        case OFTInteger:
+            ((int*)psCol->pabyValues)[iRow] = (int)nValue;
+            break;
+        case OFTInteger64:
+            ((GIntBig*)psCol->pabyValues)[iRow] = nValue;
+            break;
+        case OFTReal:
+            ((double*)psCol->pabyValues)[iRow] = (double)nValue;
+            break;
+        default:
+        {
+            char szTmp[32];
+            snprintf(szTmp, sizeof(szTmp), CPL_FRMT_GIB, nValue);
+            SetFieldString(iField, szTmp);
+            return;
+        }
+    }
+    SetValidity(psCol, iRow, TRUE);
+}
+
+/************************************************************************/
+/*                           SetFieldDouble()                           */
+/************************************************************************/
+
+void OGRFeatureBatch::SetFieldDouble( int iField, double dfValue )
+{
+    CPLAssert( nFeatureCount > 0 && iField >= 0 && iField < nColumns );
+    OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    const int iRow = nFeatureCount - 1;
+    switch( psCol->eType )
+    {
+        case OFTInteger:
+            ((int*)psCol->pabyValues)[iRow] = (int)dfValue;
+            break;
+        case OFTInteger64:
+            ((GIntBig*)psCol->pabyValues)[iRow] = (GIntBig)dfValue;
+            break;
+        case OFTReal:
+            ((double*)psCol->pabyValues)[iRow] = dfValue;
+            break;
+        default:
+        {
+            char szTmp[64];
+            CPLsnprintf(szTmp, sizeof(szTmp), "%.15g", dfValue);
+            SetFieldString(iField, szTmp);
+            return;
+        }
+    }
+    SetValidity(psCol, iRow, TRUE);
+}
+
+/************************************************************************/
+/*                           SetFieldString()                           */
+/************************************************************************/
+
+/**
+ * \brief Set the value of a field of the last added feature from a string.
+ *
+ * Only valid for OFTString and OFTBinary fields (the nul terminating
+ * character is not stored for the latter). For other field types, use
+ * SetField().
+ *
+ * @param iField field index.
+ * @param pszValue string, which does not need to be nul terminated if
+ * nLength is specified.
+ * @param nLength string length, or -1 to use strlen(pszValue).
+ * @since GDAL 2.1
+ */
+
+void OGRFeatureBatch::SetFieldString( int iField, const char *pszValue,
+                                      int nLength )
+{
+    CPLAssert( nFeatureCount > 0 && iField >= 0 && iField < nColumns );
+    OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    if( psCol->nEltSize != 0 )
+    {
+        CPLAssert( false );
+        return;
+    }
+    const size_t nLen = (nLength < 0) ? strlen(pszValue) : (size_t)nLength;
+    const size_t nTerm = (psCol->eType == OFTString) ? 1 : 0;
+    GByte* pabyDst = AllocVarValue(psCol, nFeatureCount - 1, nLen + nTerm);
+    if( pabyDst == NULL )
+        return;
+    memcpy(pabyDst, pszValue, nLen);
+    if( nTerm )
+        pabyDst[nLen] = '\0';
+}
+
+/************************************************************************/
+/*                           SetFieldBinary()                           */
+/************************************************************************/
+
+void OGRFeatureBatch::SetFieldBinary( int iField, const GByte *pabyData,
+                                      int nBytes )
+{
+    CPLAssert( nFeatureCount > 0 && iField >= 0 && iField < nColumns );
+    OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    if( psCol->eType == OFTString )
+    {
+        SetFieldString(iField, (const char*)pabyData, nBytes);
+        return;
+    }
+    if( psCol->nEltSize != 0 || nBytes < 0 )
+    {
+        CPLAssert( false );
+        return;
+    }
+    GByte* pabyDst = AllocVarValue(psCol, nFeatureCount - 1, nBytes);
+    if( pabyDst != NULL && nBytes > 0 )
+        memcpy(pabyDst, pabyData, nBytes);
+}
+
+/************************************************************************/
+/*                              SetField()                              */
+/************************************************************************/
+
+/**
+ * \brief Set the value of a field of the last added feature from a
+ * OGRField of the type of the field.
+ *
+ * List values are stored packed in the data buffer of the field: arrays of
+ * int, GIntBig or double for OFTIntegerList, OFTInteger64List and
+ * OFTRealList, and nul terminated strings one after the other for
+ * OFTStringList.
+ *
+ * @param iField field index.
+ * @param psField value.
+ * @since GDAL 2.1
+ */
+
+void OGRFeatureBatch::SetField( int iField, const OGRField *psField )
+{
+    CPLAssert( nFeatureCount > 0 && iField >= 0 && iField < nColumns );
+    if( psField->Set.nMarker1 == OGRUnsetMarker &&
+        psField->Set.nMarker2 == OGRUnsetMarker )
+        return;
+
+    OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    const int iRow = nFeatureCount - 1;
+    switch( psCol->eType )
+    {
+        case OFTInteger:
+            ((int*)psCol->pabyValues)[iRow] = psField->Integer;
+            SetValidity(psCol, iRow, TRUE);
+            break;
+
+        case OFTInteger64:
+            ((GIntBig*)psCol->pabyValues)[iRow] = psField->Integer64;
+            SetValidity(psCol, iRow, TRUE);
+            break;
+
+        case OFTReal:
+            ((double*)psCol->pabyValues)[iRow] = psField->Real;
+            SetValidity(psCol, iRow, TRUE);
+            break;
+
+        case OFTDate:
+        case OFTTime:
+        case OFTDateTime:
+            ((OGRField*)psCol->pabyValues)[iRow] = *psField;
+            SetValidity(psCol, iRow, TRUE);
+            break;
+
+        case OFTString:
+            if( psField->String != NULL )
+                SetFieldString(iField, psField->String);
+            break;
+
+        case OFTBinary:
+            SetFieldBinary(iField, psField->Binary.paData,
+                           psField->Binary.nCount);
+            break;
+
+        case OFTIntegerList:
+            SetFieldBinary(iField, (const GByte*)psField->IntegerList.paList,
+                           psField->IntegerList.nCount * (int)sizeof(int));
+            break;
+
+        case OFTInteger64List:
+            SetFieldBinary(iField,
+                           (const GByte*)psField->Integer64List.paList,
+                           psField->Integer64List.nCount * (int)sizeof(GIntBig));
+            break;
+
+        case OFTRealList:
+            SetFieldBinary(iField, (const GByte*)psField->RealList.paList,
+                           psField->RealList.nCount * (int)sizeof(double));
+            break;
+
+        case OFTStringList:
+        {
+            size_t nTotal = 0;
+            for( int i = 0; i < psField->StringList.nCount; i++ )
+                nTotal += strlen(psField->StringList.paList[i]) + 1;
+            GByte* pabyDst = AllocVarValue(psCol, iRow, nTotal);
+            if( pabyDst == NULL )
+                break;
+            for( int i = 0; i < psField->StringList.nCount; i++ )
+            {
+                const size_t nLen = strlen(psField->StringList.paList[i]) + 1;
+                memcpy(pabyDst, psField->StringList.paList[i], nLen);
+                pabyDst += nLen;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+/************************************************************************/
+/*                         AllocGeomFieldWkb()                          */
+/************************************************************************/
+
+/**
+ * \brief Reserve space for the WKB geometry of the last added feature.
+ *
+ * This is meant for drivers that can write the WKB directly. It must be
+ * ISO WKB in the native byte order.
+ *
+ * @param iGeomField geometry field index.
+ * @param nBytes WKB size.
+ * @return a pointer valid until the next call to a method of the batch,
+ * or NULL in case of memory allocation failure.
+ * @since GDAL 2.1
+ */
+
+GByte *OGRFeatureBatch::AllocGeomFieldWkb( int iGeomField, size_t nBytes )
+{
+    CPLAssert( nFeatureCount > 0 && iGeomField >= 0 &&
+               iGeomField < nGeomColumns );
+    return AllocVarValue(&pasGeomFields[iGeomField], nFeatureCount - 1, nBytes);
+}
+
+/************************************************************************/
+/*                          SetGeomFieldWkb()                           */
+/************************************************************************/
+
+/**
+ * \brief Set the geometry of the last added feature from WKB.
+ *
+ * The WKB is copied as it is when it is ISO WKB (or 2D WKB) in the native
+ * byte order. Otherwise (other byte order, 3D geometries with the
+ * wkb25DBit flag, ...), it is converted.
+ *
+ * @param iGeomField geometry field index.
+ * @param pabyWkb WKB geometry.
+ * @param nBytes WKB size.
+ * @since GDAL 2.1
+ */
+
+void OGRFeatureBatch::SetGeomFieldWkb( int iGeomField, const GByte *pabyWkb,
+                                       size_t nBytes )
+{
+#ifdef CPL_LSB
+    const GByte byNativeOrder = wkbNDR;
+#else
+    const GByte byNativeOrder = wkbXDR;
+#endif
+    GUInt32 nGeomType = 0;
+    if( nBytes >= 5 )
+        memcpy(&nGeomType, pabyWkb + 1, 4);
+
+    // The high bits are used by the wkb25DBit flag of the old OGC 3D
+    // geometry types, and by PostGIS extended WKB.
+    if( nBytes < 5 || pabyWkb[0] != byNativeOrder ||
+        (nGeomType & 0xE0000000U) != 0 )
+    {
+        OGRGeometry* poGeom = NULL;
+        if( nBytes <= INT_MAX &&
+            OGRGeometryFactory::createFromWkb(
+                const_cast<GByte*>(pabyWkb), NULL, &poGeom,
+                static_cast<int>(nBytes), wkbVariantIso) == OGRERR_NONE )
+        {
+            SetGeomField(iGeomField, poGeom);
+        }
+        delete poGeom;
+        return;
+    }
+
+    GByte* pabyDst = AllocGeomFieldWkb(iGeomField, nBytes);
+    if( pabyDst != NULL )
+        memcpy(pabyDst, pabyWkb, nBytes);
+}
+
+/************************************************************************/
+/*                            SetGeomField()                            */
+/************************************************************************/
+
+/**
+ * \brief Set the geometry of the last added feature.
+ *
+ * The geometry is exported as ISO WKB in the native byte order.
+ *
+ * @param iGeomField geometry field index.
+ * @param poGeom geometry (not modified), or NULL.
+ * @return OGRERR_NONE in case of success.
+ * @since GDAL 2.1
+ */
+
+OGRErr OGRFeatureBatch::SetGeomField( int iGeomField, OGRGeometry *poGeom )
+{
+    if( poGeom == NULL )
+        return OGRERR_NONE;
+
+    const size_t nBytes = poGeom->WkbSize();
+    GByte* pabyDst = AllocGeomFieldWkb(iGeomField, nBytes);
+    if( pabyDst == NULL )
+        return OGRERR_NOT_ENOUGH_MEMORY;
+#ifdef CPL_LSB
+    const OGRwkbByteOrder eByteOrder = wkbNDR;
+#else
+    const OGRwkbByteOrder eByteOrder = wkbXDR;
+#endif
+    OGRErr eErr = poGeom->exportToWkb(eByteOrder, pabyDst, wkbVariantIso);
+    if( eErr != OGRERR_NONE )
+    {
+        OGRFeatureBatchColumn* psCol = &pasGeomFields[iGeomField];
+        const int iRow = nFeatureCount - 1;
+        psCol->nDataSize = psCol->panOffsets[iRow];
+        psCol->panOffsets[iRow + 1] = psCol->nDataSize;
+        SetValidity(psCol, iRow, FALSE);
+    }
+    return eErr;
+}
+
+/************************************************************************/
+/*                          GetFieldValidity()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the validity bitmap of a field.
+ *
+ * @param iField field index.
+ * @return bitmap of (GetCapacity() + 7) / 8 bytes, or NULL.
+ * @since GDAL 2.1
+ */
+
+const GByte *OGRFeatureBatch::GetFieldValidity( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns )
+        return NULL;
+    return pasFields[iField].pabyValidity;
+}
+
+/************************************************************************/
+/*                             IsFieldSet()                             */
+/************************************************************************/
+
+int OGRFeatureBatch::IsFieldSet( int iFeature, int iField ) const
+{
+    if( iField < 0 || iField >= nColumns ||
+        iFeature < 0 || iFeature >= nFeatureCount )
+        return FALSE;
+    return (pasFields[iField].pabyValidity[iFeature / 8] >>
+                                                (iFeature % 8)) & 1;
+}
+
+/************************************************************************/
+/*                       GetFieldAsIntegerArray()                       */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTInteger field.
+ *
+ * Values of unset fields are 0.
+ *
+ * @param iField field index.
+ * @return an array of GetFeatureCount() values, or NULL if the field is not
+ * of type OFTInteger.
+ * @since GDAL 2.1
+ */
+
+const int *OGRFeatureBatch::GetFieldAsIntegerArray( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns ||
+        pasFields[iField].eType != OFTInteger )
+        return NULL;
+    return (const int*) pasFields[iField].pabyValues;
+}
+
+/************************************************************************/
+/*                      GetFieldAsInteger64Array()                      */
+/************************************************************************/
+
+const GIntBig *OGRFeatureBatch::GetFieldAsInteger64Array( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns ||
+        pasFields[iField].eType != OFTInteger64 )
+        return NULL;
+    return (const GIntBig*) pasFields[iField].pabyValues;
+}
+
+/************************************************************************/
+/*                        GetFieldAsDoubleArray()                       */
+/************************************************************************/
+
+const double *OGRFeatureBatch::GetFieldAsDoubleArray( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns ||
+        pasFields[iField].eType != OFTReal )
+        return NULL;
+    return (const double*) pasFields[iField].pabyValues;
+}
+
+/************************************************************************/
+/*                       GetFieldAsDateTimeArray()                      */
+/************************************************************************/
+
+/**
+ * \brief Return the values of an OFTDate, OFTTime or OFTDateTime field.
+ *
+ * Only the Date member of the returned OGRField structures is meaningful.
+ *
+ * @param iField field index.
+ * @return an array of GetFeatureCount() values, or NULL.
+ * @since GDAL 2.1
+ */
+
+const OGRField *OGRFeatureBatch::GetFieldAsDateTimeArray( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns ||
+        (pasFields[iField].eType != OFTDate &&
+         pasFields[iField].eType != OFTTime &&
+         pasFields[iField].eType != OFTDateTime) )
+        return NULL;
+    return (const OGRField*) pasFields[iField].pabyValues;
+}
+
+/************************************************************************/
+/*                            GetFieldData()                            */
+/************************************************************************/
+
+/**
+ * \brief Return the data buffer of a variable size field.
+ *
+ * The value of the i-th feature is stored between GetFieldOffsets()[i]
+ * and GetFieldOffsets()[i+1]. OFTString values include their nul
+ * terminating character.
+ *
+ * @param iField field index.
+ * @return the data buffer, or NULL for fixed size fields.
+ * @since GDAL 2.1
+ */
+
+const GByte *OGRFeatureBatch::GetFieldData( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns )
+        return NULL;
+    return pasFields[iField].pabyData;
+}
+
+/************************************************************************/
+/*                          GetFieldOffsets()                           */
+/************************************************************************/
+
+const size_t *OGRFeatureBatch::GetFieldOffsets( int iField ) const
+{
+    if( iField < 0 || iField >= nColumns )
+        return NULL;
+    return pasFields[iField].panOffsets;
+}
+
+/************************************************************************/
+/*                          GetFieldAsString()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the value of an OFTString field.
+ *
+ * @param iFeature feature index in the batch.
+ * @param iField field index.
+ * @return the string ("" if unset), or NULL if the field is not of type
+ * OFTString.
+ * @since GDAL 2.1
+ */
+
+const char *OGRFeatureBatch::GetFieldAsString( int iFeature, int iField ) const
+{
+    if( iField < 0 || iField >= nColumns ||
+        iFeature < 0 || iFeature >= nFeatureCount ||
+        pasFields[iField].eType != OFTString )
+        return NULL;
+    if( !IsFieldSet(iFeature, iField) )
+        return "";
+    const OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    return (const char*)psCol->pabyData + psCol->panOffsets[iFeature];
+}
+
+/************************************************************************/
+/*                          GetFieldAsBinary()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the value of a variable size field.
+ *
+ * @param iFeature feature index in the batch.
+ * @param iField field index.
+ * @param pnBytes location where to store the value size (not including the
+ * nul terminating character of strings).
+ * @return a pointer to the value, or NULL if unset or if the field is of
+ * fixed size.
+ * @since GDAL 2.1
+ */
+
+const GByte *OGRFeatureBatch::GetFieldAsBinary( int iFeature, int iField,
+                                                int *pnBytes ) const
+{
+    if( pnBytes )
+        *pnBytes = 0;
+    if( iField < 0 || iField >= nColumns ||
+        iFeature < 0 || iFeature >= nFeatureCount ||
+        pasFields[iField].nEltSize != 0 ||
+        !IsFieldSet(iFeature, iField) )
+        return NULL;
+    const OGRFeatureBatchColumn* psCol = &pasFields[iField];
+    size_t nBytes = psCol->panOffsets[iFeature + 1] -
+                    psCol->panOffsets[iFeature];
+    if( psCol->eType == OFTString )
+        nBytes --;
+    if( pnBytes )
+        *pnBytes = (int)nBytes;
+    return psCol->pabyData + psCol->panOffsets[iFeature];
+}
+
+/************************************************************************/
+/*                        GetGeomFieldValidity()                        */
+/************************************************************************/
+
+const GByte *OGRFeatureBatch::GetGeomFieldValidity( int iGeomField ) const
+{
+    if( iGeomField < 0 || iGeomField >= nGeomColumns )
+        return NULL;
+    return pasGeomFields[iGeomField].pabyValidity;
+}
+
+/************************************************************************/
+/*                           IsGeomFieldSet()                           */
+/************************************************************************/
+
+int OGRFeatureBatch::IsGeomFieldSet( int iFeature, int iGeomField ) const
+{
+    if( iGeomField < 0 || iGeomField >= nGeomColumns ||
+        iFeature < 0 || iFeature >= nFeatureCount )
+        return FALSE;
+    return (pasGeomFields[iGeomField].pabyValidity[iFeature / 8] >>
+                                                (iFeature % 8)) & 1;
+}
+
+/************************************************************************/
+/*                          GetGeomFieldData()                          */
+/************************************************************************/
+
+const GByte *OGRFeatureBatch::GetGeomFieldData( int iGeomField ) const
+{
+    if( iGeomField < 0 || iGeomField >= nGeomColumns )
+        return NULL;
+    return pasGeomFields[iGeomField].pabyData;
+}
+
+/************************************************************************/
+/*                         GetGeomFieldOffsets()                        */
+/************************************************************************/
+
+const size_t *OGRFeatureBatch::GetGeomFieldOffsets( int iGeomField ) const
+{
+    if( iGeomField < 0 || iGeomField >= nGeomColumns )
+        return NULL;
+    return pasGeomFields[iGeomField].panOffsets;
+}
+
+/************************************************************************/
+/*                         GetGeomFieldAsWkb()                          */
+/************************************************************************/
+
+/**
+ * \brief Return the geometry of a feature as WKB.
+ *
+ * The WKB is in the native byte order, and uses the ISO flavour for 3D
+ * geometries.
+ *
+ * @param iFeature feature index in the batch.
+ * @param iGeomField geometry field index.
+ * @param pnBytes location where to store the WKB size.
+ * @return a pointer to the WKB, or NULL if there is no geometry.
+ * @since GDAL 2.1
+ */
+
+const GByte *OGRFeatureBatch::GetGeomFieldAsWkb( int iFeature, int iGeomField,
+                                                 size_t *pnBytes ) const
+{
+    if( pnBytes )
+        *pnBytes = 0;
+    if( !IsGeomFieldSet(iFeature, iGeomField) )
+        return NULL;
+    const OGRFeatureBatchColumn* psCol = &pasGeomFields[iGeomField];
+    if( pnBytes )
+        *pnBytes = psCol->panOffsets[iFeature + 1] -
+                   psCol->panOffsets[iFeature];
+    return psCol->pabyData + psCol->panOffsets[iFeature];
+}
+
+/************************************************************************/
+/*                           OGR_FB_Create()                            */
+/************************************************************************/
+
+/**
+ * \brief Create a feature batch.
+ *
+ * This function is the same as the C++ method
+ * OGRFeatureBatch::OGRFeatureBatch().
+ *
+ * @param hDefn layer definition of the layers the batch will be used with.
+ * @param nCapacity maximum number of features held by the batch.
+ * @return a handle to the new batch, to destroy with OGR_FB_Destroy().
+ * @since GDAL 2.1
+ */
+
+OGRFeatureBatchH OGR_FB_Create( OGRFeatureDefnH hDefn, int nCapacity )
+{
+    VALIDATE_POINTER1( hDefn, "OGR_FB_Create", NULL );
+
+    return (OGRFeatureBatchH)
+        new OGRFeatureBatch( (OGRFeatureDefn*)hDefn, nCapacity );
+}
+
+/************************************************************************/
+/*                           OGR_FB_Destroy()                           */
+/************************************************************************/
+
+void OGR_FB_Destroy( OGRFeatureBatchH hBatch )
+{
+    delete (OGRFeatureBatch*)hBatch;
+}
+
+/************************************************************************/
+/*                       OGR_FB_GetFeatureCount()                       */
+/************************************************************************/
+
+int OGR_FB_GetFeatureCount( OGRFeatureBatchH hBatch )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFeatureCount", 0 );
+
+    return ((OGRFeatureBatch*)hBatch)->GetFeatureCount();
+}
+
+/************************************************************************/
+/*                            OGR_FB_GetFID()                           */
+/************************************************************************/
+
+GIntBig OGR_FB_GetFID( OGRFeatureBatchH hBatch, int iFeature )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFID", OGRNullFID );
+
+    OGRFeatureBatch* poBatch = (OGRFeatureBatch*)hBatch;
+    if( iFeature < 0 || iFeature >= poBatch->GetFeatureCount() )
+        return OGRNullFID;
+    return poBatch->GetFID(iFeature);
+}
+
+/************************************************************************/
+/*                         OGR_FB_IsFieldSet()                          */
+/************************************************************************/
+
+int OGR_FB_IsFieldSet( OGRFeatureBatchH hBatch, int iFeature, int iField )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_IsFieldSet", FALSE );
+
+    return ((OGRFeatureBatch*)hBatch)->IsFieldSet(iFeature, iField);
+}
+
+/************************************************************************/
+/*                    OGR_FB_GetFieldAsIntegerArray()                   */
+/************************************************************************/
+
+const int *OGR_FB_GetFieldAsIntegerArray( OGRFeatureBatchH hBatch,
+                                          int iField )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFieldAsIntegerArray", NULL );
+
+    return ((OGRFeatureBatch*)hBatch)->GetFieldAsIntegerArray(iField);
+}
+
+/************************************************************************/
+/*                   OGR_FB_GetFieldAsInteger64Array()                  */
+/************************************************************************/
+
+const GIntBig *OGR_FB_GetFieldAsInteger64Array( OGRFeatureBatchH hBatch,
+                                                int iField )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFieldAsInteger64Array", NULL );
+
+    return ((OGRFeatureBatch*)hBatch)->GetFieldAsInteger64Array(iField);
+}
+
+/************************************************************************/
+/*                     OGR_FB_GetFieldAsDoubleArray()                   */
+/************************************************************************/
+
+const double *OGR_FB_GetFieldAsDoubleArray( OGRFeatureBatchH hBatch,
+                                            int iField )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFieldAsDoubleArray", NULL );
+
+    return ((OGRFeatureBatch*)hBatch)->GetFieldAsDoubleArray(iField);
+}
+
+/************************************************************************/
+/*                       OGR_FB_GetFieldAsString()                      */
+/************************************************************************/
+
+const char *OGR_FB_GetFieldAsString( OGRFeatureBatchH hBatch,
+                                     int iFeature, int iField )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFieldAsString", NULL );
+
+    return ((OGRFeatureBatch*)hBatch)->GetFieldAsString(iFeature, iField);
+}
+
+/************************************************************************/
+/*                       OGR_FB_GetFieldAsBinary()                      */
+/************************************************************************/
+
+const GByte *OGR_FB_GetFieldAsBinary( OGRFeatureBatchH hBatch,
+                                      int iFeature, int iField, int *pnBytes )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetFieldAsBinary", NULL );
+
+    return ((OGRFeatureBatch*)hBatch)->GetFieldAsBinary(iFeature, iField,
+                                                        pnBytes);
+}
+
+/************************************************************************/
+/*                      OGR_FB_GetGeomFieldAsWkb()                      */
+/************************************************************************/
+
+const GByte *OGR_FB_GetGeomFieldAsWkb( OGRFeatureBatchH hBatch,
+                                       int iFeature, int iGeomField,
+                                       size_t *pnBytes )
+{
+    VALIDATE_POINTER1( hBatch, "OGR_FB_GetGeomFieldAsWkb", NULL );
+
+    return ((OGRFeatureBatch*)hBatch)->GetGeomFieldAsWkb(iFeature, iGeomField,
+                                                         pnBytes);
+}
@@ -73,6 +73,7 @@ OGRGeometry::OGRGeometry()
 
 {
     poSRS = NULL;
+    bReadOnly = FALSE;
     nCoordDimension = 2;
 }
 
@@ -91,6 +92,7 @@ OGRGeometry::OGRGeometry()
 
 OGRGeometry::OGRGeometry( const OGRGeometry& other ) :
     poSRS(other.poSRS),
+    bReadOnly(FALSE),
     nCoordDimension(other.nCoordDimension)
 {
     if( poSRS != NULL )
@@ -104,6 +106,9 @@ OGRGeometry::OGRGeometry( const OGRGeometry& other ) :
 OGRGeometry::~OGRGeometry()
 
 {
+    /* Geometries of an OGRGeometryArena are released by the arena */
+    CPLAssert( !bReadOnly );
+
     if( poSRS != NULL )
         poSRS->Release();
 }
@@ -131,6 +136,41 @@ OGRGeometry& OGRGeometry::operator=( const OGRGeometry& other )
     return *this;
 }
 
+/************************************************************************/
+/*                             IsReadOnly()                             */
+/************************************************************************/
+
+/**
+ * \fn int OGRGeometry::IsReadOnly() const;
+ *
+ * \brief Returns whether the geometry is read-only.
+ *
+ * This is the case of the geometries created in an OGRGeometryArena : their
+ * memory belongs to the arena, so they must not be deleted, and the methods
+ * that would add or remove points or parts fail with an error.
+ *
+ * @return TRUE if the geometry belongs to an OGRGeometryArena.
+ *
+ * @since GDAL 2.1
+ */
+
+/************************************************************************/
+/*                           CheckWritable()                            */
+/************************************************************************/
+
+int OGRGeometry::CheckWritable() const
+
+{
+    if( !bReadOnly )
+        return TRUE;
+
+    CPLAssert( FALSE );
+    CPLError( CE_Failure, CPLE_NotSupported,
+              "Geometry of an OGRGeometryArena cannot be modified. "
+              "Use clone() to get a modifiable copy." );
+    return FALSE;
+}
+
 /************************************************************************/
 /*                            dumpReadable()                            */
 /************************************************************************/
@@ -335,12 +375,14 @@ void OGR_G_DumpReadable( OGRGeometryH hGeom, FILE *fp, const char *pszPrefix )
 void OGRGeometry::assignSpatialReference( OGRSpatialReference * poSR )
 
 {
+    /* Reference first, in case poSR is already the assigned SRS */
+    if( poSR != NULL )
+        poSR->Reference();
+
     if( poSRS != NULL )
         poSRS->Release();
 
     poSRS = poSR;
-    if( poSRS != NULL )
-        poSRS->Reference();
 }
 
 /************************************************************************/
@@ -812,6 +854,9 @@ int OGR_G_GetCoordinateDimension( OGRGeometryH hGeom )
 void OGRGeometry::setCoordinateDimension( int nNewDimension )
 
 {
+    if( !CheckWritable() )
+        return;
+
     nCoordDimension = nNewDimension;
 }
 
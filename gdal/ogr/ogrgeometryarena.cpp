@@ -0,0 +1,552 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRGeometryArena class implementation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_geometry.h"
+#include "ogr_p.h"
+#include <new>
+
+CPL_CVSID("$Id$");
+
+/* Alignment of all the allocations done in the arena */
+#define ARENA_ALIGN         16
+#define ARENA_ROUND(n)      (((n) + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1))
+
+/* Allocations larger than this fraction of the block size get their own block */
+#define LARGE_ALLOC_RATIO   4
+
+struct OGRGeometryArena::Block
+{
+    Block      *psNext;
+    size_t      nSize;
+};
+
+/* Root geometries to which a SRS has been assigned, so that the */
+/* reference can be released when the arena is reset. */
+struct OGRGeometryArena::SRSRef
+{
+    OGRGeometry *poGeom;
+    SRSRef      *psNext;
+};
+
+#define BLOCK_HEADER_SIZE   ARENA_ROUND(sizeof(OGRGeometryArena::Block))
+
+/************************************************************************/
+/*                          OGRGeometryArena()                          */
+/************************************************************************/
+
+/**
+ * \brief Constructor.
+ *
+ * No memory is allocated until the first geometry is created.
+ *
+ * @param nBlockSizeIn size in bytes of the blocks from which allocations
+ * are served. Objects larger than a quarter of that size are allocated in
+ * a block of their own.
+ *
+ * @since GDAL 2.1
+ */
+
+OGRGeometryArena::OGRGeometryArena( size_t nBlockSizeIn ) :
+    nBlockSize(nBlockSizeIn < 1024 ? 1024 : ARENA_ROUND(nBlockSizeIn)),
+    psCurBlock(NULL),
+    psLargeBlocks(NULL),
+    nCurOffset(0),
+    nUsedSize(0),
+    psSRSRefs(NULL)
+{
+}
+
+/************************************************************************/
+/*                         ~OGRGeometryArena()                          */
+/************************************************************************/
+
+/**
+ * \brief Destructor.
+ *
+ * Releases all the memory of the arena. Geometries created in the arena
+ * become invalid.
+ */
+
+OGRGeometryArena::~OGRGeometryArena()
+
+{
+    Reset();
+    CPLFree( psCurBlock );
+}
+
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+/**
+ * \brief Release all the geometries created in the arena.
+ *
+ * The destructors of the geometries are not run. The current memory block
+ * is kept for the next allocations, so that an arena used to decode
+ * geometries one at a time ends up doing no allocation at all.
+ *
+ * @since GDAL 2.1
+ */
+
+void OGRGeometryArena::Reset()
+
+{
+    for( SRSRef *psRef = psSRSRefs; psRef != NULL; psRef = psRef->psNext )
+        psRef->poGeom->assignSpatialReference( NULL );
+    psSRSRefs = NULL;
+
+    while( psLargeBlocks != NULL )
+    {
+        Block *psNext = psLargeBlocks->psNext;
+        CPLFree( psLargeBlocks );
+        psLargeBlocks = psNext;
+    }
+
+    if( psCurBlock != NULL )
+    {
+        while( psCurBlock->psNext != NULL )
+        {
+            Block *psNext = psCurBlock->psNext;
+            psCurBlock->psNext = psNext->psNext;
+            CPLFree( psNext );
+        }
+    }
+
+    nCurOffset = 0;
+    nUsedSize = 0;
+}
+
+/************************************************************************/
+/*                           AllocateBlock()                            */
+/************************************************************************/
+
+void *OGRGeometryArena::AllocateBlock( size_t nSize, int bLarge )
+
+{
+    Block *psBlock = (Block *)
+        VSI_MALLOC_VERBOSE( BLOCK_HEADER_SIZE + nSize );
+    if( psBlock == NULL )
+        return NULL;
+    psBlock->nSize = nSize;
+
+    if( bLarge )
+    {
+        psBlock->psNext = psLargeBlocks;
+        psLargeBlocks = psBlock;
+    }
+    else
+    {
+        psBlock->psNext = psCurBlock;
+        psCurBlock = psBlock;
+        nCurOffset = 0;
+    }
+
+    return ((GByte *) psBlock) + BLOCK_HEADER_SIZE;
+}
+
+/************************************************************************/
+/*                              Allocate()                              */
+/************************************************************************/
+
+/**
+ * \brief Allocate memory from the arena.
+ *
+ * The returned memory is suitably aligned for any geometry object or
+ * coordinate array. It is released by Reset() or by the destructor of the
+ * arena, and must not be passed to CPLFree().
+ *
+ * @param nSize number of bytes to allocate.
+ *
+ * @return a pointer to the memory, or NULL in case of allocation failure.
+ *
+ * @since GDAL 2.1
+ */
+
+void *OGRGeometryArena::Allocate( size_t nSize )
+
+{
+    if( nSize > (~(size_t)0) - ARENA_ALIGN )
+        return NULL;
+    nSize = ARENA_ROUND( nSize == 0 ? 1 : nSize );
+
+    void *pRet;
+    if( nSize > nBlockSize / LARGE_ALLOC_RATIO )
+    {
+        if( nSize > (~(size_t)0) - BLOCK_HEADER_SIZE )
+            return NULL;
+        pRet = AllocateBlock( nSize, TRUE );
+    }
+    else
+    {
+        if( psCurBlock == NULL || nCurOffset + nSize > psCurBlock->nSize )
+        {
+            if( AllocateBlock( nBlockSize, FALSE ) == NULL )
+                return NULL;
+        }
+        pRet = ((GByte *) psCurBlock) + BLOCK_HEADER_SIZE + nCurOffset;
+        nCurOffset += nSize;
+    }
+
+    if( pRet != NULL )
+        nUsedSize += nSize;
+    return pRet;
+}
+
+/************************************************************************/
+/*                                New()                                 */
+/************************************************************************/
+
+template<class T> T *OGRGeometryArena::New()
+{
+    void *pMem = Allocate( sizeof(T) );
+    if( pMem == NULL )
+        return NULL;
+    T *poGeom = new (pMem) T();
+    poGeom->bReadOnly = TRUE;
+    return poGeom;
+}
+
+/************************************************************************/
+/*                             ReadPoints()                             */
+/*                                                                      */
+/*      Read a point count followed by the points, as found in a        */
+/*      linestring or in a polygon ring.                                */
+/************************************************************************/
+
+OGRErr OGRGeometryArena::ReadPoints( OGRSimpleCurve *poCurve,
+                                     unsigned char *pabyData, int nSize,
+                                     int b3D, int bSwap, int *pnConsumed )
+
+{
+    if( nSize < 4 && nSize != -1 )
+        return OGRERR_NOT_ENOUGH_DATA;
+
+    GInt32 nCount;
+    memcpy( &nCount, pabyData, 4 );
+    if( bSwap )
+        CPL_SWAP32PTR( &nCount );
+
+    const int nPointSize = b3D ? 24 : 16;
+    if( nCount < 0 || nCount > (INT_MAX - 4) / nPointSize )
+        return OGRERR_CORRUPT_DATA;
+    if( nSize != -1 && nCount > (nSize - 4) / nPointSize )
+        return OGRERR_NOT_ENOUGH_DATA;
+
+    poCurve->nCoordDimension = b3D ? 3 : 2;
+    poCurve->nPointCount = 0;
+    poCurve->paoPoints = NULL;
+    poCurve->padfZ = NULL;
+
+    if( nCount > 0 )
+    {
+        OGRRawPoint *paoPoints = (OGRRawPoint *)
+            Allocate( sizeof(OGRRawPoint) * nCount );
+        double *padfZ = b3D ? (double *) Allocate( sizeof(double) * nCount )
+                            : NULL;
+        if( paoPoints == NULL || (b3D && padfZ == NULL) )
+            return OGRERR_NOT_ENOUGH_MEMORY;
+
+        const unsigned char *pabyPoint = pabyData + 4;
+        if( !b3D && !bSwap )
+        {
+            memcpy( paoPoints, pabyPoint, 16 * (size_t)nCount );
+        }
+        else
+        {
+            for( int i = 0; i < nCount; i++, pabyPoint += nPointSize )
+            {
+                memcpy( &paoPoints[i].x, pabyPoint, 8 );
+                memcpy( &paoPoints[i].y, pabyPoint + 8, 8 );
+                if( b3D )
+                    memcpy( padfZ + i, pabyPoint + 16, 8 );
+                if( bSwap )
+                {
+                    CPL_SWAPDOUBLE( &paoPoints[i].x );
+                    CPL_SWAPDOUBLE( &paoPoints[i].y );
+                    if( b3D )
+                        CPL_SWAPDOUBLE( padfZ + i );
+                }
+            }
+        }
+
+        poCurve->paoPoints = paoPoints;
+        poCurve->padfZ = padfZ;
+        poCurve->nPointCount = nCount;
+    }
+
+    *pnConsumed = 4 + nCount * nPointSize;
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                            ReadGeometry()                            */
+/************************************************************************/
+
+OGRErr OGRGeometryArena::ReadGeometry( unsigned char *pabyData, int nSize,
+                                       OGRwkbVariant eWkbVariant,
+                                       int nRecLevel,
+                                       OGRGeometry **ppoReturn,
+                                       int *pnConsumed )
+
+{
+    /* Arbitrary value, but certainly large enough for reasonable use cases. */
+    if( nRecLevel == 32 )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Too many recursion levels (%d) while parsing WKB geometry.",
+                  nRecLevel );
+        return OGRERR_CORRUPT_DATA;
+    }
+
+    if( nSize < 9 && nSize != -1 )
+        return OGRERR_NOT_ENOUGH_DATA;
+
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(*pabyData);
+    if( nByteOrder != wkbXDR && nByteOrder != wkbNDR )
+        return OGRERR_CORRUPT_DATA;
+    const int bSwap = OGR_SWAP( (OGRwkbByteOrder) nByteOrder );
+
+    OGRwkbGeometryType eGeometryType;
+    OGRBoolean bIs3D;
+    OGRErr eErr = OGRReadWKBGeometryType( pabyData, eWkbVariant,
+                                          &eGeometryType, &bIs3D );
+    if( eErr != OGRERR_NONE )
+        return eErr;
+
+    const int nRemaining = (nSize == -1) ? -1 : nSize - 5;
+
+/* -------------------------------------------------------------------- */
+/*      Point : no memory beyond the object itself.                     */
+/* -------------------------------------------------------------------- */
+    if( eGeometryType == wkbPoint )
+    {
+        OGRPoint *poPoint = New<OGRPoint>();
+        if( poPoint == NULL )
+            return OGRERR_NOT_ENOUGH_MEMORY;
+        eErr = poPoint->importFromWkb( pabyData, nSize, eWkbVariant );
+        if( eErr != OGRERR_NONE )
+            return eErr;
+        *ppoReturn = poPoint;
+        *pnConsumed = bIs3D ? 29 : 21;
+        return OGRERR_NONE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      LineString.                                                     */
+/* -------------------------------------------------------------------- */
+    if( eGeometryType == wkbLineString )
+    {
+        OGRLineString *poLS = New<OGRLineString>();
+        if( poLS == NULL )
+            return OGRERR_NOT_ENOUGH_MEMORY;
+        int nConsumed = 0;
+        eErr = ReadPoints( poLS, pabyData + 5, nRemaining, bIs3D, bSwap,
+                           &nConsumed );
+        if( eErr != OGRERR_NONE )
+            return eErr;
+        *ppoReturn = poLS;
+        *pnConsumed = 5 + nConsumed;
+        return OGRERR_NONE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Everything else starts with a count of parts.                   */
+/* -------------------------------------------------------------------- */
+    if( eGeometryType != wkbPolygon &&
+        eGeometryType != wkbMultiPoint &&
+        eGeometryType != wkbMultiLineString &&
+        eGeometryType != wkbMultiPolygon &&
+        eGeometryType != wkbGeometryCollection )
+    {
+        return OGRERR_UNSUPPORTED_GEOMETRY_TYPE;
+    }
+
+    if( nSize < 9 && nSize != -1 )
+        return OGRERR_NOT_ENOUGH_DATA;
+    GInt32 nParts;
+    memcpy( &nParts, pabyData + 5, 4 );
+    if( bSwap )
+        CPL_SWAP32PTR( &nParts );
+
+    /* Each ring has at least 4 bytes, each sub-geometry at least 9 */
+    const int nMinPartSize = (eGeometryType == wkbPolygon) ? 4 : 9;
+    if( nParts < 0 || nParts > INT_MAX / nMinPartSize )
+        return OGRERR_CORRUPT_DATA;
+    if( nSize != -1 && nSize - 9 < nParts * nMinPartSize )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Length of input WKB is too small" );
+        return OGRERR_NOT_ENOUGH_DATA;
+    }
+
+    int nOffset = 9;
+
+    if( eGeometryType == wkbPolygon )
+    {
+        OGRPolygon *poPoly = New<OGRPolygon>();
+        OGRCurve **papoRings = (OGRCurve **)
+            Allocate( sizeof(OGRCurve *) * (nParts > 0 ? nParts : 1) );
+        if( poPoly == NULL || papoRings == NULL )
+            return OGRERR_NOT_ENOUGH_MEMORY;
+
+        for( int iRing = 0; iRing < nParts; iRing++ )
+        {
+            OGRLinearRing *poLR = New<OGRLinearRing>();
+            if( poLR == NULL )
+                return OGRERR_NOT_ENOUGH_MEMORY;
+            int nConsumed = 0;
+            eErr = ReadPoints( poLR, pabyData + nOffset,
+                               nSize == -1 ? -1 : nSize - nOffset,
+                               bIs3D, bSwap, &nConsumed );
+            if( eErr != OGRERR_NONE )
+                return eErr;
+            papoRings[iRing] = poLR;
+            nOffset += nConsumed;
+        }
+
+        OGRCurvePolygon *poCP = poPoly;
+        poCP->nCoordDimension = bIs3D ? 3 : 2;
+        poCP->oCC.papoCurves = papoRings;
+        poCP->oCC.nCurveCount = nParts;
+
+        *ppoReturn = poPoly;
+        *pnConsumed = nOffset;
+        return OGRERR_NONE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Collections.                                                    */
+/* -------------------------------------------------------------------- */
+    OGRGeometryCollection *poGC;
+    if( eGeometryType == wkbMultiPoint )
+        poGC = New<OGRMultiPoint>();
+    else if( eGeometryType == wkbMultiLineString )
+        poGC = New<OGRMultiLineString>();
+    else if( eGeometryType == wkbMultiPolygon )
+        poGC = New<OGRMultiPolygon>();
+    else
+        poGC = New<OGRGeometryCollection>();
+    OGRGeometry **papoGeoms = (OGRGeometry **)
+        Allocate( sizeof(OGRGeometry *) * (nParts > 0 ? nParts : 1) );
+    if( poGC == NULL || papoGeoms == NULL )
+        return OGRERR_NOT_ENOUGH_MEMORY;
+
+    poGC->nCoordDimension = bIs3D ? 3 : 2;
+
+    for( int iGeom = 0; iGeom < nParts; iGeom++ )
+    {
+        unsigned char *pabySubData = pabyData + nOffset;
+        const int nSubSize = (nSize == -1) ? -1 : nSize - nOffset;
+        if( nSubSize < 9 && nSubSize != -1 )
+            return OGRERR_NOT_ENOUGH_DATA;
+
+        OGRwkbGeometryType eSubGeomType;
+        eErr = OGRReadWKBGeometryType( pabySubData, eWkbVariant,
+                                       &eSubGeomType, &bIs3D );
+        if( eErr != OGRERR_NONE )
+            return eErr;
+        if( !poGC->isCompatibleSubType( eSubGeomType ) )
+        {
+            CPLDebug( "OGR",
+                      "Cannot add geometry of type (%d) to geometry of type (%d)",
+                      eSubGeomType, poGC->getGeometryType() );
+            return OGRERR_CORRUPT_DATA;
+        }
+
+        OGRGeometry *poSubGeom = NULL;
+        int nConsumed = 0;
+        eErr = ReadGeometry( pabySubData, nSubSize, eWkbVariant,
+                             nRecLevel + 1, &poSubGeom, &nConsumed );
+        if( eErr != OGRERR_NONE )
+            return eErr;
+
+        papoGeoms[iGeom] = poSubGeom;
+        if( poSubGeom->getCoordinateDimension() == 3 )
+            poGC->nCoordDimension = 3;
+        nOffset += nConsumed;
+    }
+
+    poGC->papoGeoms = papoGeoms;
+    poGC->nGeomCount = nParts;
+
+    *ppoReturn = poGC;
+    *pnConsumed = nOffset;
+    return OGRERR_NONE;
+}
+
+/************************************************************************/
+/*                           CreateFromWkb()                            */
+/************************************************************************/
+
+/**
+ * \brief Create a geometry in the arena from its well known binary
+ * representation.
+ *
+ * This is the same as OGRGeometryFactory::createFromWkb() with an arena,
+ * see its documentation for the meaning of the arguments. The returned
+ * geometry is read-only (see OGRGeometry::IsReadOnly()) and must not be
+ * deleted.
+ *
+ * @return OGRERR_NONE if all goes well, OGRERR_UNSUPPORTED_GEOMETRY_TYPE for
+ * non-linear geometry types, or any of OGRERR_NOT_ENOUGH_DATA,
+ * OGRERR_NOT_ENOUGH_MEMORY or OGRERR_CORRUPT_DATA.
+ *
+ * @since GDAL 2.1
+ */
+
+OGRErr OGRGeometryArena::CreateFromWkb( unsigned char *pabyData,
+                                        OGRSpatialReference *poSR,
+                                        OGRGeometry **ppoReturn,
+                                        int nBytes,
+                                        OGRwkbVariant eWkbVariant )
+
+{
+    *ppoReturn = NULL;
+
+    OGRGeometry *poGeom = NULL;
+    int nConsumed = 0;
+    OGRErr eErr = ReadGeometry( pabyData, nBytes, eWkbVariant, 0,
+                                &poGeom, &nConsumed );
+    if( eErr != OGRERR_NONE )
+        return eErr;
+
+    if( poSR != NULL )
+    {
+        SRSRef *psRef = (SRSRef *) Allocate( sizeof(SRSRef) );
+        if( psRef == NULL )
+            return OGRERR_NOT_ENOUGH_MEMORY;
+        psRef->poGeom = poGeom;
+        psRef->psNext = psSRSRefs;
+        psSRSRefs = psRef;
+        poGeom->assignSpatialReference( poSR );
+    }
+
+    *ppoReturn = poGeom;
+    return OGRERR_NONE;
+}
@@ -80,6 +80,7 @@ OGRGeometryCollection::OGRGeometryCollection( const OGRGeometryCollection& other
 OGRGeometryCollection::~OGRGeometryCollection()
 
 {
+    CPLAssert( !IsReadOnly() );
     empty();
 }
 
@@ -119,6 +120,9 @@ OGRGeometryCollection& OGRGeometryCollection::operator=( const OGRGeometryCollec
 void OGRGeometryCollection::empty()
 
 {
+    if( !CheckWritable() )
+        return;
+
     if( papoGeoms != NULL )
     {
         for( int i = 0; i < nGeomCount; i++ )
@@ -344,6 +348,9 @@ OGRErr OGRGeometryCollection::addGeometry( const OGRGeometry * poNewGeom )
 OGRErr OGRGeometryCollection::addGeometryDirectly( OGRGeometry * poNewGeom )
 
 {
+    if( !CheckWritable() )
+        return OGRERR_FAILURE;
+
     if( !isCompatibleSubType(poNewGeom->getGeometryType()) )
         return OGRERR_UNSUPPORTED_GEOMETRY_TYPE;
 
@@ -396,6 +403,9 @@ OGRErr OGRGeometryCollection::removeGeometry( int iGeom, int bDelete )
     if( iGeom < -1 || iGeom >= nGeomCount )
         return OGRERR_FAILURE;
 
+    if( !CheckWritable() )
+        return OGRERR_FAILURE;
+
     // Special case.
     if( iGeom == -1 )
     {
@@ -167,6 +167,53 @@ OGRErr OGRGeometryFactory::createFromWkb(unsigned char *pabyData,
     return eErr;
 }
 
+/**
+ * \brief Create a geometry object in an arena from its well known binary
+ * representation.
+ *
+ * The objects and coordinate arrays of the geometry are allocated in the
+ * passed arena instead of the heap, so that a complex multipolygon costs at
+ * most a couple of allocations and is released in one go by
+ * OGRGeometryArena::Reset(). The returned geometry is read-only and must not
+ * be deleted : see OGRGeometryArena for the restrictions. Only linear
+ * geometry types are supported : OGRERR_UNSUPPORTED_GEOMETRY_TYPE is returned
+ * for curve geometries, in which case the caller may use the regular
+ * createFromWkb().
+ *
+ * If poArena is NULL, this is the same as the regular createFromWkb().
+ *
+ * @param pabyData pointer to the input BLOB data.
+ * @param poSR pointer to the spatial reference to be assigned to the
+ *             created geometry object.  This may be NULL.
+ * @param ppoReturn the newly created geometry object will be assigned to the
+ *                  indicated pointer on return.  This will be NULL in case
+ *                  of failure.
+ * @param nBytes the number of bytes available in pabyData, or -1 if it isn't
+ *               known.
+ * @param eWkbVariant WKB variant.
+ * @param poArena the arena in which to allocate the geometry, or NULL.
+ *
+ * @return OGRERR_NONE if all goes well, otherwise any of
+ * OGRERR_NOT_ENOUGH_DATA, OGRERR_UNSUPPORTED_GEOMETRY_TYPE,
+ * OGRERR_NOT_ENOUGH_MEMORY or OGRERR_CORRUPT_DATA may be returned.
+ *
+ * @since GDAL 2.1
+ */
+
+OGRErr OGRGeometryFactory::createFromWkb(unsigned char *pabyData,
+                                         OGRSpatialReference * poSR,
+                                         OGRGeometry **ppoReturn,
+                                         int nBytes,
+                                         OGRwkbVariant eWkbVariant,
+                                         OGRGeometryArena *poArena )
+
+{
+    if( poArena == NULL )
+        return createFromWkb( pabyData, poSR, ppoReturn, nBytes, eWkbVariant );
+    return poArena->CreateFromWkb( pabyData, poSR, ppoReturn, nBytes,
+                                   eWkbVariant );
+}
+
 /************************************************************************/
 /*                        OGR_G_CreateFromWkb()                         */
 /************************************************************************/
@@ -72,6 +72,8 @@ OGRSimpleCurve::OGRSimpleCurve( const OGRSimpleCurve& other ) :
 OGRSimpleCurve::~OGRSimpleCurve()
 
 {
+    CPLAssert( !IsReadOnly() );
+
     if( paoPoints != NULL )
         OGRFree( paoPoints );
     if( padfZ != NULL )
@@ -155,6 +157,9 @@ void OGRSimpleCurve::empty()
 void OGRSimpleCurve::setCoordinateDimension( int nNewDimension )
 
 {
+    if( !CheckWritable() )
+        return;
+
     nCoordDimension = nNewDimension;
     if( nNewDimension == 2 )
         Make2D();
@@ -182,6 +187,9 @@ int OGRSimpleCurve::WkbSize() const
 void OGRSimpleCurve::Make2D()
 
 {
+    if( !CheckWritable() )
+        return;
+
     if( padfZ != NULL )
     {
         OGRFree( padfZ );
@@ -197,6 +205,9 @@ void OGRSimpleCurve::Make2D()
 void OGRSimpleCurve::Make3D()
 
 {
+    if( !CheckWritable() )
+        return;
+
     if( padfZ == NULL )
     {
         if( nPointCount == 0 )
@@ -317,6 +328,9 @@ double OGRSimpleCurve::getZ( int iVertex ) const
 void OGRSimpleCurve::setNumPoints( int nNewPointCount, int bZeroizeNewContent )
 
 {
+    if( !CheckWritable() )
+        return;
+
     if( nNewPointCount == 0 )
     {
         OGRFree( paoPoints );
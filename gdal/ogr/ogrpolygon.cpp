@@ -228,7 +228,7 @@ const OGRLinearRing *OGRPolygon::getInteriorRing( int iRing ) const
 
 OGRLinearRing *OGRPolygon::stealInteriorRing(int iRing)
 {
-    if( iRing < 0 || iRing >= oCC.nCurveCount-1 )
+    if( iRing < 0 || iRing >= oCC.nCurveCount-1 || !CheckWritable() )
         return NULL;
     OGRLinearRing *poRet = (OGRLinearRing*) oCC.papoCurves[iRing+1];
     oCC.papoCurves[iRing+1] = NULL;
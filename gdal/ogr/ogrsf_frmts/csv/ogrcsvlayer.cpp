@@ -1389,6 +1389,35 @@ OGRFeature* OGRCSVLayer::GetFeature(GIntBig nFID)
     return GetNextUnfilteredFeature();
 }
 
+/************************************************************************/
+/*                          SetPointGeometry()                          */
+/*                                                                      */
+/*      Assign a point to the feature, overwriting poGeomToReuse in     */
+/*      place when it is a point of the same dimension.                 */
+/************************************************************************/
+
+static void SetPointGeometry( OGRFeature *poFeature,
+                              OGRGeometry *&poGeomToReuse,
+                              double dfX, double dfY, double dfZ, bool bHasZ )
+{
+    if( poGeomToReuse != NULL &&
+        poGeomToReuse->getGeometryType() == (bHasZ ? wkbPoint25D : wkbPoint) )
+    {
+        OGRPoint *poPoint = (OGRPoint *) poGeomToReuse;
+        poGeomToReuse = NULL;
+        poPoint->assignSpatialReference( NULL );
+        poPoint->setX( dfX );
+        poPoint->setY( dfY );
+        if( bHasZ )
+            poPoint->setZ( dfZ );
+        poFeature->SetGeometryDirectly( poPoint );
+    }
+    else if( bHasZ )
+        poFeature->SetGeometryDirectly( new OGRPoint(dfX, dfY, dfZ) );
+    else
+        poFeature->SetGeometryDirectly( new OGRPoint(dfX, dfY) );
+}
+
 /************************************************************************/
 /*                      GetNextUnfilteredFeature()                      */
 /************************************************************************/
@@ -1407,11 +1436,13 @@ OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature()
         return NULL;
 
 /* -------------------------------------------------------------------- */
-/*      Create the OGR feature.                                         */
+/*      Create the OGR feature, or reuse the recycled one.              */
 /* -------------------------------------------------------------------- */
-    OGRFeature *poFeature;
+    OGRGeometry *poGeomToReuse = NULL;
+    OGRFeature *poFeature = GetRecycledFeature( &poGeomToReuse );
 
-    poFeature = new OGRFeature( poFeatureDefn );
+    if( poFeature == NULL )
+        poFeature = new OGRFeature( poFeatureDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Get user specified decimal_point.                               */
@@ -1692,7 +1723,7 @@ OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature()
         if (strchr(papszTokens[iNfdcLatitudeS], 'S'))
             dfLat *= -1;
         if( !(poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored()) )
-            poFeature->SetGeometryDirectly( new OGRPoint(dfLon, dfLat) );
+            SetPointGeometry( poFeature, poGeomToReuse, dfLon, dfLat, 0.0, false );
     }
 
 /* -------------------------------------------------------------------- */
@@ -1716,14 +1747,17 @@ OGRFeature * OGRCSVLayer::GetNextUnfilteredFeature()
             if( !(poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored()) )
             {
                 if( iZField != -1 && nAttrCount > iZField && papszTokens[iZField][0] != 0 )
-                    poFeature->SetGeometryDirectly( new OGRPoint(dfLon, dfLat, CPLAtof(papszTokens[iZField])) );
+                    SetPointGeometry( poFeature, poGeomToReuse, dfLon, dfLat,
+                                      CPLAtof(papszTokens[iZField]), true );
                 else
-                    poFeature->SetGeometryDirectly( new OGRPoint(dfLon, dfLat) );
+                    SetPointGeometry( poFeature, poGeomToReuse, dfLon, dfLat,
+                                      0.0, false );
             }
         }
     }
 
     CSLDestroy( papszTokens );
+    delete poGeomToReuse;
 
 /* -------------------------------------------------------------------- */
 /*      Translate the record id.                                        */
@@ -1764,7 +1798,7 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
                 || m_poAttrQuery->Evaluate( poFeature )) )
             break;
 
-        delete poFeature;
+        RecycleFeature( poFeature );
     }
 
     return poFeature;
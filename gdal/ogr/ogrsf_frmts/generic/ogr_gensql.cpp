@@ -34,6 +34,7 @@
 #include "cpl_string.h"
 #include "ogr_api.h"
 #include "cpl_time.h"
+#include <algorithm>
 #include <vector>
 
 CPL_CVSID("$Id$");
@@ -80,6 +81,1628 @@ int OGRGenSQLResultsLayerHasSpecialField(swq_expr_node* expr,
     return FALSE;
 }
 
+/************************************************************************/
+/*                       GetGenSQLMaxMemory()                           */
+/*                                                                      */
+/*      Memory budget, in bytes, of the operations that can spill to    */
+/*      disk. The configuration option is expressed in megabytes.       */
+/************************************************************************/
+
+static size_t GetGenSQLMaxMemory( const char* pszConfigOption )
+{
+    GIntBig nMB = CPLAtoGIntBig( CPLGetConfigOption( pszConfigOption, "100" ) );
+    if( nMB < 0 )
+        nMB = 0;
+    if( (GUIntBig)nMB > (GUIntBig)(~((size_t)0)) / (1024 * 1024) )
+        return ~((size_t)0);
+    return (size_t)nMB * 1024 * 1024;
+}
+
+/************************************************************************/
+/*                     OGRGenSQLSerializeFeature()                      */
+/*                                                                      */
+/*      Serialize the FID, fields, geometries and style string of a     */
+/*      feature in a compact binary form suitable for temporary files.  */
+/************************************************************************/
+
+static void AppendBytes( std::vector<GByte>& abyBuffer,
+                         const void* pData, size_t nSize )
+{
+    abyBuffer.insert( abyBuffer.end(), (const GByte*) pData,
+                      (const GByte*) pData + nSize );
+}
+
+static void AppendInt( std::vector<GByte>& abyBuffer, int nVal )
+{
+    AppendBytes( abyBuffer, &nVal, sizeof(int) );
+}
+
+static void AppendString( std::vector<GByte>& abyBuffer, const char* pszStr )
+{
+    const int nLen = static_cast<int>(strlen(pszStr));
+    AppendInt( abyBuffer, nLen );
+    AppendBytes( abyBuffer, pszStr, nLen + 1 );
+}
+
+static void OGRGenSQLSerializeFeature( OGRFeature* poFeature,
+                                       std::vector<GByte>& abyBuffer )
+{
+    OGRFeatureDefn* poFDefn = poFeature->GetDefnRef();
+
+    abyBuffer.resize(0);
+
+    GIntBig nFID = poFeature->GetFID();
+    AppendBytes( abyBuffer, &nFID, sizeof(nFID) );
+
+    for( int iField = 0; iField < poFDefn->GetFieldCount(); iField++ )
+    {
+        if( !poFeature->IsFieldSet(iField) )
+        {
+            abyBuffer.push_back( 0 );
+            continue;
+        }
+        abyBuffer.push_back( 1 );
+
+        OGRField* psField = poFeature->GetRawFieldRef(iField);
+        switch( poFDefn->GetFieldDefn(iField)->GetType() )
+        {
+            case OFTInteger:
+                AppendInt( abyBuffer, psField->Integer );
+                break;
+            case OFTInteger64:
+                AppendBytes( abyBuffer, &psField->Integer64, sizeof(GIntBig) );
+                break;
+            case OFTReal:
+                AppendBytes( abyBuffer, &psField->Real, sizeof(double) );
+                break;
+            case OFTString:
+                AppendString( abyBuffer, psField->String );
+                break;
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+                AppendBytes( abyBuffer, &psField->Date, sizeof(psField->Date) );
+                break;
+            case OFTBinary:
+                AppendInt( abyBuffer, psField->Binary.nCount );
+                AppendBytes( abyBuffer, psField->Binary.paData,
+                             psField->Binary.nCount );
+                break;
+            case OFTIntegerList:
+                AppendInt( abyBuffer, psField->IntegerList.nCount );
+                AppendBytes( abyBuffer, psField->IntegerList.paList,
+                             sizeof(int) * psField->IntegerList.nCount );
+                break;
+            case OFTInteger64List:
+                AppendInt( abyBuffer, psField->Integer64List.nCount );
+                AppendBytes( abyBuffer, psField->Integer64List.paList,
+                             sizeof(GIntBig) * psField->Integer64List.nCount );
+                break;
+            case OFTRealList:
+                AppendInt( abyBuffer, psField->RealList.nCount );
+                AppendBytes( abyBuffer, psField->RealList.paList,
+                             sizeof(double) * psField->RealList.nCount );
+                break;
+            case OFTStringList:
+                AppendInt( abyBuffer, psField->StringList.nCount );
+                for( int i = 0; i < psField->StringList.nCount; i++ )
+                    AppendString( abyBuffer, psField->StringList.paList[i] );
+                break;
+            default:
+                /* Unhandled type : serialized as unset */
+                abyBuffer.back() = 0;
+                break;
+        }
+    }
+
+    for( int iGeom = 0; iGeom < poFDefn->GetGeomFieldCount(); iGeom++ )
+    {
+        OGRGeometry* poGeom = poFeature->GetGeomFieldRef(iGeom);
+        if( poGeom == NULL )
+        {
+            AppendInt( abyBuffer, 0 );
+            continue;
+        }
+        const int nWkbSize = poGeom->WkbSize();
+        AppendInt( abyBuffer, nWkbSize );
+        const size_t nOffset = abyBuffer.size();
+        abyBuffer.resize( nOffset + nWkbSize );
+        poGeom->exportToWkb( wkbNDR, &abyBuffer[nOffset], wkbVariantIso );
+    }
+
+    const char* pszStyleString = poFeature->GetStyleString();
+    if( pszStyleString == NULL )
+        AppendInt( abyBuffer, -1 );
+    else
+        AppendString( abyBuffer, pszStyleString );
+}
+
+/************************************************************************/
+/*                    OGRGenSQLDeserializeFeature()                     */
+/************************************************************************/
+
+class OGRGenSQLReader
+{
+        const GByte* pabyCur;
+        const GByte* pabyEnd;
+
+    public:
+        OGRGenSQLReader( const GByte* pabyData, size_t nSize ) :
+            pabyCur(pabyData), pabyEnd(pabyData + nSize) {}
+
+        int Read( void* pData, size_t nSize )
+        {
+            if( (size_t)(pabyEnd - pabyCur) < nSize )
+                return FALSE;
+            memcpy( pData, pabyCur, nSize );
+            pabyCur += nSize;
+            return TRUE;
+        }
+
+        const GByte* Skip( size_t nSize )
+        {
+            if( (size_t)(pabyEnd - pabyCur) < nSize )
+                return NULL;
+            const GByte* pabyRet = pabyCur;
+            pabyCur += nSize;
+            return pabyRet;
+        }
+
+        int ReadInt( int* pnVal ) { return Read( pnVal, sizeof(int) ); }
+
+        size_t GetRemaining() const { return (size_t)(pabyEnd - pabyCur); }
+
+        int ReadCount( int* pnCount, size_t nEltSize )
+        {
+            return ReadInt( pnCount ) && *pnCount >= 0 &&
+                   (size_t)*pnCount <= (size_t)(pabyEnd - pabyCur) / nEltSize;
+        }
+
+        char* ReadString()
+        {
+            int nLen;
+            if( !ReadCount( &nLen, 1 ) )
+                return NULL;
+            const GByte* pabyStr = Skip( nLen + 1 );
+            if( pabyStr == NULL || pabyStr[nLen] != '\0' )
+                return NULL;
+            return (char*) pabyStr;
+        }
+};
+
+static OGRFeature* OGRGenSQLDeserializeFeature( const GByte* pabyData,
+                                                size_t nSize,
+                                                OGRFeatureDefn* poFDefn )
+{
+    OGRGenSQLReader oReader( pabyData, nSize );
+    OGRFeature* poFeature = new OGRFeature( poFDefn );
+
+    GIntBig nFID;
+    if( !oReader.Read( &nFID, sizeof(nFID) ) )
+        goto error;
+    poFeature->SetFID( nFID );
+
+    for( int iField = 0; iField < poFDefn->GetFieldCount(); iField++ )
+    {
+        GByte bSet;
+        if( !oReader.Read( &bSet, 1 ) )
+            goto error;
+        if( !bSet )
+            continue;
+
+        switch( poFDefn->GetFieldDefn(iField)->GetType() )
+        {
+            case OFTInteger:
+            {
+                int nVal;
+                if( !oReader.ReadInt( &nVal ) )
+                    goto error;
+                poFeature->SetField( iField, nVal );
+                break;
+            }
+            case OFTInteger64:
+            {
+                GIntBig nVal;
+                if( !oReader.Read( &nVal, sizeof(nVal) ) )
+                    goto error;
+                poFeature->SetField( iField, nVal );
+                break;
+            }
+            case OFTReal:
+            {
+                double dfVal;
+                if( !oReader.Read( &dfVal, sizeof(dfVal) ) )
+                    goto error;
+                poFeature->SetField( iField, dfVal );
+                break;
+            }
+            case OFTString:
+            {
+                const char* pszVal = oReader.ReadString();
+                if( pszVal == NULL )
+                    goto error;
+                poFeature->SetField( iField, pszVal );
+                break;
+            }
+            case OFTDate:
+            case OFTTime:
+            case OFTDateTime:
+            {
+                OGRField sField;
+                if( !oReader.Read( &sField.Date, sizeof(sField.Date) ) )
+                    goto error;
+                poFeature->SetField( iField, &sField );
+                break;
+            }
+            case OFTBinary:
+            {
+                int nCount;
+                const GByte* pabyVal;
+                if( !oReader.ReadCount( &nCount, 1 ) ||
+                    (pabyVal = oReader.Skip( nCount )) == NULL )
+                    goto error;
+                poFeature->SetField( iField, nCount, (GByte*) pabyVal );
+                break;
+            }
+            case OFTIntegerList:
+            {
+                int nCount;
+                if( !oReader.ReadCount( &nCount, sizeof(int) ) )
+                    goto error;
+                std::vector<int> anList( nCount + 1 );
+                oReader.Read( &anList[0], sizeof(int) * nCount );
+                poFeature->SetField( iField, nCount, &anList[0] );
+                break;
+            }
+            case OFTInteger64List:
+            {
+                int nCount;
+                if( !oReader.ReadCount( &nCount, sizeof(GIntBig) ) )
+                    goto error;
+                std::vector<GIntBig> anList( nCount + 1 );
+                oReader.Read( &anList[0], sizeof(GIntBig) * nCount );
+                poFeature->SetField( iField, nCount, &anList[0] );
+                break;
+            }
+            case OFTRealList:
+            {
+                int nCount;
+                if( !oReader.ReadCount( &nCount, sizeof(double) ) )
+                    goto error;
+                std::vector<double> adfList( nCount + 1 );
+                oReader.Read( &adfList[0], sizeof(double) * nCount );
+                poFeature->SetField( iField, nCount, &adfList[0] );
+                break;
+            }
+            case OFTStringList:
+            {
+                int nCount;
+                if( !oReader.ReadCount( &nCount, sizeof(int) ) )
+                    goto error;
+                std::vector<char*> apszList( nCount + 1 );
+                for( int i = 0; i < nCount; i++ )
+                {
+                    apszList[i] = oReader.ReadString();
+                    if( apszList[i] == NULL )
+                        goto error;
+                }
+                apszList[nCount] = NULL;
+                poFeature->SetField( iField, &apszList[0] );
+                break;
+            }
+            default:
+                goto error;
+        }
+    }
+
+    for( int iGeom = 0; iGeom < poFDefn->GetGeomFieldCount(); iGeom++ )
+    {
+        int nWkbSize;
+        if( !oReader.ReadCount( &nWkbSize, 1 ) )
+            goto error;
+        if( nWkbSize == 0 )
+            continue;
+        const GByte* pabyWkb = oReader.Skip( nWkbSize );
+        OGRGeometry* poGeom = NULL;
+        if( pabyWkb == NULL ||
+            OGRGeometryFactory::createFromWkb( (GByte*) pabyWkb, NULL, &poGeom,
+                                               nWkbSize, wkbVariantIso )
+                                                            != OGRERR_NONE )
+            goto error;
+        poGeom->assignSpatialReference(
+            poFDefn->GetGeomFieldDefn(iGeom)->GetSpatialRef() );
+        poFeature->SetGeomFieldDirectly( iGeom, poGeom );
+    }
+
+    {
+        int nLen;
+        if( !oReader.ReadInt( &nLen ) )
+            goto error;
+        if( nLen >= 0 )
+        {
+            const GByte* pabyStr = oReader.Skip( (size_t)nLen + 1 );
+            if( pabyStr == NULL )
+                goto error;
+            poFeature->SetStyleString( (const char*) pabyStr );
+        }
+    }
+
+    return poFeature;
+
+error:
+    CPLError( CE_Failure, CPLE_AppDefined,
+              "Corrupted temporary feature data" );
+    delete poFeature;
+    return NULL;
+}
+
+/************************************************************************/
+/*                          OGRGenSQLSpillFile                          */
+/*                                                                      */
+/*      Append-only store of serialized features. The data is kept in   */
+/*      RAM until SpillToDisk() is called, and is then moved to a       */
+/*      temporary file, removed when the object is destroyed.           */
+/************************************************************************/
+
+class OGRGenSQLSpillFile
+{
+        GByte          *pabyBuffer;
+        size_t          nBufferSize;
+        size_t          nBufferAlloc;
+        CPLString       osTmpFilename;
+        VSILFILE       *fp;
+        vsi_l_offset    nFileSize;
+
+    public:
+        OGRGenSQLSpillFile() : pabyBuffer(NULL), nBufferSize(0),
+                               nBufferAlloc(0), fp(NULL), nFileSize(0) {}
+        ~OGRGenSQLSpillFile();
+
+        int             Append( const GByte* pabyData, size_t nSize,
+                                vsi_l_offset* pnOffset );
+        int             Read( vsi_l_offset nOffset, GByte* pabyData,
+                              size_t nSize );
+        int             SpillToDisk();
+
+        int             IsOnDisk() const { return fp != NULL; }
+        size_t          GetMemoryUsage() const { return nBufferAlloc; }
+        vsi_l_offset    GetSize() const { return fp ? nFileSize : nBufferSize; }
+};
+
+OGRGenSQLSpillFile::~OGRGenSQLSpillFile()
+{
+    CPLFree( pabyBuffer );
+    if( fp != NULL )
+    {
+        VSIFCloseL( fp );
+        VSIUnlink( osTmpFilename );
+    }
+}
+
+int OGRGenSQLSpillFile::Append( const GByte* pabyData, size_t nSize,
+                                vsi_l_offset* pnOffset )
+{
+    if( fp != NULL )
+    {
+        *pnOffset = nFileSize;
+        if( VSIFSeekL( fp, nFileSize, SEEK_SET ) != 0 ||
+            VSIFWriteL( pabyData, 1, nSize, fp ) != nSize )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Cannot write to temporary file %s",
+                      osTmpFilename.c_str() );
+            return FALSE;
+        }
+        nFileSize += nSize;
+        return TRUE;
+    }
+
+    if( nSize > nBufferAlloc - nBufferSize )
+    {
+        size_t nNewAlloc = nBufferAlloc + nBufferAlloc / 2;
+        if( nNewAlloc < nBufferSize + nSize )
+            nNewAlloc = nBufferSize + nSize + 65536;
+        GByte* pabyNew = (GByte*) VSI_REALLOC_VERBOSE( pabyBuffer, nNewAlloc );
+        if( pabyNew == NULL )
+            return FALSE;
+        pabyBuffer = pabyNew;
+        nBufferAlloc = nNewAlloc;
+    }
+    *pnOffset = nBufferSize;
+    memcpy( pabyBuffer + nBufferSize, pabyData, nSize );
+    nBufferSize += nSize;
+    return TRUE;
+}
+
+int OGRGenSQLSpillFile::Read( vsi_l_offset nOffset, GByte* pabyData,
+                              size_t nSize )
+{
+    if( fp != NULL )
+    {
+        if( VSIFSeekL( fp, nOffset, SEEK_SET ) != 0 ||
+            VSIFReadL( pabyData, 1, nSize, fp ) != nSize )
+        {
+            CPLError( CE_Failure, CPLE_FileIO,
+                      "Cannot read temporary file %s",
+                      osTmpFilename.c_str() );
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    if( nOffset > nBufferSize || nSize > nBufferSize - nOffset )
+        return FALSE;
+    memcpy( pabyData, pabyBuffer + nOffset, nSize );
+    return TRUE;
+}
+
+int OGRGenSQLSpillFile::SpillToDisk()
+{
+    if( fp != NULL )
+        return TRUE;
+
+    osTmpFilename = CPLGenerateTempFilename( "ogr_gensql" );
+    fp = VSIFOpenL( osTmpFilename, "wb+" );
+    if( fp == NULL )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot create temporary file %s", osTmpFilename.c_str() );
+        return FALSE;
+    }
+    if( VSIFWriteL( pabyBuffer, 1, nBufferSize, fp ) != nBufferSize )
+    {
+        CPLError( CE_Failure, CPLE_FileIO,
+                  "Cannot write to temporary file %s", osTmpFilename.c_str() );
+        VSIFCloseL( fp );
+        fp = NULL;
+        VSIUnlink( osTmpFilename );
+        return FALSE;
+    }
+    CPLDebug( "GenSQL", "Spilled %lu bytes to %s",
+              (unsigned long) nBufferSize, osTmpFilename.c_str() );
+    nFileSize = nBufferSize;
+    CPLFree( pabyBuffer );
+    pabyBuffer = NULL;
+    nBufferSize = 0;
+    nBufferAlloc = 0;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                          OGRGenSQLHashJoin                           */
+/*                                                                      */
+/*      Resolves a "primary.field = secondary.field" LEFT JOIN by       */
+/*      reading the secondary layer once into a hash table keyed on     */
+/*      the join field. Only the first secondary feature of each key    */
+/*      is kept, as the attribute filter based join only ever used the  */
+/*      first match. The serialized features are spilled to a           */
+/*      temporary file beyond OGR_SQL_HASH_JOIN_MAX_MEMORY megabytes;   */
+/*      the key index itself always stays in RAM.                       */
+/************************************************************************/
+
+typedef enum
+{
+    GENSQL_KEY_INTEGER,
+    GENSQL_KEY_REAL,
+    GENSQL_KEY_STRING
+} OGRGenSQLKeyType;
+
+typedef struct
+{
+    GIntBig         nIntKey;
+    double          dfRealKey;
+    char           *pszStrKey;
+    vsi_l_offset    nOffset;
+    size_t          nSize;
+} OGRGenSQLJoinEntry;
+
+static unsigned long OGRGenSQLJoinHashInteger( const void* elt )
+{
+    const GUIntBig nKey = (GUIntBig) ((const OGRGenSQLJoinEntry*) elt)->nIntKey;
+    return (unsigned long) (nKey ^ (nKey >> 32));
+}
+
+static int OGRGenSQLJoinEqualInteger( const void* elt1, const void* elt2 )
+{
+    return ((const OGRGenSQLJoinEntry*) elt1)->nIntKey ==
+           ((const OGRGenSQLJoinEntry*) elt2)->nIntKey;
+}
+
+static unsigned long OGRGenSQLJoinHashReal( const void* elt )
+{
+    double dfKey = ((const OGRGenSQLJoinEntry*) elt)->dfRealKey;
+    if( dfKey == 0.0 )
+        dfKey = 0.0; /* -0.0 and 0.0 must hash identically */
+    GUIntBig nBits;
+    memcpy( &nBits, &dfKey, sizeof(nBits) );
+    return (unsigned long) (nBits ^ (nBits >> 32));
+}
+
+static int OGRGenSQLJoinEqualReal( const void* elt1, const void* elt2 )
+{
+    return ((const OGRGenSQLJoinEntry*) elt1)->dfRealKey ==
+           ((const OGRGenSQLJoinEntry*) elt2)->dfRealKey;
+}
+
+/* OGR SQL compares strings case insensitively */
+static unsigned long OGRGenSQLJoinHashString( const void* elt )
+{
+    const unsigned char* pszKey = (const unsigned char*)
+        ((const OGRGenSQLJoinEntry*) elt)->pszStrKey;
+    unsigned long nHash = 0;
+    for( ; *pszKey != '\0'; pszKey++ )
+        nHash = nHash * 31 + (unsigned long) toupper( *pszKey );
+    return nHash;
+}
+
+static int OGRGenSQLJoinEqualString( const void* elt1, const void* elt2 )
+{
+    return EQUAL( ((const OGRGenSQLJoinEntry*) elt1)->pszStrKey,
+                  ((const OGRGenSQLJoinEntry*) elt2)->pszStrKey );
+}
+
+static void OGRGenSQLJoinFreeEntry( void* elt )
+{
+    CPLFree( ((OGRGenSQLJoinEntry*) elt)->pszStrKey );
+    CPLFree( elt );
+}
+
+class OGRGenSQLHashJoin
+{
+        OGRLayer           *poJoinLayer;
+        int                 iSrcField;
+        int                 iJoinField;
+        OGRGenSQLKeyType    eKeyType;
+        CPLHashSet         *hIndex;
+        OGRGenSQLSpillFile  oStore;
+        std::vector<GByte>  abyBuffer;
+
+        OGRGenSQLHashJoin( OGRLayer* poJoinLayerIn, int iSrcFieldIn,
+                           int iJoinFieldIn, OGRGenSQLKeyType eKeyTypeIn );
+
+        int                 GetKey( OGRFeature* poFeature, int iField,
+                                    OGRGenSQLJoinEntry* psKey );
+        int                 Build();
+
+    public:
+                           ~OGRGenSQLHashJoin();
+
+        static OGRGenSQLHashJoin* Create( swq_join_def* psJoinInfo,
+                                          OGRLayer* poSrcLayer,
+                                          OGRLayer* poJoinLayer );
+
+        OGRFeature         *GetMatchingFeature( OGRFeature* poSrcFeat );
+};
+
+OGRGenSQLHashJoin::OGRGenSQLHashJoin( OGRLayer* poJoinLayerIn,
+                                      int iSrcFieldIn, int iJoinFieldIn,
+                                      OGRGenSQLKeyType eKeyTypeIn ) :
+    poJoinLayer(poJoinLayerIn), iSrcField(iSrcFieldIn),
+    iJoinField(iJoinFieldIn), eKeyType(eKeyTypeIn), hIndex(NULL)
+{
+    if( eKeyType == GENSQL_KEY_INTEGER )
+        hIndex = CPLHashSetNew( OGRGenSQLJoinHashInteger,
+                                OGRGenSQLJoinEqualInteger,
+                                OGRGenSQLJoinFreeEntry );
+    else if( eKeyType == GENSQL_KEY_REAL )
+        hIndex = CPLHashSetNew( OGRGenSQLJoinHashReal,
+                                OGRGenSQLJoinEqualReal,
+                                OGRGenSQLJoinFreeEntry );
+    else
+        hIndex = CPLHashSetNew( OGRGenSQLJoinHashString,
+                                OGRGenSQLJoinEqualString,
+                                OGRGenSQLJoinFreeEntry );
+}
+
+OGRGenSQLHashJoin::~OGRGenSQLHashJoin()
+{
+    CPLHashSetDestroy( hIndex );
+}
+
+/************************************************************************/
+/*                               Create()                               */
+/*                                                                      */
+/*      Returns NULL if the join condition is not a simple equality     */
+/*      between fields of compatible types, in which case the join is   */
+/*      resolved with attribute filters on the secondary layer.         */
+/************************************************************************/
+
+OGRGenSQLHashJoin* OGRGenSQLHashJoin::Create( swq_join_def* psJoinInfo,
+                                              OGRLayer* poSrcLayer,
+                                              OGRLayer* poJoinLayer )
+{
+    swq_expr_node* poExpr = psJoinInfo->poExpr;
+    if( poJoinLayer == poSrcLayer ||
+        poExpr->eNodeType != SNT_OPERATION ||
+        poExpr->nOperation != SWQ_EQ || poExpr->nSubExprCount != 2 ||
+        poExpr->papoSubExpr[0]->eNodeType != SNT_COLUMN ||
+        poExpr->papoSubExpr[1]->eNodeType != SNT_COLUMN )
+        return NULL;
+
+    swq_expr_node* poSrcCol = poExpr->papoSubExpr[0];
+    swq_expr_node* poJoinCol = poExpr->papoSubExpr[1];
+    if( poSrcCol->table_index != 0 )
+    {
+        poSrcCol = poExpr->papoSubExpr[1];
+        poJoinCol = poExpr->papoSubExpr[0];
+    }
+    if( poSrcCol->table_index != 0 ||
+        poJoinCol->table_index != psJoinInfo->secondary_table )
+        return NULL;
+
+    OGRFeatureDefn* poSrcDefn = poSrcLayer->GetLayerDefn();
+    OGRFeatureDefn* poJoinDefn = poJoinLayer->GetLayerDefn();
+    if( poSrcCol->field_index < 0 ||
+        poSrcCol->field_index >= poSrcDefn->GetFieldCount() ||
+        poJoinCol->field_index < 0 ||
+        poJoinCol->field_index >= poJoinDefn->GetFieldCount() )
+        return NULL;
+
+    const OGRFieldType eSrcType =
+        poSrcDefn->GetFieldDefn(poSrcCol->field_index)->GetType();
+    const OGRFieldType eJoinType =
+        poJoinDefn->GetFieldDefn(poJoinCol->field_index)->GetType();
+    const int bSrcIsInt = eSrcType == OFTInteger || eSrcType == OFTInteger64;
+    const int bJoinIsInt = eJoinType == OFTInteger || eJoinType == OFTInteger64;
+
+    OGRGenSQLKeyType eKeyType;
+    if( eSrcType == OFTString && eJoinType == OFTString )
+        eKeyType = GENSQL_KEY_STRING;
+    else if( bSrcIsInt && bJoinIsInt )
+        eKeyType = GENSQL_KEY_INTEGER;
+    else if( (bSrcIsInt || eSrcType == OFTReal) &&
+             (bJoinIsInt || eJoinType == OFTReal) )
+        eKeyType = GENSQL_KEY_REAL;
+    else
+        return NULL;
+
+    OGRGenSQLHashJoin* poHashJoin =
+        new OGRGenSQLHashJoin( poJoinLayer, poSrcCol->field_index,
+                               poJoinCol->field_index, eKeyType );
+    if( !poHashJoin->Build() )
+    {
+        delete poHashJoin;
+        return NULL;
+    }
+    return poHashJoin;
+}
+
+/************************************************************************/
+/*                               GetKey()                               */
+/************************************************************************/
+
+int OGRGenSQLHashJoin::GetKey( OGRFeature* poFeature, int iField,
+                               OGRGenSQLJoinEntry* psKey )
+{
+    if( !poFeature->IsFieldSet(iField) )
+        return FALSE;
+
+    if( eKeyType == GENSQL_KEY_INTEGER )
+        psKey->nIntKey = poFeature->GetFieldAsInteger64(iField);
+    else if( eKeyType == GENSQL_KEY_REAL )
+    {
+        psKey->dfRealKey = poFeature->GetFieldAsDouble(iField);
+        if( CPLIsNan(psKey->dfRealKey) )
+            return FALSE;
+    }
+    else
+        psKey->pszStrKey = (char*) poFeature->GetFieldAsString(iField);
+    return TRUE;
+}
+
+/************************************************************************/
+/*                               Build()                                */
+/************************************************************************/
+
+int OGRGenSQLHashJoin::Build()
+{
+    const size_t nMaxMemory =
+        GetGenSQLMaxMemory( "OGR_SQL_HASH_JOIN_MAX_MEMORY" );
+    size_t nIndexMemory = 0;
+    int bOK = TRUE;
+
+    poJoinLayer->SetAttributeFilter( "" );
+    poJoinLayer->ResetReading();
+
+    OGRFeature* poFeature;
+    while( bOK && (poFeature = poJoinLayer->GetNextFeature()) != NULL )
+    {
+        OGRGenSQLJoinEntry sKey;
+        if( !GetKey( poFeature, iJoinField, &sKey ) ||
+            CPLHashSetLookup( hIndex, &sKey ) != NULL )
+        {
+            delete poFeature;
+            continue;
+        }
+
+        OGRGenSQLJoinEntry* psEntry = (OGRGenSQLJoinEntry*)
+            CPLMalloc( sizeof(OGRGenSQLJoinEntry) );
+        *psEntry = sKey;
+        if( eKeyType == GENSQL_KEY_STRING )
+        {
+            psEntry->pszStrKey = CPLStrdup( sKey.pszStrKey );
+            nIndexMemory += strlen( sKey.pszStrKey ) + 1;
+        }
+        else
+            psEntry->pszStrKey = NULL;
+        nIndexMemory += sizeof(OGRGenSQLJoinEntry) + 4 * sizeof(void*);
+
+        OGRGenSQLSerializeFeature( poFeature, abyBuffer );
+        delete poFeature;
+
+        psEntry->nSize = abyBuffer.size();
+        if( !oStore.IsOnDisk() &&
+            nIndexMemory + oStore.GetMemoryUsage() + psEntry->nSize > nMaxMemory )
+            bOK = oStore.SpillToDisk();
+        if( bOK )
+            bOK = oStore.Append( &abyBuffer[0], psEntry->nSize,
+                                 &psEntry->nOffset );
+        CPLHashSetInsert( hIndex, psEntry );
+    }
+
+    poJoinLayer->ResetReading();
+
+    if( bOK )
+        CPLDebug( "GenSQL", "Hash join on %s: %d distinct keys, " CPL_FRMT_GUIB
+                  " bytes of features%s",
+                  poJoinLayer->GetName(), CPLHashSetSize( hIndex ),
+                  (GUIntBig) oStore.GetSize(),
+                  oStore.IsOnDisk() ? " spilled to disk" : "" );
+    return bOK;
+}
+
+/************************************************************************/
+/*                         GetMatchingFeature()                         */
+/************************************************************************/
+
+OGRFeature* OGRGenSQLHashJoin::GetMatchingFeature( OGRFeature* poSrcFeat )
+{
+    OGRGenSQLJoinEntry sKey;
+    if( !GetKey( poSrcFeat, iSrcField, &sKey ) )
+        return NULL;
+
+    OGRGenSQLJoinEntry* psEntry =
+        (OGRGenSQLJoinEntry*) CPLHashSetLookup( hIndex, &sKey );
+    if( psEntry == NULL )
+        return NULL;
+
+    abyBuffer.resize( psEntry->nSize );
+    if( !oStore.Read( psEntry->nOffset, &abyBuffer[0], psEntry->nSize ) )
+        return NULL;
+    return OGRGenSQLDeserializeFeature( &abyBuffer[0], psEntry->nSize,
+                                        poJoinLayer->GetLayerDefn() );
+}
+
+/************************************************************************/
+/*                           OGRGenSQLSorter                            */
+/*                                                                      */
+/*      Sorts the result features of an ORDER BY query with a bounded   */
+/*      amount of memory. Each entry holds the ORDER BY keys and the    */
+/*      serialized translated feature, so that the sorted result is     */
+/*      read back without random access to the source layer. Beyond     */
+/*      OGR_SQL_ORDER_BY_MAX_MEMORY megabytes, the pending entries are  */
+/*      sorted and written as a run to a temporary file, and the runs   */
+/*      are merged while reading. With a LIMIT clause, only the first   */
+/*      OFFSET+LIMIT entries are retained, in a heap whose top is the   */
+/*      last retained entry.                                            */
+/*                                                                      */
+/*      Each run being merged has a read buffer, which counts against   */
+/*      the memory budget: when there are more runs than buffers fit    */
+/*      in it, groups of runs are first merged into longer runs.        */
+/************************************************************************/
+
+#define GENSQL_SORT_READ_CHUNK      (256 * 1024)
+#define GENSQL_SORT_MIN_READ_CHUNK  4096
+
+typedef enum
+{
+    GENSQL_SORT_INTEGER,
+    GENSQL_SORT_INTEGER64,
+    GENSQL_SORT_REAL,
+    GENSQL_SORT_STRING,
+    GENSQL_SORT_DATE,
+    GENSQL_SORT_OTHER
+} OGRGenSQLSortKeyType;
+
+typedef struct
+{
+    OGRField   *pasKeys;
+    GByte      *pabyPayload;
+    size_t      nPayloadSize;
+    size_t      nMemory;
+    GIntBig     nSeq;
+} OGRGenSQLSortEntry;
+
+typedef struct
+{
+    vsi_l_offset nStart;
+    vsi_l_offset nEnd;
+    GIntBig      nCount;
+} OGRGenSQLSortRun;
+
+/* Read position in a run of the temporary file. The keys and payload */
+/* of sEntry point into abyBuffer. */
+class OGRGenSQLSortCursor
+{
+    public:
+        vsi_l_offset        nOffset;
+        vsi_l_offset        nEnd;
+        std::vector<GByte>  abyBuffer;
+        vsi_l_offset        nBufferStart;
+        size_t              nBufferSize;
+        OGRGenSQLSortEntry  sEntry;
+        const GByte        *pabyRecord;
+        size_t              nRecordSize;
+};
+
+class OGRGenSQLSorter
+{
+        int                 nKeys;
+        std::vector<int>    anKeyField;
+        std::vector<int>    abSpecialKey;
+        std::vector<int>    abAscending;
+        std::vector<OGRGenSQLSortKeyType> aeKeyType;
+
+        GIntBig             nMaxEntries;
+        size_t              nMaxMemory;
+        size_t              nMemoryUsage;
+        size_t              nReadChunk;
+        size_t              nMaxFanIn;
+        GIntBig             nSeq;
+        GIntBig             nCount;
+        std::vector<OGRGenSQLSortEntry> asEntries;
+        std::vector<GByte>  abyBuffer;
+
+        OGRGenSQLSpillFile *poRuns;
+        std::vector<OGRGenSQLSortRun> asRuns;
+        std::vector<OGRGenSQLSortCursor*> apoCursors;
+        std::vector<int>    anHeap;
+        int                 bMergeStarted;
+        GIntBig             nMergePos;
+
+        size_t              ExtractKeys( OGRFeature* poSrcFeature,
+                                         OGRField* pasKeys );
+        void                FreeEntry( OGRGenSQLSortEntry* psEntry );
+        int                 FlushRun();
+        int                 FillCursor( OGRGenSQLSortCursor* poCursor,
+                                        size_t nNeeded );
+        int                 ReadRecord( OGRGenSQLSortCursor* poCursor );
+        void                FreeCursors();
+        void                StartMerge( size_t iFirstRun, size_t nRunCount );
+        void                AdvanceMerge();
+        int                 MergePass();
+
+    public:
+                            OGRGenSQLSorter( swq_select* psSelectInfo,
+                                             OGRFeatureDefn* poSrcDefn,
+                                             int iFIDFieldIndex );
+                           ~OGRGenSQLSorter();
+
+        int                 CompareKeys( const OGRField* pasFirst,
+                                         const OGRField* pasSecond ) const;
+        int                 IsBefore( const OGRGenSQLSortEntry& sFirst,
+                                      const OGRGenSQLSortEntry& sSecond ) const
+        {
+            const int nResult = CompareKeys( sFirst.pasKeys, sSecond.pasKeys );
+            return nResult > 0 || (nResult == 0 && sFirst.nSeq < sSecond.nSeq);
+        }
+
+        int                 Add( OGRFeature* poSrcFeature,
+                                 OGRFeature* poResultFeature );
+        int                 Finish();
+
+        GIntBig             GetCount() const { return nCount; }
+        int                 IsInMemory() const { return asRuns.empty(); }
+        OGRFeature         *GetFeature( GIntBig iIndex, OGRFeatureDefn* poDefn );
+
+        const OGRGenSQLSortEntry& GetCursorEntry( int iCursor ) const
+            { return apoCursors[iCursor]->sEntry; }
+};
+
+/* Strict weak ordering of the entries, for std::sort() and the LIMIT heap. */
+class OGRGenSQLSortLess
+{
+        const OGRGenSQLSorter* poSorter;
+
+    public:
+        OGRGenSQLSortLess( const OGRGenSQLSorter* poSorterIn ) :
+            poSorter(poSorterIn) {}
+
+        bool operator()( const OGRGenSQLSortEntry& sFirst,
+                         const OGRGenSQLSortEntry& sSecond ) const
+        {
+            return poSorter->IsBefore( sFirst, sSecond ) != FALSE;
+        }
+};
+
+/* Ordering of the merge heap, whose top is the cursor with the first entry. */
+class OGRGenSQLSortCursorGreater
+{
+        const OGRGenSQLSorter* poSorter;
+
+    public:
+        OGRGenSQLSortCursorGreater( const OGRGenSQLSorter* poSorterIn ) :
+            poSorter(poSorterIn) {}
+
+        bool operator()( int iFirst, int iSecond ) const
+        {
+            return poSorter->IsBefore( poSorter->GetCursorEntry(iSecond),
+                                       poSorter->GetCursorEntry(iFirst) )
+                   != FALSE;
+        }
+};
+
+OGRGenSQLSorter::OGRGenSQLSorter( swq_select* psSelectInfo,
+                                  OGRFeatureDefn* poSrcDefn,
+                                  int iFIDFieldIndex ) :
+    nKeys(psSelectInfo->order_specs), nMaxEntries(-1),
+    nMaxMemory(GetGenSQLMaxMemory( "OGR_SQL_ORDER_BY_MAX_MEMORY" )),
+    nMemoryUsage(0), nReadChunk(GENSQL_SORT_READ_CHUNK), nMaxFanIn(0),
+    nSeq(0), nCount(0), poRuns(new OGRGenSQLSpillFile()),
+    bMergeStarted(FALSE), nMergePos(0)
+{
+    for( int iKey = 0; iKey < nKeys; iKey++ )
+    {
+        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
+        OGRGenSQLSortKeyType eType = GENSQL_SORT_OTHER;
+
+        if( psKeyDef->field_index >= iFIDFieldIndex + SPECIAL_FIELD_COUNT )
+        {
+            CPLAssert( FALSE );
+        }
+        else if( psKeyDef->field_index >= iFIDFieldIndex )
+        {
+            switch( SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex] )
+            {
+              case SWQ_INTEGER:   eType = GENSQL_SORT_INTEGER; break;
+              case SWQ_INTEGER64: eType = GENSQL_SORT_INTEGER64; break;
+              case SWQ_FLOAT:     eType = GENSQL_SORT_REAL; break;
+              default:            eType = GENSQL_SORT_STRING; break;
+            }
+        }
+        else
+        {
+            switch( poSrcDefn->GetFieldDefn(psKeyDef->field_index)->GetType() )
+            {
+              case OFTInteger:    eType = GENSQL_SORT_INTEGER; break;
+              case OFTInteger64:  eType = GENSQL_SORT_INTEGER64; break;
+              case OFTReal:       eType = GENSQL_SORT_REAL; break;
+              case OFTString:     eType = GENSQL_SORT_STRING; break;
+              case OFTDate:
+              case OFTTime:
+              case OFTDateTime:   eType = GENSQL_SORT_DATE; break;
+              default:            break;
+            }
+        }
+
+        anKeyField.push_back( psKeyDef->field_index );
+        abSpecialKey.push_back( psKeyDef->field_index >= iFIDFieldIndex );
+        abAscending.push_back( psKeyDef->ascending_flag );
+        aeKeyType.push_back( eType );
+    }
+
+    if( psSelectInfo->limit >= 0 )
+    {
+        nMaxEntries = psSelectInfo->limit;
+        if( psSelectInfo->offset > 0 )
+        {
+            if( psSelectInfo->offset > GINTBIG_MAX - nMaxEntries )
+                nMaxEntries = -1;
+            else
+                nMaxEntries += psSelectInfo->offset;
+        }
+    }
+
+    nMaxFanIn = nMaxMemory / nReadChunk;
+    if( nMaxFanIn < 2 )
+    {
+        nMaxFanIn = 2;
+        nReadChunk = nMaxMemory / 2;
+        if( nReadChunk < GENSQL_SORT_MIN_READ_CHUNK )
+            nReadChunk = GENSQL_SORT_MIN_READ_CHUNK;
+    }
+}
+
+OGRGenSQLSorter::~OGRGenSQLSorter()
+{
+    for( size_t i = 0; i < asEntries.size(); i++ )
+        FreeEntry( &asEntries[i] );
+    FreeCursors();
+    delete poRuns;
+}
+
+/************************************************************************/
+/*                            CompareKeys()                             */
+/*                                                                      */
+/*      Returns a positive value if the first tuple sorts before the    */
+/*      second one, like OGRGenSQLResultsLayer used to. Unset values    */
+/*      sort before set ones in ascending order.                        */
+/************************************************************************/
+
+int OGRGenSQLSorter::CompareKeys( const OGRField* pasFirst,
+                                  const OGRField* pasSecond ) const
+{
+    int nResult = 0;
+
+    for( int iKey = 0; nResult == 0 && iKey < nKeys; iKey++ )
+    {
+        const OGRField* psFirst = pasFirst + iKey;
+        const OGRField* psSecond = pasSecond + iKey;
+        const int bFirstUnset = psFirst->Set.nMarker1 == OGRUnsetMarker
+                             && psFirst->Set.nMarker2 == OGRUnsetMarker;
+        const int bSecondUnset = psSecond->Set.nMarker1 == OGRUnsetMarker
+                              && psSecond->Set.nMarker2 == OGRUnsetMarker;
+
+        if( bFirstUnset )
+            nResult = bSecondUnset ? 0 : -1;
+        else if( bSecondUnset )
+            nResult = 1;
+        else
+        {
+            switch( aeKeyType[iKey] )
+            {
+              case GENSQL_SORT_INTEGER:
+                if( psFirst->Integer < psSecond->Integer )
+                    nResult = -1;
+                else if( psFirst->Integer > psSecond->Integer )
+                    nResult = 1;
+                break;
+
+              case GENSQL_SORT_INTEGER64:
+                if( psFirst->Integer64 < psSecond->Integer64 )
+                    nResult = -1;
+                else if( psFirst->Integer64 > psSecond->Integer64 )
+                    nResult = 1;
+                break;
+
+              case GENSQL_SORT_REAL:
+                if( psFirst->Real < psSecond->Real )
+                    nResult = -1;
+                else if( psFirst->Real > psSecond->Real )
+                    nResult = 1;
+                break;
+
+              case GENSQL_SORT_STRING:
+                nResult = strcmp( psFirst->String, psSecond->String );
+                break;
+
+              case GENSQL_SORT_DATE:
+                nResult = OGRCompareDate( (OGRField*) psFirst,
+                                          (OGRField*) psSecond );
+                break;
+
+              default:
+                break;
+            }
+        }
+
+        if( abAscending[iKey] )
+            nResult *= -1;
+    }
+
+    return nResult;
+}
+
+/************************************************************************/
+/*                            ExtractKeys()                             */
+/*                                                                      */
+/*      Fills the zero initialized key tuple from the source feature    */
+/*      and returns the size of the allocated strings.                  */
+/************************************************************************/
+
+size_t OGRGenSQLSorter::ExtractKeys( OGRFeature* poSrcFeature,
+                                     OGRField* pasKeys )
+{
+    size_t nStringSize = 0;
+
+    for( int iKey = 0; iKey < nKeys; iKey++ )
+    {
+        const int iField = anKeyField[iKey];
+        OGRField* psDstField = pasKeys + iKey;
+
+        if( abSpecialKey[iKey] )
+        {
+            switch( aeKeyType[iKey] )
+            {
+              case GENSQL_SORT_INTEGER:
+                psDstField->Integer = poSrcFeature->GetFieldAsInteger(iField);
+                break;
+
+              case GENSQL_SORT_INTEGER64:
+                psDstField->Integer64 =
+                    poSrcFeature->GetFieldAsInteger64(iField);
+                break;
+
+              case GENSQL_SORT_REAL:
+                psDstField->Real = poSrcFeature->GetFieldAsDouble(iField);
+                break;
+
+              case GENSQL_SORT_STRING:
+                psDstField->String =
+                    CPLStrdup( poSrcFeature->GetFieldAsString(iField) );
+                nStringSize += strlen( psDstField->String ) + 1;
+                break;
+
+              default:
+                break;
+            }
+            continue;
+        }
+
+        OGRField *psSrcField = poSrcFeature->GetRawFieldRef( iField );
+        if( aeKeyType[iKey] == GENSQL_SORT_STRING )
+        {
+            if( poSrcFeature->IsFieldSet( iField ) )
+            {
+                psDstField->String = CPLStrdup( psSrcField->String );
+                nStringSize += strlen( psDstField->String ) + 1;
+            }
+            else
+                memcpy( psDstField, psSrcField, sizeof(OGRField) );
+        }
+        else if( aeKeyType[iKey] != GENSQL_SORT_OTHER )
+            memcpy( psDstField, psSrcField, sizeof(OGRField) );
+    }
+
+    return nStringSize;
+}
+
+/************************************************************************/
+/*                             FreeEntry()                              */
+/************************************************************************/
+
+void OGRGenSQLSorter::FreeEntry( OGRGenSQLSortEntry* psEntry )
+{
+    for( int iKey = 0; iKey < nKeys; iKey++ )
+    {
+        OGRField* psField = psEntry->pasKeys + iKey;
+        if( aeKeyType[iKey] == GENSQL_SORT_STRING &&
+            (psField->Set.nMarker1 != OGRUnsetMarker ||
+             psField->Set.nMarker2 != OGRUnsetMarker) )
+            CPLFree( psField->String );
+    }
+    CPLFree( psEntry->pasKeys );
+    CPLFree( psEntry->pabyPayload );
+    psEntry->pasKeys = NULL;
+    psEntry->pabyPayload = NULL;
+}
+
+/************************************************************************/
+/*                                Add()                                 */
+/*                                                                      */
+/*      Adds a result feature, sorted on the keys of the source         */
+/*      feature it was translated from.                                 */
+/************************************************************************/
+
+int OGRGenSQLSorter::Add( OGRFeature* poSrcFeature,
+                          OGRFeature* poResultFeature )
+{
+    if( nMaxEntries == 0 )
+        return TRUE;
+
+    OGRGenSQLSortEntry sEntry;
+    sEntry.pasKeys = (OGRField*) VSI_CALLOC_VERBOSE( nKeys, sizeof(OGRField) );
+    if( sEntry.pasKeys == NULL )
+        return FALSE;
+    sEntry.pabyPayload = NULL;
+    sEntry.nPayloadSize = 0;
+    sEntry.nSeq = nSeq++;
+    sEntry.nMemory = ExtractKeys( poSrcFeature, sEntry.pasKeys );
+
+/* -------------------------------------------------------------------- */
+/*      With a full LIMIT heap, only entries sorting before the last    */
+/*      retained one are of interest.                                   */
+/* -------------------------------------------------------------------- */
+    const int bHeapFull =
+        nMaxEntries > 0 && (GIntBig) asEntries.size() >= nMaxEntries;
+    if( bHeapFull && !IsBefore( sEntry, asEntries[0] ) )
+    {
+        FreeEntry( &sEntry );
+        return TRUE;
+    }
+
+    OGRGenSQLSerializeFeature( poResultFeature, abyBuffer );
+    sEntry.nPayloadSize = abyBuffer.size();
+    sEntry.pabyPayload = (GByte*) VSI_MALLOC_VERBOSE( sEntry.nPayloadSize );
+    if( sEntry.pabyPayload == NULL )
+    {
+        FreeEntry( &sEntry );
+        return FALSE;
+    }
+    memcpy( sEntry.pabyPayload, &abyBuffer[0], sEntry.nPayloadSize );
+    sEntry.nMemory += sizeof(OGRGenSQLSortEntry) +
+                      nKeys * sizeof(OGRField) + sEntry.nPayloadSize;
+
+    if( bHeapFull )
+    {
+        std::pop_heap( asEntries.begin(), asEntries.end(),
+                       OGRGenSQLSortLess(this) );
+        nMemoryUsage -= asEntries.back().nMemory;
+        FreeEntry( &asEntries.back() );
+        asEntries.back() = sEntry;
+        std::push_heap( asEntries.begin(), asEntries.end(),
+                        OGRGenSQLSortLess(this) );
+    }
+    else
+    {
+        asEntries.push_back( sEntry );
+        if( nMaxEntries > 0 )
+            std::push_heap( asEntries.begin(), asEntries.end(),
+                            OGRGenSQLSortLess(this) );
+    }
+    nMemoryUsage += sEntry.nMemory;
+
+    if( nMemoryUsage > nMaxMemory )
+        return FlushRun();
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                              FlushRun()                              */
+/*                                                                      */
+/*      Sorts the pending entries and appends them to the temporary     */
+/*      file. Each record is made of its size, the sequence number,     */
+/*      the keys and the serialized feature.                            */
+/************************************************************************/
+
+int OGRGenSQLSorter::FlushRun()
+{
+    if( asEntries.empty() )
+        return TRUE;
+
+    std::sort( asEntries.begin(), asEntries.end(), OGRGenSQLSortLess(this) );
+
+    int bOK = poRuns->SpillToDisk();
+
+    OGRGenSQLSortRun sRun;
+    sRun.nStart = poRuns->GetSize();
+    sRun.nCount = 0;
+
+    for( size_t i = 0; bOK && i < asEntries.size(); i++ )
+    {
+        const OGRGenSQLSortEntry& sEntry = asEntries[i];
+
+        abyBuffer.resize( 0 );
+        AppendInt( abyBuffer, 0 );
+        AppendBytes( abyBuffer, &sEntry.nSeq, sizeof(GIntBig) );
+        for( int iKey = 0; iKey < nKeys; iKey++ )
+        {
+            const OGRField* psField = sEntry.pasKeys + iKey;
+            if( aeKeyType[iKey] == GENSQL_SORT_STRING )
+            {
+                const GByte bSet = !(psField->Set.nMarker1 == OGRUnsetMarker &&
+                                     psField->Set.nMarker2 == OGRUnsetMarker);
+                AppendBytes( abyBuffer, &bSet, 1 );
+                if( bSet )
+                    AppendString( abyBuffer, psField->String );
+            }
+            else
+                AppendBytes( abyBuffer, psField, sizeof(OGRField) );
+        }
+        AppendBytes( abyBuffer, sEntry.pabyPayload, sEntry.nPayloadSize );
+
+        const int nRecordSize = static_cast<int>(abyBuffer.size() - sizeof(int));
+        memcpy( &abyBuffer[0], &nRecordSize, sizeof(int) );
+
+        vsi_l_offset nOffset;
+        bOK = poRuns->Append( &abyBuffer[0], abyBuffer.size(), &nOffset );
+        sRun.nCount++;
+    }
+
+    sRun.nEnd = poRuns->GetSize();
+    asRuns.push_back( sRun );
+
+    CPLDebug( "GenSQL", "ORDER BY: wrote run %d of " CPL_FRMT_GIB " features",
+              (int) asRuns.size(), sRun.nCount );
+
+    for( size_t i = 0; i < asEntries.size(); i++ )
+        FreeEntry( &asEntries[i] );
+    asEntries.resize( 0 );
+    nMemoryUsage = 0;
+
+    return bOK;
+}
+
+/************************************************************************/
+/*                               Finish()                               */
+/************************************************************************/
+
+int OGRGenSQLSorter::Finish()
+{
+    if( asRuns.empty() )
+    {
+        std::sort( asEntries.begin(), asEntries.end(),
+                   OGRGenSQLSortLess(this) );
+        nCount = (GIntBig) asEntries.size();
+        return TRUE;
+    }
+
+    if( !FlushRun() )
+        return FALSE;
+
+    while( asRuns.size() > nMaxFanIn )
+    {
+        if( !MergePass() )
+            return FALSE;
+    }
+
+    nCount = 0;
+    for( size_t i = 0; i < asRuns.size(); i++ )
+        nCount += asRuns[i].nCount;
+    if( nMaxEntries >= 0 && nCount > nMaxEntries )
+        nCount = nMaxEntries;
+
+    return TRUE;
+}
+
+/************************************************************************/
+/*                             FillCursor()                             */
+/*                                                                      */
+/*      Makes sure that the nNeeded bytes at the cursor offset are in   */
+/*      its buffer.                                                     */
+/************************************************************************/
+
+int OGRGenSQLSorter::FillCursor( OGRGenSQLSortCursor* poCursor,
+                                 size_t nNeeded )
+{
+    if( poCursor->nOffset >= poCursor->nBufferStart &&
+        poCursor->nOffset + nNeeded <=
+            poCursor->nBufferStart + poCursor->nBufferSize )
+        return TRUE;
+
+    if( nNeeded > poCursor->nEnd - poCursor->nOffset )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Corrupted temporary sort data" );
+        return FALSE;
+    }
+
+    size_t nToRead = nNeeded;
+    if( nToRead < nReadChunk )
+    {
+        nToRead = nReadChunk;
+        if( nToRead > poCursor->nEnd - poCursor->nOffset )
+            nToRead = (size_t) (poCursor->nEnd - poCursor->nOffset);
+    }
+
+    poCursor->abyBuffer.resize( nToRead );
+    poCursor->nBufferStart = poCursor->nOffset;
+    poCursor->nBufferSize = 0;
+    if( !poRuns->Read( poCursor->nOffset, &poCursor->abyBuffer[0], nToRead ) )
+        return FALSE;
+    poCursor->nBufferSize = nToRead;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                             ReadRecord()                             */
+/*                                                                      */
+/*      Decodes the next record of the run into the cursor entry.       */
+/*      Returns FALSE at the end of the run or on error.                */
+/************************************************************************/
+
+int OGRGenSQLSorter::ReadRecord( OGRGenSQLSortCursor* poCursor )
+{
+    if( poCursor->nOffset >= poCursor->nEnd )
+        return FALSE;
+
+    int nRecordSize;
+    if( !FillCursor( poCursor, sizeof(int) ) )
+        return FALSE;
+    memcpy( &nRecordSize, &poCursor->abyBuffer[0] +
+                (size_t) (poCursor->nOffset - poCursor->nBufferStart),
+            sizeof(int) );
+    if( nRecordSize < 0 ||
+        !FillCursor( poCursor, sizeof(int) + (size_t) nRecordSize ) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Corrupted temporary sort data" );
+        return FALSE;
+    }
+
+    poCursor->pabyRecord = &poCursor->abyBuffer[0] +
+                (size_t) (poCursor->nOffset - poCursor->nBufferStart);
+    poCursor->nRecordSize = sizeof(int) + (size_t) nRecordSize;
+
+    OGRGenSQLReader oReader( poCursor->pabyRecord + sizeof(int),
+                             nRecordSize );
+    OGRGenSQLSortEntry& sEntry = poCursor->sEntry;
+    int bOK = oReader.Read( &sEntry.nSeq, sizeof(GIntBig) );
+    for( int iKey = 0; bOK && iKey < nKeys; iKey++ )
+    {
+        OGRField* psField = sEntry.pasKeys + iKey;
+        if( aeKeyType[iKey] == GENSQL_SORT_STRING )
+        {
+            GByte bSet = 0;
+            bOK = oReader.Read( &bSet, 1 );
+            if( bOK && bSet )
+            {
+                psField->String = oReader.ReadString();
+                bOK = psField->String != NULL;
+            }
+            else
+            {
+                psField->Set.nMarker1 = OGRUnsetMarker;
+                psField->Set.nMarker2 = OGRUnsetMarker;
+            }
+        }
+        else
+            bOK = oReader.Read( psField, sizeof(OGRField) );
+    }
+    if( !bOK )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Corrupted temporary sort data" );
+        return FALSE;
+    }
+    sEntry.nPayloadSize = oReader.GetRemaining();
+    sEntry.pabyPayload = (GByte*) oReader.Skip( sEntry.nPayloadSize );
+
+    poCursor->nOffset += sizeof(int) + (size_t) nRecordSize;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                            FreeCursors()                             */
+/************************************************************************/
+
+void OGRGenSQLSorter::FreeCursors()
+{
+    for( size_t i = 0; i < apoCursors.size(); i++ )
+    {
+        CPLFree( apoCursors[i]->sEntry.pasKeys );
+        delete apoCursors[i];
+    }
+    apoCursors.resize( 0 );
+    anHeap.resize( 0 );
+    bMergeStarted = FALSE;
+}
+
+/************************************************************************/
+/*                             StartMerge()                             */
+/************************************************************************/
+
+void OGRGenSQLSorter::StartMerge( size_t iFirstRun, size_t nRunCount )
+{
+    FreeCursors();
+
+    for( size_t i = 0; i < nRunCount; i++ )
+    {
+        const OGRGenSQLSortRun& sRun = asRuns[iFirstRun + i];
+        OGRGenSQLSortCursor* poCursor = new OGRGenSQLSortCursor();
+        poCursor->nOffset = sRun.nStart;
+        poCursor->nEnd = sRun.nEnd;
+        poCursor->nBufferStart = 0;
+        poCursor->nBufferSize = 0;
+        poCursor->pabyRecord = NULL;
+        poCursor->nRecordSize = 0;
+        poCursor->sEntry.pasKeys =
+            (OGRField*) CPLCalloc( nKeys, sizeof(OGRField) );
+        poCursor->sEntry.pabyPayload = NULL;
+        poCursor->sEntry.nPayloadSize = 0;
+        poCursor->sEntry.nMemory = 0;
+        apoCursors.push_back( poCursor );
+
+        if( ReadRecord( poCursor ) )
+        {
+            anHeap.push_back( static_cast<int>(i) );
+            std::push_heap( anHeap.begin(), anHeap.end(),
+                            OGRGenSQLSortCursorGreater(this) );
+        }
+    }
+
+    bMergeStarted = TRUE;
+    nMergePos = 0;
+}
+
+/************************************************************************/
+/*                            AdvanceMerge()                            */
+/************************************************************************/
+
+void OGRGenSQLSorter::AdvanceMerge()
+{
+    std::pop_heap( anHeap.begin(), anHeap.end(),
+                   OGRGenSQLSortCursorGreater(this) );
+    const int iCursor = anHeap.back();
+    anHeap.pop_back();
+
+    if( ReadRecord( apoCursors[iCursor] ) )
+    {
+        anHeap.push_back( iCursor );
+        std::push_heap( anHeap.begin(), anHeap.end(),
+                        OGRGenSQLSortCursorGreater(this) );
+    }
+
+    nMergePos++;
+}
+
+/************************************************************************/
+/*                             MergePass()                              */
+/*                                                                      */
+/*      Merges groups of nMaxFanIn runs into longer runs, written to a  */
+/*      new temporary file. The records are copied as they are.        */
+/************************************************************************/
+
+int OGRGenSQLSorter::MergePass()
+{
+    OGRGenSQLSpillFile* poNewRuns = new OGRGenSQLSpillFile();
+    std::vector<OGRGenSQLSortRun> asNewRuns;
+    int bOK = poNewRuns->SpillToDisk();
+
+    for( size_t iFirstRun = 0; bOK && iFirstRun < asRuns.size();
+         iFirstRun += nMaxFanIn )
+    {
+        size_t nRunCount = asRuns.size() - iFirstRun;
+        if( nRunCount > nMaxFanIn )
+            nRunCount = nMaxFanIn;
+
+        OGRGenSQLSortRun sRun;
+        sRun.nStart = poNewRuns->GetSize();
+        sRun.nCount = 0;
+
+        StartMerge( iFirstRun, nRunCount );
+        while( bOK && !anHeap.empty() &&
+               (nMaxEntries < 0 || sRun.nCount < nMaxEntries) )
+        {
+            const OGRGenSQLSortCursor* poCursor = apoCursors[anHeap[0]];
+            vsi_l_offset nOffset;
+            bOK = poNewRuns->Append( poCursor->pabyRecord,
+                                     poCursor->nRecordSize, &nOffset );
+            sRun.nCount++;
+            AdvanceMerge();
+        }
+
+        sRun.nEnd = poNewRuns->GetSize();
+        asNewRuns.push_back( sRun );
+    }
+    FreeCursors();
+
+    CPLDebug( "GenSQL", "ORDER BY: merged %d runs into %d",
+              (int) asRuns.size(), (int) asNewRuns.size() );
+
+    delete poRuns;
+    poRuns = poNewRuns;
+    asRuns = asNewRuns;
+    return bOK;
+}
+
+/************************************************************************/
+/*                             GetFeature()                             */
+/*                                                                      */
+/*      Returns the feature at the iIndex position of the sorted        */
+/*      result. Sequential access to merged runs is cheap, going        */
+/*      backward restarts the merge.                                    */
+/************************************************************************/
+
+OGRFeature* OGRGenSQLSorter::GetFeature( GIntBig iIndex,
+                                         OGRFeatureDefn* poDefn )
+{
+    if( iIndex < 0 || iIndex >= nCount )
+        return NULL;
+
+    if( asRuns.empty() )
+    {
+        const OGRGenSQLSortEntry& sEntry = asEntries[(size_t) iIndex];
+        return OGRGenSQLDeserializeFeature( sEntry.pabyPayload,
+                                            sEntry.nPayloadSize, poDefn );
+    }
+
+    if( !bMergeStarted || iIndex < nMergePos )
+        StartMerge( 0, asRuns.size() );
+    while( nMergePos < iIndex && !anHeap.empty() )
+        AdvanceMerge();
+    if( anHeap.empty() )
+        return NULL;
+
+    const OGRGenSQLSortEntry& sEntry = apoCursors[anHeap[0]]->sEntry;
+    OGRFeature* poFeature =
+        OGRGenSQLDeserializeFeature( sEntry.pabyPayload,
+                                     sEntry.nPayloadSize, poDefn );
+    AdvanceMerge();
+    return poFeature;
+}
+
 /************************************************************************/
 /*                       OGRGenSQLResultsLayer()                        */
 /************************************************************************/
@@ -90,14 +1713,16 @@ OGRGenSQLResultsLayer::OGRGenSQLResultsLayer( GDALDataset *poSrcDSIn,
                                               const char *pszWHEREIn,
                                               const char *pszDialect ) :
     poSrcLayer(NULL), pszWHERE(NULL), papoTableLayers(NULL), poDefn(NULL),
-    panGeomFieldToSrcGeomField(NULL), nIndexSize(0),
-    panFIDIndex(NULL), bOrderByValid(FALSE), nNextIndexFID(0),
-    poSummaryFeature(NULL), iFIDFieldIndex(), nExtraDSCount(0), papoExtraDS(NULL)
+    panGeomFieldToSrcGeomField(NULL), poSorter(NULL),
+    bOrderByValid(FALSE), nNextIndexFID(0), nIteratedFeatures(-1),
+    poSummaryFeature(NULL), iFIDFieldIndex(), nExtraDSCount(0), papoExtraDS(NULL),
+    bHashJoinsPrepared(FALSE), papoHashJoins(NULL)
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfoIn;
 
     poSrcDS = poSrcDSIn;
     pSelectInfo = pSelectInfoIn;
+    nNextIndexFID = psSelectInfo->offset;
 
 /* -------------------------------------------------------------------- */
 /*      Identify all the layers involved in the SELECT.                 */
@@ -493,10 +2118,18 @@ OGRGenSQLResultsLayer::~OGRGenSQLResultsLayer()
 /* -------------------------------------------------------------------- */
 /*      Free various datastructures.                                    */
 /* -------------------------------------------------------------------- */
+    if( papoHashJoins != NULL )
+    {
+        for( int iJoin = 0; iJoin < ((swq_select *) pSelectInfo)->join_count;
+             iJoin++ )
+            delete papoHashJoins[iJoin];
+        CPLFree( papoHashJoins );
+    }
+
     CPLFree( papoTableLayers );
     papoTableLayers = NULL;
 
-    CPLFree( panFIDIndex );
+    delete poSorter;
     CPLFree( panGeomFieldToSrcGeomField );
 
     delete poSummaryFeature;
@@ -618,7 +2251,8 @@ void OGRGenSQLResultsLayer::ResetReading()
         ApplyFiltersToSource();
     }
 
-    nNextIndexFID = 0;
+    nNextIndexFID = psSelectInfo->offset;
+    nIteratedFeatures = -1;
 }
 
 /************************************************************************/
@@ -635,16 +2269,18 @@ OGRErr OGRGenSQLResultsLayer::SetNextByIndex( GIntBig nIndex )
 
     CreateOrderByIndex();
 
+    nIteratedFeatures = nIndex;
+
     if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
         || psSelectInfo->query_mode == SWQM_DISTINCT_LIST 
-        || panFIDIndex != NULL )
+        || poSorter != NULL )
     {
-        nNextIndexFID = nIndex;
+        nNextIndexFID = nIndex + psSelectInfo->offset;
         return OGRERR_NONE;
     }
     else
     {
-        return poSrcLayer->SetNextByIndex( nIndex );
+        return poSrcLayer->SetNextByIndex( nIndex + psSelectInfo->offset );
     }
 }
 
@@ -692,6 +2328,7 @@ GIntBig OGRGenSQLResultsLayer::GetFeatureCount( int bForce )
 
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+    GIntBig nRet;
 
     CreateOrderByIndex();
 
@@ -705,14 +2342,31 @@ GIntBig OGRGenSQLResultsLayer::GetFeatureCount( int bForce )
         if( psSummary == NULL )
             return 0;
 
-        return psSummary->count;
+        nRet = psSummary->count;
     }
     else if( psSelectInfo->query_mode != SWQM_RECORDSET )
-        return 1;
+        nRet = 1;
+    else if( poSorter != NULL )
+        nRet = poSorter->GetCount();
     else if( m_poAttrQuery == NULL && !MustEvaluateSpatialFilterOnGenSQL() )
-        return poSrcLayer->GetFeatureCount( bForce );
+        nRet = poSrcLayer->GetFeatureCount( bForce );
     else
+    {
+        /* Iterates over GetNextFeature(), that honours OFFSET and LIMIT */
         return OGRLayer::GetFeatureCount( bForce );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Apply the OFFSET and LIMIT clauses.                             */
+/* -------------------------------------------------------------------- */
+    if( nRet < 0 )
+        return nRet;
+    nRet -= psSelectInfo->offset;
+    if( nRet < 0 )
+        nRet = 0;
+    if( psSelectInfo->limit >= 0 && nRet > psSelectInfo->limit )
+        nRet = psSelectInfo->limit;
+    return nRet;
 }
 
 /************************************************************************/
@@ -728,7 +2382,7 @@ int OGRGenSQLResultsLayer::TestCapability( const char *pszCap )
     {
         if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
             || psSelectInfo->query_mode == SWQM_DISTINCT_LIST 
-            || panFIDIndex != NULL )
+            || (poSorter != NULL && poSorter->IsInMemory()) )
             return TRUE;
         else 
             return poSrcLayer->TestCapability( pszCap );
@@ -1251,6 +2905,35 @@ static CPLString GetFilterForJoin(swq_expr_node* poExpr, OGRFeature* poSrcFeat,
     return "";
 }
 
+/************************************************************************/
+/*                          PrepareHashJoins()                          */
+/*                                                                      */
+/*      Build the hash tables of the joins that are equalities between */
+/*      a field of the primary table and a field of the secondary one,  */
+/*      so that they don't need one attribute filter per feature.       */
+/************************************************************************/
+
+void OGRGenSQLResultsLayer::PrepareHashJoins()
+
+{
+    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
+
+    bHashJoinsPrepared = TRUE;
+    if( psSelectInfo->join_count == 0 ||
+        !CSLTestBoolean(CPLGetConfigOption("OGR_SQL_HASH_JOIN", "YES")) )
+        return;
+
+    papoHashJoins = (OGRGenSQLHashJoin **)
+        CPLCalloc( sizeof(OGRGenSQLHashJoin *), psSelectInfo->join_count );
+    for( int iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++ )
+    {
+        swq_join_def *psJoinInfo = psSelectInfo->join_defs + iJoin;
+        papoHashJoins[iJoin] = OGRGenSQLHashJoin::Create(
+            psJoinInfo, poSrcLayer,
+            papoTableLayers[psJoinInfo->secondary_table] );
+    }
+}
+
 /************************************************************************/
 /*                          TranslateFeature()                          */
 /************************************************************************/
@@ -1274,6 +2957,9 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
 /* -------------------------------------------------------------------- */
     int iJoin;
 
+    if( !bHashJoinsPrepared )
+        PrepareHashJoins();
+
     for( iJoin = 0; iJoin < psSelectInfo->join_count; iJoin++ )
     {
         CPLString osFilter;
@@ -1285,6 +2971,13 @@ OGRFeature *OGRGenSQLResultsLayer::TranslateFeature( OGRFeature *poSrcFeat )
         /* we have taken care of this */
         CPLAssert(psJoinInfo->secondary_table == iJoin + 1);
 
+        if( papoHashJoins != NULL && papoHashJoins[iJoin] != NULL )
+        {
+            apoFeatures.push_back(
+                papoHashJoins[iJoin]->GetMatchingFeature( poSrcFeat ) );
+            continue;
+        }
+
         OGRLayer *poJoinLayer = papoTableLayers[psJoinInfo->secondary_table];
 
         osFilter = GetFilterForJoin(psJoinInfo->poExpr, poSrcFeat, poJoinLayer, 
@@ -1544,36 +3237,60 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
 
+    if( psSelectInfo->limit >= 0 &&
+        (nIteratedFeatures < 0 ? 0 : nIteratedFeatures) >= psSelectInfo->limit )
+        return NULL;
+
     CreateOrderByIndex();
 
+/* -------------------------------------------------------------------- */
+/*      Ordered and summary sets start at nNextIndexFID = OFFSET. The   */
+/*      OFFSET first features of other sets are skipped below.          */
+/* -------------------------------------------------------------------- */
+    GIntBig nToSkip = 0;
+    if( nIteratedFeatures < 0 )
+    {
+        nIteratedFeatures = 0;
+        if( psSelectInfo->query_mode == SWQM_RECORDSET && poSorter == NULL )
+            nToSkip = psSelectInfo->offset;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Handle summary sets.                                            */
 /* -------------------------------------------------------------------- */
     if( psSelectInfo->query_mode == SWQM_SUMMARY_RECORD 
         || psSelectInfo->query_mode == SWQM_DISTINCT_LIST )
+    {
+        nIteratedFeatures++;
         return GetFeature( nNextIndexFID++ );
-
-    int bEvaluateSpatialFilter = MustEvaluateSpatialFilterOnGenSQL();
+    }
 
 /* -------------------------------------------------------------------- */
-/*      Handle ordered sets.                                            */
+/*      Handle ordered sets. The filters were already evaluated when    */
+/*      sorting.                                                        */
 /* -------------------------------------------------------------------- */
-    while( true )
+    if( poSorter != NULL )
     {
-        OGRFeature *poFeature;
-
-        if( panFIDIndex != NULL )
-            poFeature =  GetFeature( nNextIndexFID++ );
-        else
+        OGRFeature *poFeature = poSorter->GetFeature( nNextIndexFID, poDefn );
+        if( poFeature != NULL )
         {
-            OGRFeature *poSrcFeat = poSrcLayer->GetNextFeature();
+            nNextIndexFID++;
+            nIteratedFeatures++;
+        }
+        return poFeature;
+    }
 
-            if( poSrcFeat == NULL )
-                return NULL;
+    int bEvaluateSpatialFilter = MustEvaluateSpatialFilterOnGenSQL();
 
-            poFeature = TranslateFeature( poSrcFeat );
-            delete poSrcFeat;
-        }
+    while( true )
+    {
+        OGRFeature *poSrcFeat = poSrcLayer->GetNextFeature();
+
+        if( poSrcFeat == NULL )
+            return NULL;
+
+        OGRFeature *poFeature = TranslateFeature( poSrcFeat );
+        delete poSrcFeat;
 
         if( poFeature == NULL )
             return NULL;
@@ -1582,7 +3299,14 @@ OGRFeature *OGRGenSQLResultsLayer::GetNextFeature()
             || m_poAttrQuery->Evaluate( poFeature )) &&
             (!bEvaluateSpatialFilter ||
              FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) )) )
-            return poFeature;
+        {
+            if( nToSkip == 0 )
+            {
+                nIteratedFeatures++;
+                return poFeature;
+            }
+            nToSkip--;
+        }
 
         delete poFeature;
     }
@@ -1638,16 +3362,11 @@ OGRFeature *OGRGenSQLResultsLayer::GetFeature( GIntBig nFID )
     }
 
 /* -------------------------------------------------------------------- */
-/*      Are we running in sorted mode?  If so, run the fid through      */
-/*      the index.                                                      */
+/*      Are we running in sorted mode?  If so, return the feature at    */
+/*      this position of the sorted result.                             */
 /* -------------------------------------------------------------------- */
-    if( panFIDIndex != NULL )
-    {
-        if( nFID < 0 || nFID >= nIndexSize )
-            return NULL;
-        else
-            nFID = panFIDIndex[nFID];
-    }
+    if( poSorter != NULL )
+        return poSorter->GetFeature( nFID, poDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Handle request for random record.                               */
@@ -1706,32 +3425,24 @@ OGRFeatureDefn *OGRGenSQLResultsLayer::GetLayerDefn()
 /************************************************************************/
 /*                         CreateOrderByIndex()                         */
 /*                                                                      */
-/*      This method is responsible for creating an index providing      */
-/*      ordered access to the features according to the supplied        */
-/*      ORDER BY clauses.                                               */
+/*      This method is responsible for sorting the features according   */
+/*      to the supplied ORDER BY clauses.                               */
 /*                                                                      */
 /*      This is accomplished by making one pass through all the         */
-/*      eligible source features, and capturing the order by fields     */
-/*      of all records in memory.  A quick sort is then applied to      */
-/*      this in memory copy of the order-by fields to create the        */
-/*      required index.                                                 */
-/*                                                                      */
-/*      Keeping all the key values in memory will *not* scale up to     */
-/*      very large input datasets.                                      */
+/*      eligible source features, translating them and handing them     */
+/*      with their order by fields to an OGRGenSQLSorter, that keeps    */
+/*      them in memory or spills sorted runs to a temporary file.       */
+/*      Reading the result then does not require random access to the  */
+/*      source layer.                                                   */
 /************************************************************************/
 
 void OGRGenSQLResultsLayer::CreateOrderByIndex()
 
 {
     swq_select *psSelectInfo = (swq_select *) pSelectInfo;
-    OGRField *pasIndexFields;
-    GIntBig      i;
-    int nOrderItems = psSelectInfo->order_specs;
-    GIntBig *panFIDList;
 
     if( ! (psSelectInfo->order_specs > 0
-           && psSelectInfo->query_mode == SWQM_RECORDSET
-           && nOrderItems != 0 ) )
+           && psSelectInfo->query_mode == SWQM_RECORDSET) )
         return;
 
     if( bOrderByValid )
@@ -1741,410 +3452,45 @@ void OGRGenSQLResultsLayer::CreateOrderByIndex()
 
     ResetReading();
 
-/* -------------------------------------------------------------------- */
-/*      Allocate set of key values, and the output index.               */
-/* -------------------------------------------------------------------- */
-    size_t nFeaturesAlloc = 100;
-
-    panFIDIndex = NULL;
-    pasIndexFields = (OGRField *) 
-        CPLCalloc(sizeof(OGRField), nOrderItems * nFeaturesAlloc);
-    panFIDList = (GIntBig *) CPLMalloc(sizeof(GIntBig) * nFeaturesAlloc);
+    poSorter = new OGRGenSQLSorter( psSelectInfo, poSrcLayer->GetLayerDefn(),
+                                    iFIDFieldIndex );
 
 /* -------------------------------------------------------------------- */
-/*      Read in all the key values.                                     */
+/*      Feed the sorter with the features that pass the filters of      */
+/*      this layer.                                                     */
 /* -------------------------------------------------------------------- */
+    int bEvaluateSpatialFilter = MustEvaluateSpatialFilterOnGenSQL();
+    int bOK = TRUE;
     OGRFeature *poSrcFeat;
-    nIndexSize = 0;
 
-    while( (poSrcFeat = poSrcLayer->GetNextFeature()) != NULL )
+    while( bOK && (poSrcFeat = poSrcLayer->GetNextFeature()) != NULL )
     {
-        int iKey;
-
-        if ((size_t)nIndexSize == nFeaturesAlloc)
-        {
-            GIntBig nNewFeaturesAlloc = (nFeaturesAlloc * 4) / 3;
-            if( (GIntBig)(size_t)(sizeof(OGRField) * nOrderItems * nNewFeaturesAlloc) !=
-                    (GIntBig)sizeof(OGRField) * nOrderItems * nNewFeaturesAlloc )
-            {
-                CPLError(CE_Failure, CPLE_AppDefined, "Cannot allocate pasIndexFields");
-                VSIFree(pasIndexFields);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                return;
-            }
-            OGRField* pasNewIndexFields = (OGRField *)
-                VSI_REALLOC_VERBOSE(pasIndexFields,
-                           sizeof(OGRField) * nOrderItems * (size_t)nNewFeaturesAlloc);
-            if (pasNewIndexFields == NULL)
-            {
-                CPLError(CE_Failure, CPLE_AppDefined, "Cannot allocate pasIndexFields");
-                VSIFree(pasIndexFields);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                return;
-            }
-            pasIndexFields = pasNewIndexFields;
-
-            GIntBig* panNewFIDList = (GIntBig *)
-                VSI_REALLOC_VERBOSE(panFIDList, sizeof(GIntBig) *  (size_t)nNewFeaturesAlloc);
-            if (panNewFIDList == NULL)
-            {
-                VSIFree(pasIndexFields);
-                VSIFree(panFIDList);
-                nIndexSize = 0;
-                return;
-            }
-            panFIDList = panNewFIDList;
-
-            memset(pasIndexFields + nFeaturesAlloc, 0,
-                   sizeof(OGRField) * nOrderItems * (size_t)(nNewFeaturesAlloc - nFeaturesAlloc));
-
-            nFeaturesAlloc = (size_t)nNewFeaturesAlloc;
-        }
-
-        for( iKey = 0; iKey < nOrderItems; iKey++ )
-        {
-            swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-            OGRFieldDefn *poFDefn;
-            OGRField *psSrcField, *psDstField;
-
-            psDstField = pasIndexFields + nIndexSize * nOrderItems + iKey;
-
-            if ( psKeyDef->field_index >= iFIDFieldIndex)
-            {
-                if ( psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
-                {
-                    switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
-                    {
-                      case SWQ_INTEGER:
-                        psDstField->Integer = poSrcFeat->GetFieldAsInteger(psKeyDef->field_index);
-                        break;
-
-                      case SWQ_INTEGER64:
-                        psDstField->Integer64 = poSrcFeat->GetFieldAsInteger64(psKeyDef->field_index);
-                        break;
-
-                      case SWQ_FLOAT:
-                        psDstField->Real = poSrcFeat->GetFieldAsDouble(psKeyDef->field_index);
-                        break;
+        OGRFeature *poFeature = TranslateFeature( poSrcFeat );
 
-                      default:
-                        psDstField->String = CPLStrdup( poSrcFeat->GetFieldAsString(psKeyDef->field_index) );
-                        break;
-                    }
-                }
-                continue;
-            }
-
-            poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-                psKeyDef->field_index );
-
-            psSrcField = poSrcFeat->GetRawFieldRef( psKeyDef->field_index );
-
-            if( poFDefn->GetType() == OFTInteger 
-                || poFDefn->GetType() == OFTInteger64 
-                || poFDefn->GetType() == OFTReal
-                || poFDefn->GetType() == OFTDate
-                || poFDefn->GetType() == OFTTime
-                || poFDefn->GetType() == OFTDateTime)
-                memcpy( psDstField, psSrcField, sizeof(OGRField) );
-            else if( poFDefn->GetType() == OFTString )
-            {
-                if( poSrcFeat->IsFieldSet( psKeyDef->field_index ) )
-                    psDstField->String = CPLStrdup( psSrcField->String );
-                else
-                    memcpy( psDstField, psSrcField, sizeof(OGRField) );
-            }
-        }
+        if( poFeature != NULL &&
+            (m_poAttrQuery == NULL
+             || m_poAttrQuery->Evaluate( poFeature )) &&
+            (!bEvaluateSpatialFilter ||
+             FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) )) )
+            bOK = poSorter->Add( poSrcFeat, poFeature );
 
-        panFIDList[nIndexSize] = poSrcFeat->GetFID();
+        delete poFeature;
         delete poSrcFeat;
-
-        nIndexSize++;
-    }
-
-    //CPLDebug("GenSQL", "CreateOrderByIndex() = %d features", nIndexSize);
-
-/* -------------------------------------------------------------------- */
-/*      Initialize panFIDIndex                                          */
-/* -------------------------------------------------------------------- */
-    panFIDIndex = (GIntBig *) VSI_MALLOC_VERBOSE(sizeof(GIntBig) * (size_t)nIndexSize);
-    if( panFIDIndex == NULL )
-    {
-        VSIFree(pasIndexFields);
-        VSIFree(panFIDList);
-        nIndexSize = 0;
-        return;
-    }
-    for( i = 0; i < nIndexSize; i++ )
-        panFIDIndex[i] = i;
-
-/* -------------------------------------------------------------------- */
-/*      Quick sort the records.                                         */
-/* -------------------------------------------------------------------- */
-    if( !SortIndexSection( pasIndexFields, 0, nIndexSize ) )
-    {
-        VSIFree(pasIndexFields);
-        VSIFree(panFIDList);
-        nIndexSize = 0;
-        VSIFree(panFIDIndex);
-        panFIDIndex = NULL;
-        return;
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Rework the FID map to map to real FIDs.                         */
-/* -------------------------------------------------------------------- */
-    int bAlreadySorted = TRUE;
-    for( i = 0; i < nIndexSize; i++ )
-    {
-        if (panFIDIndex[i] != i)
-            bAlreadySorted = FALSE;
-        panFIDIndex[i] = panFIDList[panFIDIndex[i]];
-    }
-
-    CPLFree( panFIDList );
-
-/* -------------------------------------------------------------------- */
-/*      Free the key field values.                                      */
-/* -------------------------------------------------------------------- */
-    for( int iKey = 0; iKey < nOrderItems; iKey++ )
-    {
-        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-        OGRFieldDefn *poFDefn;
-
-        if ( psKeyDef->field_index >= iFIDFieldIndex &&
-            psKeyDef->field_index < iFIDFieldIndex + SPECIAL_FIELD_COUNT )
-        {
-            /* warning: only special fields of type string should be deallocated */
-            if (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex] == SWQ_STRING)
-            {
-                for( i = 0; i < nIndexSize; i++ )
-                {
-                    OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
-                    CPLFree( psField->String );
-                }
-            }
-            continue;
-        }
-
-        poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-            psKeyDef->field_index );
-
-        if( poFDefn->GetType() == OFTString )
-        {
-            for( i = 0; i < nIndexSize; i++ )
-            {
-                OGRField *psField = pasIndexFields + iKey + i * nOrderItems;
-
-                if( psField->Set.nMarker1 != OGRUnsetMarker 
-                    || psField->Set.nMarker2 != OGRUnsetMarker )
-                    CPLFree( psField->String );
-            }
-        }
     }
 
-    CPLFree( pasIndexFields );
+    if( bOK )
+        bOK = poSorter->Finish();
 
-    /* If it is already sorted, then free than panFIDIndex array */
-    /* so that GetNextFeature() can call a sequential GetNextFeature() */
-    /* on the source array. Very useful for layers where random access */
-    /* is slow. */
-    /* Use case: the GML result of a WFS GetFeature with a SORTBY */
-    if (bAlreadySorted)
+    /* On failure, the features are returned unsorted */
+    if( !bOK )
     {
-        CPLFree( panFIDIndex );
-        panFIDIndex = NULL;
-
-        nIndexSize = 0;
+        delete poSorter;
+        poSorter = NULL;
     }
 
     ResetReading();
 }
 
-/************************************************************************/
-/*                          SortIndexSection()                          */
-/*                                                                      */
-/*      Sort the records in a section of the index.                     */
-/************************************************************************/
-
-int OGRGenSQLResultsLayer::SortIndexSection( OGRField *pasIndexFields, 
-                                              GIntBig nStart, GIntBig nEntries )
-
-{
-    if( nEntries < 2 )
-        return TRUE;
-
-    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
-    int      nOrderItems = psSelectInfo->order_specs;
-
-    GIntBig nFirstGroup = nEntries / 2;
-    GIntBig nFirstStart = nStart;
-    GIntBig nSecondGroup = nEntries - nFirstGroup;
-    GIntBig nSecondStart = nStart + nFirstGroup;
-    GIntBig iMerge = 0;
-    GIntBig *panMerged;
-
-    if( !SortIndexSection( pasIndexFields, nFirstStart, nFirstGroup ) ||
-        !SortIndexSection( pasIndexFields, nSecondStart, nSecondGroup ) )
-        return FALSE;
-
-    panMerged = (GIntBig *) VSI_MALLOC_VERBOSE( sizeof(GIntBig) * (size_t)nEntries );
-    if( panMerged == NULL )
-    {
-        return FALSE;
-    }
-
-    while( iMerge < nEntries )
-    {
-        int  nResult;
-
-        if( nFirstGroup == 0 )
-            nResult = -1;
-        else if( nSecondGroup == 0 )
-            nResult = 1;
-        else
-            nResult = Compare( pasIndexFields 
-                               + panFIDIndex[nFirstStart] * nOrderItems, 
-                               pasIndexFields 
-                               + panFIDIndex[nSecondStart] * nOrderItems );
-
-        if( nResult < 0 )
-        {
-            panMerged[iMerge++] = panFIDIndex[nSecondStart++];
-            nSecondGroup--;
-        }
-        else
-        {
-            panMerged[iMerge++] = panFIDIndex[nFirstStart++];
-            nFirstGroup--;
-        }
-    }
-
-    /* Copy the merge list back into the main index */
-
-    memcpy( panFIDIndex + nStart, panMerged, sizeof(GIntBig) * (size_t)nEntries );
-    CPLFree( panMerged );
-
-    return TRUE;
-}
-
-/************************************************************************/
-/*                              Compare()                               */
-/************************************************************************/
-
-int OGRGenSQLResultsLayer::Compare( OGRField *pasFirstTuple,
-                                    OGRField *pasSecondTuple )
-
-{
-    swq_select *psSelectInfo = (swq_select *) pSelectInfo;
-    int  nResult = 0, iKey;
-
-    for( iKey = 0; nResult == 0 && iKey < psSelectInfo->order_specs; iKey++ )
-    {
-        swq_order_def *psKeyDef = psSelectInfo->order_defs + iKey;
-        OGRFieldDefn *poFDefn;
-
-        if( psKeyDef->field_index >= iFIDFieldIndex + SPECIAL_FIELD_COUNT )
-        {
-            CPLAssert( FALSE );
-            return 0;
-        }
-        else if( psKeyDef->field_index >= iFIDFieldIndex )
-            poFDefn = NULL;
-        else
-            poFDefn = poSrcLayer->GetLayerDefn()->GetFieldDefn( 
-                psKeyDef->field_index );
-
-        if( pasFirstTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-             && pasFirstTuple[iKey].Set.nMarker2 == OGRUnsetMarker )
-        {
-            if( pasSecondTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-                && pasSecondTuple[iKey].Set.nMarker2 == OGRUnsetMarker )
-                nResult = 0;
-            else
-                nResult = -1;
-        }
-        else if ( pasSecondTuple[iKey].Set.nMarker1 == OGRUnsetMarker 
-                && pasSecondTuple[iKey].Set.nMarker2 == OGRUnsetMarker )
-        {
-            nResult = 1;
-        }
-        else if ( poFDefn == NULL )
-        {
-            switch (SpecialFieldTypes[psKeyDef->field_index - iFIDFieldIndex])
-            {
-              case SWQ_INTEGER:
-                if( pasFirstTuple[iKey].Integer < pasSecondTuple[iKey].Integer )
-                    nResult = -1;
-                else if( pasFirstTuple[iKey].Integer > pasSecondTuple[iKey].Integer )
-                    nResult = 1;
-                break;
-              case SWQ_INTEGER64:
-                if( pasFirstTuple[iKey].Integer64 < pasSecondTuple[iKey].Integer64 )
-                    nResult = -1;
-                else if( pasFirstTuple[iKey].Integer64 > pasSecondTuple[iKey].Integer64 )
-                    nResult = 1;
-                break;
-              case SWQ_FLOAT:
-                if( pasFirstTuple[iKey].Real < pasSecondTuple[iKey].Real )
-                    nResult = -1;
-                else if( pasFirstTuple[iKey].Real > pasSecondTuple[iKey].Real )
-                    nResult = 1;
-                break;
-              case SWQ_STRING:
-                nResult = strcmp(pasFirstTuple[iKey].String,
-                                 pasSecondTuple[iKey].String);
-                break;
-
-              default:
-                CPLAssert( FALSE );
-                nResult = 0;
-            }
-        }
-        else if( poFDefn->GetType() == OFTInteger )
-        {
-            if( pasFirstTuple[iKey].Integer < pasSecondTuple[iKey].Integer )
-                nResult = -1;
-            else if( pasFirstTuple[iKey].Integer 
-                     > pasSecondTuple[iKey].Integer )
-                nResult = 1;
-        }
-        else if( poFDefn->GetType() == OFTInteger64 )
-        {
-            if( pasFirstTuple[iKey].Integer64 < pasSecondTuple[iKey].Integer64 )
-                nResult = -1;
-            else if( pasFirstTuple[iKey].Integer64 
-                     > pasSecondTuple[iKey].Integer64 )
-                nResult = 1;
-        }
-        else if( poFDefn->GetType() == OFTString )
-            nResult = strcmp(pasFirstTuple[iKey].String,
-                             pasSecondTuple[iKey].String);
-        else if( poFDefn->GetType() == OFTReal )
-        {
-            if( pasFirstTuple[iKey].Real < pasSecondTuple[iKey].Real )
-                nResult = -1;
-            else if( pasFirstTuple[iKey].Real > pasSecondTuple[iKey].Real )
-                nResult = 1;
-        }
-        else if( poFDefn->GetType() == OFTDate ||
-                 poFDefn->GetType() == OFTTime ||
-                 poFDefn->GetType() == OFTDateTime)
-        {
-            nResult = OGRCompareDate(&pasFirstTuple[iKey],
-                                     &pasSecondTuple[iKey]);
-        }
-
-        if( psKeyDef->ascending_flag )
-            nResult *= -1;
-    }
-
-    return nResult;
-}
-
-
 /************************************************************************/
 /*                         AddFieldDefnToSet()                          */
 /************************************************************************/
@@ -2252,10 +3598,9 @@ void OGRGenSQLResultsLayer::FindAndSetIgnoredFields()
 
 void OGRGenSQLResultsLayer::InvalidateOrderByIndex()
 {
-    CPLFree( panFIDIndex );
-    panFIDIndex = NULL;
+    delete poSorter;
+    poSorter = NULL;
 
-    nIndexSize = 0;
     bOrderByValid = FALSE;
 }
 
@@ -45,6 +45,9 @@
 #define ALL_FIELD_INDEX_TO_GEOM_FIELD_INDEX(poFDefn, idx) \
     ((idx) - ((poFDefn)->GetFieldCount() + SPECIAL_FIELD_COUNT))
 
+class OGRGenSQLHashJoin;
+class OGRGenSQLSorter;
+
 /************************************************************************/
 /*                        OGRGenSQLResultsLayer                         */
 /************************************************************************/
@@ -64,11 +67,11 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
 
     int        *panGeomFieldToSrcGeomField;
 
-    GIntBig     nIndexSize;
-    GIntBig    *panFIDIndex;
+    OGRGenSQLSorter *poSorter;
     int         bOrderByValid;
 
     GIntBig      nNextIndexFID;
+    GIntBig      nIteratedFeatures;
     OGRFeature  *poSummaryFeature;
 
     int         iFIDFieldIndex;
@@ -76,13 +79,14 @@ class CPL_DLL OGRGenSQLResultsLayer : public OGRLayer
     int         nExtraDSCount;
     GDALDataset **papoExtraDS;
 
+    int         bHashJoinsPrepared;
+    OGRGenSQLHashJoin **papoHashJoins;
+
     int         PrepareSummary();
 
     OGRFeature *TranslateFeature( OGRFeature * );
+    void        PrepareHashJoins();
     void        CreateOrderByIndex();
-    int         SortIndexSection( OGRField *pasIndexFields, 
-                                  GIntBig nStart, GIntBig nEntries );
-    int         Compare( OGRField *pasFirst, OGRField *pasSecond );
 
     void        ClearFilters();
     void        ApplyFiltersToSource();
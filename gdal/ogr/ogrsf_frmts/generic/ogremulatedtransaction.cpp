@@ -64,6 +64,10 @@ class OGRLayerWithTransaction: public OGRLayerDecorator
 
     virtual OGRFeature *GetNextFeature();
     virtual OGRFeature *GetFeature( GIntBig nFID );
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+                { return OGRLayer::GetNextFeatureBatch(poBatch); }
+    virtual void        RecycleFeature( OGRFeature *poFeature )
+                { OGRLayer::RecycleFeature(poFeature); }
     virtual OGRErr      ISetFeature( OGRFeature *poFeature );
     virtual OGRErr      ICreateFeature( OGRFeature *poFeature );
 
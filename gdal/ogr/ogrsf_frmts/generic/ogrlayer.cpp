@@ -56,6 +56,9 @@ OGRLayer::OGRLayer()
     m_bFilterIsEnvelope = FALSE;
     m_pPreparedFilterGeom = NULL;
     m_iGeomFieldFilter = 0;
+
+    m_poRecycledFeature = NULL;
+    m_poRecycledGeometry = NULL;
 }
 
 /************************************************************************/
@@ -96,6 +99,9 @@ OGRLayer::~OGRLayer()
         OGRDestroyPreparedGeometry(m_pPreparedFilterGeom);
         m_pPreparedFilterGeom = NULL;
     }
+
+    OGRFeature::DestroyFeature( m_poRecycledFeature );
+    delete m_poRecycledGeometry;
 }
 
 /************************************************************************/
@@ -550,6 +556,187 @@ OGRFeatureH OGR_L_GetNextFeature( OGRLayerH hLayer )
     return (OGRFeatureH) ((OGRLayer *)hLayer)->GetNextFeature();
 }
 
+/************************************************************************/
+/*                      IsFeatureBatchCompatible()                      */
+/************************************************************************/
+
+int OGRLayer::IsFeatureBatchCompatible( OGRFeatureBatch *poBatch )
+{
+    if( poBatch->GetDefnRef() != GetLayerDefn() )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined,
+                 "Feature batch was not created from the definition of "
+                 "layer %s", GetName());
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+/**
+ \brief Fetch the next available features from this layer into a columnar
+ buffer.
+
+ The batch is cleared, and then filled with up to poBatch->GetCapacity()
+ features, read as GetNextFeature() would.  The batch must have been
+ created from the layer definition returned by GetLayerDefn().
+
+ The default implementation calls GetNextFeature() for each feature.
+ Drivers may override it to fill the batch without instantiating
+ OGRFeature objects.
+
+ Calls to GetNextFeature() and GetNextFeatureBatch() can be freely mixed.
+
+ This method is the same as the C function OGR_L_GetNextFeatureBatch().
+
+ @param poBatch the batch to fill.
+ @return the number of features read, 0 if no more features are available.
+ @since GDAL 2.1
+*/
+
+int OGRLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+
+{
+    poBatch->Clear();
+    if( !IsFeatureBatchCompatible(poBatch) )
+        return 0;
+
+    while( !poBatch->IsFull() )
+    {
+        OGRFeature* poFeature = GetNextFeature();
+        if( poFeature == NULL )
+            break;
+        poBatch->AddFeature(poFeature);
+        RecycleFeature(poFeature);
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
+/************************************************************************/
+/*                     OGR_L_GetNextFeatureBatch()                      */
+/************************************************************************/
+
+/**
+ \brief Fetch the next available features from this layer into a columnar
+ buffer.
+
+ This function is the same as the C++ method OGRLayer::GetNextFeatureBatch().
+
+ @param hLayer handle to the layer from which feature are read.
+ @param hBatch batch created with OGR_FB_Create() from the layer definition.
+ @return the number of features read, 0 if no more features are available.
+ @since GDAL 2.1
+*/
+
+int OGR_L_GetNextFeatureBatch( OGRLayerH hLayer, OGRFeatureBatchH hBatch )
+
+{
+    VALIDATE_POINTER1( hLayer, "OGR_L_GetNextFeatureBatch", 0 );
+    VALIDATE_POINTER1( hBatch, "OGR_L_GetNextFeatureBatch", 0 );
+
+    return ((OGRLayer *)hLayer)->GetNextFeatureBatch(
+                                                (OGRFeatureBatch*)hBatch );
+}
+
+/************************************************************************/
+/*                           RecycleFeature()                           */
+/************************************************************************/
+
+/**
+ \brief Hand a feature back to the layer so that its storage is reused.
+
+ This can be called instead of deleting a feature returned by
+ GetNextFeature() or GetFeature() once the caller is done with it.
+ The layer takes ownership of the feature. Drivers that support it fill
+ the recycled feature with the next row instead of allocating a new one:
+ the field array and the string buffers of the feature are kept, and the
+ coordinate arrays of its geometry are overwritten in place when the
+ next geometry has the same type. A sequential scan that recycles each
+ feature thus runs mostly without heap allocations.
+
+ The layer keeps at most one recycled feature. Features that were not
+ created from the layer definition are simply destroyed.
+
+ This method is the same as the C function OGR_L_RecycleFeature().
+
+ @param poFeature the feature to recycle, or NULL.
+ @since GDAL 2.1
+*/
+
+void OGRLayer::RecycleFeature( OGRFeature *poFeature )
+
+{
+    if( poFeature == NULL )
+        return;
+
+    if( m_poRecycledFeature != NULL
+        || poFeature->GetDefnRef() != GetLayerDefn() )
+    {
+        OGRFeature::DestroyFeature( poFeature );
+        return;
+    }
+
+    // Fields are released now, while they still match the layer definition.
+    // The first geometry is put aside for drivers that can reuse it.
+    if( poFeature->GetGeomFieldCount() > 0 )
+    {
+        delete m_poRecycledGeometry;
+        m_poRecycledGeometry = poFeature->StealGeometry(0);
+    }
+    poFeature->Reset();
+    m_poRecycledFeature = poFeature;
+}
+
+/************************************************************************/
+/*                        OGR_L_RecycleFeature()                        */
+/************************************************************************/
+
+/**
+ \brief Hand a feature back to the layer so that its storage is reused.
+
+ This function is the same as the C++ method OGRLayer::RecycleFeature().
+
+ @param hLayer handle to the layer from which the feature was read.
+ @param hFeat handle to the feature to recycle, or NULL.
+ @since GDAL 2.1
+*/
+
+void OGR_L_RecycleFeature( OGRLayerH hLayer, OGRFeatureH hFeat )
+
+{
+    VALIDATE_POINTER0( hLayer, "OGR_L_RecycleFeature" );
+
+    ((OGRLayer *)hLayer)->RecycleFeature( (OGRFeature*) hFeat );
+}
+
+/************************************************************************/
+/*                         GetRecycledFeature()                         */
+/*                                                                      */
+/*      Return the feature handed back with RecycleFeature(), in its    */
+/*      reset state, or NULL. If ppoGeometry is not NULL, it receives   */
+/*      the first geometry of that feature, or NULL, to be overwritten  */
+/*      by the driver. The caller takes ownership of both.              */
+/************************************************************************/
+
+OGRFeature *OGRLayer::GetRecycledFeature( OGRGeometry **ppoGeometry )
+
+{
+    OGRFeature *poFeature = m_poRecycledFeature;
+    m_poRecycledFeature = NULL;
+
+    if( ppoGeometry != NULL )
+        *ppoGeometry = m_poRecycledGeometry;
+    else
+        delete m_poRecycledGeometry;
+    m_poRecycledGeometry = NULL;
+
+    return poFeature;
+}
+
 /************************************************************************/
 /*                    ConvertNonLinearGeomsIfNecessary()                */
 /************************************************************************/
@@ -97,6 +97,18 @@ OGRFeature *OGRLayerDecorator::GetNextFeature()
     return m_poDecoratedLayer->GetNextFeature();
 }
 
+int OGRLayerDecorator::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    if( !m_poDecoratedLayer ) return 0;
+    return m_poDecoratedLayer->GetNextFeatureBatch(poBatch);
+}
+
+void OGRLayerDecorator::RecycleFeature( OGRFeature *poFeature )
+{
+    if( !m_poDecoratedLayer ) { delete poFeature; return; }
+    m_poDecoratedLayer->RecycleFeature(poFeature);
+}
+
 OGRErr      OGRLayerDecorator::SetNextByIndex( GIntBig nIndex )
 {
     if( !m_poDecoratedLayer ) return OGRERR_FAILURE;
@@ -291,6 +291,30 @@ OGRFeature *OGRProxiedLayer::GetNextFeature()
     return poUnderlyingLayer->GetNextFeature();
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRProxiedLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    if( poUnderlyingLayer == NULL && !OpenUnderlyingLayer() ) return 0;
+    /* The underlying layer may have been reopened with a new definition */
+    if( poBatch->GetDefnRef() != poUnderlyingLayer->GetLayerDefn() )
+        return OGRLayer::GetNextFeatureBatch(poBatch);
+    return poUnderlyingLayer->GetNextFeatureBatch(poBatch);
+}
+
+/************************************************************************/
+/*                           RecycleFeature()                           */
+/************************************************************************/
+
+void OGRProxiedLayer::RecycleFeature( OGRFeature *poFeature )
+{
+    /* Do not reopen the underlying layer just for that */
+    if( poUnderlyingLayer == NULL ) { delete poFeature; return; }
+    poUnderlyingLayer->RecycleFeature(poFeature);
+}
+
 /************************************************************************/
 /*                           SetNextByIndex()                           */
 /************************************************************************/
@@ -95,6 +95,18 @@ OGRFeature *OGRMutexedLayer::GetNextFeature()
     return OGRLayerDecorator::GetNextFeature();
 }
 
+int OGRMutexedLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    CPLMutexHolderOptionalLockD(m_hMutex);
+    return OGRLayerDecorator::GetNextFeatureBatch(poBatch);
+}
+
+void OGRMutexedLayer::RecycleFeature( OGRFeature *poFeature )
+{
+    CPLMutexHolderOptionalLockD(m_hMutex);
+    OGRLayerDecorator::RecycleFeature(poFeature);
+}
+
 OGRErr      OGRMutexedLayer::SetNextByIndex( GIntBig nIndex )
 {
     CPLMutexHolderOptionalLockD(m_hMutex);
@@ -74,6 +74,10 @@ class OGRWarpedLayer : public OGRLayerDecorator
 
     virtual OGRFeature *GetNextFeature();
     virtual OGRFeature *GetFeature( GIntBig nFID );
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+                { return OGRLayer::GetNextFeatureBatch(poBatch); }
+    virtual void        RecycleFeature( OGRFeature *poFeature )
+                { OGRLayer::RecycleFeature(poFeature); }
     virtual OGRErr      ISetFeature( OGRFeature *poFeature );
     virtual OGRErr      ICreateFeature( OGRFeature *poFeature );
 
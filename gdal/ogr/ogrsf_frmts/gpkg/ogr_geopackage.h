@@ -313,12 +313,14 @@ class OGRGeoPackageLayer : public OGRLayer, public IOGRSQLiteGetSpatialWhere
 
     sqlite3_stmt        *m_poQueryStatement;
     int                  bDoStep;
+    int                  m_bEOF;
 
     char                *m_pszFidColumn;
 
     int                 iFIDCol;
     int                 iGeomCol;
     int                *panFieldOrdinals;
+    int                 m_iFIDAsRegularColumnIndex;
 
     void                ClearStatement();
     virtual OGRErr      ResetStatement() = 0;
@@ -327,6 +329,8 @@ class OGRGeoPackageLayer : public OGRLayer, public IOGRSQLiteGetSpatialWhere
                                            sqlite3_stmt *hStmt );
 
     OGRFeature*         TranslateFeature(sqlite3_stmt* hStmt);
+    void                TranslateFeatureToBatch(sqlite3_stmt* hStmt,
+                                                OGRFeatureBatch* poBatch);
 
   public:
 
@@ -336,6 +340,7 @@ class OGRGeoPackageLayer : public OGRLayer, public IOGRSQLiteGetSpatialWhere
     /* OGR API methods */
 
     OGRFeature*         GetNextFeature();
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch );
     const char*         GetFIDColumn();
     void                ResetReading();
     int                 TestCapability( const char * );
@@ -370,7 +375,6 @@ class OGRGeoPackageTableLayer : public OGRGeoPackageLayer
     int                         m_bPreservePrecision;
     int                         m_bTruncateFields;
     int                         m_bDeferredCreation;
-    int                         m_iFIDAsRegularColumnIndex;
 
     CPLString                   m_osIdentifierLCO;
     CPLString                   m_osDescriptionLCO;
@@ -405,6 +409,7 @@ class OGRGeoPackageTableLayer : public OGRGeoPackageLayer
     OGRErr              SetAttributeFilter( const char *pszQuery );
     OGRErr              SyncToDisk();
     OGRFeature*         GetNextFeature();
+    int                 GetNextFeatureBatch( OGRFeatureBatch *poBatch );
     OGRFeature*         GetFeature(GIntBig nFID);
     OGRErr              StartTransaction();
     OGRErr              CommitTransaction();
@@ -493,6 +498,8 @@ class OGRGeoPackageSelectLayer : public OGRGeoPackageLayer, public IOGRSQLiteSel
     virtual void        ResetReading();
 
     virtual OGRFeature *GetNextFeature();
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+                { return OGRLayer::GetNextFeatureBatch(poBatch); }
     virtual GIntBig     GetFeatureCount( int );
 
     virtual void        SetSpatialFilter( OGRGeometry * poGeom ) { SetSpatialFilter(0, poGeom); }
@@ -42,10 +42,12 @@ OGRGeoPackageLayer::OGRGeoPackageLayer(GDALGeoPackageDataset *poDS) :
     iNextShapeId(0),
     m_poQueryStatement(NULL),
     bDoStep(TRUE),
+    m_bEOF(FALSE),
     m_pszFidColumn(NULL),
     iFIDCol(-1),
     iGeomCol(-1),
-    panFieldOrdinals(NULL)
+    panFieldOrdinals(NULL),
+    m_iFIDAsRegularColumnIndex(-1)
 {
 }
 
@@ -77,6 +79,7 @@ void OGRGeoPackageLayer::ResetReading()
 {
     ClearStatement();
     iNextShapeId = 0;
+    m_bEOF = FALSE;
 }
 
 /************************************************************************/
@@ -101,6 +104,9 @@ void OGRGeoPackageLayer::ClearStatement()
 OGRFeature *OGRGeoPackageLayer::GetNextFeature()
 
 {
+    if( m_bEOF )
+        return NULL;
+
     for( ; true; )
     {
         OGRFeature      *poFeature;
@@ -131,6 +137,7 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
                 }
 
                 ClearStatement();
+                m_bEOF = TRUE;
 
                 return NULL;
             }
@@ -152,6 +159,60 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
     }
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRGeoPackageLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+
+{
+    poBatch->Clear();
+    if( !IsFeatureBatchCompatible(poBatch) )
+        return 0;
+
+    /* Filters are evaluated against OGRFeature objects */
+    if( m_poFilterGeom != NULL || m_poAttrQuery != NULL )
+        return OGRLayer::GetNextFeatureBatch(poBatch);
+
+    if( m_bEOF )
+        return 0;
+
+    if( m_poQueryStatement == NULL )
+    {
+        ResetStatement();
+        if (m_poQueryStatement == NULL)
+            return 0;
+    }
+
+    while( !poBatch->IsFull() )
+    {
+        if( bDoStep )
+        {
+            int rc = sqlite3_step( m_poQueryStatement );
+            if( rc != SQLITE_ROW )
+            {
+                if ( rc != SQLITE_DONE )
+                {
+                    sqlite3_reset(m_poQueryStatement);
+                    CPLError( CE_Failure, CPLE_AppDefined,
+                            "In GetNextFeatureBatch(): sqlite3_step() : %s",
+                            sqlite3_errmsg(m_poDS->GetDB()) );
+                }
+
+                ClearStatement();
+                m_bEOF = TRUE;
+                break;
+            }
+        }
+        else
+            bDoStep = TRUE;
+
+        TranslateFeatureToBatch(m_poQueryStatement, poBatch);
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /************************************************************************/
 /*                         TranslateFeature()                           */
 /************************************************************************/
@@ -274,6 +335,142 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
     return poFeature;
 }
 
+/************************************************************************/
+/*                      TranslateFeatureToBatch()                       */
+/*                                                                      */
+/*      Same as TranslateFeature(), but appends the current row to a    */
+/*      feature batch. The WKB part of GeoPackage geometry blobs is     */
+/*      copied as it is when it is already ISO WKB in the native byte   */
+/*      order (see OGRFeatureBatch::SetGeomFieldWkb()).                 */
+/************************************************************************/
+
+void OGRGeoPackageLayer::TranslateFeatureToBatch( sqlite3_stmt* hStmt,
+                                                  OGRFeatureBatch* poBatch )
+
+{
+    const GIntBig nFID = ( iFIDCol >= 0 ) ?
+        sqlite3_column_int64( hStmt, iFIDCol ) : iNextShapeId;
+    poBatch->AddFeature( nFID );
+
+    iNextShapeId++;
+
+    m_nFeaturesRead++;
+
+/* -------------------------------------------------------------------- */
+/*      Process Geometry if we have a column.                           */
+/* -------------------------------------------------------------------- */
+    if( iGeomCol >= 0 &&
+        sqlite3_column_type(hStmt, iGeomCol) != SQLITE_NULL &&
+        !m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() )
+    {
+        const int iGpkgSize = sqlite3_column_bytes(hStmt, iGeomCol);
+        const GByte *pabyGpkg = (const GByte *)sqlite3_column_blob(hStmt, iGeomCol);
+        GPkgHeader oHeader;
+        if( iGpkgSize >= 8 &&
+            GPkgHeaderFromWKB(pabyGpkg, &oHeader) == OGRERR_NONE &&
+            (size_t)iGpkgSize > oHeader.szHeader )
+        {
+            poBatch->SetGeomFieldWkb( 0, pabyGpkg + oHeader.szHeader,
+                                      iGpkgSize - oHeader.szHeader );
+        }
+        else
+        {
+            // Try also spatialite geometry blobs
+            OGRGeometry *poGeom = NULL;
+            if( OGRSQLiteLayer::ImportSpatiaLiteGeometry( pabyGpkg, iGpkgSize,
+                                                          &poGeom ) != OGRERR_NONE )
+            {
+                CPLError( CE_Failure, CPLE_AppDefined, "Unable to read geometry");
+            }
+            poBatch->SetGeomField( 0, poGeom );
+            delete poGeom;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      set the fields.                                                 */
+/* -------------------------------------------------------------------- */
+    for( int iField = 0; iField < m_poFeatureDefn->GetFieldCount(); iField++ )
+    {
+        OGRFieldDefn *poFieldDefn = m_poFeatureDefn->GetFieldDefn( iField );
+        if ( poFieldDefn->IsIgnored() )
+            continue;
+
+        if( iField == m_iFIDAsRegularColumnIndex )
+        {
+            poBatch->SetFieldInteger64( iField, nFID );
+            continue;
+        }
+
+        const int iRawField = panFieldOrdinals[iField];
+
+        if( sqlite3_column_type( hStmt, iRawField ) == SQLITE_NULL )
+            continue;
+
+        switch( poFieldDefn->GetType() )
+        {
+            case OFTInteger:
+                poBatch->SetFieldInteger( iField,
+                    sqlite3_column_int( hStmt, iRawField ) );
+                break;
+
+            case OFTInteger64:
+                poBatch->SetFieldInteger64( iField,
+                    sqlite3_column_int64( hStmt, iRawField ) );
+                break;
+
+            case OFTReal:
+                poBatch->SetFieldDouble( iField,
+                    sqlite3_column_double( hStmt, iRawField ) );
+                break;
+
+            case OFTBinary:
+            {
+                const GByte* pabyData = (const GByte*)sqlite3_column_blob( hStmt, iRawField );
+                poBatch->SetFieldBinary( iField, pabyData,
+                                    sqlite3_column_bytes( hStmt, iRawField ) );
+                break;
+            }
+
+            case OFTDate:
+            {
+                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
+                int nYear, nMonth, nDay;
+                if( sscanf(pszTxt, "%d-%d-%d", &nYear, &nMonth, &nDay) == 3 )
+                {
+                    OGRField sField;
+                    memset(&sField, 0, sizeof(sField));
+                    sField.Date.Year = (GInt16)nYear;
+                    sField.Date.Month = (GByte)nMonth;
+                    sField.Date.Day = (GByte)nDay;
+                    poBatch->SetField( iField, &sField );
+                }
+                break;
+            }
+
+            case OFTDateTime:
+            {
+                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
+                OGRField sField;
+                if( OGRParseXMLDateTime(pszTxt, &sField) )
+                    poBatch->SetField( iField, &sField );
+                break;
+            }
+
+            case OFTString:
+            {
+                const char* pszTxt = (const char*)sqlite3_column_text( hStmt, iRawField );
+                poBatch->SetFieldString( iField, pszTxt,
+                                    sqlite3_column_bytes( hStmt, iRawField ) );
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
 /************************************************************************/
 /*                      GetFIDColumn()                                  */
 /************************************************************************/
@@ -861,7 +861,6 @@ OGRGeoPackageTableLayer::OGRGeoPackageTableLayer(
     m_bPreservePrecision = TRUE;
     m_bTruncateFields = FALSE;
     m_bDeferredCreation = FALSE;
-    m_iFIDAsRegularColumnIndex = -1;
     m_bHasReadMetadataFromStorage = FALSE;
 }
 
@@ -1466,6 +1465,23 @@ OGRFeature* OGRGeoPackageTableLayer::GetNextFeature()
     return poFeature;
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRGeoPackageTableLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    if( m_bDeferredCreation && RunDeferredCreationIfNecessary() != OGRERR_NONE )
+    {
+        poBatch->Clear();
+        return 0;
+    }
+
+    CreateSpatialIndexIfNecessary();
+
+    return OGRGeoPackageLayer::GetNextFeatureBatch(poBatch);
+}
+
 /************************************************************************/
 /*                        GetFeature()                                  */
 /************************************************************************/
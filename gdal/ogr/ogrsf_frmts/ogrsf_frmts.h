@@ -82,6 +82,9 @@ class CPL_DLL OGRLayer : public GDALMajorObject
 
     OGRErr       GetExtentInternal(int iGeomField, OGREnvelope *psExtent, int bForce );
 
+    int          IsFeatureBatchCompatible( OGRFeatureBatch *poBatch );
+    OGRFeature  *GetRecycledFeature( OGRGeometry **ppoGeometry = NULL );
+
     virtual OGRErr      ISetFeature( OGRFeature *poFeature ) CPL_WARN_UNUSED_RESULT;
     virtual OGRErr      ICreateFeature( OGRFeature *poFeature )  CPL_WARN_UNUSED_RESULT;
 
@@ -105,6 +108,8 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     virtual OGRFeature *GetNextFeature() CPL_WARN_UNUSED_RESULT = 0;
     virtual OGRErr      SetNextByIndex( GIntBig nIndex );
     virtual OGRFeature *GetFeature( GIntBig nFID )  CPL_WARN_UNUSED_RESULT;
+    virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch );
+    virtual void        RecycleFeature( OGRFeature *poFeature );
 
     OGRErr      SetFeature( OGRFeature *poFeature )  CPL_WARN_UNUSED_RESULT;
     OGRErr      CreateFeature( OGRFeature *poFeature ) CPL_WARN_UNUSED_RESULT;
@@ -210,6 +215,10 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     int                  m_nRefCount;
 
     GIntBig              m_nFeaturesRead;
+
+  private:
+    OGRFeature          *m_poRecycledFeature;
+    OGRGeometry         *m_poRecycledGeometry;
 };
 
 /************************************************************************/
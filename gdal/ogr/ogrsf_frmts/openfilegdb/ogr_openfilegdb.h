@@ -75,6 +75,10 @@ class OGROpenFileGDBLayer : public OGRLayer
     int               BuildLayerDefinition();
     int               BuildGeometryColumnGDBv10();
     OGRFeature       *GetCurrentFeature();
+    void              InsertInSpatialIndexIfBuilding( const OGRField* psGeomField,
+                                                      int iRow );
+    OGRGeometry      *ReadGeometry( const OGRField* psGeomField );
+    void              AddCurrentRowToBatch( OGRFeatureBatch* poBatch );
 
     FileGDBOGRGeometryConverter* m_poGeomConverter;
 
@@ -127,6 +131,7 @@ public:
 
   virtual void        ResetReading();
   virtual OGRFeature* GetNextFeature();
+  virtual int         GetNextFeatureBatch( OGRFeatureBatch *poBatch );
   virtual OGRFeature* GetFeature( GIntBig nFeatureId );
   virtual OGRErr      SetNextByIndex( GIntBig nIndex );
 
@@ -1242,6 +1242,50 @@ OGRErr OGROpenFileGDBLayer::SetAttributeFilter( const char* pszFilter )
     return eErr;
 }
 
+/***********************************************************************/
+/*                  InsertInSpatialIndexIfBuilding()                   */
+/***********************************************************************/
+
+void OGROpenFileGDBLayer::InsertInSpatialIndexIfBuilding(
+                                    const OGRField* psGeomField, int iRow )
+{
+    if( m_eSpatialIndexState != SPI_IN_BUILDING )
+        return;
+
+    OGREnvelope sFeatureEnvelope;
+    if( m_poLyrTable->GetFeatureExtent(psGeomField, &sFeatureEnvelope) )
+    {
+        CPLRectObj sBounds;
+        sBounds.minx = sFeatureEnvelope.MinX;
+        sBounds.miny = sFeatureEnvelope.MinY;
+        sBounds.maxx = sFeatureEnvelope.MaxX;
+        sBounds.maxy = sFeatureEnvelope.MaxY;
+        CPLQuadTreeInsertWithBounds(m_pQuadTree, (void*)(size_t)iRow,
+                                    &sBounds);
+    }
+}
+
+/***********************************************************************/
+/*                            ReadGeometry()                           */
+/*                                                                     */
+/*      Convert a geometry field value to the geometry type of the     */
+/*      layer (polygons and linestrings are promoted to multi).        */
+/***********************************************************************/
+
+OGRGeometry* OGROpenFileGDBLayer::ReadGeometry( const OGRField* psGeomField )
+{
+    OGRGeometry* poGeom = m_poGeomConverter->GetAsGeometry(psGeomField);
+    if( poGeom != NULL )
+    {
+        OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
+        if( eFlattenType == wkbPolygon )
+            poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
+        else if( eFlattenType == wkbLineString )
+            poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
+    }
+    return poGeom;
+}
+
 /***********************************************************************/
 /*                         GetCurrentFeature()                         */
 /***********************************************************************/
@@ -1265,22 +1309,7 @@ OGRFeature* OGROpenFileGDBLayer::GetCurrentFeature()
             const OGRField* psField = m_poLyrTable->GetFieldValue(iGDBIdx);
             if( psField != NULL )
             {
-                if( m_eSpatialIndexState == SPI_IN_BUILDING )
-                {
-                    OGREnvelope sFeatureEnvelope;
-                    if( m_poLyrTable->GetFeatureExtent(psField,
-                                                       &sFeatureEnvelope) )
-                    {
-                        CPLRectObj sBounds;
-                        sBounds.minx = sFeatureEnvelope.MinX;
-                        sBounds.miny = sFeatureEnvelope.MinY;
-                        sBounds.maxx = sFeatureEnvelope.MaxX;
-                        sBounds.maxy = sFeatureEnvelope.MaxY;
-                        CPLQuadTreeInsertWithBounds(m_pQuadTree,
-                                                    (void*)(size_t)iRow,
-                                                    &sBounds);
-                    }
-                }
+                InsertInSpatialIndexIfBuilding(psField, iRow);
 
                 if( m_poFilterGeom != NULL &&
                     m_eSpatialIndexState != SPI_COMPLETED &&
@@ -1290,14 +1319,9 @@ OGRFeature* OGROpenFileGDBLayer::GetCurrentFeature()
                     return NULL;
                 }
 
-                OGRGeometry* poGeom = m_poGeomConverter->GetAsGeometry(psField);
+                OGRGeometry* poGeom = ReadGeometry(psField);
                 if( poGeom != NULL )
                 {
-                    OGRwkbGeometryType eFlattenType = wkbFlatten(poGeom->getGeometryType());
-                    if( eFlattenType == wkbPolygon )
-                        poGeom = OGRGeometryFactory::forceToMultiPolygon(poGeom);
-                    else if( eFlattenType == wkbLineString )
-                        poGeom = OGRGeometryFactory::forceToMultiLineString(poGeom);
                     poGeom->assignSpatialReference(
                         m_poFeatureDefn->GetGeomFieldDefn(0)->GetSpatialRef() );
 
@@ -1438,6 +1462,104 @@ OGRFeature* OGROpenFileGDBLayer::GetNextFeature()
     }
 }
 
+/***********************************************************************/
+/*                       AddCurrentRowToBatch()                        */
+/*                                                                     */
+/*      Same as GetCurrentFeature() when no filter is set, but appends */
+/*      the row to a feature batch.                                    */
+/***********************************************************************/
+
+void OGROpenFileGDBLayer::AddCurrentRowToBatch( OGRFeatureBatch* poBatch )
+{
+    int iOGRIdx = 0;
+    int iRow = m_poLyrTable->GetCurRow();
+    poBatch->AddFeature( iRow + 1 );
+    for(int iGDBIdx=0;iGDBIdx<m_poLyrTable->GetFieldCount();iGDBIdx++)
+    {
+        if( iGDBIdx == m_iGeomFieldIdx )
+        {
+            if( m_poFeatureDefn->GetGeomFieldDefn(0)->IsIgnored() )
+            {
+                if( m_eSpatialIndexState == SPI_IN_BUILDING )
+                    m_eSpatialIndexState = SPI_INVALID;
+                continue;
+            }
+
+            const OGRField* psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+            if( psField != NULL )
+            {
+                InsertInSpatialIndexIfBuilding(psField, iRow);
+
+                OGRGeometry* poGeom = ReadGeometry(psField);
+                if( poGeom != NULL )
+                {
+                    poBatch->SetGeomField( 0, poGeom );
+                    delete poGeom;
+                }
+            }
+        }
+        else
+        {
+            if( !m_poFeatureDefn->GetFieldDefn(iOGRIdx)->IsIgnored() )
+            {
+                const OGRField* psField = m_poLyrTable->GetFieldValue(iGDBIdx);
+                if( psField != NULL )
+                {
+                    if( iGDBIdx == m_iFieldToReadAsBinary )
+                        poBatch->SetFieldString(iOGRIdx, (const char*) psField->Binary.paData);
+                    else
+                        poBatch->SetField(iOGRIdx, psField);
+                }
+            }
+            iOGRIdx ++;
+        }
+    }
+
+    if( m_poLyrTable->HasDeletedFeaturesListed() )
+    {
+        poBatch->SetFieldInteger(m_poFeatureDefn->GetFieldCount() - 1,
+                                 m_poLyrTable->IsCurRowDeleted());
+    }
+}
+
+/***********************************************************************/
+/*                       GetNextFeatureBatch()                         */
+/***********************************************************************/
+
+int OGROpenFileGDBLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+{
+    poBatch->Clear();
+    if( !BuildLayerDefinition() || !IsFeatureBatchCompatible(poBatch) )
+        return 0;
+
+    /* Filtered reads go through GetNextFeature() */
+    if( m_nFilteredFeatureCount >= 0 || m_poIterator != NULL ||
+        m_poFilterGeom != NULL || m_poAttrQuery != NULL )
+        return OGRLayer::GetNextFeatureBatch(poBatch);
+
+    while( !m_bEOF && !poBatch->IsFull() )
+    {
+        if( m_iCurFeat == m_poLyrTable->GetTotalRecordCount() )
+            break;
+        m_iCurFeat = m_poLyrTable->GetAndSelectNextNonEmptyRow(m_iCurFeat);
+        if( m_iCurFeat < 0 )
+        {
+            m_bEOF = TRUE;
+            break;
+        }
+        m_iCurFeat ++;
+        AddCurrentRowToBatch(poBatch);
+        if( m_eSpatialIndexState == SPI_IN_BUILDING &&
+            m_iCurFeat == m_poLyrTable->GetTotalRecordCount() )
+        {
+            CPLDebug("OpenFileGDB", "SPI_COMPLETED");
+            m_eSpatialIndexState = SPI_COMPLETED;
+        }
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /***********************************************************************/
 /*                          GetFeature()                               */
 /***********************************************************************/
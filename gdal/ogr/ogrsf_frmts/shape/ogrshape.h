@@ -49,8 +49,15 @@
 /* ==================================================================== */
 OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape, 
-                               SHPObject *psShape, const char *pszSHPEncoding );
-OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape );
+                               SHPObject *psShape, const char *pszSHPEncoding,
+                               OGRFeature *poFeatureToReuse = NULL,
+                               OGRGeometry *poGeomToReuse = NULL );
+OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape,
+                               OGRGeometry *poGeomToReuse = NULL );
+int SHPReadOGRFeatureToBatch( SHPHandle hSHP, DBFHandle hDBF,
+                              OGRFeatureDefn * poDefn, int iShape,
+                              const char *pszSHPEncoding,
+                              OGRFeatureBatch* poBatch );
 OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
                                        SHPHandle hSHP, DBFHandle hDBF,
                                        const char *pszSHPEncoding,
@@ -174,6 +181,7 @@ class OGRShapeLayer : public OGRAbstractProxiedLayer
     const char         *GetFullName() { return pszFullName; }
 
     OGRFeature *        FetchShape(int iShapeId);
+    OGRFeature *        ReadFeature(int iShapeId, SHPObject *psShape);
     int                 GetFeatureCountWithSpatialFilterOnly();
 
   public:
@@ -188,6 +196,7 @@ class OGRShapeLayer : public OGRAbstractProxiedLayer
 
     void                ResetReading();
     OGRFeature *        GetNextFeature();
+    int                 GetNextFeatureBatch( OGRFeatureBatch *poBatch );
     virtual OGRErr      SetNextByIndex( GIntBig nIndex );
 
     OGRFeature         *GetFeature( GIntBig nFeatureId );
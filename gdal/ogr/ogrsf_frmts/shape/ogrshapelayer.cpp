@@ -680,8 +680,7 @@ OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExten
                  || psShape->dfYMin == psShape->dfYMax))
             || psShape->nSHPType == SHPT_NULL )
         {
-            poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                           iShapeId, psShape, osEncoding );
+            poFeature = ReadFeature( iShapeId, psShape );
         }
         else if( m_sFilterEnvelope.MaxX < psShape->dfXMin 
                  || m_sFilterEnvelope.MaxY < psShape->dfYMin
@@ -697,19 +696,34 @@ OGRFeature *OGRShapeLayer::FetchShape(int iShapeId /*, OGREnvelope* psShapeExten
             psShapeExtent->MinY = psShape->dfYMin;
             psShapeExtent->MaxX = psShape->dfXMax;
             psShapeExtent->MaxY = psShape->dfYMax;*/
-            poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                           iShapeId, psShape, osEncoding );
+            poFeature = ReadFeature( iShapeId, psShape );
         }                
     } 
     else 
     {
-        poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                       iShapeId, NULL, osEncoding );
+        poFeature = ReadFeature( iShapeId, NULL );
     }    
 
     return poFeature;
 }
 
+/************************************************************************/
+/*                            ReadFeature()                             */
+/*                                                                      */
+/*      Read a feature, into the feature handed back with               */
+/*      RecycleFeature() if there is one.                               */
+/************************************************************************/
+
+OGRFeature *OGRShapeLayer::ReadFeature( int iShapeId, SHPObject *psShape )
+
+{
+    OGRGeometry *poGeomToReuse = NULL;
+    OGRFeature *poFeatureToReuse = GetRecycledFeature( &poGeomToReuse );
+
+    return SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn, iShapeId, psShape,
+                              osEncoding, poFeatureToReuse, poGeomToReuse );
+}
+
 /************************************************************************/
 /*                           GetNextFeature()                           */
 /************************************************************************/
@@ -792,11 +806,53 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
                 return poFeature;
             }
 
-            delete poFeature;
+            RecycleFeature( poFeature );
         }
     }
 }
 
+/************************************************************************/
+/*                        GetNextFeatureBatch()                         */
+/************************************************************************/
+
+int OGRShapeLayer::GetNextFeatureBatch( OGRFeatureBatch *poBatch )
+
+{
+    poBatch->Clear();
+    if( !TouchLayer() || !IsFeatureBatchCompatible(poBatch) )
+        return 0;
+
+/* -------------------------------------------------------------------- */
+/*      Filters are evaluated against OGRFeature objects, so use the    */
+/*      generic implementation in that case.                            */
+/* -------------------------------------------------------------------- */
+    if( m_poAttrQuery != NULL || m_poFilterGeom != NULL )
+        return OGRLayer::GetNextFeatureBatch(poBatch);
+
+    while( !poBatch->IsFull() && iNextShapeId < nTotalShapeCount )
+    {
+        if( hDBF )
+        {
+            if( DBFIsRecordDeleted( hDBF, iNextShapeId ) )
+            {
+                iNextShapeId++;
+                continue;
+            }
+            if( VSIFEofL(VSI_SHP_GetVSIL(hDBF->fp)) )
+                break; /* There's an I/O error */
+        }
+
+        if( !SHPReadOGRFeatureToBatch( hSHP, hDBF, poFeatureDefn,
+                                       iNextShapeId, osEncoding, poBatch ) )
+            break;
+
+        iNextShapeId++;
+        m_nFeaturesRead++;
+    }
+
+    return poBatch->GetFeatureCount();
+}
+
 /************************************************************************/
 /*                             GetFeature()                             */
 /************************************************************************/
@@ -808,8 +864,7 @@ OGRFeature *OGRShapeLayer::GetFeature( GIntBig nFeatureId )
         return NULL;
 
     OGRFeature *poFeature = NULL;
-    poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn, (int)nFeatureId, NULL,
-                                   osEncoding );
+    poFeature = ReadFeature( (int)nFeatureId, NULL );
 
     if( poFeature != NULL )
     {
@@ -83,14 +83,42 @@ static OGRLinearRing * CreateLinearRing ( SHPObject *psShape, int ring, int bHas
 }
 
 
+/************************************************************************/
+/*                           ReuseGeometry()                            */
+/*                                                                      */
+/*      Take over poGeomToReuse if it has the requested type, so that   */
+/*      its coordinates can be overwritten in place. Otherwise return   */
+/*      NULL and leave it to the caller.                                */
+/************************************************************************/
+
+static OGRGeometry *ReuseGeometry( OGRGeometry *&poGeomToReuse,
+                                   OGRwkbGeometryType eType )
+{
+    OGRGeometry *poGeom = poGeomToReuse;
+
+    /* Linear rings report wkbLineString too */
+    if( poGeom == NULL || poGeom->getGeometryType() != eType ||
+        (wkbFlatten(eType) == wkbLineString &&
+         !EQUAL(poGeom->getGeometryName(), "LINESTRING")) )
+        return NULL;
+
+    poGeomToReuse = NULL;
+    return poGeom;
+}
+
 /************************************************************************/
 /*                          SHPReadOGRObject()                          */
 /*                                                                      */
 /*      Read an item in a shapefile, and translate to OGR geometry      */
 /*      representation.                                                 */
+/*                                                                      */
+/*      poGeomToReuse is an optional geometry, owned by this function,  */
+/*      which is updated in place instead of allocating a new one for   */
+/*      points, single part arcs and single ring polygons.              */
 /************************************************************************/
 
-OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
+OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape,
+                               OGRGeometry *poGeomToReuse )
 {
     // CPLDebug( "Shape", "SHPReadOGRObject( iShape=%d )\n", iShape );
 
@@ -101,6 +129,7 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
 
     if( psShape == NULL )
     {
+        delete poGeomToReuse;
         return NULL;
     }
 
@@ -109,18 +138,32 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
 /* -------------------------------------------------------------------- */
     else if( psShape->nSHPType == SHPT_POINT )
     {
-        poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0] );
-    }
-    else if(psShape->nSHPType == SHPT_POINTZ )
-    {
-        poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0],
-                              psShape->padfZ[0] );
+        OGRPoint *poPoint = (OGRPoint *) ReuseGeometry( poGeomToReuse, wkbPoint );
+        if( poPoint != NULL )
+        {
+            poPoint->setX( psShape->padfX[0] );
+            poPoint->setY( psShape->padfY[0] );
+            poOGR = poPoint;
+        }
+        else
+            poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0] );
     }
-    else if(psShape->nSHPType == SHPT_POINTM )
+    else if(psShape->nSHPType == SHPT_POINTZ
+            || psShape->nSHPType == SHPT_POINTM )
     {
         // Read XYM as XYZ
-        poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0],
-                              psShape->padfM[0] );
+        double dfZ = ( psShape->nSHPType == SHPT_POINTZ ) ? psShape->padfZ[0]
+                                                          : psShape->padfM[0];
+        OGRPoint *poPoint = (OGRPoint *) ReuseGeometry( poGeomToReuse, wkbPoint25D );
+        if( poPoint != NULL )
+        {
+            poPoint->setX( psShape->padfX[0] );
+            poPoint->setY( psShape->padfY[0] );
+            poPoint->setZ( dfZ );
+            poOGR = poPoint;
+        }
+        else
+            poOGR = new OGRPoint( psShape->padfX[0], psShape->padfY[0], dfZ );
     }
 /* -------------------------------------------------------------------- */
 /*      Multipoint.                                                     */
@@ -172,7 +215,12 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
         }
         else if( psShape->nParts == 1 )
         {
-            OGRLineString *poOGRLine = new OGRLineString();
+            OGRLineString *poOGRLine = (OGRLineString *)
+                ReuseGeometry( poGeomToReuse,
+                               psShape->nSHPType == SHPT_ARC ? wkbLineString
+                                                            : wkbLineString25D );
+            if( poOGRLine == NULL )
+                poOGRLine = new OGRLineString();
 
             if( psShape->nSHPType == SHPT_ARCZ )
                 poOGRLine->setPoints( psShape->nVertices,
@@ -261,12 +309,29 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
         else if ( psShape->nParts == 1 )
         {
             /* Surely outer ring */
-            OGRPolygon *poOGRPoly = NULL;
+            OGRPolygon *poOGRPoly = (OGRPolygon *)
+                ReuseGeometry( poGeomToReuse,
+                               bHasZ ? wkbPolygon25D : wkbPolygon );
             OGRLinearRing *poRing = NULL;
 
-            poOGR = poOGRPoly = new OGRPolygon();
-            poRing = CreateLinearRing ( psShape, 0, bHasZ );
-            poOGRPoly->addRingDirectly( poRing );
+            if( poOGRPoly != NULL && poOGRPoly->getNumInteriorRings() == 0
+                && (poRing = poOGRPoly->getExteriorRing()) != NULL )
+            {
+                int nRingStart, nRingEnd;
+                RingStartEnd ( psShape, 0, &nRingStart, &nRingEnd );
+                poRing->setPoints( nRingEnd - nRingStart + 1,
+                                   psShape->padfX + nRingStart,
+                                   psShape->padfY + nRingStart,
+                                   bHasZ ? psShape->padfZ + nRingStart : NULL );
+                poOGR = poOGRPoly;
+            }
+            else
+            {
+                delete poOGRPoly;
+                poOGR = poOGRPoly = new OGRPolygon();
+                poRing = CreateLinearRing ( psShape, 0, bHasZ );
+                poOGRPoly->addRingDirectly( poRing );
+            }
         }
 
         else
@@ -453,6 +518,8 @@ OGRGeometry *SHPReadOGRObject( SHPHandle hSHP, int iShape, SHPObject *psShape )
 /* -------------------------------------------------------------------- */
     SHPDestroyObject( psShape );
 
+    delete poGeomToReuse;
+
     return poOGR;
 }
 
@@ -1054,13 +1121,44 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
     return poDefn;
 }
 
+/************************************************************************/
+/*                          SHPParseDBFDate()                           */
+/************************************************************************/
+
+static void SHPParseDBFDate( const char* pszDateValue, OGRField* psFld )
+{
+    memset( psFld, 0, sizeof(OGRField) );
+
+    if( strlen(pszDateValue) >= 10 &&
+        pszDateValue[2] == '/' && pszDateValue[5] == '/' )
+    {
+        psFld->Date.Month = (GByte)atoi(pszDateValue+0);
+        psFld->Date.Day   = (GByte)atoi(pszDateValue+3);
+        psFld->Date.Year  = (GInt16)atoi(pszDateValue+6);
+    }
+    else
+    {
+        int nFullDate = atoi(pszDateValue);
+        psFld->Date.Year = (GInt16)(nFullDate / 10000);
+        psFld->Date.Month = (GByte)((nFullDate / 100) % 100);
+        psFld->Date.Day = (GByte)(nFullDate % 100);
+    }
+}
+
 /************************************************************************/
 /*                         SHPReadOGRFeature()                          */
+/*                                                                      */
+/*      poFeatureToReuse is an optional feature of poDefn, in the       */
+/*      state left by OGRFeature::Reset(), that is filled instead of    */
+/*      allocating a new one. poGeomToReuse is passed to                */
+/*      SHPReadOGRObject(). Both are owned by this function.            */
 /************************************************************************/
 
 OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape,
-                               SHPObject *psShape, const char *pszSHPEncoding )
+                               SHPObject *psShape, const char *pszSHPEncoding,
+                               OGRFeature *poFeatureToReuse,
+                               OGRGeometry *poGeomToReuse )
 
 {
     if( iShape < 0 
@@ -1070,6 +1168,8 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
         CPLError( CE_Failure, CPLE_AppDefined, 
                   "Attempt to read shape with feature id (%d) out of available"
                   " range.", iShape );
+        delete poFeatureToReuse;
+        delete poGeomToReuse;
         return NULL;
     }
 
@@ -1080,10 +1180,14 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                   iShape );
         if( psShape != NULL )
             SHPDestroyObject(psShape);
+        delete poFeatureToReuse;
+        delete poGeomToReuse;
         return NULL;
     }
 
-    OGRFeature  *poFeature = new OGRFeature( poDefn );
+    OGRFeature  *poFeature = poFeatureToReuse;
+    if( poFeature == NULL )
+        poFeature = new OGRFeature( poDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Fetch geometry from Shapefile to OGRFeature.                    */
@@ -1093,7 +1197,9 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
         if( !poDefn->IsGeometryIgnored() )
         {
             OGRGeometry* poGeometry = NULL;
-            poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+            poGeometry = SHPReadOGRObject( hSHP, iShape, psShape,
+                                           poGeomToReuse );
+            poGeomToReuse = NULL;
 
             /*
             * NOTE - mloskot:
@@ -1111,6 +1217,7 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
             SHPDestroyObject( psShape );
         }
     }
+    delete poGeomToReuse;
 
 /* -------------------------------------------------------------------- */
 /*      Fetch feature attributes to OGRFeature fields.                  */
@@ -1167,22 +1274,7 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
               if (pszDateValue[0] == '\0')
                   continue;
 
-              memset( &sFld, 0, sizeof(sFld) );
-
-              if( strlen(pszDateValue) >= 10 &&
-                  pszDateValue[2] == '/' && pszDateValue[5] == '/' )
-              {
-                  sFld.Date.Month = (GByte)atoi(pszDateValue+0);
-                  sFld.Date.Day   = (GByte)atoi(pszDateValue+3);
-                  sFld.Date.Year  = (GInt16)atoi(pszDateValue+6);
-              }
-              else
-              {
-                  int nFullDate = atoi(pszDateValue);
-                  sFld.Date.Year = (GInt16)(nFullDate / 10000);
-                  sFld.Date.Month = (GByte)((nFullDate / 100) % 100);
-                  sFld.Date.Day = (GByte)(nFullDate % 100);
-              }
+              SHPParseDBFDate( pszDateValue, &sFld );
 
               poFeature->SetField( iField, &sFld );
           }
@@ -1199,6 +1291,145 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
     return( poFeature );
 }
 
+/************************************************************************/
+/*                      SHPReadOGRFeatureToBatch()                      */
+/*                                                                      */
+/*      Append a shape to a feature batch, without going through a      */
+/*      OGRFeature. Points are directly written as WKB.                 */
+/************************************************************************/
+
+int SHPReadOGRFeatureToBatch( SHPHandle hSHP, DBFHandle hDBF,
+                              OGRFeatureDefn * poDefn, int iShape,
+                              const char *pszSHPEncoding,
+                              OGRFeatureBatch* poBatch )
+
+{
+    if( iShape < 0
+        || (hSHP != NULL && iShape >= hSHP->nRecords)
+        || (hDBF != NULL && iShape >= hDBF->nRecords) )
+    {
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "Attempt to read shape with feature id (%d) out of available"
+                  " range.", iShape );
+        return FALSE;
+    }
+
+    if( !poBatch->AddFeature( iShape ) )
+        return FALSE;
+
+/* -------------------------------------------------------------------- */
+/*      Fetch geometry.                                                 */
+/* -------------------------------------------------------------------- */
+    if( hSHP != NULL && !poDefn->IsGeometryIgnored() )
+    {
+        SHPObject* psShape = SHPReadObject( hSHP, iShape );
+        if( psShape != NULL && psShape->nVertices > 0 &&
+            (psShape->nSHPType == SHPT_POINT ||
+             psShape->nSHPType == SHPT_POINTZ ||
+             psShape->nSHPType == SHPT_POINTM) )
+        {
+            /* XYM is read as XYZ, as in SHPReadOGRObject() */
+            const int bHasZ = psShape->nSHPType != SHPT_POINT;
+            GByte* pabyWkb = poBatch->AllocGeomFieldWkb( 0, bHasZ ? 29 : 21 );
+            if( pabyWkb != NULL )
+            {
+                GUInt32 nGType = bHasZ ? 1001 : 1;
+                double adfXYZ[3];
+                adfXYZ[0] = psShape->padfX[0];
+                adfXYZ[1] = psShape->padfY[0];
+                adfXYZ[2] = (psShape->nSHPType == SHPT_POINTZ) ?
+                            psShape->padfZ[0] : psShape->padfM[0];
+                pabyWkb[0] = (GByte) wkbNDR;
+                CPL_LSBPTR32(&nGType);
+                memcpy( pabyWkb + 1, &nGType, 4 );
+                for( int i = 0; i < (bHasZ ? 3 : 2); i++ )
+                {
+                    CPL_LSBPTR64(&adfXYZ[i]);
+                    memcpy( pabyWkb + 5 + 8 * i, &adfXYZ[i], 8 );
+                }
+            }
+            SHPDestroyObject( psShape );
+        }
+        else if( psShape != NULL )
+        {
+            OGRGeometry* poGeometry = SHPReadOGRObject( hSHP, iShape, psShape );
+            poBatch->SetGeomField( 0, poGeometry );
+            delete poGeometry;
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Fetch attributes.                                               */
+/* -------------------------------------------------------------------- */
+    for( int iField = 0; hDBF != NULL && iField < poDefn->GetFieldCount(); iField++ )
+    {
+        OGRFieldDefn* poFieldDefn = poDefn->GetFieldDefn(iField);
+        if (poFieldDefn->IsIgnored() )
+            continue;
+
+        switch( poFieldDefn->GetType() )
+        {
+          case OFTString:
+          {
+              const char *pszFieldVal =
+                  DBFReadStringAttribute( hDBF, iShape, iField );
+              if( pszFieldVal != NULL && pszFieldVal[0] != '\0' )
+              {
+                if( pszSHPEncoding[0] != '\0' )
+                {
+                    char *pszUTF8Field = CPLRecode( pszFieldVal,
+                                                    pszSHPEncoding, CPL_ENC_UTF8);
+                    poBatch->SetFieldString( iField, pszUTF8Field );
+                    CPLFree( pszUTF8Field );
+                }
+                else
+                    poBatch->SetFieldString( iField, pszFieldVal );
+              }
+          }
+          break;
+
+          case OFTInteger:
+            if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                poBatch->SetFieldInteger( iField,
+                    atoi(DBFReadStringAttribute( hDBF, iShape, iField )) );
+            break;
+
+          case OFTInteger64:
+            if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                poBatch->SetFieldInteger64( iField,
+                    CPLAtoGIntBig(DBFReadStringAttribute( hDBF, iShape, iField )) );
+            break;
+
+          case OFTReal:
+            if( !DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                poBatch->SetFieldDouble( iField,
+                    CPLAtof(DBFReadStringAttribute( hDBF, iShape, iField )) );
+            break;
+
+          case OFTDate:
+          {
+              if( DBFIsAttributeNULL( hDBF, iShape, iField ) )
+                  continue;
+
+              const char* pszDateValue =
+                  DBFReadStringAttribute(hDBF,iShape,iField);
+              if (pszDateValue[0] == '\0')
+                  continue;
+
+              OGRField sFld;
+              SHPParseDBFDate( pszDateValue, &sFld );
+              poBatch->SetField( iField, &sFld );
+          }
+          break;
+
+          default:
+            CPLAssert( FALSE );
+        }
+    }
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                             GrowField()                              */
 /************************************************************************/
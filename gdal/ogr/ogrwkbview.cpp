@@ -0,0 +1,672 @@
+/******************************************************************************
+ * $Id$
+ *
+ * Project:  OpenGIS Simple Features Reference Implementation
+ * Purpose:  The OGRWKBView class implementation.
+ * Author:   agent, <agent at local>
+ *
+ ******************************************************************************
+ * Copyright (c) 2026, agent <agent at local>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "ogr_geometry.h"
+#include "ogr_p.h"
+
+CPL_CVSID("$Id$");
+
+/* Called for each sequence of points of the geometry : the vertex of a */
+/* point, the vertices of a linestring, or the vertices of a ring of a */
+/* polygon (iRing == 0 for the exterior ring). Returns FALSE to stop. */
+typedef int (*OGRWKBSequenceFunc)( const GByte *pabyPoints, int nPoints,
+                                   int b3D, int bSwap,
+                                   OGRwkbGeometryType eParentType, int iRing,
+                                   void *pUserData );
+
+/************************************************************************/
+/*                           WKBReadDouble()                            */
+/************************************************************************/
+
+static inline double WKBReadDouble( const GByte *pabyData, int bSwap )
+{
+    double dfVal;
+    memcpy( &dfVal, pabyData, 8 );
+    if( bSwap )
+        CPL_SWAPDOUBLE( &dfVal );
+    return dfVal;
+}
+
+/************************************************************************/
+/*                            WKBReadInt()                              */
+/************************************************************************/
+
+static inline GInt32 WKBReadInt( const GByte *pabyData, int bSwap )
+{
+    GInt32 nVal;
+    memcpy( &nVal, pabyData, 4 );
+    if( bSwap )
+        CPL_SWAP32PTR( &nVal );
+    return nVal;
+}
+
+/************************************************************************/
+/*                           WKBReadCount()                             */
+/*                                                                      */
+/*      Read a count of elements of nEltSize bytes and check that       */
+/*      they fit in the remaining data.                                 */
+/************************************************************************/
+
+static int WKBReadCount( const GByte *pabyData, int nSize, int bSwap,
+                         int nEltSize, int *pnCount )
+{
+    if( nSize < 4 && nSize != -1 )
+        return FALSE;
+    const GInt32 nCount = WKBReadInt( pabyData, bSwap );
+    if( nCount < 0 || nCount > (INT_MAX - 9) / nEltSize )
+        return FALSE;
+    if( nSize != -1 && nCount > (nSize - 4) / nEltSize )
+        return FALSE;
+    *pnCount = nCount;
+    return TRUE;
+}
+
+/************************************************************************/
+/*                             OGRWKBWalk()                             */
+/*                                                                      */
+/*      Visit the point sequences of a WKB geometry. Returns FALSE on   */
+/*      corrupted or unsupported data, or if pfnFunc asked to stop.     */
+/************************************************************************/
+
+static int OGRWKBWalk( const GByte *pabyData, int nSize,
+                       OGRwkbVariant eWkbVariant, int nRecLevel,
+                       OGRWKBSequenceFunc pfnFunc, void *pUserData,
+                       int *pnConsumed,
+                       OGRwkbGeometryType *peGeometryType, int *pb3D )
+
+{
+    if( nRecLevel == 32 )
+        return FALSE;
+    if( nSize < 9 && nSize != -1 )
+        return FALSE;
+
+    const int nByteOrder = DB2_V72_FIX_BYTE_ORDER(*pabyData);
+    if( nByteOrder != wkbXDR && nByteOrder != wkbNDR )
+        return FALSE;
+    const int bSwap = OGR_SWAP( (OGRwkbByteOrder) nByteOrder );
+
+    OGRwkbGeometryType eGeometryType;
+    OGRBoolean bIs3D;
+    if( OGRReadWKBGeometryType( (unsigned char *) pabyData, eWkbVariant,
+                                &eGeometryType, &bIs3D ) != OGRERR_NONE )
+        return FALSE;
+    if( peGeometryType != NULL )
+        *peGeometryType = eGeometryType;
+    if( pb3D != NULL )
+        *pb3D = bIs3D;
+
+    const int nPointSize = bIs3D ? 24 : 16;
+    const int nRemaining = (nSize == -1) ? -1 : nSize - 5;
+
+    switch( eGeometryType )
+    {
+        case wkbPoint:
+        {
+            if( nRemaining < nPointSize && nRemaining != -1 )
+                return FALSE;
+            /* NaN coordinates --> EMPTY */
+            const double dfX = WKBReadDouble( pabyData + 5, bSwap );
+            const double dfY = WKBReadDouble( pabyData + 13, bSwap );
+            if( !(dfX != dfX && dfY != dfY) &&
+                !pfnFunc( pabyData + 5, 1, bIs3D, bSwap, wkbPoint, 0,
+                          pUserData ) )
+                return FALSE;
+            *pnConsumed = 5 + nPointSize;
+            return TRUE;
+        }
+
+        case wkbLineString:
+        {
+            int nCount;
+            if( !WKBReadCount( pabyData + 5, nRemaining, bSwap, nPointSize,
+                               &nCount ) )
+                return FALSE;
+            if( nCount > 0 &&
+                !pfnFunc( pabyData + 9, nCount, bIs3D, bSwap, wkbLineString, 0,
+                          pUserData ) )
+                return FALSE;
+            *pnConsumed = 9 + nCount * nPointSize;
+            return TRUE;
+        }
+
+        case wkbPolygon:
+        {
+            int nRings;
+            if( !WKBReadCount( pabyData + 5, nRemaining, bSwap, 4, &nRings ) )
+                return FALSE;
+            int nOffset = 9;
+            for( int iRing = 0; iRing < nRings; iRing++ )
+            {
+                int nCount;
+                if( !WKBReadCount( pabyData + nOffset,
+                                   nSize == -1 ? -1 : nSize - nOffset,
+                                   bSwap, nPointSize, &nCount ) )
+                    return FALSE;
+                if( nCount > 0 &&
+                    !pfnFunc( pabyData + nOffset + 4, nCount, bIs3D, bSwap,
+                              wkbPolygon, iRing, pUserData ) )
+                    return FALSE;
+                nOffset += 4 + nCount * nPointSize;
+            }
+            *pnConsumed = nOffset;
+            return TRUE;
+        }
+
+        case wkbMultiPoint:
+        case wkbMultiLineString:
+        case wkbMultiPolygon:
+        case wkbGeometryCollection:
+        {
+            int nGeoms;
+            if( !WKBReadCount( pabyData + 5, nRemaining, bSwap, 9, &nGeoms ) )
+                return FALSE;
+            int nOffset = 9;
+            for( int iGeom = 0; iGeom < nGeoms; iGeom++ )
+            {
+                OGRwkbGeometryType eSubGeomType;
+                int nConsumed = 0;
+                if( !OGRWKBWalk( pabyData + nOffset,
+                                 nSize == -1 ? -1 : nSize - nOffset,
+                                 eWkbVariant, nRecLevel + 1,
+                                 pfnFunc, pUserData, &nConsumed,
+                                 &eSubGeomType, NULL ) )
+                    return FALSE;
+                if( (eGeometryType == wkbMultiPoint &&
+                     eSubGeomType != wkbPoint) ||
+                    (eGeometryType == wkbMultiLineString &&
+                     eSubGeomType != wkbLineString) ||
+                    (eGeometryType == wkbMultiPolygon &&
+                     eSubGeomType != wkbPolygon) )
+                    return FALSE;
+                nOffset += nConsumed;
+            }
+            *pnConsumed = nOffset;
+            return TRUE;
+        }
+
+        default:
+            return FALSE;
+    }
+}
+
+/************************************************************************/
+/*                             OGRWKBView()                             */
+/************************************************************************/
+
+static int CountPointsFunc( const GByte *, int nPoints, int, int,
+                            OGRwkbGeometryType, int, void *pUserData )
+{
+    *((int *) pUserData) += nPoints;
+    return TRUE;
+}
+
+/**
+ * \brief Constructor.
+ *
+ * The WKB is validated once, so that the other methods can rely on the
+ * structure being consistent. The data is neither copied nor converted.
+ *
+ * @param pabyDataIn pointer to the WKB data, which must remain valid for
+ * the lifetime of the view.
+ * @param nBytes the number of bytes available in pabyDataIn, or -1 if it
+ * isn't known.
+ * @param eWkbVariantIn WKB variant.
+ *
+ * @since GDAL 2.1
+ */
+
+OGRWKBView::OGRWKBView( const GByte *pabyDataIn, int nBytes,
+                        OGRwkbVariant eWkbVariantIn ) :
+    pabyData(pabyDataIn),
+    nWkbSize(0),
+    eWkbVariant(eWkbVariantIn),
+    eGeometryType(wkbUnknown),
+    b3D(FALSE),
+    nPointCount(0)
+{
+    int nConsumed = 0;
+    if( pabyData == NULL ||
+        !OGRWKBWalk( pabyData, nBytes, eWkbVariant, 0,
+                     CountPointsFunc, &nPointCount, &nConsumed,
+                     &eGeometryType, &b3D ) )
+    {
+        CPLDebug( "OGR", "OGRWKBView: invalid or unsupported WKB geometry" );
+        eGeometryType = wkbUnknown;
+        b3D = FALSE;
+        nPointCount = 0;
+        return;
+    }
+    nWkbSize = nConsumed;
+}
+
+/************************************************************************/
+/*                          getGeometryType()                           */
+/************************************************************************/
+
+/**
+ * \brief Fetch geometry type, with the same conventions as
+ * OGRGeometry::getGeometryType().
+ *
+ * @return wkbUnknown if the view is not valid.
+ */
+
+OGRwkbGeometryType OGRWKBView::getGeometryType() const
+{
+    return b3D ? wkbSetZ(eGeometryType) : eGeometryType;
+}
+
+/************************************************************************/
+/*                            getEnvelope()                             */
+/************************************************************************/
+
+static int EnvelopeFunc( const GByte *pabyPoints, int nPoints, int b3D,
+                         int bSwap, OGRwkbGeometryType, int, void *pUserData )
+{
+    OGREnvelope3D *psEnv = (OGREnvelope3D *) pUserData;
+    const int nPointSize = b3D ? 24 : 16;
+    for( int i = 0; i < nPoints; i++, pabyPoints += nPointSize )
+    {
+        const double dfX = WKBReadDouble( pabyPoints, bSwap );
+        const double dfY = WKBReadDouble( pabyPoints + 8, bSwap );
+        const double dfZ = b3D ? WKBReadDouble( pabyPoints + 16, bSwap ) : 0.0;
+        if( dfX < psEnv->MinX ) psEnv->MinX = dfX;
+        if( dfX > psEnv->MaxX ) psEnv->MaxX = dfX;
+        if( dfY < psEnv->MinY ) psEnv->MinY = dfY;
+        if( dfY > psEnv->MaxY ) psEnv->MaxY = dfY;
+        if( dfZ < psEnv->MinZ ) psEnv->MinZ = dfZ;
+        if( dfZ > psEnv->MaxZ ) psEnv->MaxZ = dfZ;
+    }
+    return TRUE;
+}
+
+/**
+ * \brief Computes and returns the bounding envelope (3D) of the geometry.
+ *
+ * The envelope is set to zero for empty or invalid geometries.
+ */
+
+void OGRWKBView::getEnvelope( OGREnvelope3D *psEnvelope ) const
+{
+    if( nPointCount == 0 )
+    {
+        psEnvelope->MinX = psEnvelope->MaxX = 0.0;
+        psEnvelope->MinY = psEnvelope->MaxY = 0.0;
+        psEnvelope->MinZ = psEnvelope->MaxZ = 0.0;
+        return;
+    }
+
+    psEnvelope->MinX = psEnvelope->MinY = psEnvelope->MinZ = HUGE_VAL;
+    psEnvelope->MaxX = psEnvelope->MaxY = psEnvelope->MaxZ = -HUGE_VAL;
+    int nConsumed;
+    OGRWKBWalk( pabyData, nWkbSize, eWkbVariant, 0, EnvelopeFunc, psEnvelope,
+                &nConsumed, NULL, NULL );
+}
+
+/**
+ * \brief Computes and returns the bounding envelope of the geometry.
+ *
+ * The envelope is set to zero for empty or invalid geometries.
+ */
+
+void OGRWKBView::getEnvelope( OGREnvelope *psEnvelope ) const
+{
+    OGREnvelope3D sEnv3D;
+    getEnvelope( &sEnv3D );
+    psEnvelope->MinX = sEnv3D.MinX;
+    psEnvelope->MaxX = sEnv3D.MaxX;
+    psEnvelope->MinY = sEnv3D.MinY;
+    psEnvelope->MaxY = sEnv3D.MaxY;
+}
+
+/************************************************************************/
+/*                             get_Length()                             */
+/************************************************************************/
+
+static int LengthFunc( const GByte *pabyPoints, int nPoints, int b3D,
+                       int bSwap, OGRwkbGeometryType eParentType, int,
+                       void *pUserData )
+{
+    if( eParentType != wkbLineString )
+        return TRUE;
+
+    const int nPointSize = b3D ? 24 : 16;
+    double dfLength = 0.0;
+    double dfPrevX = WKBReadDouble( pabyPoints, bSwap );
+    double dfPrevY = WKBReadDouble( pabyPoints + 8, bSwap );
+    for( int i = 1; i < nPoints; i++ )
+    {
+        pabyPoints += nPointSize;
+        const double dfX = WKBReadDouble( pabyPoints, bSwap );
+        const double dfY = WKBReadDouble( pabyPoints + 8, bSwap );
+        dfLength += sqrt( (dfX - dfPrevX) * (dfX - dfPrevX) +
+                          (dfY - dfPrevY) * (dfY - dfPrevY) );
+        dfPrevX = dfX;
+        dfPrevY = dfY;
+    }
+    *((double *) pUserData) += dfLength;
+    return TRUE;
+}
+
+/**
+ * \brief Compute the 2D length of the linestrings of the geometry.
+ *
+ * @return the sum of the lengths of the linestrings, or 0 for other
+ * geometry types.
+ */
+
+double OGRWKBView::get_Length() const
+{
+    double dfLength = 0.0;
+    int nConsumed;
+    if( nPointCount > 0 )
+        OGRWKBWalk( pabyData, nWkbSize, eWkbVariant, 0, LengthFunc, &dfLength,
+                    &nConsumed, NULL, NULL );
+    return dfLength;
+}
+
+/************************************************************************/
+/*                              get_Area()                              */
+/************************************************************************/
+
+static int AreaFunc( const GByte *pabyPoints, int nPoints, int b3D,
+                     int bSwap, OGRwkbGeometryType eParentType, int iRing,
+                     void *pUserData )
+{
+    if( eParentType != wkbPolygon || nPoints < 2 )
+        return TRUE;
+
+    /* Shoelace formula, relative to the first vertex for accuracy */
+    const int nPointSize = b3D ? 24 : 16;
+    const double dfX0 = WKBReadDouble( pabyPoints, bSwap );
+    const double dfY0 = WKBReadDouble( pabyPoints + 8, bSwap );
+    double dfPrevX = 0.0;
+    double dfPrevY = 0.0;
+    double dfSum = 0.0;
+    for( int i = 1; i < nPoints; i++ )
+    {
+        pabyPoints += nPointSize;
+        const double dfX = WKBReadDouble( pabyPoints, bSwap ) - dfX0;
+        const double dfY = WKBReadDouble( pabyPoints + 8, bSwap ) - dfY0;
+        dfSum += dfPrevX * dfY - dfX * dfPrevY;
+        dfPrevX = dfX;
+        dfPrevY = dfY;
+    }
+
+    const double dfRingArea = fabs( dfSum * 0.5 );
+    if( iRing == 0 )
+        *((double *) pUserData) += dfRingArea;
+    else
+        *((double *) pUserData) -= dfRingArea;
+    return TRUE;
+}
+
+/**
+ * \brief Compute the area of the polygons of the geometry.
+ *
+ * As in OGRPolygon::get_Area(), the area of the interior rings is
+ * subtracted from the area of the exterior ring.
+ *
+ * @return the sum of the areas of the polygons, or 0 for other geometry
+ * types.
+ */
+
+double OGRWKBView::get_Area() const
+{
+    double dfArea = 0.0;
+    int nConsumed;
+    if( nPointCount > 0 )
+        OGRWKBWalk( pabyData, nWkbSize, eWkbVariant, 0, AreaFunc, &dfArea,
+                    &nConsumed, NULL, NULL );
+    return dfArea;
+}
+
+/************************************************************************/
+/*                              Contains()                              */
+/************************************************************************/
+
+typedef struct
+{
+    double  dfX;
+    double  dfY;
+    int     bInside;
+} OGRWKBContainsData;
+
+static int ContainsFunc( const GByte *pabyPoints, int nPoints, int b3D,
+                         int bSwap, OGRwkbGeometryType eParentType, int,
+                         void *pUserData )
+{
+    if( eParentType != wkbPolygon || nPoints < 2 )
+        return TRUE;
+
+    /* Even-odd rule : each edge crossed by the horizontal ray going */
+    /* right of the point toggles the status. */
+    OGRWKBContainsData *psData = (OGRWKBContainsData *) pUserData;
+    const int nPointSize = b3D ? 24 : 16;
+    double dfPrevX = WKBReadDouble( pabyPoints, bSwap );
+    double dfPrevY = WKBReadDouble( pabyPoints + 8, bSwap );
+    for( int i = 1; i < nPoints; i++ )
+    {
+        pabyPoints += nPointSize;
+        const double dfX = WKBReadDouble( pabyPoints, bSwap );
+        const double dfY = WKBReadDouble( pabyPoints + 8, bSwap );
+        if( ((dfY > psData->dfY) != (dfPrevY > psData->dfY)) &&
+            psData->dfX < (dfPrevX - dfX) * (psData->dfY - dfY) /
+                          (dfPrevY - dfY) + dfX )
+        {
+            psData->bInside = !psData->bInside;
+        }
+        dfPrevX = dfX;
+        dfPrevY = dfY;
+    }
+    return TRUE;
+}
+
+/**
+ * \brief Test if a point is inside the polygons of the geometry.
+ *
+ * The test uses the even-odd rule over all the rings, which is correct for
+ * valid polygons and multipolygons. Points located exactly on the boundary
+ * may be reported as inside or outside.
+ *
+ * @return TRUE if the point is inside, FALSE otherwise or for non polygonal
+ * geometries.
+ */
+
+OGRBoolean OGRWKBView::Contains( double dfX, double dfY ) const
+{
+    if( nPointCount == 0 )
+        return FALSE;
+
+    OGREnvelope sEnv;
+    getEnvelope( &sEnv );
+    if( dfX < sEnv.MinX || dfX > sEnv.MaxX ||
+        dfY < sEnv.MinY || dfY > sEnv.MaxY )
+        return FALSE;
+
+    OGRWKBContainsData sData;
+    sData.dfX = dfX;
+    sData.dfY = dfY;
+    sData.bInside = FALSE;
+    int nConsumed;
+    OGRWKBWalk( pabyData, nWkbSize, eWkbVariant, 0, ContainsFunc, &sData,
+                &nConsumed, NULL, NULL );
+    return sData.bInside;
+}
+
+/************************************************************************/
+/*                             Intersects()                             */
+/************************************************************************/
+
+/* Liang-Barsky clipping of a segment (possibly degenerated to a point) */
+static int SegmentIntersectsEnvelope( double dfX1, double dfY1,
+                                      double dfX2, double dfY2,
+                                      const OGREnvelope *psEnv )
+{
+    const double dfDX = dfX2 - dfX1;
+    const double dfDY = dfY2 - dfY1;
+    const double adfP[4] = { -dfDX, dfDX, -dfDY, dfDY };
+    const double adfQ[4] = { dfX1 - psEnv->MinX, psEnv->MaxX - dfX1,
+                             dfY1 - psEnv->MinY, psEnv->MaxY - dfY1 };
+    double dfT0 = 0.0;
+    double dfT1 = 1.0;
+    for( int i = 0; i < 4; i++ )
+    {
+        if( adfP[i] == 0.0 )
+        {
+            if( adfQ[i] < 0.0 )
+                return FALSE;
+        }
+        else
+        {
+            const double dfR = adfQ[i] / adfP[i];
+            if( adfP[i] < 0.0 )
+            {
+                if( dfR > dfT1 )
+                    return FALSE;
+                if( dfR > dfT0 )
+                    dfT0 = dfR;
+            }
+            else
+            {
+                if( dfR < dfT0 )
+                    return FALSE;
+                if( dfR < dfT1 )
+                    dfT1 = dfR;
+            }
+        }
+    }
+    return TRUE;
+}
+
+typedef struct
+{
+    const OGREnvelope *psEnv;
+    int                bIntersects;
+    int                bHasPolygon;
+} OGRWKBIntersectsData;
+
+static int IntersectsFunc( const GByte *pabyPoints, int nPoints, int b3D,
+                           int bSwap, OGRwkbGeometryType eParentType, int,
+                           void *pUserData )
+{
+    OGRWKBIntersectsData *psData = (OGRWKBIntersectsData *) pUserData;
+    if( eParentType == wkbPolygon )
+        psData->bHasPolygon = TRUE;
+
+    const int nPointSize = b3D ? 24 : 16;
+    double dfPrevX = WKBReadDouble( pabyPoints, bSwap );
+    double dfPrevY = WKBReadDouble( pabyPoints + 8, bSwap );
+    if( nPoints == 1 )
+    {
+        psData->bIntersects =
+            SegmentIntersectsEnvelope( dfPrevX, dfPrevY, dfPrevX, dfPrevY,
+                                       psData->psEnv );
+        return !psData->bIntersects;
+    }
+    for( int i = 1; i < nPoints; i++ )
+    {
+        pabyPoints += nPointSize;
+        const double dfX = WKBReadDouble( pabyPoints, bSwap );
+        const double dfY = WKBReadDouble( pabyPoints + 8, bSwap );
+        if( SegmentIntersectsEnvelope( dfPrevX, dfPrevY, dfX, dfY,
+                                       psData->psEnv ) )
+        {
+            psData->bIntersects = TRUE;
+            return FALSE;
+        }
+        dfPrevX = dfX;
+        dfPrevY = dfY;
+    }
+    return TRUE;
+}
+
+/**
+ * \brief Test if the geometry intersects a rectangle.
+ *
+ * Unlike a comparison of envelopes, this is an exact test : it checks
+ * whether any vertex or segment of the geometry touches the rectangle, or
+ * whether the rectangle lies inside a polygon.
+ *
+ * @return TRUE if the geometry intersects the rectangle.
+ */
+
+OGRBoolean OGRWKBView::Intersects( const OGREnvelope& sEnvelope ) const
+{
+    if( nPointCount == 0 )
+        return FALSE;
+
+    OGREnvelope sEnv;
+    getEnvelope( &sEnv );
+    if( !sEnv.Intersects( sEnvelope ) )
+        return FALSE;
+    if( sEnv.MinX >= sEnvelope.MinX && sEnv.MaxX <= sEnvelope.MaxX &&
+        sEnv.MinY >= sEnvelope.MinY && sEnv.MaxY <= sEnvelope.MaxY )
+        return TRUE;
+
+    OGRWKBIntersectsData sData;
+    sData.psEnv = &sEnvelope;
+    sData.bIntersects = FALSE;
+    sData.bHasPolygon = FALSE;
+    int nConsumed;
+    OGRWKBWalk( pabyData, nWkbSize, eWkbVariant, 0, IntersectsFunc, &sData,
+                &nConsumed, NULL, NULL );
+    if( sData.bIntersects )
+        return TRUE;
+
+    /* No boundary crossing : the rectangle is either completely inside */
+    /* or completely outside the polygons. */
+    return sData.bHasPolygon && Contains( sEnvelope.MinX, sEnvelope.MinY );
+}
+
+/************************************************************************/
+/*                            Materialize()                             */
+/************************************************************************/
+
+/**
+ * \brief Build an OGRGeometry from the viewed WKB.
+ *
+ * @param poSR spatial reference to assign to the geometry, or NULL.
+ * @param poArena if not NULL, the geometry is allocated in this arena and
+ * must not be deleted by the caller.
+ *
+ * @return a new geometry, or NULL if the view is not valid.
+ */
+
+OGRGeometry *OGRWKBView::Materialize( OGRSpatialReference *poSR,
+                                      OGRGeometryArena *poArena ) const
+{
+    if( !IsValid() )
+        return NULL;
+
+    OGRGeometry *poGeom = NULL;
+    OGRGeometryFactory::createFromWkb( (unsigned char *) pabyData, poSR,
+                                       &poGeom, nWkbSize, eWkbVariant,
+                                       poArena );
+    return poGeom;
+}
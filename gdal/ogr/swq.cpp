@@ -261,10 +261,17 @@ int swqlex( YYSTYPE *ppNode, swq_parse_context *context )
             nReturn = SWQT_UNION;
         else if( EQUAL(osToken,"ALL") )
             nReturn = SWQT_ALL;
+        else if( EQUAL(osToken,"LIMIT") )
+            nReturn = SWQT_LIMIT;
+        /* OFFSET was not a keyword before GDAL 2.1, so only consider it */
+        /* as one when it is followed by a number, to keep accepting it as */
+        /* a column name. */
+        else if( EQUAL(osToken,"OFFSET") &&
+                 isdigit( (unsigned char) *(pszNext + strspn(pszNext, " \t\r\n")) ) )
+            nReturn = SWQT_OFFSET;
 
         /* Unhandled by OGR SQL */
-        else if( EQUAL(osToken,"LIMIT") ||
-                 EQUAL(osToken,"OUTER") ||
+        else if( EQUAL(osToken,"OUTER") ||
                  EQUAL(osToken,"INNER") )
             nReturn = SWQT_RESERVED_KEYWORD;
 
@@ -830,7 +837,8 @@ static const char* const apszSQLReservedKeywords[] = {
     "ASC",
     "DESC",
     "UNION",
-    "ALL"
+    "ALL",
+    "LIMIT"
 };
 
 int swq_is_reserved_keyword(const char* pszStr)
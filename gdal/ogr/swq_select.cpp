@@ -48,6 +48,8 @@ swq_select::swq_select() :
     where_expr(NULL),
     order_specs(0),
     order_defs(NULL),
+    limit(-1),
+    offset(0),
     poOtherSelect(NULL)
 { }
 
@@ -296,6 +298,11 @@ void swq_select::Dump( FILE *fp )
         else
             fprintf( fp, " DESC\n" );
     }
+
+    if( limit >= 0 )
+        fprintf( fp, "  LIMIT: " CPL_FRMT_GIB "\n", limit );
+    if( offset > 0 )
+        fprintf( fp, "  OFFSET: " CPL_FRMT_GIB "\n", offset );
 }
 
 /************************************************************************/
@@ -411,6 +418,11 @@ char* swq_select::Unparse()
             osSelect += " DESC";
     }
 
+    if( limit >= 0 )
+        osSelect += CPLSPrintf(" LIMIT " CPL_FRMT_GIB, limit);
+    if( offset > 0 )
+        osSelect += CPLSPrintf(" OFFSET " CPL_FRMT_GIB, offset);
+
     return CPLStrdup(osSelect);
 }
 
@@ -739,6 +751,26 @@ void swq_select::PushOrderBy( const char* pszTableName, const char *pszFieldName
     order_defs[order_specs-1].ascending_flag = bAscending;
 }
 
+/************************************************************************/
+/*                              SetLimit()                              */
+/************************************************************************/
+
+void swq_select::SetLimit( GIntBig nLimit )
+
+{
+    limit = nLimit;
+}
+
+/************************************************************************/
+/*                             SetOffset()                              */
+/************************************************************************/
+
+void swq_select::SetOffset( GIntBig nOffset )
+
+{
+    offset = nOffset;
+}
+
 /************************************************************************/
 /*                              PushJoin()                              */
 /************************************************************************/
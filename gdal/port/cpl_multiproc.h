@@ -203,7 +203,7 @@ class CPL_DLL CPLLockHolder
 #define CTLS_ERRORCONTEXT               5         /* cpl_error.cpp */
 #define CTLS_GDALDATASET_REC_PROTECT_MAP 6        /* gdaldataset.cpp */
 #define CTLS_PATHBUF                    7         /* cpl_path.cpp */
-#define CTLS_UNUSED3                    8
+#define CTLS_GDALDATASETPOOL_DISABLEREFCOUNT 8    /* gdalproxypool.cpp */
 #define CTLS_UNUSED4                    9
 #define CTLS_CPLSPRINTF                10         /* cpl_string.h */
 #define CTLS_RESPONSIBLEPID            11         /* gdaldataset.cpp */
@@ -52,6 +52,10 @@ class CPL_DLL VSIVirtualHandle {
     virtual vsi_l_offset Tell() = 0;
     virtual size_t    Read( void *pBuffer, size_t nSize, size_t nMemb ) = 0;
     virtual int       ReadMultiRange( int nRanges, void ** ppData, const vsi_l_offset* panOffsets, const size_t* panSizes );
+    virtual int       HasPRead() { return FALSE; }
+    virtual size_t    PRead( void *pBuffer, size_t nSize, vsi_l_offset nOffset );
+    virtual const void *GetDirectPointer( CPL_UNUSED vsi_l_offset nOffset,
+                                          CPL_UNUSED size_t nSize ) { return NULL; }
     virtual size_t    Write( const void *pBuffer, size_t nSize,size_t nMemb)=0;
     virtual int       Eof() = 0;
     virtual int       Flush() {return 0;}
@@ -728,6 +728,97 @@ int VSIFReadMultiRangeL( int nRanges, void ** ppData,
     return poFileHandle->ReadMultiRange( nRanges, ppData, panOffsets, panSizes );
 }
 
+/************************************************************************/
+/*                           VSIFHasPReadL()                            */
+/************************************************************************/
+
+/**
+ * \brief Return whether VSIFPReadL() is supported by a file handle.
+ *
+ * This is currently the case of regular files opened in read-only mode
+ * on POSIX systems (including memory mapped ones, see
+ * VSIFGetDirectPointerL()), and of /vsisubfile/ files on top of them.
+ *
+ * @param fp file handle opened with VSIFOpenL().
+ *
+ * @return TRUE if VSIFPReadL() can be used on the handle.
+ * @since GDAL 2.1
+ */
+
+int VSIFHasPReadL( VSILFILE * fp )
+{
+    VSIVirtualHandle *poFileHandle = (VSIVirtualHandle *) fp;
+
+    return poFileHandle->HasPRead();
+}
+
+/************************************************************************/
+/*                             VSIFPReadL()                             */
+/************************************************************************/
+
+/**
+ * \brief Read bytes from file at a given offset.
+ *
+ * Reads nSize bytes from the indicated file at the offset nOffset into
+ * the buffer pBuffer. Unlike VSIFSeekL() followed by VSIFReadL(), the
+ * current position of the file handle is neither used nor modified, so
+ * that several threads can call this function concurrently on the same
+ * handle, provided that VSIFHasPReadL() returns TRUE for it.
+ *
+ * This method goes through the VSIFileHandler virtualization.
+ *
+ * @param pBuffer the buffer into which the data should be read (at least
+ * nSize bytes in size).
+ * @param nSize number of bytes to read.
+ * @param nOffset offset in the file at which the data should be read.
+ * @param fp file handle opened with VSIFOpenL().
+ *
+ * @return number of bytes successfully read, smaller than nSize at end of
+ * file or on error.
+ * @since GDAL 2.1
+ */
+
+size_t VSIFPReadL( void * pBuffer, size_t nSize, vsi_l_offset nOffset,
+                   VSILFILE * fp )
+{
+    VSIVirtualHandle *poFileHandle = (VSIVirtualHandle *) fp;
+
+    return poFileHandle->PRead( pBuffer, nSize, nOffset );
+}
+
+/************************************************************************/
+/*                       VSIFGetDirectPointerL()                        */
+/************************************************************************/
+
+/**
+ * \brief Return a pointer to file content, without copying it.
+ *
+ * This is only possible for handles whose content is already in memory,
+ * currently files opened in read-only mode while the VSI_USE_MMAP
+ * configuration option is set to YES (on systems with mmap()), and
+ * /vsisubfile/ files on top of them.
+ *
+ * The returned pointer is read-only, may be used concurrently by several
+ * threads and remains valid until the handle is closed. Byte order is the
+ * one of the file.
+ *
+ * @param fp file handle opened with VSIFOpenL().
+ * @param nOffset offset in the file of the first byte of the range.
+ * @param nSize size of the range in bytes.
+ *
+ * @return a pointer to the byte at nOffset, or NULL if the handle does not
+ * support it or if the range is not entirely within the file.
+ * @since GDAL 2.1
+ */
+
+const void *VSIFGetDirectPointerL( VSILFILE * fp, vsi_l_offset nOffset,
+                                   size_t nSize )
+{
+    VSIVirtualHandle *poFileHandle = (VSIVirtualHandle *) fp;
+
+    return poFileHandle->GetDirectPointer( nOffset, nSize );
+}
+
 /************************************************************************/
 /*                             VSIFWriteL()                             */
 /************************************************************************/
@@ -1315,3 +1406,19 @@ int VSIVirtualHandle::ReadMultiRange( int nRanges, void ** ppData,
 
     return nRet;
 }
+
+/************************************************************************/
+/*                               PRead()                                */
+/*                                                                      */
+/*      There is no safe generic implementation on top of Seek() and    */
+/*      Read(), so handles must override it with HasPRead().            */
+/************************************************************************/
+
+size_t VSIVirtualHandle::PRead( CPL_UNUSED void *pBuffer,
+                                CPL_UNUSED size_t nSize,
+                                CPL_UNUSED vsi_l_offset nOffset )
+{
+    CPLError( CE_Failure, CPLE_NotSupported,
+              "PRead() not supported on this file handle" );
+    return 0;
+}
@@ -35,6 +35,7 @@
 #include "cpl_vsil_curl_priv.h"
 #include "cpl_aws.h"
 #include "cpl_minixml.h"
+#include "cpl_sha256.h"
 
 CPL_CVSID("$Id$");
 
@@ -72,6 +73,18 @@ int VSICurlUninstallReadCbk(CPL_UNUSED VSILFILE* fp)
     return FALSE;
 }
 
+/************************************************************************/
+/*                    VSICurlGetCacheStatistics()                       */
+/************************************************************************/
+
+int VSICurlGetCacheStatistics(CPL_UNUSED const char* pszFilename,
+                              CPL_UNUSED GUIntBig* pnHits,
+                              CPL_UNUSED GUIntBig* pnMisses,
+                              CPL_UNUSED GUIntBig* pnCachedBytes)
+{
+    return FALSE;
+}
+
 #else
 
 #include <curl/curl.h>
@@ -80,11 +93,28 @@ void CPLHTTPSetOptions(CURL *http_handle, char** papszOptions);
 void VSICurlSetOptions(CURL* hCurlHandle, const char* pszURL);
 
 #include <map>
+#include <vector>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <process.h>
+#include <sys/utime.h>
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
 
 #define ENABLE_DEBUG 1
 
-static const int N_MAX_REGIONS = 1000;
+static const int N_MAX_BLOCKS_PER_DOWNLOAD = 1000;
 static const int DOWNLOAD_CHUNK_SIZE = 16384;
+/* Number of times VSICurlHandle::Read() downloads again a chunk that has */
+/* been evicted from the cache by other threads before it could be used */
+static const int N_MAX_EVICTED_RETRIES = 3;
+/* Default budget of the in-memory cache of downloaded chunks */
+static const GUIntBig N_DEFAULT_CACHE_SIZE = 16 * 1024 * 1024;
+/* Default size of the persistent disk cache */
+static const GUIntBig N_DEFAULT_DISK_CACHE_SIZE = 100 * 1024 * 1024;
 
 namespace {
 
@@ -102,6 +132,7 @@ typedef struct
     vsi_l_offset    fileSize;
     bool            bIsDirectory;
     time_t          mTime;
+    char           *pszETag; /* NULL if unknown */
 } CachedFileProp;
 
 typedef struct
@@ -110,12 +141,16 @@ typedef struct
     char**          papszFileList; /* only file name without path */
 } CachedDirList;
 
-typedef struct
+typedef struct CachedRegion
 {
     unsigned long   pszURLHash;
     vsi_l_offset    nFileOffsetStart;
     size_t          nSize;
     char           *pData;
+
+    /* Links in the LRU list of VSICurlFilesystemHandler */
+    CachedRegion   *psPrev; /* more recently used */
+    CachedRegion   *psNext; /* less recently used */
 } CachedRegion;
 
 typedef struct
@@ -139,11 +174,47 @@ typedef struct
     bool                bInterrupted;
 } WriteFuncStruct;
 
+/* One GET request of VSICurlHandle::ReadMultiRange(), covering the */
+/* ranges iFirstRange to iLastRange, once coalesced. */
+typedef struct
+{
+    CURL               *hCurlHandle;
+    struct curl_slist  *psHeaders;
+    WriteFuncStruct     sWriteFuncData;
+    WriteFuncStruct     sWriteFuncHeaderData;
+    char                szCurlErrBuf[CURL_ERROR_SIZE+1];
+    char                szRange[64];
+    vsi_l_offset        nStartOffset;
+    vsi_l_offset        nEndOffset;
+    int                 iFirstRange;
+    int                 iLastRange;
+    bool                bRunning;
+} RangeRequest;
+
 } /* end of anoymous namespace */
 
-static const char* VSICurlGetCacheFileName()
+/************************************************************************/
+/*                        VSICurlHashRegion()                           */
+/************************************************************************/
+
+static unsigned long VSICurlHashRegion(const void* elt)
+{
+    const CachedRegion* psRegion = (const CachedRegion*) elt;
+    const GUIntBig nChunk = psRegion->nFileOffsetStart / DOWNLOAD_CHUNK_SIZE;
+    return psRegion->pszURLHash ^
+           ((unsigned long)(nChunk ^ (nChunk >> 32)) * 2654435761U);
+}
+
+/************************************************************************/
+/*                        VSICurlEqualRegion()                          */
+/************************************************************************/
+
+static int VSICurlEqualRegion(const void* elt1, const void* elt2)
 {
-    return "gdal_vsicurl_cache.bin";
+    const CachedRegion* psRegion1 = (const CachedRegion*) elt1;
+    const CachedRegion* psRegion2 = (const CachedRegion*) elt2;
+    return psRegion1->pszURLHash == psRegion2->pszURLHash &&
+           psRegion1->nFileOffsetStart == psRegion2->nFileOffsetStart;
 }
 
 /************************************************************************/
@@ -212,6 +283,486 @@ static int VSICurlIsFileInList( char ** papszList, const char * pszTarget )
     return nRet;
 }
 
+/************************************************************************/
+/*                          VSICurlDiskCache                            */
+/*                                                                      */
+/*      Persistent cache of downloaded chunks, that can be shared by    */
+/*      several processes using the same directory.                     */
+/*                                                                      */
+/*      Each chunk is stored in its own file, whose name is derived     */
+/*      from the URL, the validator of the remote content (its ETag,    */
+/*      or its size) and the offset of the chunk. A file is written     */
+/*      under a temporary name and then renamed, so that readers never  */
+/*      see partial content, and its header is checked when it is read. */
+/*      The modification time of a file is refreshed when it is read,   */
+/*      and the least recently used files are removed when the cache    */
+/*      exceeds its size. To find them without scanning the whole       */
+/*      directory at once, each write scans a few of the 256            */
+/*      subdirectories, so that a complete pass is spread over the      */
+/*      writing of a tenth of the size of the cache. A process that     */
+/*      wrote less than that completes its pass when it is cleaned up.  */
+/************************************************************************/
+
+static const char VSICURL_DISK_CACHE_MAGIC[8] = { 'G','D','A','L','V','C','C','1' };
+
+typedef struct
+{
+    char            szMagic[8];
+    GUInt32         nURLSize;
+    GUInt32         nValidatorSize;
+    GUIntBig        nFileOffsetStart;
+    GUIntBig        nDataSize;
+    GUIntBig        nChecksum;  /* FNV-1a of the data */
+} VSICurlDiskCacheHeader;
+
+static const int N_DISK_CACHE_SUBDIRS = 256;
+
+typedef struct
+{
+    int             iSubDir;
+    CPLString       osFilename; /* in the subdirectory */
+    time_t          nMTime;
+    GUIntBig        nSize;
+} VSICurlDiskCacheEntry;
+
+static bool VSICurlDiskCacheEntryOlder(const VSICurlDiskCacheEntry& a,
+                                       const VSICurlDiskCacheEntry& b)
+{
+    return a.nMTime < b.nMTime;
+}
+
+class VSICurlDiskCache
+{
+    CPLString       osDirectory;
+    GUIntBig        nMaxSize;
+
+    CPLMutex       *hMutex;
+    int             nTempFileCounter;
+
+    /* Files of each subdirectory, as of its last scan, plus the ones */
+    /* written since then by this process */
+    std::vector< std::map<CPLString, VSICurlDiskCacheEntry> > aoSubDirs;
+    GUIntBig        nTotalSize;
+    int             nNextSubDirToScan;
+    int             nScannedSubDirs;
+    double          dfSubDirsToScan;
+    bool            bHasWritten;
+
+    CPLString       GetChunkFilename(const char* pszURL,
+                                     const char* pszValidator,
+                                     vsi_l_offset nFileOffsetStart);
+    CPLString       GetSubDirName(int iSubDir);
+    void            SetEntry(const VSICurlDiskCacheEntry& sEntry);
+    void            ScanSubDir(int iSubDir);
+    void            ScanNextSubDir();
+    void            Trim();
+
+  public:
+                    VSICurlDiskCache(const char* pszDirectory,
+                                     GUIntBig nMaxSizeIn);
+                   ~VSICurlDiskCache();
+
+    char*           Read(const char* pszURL, const char* pszValidator,
+                         vsi_l_offset nFileOffsetStart, size_t* pnSize);
+    void            Write(const char* pszURL, const char* pszValidator,
+                          vsi_l_offset nFileOffsetStart,
+                          const char* pData, size_t nSize);
+};
+
+/************************************************************************/
+/*                    VSICurlDiskCacheChecksum()                        */
+/************************************************************************/
+
+static GUIntBig VSICurlDiskCacheChecksum(const char* pData, size_t nSize)
+{
+    GUIntBig nHash = (((GUIntBig)0xCBF29CE4U) << 32) | 0x84222325U;
+    const GUIntBig nPrime = (((GUIntBig)0x100U) << 32) | 0x000001B3U;
+    for( size_t i = 0; i < nSize; i++ )
+    {
+        nHash ^= (GByte) pData[i];
+        nHash *= nPrime;
+    }
+    return nHash;
+}
+
+/************************************************************************/
+/*                       VSICurlDiskCacheTouch()                        */
+/************************************************************************/
+
+static void VSICurlDiskCacheTouch(const char* pszFilename)
+{
+#ifdef _WIN32
+    _utime(pszFilename, NULL);
+#else
+    utime(pszFilename, NULL);
+#endif
+}
+
+/************************************************************************/
+/*                         VSICurlDiskCache()                           */
+/************************************************************************/
+
+VSICurlDiskCache::VSICurlDiskCache(const char* pszDirectory,
+                                   GUIntBig nMaxSizeIn) :
+    osDirectory(pszDirectory),
+    nMaxSize(nMaxSizeIn),
+    hMutex(NULL),
+    nTempFileCounter(0),
+    aoSubDirs(N_DISK_CACHE_SUBDIRS),
+    nTotalSize(0),
+    nNextSubDirToScan(0),
+    nScannedSubDirs(0),
+    dfSubDirsToScan(0.0),
+    bHasWritten(false)
+{
+}
+
+/************************************************************************/
+/*                        ~VSICurlDiskCache()                           */
+/************************************************************************/
+
+VSICurlDiskCache::~VSICurlDiskCache()
+{
+    if( bHasWritten && nScannedSubDirs < N_DISK_CACHE_SUBDIRS )
+    {
+        CPLMutexHolder oHolder( &hMutex );
+        while( nScannedSubDirs < N_DISK_CACHE_SUBDIRS )
+            ScanNextSubDir();
+        if( nTotalSize > nMaxSize )
+            Trim();
+    }
+
+    if( hMutex != NULL )
+        CPLDestroyMutex( hMutex );
+}
+
+/************************************************************************/
+/*                         GetChunkFilename()                           */
+/************************************************************************/
+
+CPLString VSICurlDiskCache::GetChunkFilename(const char* pszURL,
+                                             const char* pszValidator,
+                                             vsi_l_offset nFileOffsetStart)
+{
+    CPL_SHA256Context sContext;
+    GByte abyHash[CPL_SHA256_HASH_SIZE];
+    CPL_SHA256Init(&sContext);
+    CPL_SHA256Update(&sContext, pszURL, strlen(pszURL) + 1);
+    CPL_SHA256Update(&sContext, pszValidator, strlen(pszValidator));
+    CPL_SHA256Final(&sContext, abyHash);
+
+    /* 128 bits of the hash are plenty to avoid collisions, and the name */
+    /* of the file is checked against its content anyway */
+    char* pszHex = CPLBinaryToHex(16, abyHash);
+    CPLString osFilename(CPLFormFilename(GetSubDirName(abyHash[0]),
+                            CPLSPrintf("%s_" CPL_FRMT_GUIB, pszHex + 2,
+                                       (GUIntBig)nFileOffsetStart), "bin"));
+    CPLFree(pszHex);
+    return osFilename;
+}
+
+/************************************************************************/
+/*                           GetSubDirName()                            */
+/************************************************************************/
+
+CPLString VSICurlDiskCache::GetSubDirName(int iSubDir)
+{
+    return CPLFormFilename(osDirectory, CPLSPrintf("%02X", iSubDir), NULL);
+}
+
+/************************************************************************/
+/*                               Read()                                 */
+/*                                                                      */
+/*      Return the content of a cached chunk, to free with CPLFree(),   */
+/*      or NULL if it is not in the cache.                              */
+/************************************************************************/
+
+char* VSICurlDiskCache::Read(const char* pszURL, const char* pszValidator,
+                             vsi_l_offset nFileOffsetStart, size_t* pnSize)
+{
+    CPLString osFilename(GetChunkFilename(pszURL, pszValidator,
+                                          nFileOffsetStart));
+
+    VSIStatBufL sStat;
+    if( VSIStatL(osFilename, &sStat) != 0 )
+        return NULL;
+    VSILFILE* fp = VSIFOpenL(osFilename, "rb");
+    if( fp == NULL )
+        return NULL;
+
+    const size_t nURLSize = strlen(pszURL);
+    const size_t nValidatorSize = strlen(pszValidator);
+    VSICurlDiskCacheHeader sHeader;
+    char* pszURLCached = NULL;
+    char* pData = NULL;
+    bool bValid =
+        VSIFReadL(&sHeader, sizeof(sHeader), 1, fp) == 1 &&
+        memcmp(sHeader.szMagic, VSICURL_DISK_CACHE_MAGIC, 8) == 0 &&
+        sHeader.nURLSize == nURLSize &&
+        sHeader.nValidatorSize == nValidatorSize &&
+        sHeader.nFileOffsetStart == nFileOffsetStart &&
+        sHeader.nDataSize > 0 &&
+        sHeader.nDataSize <= (GUIntBig)DOWNLOAD_CHUNK_SIZE &&
+        (GUIntBig)sStat.st_size == sizeof(sHeader) + nURLSize +
+                                   nValidatorSize + sHeader.nDataSize;
+    if( bValid )
+    {
+        pszURLCached = (char*) CPLMalloc(nURLSize + nValidatorSize + 1);
+        pData = (char*) CPLMalloc((size_t)sHeader.nDataSize);
+        bValid =
+            VSIFReadL(pszURLCached, 1, nURLSize + nValidatorSize, fp) ==
+                                                nURLSize + nValidatorSize &&
+            memcmp(pszURLCached, pszURL, nURLSize) == 0 &&
+            memcmp(pszURLCached + nURLSize, pszValidator, nValidatorSize) == 0 &&
+            VSIFReadL(pData, 1, (size_t)sHeader.nDataSize, fp) ==
+                                                (size_t)sHeader.nDataSize &&
+            VSICurlDiskCacheChecksum(pData, (size_t)sHeader.nDataSize) ==
+                                                        sHeader.nChecksum;
+        CPLFree(pszURLCached);
+    }
+    VSIFCloseL(fp);
+
+    if( !bValid )
+    {
+        /* Truncated or corrupted file, or (very unlikely) hash collision */
+        CPLDebug("VSICURL", "Removing invalid disk cache file %s",
+                 osFilename.c_str());
+        VSIUnlink(osFilename);
+        CPLFree(pData);
+        return NULL;
+    }
+
+    /* Refresh the modification time used to find the least recently */
+    /* used files, but not at every access */
+    if( time(NULL) - sStat.st_mtime > 60 )
+        VSICurlDiskCacheTouch(osFilename);
+
+    if (ENABLE_DEBUG)
+        CPLDebug("VSICURL", "Got data at offset " CPL_FRMT_GUIB " from disk" ,
+                 nFileOffsetStart);
+
+    *pnSize = (size_t)sHeader.nDataSize;
+    return pData;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+void VSICurlDiskCache::Write(const char* pszURL, const char* pszValidator,
+                             vsi_l_offset nFileOffsetStart,
+                             const char* pData, size_t nSize)
+{
+    if( nSize == 0 || nSize > (size_t)DOWNLOAD_CHUNK_SIZE )
+        return;
+
+    CPLString osFilename(GetChunkFilename(pszURL, pszValidator,
+                                          nFileOffsetStart));
+    CPLString osTmpFilename;
+    {
+        CPLMutexHolder oHolder( &hMutex );
+#ifdef _WIN32
+        const int nPID = _getpid();
+#else
+        const int nPID = getpid();
+#endif
+        osTmpFilename.Printf("%s.%d_%d.tmp", osFilename.c_str(),
+                             nPID, ++nTempFileCounter);
+    }
+
+    VSILFILE* fp = VSIFOpenL(osTmpFilename, "wb");
+    if( fp == NULL )
+    {
+        VSIMkdir(osDirectory, 0755);
+        VSIMkdir(CPLGetPath(osFilename), 0755);
+        fp = VSIFOpenL(osTmpFilename, "wb");
+        if( fp == NULL )
+        {
+            CPLDebug("VSICURL", "Cannot create %s", osTmpFilename.c_str());
+            return;
+        }
+    }
+
+    VSICurlDiskCacheHeader sHeader;
+    memset(&sHeader, 0, sizeof(sHeader));
+    memcpy(sHeader.szMagic, VSICURL_DISK_CACHE_MAGIC, 8);
+    sHeader.nURLSize = (GUInt32)strlen(pszURL);
+    sHeader.nValidatorSize = (GUInt32)strlen(pszValidator);
+    sHeader.nFileOffsetStart = nFileOffsetStart;
+    sHeader.nDataSize = nSize;
+    sHeader.nChecksum = VSICurlDiskCacheChecksum(pData, nSize);
+
+    bool bOK =
+        VSIFWriteL(&sHeader, sizeof(sHeader), 1, fp) == 1 &&
+        VSIFWriteL(pszURL, 1, sHeader.nURLSize, fp) == sHeader.nURLSize &&
+        VSIFWriteL(pszValidator, 1, sHeader.nValidatorSize, fp) ==
+                                                    sHeader.nValidatorSize &&
+        VSIFWriteL(pData, 1, nSize, fp) == nSize;
+    if( VSIFCloseL(fp) != 0 )
+        bOK = false;
+
+    /* Concurrent writers of the same chunk write the same content, so */
+    /* it does not matter which rename wins */
+    if( !bOK || VSIRename(osTmpFilename, osFilename) != 0 )
+    {
+        VSIUnlink(osTmpFilename);
+        return;
+    }
+
+    VSICurlDiskCacheEntry sEntry;
+    sEntry.iSubDir = (int) strtol(CPLGetFilename(CPLGetPath(osFilename)),
+                                  NULL, 16);
+    sEntry.osFilename = CPLGetFilename(osFilename);
+    sEntry.nMTime = time(NULL);
+    sEntry.nSize = sizeof(sHeader) + sHeader.nURLSize +
+                   sHeader.nValidatorSize + nSize;
+
+    CPLMutexHolder oHolder( &hMutex );
+    SetEntry(sEntry);
+    bHasWritten = true;
+
+    /* Scan the subdirectories at a pace such that all of them have been */
+    /* scanned once a tenth of the size of the cache has been written */
+    dfSubDirsToScan += (double) N_DISK_CACHE_SUBDIRS * sEntry.nSize /
+                       ((double) nMaxSize / 10 + 1);
+    if( dfSubDirsToScan > N_DISK_CACHE_SUBDIRS )
+        dfSubDirsToScan = N_DISK_CACHE_SUBDIRS;
+    for( ; dfSubDirsToScan >= 1.0; dfSubDirsToScan -= 1.0 )
+        ScanNextSubDir();
+
+    /* Until all subdirectories have been scanned, the size of the cache */
+    /* is not known */
+    if( nScannedSubDirs == N_DISK_CACHE_SUBDIRS && nTotalSize > nMaxSize )
+        Trim();
+}
+
+/************************************************************************/
+/*                              SetEntry()                              */
+/*                                                                      */
+/*      hMutex must be held by the caller.                              */
+/************************************************************************/
+
+void VSICurlDiskCache::SetEntry(const VSICurlDiskCacheEntry& sEntry)
+{
+    std::map<CPLString, VSICurlDiskCacheEntry>& oMap =
+                                                aoSubDirs[sEntry.iSubDir];
+    std::map<CPLString, VSICurlDiskCacheEntry>::iterator oIter =
+                                                oMap.find(sEntry.osFilename);
+    if( oIter != oMap.end() )
+    {
+        nTotalSize -= oIter->second.nSize;
+        oIter->second = sEntry;
+    }
+    else
+        oMap[sEntry.osFilename] = sEntry;
+    nTotalSize += sEntry.nSize;
+}
+
+/************************************************************************/
+/*                             ScanSubDir()                             */
+/*                                                                      */
+/*      Refresh the list of files of a subdirectory, which may have     */
+/*      been changed by other processes. hMutex must be held by the     */
+/*      caller.                                                         */
+/************************************************************************/
+
+void VSICurlDiskCache::ScanSubDir(int iSubDir)
+{
+    std::map<CPLString, VSICurlDiskCacheEntry>& oMap = aoSubDirs[iSubDir];
+    std::map<CPLString, VSICurlDiskCacheEntry>::const_iterator oIter;
+    for( oIter = oMap.begin(); oIter != oMap.end(); ++oIter )
+        nTotalSize -= oIter->second.nSize;
+    oMap.clear();
+
+    const time_t nNow = time(NULL);
+    CPLString osSubDir(GetSubDirName(iSubDir));
+    char** papszFiles = VSIReadDir(osSubDir);
+    for( int i = 0; papszFiles != NULL && papszFiles[i] != NULL; i++ )
+    {
+        CPLString osFilename(CPLFormFilename(osSubDir, papszFiles[i], NULL));
+        VSIStatBufL sStat;
+        if( VSIStatL(osFilename, &sStat) != 0 || !VSI_ISREG(sStat.st_mode) )
+            continue;
+
+        if( EQUAL(CPLGetExtension(papszFiles[i]), "tmp") )
+        {
+            /* Left over by a process that crashed while writing */
+            if( nNow - sStat.st_mtime > 3600 )
+                VSIUnlink(osFilename);
+            continue;
+        }
+
+        VSICurlDiskCacheEntry sEntry;
+        sEntry.iSubDir = iSubDir;
+        sEntry.osFilename = papszFiles[i];
+        sEntry.nMTime = sStat.st_mtime;
+        sEntry.nSize = sStat.st_size;
+        oMap[sEntry.osFilename] = sEntry;
+        nTotalSize += sEntry.nSize;
+    }
+    CSLDestroy(papszFiles);
+}
+
+/************************************************************************/
+/*                           ScanNextSubDir()                           */
+/************************************************************************/
+
+void VSICurlDiskCache::ScanNextSubDir()
+{
+    ScanSubDir(nNextSubDirToScan);
+    nNextSubDirToScan = (nNextSubDirToScan + 1) % N_DISK_CACHE_SUBDIRS;
+    if( nScannedSubDirs < N_DISK_CACHE_SUBDIRS )
+        nScannedSubDirs ++;
+}
+
+/************************************************************************/
+/*                                Trim()                                */
+/*                                                                      */
+/*      Remove the least recently used files until the cache is below   */
+/*      90% of its maximum size. Files read by other processes since    */
+/*      the scan of their subdirectory have a more recent modification  */
+/*      time, which is checked before removing them. Several processes  */
+/*      may trim at the same time: this only causes a few more files    */
+/*      to be removed. hMutex must be held by the caller.               */
+/************************************************************************/
+
+void VSICurlDiskCache::Trim()
+{
+    std::vector<VSICurlDiskCacheEntry> aoEntries;
+    for( int i = 0; i < N_DISK_CACHE_SUBDIRS; i++ )
+    {
+        std::map<CPLString, VSICurlDiskCacheEntry>::const_iterator oIter;
+        for( oIter = aoSubDirs[i].begin(); oIter != aoSubDirs[i].end(); ++oIter )
+            aoEntries.push_back(oIter->second);
+    }
+    std::sort(aoEntries.begin(), aoEntries.end(), VSICurlDiskCacheEntryOlder);
+
+    const GUIntBig nTargetSize = nMaxSize / 10 * 9;
+    size_t nRemoved = 0;
+    for( size_t i = 0; i < aoEntries.size() && nTotalSize > nTargetSize; i++ )
+    {
+        const VSICurlDiskCacheEntry& sEntry = aoEntries[i];
+        CPLString osFilename(CPLFormFilename(GetSubDirName(sEntry.iSubDir),
+                                             sEntry.osFilename, NULL));
+        VSIStatBufL sStat;
+        if( VSIStatL(osFilename, &sStat) == 0 && sStat.st_mtime > sEntry.nMTime )
+        {
+            VSICurlDiskCacheEntry sNewEntry(sEntry);
+            sNewEntry.nMTime = sStat.st_mtime;
+            SetEntry(sNewEntry);
+            continue;
+        }
+
+        VSIUnlink(osFilename);
+        aoSubDirs[sEntry.iSubDir].erase(sEntry.osFilename);
+        nTotalSize -= sEntry.nSize;
+        nRemoved ++;
+    }
+    if (ENABLE_DEBUG)
+        CPLDebug("VSICURL", "Removed %d files from disk cache %s",
+                 (int)nRemoved, osDirectory.c_str());
+}
+
 /************************************************************************/
 /*                     VSICurlFilesystemHandler                         */
 /************************************************************************/
@@ -220,19 +771,30 @@ typedef struct
 {
     CPLString       osURL;
     CURL           *hCurlHandle;
+    CURLM          *hCurlMultiHandle;
 } CachedConnection;
 
 class VSICurlHandle;
 
 class VSICurlFilesystemHandler : public VSIFilesystemHandler 
 {
-    CachedRegion  **papsRegions;
-    int             nRegions;
+    /* Cache of downloaded chunks, indexed by (URL hash, chunk offset) */
+    /* and chained from the most recently used to the least recently used */
+    CPLHashSet     *hSetRegions;
+    CachedRegion   *psRegionsHead;
+    CachedRegion   *psRegionsTail;
+    GUIntBig        nCachedBytes;
+    GUIntBig        nMaxCachedBytes;    /* 0 until read from the config */
+    GUIntBig        nRegionHits;
+    GUIntBig        nRegionMisses;
 
     std::map<CPLString, CachedFileProp*>   cacheFileSize;
     std::map<CPLString, CachedDirList*>        cacheDirList;
 
-    int             bUseCacheDisk;
+    /* Persistent cache of downloaded chunks, or NULL. Created at first */
+    /* use, so that it can be configured after the handler installation */
+    bool              bDiskCacheInitialized;
+    VSICurlDiskCache *poDiskCache;
 
     /* Per-thread Curl connection cache */
     std::map<GIntBig, CachedConnection*> mapConnections;
@@ -242,6 +804,18 @@ class VSICurlFilesystemHandler : public VSIFilesystemHandler
                                           char* pszData,
                                           bool* pbGotFileList);
 
+    CachedRegion*       FindRegion(unsigned long pszURLHash,
+                                   vsi_l_offset nFileOffsetStart);
+    GUIntBig            GetMaxCachedBytes();
+    void                UnlinkRegion(CachedRegion* psRegion);
+    void                DeleteRegion(CachedRegion* psRegion);
+    CachedRegion*       AddRegionToMemoryCache(unsigned long pszURLHash,
+                                               vsi_l_offset nFileOffsetStart,
+                                               size_t nSize,
+                                               char* pData);
+    VSICurlDiskCache   *GetDiskCache();
+    CPLString           GetDiskCacheValidator(const char* pszURL);
+
 protected:
     CPLMutex       *hMutex;
 
@@ -272,8 +846,15 @@ public:
             void     InvalidateDirContent( const char *pszDirname );
 
 
-    const CachedRegion* GetRegion(const char*     pszURL,
-                                  vsi_l_offset    nFileOffsetStart);
+    bool                CopyRegion(const char*    pszURL,
+                                   vsi_l_offset   nOffset,
+                                   void*          pDst,
+                                   size_t         nMaxSize,
+                                   size_t*        pnCopied,
+                                   size_t*        pnRegionSize);
+    bool                IsRegionCached(const char*     pszURL,
+                                       vsi_l_offset    nOffset)
+        { return CopyRegion(pszURL, nOffset, NULL, 0, NULL, NULL); }
 
     void                AddRegion(const char*     pszURL,
                                   vsi_l_offset    nFileOffsetStart,
@@ -282,12 +863,17 @@ public:
 
     CachedFileProp*     GetCachedFileProp(const char*     pszURL);
     void                InvalidateCachedFileProp(const char*     pszURL);
+    void                SetCachedFileETag(const char* pszURL,
+                                          const char* pszETag);
 
-    void                AddRegionToCacheDisk(CachedRegion* psRegion);
-    const CachedRegion* GetRegionFromCacheDisk(const char*     pszURL,
-                                               vsi_l_offset nFileOffsetStart);
 
     CURL               *GetCurlHandleFor(CPLString osURL);
+    CURLM              *GetCurlMultiHandleFor(CPLString osURL);
+
+    int                 GetMaxBlocksPerDownload();
+    void                GetCacheStatistics(GUIntBig* pnHits,
+                                           GUIntBig* pnMisses,
+                                           GUIntBig* pnCachedBytes);
 };
 
 /************************************************************************/
@@ -317,6 +903,10 @@ class VSICurlHandle : public VSIVirtualHandle
 
     bool            DownloadRegion(vsi_l_offset startOffset, int nBlocks);
 
+    int             ReadMultiRangeSingleGet( int nRanges, void ** ppData,
+                                             const vsi_l_offset* panOffsets,
+                                             const size_t* panSizes );
+
     VSICurlReadCbkFunc  pfnReadCbk;
     void               *pReadCbkUserData;
     bool                bStopOnInterrruptUntilUninstall;
@@ -605,6 +1195,35 @@ static size_t VSICurlHandleWriteFunc(void *buffer, size_t count, size_t nmemb, v
 }
 
 
+/************************************************************************/
+/*                          VSICurlGetETag()                            */
+/*                                                                      */
+/*      Return the value of the last ETag header found in pszHeaders.   */
+/************************************************************************/
+
+static CPLString VSICurlGetETag(const char* pszHeaders)
+{
+    CPLString osETag;
+    const char* pszIter = pszHeaders;
+    while( pszIter != NULL && *pszIter != '\0' )
+    {
+        if( STARTS_WITH_CI(pszIter, "ETag:") )
+        {
+            const char* pszValue = pszIter + 5;
+            while( *pszValue == ' ' )
+                pszValue ++;
+            const char* pszEnd = pszValue;
+            while( *pszEnd != '\0' && *pszEnd != '\r' && *pszEnd != '\n' )
+                pszEnd ++;
+            osETag.assign(pszValue, pszEnd - pszValue);
+        }
+        pszIter = strchr(pszIter, '\n');
+        if( pszIter != NULL )
+            pszIter ++;
+    }
+    return osETag;
+}
+
 /************************************************************************/
 /*                           GetFileSize()                              */
 /************************************************************************/
@@ -824,6 +1443,18 @@ vsi_l_offset VSICurlHandle::GetFileSize()
                     pszURL, fileSize, (int)response_code);
     }
 
+    /* The ETag identifies the content in the disk cache */
+    if (eExists == EXIST_YES)
+    {
+        CPLString osETag;
+        if( sWriteFuncHeaderData.pBuffer != NULL )
+            osETag = VSICurlGetETag(sWriteFuncHeaderData.pBuffer);
+        else if( osVerb == "HEAD" && sWriteFuncData.pBuffer != NULL )
+            osETag = VSICurlGetETag(sWriteFuncData.pBuffer);
+        if( !osETag.empty() )
+            poFS->SetCachedFileETag(pszURL, osETag);
+    }
+
     CPLFree(sWriteFuncData.pBuffer);
     CPLFree(sWriteFuncHeaderData.pBuffer);
 
@@ -1069,11 +1700,26 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const  nSize, size_t
     //CPLDebug("VSICURL", "offset=%d, size=%d", (int)curOffset, (int)nBufferRequestSize);
 
     vsi_l_offset iterOffset = curOffset;
+    int nRetries = 0;
     while (nBufferRequestSize)
     {
-        const CachedRegion* psRegion = poFS->GetRegion(pszURL, iterOffset);
-        if (psRegion == NULL)
+        size_t nToCopy = 0;
+        size_t nRegionSize = 0;
+        if (!poFS->CopyRegion(pszURL, iterOffset, pBuffer, nBufferRequestSize,
+                              &nToCopy, &nRegionSize))
         {
+            /* The chunk was just downloaded, but evicted by other threads */
+            /* before we could copy it. Do not loop forever though. */
+            if (nRetries == N_MAX_EVICTED_RETRIES)
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Downloaded data for %s evicted from the cache "
+                         "before being used. CPL_VSIL_CURL_CACHE_SIZE should "
+                         "be increased", pszURL);
+                bEOF = true;
+                return 0;
+            }
+
             vsi_l_offset nOffsetToDownload =
                 (iterOffset / DOWNLOAD_CHUNK_SIZE) * DOWNLOAD_CHUNK_SIZE;
 
@@ -1105,15 +1751,18 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const  nSize, size_t
             /* Avoid reading already cached data */
             for(i=1;i<nBlocksToDownload;i++)
             {
-                if (poFS->GetRegion(pszURL, nOffsetToDownload + i * DOWNLOAD_CHUNK_SIZE) != NULL)
+                if (poFS->IsRegionCached(pszURL, nOffsetToDownload + i * DOWNLOAD_CHUNK_SIZE))
                 {
                     nBlocksToDownload = i;
                     break;
                 }
             }
 
-            if( nBlocksToDownload > N_MAX_REGIONS )
-                nBlocksToDownload = N_MAX_REGIONS;
+            /* Do not download more than what the cache can hold, otherwise */
+            /* the first blocks would be evicted before being used */
+            const int nMaxBlocks = poFS->GetMaxBlocksPerDownload();
+            if( nBlocksToDownload > nMaxBlocks )
+                nBlocksToDownload = nMaxBlocks;
 
             if (DownloadRegion(nOffsetToDownload, nBlocksToDownload) == false)
             {
@@ -1121,20 +1770,19 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const  nSize, size_t
                     bEOF = true;
                 return 0;
             }
-            psRegion = poFS->GetRegion(pszURL, iterOffset);
+            nRetries ++;
+            continue;
         }
-        if (psRegion == NULL || psRegion->pData == NULL)
+        nRetries = 0;
+        if (nToCopy == 0)
         {
             bEOF = true;
             return 0;
         }
-        int nToCopy = (int) MIN(nBufferRequestSize, psRegion->nSize - (iterOffset - psRegion->nFileOffsetStart));
-        memcpy(pBuffer, psRegion->pData + iterOffset - psRegion->nFileOffsetStart,
-                nToCopy);
         pBuffer = (char*) pBuffer + nToCopy;
         iterOffset += nToCopy;
         nBufferRequestSize -= nToCopy;
-        if (psRegion->nSize != (size_t)DOWNLOAD_CHUNK_SIZE && nBufferRequestSize != 0)
+        if (nRegionSize != (size_t)DOWNLOAD_CHUNK_SIZE && nBufferRequestSize != 0)
         {
             break;
         }
@@ -1157,6 +1805,258 @@ size_t VSICurlHandle::Read( void * const pBufferIn, size_t const  nSize, size_t
 int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
                                    const vsi_l_offset* const panOffsets,
                                    const size_t* const panSizes )
+{
+    if (bInterrupted && bStopOnInterrruptUntilUninstall)
+        return FALSE;
+
+    CachedFileProp* cachedFileProp = poFS->GetCachedFileProp(pszURL);
+    if (cachedFileProp->eExists == EXIST_NO)
+        return -1;
+
+    const char* pszMultiRange =
+        CPLGetConfigOption("CPL_VSIL_CURL_MULTIRANGE", "PARALLEL");
+    if( EQUAL(pszMultiRange, "SINGLE_GET") )
+        return ReadMultiRangeSingleGet(nRanges, ppData, panOffsets, panSizes);
+
+    int nMaxConcurrent = 1;
+    if( !EQUAL(pszMultiRange, "SERIAL") )
+    {
+        nMaxConcurrent = atoi(
+            CPLGetConfigOption("CPL_VSIL_CURL_MAX_CONCURRENT_RANGES", "10"));
+        if( nMaxConcurrent <= 0 )
+            nMaxConcurrent = 10;
+    }
+    const vsi_l_offset nMaxGap = CPLScanUIntBig(
+        CPLGetConfigOption("CPL_VSIL_CURL_MULTIRANGE_MAX_GAP", "4096"), 20);
+
+/* -------------------------------------------------------------------- */
+/*      Coalesce ranges separated by at most nMaxGap bytes in a single  */
+/*      GET request. The bytes of the gaps are downloaded and           */
+/*      discarded, which is usually cheaper than an extra request.      */
+/* -------------------------------------------------------------------- */
+    std::vector<RangeRequest> asRequests;
+    for( int i = 0; i < nRanges; )
+    {
+        RangeRequest sRequest;
+        memset(&sRequest, 0, sizeof(sRequest));
+        sRequest.nStartOffset = panOffsets[i];
+        sRequest.nEndOffset = panOffsets[i] + panSizes[i];
+        sRequest.iFirstRange = i;
+        i ++;
+        while( i < nRanges && panOffsets[i] >= sRequest.nEndOffset &&
+               panOffsets[i] - sRequest.nEndOffset <= nMaxGap )
+        {
+            sRequest.nEndOffset = panOffsets[i] + panSizes[i];
+            i ++;
+        }
+        sRequest.iLastRange = i - 1;
+        // nEndOffset is inclusive in the request
+        if( sRequest.nEndOffset > sRequest.nStartOffset )
+            sRequest.nEndOffset --;
+        asRequests.push_back(sRequest);
+    }
+
+    if (ENABLE_DEBUG)
+        CPLDebug("VSICURL", "Downloading %d ranges in %d request(s), "
+                 "%d at a time (%s)...",
+                 nRanges, static_cast<int>(asRequests.size()),
+                 nMaxConcurrent, pszURL);
+
+/* -------------------------------------------------------------------- */
+/*      Prepare one easy handle per request.                            */
+/* -------------------------------------------------------------------- */
+    CURLM* hMultiHandle = poFS->GetCurlMultiHandleFor(pszURL);
+    const bool bIsHTTP = STARTS_WITH(pszURL, "http");
+    for( size_t i = 0; i < asRequests.size(); i++ )
+    {
+        RangeRequest* psRequest = &asRequests[i];
+        psRequest->hCurlHandle = curl_easy_init();
+        VSICurlSetOptions(psRequest->hCurlHandle, pszURL);
+
+        VSICURLInitWriteFuncStruct(&psRequest->sWriteFuncData, (VSILFILE*)this,
+                                   pfnReadCbk, pReadCbkUserData);
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_WRITEDATA,
+                         &psRequest->sWriteFuncData);
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_WRITEFUNCTION,
+                         VSICurlHandleWriteFunc);
+
+        VSICURLInitWriteFuncStruct(&psRequest->sWriteFuncHeaderData,
+                                   NULL, NULL, NULL);
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_HEADERDATA,
+                         &psRequest->sWriteFuncHeaderData);
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_HEADERFUNCTION,
+                         VSICurlHandleWriteFunc);
+        psRequest->sWriteFuncHeaderData.bIsHTTP = bIsHTTP;
+        psRequest->sWriteFuncHeaderData.nStartOffset = psRequest->nStartOffset;
+        psRequest->sWriteFuncHeaderData.nEndOffset = psRequest->nEndOffset;
+
+        snprintf(psRequest->szRange, sizeof(psRequest->szRange),
+                 CPL_FRMT_GUIB "-" CPL_FRMT_GUIB,
+                 psRequest->nStartOffset, psRequest->nEndOffset);
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_RANGE,
+                         psRequest->szRange);
+
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_ERRORBUFFER,
+                         psRequest->szCurlErrBuf );
+        curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_PRIVATE, psRequest);
+
+        psRequest->psHeaders = GetCurlHeaders("GET");
+        if( psRequest->psHeaders != NULL )
+            curl_easy_setopt(psRequest->hCurlHandle, CURLOPT_HTTPHEADER,
+                             psRequest->psHeaders);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Run them, with at most nMaxConcurrent at a time.                */
+/* -------------------------------------------------------------------- */
+    size_t iNextRequest = 0;
+    int nActive = 0;
+    while( iNextRequest < asRequests.size() && nActive < nMaxConcurrent )
+    {
+        asRequests[iNextRequest].bRunning = true;
+        curl_multi_add_handle(hMultiHandle,
+                              asRequests[iNextRequest].hCurlHandle);
+        iNextRequest ++;
+        nActive ++;
+    }
+
+    int nStillRunning = 0;
+    while (curl_multi_perform(hMultiHandle, &nStillRunning) == CURLM_CALL_MULTI_PERFORM);
+    while( nActive > 0 )
+    {
+        CURLMsg *psMsg;
+        int nMsgsInQueue;
+        while( (psMsg = curl_multi_info_read(hMultiHandle,
+                                             &nMsgsInQueue)) != NULL )
+        {
+            if( psMsg->msg != CURLMSG_DONE )
+                continue;
+            RangeRequest* psDoneRequest = NULL;
+            curl_easy_getinfo(psMsg->easy_handle, CURLINFO_PRIVATE,
+                              &psDoneRequest);
+            psDoneRequest->bRunning = false;
+            curl_multi_remove_handle(hMultiHandle, psMsg->easy_handle);
+            nActive --;
+            if( iNextRequest < asRequests.size() )
+            {
+                asRequests[iNextRequest].bRunning = true;
+                curl_multi_add_handle(hMultiHandle,
+                                      asRequests[iNextRequest].hCurlHandle);
+                iNextRequest ++;
+                nActive ++;
+            }
+        }
+        if( nActive == 0 )
+            break;
+
+        fd_set fdread, fdwrite, fdexcep;
+        int nMaxFD = -1;
+        FD_ZERO(&fdread);
+        FD_ZERO(&fdwrite);
+        FD_ZERO(&fdexcep);
+        curl_multi_fdset(hMultiHandle, &fdread, &fdwrite, &fdexcep, &nMaxFD);
+        if( nMaxFD >= 0 )
+        {
+            struct timeval timeout;
+            timeout.tv_sec = 0;
+            timeout.tv_usec = 100000;
+            if( select(nMaxFD + 1, &fdread, &fdwrite, &fdexcep, &timeout) < 0 )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined, "select() failed");
+                break;
+            }
+        }
+        else
+        {
+            CPLSleep(0.01);
+        }
+        while (curl_multi_perform(hMultiHandle, &nStillRunning) == CURLM_CALL_MULTI_PERFORM);
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Check the results and dispatch the data.                        */
+/* -------------------------------------------------------------------- */
+    int nRet = 0;
+    for( size_t i = 0; i < asRequests.size(); i++ )
+    {
+        RangeRequest* psRequest = &asRequests[i];
+
+        // Only after a select() failure
+        if( psRequest->bRunning )
+            curl_multi_remove_handle(hMultiHandle, psRequest->hCurlHandle);
+
+        if( nRet == 0 )
+        {
+            long response_code = 0;
+            curl_easy_getinfo(psRequest->hCurlHandle, CURLINFO_HTTP_CODE,
+                              &response_code);
+
+            if( psRequest->sWriteFuncData.bInterrupted )
+            {
+                bInterrupted = true;
+                nRet = -1;
+            }
+            else if ((response_code != 200 && response_code != 206 &&
+                      response_code != 225 && response_code != 226 &&
+                      response_code != 426) ||
+                     psRequest->sWriteFuncHeaderData.bError)
+            {
+                if (response_code >= 400 && psRequest->szCurlErrBuf[0] != '\0')
+                {
+                    if (strcmp(psRequest->szCurlErrBuf, "Couldn't use REST") == 0)
+                        CPLError(CE_Failure, CPLE_AppDefined, "%d: %s, %s",
+                                 (int)response_code, psRequest->szCurlErrBuf,
+                                 "Range downloading not supported by this server !");
+                    else
+                        CPLError(CE_Failure, CPLE_AppDefined, "%d: %s",
+                                 (int)response_code, psRequest->szCurlErrBuf);
+                }
+                nRet = -1;
+            }
+            else if( (vsi_l_offset)psRequest->sWriteFuncData.nSize <
+                     psRequest->nEndOffset - psRequest->nStartOffset + 1 )
+            {
+                CPLError(CE_Failure, CPLE_AppDefined,
+                         "Got only %u bytes for range %s",
+                         static_cast<unsigned int>(
+                             psRequest->sWriteFuncData.nSize),
+                         psRequest->szRange);
+                nRet = -1;
+            }
+            else
+            {
+                for( int j = psRequest->iFirstRange;
+                     j <= psRequest->iLastRange; j++ )
+                {
+                    memcpy(ppData[j],
+                           psRequest->sWriteFuncData.pBuffer +
+                                (panOffsets[j] - psRequest->nStartOffset),
+                           panSizes[j]);
+                }
+            }
+        }
+
+        curl_easy_cleanup(psRequest->hCurlHandle);
+        if( psRequest->psHeaders != NULL )
+            curl_slist_free_all(psRequest->psHeaders);
+        CPLFree(psRequest->sWriteFuncData.pBuffer);
+        CPLFree(psRequest->sWriteFuncHeaderData.pBuffer);
+    }
+
+    return nRet;
+}
+
+/************************************************************************/
+/*                      ReadMultiRangeSingleGet()                       */
+/*                                                                      */
+/*      Request all the ranges in a single GET, whose answer is a       */
+/*      multipart/byteranges document. Not all servers support it.      */
+/************************************************************************/
+
+int VSICurlHandle::ReadMultiRangeSingleGet( int const nRanges,
+                                            void ** const ppData,
+                                            const vsi_l_offset* const panOffsets,
+                                            const size_t* const panSizes )
 {
     WriteFuncStruct sWriteFuncData;
     WriteFuncStruct sWriteFuncHeaderData;
@@ -1201,10 +2101,10 @@ int VSICurlHandle::ReadMultiRange( int const nRanges, void ** const ppData,
     if (nMergedRanges > nMaxRanges)
     {
         int nHalf = nRanges / 2;
-        int nRet = ReadMultiRange(nHalf, ppData, panOffsets, panSizes);
+        int nRet = ReadMultiRangeSingleGet(nHalf, ppData, panOffsets, panSizes);
         if (nRet != 0)
             return nRet;
-        return ReadMultiRange(nRanges - nHalf, ppData + nHalf, panOffsets + nHalf, panSizes + nHalf);
+        return ReadMultiRangeSingleGet(nRanges - nHalf, ppData + nHalf, panOffsets + nHalf, panSizes + nHalf);
     }
 
     CURL* hCurlHandle = poFS->GetCurlHandleFor(pszURL);
@@ -1556,9 +2456,15 @@ int       VSICurlHandle::Close()
 VSICurlFilesystemHandler::VSICurlFilesystemHandler()
 {
     hMutex = NULL;
-    papsRegions = NULL;
-    nRegions = 0;
-    bUseCacheDisk = CSLTestBoolean(CPLGetConfigOption("CPL_VSIL_CURL_USE_CACHE", "NO"));
+    hSetRegions = CPLHashSetNew(VSICurlHashRegion, VSICurlEqualRegion, NULL);
+    psRegionsHead = NULL;
+    psRegionsTail = NULL;
+    nCachedBytes = 0;
+    nMaxCachedBytes = 0;
+    nRegionHits = 0;
+    nRegionMisses = 0;
+    bDiskCacheInitialized = false;
+    poDiskCache = NULL;
 }
 
 /************************************************************************/
@@ -1567,18 +2473,28 @@ VSICurlFilesystemHandler::VSICurlFilesystemHandler()
 
 VSICurlFilesystemHandler::~VSICurlFilesystemHandler()
 {
-    int i;
-    for(i=0;i<nRegions;i++)
+    if (ENABLE_DEBUG && (nRegionHits || nRegionMisses))
+        CPLDebug("VSICURL", "Chunk cache: " CPL_FRMT_GUIB " hits, "
+                 CPL_FRMT_GUIB " misses",
+                 nRegionHits, nRegionMisses);
+
+    CachedRegion* psRegion = psRegionsHead;
+    while( psRegion != NULL )
     {
-        CPLFree(papsRegions[i]->pData);
-        CPLFree(papsRegions[i]);
+        CachedRegion* psNext = psRegion->psNext;
+        CPLFree(psRegion->pData);
+        CPLFree(psRegion);
+        psRegion = psNext;
     }
-    CPLFree(papsRegions);
+    CPLHashSetDestroy(hSetRegions);
+
+    delete poDiskCache;
 
     std::map<CPLString, CachedFileProp*>::const_iterator iterCacheFileSize;
 
     for( iterCacheFileSize = cacheFileSize.begin(); iterCacheFileSize != cacheFileSize.end(); iterCacheFileSize++ )
     {
+        CPLFree(iterCacheFileSize->second->pszETag);
         CPLFree(iterCacheFileSize->second);
     }
 
@@ -1594,6 +2510,8 @@ VSICurlFilesystemHandler::~VSICurlFilesystemHandler()
     for( iterConnections = mapConnections.begin(); iterConnections != mapConnections.end(); iterConnections++ )
     {
         curl_easy_cleanup(iterConnections->second->hCurlHandle);
+        if( iterConnections->second->hCurlMultiHandle != NULL )
+            curl_multi_cleanup(iterConnections->second->hCurlMultiHandle);
         delete iterConnections->second;
     }
 
@@ -1619,6 +2537,7 @@ CURL* VSICurlFilesystemHandler::GetCurlHandleFor(CPLString osURL)
         CachedConnection* psCachedConnection = new CachedConnection;
         psCachedConnection->osURL = osURL;
         psCachedConnection->hCurlHandle = hCurlHandle;
+        psCachedConnection->hCurlMultiHandle = NULL;
         mapConnections[CPLGetPID()] = psCachedConnection;
         return hCurlHandle;
     }
@@ -1649,147 +2568,164 @@ CURL* VSICurlFilesystemHandler::GetCurlHandleFor(CPLString osURL)
     }
 }
 
-
 /************************************************************************/
-/*                   GetRegionFromCacheDisk()                           */
+/*                      GetCurlMultiHandleFor()                         */
+/*                                                                      */
+/*      Return the per-thread multi handle. Easy handles attached to    */
+/*      it share its connection cache, which is thus kept alive         */
+/*      between successive ReadMultiRange() calls.                      */
 /************************************************************************/
 
-const CachedRegion* 
-VSICurlFilesystemHandler::GetRegionFromCacheDisk(const char* pszURL,
-                                                 vsi_l_offset nFileOffsetStart)
+CURLM* VSICurlFilesystemHandler::GetCurlMultiHandleFor(CPLString osURL)
 {
-    nFileOffsetStart = (nFileOffsetStart / DOWNLOAD_CHUNK_SIZE) * DOWNLOAD_CHUNK_SIZE;
-    VSILFILE* fp = VSIFOpenL(VSICurlGetCacheFileName(), "rb");
-    if (fp)
-    {
-        unsigned long   pszURLHash = CPLHashSetHashStr(pszURL);
-        unsigned long   pszURLHashCached;
-        vsi_l_offset    nFileOffsetStartCached;
-        size_t          nSizeCached;
-        while(true)
-        {
-            if (VSIFReadL(&pszURLHashCached, sizeof(unsigned long), 1, fp) == 0)
-                break;
-            if( VSIFReadL(&nFileOffsetStartCached, sizeof(vsi_l_offset), 1, fp) == 0)
-                break;
-            if( VSIFReadL(&nSizeCached, sizeof(size_t), 1, fp) == 0)
-                break;
-            if (pszURLHash == pszURLHashCached &&
-                nFileOffsetStart == nFileOffsetStartCached)
-            {
-                if (ENABLE_DEBUG)
-                    CPLDebug("VSICURL", "Got data at offset " CPL_FRMT_GUIB " from disk" , nFileOffsetStart);
-                if (nSizeCached)
-                {
-                    char* pBuffer = (char*) CPLMalloc(nSizeCached);
-                    if( VSIFReadL(pBuffer, 1, nSizeCached, fp) != nSizeCached )
-                    {
-                        CPLFree(pBuffer);
-                        break;
-                    }
-                    AddRegion(pszURL, nFileOffsetStart, nSizeCached, pBuffer);
-                    CPLFree(pBuffer);
-                }
-                else
-                {
-                    AddRegion(pszURL, nFileOffsetStart, 0, NULL);
-                }
-                VSIFCloseL(fp);
-                return GetRegion(pszURL, nFileOffsetStart);
-            }
-            else
-            {
-                if( VSIFSeekL(fp, nSizeCached, SEEK_CUR) != 0 )
-                    break;
-            }
-        }
-        VSIFCloseL(fp);
-    }
-    return NULL;
+    GetCurlHandleFor(osURL);
+
+    CPLMutexHolder oHolder( &hMutex );
+
+    CachedConnection* psCachedConnection = mapConnections[CPLGetPID()];
+    if( psCachedConnection->hCurlMultiHandle == NULL )
+        psCachedConnection->hCurlMultiHandle = curl_multi_init();
+    return psCachedConnection->hCurlMultiHandle;
 }
 
 
 /************************************************************************/
-/*                  AddRegionToCacheDisk()                                */
+/*                            FindRegion()                              */
+/*                                                                      */
+/*      Look for a cached chunk and, if found, move it at the head of   */
+/*      the LRU list. hMutex must be held by the caller.                */
 /************************************************************************/
 
-void VSICurlFilesystemHandler::AddRegionToCacheDisk(CachedRegion* psRegion)
+CachedRegion* VSICurlFilesystemHandler::FindRegion(unsigned long pszURLHash,
+                                                   vsi_l_offset nFileOffsetStart)
 {
-    VSILFILE* fp = VSIFOpenL(VSICurlGetCacheFileName(), "r+b");
-    if (fp)
-    {
-        unsigned long   pszURLHashCached;
-        vsi_l_offset    nFileOffsetStartCached;
-        size_t          nSizeCached;
-        while(true)
-        {
-            if (VSIFReadL(&pszURLHashCached, 1, sizeof(unsigned long), fp) == 0)
-                break;
-            if( VSIFReadL(&nFileOffsetStartCached, sizeof(vsi_l_offset), 1, fp) == 0 )
-                break;
-            if( VSIFReadL(&nSizeCached, sizeof(size_t), 1, fp) == 0 )
-                break;
-            if (psRegion->pszURLHash == pszURLHashCached &&
-                psRegion->nFileOffsetStart == nFileOffsetStartCached)
-            {
-                CPLAssert(psRegion->nSize == nSizeCached);
-                VSIFCloseL(fp);
-                return;
-            }
-            else
-            {
-                if( VSIFSeekL(fp, nSizeCached, SEEK_CUR) != 0 )
-                    break;
-            }
-        }
-    }
-    else
+    CachedRegion sKey;
+    sKey.pszURLHash = pszURLHash;
+    sKey.nFileOffsetStart = nFileOffsetStart;
+
+    CachedRegion* psRegion = (CachedRegion*) CPLHashSetLookup(hSetRegions, &sKey);
+    if (psRegion == NULL)
+        return NULL;
+
+    if (psRegion != psRegionsHead)
     {
-        fp = VSIFOpenL(VSICurlGetCacheFileName(), "wb");
+        UnlinkRegion(psRegion);
+        psRegion->psNext = psRegionsHead;
+        psRegionsHead->psPrev = psRegion;
+        psRegionsHead = psRegion;
     }
-    if (fp)
-    {
-        if (ENABLE_DEBUG)
-             CPLDebug("VSICURL", "Write data at offset " CPL_FRMT_GUIB " to disk" , psRegion->nFileOffsetStart);
-        CPL_IGNORE_RET_VAL(VSIFWriteL(&psRegion->pszURLHash, 1, sizeof(unsigned long), fp));
-        CPL_IGNORE_RET_VAL(VSIFWriteL(&psRegion->nFileOffsetStart, 1, sizeof(vsi_l_offset), fp));
-        CPL_IGNORE_RET_VAL(VSIFWriteL(&psRegion->nSize, 1, sizeof(size_t), fp));
-        if (psRegion->nSize)
-            CPL_IGNORE_RET_VAL(VSIFWriteL(psRegion->pData, 1, psRegion->nSize, fp));
+    return psRegion;
+}
 
-        VSIFCloseL(fp);
-    }
-    return;
+/************************************************************************/
+/*                           UnlinkRegion()                             */
+/************************************************************************/
+
+void VSICurlFilesystemHandler::UnlinkRegion(CachedRegion* psRegion)
+{
+    if (psRegion->psPrev)
+        psRegion->psPrev->psNext = psRegion->psNext;
+    else
+        psRegionsHead = psRegion->psNext;
+    if (psRegion->psNext)
+        psRegion->psNext->psPrev = psRegion->psPrev;
+    else
+        psRegionsTail = psRegion->psPrev;
+    psRegion->psPrev = NULL;
+    psRegion->psNext = NULL;
 }
 
+/************************************************************************/
+/*                           DeleteRegion()                             */
+/************************************************************************/
+
+void VSICurlFilesystemHandler::DeleteRegion(CachedRegion* psRegion)
+{
+    CPLHashSetRemove(hSetRegions, psRegion);
+    UnlinkRegion(psRegion);
+    nCachedBytes -= sizeof(CachedRegion) + psRegion->nSize;
+    CPLFree(psRegion->pData);
+    CPLFree(psRegion);
+}
 
 /************************************************************************/
-/*                          GetRegion()                                 */
+/*                       VSICurlCopyFromRegion()                        */
 /************************************************************************/
 
-const CachedRegion* VSICurlFilesystemHandler::GetRegion(const char* pszURL,
-                                                        vsi_l_offset nFileOffsetStart)
+static void VSICurlCopyFromRegion(const CachedRegion* psRegion,
+                                  vsi_l_offset nOffset,
+                                  void* pDst, size_t nMaxSize,
+                                  size_t* pnCopied, size_t* pnRegionSize)
 {
-    CPLMutexHolder oHolder( &hMutex );
+    const size_t nDelta = (size_t)(nOffset - psRegion->nFileOffsetStart);
+    size_t nToCopy = 0;
+    if (nDelta < psRegion->nSize)
+    {
+        nToCopy = MIN(nMaxSize, psRegion->nSize - nDelta);
+        if (nToCopy)
+            memcpy(pDst, psRegion->pData + nDelta, nToCopy);
+    }
+    if (pnCopied)
+        *pnCopied = nToCopy;
+    if (pnRegionSize)
+        *pnRegionSize = psRegion->nSize;
+}
 
+/************************************************************************/
+/*                            CopyRegion()                              */
+/*                                                                      */
+/*      Copy at most nMaxSize bytes at nOffset from the cached chunk    */
+/*      that contains it. The copy is done with hMutex held, so that    */
+/*      the chunk cannot be evicted meanwhile by another thread.        */
+/*      Returns false if the chunk is not cached. Otherwise, *pnCopied  */
+/*      is set to the number of bytes copied and *pnRegionSize to the  */
+/*      size of the chunk, which is smaller than DOWNLOAD_CHUNK_SIZE    */
+/*      only at the end of the file.                                    */
+/************************************************************************/
+
+bool VSICurlFilesystemHandler::CopyRegion(const char* pszURL,
+                                          vsi_l_offset nOffset,
+                                          void* pDst, size_t nMaxSize,
+                                          size_t* pnCopied,
+                                          size_t* pnRegionSize)
+{
     unsigned long   pszURLHash = CPLHashSetHashStr(pszURL);
 
-    nFileOffsetStart = (nFileOffsetStart / DOWNLOAD_CHUNK_SIZE) * DOWNLOAD_CHUNK_SIZE;
-    int i;
-    for(i=0;i<nRegions;i++)
+    const vsi_l_offset nFileOffsetStart =
+                    (nOffset / DOWNLOAD_CHUNK_SIZE) * DOWNLOAD_CHUNK_SIZE;
+
+    CPLString osValidator;
     {
-        CachedRegion* psRegion = papsRegions[i];
-        if (psRegion->pszURLHash == pszURLHash &&
-            nFileOffsetStart == psRegion->nFileOffsetStart)
+        CPLMutexHolder oHolder( &hMutex );
+
+        CachedRegion* psRegion = FindRegion(pszURLHash, nFileOffsetStart);
+        if (psRegion != NULL)
         {
-            memmove(papsRegions + 1, papsRegions, i * sizeof(CachedRegion*));
-            papsRegions[0] = psRegion;
-            return psRegion;
+            nRegionHits ++;
+            VSICurlCopyFromRegion(psRegion, nOffset, pDst, nMaxSize,
+                                  pnCopied, pnRegionSize);
+            return true;
         }
+        nRegionMisses ++;
+        if (GetDiskCache() == NULL)
+            return false;
+        osValidator = GetDiskCacheValidator(pszURL);
     }
-    if (bUseCacheDisk)
-        return GetRegionFromCacheDisk(pszURL, nFileOffsetStart);
-    return NULL;
+    if (osValidator.empty())
+        return false;
+
+    /* Look in the persistent cache, without holding the mutex */
+    size_t nSize = 0;
+    char* pData = poDiskCache->Read(pszURL, osValidator, nFileOffsetStart, &nSize);
+    if (pData == NULL)
+        return false;
+
+    CPLMutexHolder oHolder( &hMutex );
+    const CachedRegion* psRegion =
+        AddRegionToMemoryCache(pszURLHash, nFileOffsetStart, nSize, pData);
+    VSICurlCopyFromRegion(psRegion, nOffset, pDst, nMaxSize,
+                          pnCopied, pnRegionSize);
+    return true;
 }
 
 /************************************************************************/
@@ -1801,36 +2737,179 @@ void  VSICurlFilesystemHandler::AddRegion(const char* pszURL,
                                           size_t          nSize,
                                           const char     *pData)
 {
-    CPLMutexHolder oHolder( &hMutex );
-
     unsigned long   pszURLHash = CPLHashSetHashStr(pszURL);
 
-    CachedRegion* psRegion;
-    if (nRegions == N_MAX_REGIONS)
+    char* pDataCopy = (nSize) ? (char*) CPLMalloc(nSize) : NULL;
+    if (nSize)
+        memcpy(pDataCopy, pData, nSize);
+
+    CPLString osValidator;
     {
-        psRegion = papsRegions[N_MAX_REGIONS-1];
-        memmove(papsRegions + 1, papsRegions, (N_MAX_REGIONS-1) * sizeof(CachedRegion*));
-        papsRegions[0] = psRegion;
-        CPLFree(psRegion->pData);
+        CPLMutexHolder oHolder( &hMutex );
+
+        AddRegionToMemoryCache(pszURLHash, nFileOffsetStart, nSize, pDataCopy);
+        if (GetDiskCache() != NULL)
+            osValidator = GetDiskCacheValidator(pszURL);
     }
-    else
+
+    if (!osValidator.empty())
+        poDiskCache->Write(pszURL, osValidator, nFileOffsetStart, pData, nSize);
+}
+
+/************************************************************************/
+/*                       AddRegionToMemoryCache()                       */
+/*                                                                      */
+/*      Takes ownership of pData. hMutex must be held by the caller.    */
+/************************************************************************/
+
+CachedRegion* VSICurlFilesystemHandler::AddRegionToMemoryCache(
+                                          unsigned long   pszURLHash,
+                                          vsi_l_offset    nFileOffsetStart,
+                                          size_t          nSize,
+                                          char           *pData)
+{
+    /* The same chunk may have been downloaded concurrently by another */
+    /* thread: keep the cached one. */
+    CachedRegion* psExisting = FindRegion(pszURLHash, nFileOffsetStart);
+    if (psExisting != NULL)
     {
-        papsRegions = (CachedRegion**) CPLRealloc(papsRegions, (nRegions + 1) * sizeof(CachedRegion*));
-        if (nRegions)
-            memmove(papsRegions + 1, papsRegions, nRegions * sizeof(CachedRegion*));
-        nRegions ++;
-        papsRegions[0] = psRegion = (CachedRegion*) CPLMalloc(sizeof(CachedRegion));
+        CPLFree(pData);
+        return psExisting;
     }
 
+    /* Evict the least recently used chunks until the new one fits */
+    const GUIntBig nRegionBytes = sizeof(CachedRegion) + nSize;
+    while (psRegionsTail != NULL &&
+           nCachedBytes + nRegionBytes > GetMaxCachedBytes())
+        DeleteRegion(psRegionsTail);
+
+    CachedRegion* psRegion = (CachedRegion*) CPLMalloc(sizeof(CachedRegion));
     psRegion->pszURLHash = pszURLHash;
     psRegion->nFileOffsetStart = nFileOffsetStart;
     psRegion->nSize = nSize;
-    psRegion->pData = (nSize) ? (char*) CPLMalloc(nSize) : NULL;
-    if (nSize)
-        memcpy(psRegion->pData, pData, nSize);
+    psRegion->pData = pData;
+
+    psRegion->psPrev = NULL;
+    psRegion->psNext = psRegionsHead;
+    if (psRegionsHead)
+        psRegionsHead->psPrev = psRegion;
+    psRegionsHead = psRegion;
+    if (psRegionsTail == NULL)
+        psRegionsTail = psRegion;
+    CPLHashSetInsert(hSetRegions, psRegion);
+    nCachedBytes += nRegionBytes;
+
+    return psRegion;
+}
 
-    if (bUseCacheDisk)
-        AddRegionToCacheDisk(psRegion);
+/************************************************************************/
+/*                            GetDiskCache()                            */
+/*                                                                      */
+/*      hMutex must be held by the caller.                              */
+/************************************************************************/
+
+VSICurlDiskCache* VSICurlFilesystemHandler::GetDiskCache()
+{
+    if( bDiskCacheInitialized )
+        return poDiskCache;
+    bDiskCacheInitialized = true;
+
+    const char* pszCacheDir = CPLGetConfigOption("CPL_VSIL_CURL_CACHE_DIR", NULL);
+    if( pszCacheDir == NULL &&
+        !CSLTestBoolean(CPLGetConfigOption("CPL_VSIL_CURL_USE_CACHE", "NO")) )
+        return NULL;
+
+    CPLString osCacheDir;
+    if( pszCacheDir != NULL )
+        osCacheDir = pszCacheDir;
+    else
+        osCacheDir = CPLFormFilename(CPLGetPath(CPLGenerateTempFilename(NULL)),
+                                     "gdal_vsicurl_cache", NULL);
+    poDiskCache = new VSICurlDiskCache(osCacheDir,
+        CPLScanUIntBig(CPLGetConfigOption("CPL_VSIL_CURL_DISK_CACHE_SIZE",
+                       CPLSPrintf(CPL_FRMT_GUIB, N_DEFAULT_DISK_CACHE_SIZE)), 40));
+    return poDiskCache;
+}
+
+/************************************************************************/
+/*                       GetDiskCacheValidator()                        */
+/*                                                                      */
+/*      Return the string that identifies the content of pszURL in the  */
+/*      disk cache, or an empty string if it is not known yet. hMutex   */
+/*      must be held by the caller.                                     */
+/************************************************************************/
+
+CPLString VSICurlFilesystemHandler::GetDiskCacheValidator(const char* pszURL)
+{
+    CPLString osValidator;
+    std::map<CPLString, CachedFileProp*>::const_iterator oIter =
+                                                    cacheFileSize.find(pszURL);
+    if( oIter == cacheFileSize.end() )
+        return osValidator;
+
+    const CachedFileProp* cachedFileProp = oIter->second;
+    if( cachedFileProp->eExists != EXIST_YES ||
+        !cachedFileProp->bHasComputedFileSize )
+        return osValidator;
+
+    /* Without ETag, we can only rely on the file size to detect changes */
+    if( cachedFileProp->pszETag != NULL )
+        osValidator = CPLString("etag=") + cachedFileProp->pszETag;
+    else
+        osValidator.Printf("size=" CPL_FRMT_GUIB, cachedFileProp->fileSize);
+    return osValidator;
+}
+
+/************************************************************************/
+/*                         GetMaxCachedBytes()                          */
+/*                                                                      */
+/*      The size of the cache is read at first use, and not when the    */
+/*      handler is installed, so that it can be set with --config.      */
+/*      hMutex must be held by the caller.                              */
+/************************************************************************/
+
+GUIntBig VSICurlFilesystemHandler::GetMaxCachedBytes()
+{
+    if (nMaxCachedBytes == 0)
+        nMaxCachedBytes = CPLScanUIntBig(
+            CPLGetConfigOption("CPL_VSIL_CURL_CACHE_SIZE",
+                               CPLSPrintf(CPL_FRMT_GUIB, N_DEFAULT_CACHE_SIZE)), 40);
+    return nMaxCachedBytes;
+}
+
+/************************************************************************/
+/*                      GetMaxBlocksPerDownload()                       */
+/************************************************************************/
+
+int VSICurlFilesystemHandler::GetMaxBlocksPerDownload()
+{
+    CPLMutexHolder oHolder( &hMutex );
+
+    GUIntBig nMaxBlocks = GetMaxCachedBytes() /
+                            (sizeof(CachedRegion) + DOWNLOAD_CHUNK_SIZE);
+    if (nMaxBlocks < 1)
+        return 1;
+    if (nMaxBlocks > (GUIntBig)N_MAX_BLOCKS_PER_DOWNLOAD)
+        return N_MAX_BLOCKS_PER_DOWNLOAD;
+    return (int)nMaxBlocks;
+}
+
+/************************************************************************/
+/*                        GetCacheStatistics()                          */
+/************************************************************************/
+
+void VSICurlFilesystemHandler::GetCacheStatistics(GUIntBig* pnHits,
+                                                  GUIntBig* pnMisses,
+                                                  GUIntBig* pnCachedBytes)
+{
+    CPLMutexHolder oHolder( &hMutex );
+
+    if (pnHits)
+        *pnHits = nRegionHits;
+    if (pnMisses)
+        *pnMisses = nRegionMisses;
+    if (pnCachedBytes)
+        *pnCachedBytes = nCachedBytes;
 }
 
 /************************************************************************/
@@ -1849,12 +2928,28 @@ CachedFileProp*  VSICurlFilesystemHandler::GetCachedFileProp(const char* pszURL)
         cachedFileProp->bHasComputedFileSize = false;
         cachedFileProp->fileSize = 0;
         cachedFileProp->bIsDirectory = false;
+        cachedFileProp->mTime = 0;
+        cachedFileProp->pszETag = NULL;
         cacheFileSize[pszURL] = cachedFileProp;
     }
 
     return cachedFileProp;
 }
 
+/************************************************************************/
+/*                         SetCachedFileETag()                          */
+/************************************************************************/
+
+void VSICurlFilesystemHandler::SetCachedFileETag(const char* pszURL,
+                                                 const char* pszETag)
+{
+    CPLMutexHolder oHolder( &hMutex );
+
+    CachedFileProp* cachedFileProp = GetCachedFileProp(pszURL);
+    CPLFree(cachedFileProp->pszETag);
+    cachedFileProp->pszETag = CPLStrdup(pszETag);
+}
+
 /************************************************************************/
 /*                    InvalidateCachedFileProp()                        */
 /************************************************************************/
@@ -1866,6 +2961,7 @@ void VSICurlFilesystemHandler::InvalidateCachedFileProp(const char* pszURL)
     std::map<CPLString, CachedFileProp*>::iterator oIter = cacheFileSize.find(pszURL);
     if( oIter != cacheFileSize.end() )
     {
+        CPLFree(oIter->second->pszETag);
         CPLFree(oIter->second);
         cacheFileSize.erase(oIter);
     }
@@ -2953,6 +4049,19 @@ char** VSICurlFilesystemHandler::ReadDir( const char *pszDirname )
  * it will progressively increase the chunk size up to 2 MB to improve download
  * performance.
  *
+ * Downloaded chunks are kept in an in-memory LRU cache shared by all the
+ * handles of the filesystem. Starting with GDAL 2.1, its size can be set with the
+ * CPL_VSIL_CURL_CACHE_SIZE configuration option (in bytes, 16 MB by default).
+ *
+ * Starting with GDAL 2.1, downloaded chunks can also be stored in a persistent
+ * disk cache, shared by all the processes that use the same directory, by setting
+ * the CPL_VSIL_CURL_CACHE_DIR configuration option to the directory to use
+ * (setting CPL_VSIL_CURL_USE_CACHE to YES uses a gdal_vsicurl_cache directory in
+ * the temporary directory). Cached content is identified by the URL and the ETag
+ * returned by the server, or the file size if there is no ETag. The least recently
+ * used chunks are removed when the cache exceeds CPL_VSIL_CURL_DISK_CACHE_SIZE
+ * bytes (100 MB by default).
+ *
  * The GDAL_HTTP_PROXY, GDAL_HTTP_PROXYUSERPWD and GDAL_PROXY_AUTH configuration options can be
  * used to define a proxy server. The syntax to use is the one of Curl CURLOPT_PROXY,
  * CURLOPT_PROXYUSERPWD and CURLOPT_PROXYAUTH options.
@@ -2961,6 +4070,15 @@ char** VSICurlFilesystemHandler::ReadDir( const char *pszDirname )
  * VSI_CACHE to TRUE. The cache size defaults to 25 MB, but can be modified by setting
  * the configuration option VSI_CACHE_SIZE (in bytes).
  *
+ * Starting with GDAL 2.1, VSIFReadMultiRangeL() (used for example by the GTiff
+ * driver to fetch several tiles at once) is implemented by issuing one range
+ * GET request per group of ranges, ranges separated by at most
+ * CPL_VSIL_CURL_MULTIRANGE_MAX_GAP bytes (4096 by default) being coalesced in
+ * the same group. Up to CPL_VSIL_CURL_MAX_CONCURRENT_RANGES (10 by default)
+ * requests are run in parallel. Setting CPL_VSIL_CURL_MULTIRANGE to SERIAL runs
+ * them one after the other, and setting it to SINGLE_GET restores the previous
+ * behaviour of a single multipart/byteranges request.
+ *
  * VSIStatL() will return the size in st_size member and file
  * nature- file or directory - in st_mode member (the later only reliable with FTP
  * resources for now).
@@ -3001,6 +4119,24 @@ int VSICurlUninstallReadCbk(VSILFILE* fp)
     return ((VSICurlHandle*)fp)->UninstallReadCbk();
 }
 
+/************************************************************************/
+/*                    VSICurlGetCacheStatistics()                       */
+/************************************************************************/
+
+int VSICurlGetCacheStatistics(const char* pszFilename,
+                              GUIntBig* pnHits,
+                              GUIntBig* pnMisses,
+                              GUIntBig* pnCachedBytes)
+{
+    if( !STARTS_WITH_CI(pszFilename, "/vsicurl/") &&
+        !STARTS_WITH_CI(pszFilename, "/vsis3/") )
+        return FALSE;
+
+    VSICurlFilesystemHandler* poFSHandler =
+        (VSICurlFilesystemHandler*) VSIFileManager::GetHandler(pszFilename);
+    poFSHandler->GetCacheStatistics(pnHits, pnMisses, pnCachedBytes);
+    return TRUE;
+}
 
 /************************************************************************/
 /*                         VSIS3FSHandler                               */
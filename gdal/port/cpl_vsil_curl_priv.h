@@ -46,4 +46,13 @@ int VSICurlInstallReadCbk(VSILFILE* fp, VSICurlReadCbkFunc pfnReadCbk, void* pfn
                           int bStopOnInterrruptUntilUninstall);
 int VSICurlUninstallReadCbk(VSILFILE* fp);
 
+/* Return the statistics of the in-memory chunk cache of the /vsicurl/ or */
+/* /vsis3/ handler that serves pszFilename: number of chunk lookups that */
+/* were satisfied or not by the cache, and number of bytes it currently uses. */
+/* Returns FALSE if pszFilename is not served by one of those handlers. */
+int CPL_DLL VSICurlGetCacheStatistics(const char* pszFilename,
+                                      GUIntBig* pnHits,
+                                      GUIntBig* pnMisses,
+                                      GUIntBig* pnCachedBytes);
+
 #endif // CPL_VSIL_CURL_PRIV_H_INCLUDED
@@ -52,6 +52,9 @@
 #include <sys/statvfs.h>
 #endif
 #include <sys/types.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 #include <dirent.h>
 #include <errno.h>
 #include <new>
@@ -161,6 +164,8 @@ class VSIUnixStdioHandle : public VSIVirtualHandle
     virtual int       Seek( vsi_l_offset nOffsetIn, int nWhence );
     virtual vsi_l_offset Tell();
     virtual size_t    Read( void *pBuffer, size_t nSize, size_t nMemb );
+    virtual int       HasPRead() { return bReadOnly; }
+    virtual size_t    PRead( void *pBuffer, size_t nSize, vsi_l_offset nOffset );
     virtual size_t    Write( const void *pBuffer, size_t nSize, size_t nMemb );
     virtual int       Eof();
     virtual int       Flush();
@@ -377,6 +382,58 @@ size_t VSIUnixStdioHandle::Read( void * pBuffer, size_t nSize, size_t nCount )
     return nResult;
 }
 
+/************************************************************************/
+/*                               PRead()                                */
+/*                                                                      */
+/*      pread() works on the file descriptor without touching its       */
+/*      offset nor the stdio buffer of fp, so it can be used from       */
+/*      several threads and be mixed with Seek()/Read(). Data still     */
+/*      in the stdio write buffer would not be seen, hence HasPRead()   */
+/*      being limited to read-only handles.                             */
+/************************************************************************/
+
+size_t VSIUnixStdioHandle::PRead( void *pBuffer, size_t nSize,
+                                  vsi_l_offset nOffset )
+
+{
+    const int fd = fileno( fp );
+    size_t nRead = 0;
+
+    while( nRead < nSize )
+    {
+#ifdef HAVE_PREAD64
+        const ssize_t nRet = pread64( fd, (GByte*) pBuffer + nRead,
+                                      nSize - nRead,
+                                      (off64_t) (nOffset + nRead) );
+#else
+        if( nOffset + nRead !=
+                (vsi_l_offset) (off_t) (nOffset + nRead) )
+        {
+            errno = EOVERFLOW;
+            break;
+        }
+        const ssize_t nRet = pread( fd, (GByte*) pBuffer + nRead,
+                                    nSize - nRead,
+                                    (off_t) (nOffset + nRead) );
+#endif
+        if( nRet < 0 )
+        {
+            if( errno == EINTR )
+                continue;
+            break;
+        }
+        if( nRet == 0 )
+            break;
+        nRead += nRet;
+    }
+
+#ifdef VSI_COUNT_BYTES_READ
+    poFS->AddToTotal( nRead );
+#endif
+
+    return nRead;
+}
+
 /************************************************************************/
 /*                               Write()                                */
 /************************************************************************/
@@ -447,6 +504,208 @@ int VSIUnixStdioHandle::Truncate( vsi_l_offset nNewSize )
     return VSI_FTRUNCATE64(fileno(fp), nNewSize);
 }
 
+#ifdef HAVE_MMAP
+
+/************************************************************************/
+/* ==================================================================== */
+/*                      VSIUnixStdioMMapHandle                          */
+/* ==================================================================== */
+/************************************************************************/
+
+class VSIUnixStdioMMapHandle : public VSIVirtualHandle
+{
+    FILE          *fp;
+    const GByte   *pabyData;
+    size_t         nLength;
+    vsi_l_offset   nCurOffset;
+    int            bAtEOF;
+
+                      VSIUnixStdioMMapHandle( FILE* fpIn,
+                                              const GByte* pabyDataIn,
+                                              size_t nLengthIn ) :
+                        fp(fpIn), pabyData(pabyDataIn), nLength(nLengthIn),
+                        nCurOffset(0), bAtEOF(FALSE) {}
+
+  public:
+    static VSIUnixStdioMMapHandle *Create( FILE* fpIn );
+
+    virtual int       Seek( vsi_l_offset nOffsetIn, int nWhence );
+    virtual vsi_l_offset Tell() { return nCurOffset; }
+    virtual size_t    Read( void *pBuffer, size_t nSize, size_t nMemb );
+    virtual int       ReadMultiRange( int nRanges, void ** ppData,
+                                      const vsi_l_offset* panOffsets,
+                                      const size_t* panSizes );
+    virtual int       HasPRead() { return TRUE; }
+    virtual size_t    PRead( void *pBuffer, size_t nSize, vsi_l_offset nOffset );
+    virtual const void *GetDirectPointer( vsi_l_offset nOffset, size_t nSize );
+    virtual size_t    Write( const void *pBuffer, size_t nSize, size_t nMemb );
+    virtual int       Eof() { return bAtEOF; }
+    virtual int       Close();
+    virtual void     *GetNativeFileDescriptor() { return (void*) (size_t) fileno(fp); }
+};
+
+/************************************************************************/
+/*                               Create()                               */
+/*                                                                      */
+/*      Map the whole file. Returns NULL (leaving fpIn open) if this    */
+/*      is not possible, in which case the caller falls back to a       */
+/*      regular handle.                                                 */
+/************************************************************************/
+
+VSIUnixStdioMMapHandle *VSIUnixStdioMMapHandle::Create( FILE* fpIn )
+
+{
+    if( VSI_FSEEK64( fpIn, 0, SEEK_END ) != 0 )
+        return NULL;
+    const vsi_l_offset nFileSize = VSI_FTELL64( fpIn );
+    if( VSI_FSEEK64( fpIn, 0, SEEK_SET ) != 0 )
+        return NULL;
+
+    // mmap() of an empty file is not allowed.
+    if( nFileSize == 0 || nFileSize != (vsi_l_offset)(size_t)nFileSize )
+        return NULL;
+
+    void* pAddr = mmap( NULL, (size_t)nFileSize, PROT_READ, MAP_SHARED,
+                        fileno(fpIn), 0 );
+    if( pAddr == MAP_FAILED )
+    {
+        CPLDebug( "VSI", "mmap() failed: %s", VSIStrerror(errno) );
+        return NULL;
+    }
+
+    VSIUnixStdioMMapHandle* poHandle = new(std::nothrow)
+        VSIUnixStdioMMapHandle( fpIn, (const GByte*)pAddr, (size_t)nFileSize );
+    if( poHandle == NULL )
+        munmap( pAddr, (size_t)nFileSize );
+    return poHandle;
+}
+
+/************************************************************************/
+/*                               Close()                                */
+/************************************************************************/
+
+int VSIUnixStdioMMapHandle::Close()
+
+{
+    VSIDebug1( "VSIUnixStdioMMapHandle::Close(%p)", fp );
+
+    munmap( (void*)pabyData, nLength );
+    return fclose( fp );
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+int VSIUnixStdioMMapHandle::Seek( vsi_l_offset nOffsetIn, int nWhence )
+
+{
+    bAtEOF = FALSE;
+    if( nWhence == SEEK_SET )
+        nCurOffset = nOffsetIn;
+    else if( nWhence == SEEK_CUR )
+        nCurOffset += nOffsetIn;
+    else if( nWhence == SEEK_END )
+        nCurOffset = nLength + nOffsetIn;
+    else
+    {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                                Read()                                */
+/************************************************************************/
+
+size_t VSIUnixStdioMMapHandle::Read( void * pBuffer, size_t nSize,
+                                     size_t nCount )
+
+{
+    if( nSize == 0 || nCount == 0 )
+        return 0;
+
+    if( nCurOffset >= nLength )
+    {
+        bAtEOF = TRUE;
+        return 0;
+    }
+
+    size_t nBytesToRead = nSize * nCount;
+    if( nBytesToRead > nLength - nCurOffset )
+    {
+        nBytesToRead = (size_t)(nLength - nCurOffset);
+        bAtEOF = TRUE;
+    }
+
+    memcpy( pBuffer, pabyData + nCurOffset, nBytesToRead );
+    nCurOffset += nBytesToRead;
+
+    return nBytesToRead / nSize;
+}
+
+/************************************************************************/
+/*                           ReadMultiRange()                           */
+/************************************************************************/
+
+int VSIUnixStdioMMapHandle::ReadMultiRange( int nRanges, void ** ppData,
+                                            const vsi_l_offset* panOffsets,
+                                            const size_t* panSizes )
+
+{
+    for( int i = 0; i < nRanges; i++ )
+    {
+        if( panOffsets[i] > nLength || panSizes[i] > nLength - panOffsets[i] )
+            return -1;
+        memcpy( ppData[i], pabyData + panOffsets[i], panSizes[i] );
+    }
+    return 0;
+}
+
+/************************************************************************/
+/*                               PRead()                                */
+/************************************************************************/
+
+size_t VSIUnixStdioMMapHandle::PRead( void *pBuffer, size_t nSize,
+                                      vsi_l_offset nOffset )
+
+{
+    if( nOffset >= nLength )
+        return 0;
+    if( nSize > nLength - nOffset )
+        nSize = (size_t)(nLength - nOffset);
+    memcpy( pBuffer, pabyData + nOffset, nSize );
+    return nSize;
+}
+
+/************************************************************************/
+/*                          GetDirectPointer()                          */
+/************************************************************************/
+
+const void *VSIUnixStdioMMapHandle::GetDirectPointer( vsi_l_offset nOffset,
+                                                      size_t nSize )
+
+{
+    if( nOffset > nLength || nSize > nLength - nOffset )
+        return NULL;
+    return pabyData + nOffset;
+}
+
+/************************************************************************/
+/*                               Write()                                */
+/************************************************************************/
+
+size_t VSIUnixStdioMMapHandle::Write( CPL_UNUSED const void * pBuffer,
+                                      CPL_UNUSED size_t nSize,
+                                      CPL_UNUSED size_t nCount )
+
+{
+    errno = EBADF;
+    return 0;
+}
+
+#endif /* HAVE_MMAP */
 
 /************************************************************************/
 /* ==================================================================== */
@@ -504,6 +763,25 @@ VSIUnixStdioFilesystemHandler::Open( const char *pszFilename,
     }
 
     const int bReadOnly = strcmp(pszAccess, "rb") == 0 || strcmp(pszAccess, "r") == 0;
+
+#ifdef HAVE_MMAP
+/* -------------------------------------------------------------------- */
+/*      If VSI_USE_MMAP is set, serve read-only files from a memory     */
+/*      mapping of the whole file.                                      */
+/* -------------------------------------------------------------------- */
+    if( bReadOnly
+        && CSLTestBoolean( CPLGetConfigOption( "VSI_USE_MMAP", "NO" ) ) )
+    {
+        VSIUnixStdioMMapHandle *poMMapHandle =
+            VSIUnixStdioMMapHandle::Create( fp );
+        if( poMMapHandle != NULL )
+        {
+            errno = nError;
+            return poMMapHandle;
+        }
+    }
+#endif
+
     VSIUnixStdioHandle *poHandle = new(std::nothrow) VSIUnixStdioHandle(this, fp, bReadOnly );
     if( poHandle == NULL )
     {